@@ -7,6 +7,7 @@
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
@@ -48,6 +49,7 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string stats_filepath;
 } options;
 
 static void session_print(const string &str)
@@ -161,6 +163,15 @@ static void session_init()
 
 static void session_exit()
 {
+  if (options.session && !options.stats_filepath.empty()) {
+    RenderStats stats;
+    options.session->collect_statistics(&stats);
+    string report = stats.json_report();
+    if (!path_write_text(options.stats_filepath, report)) {
+      fprintf(stderr, "Failed to write statistics to %s\n", options.stats_filepath.c_str());
+    }
+  }
+
   if (options.session) {
     delete options.session;
     options.session = NULL;
@@ -426,6 +437,9 @@ static void options_parse(int argc, const char **argv)
              "--profile",
              &profile,
              "Enable profile logging",
+             "--stats-output %s",
+             &options.stats_filepath,
+             "File path to write render statistics and profiling information to, as JSON",
 #ifdef WITH_CYCLES_LOGGING
              "--debug",
              &debug,
@@ -475,7 +489,7 @@ static void options_parse(int argc, const char **argv)
     exit(EXIT_SUCCESS);
   }
 
-  options.session_params.use_profiling = profile;
+  options.session_params.use_profiling = profile || !options.stats_filepath.empty();
 
   if (ssname == "osl")
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -429,6 +429,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0.01,
     )
 
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Sample many lights more efficiently, by picking lights based on their estimated contribution to every shading point",
+        default=True,
+    )
+
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
         description="Automatically reduce the number of samples per pixel based on estimated noise level",
@@ -874,6 +880,22 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_texture_limit
     )
 
+    texture_memory_limit: IntProperty(
+        name="Viewport Texture Memory Limit",
+        description="Scale down the largest textures used by viewport rendering until all textures fit into this "
+        "amount of memory in megabytes, 0 for no limit",
+        default=0,
+        min=0,
+    )
+
+    texture_memory_limit_render: IntProperty(
+        name="Render Texture Memory Limit",
+        description="Scale down the largest textures used by final rendering until all textures fit into this "
+        "amount of memory in megabytes, 0 for no limit",
+        default=0,
+        min=0,
+    )
+
     use_fast_gi: BoolProperty(
         name="Fast GI Approximation",
         description="Approximate diffuse indirect light with background tinted ambient occlusion. This provides fast alternative to full global illumination, for interactive viewport rendering or final renders with reduced quality",
@@ -912,6 +934,16 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_half_attributes: BoolProperty(
+        name="Half Precision Attributes",
+        description="Store generic attributes, color attributes and tangents as half floats to reduce memory usage, at the cost of precision",
+        default=False,
+    )
+    use_texture_compression: BoolProperty(
+        name="Compress Textures",
+        description="Compress opaque 8 bit color textures to an eighth of their memory usage, at the cost of some color precision. Not supported on Metal",
+        default=False,
+    )
 
     # Various fine-tuning debug flags
 
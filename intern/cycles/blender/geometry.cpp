@@ -12,6 +12,7 @@
 #include "blender/util.h"
 
 #include "util/foreach.h"
+#include "util/md5.h"
 #include "util/task.h"
 
 CCL_NAMESPACE_BEGIN
@@ -181,6 +182,102 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   return geom;
 }
 
+static void md5_append_data(MD5Hash &md5, const void *data, const size_t num_bytes)
+{
+  md5.append((const uint8_t *)&num_bytes, sizeof(num_bytes));
+
+  /* Append in chunks, since MD5Hash takes the size as int. */
+  const size_t chunk_size = 1 << 30;
+  for (size_t offset = 0; offset < num_bytes; offset += chunk_size) {
+    md5.append((const uint8_t *)data + offset, (int)min(chunk_size, num_bytes - offset));
+  }
+}
+
+template<typename T> static void md5_append_array(MD5Hash &md5, const array<T> &data)
+{
+  md5_append_data(md5, data.data(), data.size() * sizeof(T));
+}
+
+/* Hash of everything that ends up in the render for a mesh, so meshes with the same hash can
+ * be shared between objects. */
+static string mesh_content_hash(Mesh *mesh)
+{
+  MD5Hash md5;
+
+  foreach (Node *node, mesh->get_used_shaders()) {
+    md5.append((const uint8_t *)&node, sizeof(node));
+  }
+
+  md5_append_array(md5, mesh->get_verts());
+  md5_append_array(md5, mesh->get_triangles());
+  md5_append_array(md5, mesh->get_shader());
+  md5_append_array(md5, mesh->get_smooth());
+
+  foreach (const Attribute &attr, mesh->attributes.attributes) {
+    md5.append(attr.name.string());
+    md5.append((const uint8_t *)&attr.std, sizeof(attr.std));
+    md5.append((const uint8_t *)&attr.element, sizeof(attr.element));
+    md5.append((const uint8_t *)&attr.flags, sizeof(attr.flags));
+    md5.append(attr.type.c_str());
+
+    md5_append_data(md5, attr.buffer.data(), attr.buffer.size());
+  }
+
+  return md5.get_hex();
+}
+
+/* Let objects whose evaluated meshes are identical share a single mesh, as if the geometry was
+ * instanced. This saves memory and BVH build time for objects that can't be instanced in
+ * Blender, like copies that are not linked duplicates or identical geometry nodes results.
+ *
+ * The duplicates are deleted, and recreated on the next sync so that edits to either copy are
+ * picked up. Hence this is only done for final renders. Meshes with deformation motion or
+ * subdivision are left alone, since their data depends on the object. */
+void BlenderSync::deduplicate_geometry()
+{
+  map<string, Geometry *> unique_meshes;
+  map<Geometry *, Geometry *> duplicates;
+
+  for (const auto &[key, geom] : geometry_map.key_to_scene_data()) {
+    if (geom->geometry_type != Geometry::MESH || !geometry_map.is_used(key)) {
+      continue;
+    }
+
+    Mesh *mesh = static_cast<Mesh *>(geom);
+    if (mesh->transform_applied || mesh->get_use_motion_blur() ||
+        mesh->get_subdivision_type() != Mesh::SUBDIVISION_NONE ||
+        mesh->get_triangles().size() == 0) {
+      continue;
+    }
+
+    const string hash = mesh_content_hash(mesh);
+    const auto unique_mesh = unique_meshes.find(hash);
+    if (unique_mesh == unique_meshes.end()) {
+      unique_meshes[hash] = mesh;
+    }
+    else {
+      duplicates[mesh] = unique_mesh->second;
+    }
+  }
+
+  if (duplicates.empty()) {
+    return;
+  }
+
+  foreach (Object *object, scene->objects) {
+    const auto duplicate = duplicates.find(object->get_geometry());
+    if (duplicate != duplicates.end()) {
+      object->set_geometry(duplicate->second);
+    }
+  }
+
+  for (const auto &duplicate : duplicates) {
+    geometry_map.unused(duplicate.first);
+  }
+
+  VLOG_INFO << "Shared " << duplicates.size() << " meshes identical to other meshes.";
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BObjectInfo &b_ob_info,
                                        Object *object,
@@ -139,6 +139,12 @@ template<typename K, typename T> class id_map {
     used_set.insert(data);
   }
 
+  void unused(T *data)
+  {
+    /* tag data as no longer in use, so it is deleted by post_sync() */
+    used_set.erase(data);
+  }
+
   void set_default(T *data)
   {
     b_map[NULL] = data;
@@ -573,8 +573,9 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
       bool has_subdivision_modifier = false;
       BL::MeshSequenceCacheModifier b_mesh_cache(PointerRNA_NULL);
 
-      /* Experimental as Blender does not have good support for procedurals at the moment. */
-      if (experimental) {
+      /* Experimental in the viewport as Blender does not have good support for procedurals at
+       * the moment. Final renders don't need interactive updates, so they always use it. */
+      if (experimental || !preview) {
         b_mesh_cache = object_mesh_cache_find(b_ob, &has_subdivision_modifier);
         use_procedural = b_mesh_cache && b_mesh_cache.cache_file().use_render_procedural();
       }
@@ -624,6 +625,11 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   if (!cancel && !motion) {
     sync_background_light(b_v3d, use_portal);
 
+    /* Share identical meshes between objects, before unused geometry is deleted. */
+    if (!preview && scene->need_motion() == Scene::MOTION_NONE) {
+      deduplicate_geometry();
+    }
+
     /* Handle removed data and modified pointers, as this may free memory, delete Nodes in the
      * right order to ensure that dependent data is freed after their users. Objects should be
      * freed before particle systems and geometries. */
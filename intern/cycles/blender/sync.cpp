@@ -341,6 +341,7 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   }
 
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_PMJ);
@@ -851,6 +852,10 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   else
     params.bvh_type = BVH_TYPE_DYNAMIC;
 
+  /* With persistent data the scene is kept between frames. Applying transforms to the geometry
+   * would make every moved object rebuild its geometry and the whole scene BVH. */
+  params.use_bvh_static_transforms = !(background && b_scene.render().use_persistent_data());
+
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
@@ -875,6 +880,19 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
     params.texture_limit = 0;
   }
 
+  /* Texture memory limit is in megabytes. */
+  const int texture_memory_limit = RNA_int_get(
+      &cscene, background ? "texture_memory_limit_render" : "texture_memory_limit");
+  if (texture_memory_limit > 0 && b_scene.render().use_simplify()) {
+    params.texture_memory_limit = (size_t)texture_memory_limit * 1024 * 1024;
+  }
+  else {
+    params.texture_memory_limit = 0;
+  }
+
+  params.use_half_attributes = RNA_boolean_get(&cscene, "use_half_attributes");
+  params.use_texture_compression = RNA_boolean_get(&cscene, "use_texture_compression");
+
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
   params.background = background;
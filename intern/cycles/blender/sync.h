@@ -174,6 +174,8 @@ class BlenderSync {
                           bool use_particle_hair,
                           TaskPool *task_pool);
 
+  void deduplicate_geometry();
+
   void sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                             BObjectInfo &b_ob_info,
                             Object *object,
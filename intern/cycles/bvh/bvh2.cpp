@@ -15,6 +15,7 @@
 
 #include "util/foreach.h"
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -493,10 +494,6 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
 
   /* reserve */
   size_t prim_index_size = pack.prim_index.size();
-
-  size_t pack_prim_index_offset = prim_index_size;
-  size_t pack_nodes_offset = nodes_size;
-  size_t pack_leaf_nodes_offset = leaf_nodes_size;
   size_t object_offset = 0;
 
   foreach (Geometry *geom, geometry) {
@@ -530,9 +527,18 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
   int4 *pack_leaf_nodes = (pack.leaf_nodes.size()) ? &pack.leaf_nodes[0] : NULL;
   float2 *pack_prim_time = (pack.prim_time.size()) ? &pack.prim_time[0] : NULL;
 
+  /* Offsets of the data of an instanced geometry in the merged arrays. */
+  struct InstanceOffsets {
+    BVH2 *bvh;
+    int geom_prim_offset;
+    size_t prim_offset;
+    size_t nodes_offset;
+    size_t nodes_leaf_offset;
+  };
+  vector<InstanceOffsets> instances;
   unordered_map<Geometry *, int> geometry_map;
 
-  /* merge */
+  /* Compute the offsets of all instances first, so that their data can be merged in parallel. */
   foreach (Object *ob, objects) {
     Geometry *geom = ob->get_geometry();
 
@@ -558,7 +564,6 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
 
     int noffset = nodes_offset;
     int noffset_leaf = nodes_leaf_offset;
-    int geom_prim_offset = geom->prim_offset;
 
     /* fill in node indexes for instances */
     if (bvh->pack.root_index == -1)
@@ -568,81 +573,99 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
 
     geometry_map[geom] = pack.object_node[object_offset - 1];
 
-    /* merge primitive, object and triangle indexes */
-    if (bvh->pack.prim_index.size()) {
-      size_t bvh_prim_index_size = bvh->pack.prim_index.size();
-      int *bvh_prim_index = &bvh->pack.prim_index[0];
-      int *bvh_prim_type = &bvh->pack.prim_type[0];
-      uint *bvh_prim_visibility = &bvh->pack.prim_visibility[0];
-      float2 *bvh_prim_time = bvh->pack.prim_time.size() ? &bvh->pack.prim_time[0] : NULL;
-
-      for (size_t i = 0; i < bvh_prim_index_size; i++) {
-        pack_prim_index[pack_prim_index_offset] = bvh_prim_index[i] + geom_prim_offset;
-        pack_prim_type[pack_prim_index_offset] = bvh_prim_type[i];
-        pack_prim_visibility[pack_prim_index_offset] = bvh_prim_visibility[i];
-        pack_prim_object[pack_prim_index_offset] = 0;  // unused for instances
-        if (bvh_prim_time != NULL) {
-          pack_prim_time[pack_prim_index_offset] = bvh_prim_time[i];
+    instances.push_back(
+        {bvh, (int)geom->prim_offset, prim_offset, nodes_offset, nodes_leaf_offset});
+
+    nodes_offset += bvh->pack.nodes.size();
+    nodes_leaf_offset += bvh->pack.leaf_nodes.size();
+    prim_offset += bvh->pack.prim_index.size();
+  }
+
+  /* merge */
+  parallel_for(blocked_range<size_t>(0, instances.size(), 1), [&](const blocked_range<size_t> &r) {
+    for (size_t instance_index = r.begin(); instance_index != r.end(); instance_index++) {
+      const InstanceOffsets &instance = instances[instance_index];
+      BVH2 *bvh = instance.bvh;
+
+      const int noffset = instance.nodes_offset;
+      const int noffset_leaf = instance.nodes_leaf_offset;
+      const int geom_prim_offset = instance.geom_prim_offset;
+      size_t pack_prim_index_offset = instance.prim_offset;
+      size_t pack_nodes_offset = instance.nodes_offset;
+      size_t pack_leaf_nodes_offset = instance.nodes_leaf_offset;
+
+      /* merge primitive, object and triangle indexes */
+      if (bvh->pack.prim_index.size()) {
+        size_t bvh_prim_index_size = bvh->pack.prim_index.size();
+        int *bvh_prim_index = &bvh->pack.prim_index[0];
+        int *bvh_prim_type = &bvh->pack.prim_type[0];
+        uint *bvh_prim_visibility = &bvh->pack.prim_visibility[0];
+        float2 *bvh_prim_time = bvh->pack.prim_time.size() ? &bvh->pack.prim_time[0] : NULL;
+
+        for (size_t i = 0; i < bvh_prim_index_size; i++) {
+          pack_prim_index[pack_prim_index_offset] = bvh_prim_index[i] + geom_prim_offset;
+          pack_prim_type[pack_prim_index_offset] = bvh_prim_type[i];
+          pack_prim_visibility[pack_prim_index_offset] = bvh_prim_visibility[i];
+          pack_prim_object[pack_prim_index_offset] = 0;  // unused for instances
+          if (bvh_prim_time != NULL) {
+            pack_prim_time[pack_prim_index_offset] = bvh_prim_time[i];
+          }
+          pack_prim_index_offset++;
         }
-        pack_prim_index_offset++;
       }
-    }
 
-    /* merge nodes */
-    if (bvh->pack.leaf_nodes.size()) {
-      int4 *leaf_nodes_offset = &bvh->pack.leaf_nodes[0];
-      size_t leaf_nodes_offset_size = bvh->pack.leaf_nodes.size();
-      for (size_t i = 0, j = 0; i < leaf_nodes_offset_size; i += BVH_NODE_LEAF_SIZE, j++) {
-        int4 data = leaf_nodes_offset[i];
-        data.x += prim_offset;
-        data.y += prim_offset;
-        pack_leaf_nodes[pack_leaf_nodes_offset] = data;
-        for (int j = 1; j < BVH_NODE_LEAF_SIZE; ++j) {
-          pack_leaf_nodes[pack_leaf_nodes_offset + j] = leaf_nodes_offset[i + j];
+      /* merge nodes */
+      if (bvh->pack.leaf_nodes.size()) {
+        int4 *leaf_nodes_offset = &bvh->pack.leaf_nodes[0];
+        size_t leaf_nodes_offset_size = bvh->pack.leaf_nodes.size();
+        for (size_t i = 0, j = 0; i < leaf_nodes_offset_size; i += BVH_NODE_LEAF_SIZE, j++) {
+          int4 data = leaf_nodes_offset[i];
+          data.x += instance.prim_offset;
+          data.y += instance.prim_offset;
+          pack_leaf_nodes[pack_leaf_nodes_offset] = data;
+          for (int j = 1; j < BVH_NODE_LEAF_SIZE; ++j) {
+            pack_leaf_nodes[pack_leaf_nodes_offset + j] = leaf_nodes_offset[i + j];
+          }
+          pack_leaf_nodes_offset += BVH_NODE_LEAF_SIZE;
         }
-        pack_leaf_nodes_offset += BVH_NODE_LEAF_SIZE;
       }
-    }
 
-    if (bvh->pack.nodes.size()) {
-      int4 *bvh_nodes = &bvh->pack.nodes[0];
-      size_t bvh_nodes_size = bvh->pack.nodes.size();
+      if (bvh->pack.nodes.size()) {
+        int4 *bvh_nodes = &bvh->pack.nodes[0];
+        size_t bvh_nodes_size = bvh->pack.nodes.size();
 
-      for (size_t i = 0, j = 0; i < bvh_nodes_size; j++) {
-        size_t nsize, nsize_bbox;
-        if (bvh_nodes[i].x & PATH_RAY_NODE_UNALIGNED) {
-          nsize = BVH_UNALIGNED_NODE_SIZE;
-          nsize_bbox = 0;
-        }
-        else {
-          nsize = BVH_NODE_SIZE;
-          nsize_bbox = 0;
-        }
+        for (size_t i = 0, j = 0; i < bvh_nodes_size; j++) {
+          size_t nsize, nsize_bbox;
+          if (bvh_nodes[i].x & PATH_RAY_NODE_UNALIGNED) {
+            nsize = BVH_UNALIGNED_NODE_SIZE;
+            nsize_bbox = 0;
+          }
+          else {
+            nsize = BVH_NODE_SIZE;
+            nsize_bbox = 0;
+          }
 
-        memcpy(pack_nodes + pack_nodes_offset, bvh_nodes + i, nsize_bbox * sizeof(int4));
+          memcpy(pack_nodes + pack_nodes_offset, bvh_nodes + i, nsize_bbox * sizeof(int4));
 
-        /* Modify offsets into arrays */
-        int4 data = bvh_nodes[i + nsize_bbox];
-        data.z += (data.z < 0) ? -noffset_leaf : noffset;
-        data.w += (data.w < 0) ? -noffset_leaf : noffset;
-        pack_nodes[pack_nodes_offset + nsize_bbox] = data;
+          /* Modify offsets into arrays */
+          int4 data = bvh_nodes[i + nsize_bbox];
+          data.z += (data.z < 0) ? -noffset_leaf : noffset;
+          data.w += (data.w < 0) ? -noffset_leaf : noffset;
+          pack_nodes[pack_nodes_offset + nsize_bbox] = data;
 
-        /* Usually this copies nothing, but we better
-         * be prepared for possible node size extension.
-         */
-        memcpy(&pack_nodes[pack_nodes_offset + nsize_bbox + 1],
-               &bvh_nodes[i + nsize_bbox + 1],
-               sizeof(int4) * (nsize - (nsize_bbox + 1)));
+          /* Usually this copies nothing, but we better
+           * be prepared for possible node size extension.
+           */
+          memcpy(&pack_nodes[pack_nodes_offset + nsize_bbox + 1],
+                 &bvh_nodes[i + nsize_bbox + 1],
+                 sizeof(int4) * (nsize - (nsize_bbox + 1)));
 
-        pack_nodes_offset += nsize;
-        i += nsize;
+          pack_nodes_offset += nsize;
+          i += nsize;
+        }
       }
     }
-
-    nodes_offset += bvh->pack.nodes.size();
-    nodes_leaf_offset += bvh->pack.leaf_nodes.size();
-    prim_offset += bvh->pack.prim_index.size();
-  }
+  });
 }
 
 CCL_NAMESPACE_END
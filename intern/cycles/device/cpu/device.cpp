@@ -27,6 +27,7 @@ void device_cpu_info(vector<DeviceInfo> &devices)
   info.num = 0;
   info.has_osl = true;
   info.has_nanovdb = true;
+  info.has_bc1_textures = true;
   info.has_profiling = true;
   if (guiding_supported()) {
     info.has_guiding = true;
@@ -134,9 +134,11 @@ void device_cuda_info(vector<DeviceInfo> &devices)
     info.num = num;
 
     info.has_nanovdb = true;
+    info.has_bc1_textures = true;
     info.denoisers = 0;
 
     info.has_gpu_queue = true;
+    info.has_profiling = true;
 
     /* Check if the device has P2P access to any other device in the system. */
     for (int peer_num = 0; peer_num < count && !info.has_peer_memory; peer_num++) {
@@ -347,6 +347,10 @@ string CUDADevice::compile_kernel(const uint kernel_features,
 
   path_create_directories(cubin);
 
+  /* Compile into a temporary file, so that other processes sharing the cache directory never load
+   * a partially written kernel. */
+  const string cubin_tmp = path_temp_sibling(cubin);
+
   source_path = path_join(path_join(source_path, "kernel"),
                           path_join("device", path_join(base, string_printf("%s.cu", name))));
 
@@ -362,7 +366,7 @@ string CUDADevice::compile_kernel(const uint kernel_features,
       minor,
       kernel_ext,
       source_path.c_str(),
-      cubin.c_str(),
+      cubin_tmp.c_str(),
       common_cflags.c_str());
 
   printf("Compiling %sCUDA kernel ...\n%s\n",
@@ -373,6 +377,7 @@ string CUDADevice::compile_kernel(const uint kernel_features,
   command = "call " + command;
 #  endif
   if (system(command.c_str()) != 0) {
+    path_remove(cubin_tmp);
     set_error(
         "Failed to execute compilation command, "
         "see console for details.");
@@ -380,6 +385,9 @@ string CUDADevice::compile_kernel(const uint kernel_features,
   }
 
   /* Verify if compilation succeeded */
+  if (path_exists(cubin_tmp) && !path_rename(cubin_tmp, cubin)) {
+    path_remove(cubin_tmp);
+  }
   if (!path_exists(cubin)) {
     set_error(
         "CUDA kernel compilation failed, "
@@ -556,7 +564,7 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
     /* Find suitable memory allocation to move. */
     device_memory *max_mem = NULL;
     size_t max_size = 0;
-    bool max_is_image = false;
+    int max_priority = 0;
 
     thread_scoped_lock lock(cuda_mem_map_mutex);
     foreach (CUDAMemMap::value_type &pair, cuda_mem_map) {
@@ -583,9 +591,15 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
         continue;
       }
 
-      /* Try to move largest allocation, prefer moving images. */
-      if (is_image > max_is_image || (is_image == max_is_image && mem.device_size > max_size)) {
-        max_is_image = is_image;
+      /* Try to move largest allocation, in the order of the memory priority for host mapping
+       * so memory that is accessed less often by the kernels is moved first. */
+      const int priority = mem.host_mapped_priority();
+      if (priority < 0) {
+        continue;
+      }
+      if (!max_mem || priority < max_priority ||
+          (priority == max_priority && mem.device_size > max_size)) {
+        max_priority = priority;
         max_size = mem.device_size;
         max_mem = &mem;
       }
@@ -683,6 +697,10 @@ CUDADevice::CUDAMem *CUDADevice::generic_alloc(device_memory &mem, size_t pitch_
 
       assert((mem_alloc_result == CUDA_SUCCESS && shared_pointer != 0) ||
              (mem_alloc_result != CUDA_SUCCESS && shared_pointer == 0));
+
+      if (mem_alloc_result == CUDA_SUCCESS) {
+        stats.mem_host_map(size);
+      }
     }
 
     if (mem_alloc_result == CUDA_SUCCESS) {
@@ -788,6 +806,7 @@ void CUDADevice::generic_free(device_memory &mem)
             mem.host_pointer = 0;
           }
           cuMemFreeHost(mem.shared_pointer);
+          stats.mem_host_unmap(mem.device_size);
           mem.shared_pointer = 0;
         }
       }
@@ -1100,7 +1119,8 @@ void CUDADevice::tex_alloc(device_texture &mem)
   if (mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FLOAT &&
       mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FLOAT3 &&
       mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FPN &&
-      mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FP16) {
+      mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FP16 &&
+      mem.info.data_type != IMAGE_DATA_TYPE_BC1) {
     CUDA_RESOURCE_DESC resDesc;
     memset(&resDesc, 0, sizeof(resDesc));
 
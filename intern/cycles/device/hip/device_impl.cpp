@@ -316,6 +316,10 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
 
   path_create_directories(fatbin);
 
+  /* Compile into a temporary file, so that other processes sharing the cache directory never load
+   * a partially written kernel. */
+  const string fatbin_tmp = path_temp_sibling(fatbin);
+
   source_path = path_join(path_join(source_path, "kernel"),
                           path_join("device", path_join(base, string_printf("%s.cpp", name))));
 
@@ -325,7 +329,7 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
                                  include_path.c_str(),
                                  kernel_ext,
                                  source_path.c_str(),
-                                 fatbin.c_str());
+                                 fatbin_tmp.c_str());
 
   printf("Compiling %sHIP kernel ...\n%s\n",
          (use_adaptive_compilation()) ? "adaptive " : "",
@@ -335,6 +339,7 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
   command = "call " + command;
 #  endif
   if (system(command.c_str()) != 0) {
+    path_remove(fatbin_tmp);
     set_error(
         "Failed to execute compilation command, "
         "see console for details.");
@@ -342,6 +347,9 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
   }
 
   /* Verify if compilation succeeded */
+  if (path_exists(fatbin_tmp) && !path_rename(fatbin_tmp, fatbin)) {
+    path_remove(fatbin_tmp);
+  }
   if (!path_exists(fatbin)) {
     set_error(
         "HIP kernel compilation failed, "
@@ -517,7 +525,7 @@ void HIPDevice::move_textures_to_host(size_t size, bool for_texture)
     /* Find suitable memory allocation to move. */
     device_memory *max_mem = NULL;
     size_t max_size = 0;
-    bool max_is_image = false;
+    int max_priority = 0;
 
     thread_scoped_lock lock(hip_mem_map_mutex);
     foreach (HIPMemMap::value_type &pair, hip_mem_map) {
@@ -544,9 +552,15 @@ void HIPDevice::move_textures_to_host(size_t size, bool for_texture)
         continue;
       }
 
-      /* Try to move largest allocation, prefer moving images. */
-      if (is_image > max_is_image || (is_image == max_is_image && mem.device_size > max_size)) {
-        max_is_image = is_image;
+      /* Try to move largest allocation, in the order of the memory priority for host mapping
+       * so memory that is accessed less often by the kernels is moved first. */
+      const int priority = mem.host_mapped_priority();
+      if (priority < 0) {
+        continue;
+      }
+      if (!max_mem || priority < max_priority ||
+          (priority == max_priority && mem.device_size > max_size)) {
+        max_priority = priority;
         max_size = mem.device_size;
         max_mem = &mem;
       }
@@ -644,6 +658,10 @@ HIPDevice::HIPMem *HIPDevice::generic_alloc(device_memory &mem, size_t pitch_pad
 
       assert((mem_alloc_result == hipSuccess && shared_pointer != 0) ||
              (mem_alloc_result != hipSuccess && shared_pointer == 0));
+
+      if (mem_alloc_result == hipSuccess) {
+        stats.mem_host_map(size);
+      }
     }
 
     if (mem_alloc_result == hipSuccess) {
@@ -743,6 +761,7 @@ void HIPDevice::generic_free(device_memory &mem)
             mem.host_pointer = 0;
           }
           hipHostFree(mem.shared_pointer);
+          stats.mem_host_unmap(mem.device_size);
           mem.shared_pointer = 0;
         }
       }
@@ -1057,7 +1076,8 @@ void HIPDevice::tex_alloc(device_texture &mem)
   if (mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FLOAT &&
       mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FLOAT3 &&
       mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FPN &&
-      mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FP16) {
+      mem.info.data_type != IMAGE_DATA_TYPE_NANOVDB_FP16 &&
+      mem.info.data_type != IMAGE_DATA_TYPE_BC1) {
     /* Bindless textures. */
     hipResourceDesc resDesc;
     memset(&resDesc, 0, sizeof(resDesc));
@@ -127,6 +127,23 @@ bool device_memory::is_resident(Device *sub_device) const
   return device->is_resident(device_pointer, sub_device);
 }
 
+int device_memory::host_mapped_priority() const
+{
+  if (type == MEM_TEXTURE) {
+    return 0;
+  }
+  if (type != MEM_GLOBAL) {
+    return -1;
+  }
+  if (string_startswith(name, "attributes_")) {
+    return 1;
+  }
+  if (string_startswith(name, "prim_") || strcmp(name, "bvh_leaf_nodes") == 0) {
+    return 2;
+  }
+  return 3;
+}
+
 /* Device Sub Ptr */
 
 device_sub_ptr::device_sub_ptr(device_memory &mem, size_t offset, size_t size) : device(mem.device)
@@ -186,6 +203,11 @@ device_texture::device_texture(Device *device,
       data_type = TYPE_UINT16;
       data_elements = 1;
       break;
+    case IMAGE_DATA_TYPE_BC1:
+      /* One 64 bit block per 4x4 texels. */
+      data_type = TYPE_UINT;
+      data_elements = 2;
+      break;
     case IMAGE_DATA_NUM_TYPES:
       assert(0);
       return;
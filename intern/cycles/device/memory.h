@@ -246,6 +246,11 @@ class device_memory {
 
   bool is_resident(Device *sub_device) const;
 
+  /* Order in which memory is moved to mapped host memory when device memory runs out, lowest
+   * first. Images are accessed the least per sample and are moved first, followed by geometry
+   * attributes and then BVH leaves. Returns -1 for memory that should stay on the device. */
+  int host_mapped_priority() const;
+
  protected:
   friend class CUDADevice;
   friend class OptiXDevice;
@@ -640,10 +640,17 @@ void MetalKernelPipeline::compile()
 
     if (@available(macOS 11.0, *)) {
       if (creating_new_archive || recreate_archive) {
-        if (![archive serializeToURL:[NSURL fileURLWithPath:@(metalbin_path.c_str())]
+        /* Write to a temporary file first, the cache directory may be shared with other
+         * processes. */
+        const string metalbin_tmp_path = path_temp_sibling(metalbin_path);
+        if (![archive serializeToURL:[NSURL fileURLWithPath:@(metalbin_tmp_path.c_str())]
                                error:&error]) {
           metal_printf("Failed to save binary archive, error:\n%s\n",
                        [[error localizedDescription] UTF8String]);
+          path_remove(metalbin_tmp_path);
+        }
+        else if (!path_rename(metalbin_tmp_path, metalbin_path)) {
+          path_remove(metalbin_tmp_path);
         }
       }
     }
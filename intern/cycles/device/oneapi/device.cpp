@@ -146,9 +146,11 @@ static void device_iterator_cb(const char *id, const char *name, int num, void *
   info.id = id;
 
   info.has_nanovdb = true;
+  info.has_bc1_textures = true;
   info.denoisers = 0;
 
   info.has_gpu_queue = true;
+  info.has_profiling = true;
 
   /* NOTE(@nsirgien): oneAPI right now is focused on one device usage. In future it maybe will
    * change, but right now peer access from one device to another device is not supported. */
@@ -15,7 +15,10 @@ DeviceQueue::DeviceQueue(Device *device)
     : device(device),
       last_kernels_enqueued_(0),
       last_sync_time_(0.0),
-      is_per_kernel_performance_(false)
+      is_per_kernel_performance_(false),
+      use_profiling_(false),
+      profiling_kernel_(DEVICE_KERNEL_NUM),
+      profiling_start_time_(0.0)
 {
   DCHECK_NE(device, nullptr);
   is_per_kernel_performance_ = getenv("CYCLES_DEBUG_PER_KERNEL_PERFORMANCE");
@@ -68,11 +71,25 @@ void DeviceQueue::debug_enqueue_begin(DeviceKernel kernel, const int work_size)
   }
 
   last_kernels_enqueued_ |= (uint64_t(1) << (uint64_t)kernel);
+
+  if (use_profiling_) {
+    DeviceKernelStats &kernel_stats = stats_kernel_[kernel];
+    kernel_stats.num_launches++;
+    kernel_stats.work_size += work_size;
+
+    profiling_kernel_ = kernel;
+    profiling_start_time_ = time_dt();
+  }
 }
 
 void DeviceQueue::debug_enqueue_end()
 {
-  if (VLOG_DEVICE_STATS_IS_ON && is_per_kernel_performance_) {
+  if (use_profiling_) {
+    /* Wait for the kernel to finish, so that its time is not mixed with other kernels. */
+    synchronize();
+    stats_kernel_[profiling_kernel_].time += time_dt() - profiling_start_time_;
+  }
+  else if (VLOG_DEVICE_STATS_IS_ON && is_per_kernel_performance_) {
     synchronize();
   }
 }
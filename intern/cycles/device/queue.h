@@ -87,6 +87,16 @@ struct DeviceKernelArguments {
   }
 };
 
+/* Execution statistics of a kernel on a queue. */
+struct DeviceKernelStats {
+  /* Number of times the kernel was enqueued. */
+  uint64_t num_launches = 0;
+  /* Total number of work items over all launches. */
+  uint64_t work_size = 0;
+  /* Accumulated execution time in seconds. */
+  double time = 0.0;
+};
+
 /* Abstraction of a command queue for a device.
  * Provides API to schedule kernel execution in a specific queue with minimal possible overhead
  * from driver side.
@@ -153,6 +163,19 @@ class DeviceQueue {
     return nullptr;
   }
 
+  /* Collect per-kernel execution statistics. This adds a queue synchronization after every
+   * kernel launch, so it is only to be enabled for profiling. */
+  void set_use_profiling(bool use_profiling)
+  {
+    use_profiling_ = use_profiling;
+  }
+
+  /* Per-kernel execution statistics, collected since profiling was enabled. */
+  const map<DeviceKernel, DeviceKernelStats> &get_kernel_stats() const
+  {
+    return stats_kernel_;
+  }
+
   /* Device this queue has been created for. */
   Device *device;
 
@@ -176,6 +199,13 @@ class DeviceQueue {
   /* If it is true, then a performance statistics in the debugging logs will have focus on kernels
    * and an explicit queue synchronization will be added after each kernel execution. */
   bool is_per_kernel_performance_;
+  /* Collect per-kernel statistics, see set_use_profiling(). */
+  bool use_profiling_;
+  /* Kernel enqueued last and the time it was enqueued, for profiling. */
+  DeviceKernel profiling_kernel_;
+  double profiling_start_time_;
+  /* Accumulated statistics of individual kernels. */
+  map<DeviceKernel, DeviceKernelStats> stats_kernel_;
 };
 
 CCL_NAMESPACE_END
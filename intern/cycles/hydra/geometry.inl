@@ -177,8 +177,12 @@ void HdCyclesGeometry<Base, CyclesBase>::Sync(HdSceneDelegate *sceneDelegate,
     _geom->tag_update(lock.scene, rebuild);
   }
 
+  // Only tag instances that actually changed, since tagging any object causes the object and
+  // light managers to update all objects
   for (Object *instance : _instances) {
-    instance->tag_update(lock.scene);
+    if (instance->is_modified()) {
+      instance->tag_update(lock.scene);
+    }
   }
 
   *dirtyBits = HdChangeTracker::Clean;
@@ -110,8 +110,14 @@ HdDirtyBits HdCyclesMesh::GetInitialDirtyBitsMask() const
 HdDirtyBits HdCyclesMesh::_PropagateDirtyBits(HdDirtyBits bits) const
 {
   if (bits & (HdChangeTracker::DirtyMaterialId)) {
-    // Update used shaders from geometry subsets if any exist in the topology
-    bits |= HdChangeTracker::DirtyTopology;
+    // Update used shaders from geometry subsets if any exist in the topology, otherwise only the
+    // primvars required by the new material need updating, which avoids a BVH rebuild
+    if (!_topology.GetGeomSubsets().empty()) {
+      bits |= HdChangeTracker::DirtyTopology;
+    }
+    else {
+      bits |= HdChangeTracker::DirtyPrimvar;
+    }
   }
 
   if (bits & (HdChangeTracker::DirtyTopology | HdChangeTracker::DirtyDisplayStyle |
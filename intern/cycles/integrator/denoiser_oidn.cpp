@@ -9,9 +9,11 @@
 #include "device/queue.h"
 #include "integrator/pass_accessor_cpu.h"
 #include "session/buffers.h"
+#include "util/algorithm.h"
 #include "util/array.h"
 #include "util/log.h"
 #include "util/openimagedenoise.h"
+#include "util/tbb.h"
 
 #include "kernel/device/cpu/compat.h"
 #include "kernel/device/cpu/kernel.h"
@@ -20,12 +22,25 @@ CCL_NAMESPACE_BEGIN
 
 thread_mutex OIDNDenoiser::mutex_;
 
+class OIDNDenoiser::State {
+ public:
+#ifdef WITH_OPENIMAGEDENOISE
+  /* Lazily created on the first denoising request. */
+  oidn::DeviceRef oidn_device;
+#endif
+};
+
 OIDNDenoiser::OIDNDenoiser(Device *path_trace_device, const DenoiseParams &params)
-    : Denoiser(path_trace_device, params)
+    : Denoiser(path_trace_device, params), state_(make_unique<State>())
 {
   DCHECK_EQ(params.type, DENOISER_OPENIMAGEDENOISE);
 }
 
+OIDNDenoiser::~OIDNDenoiser()
+{
+  /* Explicit destructor, so that the State is a complete type at the point of its destruction. */
+}
+
 #ifdef WITH_OPENIMAGEDENOISE
 static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
 {
@@ -90,12 +105,14 @@ class OIDNPass {
 class OIDNDenoiseContext {
  public:
   OIDNDenoiseContext(OIDNDenoiser *denoiser,
+                     oidn::DeviceRef &oidn_device,
                      const DenoiseParams &denoise_params,
                      const BufferParams &buffer_params,
                      RenderBuffers *render_buffers,
                      const int num_samples,
                      const bool allow_inplace_modification)
       : denoiser_(denoiser),
+        oidn_device_(oidn_device),
         denoise_params_(denoise_params),
         buffer_params_(buffer_params),
         render_buffers_(render_buffers),
@@ -150,13 +167,9 @@ class OIDNDenoiseContext {
 
     OIDNPass oidn_color_access_pass = read_input_pass(oidn_color_pass, oidn_output_pass);
 
-    oidn::DeviceRef oidn_device = oidn::newDevice();
-    oidn_device.set("setAffinity", false);
-    oidn_device.commit();
-
     /* Create a filter for denoising a beauty (color) image using prefiltered auxiliary images too.
      */
-    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    oidn::FilterRef oidn_filter = oidn_device_.newFilter("RT");
     set_input_pass(oidn_filter, oidn_color_access_pass);
     set_guiding_passes(oidn_filter, oidn_color_pass);
     set_output_pass(oidn_filter, oidn_output_pass);
@@ -169,15 +182,15 @@ class OIDNDenoiseContext {
     }
     oidn_filter.commit();
 
-    filter_guiding_pass_if_needed(oidn_device, oidn_albedo_pass_);
-    filter_guiding_pass_if_needed(oidn_device, oidn_normal_pass_);
+    filter_guiding_pass_if_needed(oidn_albedo_pass_);
+    filter_guiding_pass_if_needed(oidn_normal_pass_);
 
     /* Filter the beauty image. */
     oidn_filter.execute();
 
     /* Check for errors. */
     const char *error_message;
-    const oidn::Error error = oidn_device.getError(error_message);
+    const oidn::Error error = oidn_device_.getError(error_message);
     if (error != oidn::Error::None && error != oidn::Error::Cancelled) {
       LOG(ERROR) << "OpenImageDenoise error: " << error_message;
     }
@@ -186,14 +199,14 @@ class OIDNDenoiseContext {
   }
 
  protected:
-  void filter_guiding_pass_if_needed(oidn::DeviceRef &oidn_device, OIDNPass &oidn_pass)
+  void filter_guiding_pass_if_needed(OIDNPass &oidn_pass)
   {
     if (denoise_params_.prefilter != DENOISER_PREFILTER_ACCURATE || !oidn_pass ||
         oidn_pass.is_filtered) {
       return;
     }
 
-    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    oidn::FilterRef oidn_filter = oidn_device_.newFilter("RT");
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
     oidn_filter.commit();
@@ -382,9 +395,7 @@ class OIDNDenoiseContext {
       const int64_t num_pixel_components = width * height * 3;
       oidn_albedo_pass_.scaled_buffer.resize(num_pixel_components);
 
-      for (int i = 0; i < num_pixel_components; ++i) {
-        oidn_albedo_pass_.scaled_buffer[i] = 0.5f;
-      }
+      std::fill_n(oidn_albedo_pass_.scaled_buffer.data(), num_pixel_components, 0.5f);
 
       albedo_replaced_with_fake_ = true;
     }
@@ -420,10 +431,12 @@ class OIDNDenoiseContext {
     const bool has_pass_sample_count = (pass_sample_count_ != PASS_UNUSED);
     const bool need_scale = has_pass_sample_count || oidn_input_pass.use_compositing;
 
-    for (int y = 0; y < height; ++y) {
-      float *buffer_row = buffer_data + buffer_offset + y * row_stride;
-      for (int x = 0; x < width; ++x) {
-        float *buffer_pixel = buffer_row + x * pass_stride;
+    /* Rows are independent, so process them in parallel the same way as the pass accessor does
+     * when reading the input passes. */
+    parallel_for(int64_t(0), height, [&](int64_t row) {
+      float *buffer_row = buffer_data + buffer_offset + row * row_stride;
+      for (int64_t col = 0; col < width; ++col) {
+        float *buffer_pixel = buffer_row + col * pass_stride;
         float *denoised_pixel = buffer_pixel + oidn_output_pass.offset;
 
         if (need_scale) {
@@ -452,7 +465,7 @@ class OIDNDenoiseContext {
           denoised_pixel[3] = 0;
         }
       }
-    }
+    });
   }
 
   bool is_pass_scale_needed(OIDNPass &oidn_pass) const
@@ -494,10 +507,10 @@ class OIDNDenoiseContext {
 
     const bool has_pass_sample_count = (pass_sample_count_ != PASS_UNUSED);
 
-    for (int y = 0; y < height; ++y) {
-      float *buffer_row = buffer_data + buffer_offset + y * row_stride;
-      for (int x = 0; x < width; ++x) {
-        float *buffer_pixel = buffer_row + x * pass_stride;
+    parallel_for(int64_t(0), height, [&](int64_t row) {
+      float *buffer_row = buffer_data + buffer_offset + row * row_stride;
+      for (int64_t col = 0; col < width; ++col) {
+        float *buffer_pixel = buffer_row + col * pass_stride;
         float *pass_pixel = buffer_pixel + oidn_pass.offset;
 
         const float pixel_scale = 1.0f / (has_pass_sample_count ?
@@ -508,10 +521,11 @@ class OIDNDenoiseContext {
         pass_pixel[1] = pass_pixel[1] * pixel_scale;
         pass_pixel[2] = pass_pixel[2] * pixel_scale;
       }
-    }
+    });
   }
 
   OIDNDenoiser *denoiser_ = nullptr;
+  oidn::DeviceRef &oidn_device_;
 
   const DenoiseParams &denoise_params_;
   const BufferParams &buffer_params_;
@@ -580,8 +594,19 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
   unique_ptr<DeviceQueue> queue = create_device_queue(render_buffers);
   copy_render_buffers_from_device(queue, render_buffers);
 
-  OIDNDenoiseContext context(
-      this, params_, buffer_params, render_buffers, num_samples, allow_inplace_modification);
+  if (!state_->oidn_device) {
+    state_->oidn_device = oidn::newDevice();
+    state_->oidn_device.set("setAffinity", false);
+    state_->oidn_device.commit();
+  }
+
+  OIDNDenoiseContext context(this,
+                             state_->oidn_device,
+                             params_,
+                             buffer_params,
+                             render_buffers,
+                             num_samples,
+                             allow_inplace_modification);
 
   if (context.need_denoising()) {
     context.read_guiding_passes();
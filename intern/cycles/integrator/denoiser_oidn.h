@@ -17,6 +17,7 @@ class OIDNDenoiser : public Denoiser {
   class State;
 
   OIDNDenoiser(Device *path_trace_device, const DenoiseParams &params);
+  ~OIDNDenoiser();
 
   virtual bool denoise_buffer(const BufferParams &buffer_params,
                               RenderBuffers *render_buffers,
@@ -30,6 +31,10 @@ class OIDNDenoiser : public Denoiser {
   /* We only perform one denoising at a time, since OpenImageDenoise itself is multithreaded.
    * Use this mutex whenever images are passed to the OIDN and needs to be denoised. */
   static thread_mutex mutex_;
+
+  /* Reused between denoising calls, so that the OIDN device is not re-created for every pass and
+   * every viewport update. Is only accessed with the mutex locked. */
+  unique_ptr<State> state_;
 };
 
 CCL_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include "integrator/render_scheduler.h"
 #include "scene/pass.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/tile.h"
 #include "util/algorithm.h"
 #include "util/log.h"
@@ -117,6 +118,12 @@ void PathTrace::reset(const BufferParams &full_params,
 
   full_params_ = full_params;
 
+  /* Pixels that converged with adaptive sampling are active again after a reset. */
+  if (reset_rendering && !work_row_costs_.empty()) {
+    work_row_costs_.clear();
+    render_state_.need_reset_params = true;
+  }
+
   /* NOTE: GPU display checks for buffer modification and avoids unnecessary re-allocation.
    * It is requires to inform about reset whenever it happens, so that the redraw state tracking is
    * properly updated. */
@@ -240,34 +247,24 @@ void PathTrace::render_init_kernel_execution()
 template<typename Callback>
 static void foreach_sliced_buffer_params(const vector<unique_ptr<PathTraceWork>> &path_trace_works,
                                          const vector<WorkBalanceInfo> &work_balance_infos,
+                                         const vector<float> &row_costs,
                                          const BufferParams &buffer_params,
                                          const int overscan,
                                          const Callback &callback)
 {
   const int num_works = path_trace_works.size();
-  const int window_height = buffer_params.window_height;
+  const vector<int> slice_rows = work_balance_split_rows(
+      work_balance_infos, row_costs, buffer_params.window_height);
 
   int current_y = 0;
   for (int i = 0; i < num_works; ++i) {
-    const double weight = work_balance_infos[i].weight;
     const int slice_window_full_y = buffer_params.full_y + buffer_params.window_y + current_y;
-    const int slice_window_height = max(lround(window_height * weight), 1);
-
-    /* Disallow negative values to deal with situations when there are more compute devices than
-     * scan-lines. */
-    const int remaining_window_height = max(0, window_height - current_y);
 
     BufferParams slice_params = buffer_params;
 
     slice_params.full_y = max(slice_window_full_y - overscan, buffer_params.full_y);
     slice_params.window_y = slice_window_full_y - slice_params.full_y;
-
-    if (i < num_works - 1) {
-      slice_params.window_height = min(slice_window_height, remaining_window_height);
-    }
-    else {
-      slice_params.window_height = remaining_window_height;
-    }
+    slice_params.window_height = slice_rows[i];
 
     slice_params.height = slice_params.window_y + slice_params.window_height + overscan;
     slice_params.height = min(slice_params.height,
@@ -286,6 +283,7 @@ void PathTrace::update_allocated_work_buffer_params()
   const int overscan = tile_manager_.get_tile_overscan();
   foreach_sliced_buffer_params(path_trace_works_,
                                work_balance_infos_,
+                               work_row_costs_,
                                big_tile_params_,
                                overscan,
                                [](PathTraceWork *path_trace_work, const BufferParams &params) {
@@ -328,6 +326,7 @@ void PathTrace::update_effective_work_buffer_params(const RenderWork &render_wor
 
   foreach_sliced_buffer_params(path_trace_works_,
                                work_balance_infos_,
+                               work_row_costs_,
                                scaled_big_tile_params,
                                overscan,
                                [&](PathTraceWork *path_trace_work, const BufferParams params) {
@@ -669,6 +668,32 @@ void PathTrace::update_display(const RenderWork &render_work)
   render_scheduler_.report_display_update_time(render_work, time_dt() - start_time);
 }
 
+/* Cost of rendering every row of the window, based on the number of pixels which did not converge
+ * yet with adaptive sampling. */
+static vector<float> calculate_row_costs(RenderBuffers &buffers)
+{
+  const BufferParams &params = buffers.params;
+  const int aux_w_offset = params.get_pass_offset(PASS_ADAPTIVE_AUX_BUFFER) + 3;
+  const float *buffer = buffers.buffer.data();
+
+  vector<float> row_costs(params.window_height);
+  parallel_for(0, params.window_height, [&](int y) {
+    const float *row_buffer = buffer + (int64_t(params.window_y + y) * params.width +
+                                        params.window_x) *
+                                           params.pass_stride;
+    int num_active_pixels = 0;
+    for (int x = 0; x < params.window_width; x++) {
+      if (row_buffer[x * params.pass_stride + aux_w_offset] == 0.0f) {
+        num_active_pixels++;
+      }
+    }
+    /* Converged pixels still have some cost, and slices must never have zero cost. */
+    row_costs[y] = num_active_pixels + 0.01f * params.window_width;
+  });
+
+  return row_costs;
+}
+
 void PathTrace::rebalance(const RenderWork &render_work)
 {
   if (!render_work.rebalance) {
@@ -703,17 +728,39 @@ void PathTrace::rebalance(const RenderWork &render_work)
     }
   }
 
-  if (!did_rebalance) {
+  /* With adaptive sampling the cost of rows changes a lot while pixels converge, so the rows are
+   * split again based on the number of active pixels, even when the weights did not change. */
+  const BufferParams &effective_big_tile_params = render_state_.effective_big_tile_params;
+  const bool use_row_costs = render_work.resolution_divider == 1 &&
+                             effective_big_tile_params.get_pass_offset(
+                                 PASS_ADAPTIVE_AUX_BUFFER) != PASS_UNUSED;
+
+  if (!did_rebalance && !use_row_costs) {
     VLOG_WORK << "Balance in path trace works did not change.";
     render_scheduler_.report_rebalance_time(render_work, time_dt() - start_time, false);
     return;
   }
 
   RenderBuffers big_tile_cpu_buffers(cpu_device_.get());
-  big_tile_cpu_buffers.reset(render_state_.effective_big_tile_params);
+  big_tile_cpu_buffers.reset(effective_big_tile_params);
 
   copy_to_render_buffers(&big_tile_cpu_buffers);
 
+  if (use_row_costs) {
+    const int num_rows = effective_big_tile_params.window_height;
+    vector<float> row_costs = calculate_row_costs(big_tile_cpu_buffers);
+    const bool slices_changed = work_balance_split_rows(
+                                    work_balance_infos_, work_row_costs_, num_rows) !=
+                                work_balance_split_rows(work_balance_infos_, row_costs, num_rows);
+    work_row_costs_ = std::move(row_costs);
+
+    if (!did_rebalance && !slices_changed) {
+      VLOG_WORK << "Balance in path trace works did not change.";
+      render_scheduler_.report_rebalance_time(render_work, time_dt() - start_time, false);
+      return;
+    }
+  }
+
   render_state_.need_reset_params = true;
   update_work_buffer_params_if_needed(render_work);
 
@@ -1255,6 +1302,27 @@ string PathTrace::full_report() const
   return result;
 }
 
+void PathTrace::set_use_profiling(bool use_profiling)
+{
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->set_use_profiling(use_profiling);
+  }
+}
+
+void PathTrace::collect_statistics(RenderStats *render_stats) const
+{
+  map<DeviceKernel, DeviceKernelStats> kernel_stats;
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->collect_kernel_stats(kernel_stats);
+  }
+
+  render_stats->device.kernels.clear();
+  for (const auto &[kernel, stats] : kernel_stats) {
+    render_stats->device.kernels.emplace_back(
+        device_kernel_as_string(kernel), stats.num_launches, stats.work_size, stats.time);
+  }
+}
+
 void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bool reset)
 {
 #ifdef WITH_PATH_GUIDING
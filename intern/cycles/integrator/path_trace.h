@@ -26,6 +26,7 @@ class DisplayDriver;
 class Film;
 class RenderBuffers;
 class RenderScheduler;
+class RenderStats;
 class RenderWork;
 class PathTraceDisplay;
 class OutputDriver;
@@ -174,6 +175,13 @@ class PathTrace {
    * times, and so on. */
   string full_report() const;
 
+  /* Collect per-kernel execution statistics on the GPU devices. This synchronizes the device
+   * queues after every kernel launch, so is only to be enabled for profiling. */
+  void set_use_profiling(bool use_profiling);
+
+  /* Add the per-kernel execution statistics of all devices to the render statistics. */
+  void collect_statistics(RenderStats *render_stats) const;
+
   /* Callback which is called to report current rendering progress.
    *
    * It is supposed to be cheaper than buffer update/write, hence can be called more often.
@@ -272,6 +280,10 @@ class PathTrace {
   /* Per-path trace work information needed for multi-device balancing. */
   vector<WorkBalanceInfo> work_balance_infos_;
 
+  /* Cost of rendering every row of the big tile, used to split the big tile into slices for the
+   * works. Empty when all rows cost the same. */
+  vector<float> work_row_costs_;
+
   /* Render buffer parameters of the full frame and current big tile. */
   BufferParams full_params_;
   BufferParams big_tile_params_;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "device/queue.h"
 #include "integrator/pass_accessor.h"
 #include "scene/pass.h"
 #include "session/buffers.h"
@@ -125,6 +126,17 @@ class PathTraceWork {
   /* Run cryptomatte pass post-processing kernels. */
   virtual void cryptomatte_postproces() = 0;
 
+  /* Collect per-kernel execution statistics, for works which execute kernels on a device
+   * queue. */
+  virtual void set_use_profiling(bool /*use_profiling*/)
+  {
+  }
+
+  /* Accumulate per-kernel execution statistics collected since profiling was enabled. */
+  virtual void collect_kernel_stats(map<DeviceKernel, DeviceKernelStats> & /*kernel_stats*/) const
+  {
+  }
+
   /* Cheap-ish request to see whether rendering is requested and is to be stopped as soon as
    * possible, without waiting for any samples to be finished. */
   inline bool is_cancel_requested() const
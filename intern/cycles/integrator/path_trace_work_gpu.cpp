@@ -1057,6 +1057,22 @@ void PathTraceWorkGPU::cryptomatte_postproces()
   queue_->enqueue(DEVICE_KERNEL_CRYPTOMATTE_POSTPROCESS, work_size, args);
 }
 
+void PathTraceWorkGPU::set_use_profiling(bool use_profiling)
+{
+  queue_->set_use_profiling(use_profiling);
+}
+
+void PathTraceWorkGPU::collect_kernel_stats(
+    map<DeviceKernel, DeviceKernelStats> &kernel_stats) const
+{
+  for (const auto &[kernel, stats] : queue_->get_kernel_stats()) {
+    DeviceKernelStats &total_stats = kernel_stats[kernel];
+    total_stats.num_launches += stats.num_launches;
+    total_stats.work_size += stats.work_size;
+    total_stats.time += stats.time;
+  }
+}
+
 bool PathTraceWorkGPU::copy_render_buffers_from_device()
 {
   queue_->copy_from_device(buffers_->buffer);
@@ -48,6 +48,10 @@ class PathTraceWorkGPU : public PathTraceWork {
   virtual int adaptive_sampling_converge_filter_count_active(float threshold, bool reset) override;
   virtual void cryptomatte_postproces() override;
 
+  virtual void set_use_profiling(bool use_profiling) override;
+  virtual void collect_kernel_stats(
+      map<DeviceKernel, DeviceKernelStats> &kernel_stats) const override;
+
  protected:
   void alloc_integrator_soa();
   void alloc_integrator_queue();
@@ -83,4 +83,59 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
   return true;
 }
 
+vector<int> work_balance_split_rows(const vector<WorkBalanceInfo> &work_balance_infos,
+                                    const vector<float> &row_costs,
+                                    const int num_rows)
+{
+  const int num_infos = work_balance_infos.size();
+  vector<int> slice_rows(num_infos, 0);
+
+  if (int(row_costs.size()) != num_rows) {
+    int current_row = 0;
+    for (int i = 0; i < num_infos; ++i) {
+      /* Disallow negative values to deal with situations when there are more compute devices
+       * than scan-lines. */
+      const int remaining_rows = max(0, num_rows - current_row);
+      if (i < num_infos - 1) {
+        const int rows = max(int(lround(num_rows * work_balance_infos[i].weight)), 1);
+        slice_rows[i] = min(rows, remaining_rows);
+      }
+      else {
+        slice_rows[i] = remaining_rows;
+      }
+      current_row += slice_rows[i];
+    }
+    return slice_rows;
+  }
+
+  double total_cost = 0;
+  for (const float cost : row_costs) {
+    total_cost += cost;
+  }
+
+  double weight_accum = 0;
+  double cost_accum = 0;
+  int current_row = 0;
+  for (int i = 0; i < num_infos - 1; ++i) {
+    weight_accum += work_balance_infos[i].weight;
+    const double target_cost = weight_accum * total_cost;
+
+    int end_row = min(current_row + 1, num_rows);
+    for (int row = current_row; row < end_row; ++row) {
+      cost_accum += row_costs[row];
+    }
+    /* Add rows while that brings the cost closer to the target. */
+    while (end_row < num_rows && cost_accum + 0.5 * row_costs[end_row] <= target_cost) {
+      cost_accum += row_costs[end_row];
+      end_row++;
+    }
+
+    slice_rows[i] = end_row - current_row;
+    current_row = end_row;
+  }
+  slice_rows[num_infos - 1] = num_rows - current_row;
+
+  return slice_rows;
+}
+
 CCL_NAMESPACE_END
@@ -26,4 +26,12 @@ void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos);
  * Returns true if the balancing did change. */
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos);
 
+/* Split rows into one slice per work, so that every work gets the fraction of the total cost of
+ * the rows given by its weight. Every slice gets at least one row while there are rows left.
+ * When the number of row costs doesn't match the number of rows, all rows have the same cost.
+ * Returns the number of rows of every slice. */
+vector<int> work_balance_split_rows(const vector<WorkBalanceInfo> &work_balance_infos,
+                                    const vector<float> &row_costs,
+                                    const int num_rows);
+
 CCL_NAMESPACE_END
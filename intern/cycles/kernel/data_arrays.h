@@ -53,6 +53,7 @@ KERNEL_DATA_ARRAY(float2, attributes_float2)
 KERNEL_DATA_ARRAY(packed_float3, attributes_float3)
 KERNEL_DATA_ARRAY(float4, attributes_float4)
 KERNEL_DATA_ARRAY(uchar4, attributes_uchar4)
+KERNEL_DATA_ARRAY(half4, attributes_half4)
 
 /* lights */
 KERNEL_DATA_ARRAY(KernelLightDistribution, light_distribution)
@@ -60,6 +61,13 @@ KERNEL_DATA_ARRAY(KernelLight, lights)
 KERNEL_DATA_ARRAY(float2, light_background_marginal_cdf)
 KERNEL_DATA_ARRAY(float2, light_background_conditional_cdf)
 
+/* light tree */
+KERNEL_DATA_ARRAY(KernelLightTreeNode, light_tree_nodes)
+KERNEL_DATA_ARRAY(KernelLightTreeEmitter, light_tree_emitters)
+KERNEL_DATA_ARRAY(int, light_to_tree)
+KERNEL_DATA_ARRAY(KernelLightTreeObject, object_to_tree)
+KERNEL_DATA_ARRAY(int, triangle_to_tree)
+
 /* particles */
 KERNEL_DATA_ARRAY(KernelParticle, particles)
 
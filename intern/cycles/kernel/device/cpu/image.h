@@ -9,6 +9,8 @@
 #  include <nanovdb/util/SampleFromVoxels.h>
 #endif
 
+#include "kernel/util/texture_compression.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* Make template functions private so symbols don't conflict between kernels with different
@@ -89,7 +91,12 @@ template<typename TexT, typename OutT = float4> struct TextureInterpolator {
    * Does not check if data request is in bounds. */
   static ccl_always_inline OutT read(const TexT *data, int x, int y, int width, int height)
   {
-    return read(data[y * width + x]);
+    if constexpr (std::is_same<TexT, BC1Block>::value) {
+      return bc1_texel(data, width, x, y);
+    }
+    else {
+      return read(data[y * width + x]);
+    }
   }
 
   /* Read 2D Texture Data Clip
@@ -99,7 +106,7 @@ template<typename TexT, typename OutT = float4> struct TextureInterpolator {
     if (x < 0 || x >= width || y < 0 || y >= height) {
       return zero();
     }
-    return read(data[y * width + x]);
+    return read(data, x, y, width, height);
   }
 
   /* Read 3D Texture Data
@@ -764,6 +771,8 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
       return TextureInterpolator<ushort4>::interp(info, x, y);
     case IMAGE_DATA_TYPE_FLOAT4:
       return TextureInterpolator<float4>::interp(info, x, y);
+    case IMAGE_DATA_TYPE_BC1:
+      return TextureInterpolator<BC1Block>::interp(info, x, y);
     default:
       assert(0);
       return make_float4(
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "kernel/util/texture_compression.h"
+
 CCL_NAMESPACE_BEGIN
 
 #ifdef WITH_NANOVDB
@@ -179,10 +181,79 @@ ccl_device_noinline typename nanovdb::NanoGrid<T>::ValueType kernel_tex_image_in
 }
 #endif
 
+#ifndef __KERNEL_METAL__
+/* Block compressed textures are stored in linear memory, with filtering done here. */
+ccl_device float4 kernel_tex_image_read_bc1(ccl_global const TextureInfo &info, int x, int y)
+{
+  const int width = info.width;
+  const int height = info.height;
+
+  if (info.extension == EXTENSION_REPEAT) {
+    x %= width;
+    x += (x < 0) ? width : 0;
+    y %= height;
+    y += (y < 0) ? height : 0;
+  }
+  else if (info.extension == EXTENSION_EXTEND) {
+    x = clamp(x, 0, width - 1);
+    y = clamp(y, 0, height - 1);
+  }
+  else if (x < 0 || x >= width || y < 0 || y >= height) {
+    return zero_float4();
+  }
+
+  return bc1_texel((ccl_global const BC1Block *)info.data, width, x, y);
+}
+
+ccl_device_noinline float4 kernel_tex_image_interp_bc1(ccl_global const TextureInfo &info,
+                                                       float x,
+                                                       float y)
+{
+  if (info.interpolation == INTERPOLATION_CLOSEST) {
+    return kernel_tex_image_read_bc1(
+        info, float_to_int(floorf(x * info.width)), float_to_int(floorf(y * info.height)));
+  }
+
+  x = (x * info.width) - 0.5f;
+  y = (y * info.height) - 0.5f;
+
+  const float px = floorf(x);
+  const float py = floorf(y);
+  const float fx = x - px;
+  const float fy = y - py;
+  const int ix = float_to_int(px);
+  const int iy = float_to_int(py);
+
+  if (info.interpolation == INTERPOLATION_LINEAR) {
+    return (1.0f - fy) * ((1.0f - fx) * kernel_tex_image_read_bc1(info, ix, iy) +
+                          fx * kernel_tex_image_read_bc1(info, ix + 1, iy)) +
+           fy * ((1.0f - fx) * kernel_tex_image_read_bc1(info, ix, iy + 1) +
+                 fx * kernel_tex_image_read_bc1(info, ix + 1, iy + 1));
+  }
+
+  const float u[4] = {cubic_w0(fx), cubic_w1(fx), cubic_w2(fx), cubic_w3(fx)};
+  const float v[4] = {cubic_w0(fy), cubic_w1(fy), cubic_w2(fy), cubic_w3(fy)};
+
+  float4 r = zero_float4();
+  for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < 4; i++) {
+      r += u[i] * v[j] * kernel_tex_image_read_bc1(info, ix + i - 1, iy + j - 1);
+    }
+  }
+  return r;
+}
+#endif
+
 ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, float y)
 {
   ccl_global const TextureInfo &info = kernel_data_fetch(texture_info, id);
 
+#ifndef __KERNEL_METAL__
+  if (info.data_type == IMAGE_DATA_TYPE_BC1) {
+    return kernel_tex_image_interp_bc1(info, x, y);
+  }
+#endif
+
   /* float4, byte4, ushort4 and half4 */
   const int texture_type = info.data_type;
   if (texture_type == IMAGE_DATA_TYPE_FLOAT4 || texture_type == IMAGE_DATA_TYPE_BYTE4 ||
@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: Apache-2.0
  * Copyright 2021-2022 Intel Corporation */
 
+#include "kernel/util/texture_compression.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* For oneAPI implementation we do manual lookup and interpolation. */
@@ -64,6 +66,10 @@ ccl_device_inline float4 svm_image_texture_read(const TextureInfo &info, int x,
     half4 r = tex_fetch<half4>(info, data_offset);
     return make_float4(r.x, r.y, r.z, r.w);
   }
+  /* BC1, only used for 2D textures. */
+  else if (texture_type == IMAGE_DATA_TYPE_BC1) {
+    return bc1_texel(reinterpret_cast<ccl_global const BC1Block *>(info.data), info.width, x, y);
+  }
   /* Byte */
   else {
     uchar r = tex_fetch<uchar>(info, data_offset);
@@ -97,6 +97,28 @@ ccl_device_inline AttributeDescriptor find_attribute(KernelGlobals kg,
   return find_attribute(kg, sd->object, sd->prim, sd->type, id);
 }
 
+/* Fetch attribute data, decoding attributes stored as half floats. */
+
+ccl_device_inline float3 attribute_data_fetch_float3(KernelGlobals kg,
+                                                     const AttributeDescriptor desc,
+                                                     const int offset)
+{
+  if (desc.flags & ATTR_HALF) {
+    return float4_to_float3(half4_to_float4_image(kernel_data_fetch(attributes_half4, offset)));
+  }
+  return kernel_data_fetch(attributes_float3, offset);
+}
+
+ccl_device_inline float4 attribute_data_fetch_float4(KernelGlobals kg,
+                                                     const AttributeDescriptor desc,
+                                                     const int offset)
+{
+  if (desc.flags & ATTR_HALF) {
+    return half4_to_float4_image(kernel_data_fetch(attributes_half4, offset));
+  }
+  return kernel_data_fetch(attributes_float4, offset);
+}
+
 /* Transform matrix attribute on meshes */
 
 ccl_device Transform primitive_attribute_matrix(KernelGlobals kg, const AttributeDescriptor desc)
@@ -115,8 +115,8 @@ ccl_device float3 curve_attribute_float3(KernelGlobals kg,
     int k0 = curve.first_key + PRIMITIVE_UNPACK_SEGMENT(sd->type);
     int k1 = k0 + 1;
 
-    float3 f0 = kernel_data_fetch(attributes_float3, desc.offset + k0);
-    float3 f1 = kernel_data_fetch(attributes_float3, desc.offset + k1);
+    float3 f0 = attribute_data_fetch_float3(kg, desc, desc.offset + k0);
+    float3 f1 = attribute_data_fetch_float3(kg, desc, desc.offset + k1);
 
 #  ifdef __RAY_DIFFERENTIALS__
     if (dx)
@@ -138,7 +138,7 @@ ccl_device float3 curve_attribute_float3(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_CURVE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_CURVE) ? desc.offset + sd->prim :
                                                                 desc.offset;
-      return kernel_data_fetch(attributes_float3, offset);
+      return attribute_data_fetch_float3(kg, desc, offset);
     }
     else {
       return make_float3(0.0f, 0.0f, 0.0f);
@@ -157,8 +157,8 @@ ccl_device float4 curve_attribute_float4(KernelGlobals kg,
     int k0 = curve.first_key + PRIMITIVE_UNPACK_SEGMENT(sd->type);
     int k1 = k0 + 1;
 
-    float4 f0 = kernel_data_fetch(attributes_float4, desc.offset + k0);
-    float4 f1 = kernel_data_fetch(attributes_float4, desc.offset + k1);
+    float4 f0 = attribute_data_fetch_float4(kg, desc, desc.offset + k0);
+    float4 f1 = attribute_data_fetch_float4(kg, desc, desc.offset + k1);
 
 #  ifdef __RAY_DIFFERENTIALS__
     if (dx)
@@ -180,7 +180,7 @@ ccl_device float4 curve_attribute_float4(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_CURVE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_CURVE) ? desc.offset + sd->prim :
                                                                 desc.offset;
-      return kernel_data_fetch(attributes_float4, offset);
+      return attribute_data_fetch_float4(kg, desc, offset);
     }
     else {
       return zero_float4();
@@ -68,7 +68,7 @@ ccl_device float3 point_attribute_float3(KernelGlobals kg,
 #  endif
 
   if (desc.element == ATTR_ELEMENT_VERTEX) {
-    return kernel_data_fetch(attributes_float3, desc.offset + sd->prim);
+    return attribute_data_fetch_float3(kg, desc, desc.offset + sd->prim);
   }
   else {
     return make_float3(0.0f, 0.0f, 0.0f);
@@ -89,7 +89,7 @@ ccl_device float4 point_attribute_float4(KernelGlobals kg,
 #  endif
 
   if (desc.element == ATTR_ELEMENT_VERTEX) {
-    return kernel_data_fetch(attributes_float4, desc.offset + sd->prim);
+    return attribute_data_fetch_float4(kg, desc, desc.offset + sd->prim);
   }
   else {
     return zero_float4();
@@ -254,15 +254,15 @@ ccl_device float3 triangle_attribute_float3(KernelGlobals kg,
 
     if (desc.element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_VERTEX_MOTION)) {
       const uint4 tri_vindex = kernel_data_fetch(tri_vindex, sd->prim);
-      f0 = kernel_data_fetch(attributes_float3, desc.offset + tri_vindex.x);
-      f1 = kernel_data_fetch(attributes_float3, desc.offset + tri_vindex.y);
-      f2 = kernel_data_fetch(attributes_float3, desc.offset + tri_vindex.z);
+      f0 = attribute_data_fetch_float3(kg, desc, desc.offset + tri_vindex.x);
+      f1 = attribute_data_fetch_float3(kg, desc, desc.offset + tri_vindex.y);
+      f2 = attribute_data_fetch_float3(kg, desc, desc.offset + tri_vindex.z);
     }
     else {
       const int tri = desc.offset + sd->prim * 3;
-      f0 = kernel_data_fetch(attributes_float3, tri + 0);
-      f1 = kernel_data_fetch(attributes_float3, tri + 1);
-      f2 = kernel_data_fetch(attributes_float3, tri + 2);
+      f0 = attribute_data_fetch_float3(kg, desc, tri + 0);
+      f1 = attribute_data_fetch_float3(kg, desc, tri + 1);
+      f2 = attribute_data_fetch_float3(kg, desc, tri + 2);
     }
 
 #ifdef __RAY_DIFFERENTIALS__
@@ -285,7 +285,7 @@ ccl_device float3 triangle_attribute_float3(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_FACE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_FACE) ? desc.offset + sd->prim :
                                                                desc.offset;
-      return kernel_data_fetch(attributes_float3, offset);
+      return attribute_data_fetch_float3(kg, desc, offset);
     }
     else {
       return make_float3(0.0f, 0.0f, 0.0f);
@@ -305,16 +305,16 @@ ccl_device float4 triangle_attribute_float4(KernelGlobals kg,
 
     if (desc.element & (ATTR_ELEMENT_VERTEX | ATTR_ELEMENT_VERTEX_MOTION)) {
       const uint4 tri_vindex = kernel_data_fetch(tri_vindex, sd->prim);
-      f0 = kernel_data_fetch(attributes_float4, desc.offset + tri_vindex.x);
-      f1 = kernel_data_fetch(attributes_float4, desc.offset + tri_vindex.y);
-      f2 = kernel_data_fetch(attributes_float4, desc.offset + tri_vindex.z);
+      f0 = attribute_data_fetch_float4(kg, desc, desc.offset + tri_vindex.x);
+      f1 = attribute_data_fetch_float4(kg, desc, desc.offset + tri_vindex.y);
+      f2 = attribute_data_fetch_float4(kg, desc, desc.offset + tri_vindex.z);
     }
     else {
       const int tri = desc.offset + sd->prim * 3;
       if (desc.element == ATTR_ELEMENT_CORNER) {
-        f0 = kernel_data_fetch(attributes_float4, tri + 0);
-        f1 = kernel_data_fetch(attributes_float4, tri + 1);
-        f2 = kernel_data_fetch(attributes_float4, tri + 2);
+        f0 = attribute_data_fetch_float4(kg, desc, tri + 0);
+        f1 = attribute_data_fetch_float4(kg, desc, tri + 1);
+        f2 = attribute_data_fetch_float4(kg, desc, tri + 2);
       }
       else {
         f0 = color_srgb_to_linear_v4(
@@ -346,7 +346,7 @@ ccl_device float4 triangle_attribute_float4(KernelGlobals kg,
     if (desc.element & (ATTR_ELEMENT_FACE | ATTR_ELEMENT_OBJECT | ATTR_ELEMENT_MESH)) {
       const int offset = (desc.element == ATTR_ELEMENT_FACE) ? desc.offset + sd->prim :
                                                                desc.offset;
-      return kernel_data_fetch(attributes_float4, offset);
+      return attribute_data_fetch_float4(kg, desc, offset);
     }
     else {
       return zero_float4();
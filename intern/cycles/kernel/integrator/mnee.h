@@ -147,7 +147,7 @@ ccl_device_forceinline void mnee_update_light_sample(KernelGlobals kg,
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= ls->pdf_selection;
 }
 
 /* Manifold vertex setup from ray and intersection data */
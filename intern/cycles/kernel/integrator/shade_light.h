@@ -64,6 +64,9 @@ ccl_device_inline void integrate_light(KernelGlobals kg,
     /* multiple importance sampling, get regular light pdf,
      * and compute weight with respect to BSDF pdf */
     const float mis_ray_pdf = INTEGRATOR_STATE(state, path, mis_ray_pdf);
+    if (kernel_data.integrator.use_light_tree && !(path_flag & PATH_RAY_VOLUME_SCATTER)) {
+      ls.pdf *= light_tree_pdf_scale_lamp(kg, ray_P, ls.lamp);
+    }
     mis_weight = light_sample_mis_weight_forward(kg, mis_ray_pdf, ls.pdf);
   }
 
@@ -126,6 +126,10 @@ ccl_device_forceinline void integrate_surface_emission(KernelGlobals kg,
     /* Multiple importance sampling, get triangle light pdf,
      * and compute weight with respect to BSDF pdf. */
     float pdf = triangle_light_pdf(kg, sd, t);
+    if (kernel_data.integrator.use_light_tree && !(path_flag & PATH_RAY_VOLUME_SCATTER)) {
+      const float3 ray_P = INTEGRATOR_STATE(state, ray, P);
+      pdf *= light_tree_pdf_scale_triangle(kg, ray_P, sd->object, sd->prim);
+    }
     mis_weight = light_sample_mis_weight_forward(kg, bsdf_pdf, pdf);
   }
 
@@ -154,7 +158,7 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
     const uint bounce = INTEGRATOR_STATE(state, path, bounce);
     const float2 rand_light = path_state_rng_2D(kg, rng_state, PRNG_LIGHT);
 
-    if (!light_distribution_sample_from_position(
+    if (!light_distribution_sample_from_surface(
             kg, rand_light.x, rand_light.y, sd->time, sd->P, bounce, path_flag, &ls)) {
       return;
     }
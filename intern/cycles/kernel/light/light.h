@@ -5,6 +5,7 @@
 
 #include "kernel/geom/geom.h"
 #include "kernel/light/background.h"
+#include "kernel/light/tree.h"
 #include "kernel/sample/mapping.h"
 
 CCL_NAMESPACE_BEGIN
@@ -12,19 +13,20 @@ CCL_NAMESPACE_BEGIN
 /* Light Sample result */
 
 typedef struct LightSample {
-  float3 P;       /* position on light, or direction for distant light */
-  float3 Ng;      /* normal on light */
-  float3 D;       /* direction from shading point to light */
-  float t;        /* distance to light (FLT_MAX for distant light) */
-  float u, v;     /* parametric coordinate on primitive */
-  float pdf;      /* light sampling probability density function */
-  float eval_fac; /* intensity multiplier */
-  int object;     /* object id for triangle/curve lights */
-  int prim;       /* primitive id for triangle/curve lights */
-  int shader;     /* shader id */
-  int lamp;       /* lamp id */
-  int group;      /* lightgroup */
-  LightType type; /* type of light */
+  float3 P;            /* position on light, or direction for distant light */
+  float3 Ng;           /* normal on light */
+  float3 D;            /* direction from shading point to light */
+  float t;             /* distance to light (FLT_MAX for distant light) */
+  float u, v;          /* parametric coordinate on primitive */
+  float pdf;           /* light sampling probability density function */
+  float pdf_selection; /* probability of picking this light */
+  float eval_fac;      /* intensity multiplier */
+  int object;          /* object id for triangle/curve lights */
+  int prim;            /* primitive id for triangle/curve lights */
+  int shader;          /* shader id */
+  int lamp;            /* lamp id */
+  int group;           /* lightgroup */
+  LightType type;      /* type of light */
 } LightSample;
 
 /* Regular Light */
@@ -892,13 +894,21 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
                                                    const float3 P,
                                                    const int bounce,
                                                    const uint32_t path_flag,
+                                                   const bool use_light_tree,
                                                    ccl_private LightSample *ls)
 {
   /* Sample light index from distribution. */
-  const int index = light_distribution_sample(kg, &randu);
+  int index = light_distribution_sample(kg, &randu);
+  float pdf_scale = 1.0f;
+  if (use_light_tree) {
+    if (!light_tree_sample(kg, P, &index, &randu, &pdf_scale)) {
+      return false;
+    }
+  }
   ccl_global const KernelLightDistribution *kdistribution = &kernel_data_fetch(light_distribution,
                                                                                index);
   const int prim = kdistribution->prim;
+  ls->pdf_selection = light_distribution_pdf(kg, index) * pdf_scale;
 
   if (prim >= 0) {
     /* Mesh light. */
@@ -913,6 +923,7 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
     const int shader_flag = kdistribution->mesh_light.shader_flag;
     triangle_light_sample<in_volume_segment>(kg, prim, object, randu, randv, time, ls, P);
     ls->shader |= shader_flag;
+    ls->pdf *= pdf_scale;
     return (ls->pdf > 0.0f);
   }
 
@@ -922,7 +933,11 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
     return false;
   }
 
-  return light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls);
+  if (!light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls)) {
+    return false;
+  }
+  ls->pdf *= pdf_scale;
+  return true;
 }
 
 ccl_device_inline bool light_distribution_sample_from_volume_segment(KernelGlobals kg,
@@ -934,7 +949,7 @@ ccl_device_inline bool light_distribution_sample_from_volume_segment(KernelGloba
                                                                      const uint32_t path_flag,
                                                                      ccl_private LightSample *ls)
 {
-  return light_distribution_sample<true>(kg, randu, randv, time, P, bounce, path_flag, ls);
+  return light_distribution_sample<true>(kg, randu, randv, time, P, bounce, path_flag, false, ls);
 }
 
 ccl_device_inline bool light_distribution_sample_from_position(KernelGlobals kg,
@@ -946,7 +961,21 @@ ccl_device_inline bool light_distribution_sample_from_position(KernelGlobals kg,
                                                                const uint32_t path_flag,
                                                                ccl_private LightSample *ls)
 {
-  return light_distribution_sample<false>(kg, randu, randv, time, P, bounce, path_flag, ls);
+  return light_distribution_sample<false>(
+      kg, randu, randv, time, P, bounce, path_flag, false, ls);
+}
+
+ccl_device_inline bool light_distribution_sample_from_surface(KernelGlobals kg,
+                                                              float randu,
+                                                              const float randv,
+                                                              const float time,
+                                                              const float3 P,
+                                                              const int bounce,
+                                                              const uint32_t path_flag,
+                                                              ccl_private LightSample *ls)
+{
+  return light_distribution_sample<false>(
+      kg, randu, randv, time, P, bounce, path_flag, kernel_data.integrator.use_light_tree, ls);
 }
 
 ccl_device_inline bool light_distribution_sample_new_position(KernelGlobals kg,
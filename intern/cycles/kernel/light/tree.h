@@ -0,0 +1,269 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+/* Light Tree
+ *
+ * Hierarchy of the local lights in the scene (point, spot and area lights and mesh light
+ * triangles) for importance sampling many lights. At every node the child to traverse is picked
+ * proportional to an estimate of the light it contributes to the shading point, based on the
+ * energy, bounding box and orientation bounds of the lights below it.
+ *
+ * Distant and background lights are not in the tree. They are still picked from the flat light
+ * distribution, and when the flat distribution picks a local light, the tree is used to pick the
+ * local light instead. This keeps the light sampling code below working on distribution
+ * entries; its PDF is only rescaled by the ratio of the tree and flat selection probabilities.
+ *
+ * The tree is only used for surface shading points. Volume scattering keeps using the flat
+ * distribution, since equiangular sampling picks the light before the shading point is known.
+ */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+/* Estimate of the light received at P from the lights within the bounds. This must never be
+ * zero for a point that can receive light, so only the emitter side bounds are used, ignoring
+ * the normal at P. */
+ccl_device float light_tree_importance(const float3 P,
+                                       ccl_global const KernelLightTreeBounds *bounds)
+{
+  if (bounds->energy == 0.0f) {
+    return 0.0f;
+  }
+
+  const float3 bbox_min = make_float3(
+      bounds->bbox_min[0], bounds->bbox_min[1], bounds->bbox_min[2]);
+  const float3 bbox_max = make_float3(
+      bounds->bbox_max[0], bounds->bbox_max[1], bounds->bbox_max[2]);
+  const float3 axis = make_float3(bounds->axis[0], bounds->axis[1], bounds->axis[2]);
+
+  const float3 centroid = 0.5f * (bbox_min + bbox_max);
+  const float radius = 0.5f * len(bbox_max - bbox_min);
+
+  float distance;
+  const float3 point_to_centroid = normalize_len(centroid - P, &distance);
+
+  /* Clamp the distance to the bounding sphere, so nodes containing P are not infinitely
+   * important. */
+  const float distance_squared = max(sqr(max(distance, radius)), 1e-8f);
+
+  /* Smallest angle between the emission axis and the direction to P from any point in the
+   * bounding sphere. */
+  float theta_prime = 0.0f;
+  if (distance > radius) {
+    const float theta = safe_acosf(dot(axis, -point_to_centroid));
+    const float theta_u = safe_asinf(radius / distance);
+    theta_prime = max(theta - bounds->theta_o - theta_u, 0.0f);
+  }
+
+  if (theta_prime > bounds->theta_e) {
+    return 0.0f;
+  }
+
+  return bounds->energy * max(cosf(theta_prime), 0.0f) / distance_squared;
+}
+
+/* Probability of traversing the first child of an inner node. Negative if neither child can
+ * contribute to P. */
+ccl_device float light_tree_first_child_probability(KernelGlobals kg,
+                                                    const float3 P,
+                                                    ccl_global const KernelLightTreeNode *node,
+                                                    const int node_index)
+{
+  const float importance_first = light_tree_importance(
+      P, &kernel_data_fetch(light_tree_nodes, node_index + 1).bounds);
+  const float importance_second = light_tree_importance(
+      P, &kernel_data_fetch(light_tree_nodes, node->child_index).bounds);
+  const float total_importance = importance_first + importance_second;
+
+  if (!(total_importance > 0.0f)) {
+    return -1.0f;
+  }
+  return importance_first / total_importance;
+}
+
+/* Total importance of the emitters in a leaf node. */
+ccl_device float light_tree_leaf_importance(KernelGlobals kg,
+                                            const float3 P,
+                                            ccl_global const KernelLightTreeNode *leaf)
+{
+  float total_importance = 0.0f;
+  for (int i = 0; i < leaf->num_emitters; i++) {
+    total_importance += light_tree_importance(
+        P, &kernel_data_fetch(light_tree_emitters, leaf->first_emitter + i).bounds);
+  }
+  return total_importance;
+}
+
+/* Pick an emitter from the tree, reusing the random number at every level like the flat
+ * distribution does. Returns -1 when no light can contribute to P. */
+ccl_device int light_tree_sample_emitter(KernelGlobals kg,
+                                         const float3 P,
+                                         ccl_private float *randu,
+                                         ccl_private float *pdf)
+{
+  int node_index = 0;
+  ccl_global const KernelLightTreeNode *node = &kernel_data_fetch(light_tree_nodes, node_index);
+  float r = *randu;
+  *pdf = 1.0f;
+
+  while (node->num_emitters == 0) {
+    const float probability = light_tree_first_child_probability(kg, P, node, node_index);
+    if (probability < 0.0f) {
+      return -1;
+    }
+
+    if (r < probability) {
+      node_index = node_index + 1;
+      r = r / probability;
+      *pdf *= probability;
+    }
+    else {
+      node_index = node->child_index;
+      r = (r - probability) / (1.0f - probability);
+      *pdf *= 1.0f - probability;
+    }
+    /* Float rounding can push the rescaled number to one. */
+    r = min(r, 0.99999994f);
+    node = &kernel_data_fetch(light_tree_nodes, node_index);
+  }
+
+  const float total_importance = light_tree_leaf_importance(kg, P, node);
+  if (!(total_importance > 0.0f)) {
+    return -1;
+  }
+
+  /* Pick an emitter in the leaf proportional to its importance. */
+  const float r_total = r * total_importance;
+  int emitter = -1;
+  float emitter_importance = 0.0f;
+  float emitter_cdf = 0.0f;
+  float cdf = 0.0f;
+  for (int i = 0; i < node->num_emitters; i++) {
+    const float importance = light_tree_importance(
+        P, &kernel_data_fetch(light_tree_emitters, node->first_emitter + i).bounds);
+    if (importance > 0.0f) {
+      emitter = node->first_emitter + i;
+      emitter_importance = importance;
+      emitter_cdf = cdf;
+      if (r_total < cdf + importance) {
+        break;
+      }
+    }
+    cdf += importance;
+  }
+
+  *randu = min((r_total - emitter_cdf) / emitter_importance, 0.99999994f);
+  *pdf *= emitter_importance / total_importance;
+  return emitter;
+}
+
+/* Probability of picking the emitter from P, by walking from its leaf up to the root. */
+ccl_device float light_tree_emitter_pdf(KernelGlobals kg, const float3 P, const int emitter)
+{
+  ccl_global const KernelLightTreeEmitter *kemitter = &kernel_data_fetch(light_tree_emitters,
+                                                                         emitter);
+  int node_index = kemitter->leaf_index;
+  ccl_global const KernelLightTreeNode *node = &kernel_data_fetch(light_tree_nodes, node_index);
+
+  const float total_importance = light_tree_leaf_importance(kg, P, node);
+  if (!(total_importance > 0.0f)) {
+    return 0.0f;
+  }
+  float pdf = light_tree_importance(P, &kemitter->bounds) / total_importance;
+
+  while (node_index != 0 && pdf > 0.0f) {
+    const int parent_index = node->parent_index;
+    ccl_global const KernelLightTreeNode *parent = &kernel_data_fetch(light_tree_nodes,
+                                                                      parent_index);
+    const float probability = light_tree_first_child_probability(kg, P, parent, parent_index);
+    if (probability < 0.0f) {
+      return 0.0f;
+    }
+    pdf *= (node_index == parent_index + 1) ? probability : 1.0f - probability;
+
+    node_index = parent_index;
+    node = parent;
+  }
+
+  return pdf;
+}
+
+/* Selection probability of a distribution entry in the flat light distribution. */
+ccl_device_inline float light_distribution_pdf(KernelGlobals kg, const int index)
+{
+  return kernel_data_fetch(light_distribution, index + 1).totarea -
+         kernel_data_fetch(light_distribution, index).totarea;
+}
+
+/* Ratio of the probability of the tree picking the emitter at P to the flat distribution
+ * picking it, which is the factor to apply to light PDFs computed for the flat distribution. */
+ccl_device float light_tree_pdf_scale(KernelGlobals kg, const float3 P, const int emitter)
+{
+  if (emitter < 0) {
+    /* Local lights that are not in the tree are never sampled. */
+    return 0.0f;
+  }
+
+  const int index = kernel_data_fetch(light_tree_emitters, emitter).distribution_id;
+  const float distribution_pdf = light_distribution_pdf(kg, index);
+  if (!(distribution_pdf > 0.0f)) {
+    return 0.0f;
+  }
+
+  return kernel_data.integrator.light_tree_pdf * light_tree_emitter_pdf(kg, P, emitter) /
+         distribution_pdf;
+}
+
+/* Replace a local light picked from the flat distribution by one picked from the tree. Returns
+ * false if no light can contribute to P. */
+ccl_device bool light_tree_sample(KernelGlobals kg,
+                                  const float3 P,
+                                  ccl_private int *index,
+                                  ccl_private float *randu,
+                                  ccl_private float *pdf_scale)
+{
+  ccl_global const KernelLightDistribution *kdistribution = &kernel_data_fetch(light_distribution,
+                                                                               *index);
+  if (kdistribution->prim < 0) {
+    const int type = kernel_data_fetch(lights, ~kdistribution->prim).type;
+    if (type == LIGHT_DISTANT || type == LIGHT_BACKGROUND) {
+      /* Not in the tree. */
+      *pdf_scale = 1.0f;
+      return true;
+    }
+  }
+
+  float pdf;
+  const int emitter = light_tree_sample_emitter(kg, P, randu, &pdf);
+  if (emitter < 0) {
+    return false;
+  }
+
+  *index = kernel_data_fetch(light_tree_emitters, emitter).distribution_id;
+  *pdf_scale = kernel_data.integrator.light_tree_pdf * pdf / light_distribution_pdf(kg, *index);
+  return true;
+}
+
+ccl_device_inline float light_tree_pdf_scale_triangle(KernelGlobals kg,
+                                                      const float3 P,
+                                                      const int object,
+                                                      const int prim)
+{
+  const KernelLightTreeObject kobject = kernel_data_fetch(object_to_tree, object);
+  if (kobject.triangle_offset < 0) {
+    return 0.0f;
+  }
+  const int emitter = kernel_data_fetch(triangle_to_tree,
+                                        kobject.triangle_offset + prim - kobject.prim_offset);
+  return light_tree_pdf_scale(kg, P, emitter);
+}
+
+ccl_device_inline float light_tree_pdf_scale_lamp(KernelGlobals kg,
+                                                  const float3 P,
+                                                  const int lamp)
+{
+  return light_tree_pdf_scale(kg, P, kernel_data_fetch(light_to_tree, lamp));
+}
+
+CCL_NAMESPACE_END
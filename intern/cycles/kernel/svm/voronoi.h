@@ -433,6 +433,35 @@ ccl_device float voronoi_distance_3d(float3 a,
   }
 }
 
+#ifdef __KERNEL_SSE__
+/* Hashes of the cells within the radius around a cell, in the order the loops below visit them.
+ * Hashing four cells at once is noticeably faster than hashing them one by one, since every hash
+ * is a long chain of dependent integer operations. The results are the same. */
+ccl_device_inline void voronoi_hash_cells_3d(const float3 cellPosition,
+                                             const int radius,
+                                             float3 *cellHashes)
+{
+  const int width = 2 * radius + 1;
+  const int num_cells = width * width * width;
+  for (int n = 0; n < num_cells; n += 4) {
+    ssef kx, ky, kz;
+    for (int lane = 0; lane < 4; lane++) {
+      const int cell = min(n + lane, num_cells - 1);
+      kx[lane] = cellPosition.x + (float)(cell % width - radius);
+      ky[lane] = cellPosition.y + (float)((cell / width) % width - radius);
+      kz[lane] = cellPosition.z + (float)(cell / (width * width) - radius);
+    }
+
+    ssef hx, hy, hz;
+    hash_ssef3_to_ssef3(kx, ky, kz, &hx, &hy, &hz);
+
+    for (int lane = 0; lane < 4 && n + lane < num_cells; lane++) {
+      cellHashes[n + lane] = make_float3(hx[lane], hy[lane], hz[lane]);
+    }
+  }
+}
+#endif
+
 ccl_device void voronoi_f1_3d(float3 coord,
                               float exponent,
                               float randomness,
@@ -444,19 +473,29 @@ ccl_device void voronoi_f1_3d(float3 coord,
   float3 cellPosition = floor(coord);
   float3 localPosition = coord - cellPosition;
 
+#ifdef __KERNEL_SSE__
+  float3 cellHashes[27];
+  voronoi_hash_cells_3d(cellPosition, 1, cellHashes);
+  int cellIndex = 0;
+#endif
+
   float minDistance = 8.0f;
-  float3 targetOffset = make_float3(0.0f, 0.0f, 0.0f);
+  float3 targetColor = make_float3(0.0f, 0.0f, 0.0f);
   float3 targetPosition = make_float3(0.0f, 0.0f, 0.0f);
   for (int k = -1; k <= 1; k++) {
     for (int j = -1; j <= 1; j++) {
       for (int i = -1; i <= 1; i++) {
         float3 cellOffset = make_float3(i, j, k);
-        float3 pointPosition = cellOffset +
-                               hash_float3_to_float3(cellPosition + cellOffset) * randomness;
+#ifdef __KERNEL_SSE__
+        float3 cellHash = cellHashes[cellIndex++];
+#else
+        float3 cellHash = hash_float3_to_float3(cellPosition + cellOffset);
+#endif
+        float3 pointPosition = cellOffset + cellHash * randomness;
         float distanceToPoint = voronoi_distance_3d(
             pointPosition, localPosition, metric, exponent);
         if (distanceToPoint < minDistance) {
-          targetOffset = cellOffset;
+          targetColor = cellHash;
           minDistance = distanceToPoint;
           targetPosition = pointPosition;
         }
@@ -464,7 +503,7 @@ ccl_device void voronoi_f1_3d(float3 coord,
     }
   }
   *outDistance = minDistance;
-  *outColor = hash_float3_to_float3(cellPosition + targetOffset);
+  *outColor = targetColor;
   *outPosition = targetPosition + cellPosition;
 }
 
@@ -480,6 +519,12 @@ ccl_device void voronoi_smooth_f1_3d(float3 coord,
   float3 cellPosition = floor(coord);
   float3 localPosition = coord - cellPosition;
 
+#ifdef __KERNEL_SSE__
+  float3 cellHashes[125];
+  voronoi_hash_cells_3d(cellPosition, 2, cellHashes);
+  int cellIndex = 0;
+#endif
+
   float smoothDistance = 8.0f;
   float3 smoothColor = make_float3(0.0f, 0.0f, 0.0f);
   float3 smoothPosition = make_float3(0.0f, 0.0f, 0.0f);
@@ -487,8 +532,12 @@ ccl_device void voronoi_smooth_f1_3d(float3 coord,
     for (int j = -2; j <= 2; j++) {
       for (int i = -2; i <= 2; i++) {
         float3 cellOffset = make_float3(i, j, k);
-        float3 pointPosition = cellOffset +
-                               hash_float3_to_float3(cellPosition + cellOffset) * randomness;
+#ifdef __KERNEL_SSE__
+        float3 cellColor = cellHashes[cellIndex++];
+#else
+        float3 cellColor = hash_float3_to_float3(cellPosition + cellOffset);
+#endif
+        float3 pointPosition = cellOffset + cellColor * randomness;
         float distanceToPoint = voronoi_distance_3d(
             pointPosition, localPosition, metric, exponent);
         float h = smoothstep(
@@ -496,7 +545,6 @@ ccl_device void voronoi_smooth_f1_3d(float3 coord,
         float correctionFactor = smoothness * h * (1.0f - h);
         smoothDistance = mix(smoothDistance, distanceToPoint, h) - correctionFactor;
         correctionFactor /= 1.0f + 3.0f * smoothness;
-        float3 cellColor = hash_float3_to_float3(cellPosition + cellOffset);
         smoothColor = mix(smoothColor, cellColor, h) - correctionFactor;
         smoothPosition = mix(smoothPosition, pointPosition, h) - correctionFactor;
       }
@@ -524,12 +572,21 @@ ccl_device void voronoi_f2_3d(float3 coord,
   float3 positionF1 = make_float3(0.0f, 0.0f, 0.0f);
   float3 offsetF2 = make_float3(0.0f, 0.0f, 0.0f);
   float3 positionF2 = make_float3(0.0f, 0.0f, 0.0f);
+#ifdef __KERNEL_SSE__
+  float3 cellHashes[27];
+  voronoi_hash_cells_3d(cellPosition, 1, cellHashes);
+  int cellIndex = 0;
+#endif
   for (int k = -1; k <= 1; k++) {
     for (int j = -1; j <= 1; j++) {
       for (int i = -1; i <= 1; i++) {
         float3 cellOffset = make_float3(i, j, k);
-        float3 pointPosition = cellOffset +
-                               hash_float3_to_float3(cellPosition + cellOffset) * randomness;
+#ifdef __KERNEL_SSE__
+        float3 cellHash = cellHashes[cellIndex++];
+#else
+        float3 cellHash = hash_float3_to_float3(cellPosition + cellOffset);
+#endif
+        float3 pointPosition = cellOffset + cellHash * randomness;
         float distanceToPoint = voronoi_distance_3d(
             pointPosition, localPosition, metric, exponent);
         if (distanceToPoint < distanceF1) {
@@ -667,6 +667,8 @@ typedef enum AttributeStandard {
 typedef enum AttributeFlag {
   ATTR_FINAL_SIZE = (1 << 0),
   ATTR_SUBDIVIDED = (1 << 1),
+  /* Float3 or float4 attribute stored as half floats in the half4 attribute array. */
+  ATTR_HALF = (1 << 2),
 } AttributeFlag;
 
 typedef struct AttributeDescriptor {
@@ -1317,6 +1319,45 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+/* Bounds of the position, orientation and energy of a light tree node or emitter. Emission
+ * happens in directions within theta_e of a normal that is within theta_o of the axis. */
+typedef struct KernelLightTreeBounds {
+  float bbox_min[3];
+  float energy;
+  float bbox_max[3];
+  float theta_o;
+  float axis[3];
+  float theta_e;
+} KernelLightTreeBounds;
+
+typedef struct KernelLightTreeNode {
+  KernelLightTreeBounds bounds;
+  /* Inner nodes have their first child right after them, and the second child at child_index.
+   * Leaf nodes store num_emitters emitters starting at first_emitter. */
+  int child_index;
+  int first_emitter;
+  int num_emitters;
+  int parent_index;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
+typedef struct KernelLightTreeEmitter {
+  KernelLightTreeBounds bounds;
+  /* Index into the light distribution. */
+  int distribution_id;
+  int leaf_index;
+  int pad1, pad2;
+} KernelLightTreeEmitter;
+static_assert_align(KernelLightTreeEmitter, 16);
+
+/* Lookup of the light tree emitter of a mesh light triangle. */
+typedef struct KernelLightTreeObject {
+  int prim_offset;
+  /* Offset into triangle_to_tree, or -1 if the object has no emitters in the light tree. */
+  int triangle_offset;
+} KernelLightTreeObject;
+static_assert_align(KernelLightTreeObject, 8);
+
 typedef struct KernelParticle {
   int index;
   float age;
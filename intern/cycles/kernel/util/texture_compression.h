@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+/* BC1 Texture Compression
+ *
+ * Opaque byte textures can be stored with BC1 (also known as DXT1) block compression, at 4 bits
+ * per texel instead of 32. Every block of 4x4 texels stores two endpoint colors in RGB565 and a
+ * 2 bit index per texel, selecting one of the endpoints or a color in between them. Texels are
+ * decoded in software, so the same data works on every device. */
+
+typedef struct BC1Block {
+  /* First endpoint in the low 16 bits, second endpoint in the high 16 bits. */
+  uint endpoints;
+  /* 2 bit index per texel, in row major order starting at the lowest bits. */
+  uint indices;
+} BC1Block;
+
+ccl_device_inline float3 bc1_rgb565_to_float3(const uint c)
+{
+  return make_float3((float)((c >> 11) & 31) * (1.0f / 31.0f),
+                     (float)((c >> 5) & 63) * (1.0f / 63.0f),
+                     (float)(c & 31) * (1.0f / 31.0f));
+}
+
+/* Decode the texel at x, y, which must be inside the texture. */
+ccl_device_inline float4 bc1_texel(ccl_global const BC1Block *blocks,
+                                   const int width,
+                                   const int x,
+                                   const int y)
+{
+  const int blocks_x = (width + 3) >> 2;
+  const BC1Block block = blocks[(y >> 2) * blocks_x + (x >> 2)];
+
+  const uint c0 = block.endpoints & 0xffff;
+  const uint c1 = block.endpoints >> 16;
+  const uint index = (block.indices >> (2 * (((y & 3) << 2) | (x & 3)))) & 3;
+
+  const float3 e0 = bc1_rgb565_to_float3(c0);
+  const float3 e1 = bc1_rgb565_to_float3(c1);
+
+  if (index == 0) {
+    return float3_to_float4(e0);
+  }
+  if (index == 1) {
+    return float3_to_float4(e1);
+  }
+  if (c0 > c1) {
+    /* Four color mode, the encoder always writes blocks in this mode. */
+    return float3_to_float4((index == 2) ? (2.0f * e0 + e1) * (1.0f / 3.0f) :
+                                           (e0 + 2.0f * e1) * (1.0f / 3.0f));
+  }
+  /* Three color mode with transparent black. */
+  return (index == 2) ? float3_to_float4(0.5f * (e0 + e1)) : zero_float4();
+}
+
+CCL_NAMESPACE_END
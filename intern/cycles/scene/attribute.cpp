@@ -396,6 +396,10 @@ AttributeStandard Attribute::name_standard(const char *name)
 
 AttrKernelDataType Attribute::kernel_type(const Attribute &attr)
 {
+  if (attr.flags & ATTR_HALF) {
+    return AttrKernelDataType::HALF4;
+  }
+
   if (attr.element == ATTR_ELEMENT_CORNER) {
     return AttrKernelDataType::UCHAR4;
   }
@@ -415,6 +419,28 @@ AttrKernelDataType Attribute::kernel_type(const Attribute &attr)
   return AttrKernelDataType::FLOAT3;
 }
 
+bool Attribute::supports_half_storage() const
+{
+  /* Generic attributes, vertex colors and tangents are only used for shading and tolerate the
+   * loss of precision. Other standard attributes like motion positions are used for intersection,
+   * and UVs would be off by a texel on high resolution textures at half precision. */
+  if (!(std == ATTR_STD_NONE || std == ATTR_STD_VERTEX_COLOR || std == ATTR_STD_UV_TANGENT)) {
+    return false;
+  }
+
+  if (!(element == ATTR_ELEMENT_VERTEX || element == ATTR_ELEMENT_FACE ||
+        element == ATTR_ELEMENT_CORNER || element == ATTR_ELEMENT_CURVE ||
+        element == ATTR_ELEMENT_CURVE_KEY)) {
+    return false;
+  }
+
+  if (type == TypeDesc::TypeFloat || type == TypeFloat2 || type == TypeDesc::TypeMatrix) {
+    return false;
+  }
+
+  return true;
+}
+
 void Attribute::get_uv_tiles(Geometry *geom,
                              AttributePrimitive prim,
                              unordered_set<int> &tiles) const
@@ -780,6 +806,27 @@ void AttributeSet::clear_modified()
   modified_flag = 0;
 }
 
+void AttributeSet::update_half_storage(const bool use_half)
+{
+  foreach (Attribute &attr, attributes) {
+    const bool half = use_half && attr.supports_half_storage();
+    if (half == ((attr.flags & ATTR_HALF) != 0)) {
+      continue;
+    }
+
+    /* Tag both the old and the new device array, so they are reallocated. */
+    tag_modified(attr);
+    if (half) {
+      attr.flags |= ATTR_HALF;
+    }
+    else {
+      attr.flags &= ~ATTR_HALF;
+    }
+    tag_modified(attr);
+    attr.modified = true;
+  }
+}
+
 void AttributeSet::tag_modified(const Attribute &attr)
 {
   /* Some attributes are not stored in the various kernel attribute arrays
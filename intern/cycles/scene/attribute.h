@@ -34,7 +34,15 @@ struct Transform;
  *
  * The values of this enumeration are also used as flags to detect changes in AttributeSet. */
 
-enum AttrKernelDataType { FLOAT = 0, FLOAT2 = 1, FLOAT3 = 2, FLOAT4 = 3, UCHAR4 = 4, NUM = 5 };
+enum AttrKernelDataType {
+  FLOAT = 0,
+  FLOAT2 = 1,
+  FLOAT3 = 2,
+  FLOAT4 = 3,
+  UCHAR4 = 4,
+  HALF4 = 5,
+  NUM = 6
+};
 
 /* Attribute
  *
@@ -166,6 +174,9 @@ class Attribute {
 
   static AttrKernelDataType kernel_type(const Attribute &attr);
 
+  /* Whether the attribute may be stored as half floats on the device. */
+  bool supports_half_storage() const;
+
   void get_uv_tiles(Geometry *geom, AttributePrimitive prim, unordered_set<int> &tiles) const;
 };
 
@@ -215,6 +226,10 @@ class AttributeSet {
 
   void clear_modified();
 
+  /* Store the attributes that support it as half floats on the device or not, tagging the
+   * attributes that switch storage as modified. */
+  void update_half_storage(const bool use_half);
+
  private:
   /* Set the relevant modified flag for the attribute. Only attributes that are stored in device
    * arrays will be considered for tagging this AttributeSet as modified. */
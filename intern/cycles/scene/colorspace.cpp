@@ -8,6 +8,7 @@
 #include "util/image.h"
 #include "util/log.h"
 #include "util/math.h"
+#include "util/tbb.h"
 #include "util/thread.h"
 #include "util/vector.h"
 
@@ -251,99 +252,107 @@ template<typename T> inline void cast_from_float4(T *data, float4 value)
 
 /* Slower versions for other all data types, which needs to convert to float and back. */
 template<typename T, bool compress_as_srgb = false>
-inline void processor_apply_pixels_rgba(const OCIO::Processor *processor,
-                                        T *pixels,
-                                        size_t num_pixels)
+inline void processor_apply_pixels_rgba_chunk(const OCIO::CPUProcessor *device_processor,
+                                              T *pixels,
+                                              size_t width)
 {
   /* TODO: implement faster version for when we know the conversion
    * is a simple matrix transform between linear spaces. In that case
    * un-premultiply is not needed. */
-  OCIO::ConstCPUProcessorRcPtr device_processor = processor->getDefaultCPUProcessor();
-
-  /* Process large images in chunks to keep temporary memory requirement down. */
-  const size_t chunk_size = std::min((size_t)(16 * 1024 * 1024), num_pixels);
-  vector<float4> float_pixels(chunk_size);
-
-  for (size_t j = 0; j < num_pixels; j += chunk_size) {
-    size_t width = std::min(chunk_size, num_pixels - j);
+  vector<float4> float_pixels(width);
 
-    for (size_t i = 0; i < width; i++) {
-      float4 value = cast_to_float4(pixels + 4 * (j + i));
-
-      if (!(value.w <= 0.0f || value.w == 1.0f)) {
-        float inv_alpha = 1.0f / value.w;
-        value.x *= inv_alpha;
-        value.y *= inv_alpha;
-        value.z *= inv_alpha;
-      }
+  for (size_t i = 0; i < width; i++) {
+    float4 value = cast_to_float4(pixels + 4 * i);
 
-      float_pixels[i] = value;
+    if (!(value.w <= 0.0f || value.w == 1.0f)) {
+      float inv_alpha = 1.0f / value.w;
+      value.x *= inv_alpha;
+      value.y *= inv_alpha;
+      value.z *= inv_alpha;
     }
 
-    OCIO::PackedImageDesc desc((float *)float_pixels.data(), width, 1, 4);
-    device_processor->apply(desc);
+    float_pixels[i] = value;
+  }
 
-    for (size_t i = 0; i < width; i++) {
-      float4 value = float_pixels[i];
+  OCIO::PackedImageDesc desc((float *)float_pixels.data(), width, 1, 4);
+  device_processor->apply(desc);
 
-      if (compress_as_srgb) {
-        value = color_linear_to_srgb_v4(value);
-      }
+  for (size_t i = 0; i < width; i++) {
+    float4 value = float_pixels[i];
 
-      if (!(value.w <= 0.0f || value.w == 1.0f)) {
-        value.x *= value.w;
-        value.y *= value.w;
-        value.z *= value.w;
-      }
+    if (compress_as_srgb) {
+      value = color_linear_to_srgb_v4(value);
+    }
 
-      cast_from_float4(pixels + 4 * (j + i), value);
+    if (!(value.w <= 0.0f || value.w == 1.0f)) {
+      value.x *= value.w;
+      value.y *= value.w;
+      value.z *= value.w;
     }
+
+    cast_from_float4(pixels + 4 * i, value);
   }
 }
 
 template<typename T, bool compress_as_srgb = false>
-inline void processor_apply_pixels_grayscale(const OCIO::Processor *processor,
-                                             T *pixels,
-                                             size_t num_pixels)
+inline void processor_apply_pixels_grayscale_chunk(const OCIO::CPUProcessor *device_processor,
+                                                   T *pixels,
+                                                   size_t width)
 {
-  OCIO::ConstCPUProcessorRcPtr device_processor = processor->getDefaultCPUProcessor();
-
-  /* Process large images in chunks to keep temporary memory requirement down. */
-  const size_t chunk_size = std::min((size_t)(16 * 1024 * 1024), num_pixels);
-  vector<float> float_pixels(chunk_size * 3);
-
-  for (size_t j = 0; j < num_pixels; j += chunk_size) {
-    size_t width = std::min(chunk_size, num_pixels - j);
-
-    /* Convert to 3 channels, since that's the minimum required by OpenColorIO. */
-    {
-      const T *pixel = pixels + j;
-      float *fpixel = float_pixels.data();
-      for (size_t i = 0; i < width; i++, pixel++, fpixel += 3) {
-        const float f = util_image_cast_to_float<T>(*pixel);
-        fpixel[0] = f;
-        fpixel[1] = f;
-        fpixel[2] = f;
-      }
+  vector<float> float_pixels(width * 3);
+
+  /* Convert to 3 channels, since that's the minimum required by OpenColorIO. */
+  {
+    const T *pixel = pixels;
+    float *fpixel = float_pixels.data();
+    for (size_t i = 0; i < width; i++, pixel++, fpixel += 3) {
+      const float f = util_image_cast_to_float<T>(*pixel);
+      fpixel[0] = f;
+      fpixel[1] = f;
+      fpixel[2] = f;
     }
+  }
 
-    OCIO::PackedImageDesc desc((float *)float_pixels.data(), width, 1, 3);
-    device_processor->apply(desc);
+  OCIO::PackedImageDesc desc((float *)float_pixels.data(), width, 1, 3);
+  device_processor->apply(desc);
 
-    {
-      T *pixel = pixels + j;
-      const float *fpixel = float_pixels.data();
-      for (size_t i = 0; i < width; i++, pixel++, fpixel += 3) {
-        float f = average(make_float3(fpixel[0], fpixel[1], fpixel[2]));
-        if (compress_as_srgb) {
-          f = color_linear_to_srgb(f);
-        }
-        *pixel = util_image_cast_from_float<T>(f);
+  {
+    T *pixel = pixels;
+    const float *fpixel = float_pixels.data();
+    for (size_t i = 0; i < width; i++, pixel++, fpixel += 3) {
+      float f = average(make_float3(fpixel[0], fpixel[1], fpixel[2]));
+      if (compress_as_srgb) {
+        f = color_linear_to_srgb(f);
       }
+      *pixel = util_image_cast_from_float<T>(f);
     }
   }
 }
 
+/* Process chunks of the image in parallel, which also keeps the temporary memory requirement
+ * down for large images. */
+template<typename T, bool compress_as_srgb = false>
+inline void processor_apply_pixels(const OCIO::Processor *processor,
+                                   T *pixels,
+                                   size_t num_pixels,
+                                   bool is_rgba)
+{
+  OCIO::ConstCPUProcessorRcPtr device_processor = processor->getDefaultCPUProcessor();
+
+  const size_t pixels_per_task = 64 * 1024;
+  parallel_for(blocked_range<size_t>(0, num_pixels, pixels_per_task),
+               [&](const blocked_range<size_t> &r) {
+                 if (is_rgba) {
+                   processor_apply_pixels_rgba_chunk<T, compress_as_srgb>(
+                       device_processor.get(), pixels + 4 * r.begin(), r.size());
+                 }
+                 else {
+                   processor_apply_pixels_grayscale_chunk<T, compress_as_srgb>(
+                       device_processor.get(), pixels + r.begin(), r.size());
+                 }
+               });
+}
+
 #endif
 
 template<typename T>
@@ -354,25 +363,13 @@ void ColorSpaceManager::to_scene_linear(
   const OCIO::Processor *processor = (const OCIO::Processor *)get_processor(colorspace);
 
   if (processor) {
-    if (is_rgba) {
-      if (compress_as_srgb) {
-        /* Compress output as sRGB. */
-        processor_apply_pixels_rgba<T, true>(processor, pixels, num_pixels);
-      }
-      else {
-        /* Write output as scene linear directly. */
-        processor_apply_pixels_rgba<T>(processor, pixels, num_pixels);
-      }
+    if (compress_as_srgb) {
+      /* Compress output as sRGB. */
+      processor_apply_pixels<T, true>(processor, pixels, num_pixels, is_rgba);
     }
     else {
-      if (compress_as_srgb) {
-        /* Compress output as sRGB. */
-        processor_apply_pixels_grayscale<T, true>(processor, pixels, num_pixels);
-      }
-      else {
-        /* Write output as scene linear directly. */
-        processor_apply_pixels_grayscale<T>(processor, pixels, num_pixels);
-      }
+      /* Write output as scene linear directly. */
+      processor_apply_pixels<T>(processor, pixels, num_pixels, is_rgba);
     }
   }
 #else
@@ -499,7 +499,8 @@ static void update_attribute_element_size(Geometry *geom,
                                           size_t *attr_float2_size,
                                           size_t *attr_float3_size,
                                           size_t *attr_float4_size,
-                                          size_t *attr_uchar4_size)
+                                          size_t *attr_uchar4_size,
+                                          size_t *attr_half4_size)
 {
   if (mattr) {
     size_t size = mattr->element_size(geom, prim);
@@ -510,6 +511,9 @@ static void update_attribute_element_size(Geometry *geom,
     else if (mattr->element == ATTR_ELEMENT_CORNER_BYTE) {
       *attr_uchar4_size += size;
     }
+    else if (mattr->flags & ATTR_HALF) {
+      *attr_half4_size += size;
+    }
     else if (mattr->type == TypeDesc::TypeFloat) {
       *attr_float_size += size;
     }
@@ -528,6 +532,61 @@ static void update_attribute_element_size(Geometry *geom,
   }
 }
 
+/* Attribute data is copied into the device arrays by tasks, so that the attributes of all geometry
+ * are copied in parallel. Large attributes are split into multiple tasks. */
+template<typename DeviceType, typename DataType>
+static void copy_attribute_data(TaskPool &pool,
+                                DeviceType *dst,
+                                const DataType *src,
+                                const size_t size)
+{
+  const size_t elements_per_task = 1 << 20;
+  for (size_t start = 0; start < size; start += elements_per_task) {
+    const size_t end = min(start + elements_per_task, size);
+    pool.push([dst, src, start, end]() {
+      for (size_t k = start; k < end; k++) {
+        dst[k] = src[k];
+      }
+    });
+  }
+}
+
+static half4 attribute_to_half4(const float3 f)
+{
+  const half4 h = {float_to_half_image(f.x),
+                   float_to_half_image(f.y),
+                   float_to_half_image(f.z),
+                   float_to_half_image(0.0f)};
+  return h;
+}
+
+static half4 attribute_to_half4(const float4 f)
+{
+  const half4 h = {float_to_half_image(f.x),
+                   float_to_half_image(f.y),
+                   float_to_half_image(f.z),
+                   float_to_half_image(f.w)};
+  return h;
+}
+
+/* Same as copy_attribute_data, converting float3 and float4 attributes to half floats. */
+template<typename DataType>
+static void copy_attribute_data_half(TaskPool &pool,
+                                     half4 *dst,
+                                     const DataType *src,
+                                     const size_t size)
+{
+  const size_t elements_per_task = 1 << 20;
+  for (size_t start = 0; start < size; start += elements_per_task) {
+    const size_t end = min(start + elements_per_task, size);
+    pool.push([dst, src, start, end]() {
+      for (size_t k = start; k < end; k++) {
+        dst[k] = attribute_to_half4(src[k]);
+      }
+    });
+  }
+}
+
 void GeometryManager::update_attribute_element_offset(Geometry *geom,
                                                       device_vector<float> &attr_float,
                                                       size_t &attr_float_offset,
@@ -539,10 +598,13 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
                                                       size_t &attr_float4_offset,
                                                       device_vector<uchar4> &attr_uchar4,
                                                       size_t &attr_uchar4_offset,
+                                                      device_vector<half4> &attr_half4,
+                                                      size_t &attr_half4_offset,
                                                       Attribute *mattr,
                                                       AttributePrimitive prim,
                                                       TypeDesc &type,
-                                                      AttributeDescriptor &desc)
+                                                      AttributeDescriptor &desc,
+                                                      TaskPool &copy_pool)
 {
   if (mattr) {
     /* store element and type */
@@ -567,22 +629,35 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
 
       assert(attr_uchar4.size() >= offset + size);
       if (mattr->modified) {
-        for (size_t k = 0; k < size; k++) {
-          attr_uchar4[offset + k] = data[k];
-        }
+        copy_attribute_data(copy_pool, attr_uchar4.data() + offset, data, size);
         attr_uchar4.tag_modified();
       }
       attr_uchar4_offset += size;
     }
+    else if (mattr->flags & ATTR_HALF) {
+      offset = attr_half4_offset;
+
+      assert(attr_half4.size() >= offset + size);
+      if (mattr->modified) {
+        if (mattr->type == TypeFloat4 || mattr->type == TypeRGBA) {
+          copy_attribute_data_half(
+              copy_pool, attr_half4.data() + offset, mattr->data_float4(), size);
+        }
+        else {
+          copy_attribute_data_half(
+              copy_pool, attr_half4.data() + offset, mattr->data_float3(), size);
+        }
+        attr_half4.tag_modified();
+      }
+      attr_half4_offset += size;
+    }
     else if (mattr->type == TypeDesc::TypeFloat) {
       float *data = mattr->data_float();
       offset = attr_float_offset;
 
       assert(attr_float.size() >= offset + size);
       if (mattr->modified) {
-        for (size_t k = 0; k < size; k++) {
-          attr_float[offset + k] = data[k];
-        }
+        copy_attribute_data(copy_pool, attr_float.data() + offset, data, size);
         attr_float.tag_modified();
       }
       attr_float_offset += size;
@@ -593,9 +668,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
 
       assert(attr_float2.size() >= offset + size);
       if (mattr->modified) {
-        for (size_t k = 0; k < size; k++) {
-          attr_float2[offset + k] = data[k];
-        }
+        copy_attribute_data(copy_pool, attr_float2.data() + offset, data, size);
         attr_float2.tag_modified();
       }
       attr_float2_offset += size;
@@ -606,9 +679,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
 
       assert(attr_float4.size() >= offset + size * 3);
       if (mattr->modified) {
-        for (size_t k = 0; k < size * 3; k++) {
-          attr_float4[offset + k] = (&tfm->x)[k];
-        }
+        copy_attribute_data(copy_pool, attr_float4.data() + offset, &tfm->x, size * 3);
         attr_float4.tag_modified();
       }
       attr_float4_offset += size * 3;
@@ -619,9 +690,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
 
       assert(attr_float4.size() >= offset + size);
       if (mattr->modified) {
-        for (size_t k = 0; k < size; k++) {
-          attr_float4[offset + k] = data[k];
-        }
+        copy_attribute_data(copy_pool, attr_float4.data() + offset, data, size);
         attr_float4.tag_modified();
       }
       attr_float4_offset += size;
@@ -632,9 +701,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
 
       assert(attr_float3.size() >= offset + size);
       if (mattr->modified) {
-        for (size_t k = 0; k < size; k++) {
-          attr_float3[offset + k] = data[k];
-        }
+        copy_attribute_data(copy_pool, attr_float3.data() + offset, data, size);
         attr_float3.tag_modified();
       }
       attr_float3_offset += size;
@@ -762,6 +829,7 @@ void GeometryManager::device_update_attributes(Device *device,
   size_t attr_float3_size = 0;
   size_t attr_float4_size = 0;
   size_t attr_uchar4_size = 0;
+  size_t attr_half4_size = 0;
 
   for (size_t i = 0; i < scene->geometry.size(); i++) {
     Geometry *geom = scene->geometry[i];
@@ -776,7 +844,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                     &attr_float2_size,
                                     &attr_float3_size,
                                     &attr_float4_size,
-                                    &attr_uchar4_size);
+                                    &attr_uchar4_size,
+                                    &attr_half4_size);
 
       if (geom->is_mesh()) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -789,7 +858,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                       &attr_float2_size,
                                       &attr_float3_size,
                                       &attr_float4_size,
-                                      &attr_uchar4_size);
+                                      &attr_uchar4_size,
+                                    &attr_half4_size);
       }
     }
   }
@@ -805,7 +875,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                     &attr_float2_size,
                                     &attr_float3_size,
                                     &attr_float4_size,
-                                    &attr_uchar4_size);
+                                    &attr_uchar4_size,
+                                    &attr_half4_size);
     }
   }
 
@@ -814,6 +885,7 @@ void GeometryManager::device_update_attributes(Device *device,
   dscene->attributes_float3.alloc(attr_float3_size);
   dscene->attributes_float4.alloc(attr_float4_size);
   dscene->attributes_uchar4.alloc(attr_uchar4_size);
+  dscene->attributes_half4.alloc(attr_half4_size);
 
   /* The order of those flags needs to match that of AttrKernelDataType. */
   const bool attributes_need_realloc[AttrKernelDataType::NUM] = {
@@ -822,6 +894,7 @@ void GeometryManager::device_update_attributes(Device *device,
       dscene->attributes_float3.need_realloc(),
       dscene->attributes_float4.need_realloc(),
       dscene->attributes_uchar4.need_realloc(),
+      dscene->attributes_half4.need_realloc(),
   };
 
   size_t attr_float_offset = 0;
@@ -829,8 +902,11 @@ void GeometryManager::device_update_attributes(Device *device,
   size_t attr_float3_offset = 0;
   size_t attr_float4_offset = 0;
   size_t attr_uchar4_offset = 0;
+  size_t attr_half4_offset = 0;
 
-  /* Fill in attributes. */
+  /* Fill in attributes. The offsets are computed here, the data is copied by the tasks in this
+   * pool. */
+  TaskPool copy_pool;
   for (size_t i = 0; i < scene->geometry.size(); i++) {
     Geometry *geom = scene->geometry[i];
     AttributeRequestSet &attributes = geom_attributes[i];
@@ -856,10 +932,13 @@ void GeometryManager::device_update_attributes(Device *device,
                                       attr_float4_offset,
                                       dscene->attributes_uchar4,
                                       attr_uchar4_offset,
+                                      dscene->attributes_half4,
+                                      attr_half4_offset,
                                       attr,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
-                                      req.desc);
+                                      req.desc,
+                                      copy_pool);
 
       if (geom->is_mesh()) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -881,10 +960,13 @@ void GeometryManager::device_update_attributes(Device *device,
                                         attr_float4_offset,
                                         dscene->attributes_uchar4,
                                         attr_uchar4_offset,
+                                        dscene->attributes_half4,
+                                        attr_half4_offset,
                                         subd_attr,
                                         ATTR_PRIM_SUBD,
                                         req.subd_type,
-                                        req.subd_desc);
+                                        req.subd_desc,
+                                        copy_pool);
       }
 
       if (progress.get_cancel())
@@ -915,10 +997,13 @@ void GeometryManager::device_update_attributes(Device *device,
                                       attr_float4_offset,
                                       dscene->attributes_uchar4,
                                       attr_uchar4_offset,
+                                      dscene->attributes_half4,
+                                      attr_half4_offset,
                                       attr,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
-                                      req.desc);
+                                      req.desc,
+                                      copy_pool);
 
       /* object attributes don't care about subdivision */
       req.subd_type = req.type;
@@ -929,6 +1014,8 @@ void GeometryManager::device_update_attributes(Device *device,
     }
   }
 
+  copy_pool.wait_work();
+
   /* create attribute lookup maps */
   if (scene->shader_manager->use_osl())
     update_osl_globals(device, scene);
@@ -946,6 +1033,7 @@ void GeometryManager::device_update_attributes(Device *device,
   dscene->attributes_float3.copy_to_device_if_modified();
   dscene->attributes_float4.copy_to_device_if_modified();
   dscene->attributes_uchar4.copy_to_device_if_modified();
+  dscene->attributes_half4.copy_to_device_if_modified();
 
   if (progress.get_cancel())
     return;
@@ -1100,31 +1188,40 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->tri_patch.need_realloc() ||
                                dscene->tri_patch_uv.need_realloc();
 
+    /* The offsets of all geometry are computed in advance, so the meshes are packed in
+     * parallel. */
+    TaskPool pool;
     foreach (Geometry *geom, scene->geometry) {
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
 
-        if (mesh->shader_is_modified() || mesh->smooth_is_modified() ||
-            mesh->triangles_is_modified() || copy_all_data) {
-          mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
-        }
+        pool.push([=, &progress]() {
+          if (progress.get_cancel())
+            return;
 
-        if (mesh->verts_is_modified() || copy_all_data) {
-          mesh->pack_normals(&vnormal[mesh->vert_offset]);
-        }
+          if (mesh->shader_is_modified() || mesh->smooth_is_modified() ||
+              mesh->triangles_is_modified() || copy_all_data) {
+            mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+          }
 
-        if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
-            mesh->vert_patch_uv_is_modified() || copy_all_data) {
-          mesh->pack_verts(&tri_verts[mesh->prim_offset * 3],
-                           &tri_vindex[mesh->prim_offset],
-                           &tri_patch[mesh->prim_offset],
-                           &tri_patch_uv[mesh->vert_offset]);
-        }
+          if (mesh->verts_is_modified() || copy_all_data) {
+            mesh->pack_normals(&vnormal[mesh->vert_offset]);
+          }
 
-        if (progress.get_cancel())
-          return;
+          if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
+              mesh->vert_patch_uv_is_modified() || copy_all_data) {
+            mesh->pack_verts(&tri_verts[mesh->prim_offset * 3],
+                             &tri_vindex[mesh->prim_offset],
+                             &tri_patch[mesh->prim_offset],
+                             &tri_patch_uv[mesh->vert_offset]);
+          }
+        });
       }
     }
+    pool.wait_work();
+
+    if (progress.get_cancel())
+      return;
 
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
@@ -1148,6 +1245,7 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->curves.need_realloc() ||
                                dscene->curve_segments.need_realloc();
 
+    TaskPool pool;
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_hair()) {
         Hair *hair = static_cast<Hair *>(geom);
@@ -1161,14 +1259,21 @@ void GeometryManager::device_update_mesh(Device *,
           continue;
         }
 
-        hair->pack_curves(scene,
-                          &curve_keys[hair->curve_key_offset],
-                          &curves[hair->prim_offset],
-                          &curve_segments[hair->curve_segment_offset]);
-        if (progress.get_cancel())
-          return;
+        pool.push([=, &progress]() {
+          if (progress.get_cancel())
+            return;
+
+          hair->pack_curves(scene,
+                            &curve_keys[hair->curve_key_offset],
+                            &curves[hair->prim_offset],
+                            &curve_segments[hair->curve_segment_offset]);
+        });
       }
     }
+    pool.wait_work();
+
+    if (progress.get_cancel())
+      return;
 
     dscene->curve_keys.copy_to_device_if_modified();
     dscene->curves.copy_to_device_if_modified();
@@ -1181,15 +1286,24 @@ void GeometryManager::device_update_mesh(Device *,
     float4 *points = dscene->points.alloc(point_size);
     uint *points_shader = dscene->points_shader.alloc(point_size);
 
+    TaskPool pool;
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_pointcloud()) {
         PointCloud *pointcloud = static_cast<PointCloud *>(geom);
-        pointcloud->pack(
-            scene, &points[pointcloud->prim_offset], &points_shader[pointcloud->prim_offset]);
-        if (progress.get_cancel())
-          return;
+
+        pool.push([=, &progress]() {
+          if (progress.get_cancel())
+            return;
+
+          pointcloud->pack(
+              scene, &points[pointcloud->prim_offset], &points_shader[pointcloud->prim_offset]);
+        });
       }
     }
+    pool.wait_work();
+
+    if (progress.get_cancel())
+      return;
 
     dscene->points.copy_to_device();
     dscene->points_shader.copy_to_device();
@@ -1337,9 +1451,12 @@ enum {
 
   ATTR_UCHAR4_NEEDS_REALLOC = (1 << 15),
 
+  ATTR_HALF4_MODIFIED = (1 << 16),
+  ATTR_HALF4_NEEDS_REALLOC = (1 << 17),
+
   ATTRS_NEED_REALLOC = (ATTR_FLOAT_NEEDS_REALLOC | ATTR_FLOAT2_NEEDS_REALLOC |
                         ATTR_FLOAT3_NEEDS_REALLOC | ATTR_FLOAT4_NEEDS_REALLOC |
-                        ATTR_UCHAR4_NEEDS_REALLOC),
+                        ATTR_UCHAR4_NEEDS_REALLOC | ATTR_HALF4_NEEDS_REALLOC),
   DEVICE_MESH_DATA_NEEDS_REALLOC = (MESH_DATA_NEED_REALLOC | ATTRS_NEED_REALLOC),
   DEVICE_POINT_DATA_NEEDS_REALLOC = (POINT_DATA_NEED_REALLOC | ATTRS_NEED_REALLOC),
   DEVICE_CURVE_DATA_NEEDS_REALLOC = (CURVE_DATA_NEED_REALLOC | ATTRS_NEED_REALLOC),
@@ -1376,6 +1493,10 @@ static void update_device_flags_attribute(uint32_t &device_update_flags,
         device_update_flags |= ATTR_UCHAR4_MODIFIED;
         break;
       }
+      case AttrKernelDataType::HALF4: {
+        device_update_flags |= ATTR_HALF4_MODIFIED;
+        break;
+      }
       case AttrKernelDataType::NUM: {
         break;
       }
@@ -1401,6 +1522,9 @@ static void update_attribute_realloc_flags(uint32_t &device_update_flags,
   if (attributes.modified(AttrKernelDataType::UCHAR4)) {
     device_update_flags |= ATTR_UCHAR4_NEEDS_REALLOC;
   }
+  if (attributes.modified(AttrKernelDataType::HALF4)) {
+    device_update_flags |= ATTR_HALF4_NEEDS_REALLOC;
+  }
 }
 
 void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Progress &progress)
@@ -1425,6 +1549,7 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
   foreach (Geometry *geom, scene->geometry) {
     geom->has_volume = false;
 
+    geom->attributes.update_half_storage(scene->params.use_half_attributes);
     update_attribute_realloc_flags(device_update_flags, geom->attributes);
 
     if (geom->is_mesh()) {
@@ -1636,6 +1761,14 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
     dscene->attributes_uchar4.tag_modified();
   }
 
+  if (device_update_flags & ATTR_HALF4_NEEDS_REALLOC) {
+    dscene->attributes_map.tag_realloc();
+    dscene->attributes_half4.tag_realloc();
+  }
+  else if (device_update_flags & ATTR_HALF4_MODIFIED) {
+    dscene->attributes_half4.tag_modified();
+  }
+
   if (device_update_flags & DEVICE_MESH_DATA_MODIFIED) {
     /* if anything else than vertices or shaders are modified, we would need to reallocate, so
      * these are the only arrays that can be updated */
@@ -1819,6 +1952,9 @@ void GeometryManager::device_update(Device *device,
                                    dicing_camera->get_full_height());
     dicing_camera->update(scene);
 
+    /* Meshes are tessellated independently of each other, so do it in parallel. */
+    TaskPool pool;
+
     size_t i = 0;
     foreach (Geometry *geom, scene->geometry) {
       if (!(geom->is_modified() && geom->is_mesh())) {
@@ -1834,20 +1970,25 @@ void GeometryManager::device_update(Device *device,
           msg += string_printf(
               "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
 
-        progress.set_status("Updating Mesh", msg);
-
         mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
 
-        i++;
+        pool.push([mesh, msg, &progress]() {
+          if (progress.get_cancel()) {
+            return;
+          }
 
-        if (progress.get_cancel()) {
-          return;
-        }
+          progress.set_status("Updating Mesh", msg);
+
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+        });
+
+        i++;
       }
     }
 
+    pool.wait_work();
+
     if (progress.get_cancel()) {
       return;
     }
@@ -2098,6 +2239,7 @@ void GeometryManager::device_update(Device *device,
   dscene->attributes_float3.clear_modified();
   dscene->attributes_float4.clear_modified();
   dscene->attributes_uchar4.clear_modified();
+  dscene->attributes_half4.clear_modified();
 }
 
 void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool force_free)
@@ -2128,6 +2270,7 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool forc
   dscene->attributes_float3.free_if_need_realloc(force_free);
   dscene->attributes_float4.free_if_need_realloc(force_free);
   dscene->attributes_uchar4.free_if_need_realloc(force_free);
+  dscene->attributes_half4.free_if_need_realloc(force_free);
 
   /* Signal for shaders like displacement not to do ray tracing. */
   dscene->data.bvh.bvh_layout = BVH_LAYOUT_NONE;
@@ -27,6 +27,7 @@ class RenderStats;
 class Scene;
 class SceneParams;
 class Shader;
+class TaskPool;
 class Volume;
 struct PackedBVH;
 
@@ -256,10 +257,13 @@ class GeometryManager {
                                               size_t &attr_float4_offset,
                                               device_vector<uchar4> &attr_uchar4,
                                               size_t &attr_uchar4_offset,
+                                              device_vector<half4> &attr_half4,
+                                              size_t &attr_half4_offset,
                                               Attribute *mattr,
                                               AttributePrimitive prim,
                                               TypeDesc &type,
-                                              AttributeDescriptor &desc);
+                                              AttributeDescriptor &desc,
+                                              TaskPool &copy_pool);
 };
 
 CCL_NAMESPACE_END
@@ -3,6 +3,7 @@
 
 #include "scene/image.h"
 #include "device/device.h"
+#include "kernel/util/texture_compression.h"
 #include "scene/colorspace.h"
 #include "scene/image_oiio.h"
 #include "scene/image_vdb.h"
@@ -16,6 +17,7 @@
 #include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/tbb.h"
 #include "util/texture.h"
 #include "util/unique_ptr.h"
 
@@ -68,6 +70,8 @@ const char *name_from_type(ImageDataType type)
       return "nanovdb_fpn";
     case IMAGE_DATA_TYPE_NANOVDB_FP16:
       return "nanovdb_fp16";
+    case IMAGE_DATA_TYPE_BC1:
+      return "bc1";
     case IMAGE_DATA_NUM_TYPES:
       assert(!"System enumerator type, should never be used");
       return "";
@@ -324,6 +328,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+  features.has_bc1_textures = info.has_bc1_textures;
 }
 
 ImageManager::~ImageManager()
@@ -481,6 +486,7 @@ int ImageManager::add_image_slot(ImageLoader *loader,
   img->need_metadata = true;
   img->need_load = !(osl_texture_system && !img->loader->osl_filepath().empty());
   img->builtin = builtin;
+  img->texture_limit = 0;
   img->users = 1;
   img->mem = NULL;
 
@@ -525,6 +531,98 @@ static bool image_associate_alpha(ImageManager::Image *img)
            img->params.alpha_type == IMAGE_ALPHA_CHANNEL_PACKED);
 }
 
+static uint bc1_float3_to_rgb565(const float3 c)
+{
+  const uint r = clamp(float_to_int(c.x * 31.0f + 0.5f), 0, 31);
+  const uint g = clamp(float_to_int(c.y * 63.0f + 0.5f), 0, 63);
+  const uint b = clamp(float_to_int(c.z * 31.0f + 0.5f), 0, 31);
+  return (r << 11) | (g << 5) | b;
+}
+
+/* Encode the 4x4 texels starting at x, y, repeating the last row and column at the image border.
+ * The endpoints are the extremes of the texel colors along their principal axis. */
+static BC1Block bc1_encode_block(
+    const uchar4 *pixels, const int width, const int height, const int x, const int y)
+{
+  float3 texels[16];
+  float3 mean = zero_float3();
+  for (int i = 0; i < 16; i++) {
+    const int px = min(x + i % 4, width - 1);
+    const int py = min(y + i / 4, height - 1);
+    const uchar4 p = pixels[(size_t)py * width + px];
+    texels[i] = make_float3(p.x, p.y, p.z) * (1.0f / 255.0f);
+    mean += texels[i];
+  }
+  mean *= 1.0f / 16.0f;
+
+  /* Covariance matrix, and its principal eigenvector by power iteration. */
+  float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  for (int i = 0; i < 16; i++) {
+    const float3 d = texels[i] - mean;
+    cov[0] += d.x * d.x;
+    cov[1] += d.x * d.y;
+    cov[2] += d.x * d.z;
+    cov[3] += d.y * d.y;
+    cov[4] += d.y * d.z;
+    cov[5] += d.z * d.z;
+  }
+
+  float3 axis = make_float3(1.0f, 1.0f, 1.0f);
+  for (int iteration = 0; iteration < 4; iteration++) {
+    axis = make_float3(cov[0] * axis.x + cov[1] * axis.y + cov[2] * axis.z,
+                       cov[1] * axis.x + cov[3] * axis.y + cov[4] * axis.z,
+                       cov[2] * axis.x + cov[4] * axis.y + cov[5] * axis.z);
+    const float axis_len = len(axis);
+    if (axis_len < 1e-8f) {
+      axis = zero_float3();
+      break;
+    }
+    axis /= axis_len;
+  }
+
+  float t_min = 0.0f, t_max = 0.0f;
+  for (int i = 0; i < 16; i++) {
+    const float t = dot(texels[i] - mean, axis);
+    t_min = min(t_min, t);
+    t_max = max(t_max, t);
+  }
+
+  uint c0 = bc1_float3_to_rgb565(mean + axis * t_max);
+  uint c1 = bc1_float3_to_rgb565(mean + axis * t_min);
+  if (c0 < c1) {
+    swap(c0, c1);
+  }
+
+  BC1Block block;
+  block.endpoints = c0 | (c1 << 16);
+  block.indices = 0;
+  if (c0 == c1) {
+    /* Single color, every texel uses the first endpoint. */
+    return block;
+  }
+
+  /* Pick the closest palette color for every texel. */
+  const float3 e0 = bc1_rgb565_to_float3(c0);
+  const float3 e1 = bc1_rgb565_to_float3(c1);
+  const float3 palette[4] = {
+      e0, e1, (2.0f * e0 + e1) * (1.0f / 3.0f), (e0 + 2.0f * e1) * (1.0f / 3.0f)};
+
+  for (int i = 0; i < 16; i++) {
+    uint best_index = 0;
+    float best_distance = FLT_MAX;
+    for (uint index = 0; index < 4; index++) {
+      const float distance = len_squared(texels[i] - palette[index]);
+      if (distance < best_distance) {
+        best_distance = distance;
+        best_index = index;
+      }
+    }
+    block.indices |= best_index << (2 * i);
+  }
+
+  return block;
+}
+
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 bool ImageManager::file_load_image(Image *img, int texture_limit)
 {
@@ -625,26 +723,25 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
     /* For RGBA buffers we put all channels to 0 if either of them is not
      * finite. This way we avoid possible artifacts caused by fully changed
      * hue. */
-    if (is_rgba) {
-      for (size_t i = 0; i < num_pixels; i += 4) {
-        StorageType *pixel = &pixels[i * 4];
-        if (!isfinite(pixel[0]) || !isfinite(pixel[1]) || !isfinite(pixel[2]) ||
-            !isfinite(pixel[3])) {
-          pixel[0] = 0;
-          pixel[1] = 0;
-          pixel[2] = 0;
-          pixel[3] = 0;
-        }
-      }
-    }
-    else {
-      for (size_t i = 0; i < num_pixels; ++i) {
-        StorageType *pixel = &pixels[i];
-        if (!isfinite(pixel[0])) {
-          pixel[0] = 0;
-        }
-      }
-    }
+    const size_t pixels_per_task = 256 * 1024;
+    parallel_for(blocked_range<size_t>(0, num_pixels, pixels_per_task),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); i++) {
+                     if (is_rgba) {
+                       StorageType *pixel = &pixels[i * 4];
+                       if (!isfinite(pixel[0]) || !isfinite(pixel[1]) || !isfinite(pixel[2]) ||
+                           !isfinite(pixel[3])) {
+                         pixel[0] = 0;
+                         pixel[1] = 0;
+                         pixel[2] = 0;
+                         pixel[3] = 0;
+                       }
+                     }
+                     else if (!isfinite(pixels[i])) {
+                       pixels[i] = 0;
+                     }
+                   }
+                 });
   }
 
   /* Scale image down if needed. */
@@ -681,6 +778,59 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+void ImageManager::device_compress_image_bc1(Device *device, Image *img)
+{
+  /* Only opaque color images, data like normal maps loses too much precision. */
+  if (ColorSpaceManager::colorspace_is_data(img->params.colorspace)) {
+    return;
+  }
+
+  const device_texture *mem = img->mem;
+  const int width = mem->data_width;
+  const int height = mem->data_height;
+  if (mem->data_depth > 1 || width < 4 || height < 4) {
+    return;
+  }
+
+  const uchar4 *pixels = (const uchar4 *)mem->host_pointer;
+  const size_t num_pixels = (size_t)width * height;
+  for (size_t i = 0; i < num_pixels; i++) {
+    if (pixels[i].w != 255) {
+      return;
+    }
+  }
+
+  const int blocks_x = (width + 3) / 4;
+  const int blocks_y = (height + 3) / 4;
+  vector<BC1Block> blocks((size_t)blocks_x * blocks_y);
+
+  parallel_for(blocked_range<size_t>(0, blocks_y), [&](const blocked_range<size_t> &r) {
+    for (size_t by = r.begin(); by != r.end(); by++) {
+      for (int bx = 0; bx < blocks_x; bx++) {
+        blocks[by * blocks_x + bx] = bc1_encode_block(pixels, width, height, bx * 4, by * 4);
+      }
+    }
+  });
+
+  const uint slot = mem->slot;
+  const InterpolationType interpolation = img->params.interpolation;
+  const ExtensionType extension = img->params.extension;
+
+  thread_scoped_lock device_lock(device_mutex);
+  delete img->mem;
+
+  img->mem_name = string_printf("tex_image_%s_%03d", name_from_type(IMAGE_DATA_TYPE_BC1), slot);
+  img->mem = new device_texture(
+      device, img->mem_name.c_str(), slot, IMAGE_DATA_TYPE_BC1, interpolation, extension);
+
+  BC1Block *data = (BC1Block *)img->mem->alloc(blocks.size(), 0);
+  std::copy(blocks.begin(), blocks.end(), data);
+
+  /* The kernel uses the size of the image, not of the block array. */
+  img->mem->info.width = width;
+  img->mem->info.height = height;
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -691,7 +841,10 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
+  if (img->texture_limit > 0 && (texture_limit == 0 || img->texture_limit < texture_limit)) {
+    texture_limit = img->texture_limit;
+  }
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
@@ -744,6 +897,9 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
       pixels[2] = (TEX_IMAGE_MISSING_B * 255);
       pixels[3] = (TEX_IMAGE_MISSING_A * 255);
     }
+    else if (scene->params.use_texture_compression && features.has_bc1_textures) {
+      device_compress_image_bc1(device, img);
+    }
   }
   else if (type == IMAGE_DATA_TYPE_BYTE) {
     if (!file_load_image<TypeDesc::UINT8, uchar>(img, texture_limit)) {
@@ -844,6 +1000,130 @@ void ImageManager::device_free_image(Device *, int slot)
   images[slot] = NULL;
 }
 
+static size_t image_data_type_size(const ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return sizeof(float4);
+    case IMAGE_DATA_TYPE_BYTE4:
+      return sizeof(uchar4);
+    case IMAGE_DATA_TYPE_HALF4:
+      return sizeof(half4);
+    case IMAGE_DATA_TYPE_FLOAT:
+      return sizeof(float);
+    case IMAGE_DATA_TYPE_BYTE:
+      return sizeof(uchar);
+    case IMAGE_DATA_TYPE_HALF:
+      return sizeof(half);
+    case IMAGE_DATA_TYPE_USHORT4:
+      return sizeof(ushort4);
+    case IMAGE_DATA_TYPE_USHORT:
+      return sizeof(uint16_t);
+    default:
+      return 0;
+  }
+}
+
+/* Memory used by an image on the device when it is scaled down to the texture limit, in the same
+ * way as #ImageManager::file_load_image does it. */
+static size_t image_memory_size(const ImageMetaData &metadata, const int texture_limit)
+{
+  size_t width = metadata.width;
+  size_t height = metadata.height;
+  size_t depth = metadata.depth;
+  const size_t max_size = max(max(width, height), depth);
+  if (texture_limit > 0 && max_size > (size_t)texture_limit) {
+    float scale_factor = 1.0f;
+    while (max_size * scale_factor > texture_limit) {
+      scale_factor *= 0.5f;
+    }
+    width = max((size_t)((float)width * scale_factor), (size_t)1);
+    height = max((size_t)((float)height * scale_factor), (size_t)1);
+    depth = max((size_t)((float)depth * scale_factor), (size_t)1);
+  }
+  return width * height * depth * image_data_type_size(metadata.type);
+}
+
+void ImageManager::fit_texture_memory_limit(Scene *scene)
+{
+  const size_t memory_limit = scene->params.texture_memory_limit;
+  /* Don't scale textures below this size, they hardly use any memory. */
+  const int min_texture_limit = 128;
+
+  /* Images that are loaded already keep their size, only images that still have to be loaded are
+   * scaled down. */
+  size_t fixed_size = 0;
+  vector<Image *> scalable_images;
+  foreach (Image *img, images) {
+    if (img == NULL || img->users == 0) {
+      continue;
+    }
+    if (!img->need_load) {
+      if (img->mem) {
+        fixed_size += img->mem->memory_size();
+      }
+      continue;
+    }
+    img->texture_limit = 0;
+    if (memory_limit == 0) {
+      continue;
+    }
+    load_image_metadata(img);
+    if (image_data_type_size(img->metadata.type) == 0) {
+      /* Volumes can't be scaled down. */
+      fixed_size += img->metadata.byte_size;
+      continue;
+    }
+    img->texture_limit = scene->params.texture_limit;
+    scalable_images.push_back(img);
+  }
+
+  if (scalable_images.empty()) {
+    return;
+  }
+
+  size_t total_size = fixed_size;
+  foreach (Image *img, scalable_images) {
+    total_size += image_memory_size(img->metadata, img->texture_limit);
+  }
+
+  /* Halve the size of the largest image until everything fits. */
+  while (total_size > memory_limit) {
+    Image *largest_img = NULL;
+    size_t largest_size = 0;
+    foreach (Image *img, scalable_images) {
+      const size_t size = image_memory_size(img->metadata, img->texture_limit);
+      const bool can_scale = img->texture_limit == 0 || img->texture_limit > min_texture_limit;
+      if (can_scale && size > largest_size) {
+        largest_img = img;
+        largest_size = size;
+      }
+    }
+    if (largest_img == NULL) {
+      break;
+    }
+
+    const ImageMetaData &metadata = largest_img->metadata;
+    const int max_size = (int)max(max(metadata.width, metadata.height), metadata.depth);
+    const int current_limit = (largest_img->texture_limit > 0) ?
+                                  min(largest_img->texture_limit, max_size) :
+                                  max_size;
+    largest_img->texture_limit = max(current_limit / 2, min_texture_limit);
+    const size_t new_size = image_memory_size(metadata, largest_img->texture_limit);
+    if (new_size == largest_size) {
+      /* The image is too small to be scaled down further. */
+      largest_img->texture_limit = min_texture_limit;
+    }
+    total_size -= largest_size - new_size;
+  }
+
+  if (total_size > memory_limit) {
+    VLOG_WORK << "Image textures use " << string_human_readable_size(total_size)
+              << ", more than the texture memory limit of "
+              << string_human_readable_size(memory_limit);
+  }
+}
+
 void ImageManager::device_update(Device *device, Scene *scene, Progress &progress)
 {
   if (!need_update()) {
@@ -856,6 +1136,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  fit_texture_memory_limit(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -894,6 +1176,8 @@ void ImageManager::device_load_builtin(Device *device, Scene *scene, Progress &p
     return;
   }
 
+  fit_texture_memory_limit(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -88,6 +88,7 @@ class ImageMetaData {
 class ImageDeviceFeatures {
  public:
   bool has_nanovdb;
+  bool has_bc1_textures;
 };
 
 /* Image loader base class, that can be subclassed to load image data
@@ -200,6 +201,8 @@ class ImageManager {
     bool need_metadata;
     bool need_load;
     bool builtin;
+    /* Size limit from fitting all textures into the memory limit, 0 if not limited. */
+    int texture_limit;
 
     string mem_name;
     device_texture *mem;
@@ -225,10 +228,12 @@ class ImageManager {
   void remove_image_user(int slot);
 
   void load_image_metadata(Image *img);
+  void fit_texture_memory_limit(Scene *scene);
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  void device_compress_image_bc1(Device *device, Image *img);
   void device_load_image(Device *device, Scene *scene, int slot, Progress *progress);
   void device_free_image(Device *device, int slot);
 
@@ -7,6 +7,7 @@
 #include "scene/film.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
+#include "scene/light_tree.h"
 #include "scene/mesh.h"
 #include "scene/object.h"
 #include "scene/scene.h"
@@ -519,6 +520,281 @@ void LightManager::device_update_distribution(Device *,
   }
 }
 
+/* Rough estimate of the energy of a shader, used to weight lights in the light tree. */
+static float shader_emission_estimate(Shader *shader)
+{
+  float3 emission;
+  if (shader->is_constant_emission(&emission)) {
+    return average(fabs(emission));
+  }
+  return 1.0f;
+}
+
+static void light_tree_bounds_to_kernel(const BoundBox &bbox,
+                                        const LightTreeOrientation &orientation,
+                                        const float energy,
+                                        KernelLightTreeBounds &kbounds)
+{
+  kbounds.bbox_min[0] = bbox.min.x;
+  kbounds.bbox_min[1] = bbox.min.y;
+  kbounds.bbox_min[2] = bbox.min.z;
+  kbounds.energy = energy;
+  kbounds.bbox_max[0] = bbox.max.x;
+  kbounds.bbox_max[1] = bbox.max.y;
+  kbounds.bbox_max[2] = bbox.max.z;
+  kbounds.theta_o = orientation.theta_o;
+  kbounds.axis[0] = orientation.axis.x;
+  kbounds.axis[1] = orientation.axis.y;
+  kbounds.axis[2] = orientation.axis.z;
+  kbounds.theta_e = orientation.theta_e;
+}
+
+void LightManager::device_update_tree(Device *,
+                                      DeviceScene *dscene,
+                                      Scene *scene,
+                                      Progress &progress)
+{
+  KernelIntegrator *kintegrator = &dscene->data.integrator;
+  kintegrator->use_light_tree = false;
+  kintegrator->light_tree_pdf = 0.0f;
+
+  if (!kintegrator->use_direct_light || !scene->integrator->get_use_light_tree()) {
+    return;
+  }
+
+  progress.set_status("Updating Lights", "Building light tree");
+
+  /* Gather the local lights in the same order as the light distribution. */
+  const KernelLightDistribution *distribution = dscene->light_distribution.data();
+  const int num_distribution = kintegrator->num_distribution;
+  vector<LightTreeEmitter> emitters;
+  /* Local entries of the light distribution, including the ones without emission. */
+  float local_pdf = 0.0f;
+
+  /* Distribution index of the light tree emitters, replaced by the emitter index after the tree
+   * is built. */
+  vector<int> triangle_to_tree;
+  KernelLightTreeObject no_object_in_tree;
+  no_object_in_tree.prim_offset = 0;
+  no_object_in_tree.triangle_offset = -1;
+  vector<KernelLightTreeObject> object_to_tree(scene->objects.size(), no_object_in_tree);
+  vector<int> light_to_tree(dscene->lights.size(), -1);
+
+  int distribution_id = 0;
+  int object_id = 0;
+
+  foreach (Object *object, scene->objects) {
+    if (progress.get_cancel()) {
+      return;
+    }
+
+    if (!object_usable_as_light(object)) {
+      object_id++;
+      continue;
+    }
+
+    Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+    const bool transform_applied = mesh->transform_applied;
+    const Transform tfm = object->get_tfm();
+
+    object_to_tree[object_id].prim_offset = mesh->prim_offset;
+    object_to_tree[object_id].triangle_offset = triangle_to_tree.size();
+
+    vector<float> shader_energy(mesh->get_used_shaders().size(), -1.0f);
+
+    const size_t mesh_num_triangles = mesh->num_triangles();
+    for (size_t i = 0; i < mesh_num_triangles; i++) {
+      const int shader_index = mesh->get_shader()[i];
+      Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
+                           static_cast<Shader *>(mesh->get_used_shaders()[shader_index]) :
+                           scene->default_surface;
+
+      if (!(shader->get_use_mis() && shader->has_surface_emission)) {
+        triangle_to_tree.push_back(-1);
+        continue;
+      }
+
+      const int id = distribution_id++;
+      const float pdf = distribution[id + 1].totarea - distribution[id].totarea;
+      local_pdf += pdf;
+
+      Mesh::Triangle t = mesh->get_triangle(i);
+      if (!(pdf > 0.0f) || !t.valid(&mesh->get_verts()[0])) {
+        triangle_to_tree.push_back(-1);
+        continue;
+      }
+
+      float energy;
+      if (shader_index < int(shader_energy.size())) {
+        if (shader_energy[shader_index] < 0.0f) {
+          shader_energy[shader_index] = shader_emission_estimate(shader);
+        }
+        energy = shader_energy[shader_index];
+      }
+      else {
+        energy = shader_emission_estimate(shader);
+      }
+
+      float3 p[3];
+      for (int k = 0; k < 3; k++) {
+        p[k] = mesh->get_verts()[t.v[k]];
+        if (!transform_applied) {
+          p[k] = transform_point(&tfm, p[k]);
+        }
+      }
+
+      LightTreeEmitter emitter;
+      emitter.bbox.grow(p[0]);
+      emitter.bbox.grow(p[1]);
+      emitter.bbox.grow(p[2]);
+      /* Mesh lights emit from both sides. */
+      emitter.orientation = LightTreeOrientation(
+          safe_normalize(cross(p[1] - p[0], p[2] - p[0])), M_PI_F, M_PI_2_F);
+      emitter.energy = energy * triangle_area(p[0], p[1], p[2]);
+      emitter.distribution_id = id;
+
+      if (emitter.energy > 0.0f) {
+        emitters.push_back(emitter);
+        triangle_to_tree.push_back(id);
+      }
+      else {
+        triangle_to_tree.push_back(-1);
+      }
+    }
+
+    object_id++;
+  }
+
+  int light_index = 0;
+  foreach (Light *light, scene->lights) {
+    if (!light->is_enabled) {
+      continue;
+    }
+
+    const int id = distribution_id++;
+    const int lamp = light_index++;
+
+    if (light->light_type == LIGHT_DISTANT || light->light_type == LIGHT_BACKGROUND) {
+      continue;
+    }
+    local_pdf += distribution[id + 1].totarea - distribution[id].totarea;
+
+    Shader *shader = (light->shader) ? light->shader : scene->default_light;
+    const float strength = average(fabs(light->strength)) * shader_emission_estimate(shader);
+
+    LightTreeEmitter emitter;
+    emitter.distribution_id = id;
+
+    if (light->light_type == LIGHT_AREA) {
+      const float3 axisu = light->axisu * (light->sizeu * light->size);
+      const float3 axisv = light->axisv * (light->sizev * light->size);
+      for (int k = 0; k < 4; k++) {
+        emitter.bbox.grow(light->co + axisu * ((k & 1) ? 0.5f : -0.5f) +
+                          axisv * ((k & 2) ? 0.5f : -0.5f));
+      }
+      /* Area lights only emit from the front. */
+      emitter.orientation = LightTreeOrientation(safe_normalize(light->dir), 0.0f, M_PI_2_F);
+      emitter.energy = 0.25f * strength;
+    }
+    else {
+      emitter.bbox.grow(light->co, light->size);
+      if (light->light_type == LIGHT_SPOT) {
+        /* Spot lights emit no light outside of the spot cone. */
+        emitter.orientation = LightTreeOrientation(
+            safe_normalize(light->dir), min(light->spot_angle * 0.5f, M_PI_F), 0.0f);
+      }
+      else {
+        emitter.orientation = LightTreeOrientation(
+            make_float3(0.0f, 0.0f, 1.0f), M_PI_F, M_PI_2_F);
+      }
+      emitter.energy = 0.25f * M_1_PI_F * strength;
+    }
+
+    if (emitter.energy > 0.0f) {
+      emitters.push_back(emitter);
+      light_to_tree[lamp] = id;
+    }
+  }
+
+  assert(distribution_id == num_distribution);
+
+  if (emitters.empty()) {
+    return;
+  }
+
+  /* Build the tree, which reorders the emitters. */
+  LightTree light_tree(emitters, 8);
+  const vector<LightTreeNode> &nodes = light_tree.get_nodes();
+
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const LightTreeNode &node = nodes[i];
+    light_tree_bounds_to_kernel(node.bbox, node.orientation, node.energy, knodes[i].bounds);
+    knodes[i].child_index = node.child_index;
+    knodes[i].first_emitter = node.first_emitter;
+    knodes[i].num_emitters = node.num_emitters;
+    knodes[i].parent_index = node.parent_index;
+  }
+
+  vector<int> distribution_to_tree(num_distribution, -1);
+  KernelLightTreeEmitter *kemitters = dscene->light_tree_emitters.alloc(emitters.size());
+  for (size_t i = 0; i < emitters.size(); i++) {
+    const LightTreeEmitter &emitter = emitters[i];
+    light_tree_bounds_to_kernel(
+        emitter.bbox, emitter.orientation, emitter.energy, kemitters[i].bounds);
+    kemitters[i].distribution_id = emitter.distribution_id;
+    kemitters[i].pad1 = 0;
+    kemitters[i].pad2 = 0;
+    distribution_to_tree[emitter.distribution_id] = i;
+  }
+  for (size_t i = 0; i < nodes.size(); i++) {
+    for (int j = 0; j < nodes[i].num_emitters; j++) {
+      kemitters[nodes[i].first_emitter + j].leaf_index = i;
+    }
+  }
+
+  /* Map lights and triangles to their emitter in the tree. Device vectors are not allocated when
+   * empty, the kernel only reads them for lights in the tree. */
+  if (!light_to_tree.empty()) {
+    int *klight_to_tree = dscene->light_to_tree.alloc(light_to_tree.size());
+    for (size_t i = 0; i < light_to_tree.size(); i++) {
+      klight_to_tree[i] = (light_to_tree[i] >= 0) ? distribution_to_tree[light_to_tree[i]] : -1;
+    }
+    dscene->light_to_tree.copy_to_device();
+  }
+
+  if (!object_to_tree.empty()) {
+    KernelLightTreeObject *kobject_to_tree = dscene->object_to_tree.alloc(object_to_tree.size());
+    for (size_t i = 0; i < object_to_tree.size(); i++) {
+      kobject_to_tree[i] = object_to_tree[i];
+    }
+    dscene->object_to_tree.copy_to_device();
+  }
+
+  if (!triangle_to_tree.empty()) {
+    int *ktriangle_to_tree = dscene->triangle_to_tree.alloc(triangle_to_tree.size());
+    for (size_t i = 0; i < triangle_to_tree.size(); i++) {
+      ktriangle_to_tree[i] = (triangle_to_tree[i] >= 0) ?
+                                 distribution_to_tree[triangle_to_tree[i]] :
+                                 -1;
+    }
+    dscene->triangle_to_tree.copy_to_device();
+  }
+
+  dscene->light_tree_nodes.copy_to_device();
+  dscene->light_tree_emitters.copy_to_device();
+
+  VLOG_INFO << "Light tree with " << nodes.size() << " nodes for " << emitters.size()
+            << " lights.";
+
+  kintegrator->use_light_tree = true;
+  kintegrator->light_tree_pdf = local_pdf;
+}
+
 static void background_cdf(
     int start, int end, int res_x, int res_y, const vector<float3> *pixels, float2 *cond_cdf)
 {
@@ -994,6 +1270,10 @@ void LightManager::device_update(Device *device,
   if (progress.get_cancel())
     return;
 
+  device_update_tree(device, dscene, scene, progress);
+  if (progress.get_cancel())
+    return;
+
   if (need_update_background) {
     device_update_background(device, dscene, scene, progress);
     if (progress.get_cancel())
@@ -1012,6 +1292,11 @@ void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_ba
 {
   dscene->light_distribution.free();
   dscene->lights.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitters.free();
+  dscene->light_to_tree.free();
+  dscene->object_to_tree.free();
+  dscene->triangle_to_tree.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
     dscene->light_background_conditional_cdf.free();
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "scene/light_tree.h"
+
+#include "util/algorithm.h"
+#include "util/math.h"
+
+CCL_NAMESPACE_BEGIN
+
+LightTreeOrientation LightTreeOrientation::merge(const LightTreeOrientation &a,
+                                                 const LightTreeOrientation &b)
+{
+  /* Keep the wider cone in a. */
+  if (b.theta_o > a.theta_o) {
+    return merge(b, a);
+  }
+
+  const float theta_e = max(a.theta_e, b.theta_e);
+  const float theta_d = safe_acosf(dot(a.axis, b.axis));
+
+  /* The wider cone already contains the other one. */
+  if (min(theta_d + b.theta_o, M_PI_F) <= a.theta_o) {
+    return LightTreeOrientation(a.axis, a.theta_o, theta_e);
+  }
+
+  const float theta_o = (a.theta_o + theta_d + b.theta_o) * 0.5f;
+  if (theta_o >= M_PI_F) {
+    return LightTreeOrientation(a.axis, M_PI_F, theta_e);
+  }
+
+  /* Rotate the axis of the wider cone towards the other axis, so the new cone touches the far
+   * sides of both. */
+  const float3 ortho = safe_normalize(b.axis - a.axis * dot(a.axis, b.axis));
+  if (is_zero(ortho)) {
+    /* Opposite axes, any rotation works but the cone would cover most of the sphere anyway. */
+    return LightTreeOrientation(a.axis, M_PI_F, theta_e);
+  }
+  const float theta_r = theta_o - a.theta_o;
+  const float3 axis = normalize(a.axis * cosf(theta_r) + ortho * sinf(theta_r));
+  return LightTreeOrientation(axis, theta_o, theta_e);
+}
+
+LightTree::LightTree(vector<LightTreeEmitter> &emitters, int max_emitters_in_leaf)
+    : emitters_(emitters), max_emitters_in_leaf_(max(max_emitters_in_leaf, 1))
+{
+  if (emitters_.empty()) {
+    return;
+  }
+
+  nodes_.reserve(2 * (emitters_.size() / max_emitters_in_leaf_) + 1);
+  recursive_build(-1, 0, emitters_.size());
+}
+
+int LightTree::recursive_build(int parent_index, int begin, int end)
+{
+  const int node_index = nodes_.size();
+  nodes_.emplace_back();
+
+  BoundBox bbox = BoundBox::empty;
+  BoundBox centroid_bbox = BoundBox::empty;
+  LightTreeOrientation orientation = emitters_[begin].orientation;
+  float energy = 0.0f;
+  for (int i = begin; i < end; i++) {
+    const LightTreeEmitter &emitter = emitters_[i];
+    bbox.grow(emitter.bbox);
+    centroid_bbox.grow(emitter.bbox.center());
+    if (i != begin) {
+      orientation = LightTreeOrientation::merge(orientation, emitter.orientation);
+    }
+    energy += emitter.energy;
+  }
+
+  /* The node can't be referenced across the recursion below, since it reallocates the nodes. */
+  nodes_[node_index].bbox = bbox;
+  nodes_[node_index].orientation = orientation;
+  nodes_[node_index].energy = energy;
+  nodes_[node_index].parent_index = parent_index;
+
+  const int num_emitters = end - begin;
+  if (num_emitters <= max_emitters_in_leaf_) {
+    nodes_[node_index].first_emitter = begin;
+    nodes_[node_index].num_emitters = num_emitters;
+    return node_index;
+  }
+
+  /* Split at the median along the largest axis of the centroids. */
+  const float3 extent = centroid_bbox.size();
+  int axis = 0;
+  if (extent.y > extent[axis]) {
+    axis = 1;
+  }
+  if (extent.z > extent[axis]) {
+    axis = 2;
+  }
+
+  const int middle = begin + num_emitters / 2;
+  std::nth_element(emitters_.begin() + begin,
+                   emitters_.begin() + middle,
+                   emitters_.begin() + end,
+                   [axis](const LightTreeEmitter &a, const LightTreeEmitter &b) {
+                     return a.bbox.center2()[axis] < b.bbox.center2()[axis];
+                   });
+
+  recursive_build(node_index, begin, middle);
+  const int second_child = recursive_build(node_index, middle, end);
+  nodes_[node_index].child_index = second_child;
+
+  return node_index;
+}
+
+CCL_NAMESPACE_END
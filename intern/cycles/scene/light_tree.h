@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "util/boundbox.h"
+#include "util/types.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Orientation bounds of the emission of one or more lights. The normals of the emitters are
+ * within theta_o of the axis, and light is emitted within theta_e of the normals. */
+struct LightTreeOrientation {
+  float3 axis;
+  float theta_o;
+  float theta_e;
+
+  LightTreeOrientation() : axis(make_float3(0.0f, 0.0f, 1.0f)), theta_o(0.0f), theta_e(0.0f)
+  {
+  }
+  LightTreeOrientation(const float3 &axis, float theta_o, float theta_e)
+      : axis(axis), theta_o(theta_o), theta_e(theta_e)
+  {
+  }
+
+  /* Smallest cone containing both cones. */
+  static LightTreeOrientation merge(const LightTreeOrientation &a, const LightTreeOrientation &b);
+};
+
+/* Point, spot or area light, or mesh light triangle, with the index of its entry in the flat
+ * light distribution. */
+struct LightTreeEmitter {
+  BoundBox bbox = BoundBox::empty;
+  LightTreeOrientation orientation;
+  float energy = 0.0f;
+  int distribution_id = -1;
+};
+
+struct LightTreeNode {
+  BoundBox bbox = BoundBox::empty;
+  LightTreeOrientation orientation;
+  float energy = 0.0f;
+
+  /* Index of the second child for inner nodes, the first child directly follows the node. */
+  int child_index = -1;
+  int first_emitter = -1;
+  int num_emitters = 0;
+  int parent_index = -1;
+
+  bool is_leaf() const
+  {
+    return num_emitters > 0;
+  }
+};
+
+/* Bounding volume hierarchy of lights, built by splitting the emitters at the median of their
+ * centroids along the largest axis. The nodes are stored in depth-first order, and the emitters
+ * are reordered so that every leaf references a contiguous range of them. */
+class LightTree {
+ public:
+  LightTree(vector<LightTreeEmitter> &emitters, int max_emitters_in_leaf);
+
+  const vector<LightTreeNode> &get_nodes() const
+  {
+    return nodes_;
+  }
+
+ private:
+  int recursive_build(int parent_index, int begin, int end);
+
+  vector<LightTreeEmitter> &emitters_;
+  vector<LightTreeNode> nodes_;
+  int max_emitters_in_leaf_;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
@@ -104,6 +104,7 @@ class DeviceScene {
   device_vector<packed_float3> attributes_float3;
   device_vector<float4> attributes_float4;
   device_vector<uchar4> attributes_uchar4;
+  device_vector<half4> attributes_half4;
 
   /* lights */
   device_vector<KernelLightDistribution> light_distribution;
@@ -111,6 +112,13 @@ class DeviceScene {
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
 
+  /* light tree */
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<KernelLightTreeEmitter> light_tree_emitters;
+  device_vector<int> light_to_tree;
+  device_vector<KernelLightTreeObject> object_to_tree;
+  device_vector<int> triangle_to_tree;
+
   /* particles */
   device_vector<KernelParticle> particles;
 
@@ -146,6 +154,10 @@ class SceneParams {
   BVHLayout bvh_layout;
 
   BVHType bvh_type;
+  /* Apply object transforms to single user geometry for the static BVH. When disabled, every
+   * geometry keeps its own BVH, so that renders with persistent data only have to rebuild the
+   * BVHs of modified geometry and the top level BVH when objects move. */
+  bool use_bvh_static_transforms;
   bool use_bvh_spatial_split;
   bool use_bvh_compact_structure;
   bool use_bvh_unaligned_nodes;
@@ -153,6 +165,12 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Maximum memory used by image textures in bytes, larger textures are scaled down to fit. */
+  size_t texture_memory_limit;
+  /* Store generic attributes, vertex colors and tangents as half floats on the device. */
+  bool use_half_attributes;
+  /* Compress opaque byte image textures with BC1, if the device supports it. */
+  bool use_texture_compression;
 
   bool background;
 
@@ -161,6 +179,7 @@ class SceneParams {
     shadingsystem = SHADINGSYSTEM_SVM;
     bvh_layout = BVH_LAYOUT_AUTO;
     bvh_type = BVH_TYPE_DYNAMIC;
+    use_bvh_static_transforms = true;
     use_bvh_spatial_split = false;
     use_bvh_compact_structure = true;
     use_bvh_unaligned_nodes = true;
@@ -168,6 +187,9 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_memory_limit = 0;
+    use_half_attributes = false;
+    use_texture_compression = false;
     background = true;
   }
 
@@ -175,12 +197,16 @@ class SceneParams {
   {
     return !(shadingsystem == params.shadingsystem && bvh_layout == params.bvh_layout &&
              bvh_type == params.bvh_type &&
+             use_bvh_static_transforms == params.use_bvh_static_transforms &&
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_compact_structure == params.use_bvh_compact_structure &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_memory_limit == params.texture_memory_limit &&
+             use_half_attributes == params.use_half_attributes &&
+             use_texture_compression == params.use_texture_compression);
   }
 
   int curve_subdivisions()
@@ -38,6 +38,52 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+bool namedKernelEntryComparator(const NamedKernelEntry &a, const NamedKernelEntry &b)
+{
+  return a.time > b.time;
+}
+
+/* Quoted JSON string, with the characters JSON does not allow in strings escaped. */
+string json_string(const string &str)
+{
+  string result = "\"";
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          result += string_printf("\\u%04x", (unsigned int)c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result + "\"";
+}
+
+/* JSON array of the given items, which are already formatted as JSON. */
+string json_array(const vector<string> &items)
+{
+  string result = "[";
+  for (size_t i = 0; i < items.size(); i++) {
+    result += (i == 0) ? items[i] : "," + items[i];
+  }
+  return result + "]";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -88,6 +134,20 @@ string NamedSizeStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSizeStats::json_report()
+{
+  sort(entries.begin(), entries.end(), namedSizeEntryComparator);
+  vector<string> items;
+  foreach (const NamedSizeEntry &entry, entries) {
+    items.push_back(string_printf("{\"name\":%s,\"size\":%zu}",
+                                  json_string(entry.name).c_str(),
+                                  entry.size));
+  }
+  return string_printf("{\"total_size\":%zu,\"entries\":%s}",
+                       total_size,
+                       json_array(items).c_str());
+}
+
 string NamedTimeStats::full_report(int indent_level)
 {
   const string indent(indent_level * kIndentNumSpaces, ' ');
@@ -157,6 +217,22 @@ string NamedNestedSampleStats::full_report(int indent_level, uint64_t total_samp
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+  vector<string> items;
+  foreach (NamedNestedSampleStats &entry, entries) {
+    items.push_back(entry.json_report());
+  }
+  return string_printf("{\"name\":%s,\"time\":%.3f,\"self_time\":%.3f,\"entries\":%s}",
+                       json_string(name).c_str(),
+                       sum_samples * 0.001,
+                       self_samples * 0.001,
+                       json_array(items).c_str());
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits)
@@ -211,6 +287,26 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  foreach (entry_map::const_reference entry, entries) {
+    sorted_entries.push_back(entry.second);
+  }
+
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  vector<string> items;
+  foreach (const NamedSampleCountPair &entry, sorted_entries) {
+    items.push_back(string_printf("{\"name\":%s,\"time\":%.3f,\"hits\":%llu}",
+                                  json_string(entry.name.string()).c_str(),
+                                  entry.samples * 0.001,
+                                  (unsigned long long)entry.hits));
+  }
+  return json_array(items);
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -225,6 +321,11 @@ string MeshStats::full_report(int indent_level)
   return result;
 }
 
+string MeshStats::json_report()
+{
+  return "{\"geometry\":" + geometry.json_report() + "}";
+}
+
 /* Image statistics. */
 
 ImageStats::ImageStats()
@@ -239,6 +340,79 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+string ImageStats::json_report()
+{
+  return "{\"textures\":" + textures.json_report() + "}";
+}
+
+/* Device statistics. */
+
+NamedKernelEntry::NamedKernelEntry() : name(""), num_launches(0), work_size(0), time(0.0)
+{
+}
+
+NamedKernelEntry::NamedKernelEntry(const string &name,
+                                   uint64_t num_launches,
+                                   uint64_t work_size,
+                                   double time)
+    : name(name), num_launches(num_launches), work_size(work_size), time(time)
+{
+}
+
+DeviceStats::DeviceStats() : mem_used(0), mem_peak(0), host_mapped_size(0), host_mapped_peak(0)
+{
+}
+
+string DeviceStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  const string double_indent = indent + indent;
+  string result = "";
+  result += string_printf("%sMemory: %s (peak %s)\n",
+                          indent.c_str(),
+                          string_human_readable_size(mem_used).c_str(),
+                          string_human_readable_size(mem_peak).c_str());
+  result += string_printf("%sHost mapped memory: %s (peak %s)\n",
+                          indent.c_str(),
+                          string_human_readable_size(host_mapped_size).c_str(),
+                          string_human_readable_size(host_mapped_peak).c_str());
+  if (!kernels.empty()) {
+    result += indent + "Kernels:\n";
+    sort(kernels.begin(), kernels.end(), namedKernelEntryComparator);
+    foreach (const NamedKernelEntry &entry, kernels) {
+      result += string_printf("%s%-48s %fs (%s launches, %s work items)\n",
+                              double_indent.c_str(),
+                              entry.name.c_str(),
+                              entry.time,
+                              string_human_readable_number(entry.num_launches).c_str(),
+                              string_human_readable_number(entry.work_size).c_str());
+    }
+  }
+  return result;
+}
+
+string DeviceStats::json_report()
+{
+  sort(kernels.begin(), kernels.end(), namedKernelEntryComparator);
+  vector<string> items;
+  foreach (const NamedKernelEntry &entry, kernels) {
+    items.push_back(
+        string_printf("{\"name\":%s,\"time\":%f,\"launches\":%llu,\"work_size\":%llu}",
+                      json_string(entry.name).c_str(),
+                      entry.time,
+                      (unsigned long long)entry.num_launches,
+                      (unsigned long long)entry.work_size));
+  }
+  return string_printf(
+      "{\"memory_used\":%zu,\"memory_peak\":%zu,\"host_mapped_size\":%zu,"
+      "\"host_mapped_peak\":%zu,\"kernels\":%s}",
+      mem_used,
+      mem_peak,
+      host_mapped_size,
+      host_mapped_peak,
+      json_array(items).c_str());
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -302,6 +476,7 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += "Device statistics:\n" + device.full_report(1);
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
@@ -313,6 +488,21 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  string result = "{";
+  result += "\"mesh\":" + mesh.json_report();
+  result += ",\"image\":" + image.json_report();
+  result += ",\"device\":" + device.json_report();
+  if (has_profiling) {
+    result += ",\"kernel\":" + kernel.json_report();
+    result += ",\"shaders\":" + shaders.json_report();
+    result += ",\"objects\":" + objects.json_report();
+  }
+  result += "}";
+  return result;
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0)
 {
 }
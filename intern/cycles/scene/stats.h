@@ -51,6 +51,9 @@ class NamedSizeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate machine-readable report as a JSON object. */
+  string json_report();
+
   /* Total size of all entries. */
   size_t total_size;
 
@@ -100,6 +103,7 @@ class NamedNestedSampleStats {
   void update_sum();
 
   string full_report(int indent_level = 0, uint64_t total_samples = 0);
+  string json_report();
 
   string name;
 
@@ -128,6 +132,7 @@ class NamedSampleCountStats {
   NamedSampleCountStats();
 
   string full_report(int indent_level = 0);
+  string json_report();
   void add(const ustring &name, uint64_t samples, uint64_t hits);
 
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
@@ -141,6 +146,7 @@ class MeshStats {
 
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
+  string json_report();
 
   /* Input geometry statistics, this is what is coming as an input to render
    * from. say, Blender. This does not include runtime or engine specific
@@ -156,10 +162,46 @@ class ImageStats {
 
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
+  string json_report();
 
   NamedSizeStats textures;
 };
 
+/* Execution statistics of a device kernel, accumulated over all devices. */
+class NamedKernelEntry {
+ public:
+  NamedKernelEntry();
+  NamedKernelEntry(const string &name, uint64_t num_launches, uint64_t work_size, double time);
+
+  string name;
+  uint64_t num_launches;
+  /* Total number of work items, which for most integrator kernels is the number of paths or
+   * rays processed. */
+  uint64_t work_size;
+  double time;
+};
+
+/* Statistics about device memory and kernel execution. */
+class DeviceStats {
+ public:
+  DeviceStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+  string json_report();
+
+  /* Device memory used by the render. */
+  size_t mem_used;
+  size_t mem_peak;
+
+  /* Memory which did not fit on the device and was moved to mapped host memory. */
+  size_t host_mapped_size;
+  size_t host_mapped_peak;
+
+  /* Per-kernel execution statistics, only available when profiling GPU renders. */
+  vector<NamedKernelEntry> kernels;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -168,6 +210,9 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return all statistics as a JSON object, for tracking them with external tools. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -175,6 +220,7 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+  DeviceStats device;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
@@ -6,6 +6,7 @@
 #include "util/array.h"
 #include "util/map.h"
 #include "util/system.h"
+#include "util/tbb.h"
 #include "util/time.h"
 #include "util/unique_ptr.h"
 
@@ -407,61 +408,62 @@ static bool merge_pixels(const vector<MergeImage> &images,
       return false;
     }
 
-    for (const MergeImageLayer &layer : image.layers) {
-      const size_t stride = image.in->spec().nchannels;
-      const size_t out_stride = out_spec.nchannels;
-      const size_t num_pixels = pixels.size();
-
-      for (const MergeImagePass &pass : layer.passes) {
-        size_t offset = pass.offset;
-        size_t out_offset = pass.merge_offset;
-
-        switch (pass.op) {
-          case MERGE_CHANNEL_NOP:
-            break;
-          case MERGE_CHANNEL_COPY:
-            for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
-              out_pixels[out_offset] = pixels[offset];
-            }
-            break;
-          case MERGE_CHANNEL_SUM:
-            for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
-              out_pixels[out_offset] += pixels[offset];
-            }
-            break;
-          case MERGE_CHANNEL_AVERAGE: {
-            /* Weights based on sample count passes and sample metadata. Per channel since not
-             * all files are guaranteed to have the same channels. */
-            size_t sample_pass_offset = layer.sample_pass_offset;
-            const auto &samples = layer_samples.at(layer.name);
-
-            for (size_t i = 0; offset < num_pixels;
-                 offset += stride, sample_pass_offset += stride, out_offset += out_stride, i++) {
-              const float total_samples = samples.per_pixel[i];
-
-              float layer_samples;
-              if (layer.has_sample_pass) {
-                layer_samples = pixels[sample_pass_offset] * layer.samples;
+    const size_t stride = image.in->spec().nchannels;
+    const size_t out_stride = out_spec.nchannels;
+    const size_t num_pixels = pixels.size() / stride;
+
+    /* Merge ranges of pixels in parallel, all channels of a pixel are merged by the same task. */
+    parallel_for(blocked_range<size_t>(0, num_pixels, 4096), [&](const blocked_range<size_t> &r) {
+      for (const MergeImageLayer &layer : image.layers) {
+        for (const MergeImagePass &pass : layer.passes) {
+          switch (pass.op) {
+            case MERGE_CHANNEL_NOP:
+              break;
+            case MERGE_CHANNEL_COPY:
+              for (size_t i = r.begin(); i < r.end(); i++) {
+                out_pixels[i * out_stride + pass.merge_offset] = pixels[i * stride + pass.offset];
               }
-              else {
-                layer_samples = layer.samples;
+              break;
+            case MERGE_CHANNEL_SUM:
+              for (size_t i = r.begin(); i < r.end(); i++) {
+                out_pixels[i * out_stride + pass.merge_offset] += pixels[i * stride + pass.offset];
               }
-
-              out_pixels[out_offset] += pixels[offset] * (1.0f * layer_samples / total_samples);
+              break;
+            case MERGE_CHANNEL_AVERAGE: {
+              /* Weights based on sample count passes and sample metadata. Per channel since not
+               * all files are guaranteed to have the same channels. */
+              const auto &samples = layer_samples.at(layer.name);
+
+              for (size_t i = r.begin(); i < r.end(); i++) {
+                const float total_samples = samples.per_pixel[i];
+
+                float layer_samples;
+                if (layer.has_sample_pass) {
+                  layer_samples = pixels[i * stride + layer.sample_pass_offset] * layer.samples;
+                }
+                else {
+                  layer_samples = layer.samples;
+                }
+
+                const float weight = 1.0f * layer_samples / total_samples;
+                out_pixels[i * out_stride + pass.merge_offset] += pixels[i * stride +
+                                                                         pass.offset] *
+                                                                  weight;
+              }
+              break;
             }
-            break;
-          }
-          case MERGE_CHANNEL_SAMPLES: {
-            const auto &samples = layer_samples.at(layer.name);
-            for (size_t i = 0; offset < num_pixels;
-                 offset += stride, out_offset += out_stride, i++) {
-              out_pixels[out_offset] = 1.0f * samples.per_pixel[i] / samples.total;
+            case MERGE_CHANNEL_SAMPLES: {
+              const auto &samples = layer_samples.at(layer.name);
+              for (size_t i = r.begin(); i < r.end(); i++) {
+                out_pixels[i * out_stride + pass.merge_offset] = 1.0f * samples.per_pixel[i] /
+                                                                 samples.total;
+              }
+              break;
             }
-            break;
           }
         }
       }
-    }
+    });
   }
 
   return true;
@@ -250,6 +250,7 @@ void Session::thread_render()
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     profiler.start();
   }
+  path_trace_->set_use_profiling(params.use_profiling);
 
   /* session thread loop */
   progress.set_status("Waiting for render to start");
@@ -698,8 +699,17 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
-  if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
-    render_stats->collect_profiling(scene, profiler);
+  render_stats->device.mem_used = stats.mem_used;
+  render_stats->device.mem_peak = stats.mem_peak;
+  render_stats->device.host_mapped_size = stats.mem_host_mapped;
+  render_stats->device.host_mapped_peak = stats.mem_host_mapped_peak;
+  if (params.use_profiling) {
+    if (params.device.type == DEVICE_CPU) {
+      render_stats->collect_profiling(scene, profiler);
+    }
+    else {
+      path_trace_->collect_statistics(render_stats);
+    }
   }
 }
 
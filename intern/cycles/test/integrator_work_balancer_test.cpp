@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+static vector<WorkBalanceInfo> make_infos(const vector<double> &weights)
+{
+  vector<WorkBalanceInfo> infos(weights.size());
+  for (size_t i = 0; i < weights.size(); i++) {
+    infos[i].weight = weights[i];
+  }
+  return infos;
+}
+
+TEST(WorkBalancer, split_rows_uniform)
+{
+  const vector<WorkBalanceInfo> infos = make_infos({0.25, 0.75});
+  const vector<int> slice_rows = work_balance_split_rows(infos, {}, 100);
+  ASSERT_EQ(slice_rows.size(), 2);
+  EXPECT_EQ(slice_rows[0], 25);
+  EXPECT_EQ(slice_rows[1], 75);
+}
+
+TEST(WorkBalancer, split_rows_more_works_than_rows)
+{
+  const vector<WorkBalanceInfo> infos = make_infos({0.25, 0.25, 0.25, 0.25});
+  const vector<int> slice_rows = work_balance_split_rows(infos, {}, 2);
+  EXPECT_EQ(slice_rows[0], 1);
+  EXPECT_EQ(slice_rows[1], 1);
+  EXPECT_EQ(slice_rows[2], 0);
+  EXPECT_EQ(slice_rows[3], 0);
+}
+
+TEST(WorkBalancer, split_rows_costs)
+{
+  const vector<WorkBalanceInfo> infos = make_infos({0.5, 0.5});
+
+  /* All of the cost is in the last quarter of the rows. */
+  vector<float> row_costs(100, 0.0f);
+  for (int i = 75; i < 100; i++) {
+    row_costs[i] = 1.0f;
+  }
+  row_costs[0] = 0.001f;
+
+  const vector<int> slice_rows = work_balance_split_rows(infos, row_costs, 100);
+  EXPECT_EQ(slice_rows[0], 87);
+  EXPECT_EQ(slice_rows[1], 13);
+}
+
+TEST(WorkBalancer, split_rows_costs_minimum_one_row)
+{
+  const vector<WorkBalanceInfo> infos = make_infos({0.5, 0.5});
+  const vector<float> row_costs = {100.0f, 1.0f, 1.0f, 1.0f};
+  const vector<int> slice_rows = work_balance_split_rows(infos, row_costs, 4);
+  EXPECT_EQ(slice_rows[0], 1);
+  EXPECT_EQ(slice_rows[1], 3);
+}
+
+CCL_NAMESPACE_END
@@ -317,6 +317,31 @@ ccl_device_inline ssei hash_ssei4(ssei kx, ssei ky, ssei kz, ssei kw)
   return c;
 }
 
+/* Same as uint_to_float_incl() for every component. SSE2 only converts signed integers, so the
+ * halves are converted separately. Their sum is exact, which gives the same rounding. */
+ccl_device_inline ssef uint_to_float_incl(const ssei &n)
+{
+  const ssef hi = ssef(srl(n, 16));
+  const ssef lo = ssef(n & ssei(0xffff));
+  return (hi * 65536.0f + lo) * (1.0f / (float)0xFFFFFFFFu);
+}
+
+/* Same as hash_float3_to_float3() for four keys at once, given and returned per component. */
+ccl_device_inline void hash_ssef3_to_ssef3(const ssef &kx,
+                                           const ssef &ky,
+                                           const ssef &kz,
+                                           ssef *rx,
+                                           ssef *ry,
+                                           ssef *rz)
+{
+  const ssei x = _mm_castps_si128(kx);
+  const ssei y = _mm_castps_si128(ky);
+  const ssei z = _mm_castps_si128(kz);
+  *rx = uint_to_float_incl(hash_ssei3(x, y, z));
+  *ry = uint_to_float_incl(hash_ssei4(x, y, z, ssei(__float_as_int(1.0f))));
+  *rz = uint_to_float_incl(hash_ssei4(x, y, z, ssei(__float_as_int(2.0f))));
+}
+
 #  if defined(__KERNEL_AVX__)
 ccl_device_inline avxi hash_avxi(avxi kx)
 {
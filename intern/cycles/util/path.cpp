@@ -11,6 +11,8 @@
 
 OIIO_NAMESPACE_USING
 
+#include <atomic>
+#include <random>
 #include <stdio.h>
 
 #include <sys/stat.h>
@@ -357,6 +359,13 @@ string path_user_get(const string &sub)
 
 string path_cache_get(const string &sub)
 {
+  /* The cache location can be set to a directory shared by multiple machines, for example to
+   * share compiled kernels between the nodes of a render farm. */
+  static const char *env_cache_path = getenv("CYCLES_CACHE_PATH");
+  if (env_cache_path != NULL && env_cache_path[0] != '\0') {
+    return path_join(env_cache_path, sub);
+  }
+
 #if defined(__linux__) || defined(__APPLE__)
   if (cached_xdg_cache_path == "") {
     cached_xdg_cache_path = path_xdg_cache_get();
@@ -726,6 +735,22 @@ bool path_remove(const string &path)
   return remove(path.c_str()) == 0;
 }
 
+bool path_rename(const string &from, const string &to)
+{
+#ifdef _WIN32
+  /* Renaming doesn't replace existing files on Windows. */
+  path_remove(to);
+#endif
+  return rename(from.c_str(), to.c_str()) == 0;
+}
+
+string path_temp_sibling(const string &path)
+{
+  static std::atomic<uint64_t> counter = 0;
+  std::random_device random;
+  return string_printf("%s.%08x%08x.tmp", path.c_str(), random(), (uint)counter.fetch_add(1));
+}
+
 struct SourceReplaceState {
   typedef map<string, string> ProcessedMapping;
   /* Base director for all relative include headers. */
@@ -51,6 +51,10 @@ bool path_read_text(const string &path, string &text);
 
 /* File manipulation. */
 bool path_remove(const string &path);
+bool path_rename(const string &from, const string &to);
+/* Unique path in the same directory, to write a file there first and then rename it to the given
+ * path. Other processes sharing the directory then never see a partially written file. */
+string path_temp_sibling(const string &path);
 
 /* source code utility */
 string path_source_replace_includes(const string &source, const string &path);
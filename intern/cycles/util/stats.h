@@ -13,7 +13,7 @@ class Stats {
  public:
   enum static_init_t { static_init = 0 };
 
-  Stats() : mem_used(0), mem_peak(0)
+  Stats() : mem_used(0), mem_peak(0), mem_host_mapped(0), mem_host_mapped_peak(0)
   {
   }
   explicit Stats(static_init_t)
@@ -32,8 +32,23 @@ class Stats {
     atomic_sub_and_fetch_z(&mem_used, size);
   }
 
+  /* Device memory that did not fit on the device and was allocated in mapped host memory. */
+  void mem_host_map(size_t size)
+  {
+    atomic_add_and_fetch_z(&mem_host_mapped, size);
+    atomic_fetch_and_update_max_z(&mem_host_mapped_peak, mem_host_mapped);
+  }
+
+  void mem_host_unmap(size_t size)
+  {
+    assert(mem_host_mapped >= size);
+    atomic_sub_and_fetch_z(&mem_host_mapped, size);
+  }
+
   size_t mem_used;
   size_t mem_peak;
+  size_t mem_host_mapped;
+  size_t mem_host_mapped_peak;
 };
 
 CCL_NAMESPACE_END
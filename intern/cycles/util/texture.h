@@ -39,6 +39,7 @@ typedef enum ImageDataType {
   IMAGE_DATA_TYPE_NANOVDB_FLOAT3 = 9,
   IMAGE_DATA_TYPE_NANOVDB_FPN = 10,
   IMAGE_DATA_TYPE_NANOVDB_FP16 = 11,
+  IMAGE_DATA_TYPE_BC1 = 12,
 
   IMAGE_DATA_NUM_TYPES
 } ImageDataType;
@@ -247,6 +247,24 @@ void MEM_use_lockfree_allocator(void);
  * NOTE: The switch between allocator types can only happen before any allocation did happen. */
 void MEM_use_guarded_allocator(void);
 
+/** Default average number of allocated bytes between two samples of the heap profiler. */
+#define MEM_HEAP_PROFILE_DEFAULT_SAMPLE_INTERVAL (512 * 1024)
+
+/**
+ * Start recording the call stack of sampled allocations. Allocations are sampled at random, on
+ * average once every `sample_interval` allocated bytes, so the cost is low enough to use in
+ * release builds. Only allocations from the lock-free allocator are sampled.
+ */
+void MEM_heap_profile_start(size_t sample_interval);
+/** Stop sampling new allocations, samples of allocations which are still alive are kept. */
+void MEM_heap_profile_stop(void);
+/**
+ * Write samples of all allocations which are still alive to a file, using the legacy heap
+ * profile format of `gperftools` which can be read by `pprof`.
+ * \return false if the file could not be written.
+ */
+bool MEM_heap_profile_write(const char *filepath);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -6,12 +6,23 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <math.h>
 #include <stdarg.h>
 #include <stdio.h> /* printf */
 #include <stdlib.h>
 #include <string.h> /* memcpy */
 #include <sys/types.h>
 
+#include <pthread.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <execinfo.h>
+#  define HAVE_HEAP_PROFILE_BACKTRACE
+#elif defined(_WIN32)
+#  include <windows.h>
+#  define HAVE_HEAP_PROFILE_BACKTRACE
+#endif
+
 #include "MEM_guardedalloc.h"
 
 /* to ensure strict conversions */
@@ -38,13 +49,33 @@ static void (*error_callback)(const char *) = NULL;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  /* Block was allocated with the capacity of its thread cache size class. */
+  MEMHEAD_THREAD_CACHE_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG)))
+#define MEMHEAD_IS_THREAD_CACHE(memhead) ((memhead)->len & (size_t)MEMHEAD_THREAD_CACHE_FLAG)
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_THREAD_CACHE_FLAG)))
+
+/* Set in the alignment of blocks which are sampled by the heap profiler. Sampled blocks are always
+ * allocated as aligned blocks, and have their #HeapProfileSample pointer stored in the padding
+ * right before the head. The padding is never smaller than a pointer. */
+#define MEMHEAD_ALIGNMENT_SAMPLED_FLAG 0x4000
+#define MEMHEAD_ALIGNMENT(memhead) \
+  ((size_t)((memhead)->alignment & ~MEMHEAD_ALIGNMENT_SAMPLED_FLAG))
+#define MEMHEAD_ALIGNED_REAL_PTR(memhead) \
+  ((char *)(memhead)-MEMHEAD_ALIGN_PADDING(MEMHEAD_ALIGNMENT(memhead)))
+#define MEMHEAD_ALIGNED_SAMPLE(memhead) (((struct HeapProfileSample **)(memhead))[-1])
+
+#ifdef _MSC_VER
+#  define THREAD_LOCAL __declspec(thread)
+#else
+#  define THREAD_LOCAL __thread
+#endif
 
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
@@ -77,6 +108,316 @@ print_error(const char *str, ...)
   }
 }
 
+#ifdef WITH_MEM_THREAD_CACHE
+
+/* -------------------------------------------------------------------- */
+/** \name Thread Cache
+ *
+ * Small blocks which are freed are kept in a cache of the freeing thread, and are re-used by the
+ * next allocations of the same size class from that thread, without going through the system
+ * allocator and its locks. Blocks in the cache are not counted as used memory.
+ *
+ * Cached blocks are regular system allocations, so any block can still be freed with `free()`
+ * from any thread. The cache of a thread is released when the thread exits, except on Windows
+ * where the (bounded) cache of exited threads is only released on process exit.
+ * \{ */
+
+/* Data size granularity of the size classes. */
+#  define THREAD_CACHE_CLASS_SIZE 16
+#  define THREAD_CACHE_CLASSES_NUM 64
+/* Largest data size which is handled by the cache. */
+#  define THREAD_CACHE_LEN_MAX (THREAD_CACHE_CLASS_SIZE * THREAD_CACHE_CLASSES_NUM)
+/* Maximum number of cached blocks per size class and thread. */
+#  define THREAD_CACHE_BLOCKS_MAX 64
+
+typedef struct ThreadCacheBin {
+  /* Cached blocks, linked through the first bytes of their data. */
+  MemHead *first;
+  unsigned int blocks_num;
+} ThreadCacheBin;
+
+static THREAD_LOCAL ThreadCacheBin thread_cache[THREAD_CACHE_CLASSES_NUM];
+
+MEM_INLINE size_t thread_cache_class(size_t len)
+{
+  return (len == 0) ? 0 : (len - 1) / THREAD_CACHE_CLASS_SIZE;
+}
+
+MEM_INLINE size_t thread_cache_class_len(size_t size_class)
+{
+  return (size_class + 1) * THREAD_CACHE_CLASS_SIZE;
+}
+
+#  ifndef _WIN32
+static pthread_key_t thread_cache_key;
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+static THREAD_LOCAL bool thread_cache_is_registered = false;
+
+static void thread_cache_exit(void *UNUSED(value))
+{
+  for (int i = 0; i < THREAD_CACHE_CLASSES_NUM; i++) {
+    ThreadCacheBin *bin = &thread_cache[i];
+    while (bin->first) {
+      MemHead *memh = bin->first;
+      bin->first = *(MemHead **)PTR_FROM_MEMHEAD(memh);
+      free(memh);
+    }
+    bin->blocks_num = 0;
+  }
+}
+
+static void thread_cache_key_create(void)
+{
+  pthread_key_create(&thread_cache_key, thread_cache_exit);
+}
+
+/* Make sure the cache of the current thread is released when the thread exits. */
+MEM_INLINE void thread_cache_ensure_registered(void)
+{
+  if (UNLIKELY(!thread_cache_is_registered)) {
+    pthread_once(&thread_cache_key_once, thread_cache_key_create);
+    /* The destructor is only called for a non-null value. */
+    pthread_setspecific(thread_cache_key, &thread_cache_is_registered);
+    thread_cache_is_registered = true;
+  }
+}
+#  endif
+
+static MemHead *thread_cache_malloc(size_t len, bool clear)
+{
+  const size_t size_class = thread_cache_class(len);
+  ThreadCacheBin *bin = &thread_cache[size_class];
+  MemHead *memh = bin->first;
+  if (memh) {
+    bin->first = *(MemHead **)PTR_FROM_MEMHEAD(memh);
+    bin->blocks_num--;
+    if (clear) {
+      memset(memh + 1, 0, len);
+    }
+    return memh;
+  }
+  const size_t alloc_len = thread_cache_class_len(size_class) + sizeof(MemHead);
+  return (MemHead *)(clear ? calloc(1, alloc_len) : malloc(alloc_len));
+}
+
+/* Returns false if the block did not fit into the cache and has to be freed. */
+static bool thread_cache_free(MemHead *memh, size_t len)
+{
+  ThreadCacheBin *bin = &thread_cache[thread_cache_class(len)];
+  if (bin->blocks_num == THREAD_CACHE_BLOCKS_MAX) {
+    return false;
+  }
+#  ifndef _WIN32
+  thread_cache_ensure_registered();
+#  endif
+  *(MemHead **)PTR_FROM_MEMHEAD(memh) = bin->first;
+  bin->first = memh;
+  bin->blocks_num++;
+  return true;
+}
+
+/** \} */
+
+#endif /* WITH_MEM_THREAD_CACHE */
+
+/* -------------------------------------------------------------------- */
+/** \name Heap Profile
+ *
+ * Allocations are sampled with a probability proportional to their size, by counting down a
+ * random number of bytes with an exponential distribution per thread. This way the profile is an
+ * unbiased estimate of the memory usage, which `pprof` reconstructs from the sample interval.
+ * \{ */
+
+#define HEAP_PROFILE_FRAMES_MAX 32
+/* Frames of the heap profiler itself which are skipped in the recorded call stack. */
+#define HEAP_PROFILE_FRAMES_SKIP 2
+
+typedef struct HeapProfileSample {
+  struct HeapProfileSample *next, *prev;
+  size_t len;
+  int frames_num;
+  void *frames[HEAP_PROFILE_FRAMES_MAX];
+} HeapProfileSample;
+
+/* Zero when the profiler is not running. */
+static size_t heap_profile_sample_interval = 0;
+static HeapProfileSample *heap_profile_samples = NULL;
+static pthread_mutex_t heap_profile_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static THREAD_LOCAL size_t heap_profile_bytes_until_sample = 0;
+static THREAD_LOCAL uint64_t heap_profile_random_state = 0;
+
+static size_t heap_profile_next_sample_distance(size_t sample_interval)
+{
+  if (heap_profile_random_state == 0) {
+    /* Different seed for every thread. */
+    heap_profile_random_state = (uint64_t)(uintptr_t)&heap_profile_random_state | 1;
+  }
+  /* Xorshift random number generator. */
+  heap_profile_random_state ^= heap_profile_random_state << 13;
+  heap_profile_random_state ^= heap_profile_random_state >> 7;
+  heap_profile_random_state ^= heap_profile_random_state << 17;
+  /* Uniform random number in the (0, 1] range. */
+  const double random = (double)((heap_profile_random_state >> 11) + 1) /
+                        9007199254740992.0; /* 2^53 */
+  return (size_t)(-log(random) * (double)sample_interval) + 1;
+}
+
+MEM_INLINE bool heap_profile_should_sample(size_t len)
+{
+  const size_t sample_interval = heap_profile_sample_interval;
+  if (LIKELY(sample_interval == 0)) {
+    return false;
+  }
+  if (heap_profile_bytes_until_sample > len) {
+    heap_profile_bytes_until_sample -= len;
+    return false;
+  }
+  heap_profile_bytes_until_sample = heap_profile_next_sample_distance(sample_interval);
+  return true;
+}
+
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+static HeapProfileSample *
+heap_profile_sample_add(size_t len)
+{
+  HeapProfileSample *sample = (HeapProfileSample *)malloc(sizeof(HeapProfileSample));
+  if (sample == NULL) {
+    return NULL;
+  }
+  sample->len = len;
+  sample->frames_num = 0;
+
+#ifdef HAVE_HEAP_PROFILE_BACKTRACE
+  void *frames[HEAP_PROFILE_FRAMES_MAX + HEAP_PROFILE_FRAMES_SKIP];
+#  ifdef _WIN32
+  const int frames_num = (int)CaptureStackBackTrace(
+      0, HEAP_PROFILE_FRAMES_MAX + HEAP_PROFILE_FRAMES_SKIP, frames, NULL);
+#  else
+  const int frames_num = backtrace(frames, HEAP_PROFILE_FRAMES_MAX + HEAP_PROFILE_FRAMES_SKIP);
+#  endif
+  for (int i = HEAP_PROFILE_FRAMES_SKIP; i < frames_num; i++) {
+    sample->frames[sample->frames_num++] = frames[i];
+  }
+#endif
+
+  pthread_mutex_lock(&heap_profile_lock);
+  sample->prev = NULL;
+  sample->next = heap_profile_samples;
+  if (heap_profile_samples) {
+    heap_profile_samples->prev = sample;
+  }
+  heap_profile_samples = sample;
+  pthread_mutex_unlock(&heap_profile_lock);
+
+  return sample;
+}
+
+static void heap_profile_sample_remove(HeapProfileSample *sample)
+{
+  if (sample == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&heap_profile_lock);
+  if (sample->prev) {
+    sample->prev->next = sample->next;
+  }
+  else {
+    heap_profile_samples = sample->next;
+  }
+  if (sample->next) {
+    sample->next->prev = sample->prev;
+  }
+  pthread_mutex_unlock(&heap_profile_lock);
+  free(sample);
+}
+
+void MEM_heap_profile_start(size_t sample_interval)
+{
+  heap_profile_sample_interval = sample_interval;
+}
+
+void MEM_heap_profile_stop(void)
+{
+  heap_profile_sample_interval = 0;
+}
+
+bool MEM_heap_profile_write(const char *filepath)
+{
+  FILE *file = fopen(filepath, "w");
+  if (file == NULL) {
+    print_error("Unable to write heap profile to %s\n", filepath);
+    return false;
+  }
+
+  pthread_mutex_lock(&heap_profile_lock);
+  unsigned int samples_num = 0;
+  size_t samples_len = 0;
+  for (const HeapProfileSample *sample = heap_profile_samples; sample; sample = sample->next) {
+    samples_num++;
+    samples_len += sample->len;
+  }
+  /* Allocation totals are not tracked, so they are the same as the in-use totals. */
+  fprintf(file,
+          "heap profile: %u: " SIZET_FORMAT " [%u: " SIZET_FORMAT "] @ heap_v2/" SIZET_FORMAT
+          "\n",
+          samples_num,
+          SIZET_ARG(samples_len),
+          samples_num,
+          SIZET_ARG(samples_len),
+          SIZET_ARG(heap_profile_sample_interval ? heap_profile_sample_interval :
+                                                   MEM_HEAP_PROFILE_DEFAULT_SAMPLE_INTERVAL));
+  for (const HeapProfileSample *sample = heap_profile_samples; sample; sample = sample->next) {
+    fprintf(file,
+            "1: " SIZET_FORMAT " [1: " SIZET_FORMAT "] @",
+            SIZET_ARG(sample->len),
+            SIZET_ARG(sample->len));
+    for (int i = 0; i < sample->frames_num; i++) {
+      fprintf(file, " %p", sample->frames[i]);
+    }
+    fprintf(file, "\n");
+  }
+  pthread_mutex_unlock(&heap_profile_lock);
+
+#ifdef __linux__
+  /* Memory mappings are needed by `pprof` to symbolize the addresses. */
+  FILE *maps = fopen("/proc/self/maps", "r");
+  if (maps) {
+    fprintf(file, "\nMAPPED_LIBRARIES:\n");
+    char buffer[4096];
+    size_t buffer_len;
+    while ((buffer_len = fread(buffer, 1, sizeof(buffer), maps)) > 0) {
+      fwrite(buffer, 1, buffer_len, file);
+    }
+    fclose(maps);
+  }
+#endif
+
+  fclose(file);
+  return true;
+}
+
+/** \} */
+
+static void *mem_lockfree_mallocN_aligned_ex(
+    size_t len, size_t alignment, bool clear, bool sampled, const char *str);
+
+/* Allocate memory for the head and `len` bytes of data, the flags which are to be stored in the
+ * head length are returned in `r_len_flags`. */
+MEM_INLINE MemHead *memhead_malloc(size_t len, bool clear, size_t *r_len_flags)
+{
+#ifdef WITH_MEM_THREAD_CACHE
+  if (len <= THREAD_CACHE_LEN_MAX) {
+    *r_len_flags = MEMHEAD_THREAD_CACHE_FLAG;
+    return thread_cache_malloc(len, clear);
+  }
+#endif
+  *r_len_flags = 0;
+  return (MemHead *)(clear ? calloc(1, len + sizeof(MemHead)) : malloc(len + sizeof(MemHead)));
+}
+
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (LIKELY(vmemh)) {
@@ -111,8 +452,16 @@ void MEM_lockfree_freeN(void *vmemh)
   }
   if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
     MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-    aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
+    if (UNLIKELY(memh_aligned->alignment & MEMHEAD_ALIGNMENT_SAMPLED_FLAG)) {
+      heap_profile_sample_remove(MEMHEAD_ALIGNED_SAMPLE(memh_aligned));
+    }
+    aligned_free(MEMHEAD_ALIGNED_REAL_PTR(memh_aligned));
   }
+#ifdef WITH_MEM_THREAD_CACHE
+  else if (MEMHEAD_IS_THREAD_CACHE(memh) && thread_cache_free(memh, len)) {
+    /* Pass. */
+  }
+#endif
   else {
     free(memh);
   }
@@ -127,7 +476,7 @@ void *MEM_lockfree_dupallocN(const void *vmemh)
     if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
       newp = MEM_lockfree_mallocN_aligned(
-          prev_size, (size_t)memh_aligned->alignment, "dupli_malloc");
+          prev_size, MEMHEAD_ALIGNMENT(memh_aligned), "dupli_malloc");
     }
     else {
       newp = MEM_lockfree_mallocN(prev_size, "dupli_malloc");
@@ -150,7 +499,7 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
     }
     else {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+      newp = MEM_lockfree_mallocN_aligned(len, MEMHEAD_ALIGNMENT(memh_aligned), "realloc");
     }
 
     if (newp) {
@@ -186,7 +535,7 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
     }
     else {
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
-      newp = MEM_lockfree_mallocN_aligned(len, (size_t)memh_aligned->alignment, "recalloc");
+      newp = MEM_lockfree_mallocN_aligned(len, MEMHEAD_ALIGNMENT(memh_aligned), "recalloc");
     }
 
     if (newp) {
@@ -217,13 +566,19 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
 void *MEM_lockfree_callocN(size_t len, const char *str)
 {
   MemHead *memh;
+  size_t len_flags;
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  if (UNLIKELY(heap_profile_should_sample(len))) {
+    return mem_lockfree_mallocN_aligned_ex(
+        len, ALIGNED_MALLOC_MINIMUM_ALIGNMENT, true, true, str);
+  }
+
+  memh = memhead_malloc(len, true, &len_flags);
 
   if (LIKELY(memh)) {
-    memh->len = len;
+    memh->len = len | len_flags;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -258,17 +613,23 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
 void *MEM_lockfree_mallocN(size_t len, const char *str)
 {
   MemHead *memh;
+  size_t len_flags;
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  if (UNLIKELY(heap_profile_should_sample(len))) {
+    return mem_lockfree_mallocN_aligned_ex(
+        len, ALIGNED_MALLOC_MINIMUM_ALIGNMENT, false, true, str);
+  }
+
+  memh = memhead_malloc(len, false, &len_flags);
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
+    memh->len = len | len_flags;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -300,7 +661,8 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
   return MEM_lockfree_mallocN(total_size, str);
 }
 
-void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str)
+static void *mem_lockfree_mallocN_aligned_ex(
+    size_t len, size_t alignment, bool clear, bool sampled, const char *str)
 {
   /* Huge alignment values doesn't make sense and they wouldn't fit into 'short' used in the
    * MemHead. */
@@ -334,12 +696,19 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
      */
     memh = (MemHeadAligned *)((char *)memh + extra_padding);
 
-    if (UNLIKELY(malloc_debug_memset && len)) {
+    if (clear) {
+      memset(memh + 1, 0, len);
+    }
+    else if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
     memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
+    if (UNLIKELY(sampled)) {
+      memh->alignment |= MEMHEAD_ALIGNMENT_SAMPLED_FLAG;
+      MEMHEAD_ALIGNED_SAMPLE(memh) = heap_profile_sample_add(len);
+    }
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -353,6 +722,12 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
   return NULL;
 }
 
+void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str)
+{
+  return mem_lockfree_mallocN_aligned_ex(
+      len, alignment, false, heap_profile_should_sample(len), str);
+}
+
 void MEM_lockfree_printmemlist_pydict(void)
 {
 }
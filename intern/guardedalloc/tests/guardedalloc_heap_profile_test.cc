@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+std::string ReadHeapProfile()
+{
+  const std::string filepath = ::testing::TempDir() + "guardedalloc_heap_profile.txt";
+  EXPECT_TRUE(MEM_heap_profile_write(filepath.c_str()));
+  std::ifstream file(filepath);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  file.close();
+  std::remove(filepath.c_str());
+  return buffer.str();
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, LockfreeHeapProfile)
+{
+  /* Sample every allocation. */
+  MEM_heap_profile_start(1);
+  void *block = MEM_mallocN(100, __func__);
+  char *cleared = static_cast<char *>(MEM_callocN(200, __func__));
+  void *aligned = MEM_mallocN_aligned(300, 64, __func__);
+  MEM_heap_profile_stop();
+
+  /* Sampled blocks behave like any other block. */
+  EXPECT_EQ(MEM_allocN_len(block), 100);
+  EXPECT_EQ(MEM_allocN_len(cleared), 200);
+  for (int i = 0; i < 200; i++) {
+    EXPECT_EQ(cleared[i], 0);
+  }
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+  block = MEM_reallocN(block, 1000);
+  EXPECT_EQ(MEM_allocN_len(block), 1000);
+
+  const std::string profile = ReadHeapProfile();
+  /* The re-allocated block is not sampled, since the profiler was stopped. */
+  EXPECT_EQ(profile.find("heap profile: 2: 500 [2: 500] @ heap_v2/"), 0);
+  EXPECT_NE(profile.find("1: 200 [1: 200] @"), std::string::npos);
+  EXPECT_NE(profile.find("1: 300 [1: 300] @"), std::string::npos);
+
+  MEM_freeN(block);
+  MEM_freeN(cleared);
+  MEM_freeN(aligned);
+  EXPECT_EQ(ReadHeapProfile().find("heap profile: 0: 0 [0: 0] @ heap_v2/"), 0);
+}
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+/* Allocate and free blocks of many small sizes, so that blocks are re-used from the thread
+ * cache when the allocator is built with it. */
+void AllocFreeSmallBlocks()
+{
+  std::vector<void *> blocks;
+  for (int iteration = 0; iteration < 4; iteration++) {
+    for (size_t len = 0; len < 2048; len += 7) {
+      blocks.push_back(iteration % 2 ? MEM_callocN(len, __func__) : MEM_mallocN(len, __func__));
+      EXPECT_GE(MEM_allocN_len(blocks.back()), len);
+    }
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+    blocks.clear();
+  }
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, LockfreeSmallBlocksAccounting)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  void *block = MEM_mallocN(100, __func__);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use + 100);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + 1);
+  MEM_freeN(block);
+
+  /* A re-used block is cleared and only accounts for the requested length. */
+  char *cleared = static_cast<char *>(MEM_callocN(20, __func__));
+  EXPECT_EQ(MEM_allocN_len(cleared), 20);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use + 20);
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(cleared[i], 0);
+  }
+  MEM_freeN(cleared);
+
+  AllocFreeSmallBlocks();
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
+
+TEST_F(LockFreeAllocatorTest, LockfreeSmallBlocksThreads)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  /* Blocks allocated on one thread and freed on another. */
+  std::vector<void *> blocks;
+  for (size_t len = 0; len < 1024; len += 4) {
+    blocks.push_back(MEM_mallocN(len, __func__));
+  }
+  std::thread free_thread([&]() {
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+    AllocFreeSmallBlocks();
+  });
+  free_thread.join();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back(AllocFreeSmallBlocks);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
@@ -40,6 +40,15 @@ using std::to_string;
 atomic<int> MANTA::solverID(0);
 int MANTA::with_debug(0);
 
+/* Cache files are saved by forked processes while the next frames are simulated, see
+ * #fluid_cache_save_async in the fluid script. Windows has no fork() and forking a process using
+ * the system frameworks is not safe on macOS. */
+#ifdef __linux__
+static const bool with_async_cache_saves = true;
+#else
+static const bool with_async_cache_saves = false;
+#endif
+
 MANTA::MANTA(int *res, FluidModifierData *fmd)
     : mCurrentID(++solverID), mMaxRes(fmd->domain->maxres)
 {
@@ -280,6 +289,10 @@ bool MANTA::initDomain(FluidModifierData *fmd)
   ss << "set_manta_debuglevel(" << with_debug << ")";
   pythonCommands.push_back(ss.str());
 
+  ss.str("");
+  ss << "withMPSave = " << (with_async_cache_saves ? "True" : "False");
+  pythonCommands.push_back(ss.str());
+
   /* Now init basic fluid domain. */
   string tmpString = fluid_variables + fluid_solver + fluid_alloc + fluid_cache_helper +
                      fluid_bake_multiprocessing + fluid_bake_data + fluid_bake_noise +
@@ -546,6 +559,9 @@ MANTA::~MANTA()
     cout << "~FLUID: " << mCurrentID << " with res(" << mResX << ", " << mResY << ", " << mResZ
          << ")" << endl;
 
+  /* Cache files must be complete before the Python objects are freed. */
+  joinCacheWriters();
+
   /* Destruction string for Python. */
   string tmpString = "";
   vector<string> pythonCommands;
@@ -1245,6 +1261,10 @@ bool MANTA::writeData(FluidModifierData *fmd, int framenr)
        << ", '" << volume_format << "', " << resumable_cache << ")";
     pythonCommands.push_back(ss.str());
   }
+  if (mUsingSmoke || mUsingLiquid) {
+    addPendingCacheFile(
+        getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, volume_format, framenr));
+  }
   return runPythonString(pythonCommands);
 }
 
@@ -1266,6 +1286,8 @@ bool MANTA::writeNoise(FluidModifierData *fmd, int framenr)
     ss << "smoke_save_noise_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
        << ", '" << volume_format << "', " << resumable_cache << ")";
     pythonCommands.push_back(ss.str());
+    addPendingCacheFile(
+        getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, volume_format, framenr));
   }
   return runPythonString(pythonCommands);
 }
@@ -1334,6 +1356,9 @@ bool MANTA::readData(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasData(fmd, framenr))
     return false;
 
+  /* Make sure that files saved in the background are complete. */
+  joinCacheWriters();
+
   if (mUsingSmoke) {
     ss.str("");
     ss << "smoke_load_data_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
@@ -1377,6 +1402,9 @@ bool MANTA::readNoise(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasNoise(fmd, framenr))
     return false;
 
+  /* Make sure that files saved in the background are complete. */
+  joinCacheWriters();
+
   ss.str("");
   ss << "smoke_load_noise_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << volume_format << "', " << resumable_cache << ")";
@@ -1405,6 +1433,9 @@ bool MANTA::readMesh(FluidModifierData *fmd, int framenr)
   if (!hasMesh(fmd, framenr))
     return false;
 
+  /* Make sure that files saved in the background are complete. */
+  joinCacheWriters();
+
   ss.str("");
   ss << "liquid_load_mesh_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << mesh_format << "')";
@@ -1446,6 +1477,9 @@ bool MANTA::readParticles(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasParticles(fmd, framenr))
     return false;
 
+  /* Make sure that files saved in the background are complete. */
+  joinCacheWriters();
+
   ss.str("");
   ss << "liquid_load_particles_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << volume_format << "', " << resumable_cache << ")";
@@ -1476,6 +1510,9 @@ bool MANTA::readGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
   if (!hasGuiding(fmd, framenr, sourceDomain))
     return false;
 
+  /* Make sure that files saved in the background are complete. */
+  joinCacheWriters();
+
   if (sourceDomain) {
     ss.str("");
     ss << "fluid_load_vel_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
@@ -1574,6 +1611,7 @@ bool MANTA::bakeMesh(FluidModifierData *fmd, int framenr)
   ss << "bake_mesh_" << mCurrentID << "('" << escapePath(cacheDirMesh) << "', " << framenr << ", '"
      << volume_format << "', '" << mesh_format << "')";
   pythonCommands.push_back(ss.str());
+  addPendingCacheFile(getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, mesh_format, framenr));
 
   return runPythonString(pythonCommands);
 }
@@ -1604,6 +1642,8 @@ bool MANTA::bakeParticles(FluidModifierData *fmd, int framenr)
   ss << "bake_particles_" << mCurrentID << "('" << escapePath(cacheDirParticles) << "', "
      << framenr << ", '" << volume_format << "', " << resumable_cache << ")";
   pythonCommands.push_back(ss.str());
+  addPendingCacheFile(
+      getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, volume_format, framenr));
 
   return runPythonString(pythonCommands);
 }
@@ -1634,6 +1674,8 @@ bool MANTA::bakeGuiding(FluidModifierData *fmd, int framenr)
   ss << "bake_guiding_" << mCurrentID << "('" << escapePath(cacheDirGuiding) << "', " << framenr
      << ", '" << volume_format << "', " << resumable_cache << ")";
   pythonCommands.push_back(ss.str());
+  addPendingCacheFile(
+      getFile(fmd, FLUID_DOMAIN_DIR_GUIDE, FLUID_NAME_GUIDING, volume_format, framenr));
 
   return runPythonString(pythonCommands);
 }
@@ -2218,8 +2260,8 @@ bool MANTA::hasConfig(FluidModifierData *fmd, int framenr)
 bool MANTA::hasData(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, extension, framenr).c_str());
+  bool exists = hasCacheFile(
+      getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, extension, framenr));
 
   /* Check single file naming. */
   if (!exists) {
@@ -2235,8 +2277,8 @@ bool MANTA::hasData(FluidModifierData *fmd, int framenr)
 bool MANTA::hasNoise(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, extension, framenr).c_str());
+  bool exists = hasCacheFile(
+      getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, extension, framenr));
 
   /* Check single file naming. */
   if (!exists) {
@@ -2261,8 +2303,8 @@ bool MANTA::hasNoise(FluidModifierData *fmd, int framenr)
 bool MANTA::hasMesh(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_mesh_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, extension, framenr).c_str());
+  bool exists = hasCacheFile(
+      getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, extension, framenr));
 
   /* Check old file naming. */
   if (!exists) {
@@ -2278,8 +2320,8 @@ bool MANTA::hasMesh(FluidModifierData *fmd, int framenr)
 bool MANTA::hasParticles(FluidModifierData *fmd, int framenr)
 {
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(
-      getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, extension, framenr).c_str());
+  bool exists = hasCacheFile(
+      getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, extension, framenr));
 
   /* Check single file naming. */
   if (!exists) {
@@ -2306,7 +2348,7 @@ bool MANTA::hasGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
   string subdirectory = (sourceDomain) ? FLUID_DOMAIN_DIR_DATA : FLUID_DOMAIN_DIR_GUIDE;
   string filename = (sourceDomain) ? FLUID_NAME_DATA : FLUID_NAME_GUIDING;
   string extension = getCacheFileEnding(fmd->domain->cache_data_format);
-  bool exists = BLI_exists(getFile(fmd, subdirectory, filename, extension, framenr).c_str());
+  bool exists = hasCacheFile(getFile(fmd, subdirectory, filename, extension, framenr));
 
   /* Check old file naming. */
   if (!exists) {
@@ -2320,6 +2362,35 @@ bool MANTA::hasGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
   return exists;
 }
 
+bool MANTA::joinCacheWriters()
+{
+  if (mPendingCacheFiles.empty())
+    return true;
+
+  if (with_debug)
+    cout << "MANTA::joinCacheWriters()" << endl;
+
+  ostringstream ss;
+  vector<string> pythonCommands;
+
+  ss << "fluid_cache_join_writers_" << mCurrentID << "()";
+  pythonCommands.push_back(ss.str());
+
+  mPendingCacheFiles.clear();
+  return runPythonString(pythonCommands);
+}
+
+void MANTA::addPendingCacheFile(const string &file)
+{
+  if (with_async_cache_saves)
+    mPendingCacheFiles.insert(file);
+}
+
+bool MANTA::hasCacheFile(const string &file)
+{
+  return BLI_exists(file.c_str()) || mPendingCacheFiles.count(file);
+}
+
 string MANTA::getDirectory(FluidModifierData *fmd, string subdirectory)
 {
   char directory[FILE_MAX];
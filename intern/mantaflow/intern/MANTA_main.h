@@ -12,11 +12,13 @@
 #include <cassert>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using std::atomic;
 using std::string;
 using std::unordered_map;
+using std::unordered_set;
 using std::vector;
 
 struct MANTA {
@@ -70,6 +72,9 @@ struct MANTA {
   bool writeNoise(FluidModifierData *fmd, int framenr);
   /* Write calls for mesh and particles were left in bake calls for now. */
 
+  /* Wait for the cache files that are still being written in the background. */
+  bool joinCacheWriters();
+
   /* Read cache (via Python). */
   bool readConfiguration(FluidModifierData *fmd, int framenr);
   bool readData(FluidModifierData *fmd, int framenr, bool resumable);
@@ -728,6 +733,9 @@ struct MANTA {
 
   unordered_map<string, string> mRNAMap;
 
+  /* Cache files being written in the background, which might not exist on disk yet. */
+  unordered_set<string> mPendingCacheFiles;
+
   /* The ID of the solver objects will be incremented for every new object. */
   const int mCurrentID;
 
@@ -870,6 +878,8 @@ struct MANTA {
                  string fname,
                  string extension,
                  int framenr);
+  void addPendingCacheFile(const string &file);
+  bool hasCacheFile(const string &file);
 };
 
 #endif
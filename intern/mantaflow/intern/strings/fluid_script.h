@@ -19,6 +19,7 @@ import os.path, shutil, math, sys, gc, multiprocessing, platform, time\n\
 \n\
 withMPBake = False # Bake files asynchronously\n\
 withMPSave = False # Save files asynchronously\n\
+maxMPSaveWriters = 2 # Number of frames being saved asynchronously at the same time\n\
 isWindows = platform.system() != 'Darwin' and platform.system() != 'Linux'\n\
 # TODO(sebbas): Use this to simulate Windows multiprocessing (has default mode spawn)\n\
 #try:\n\
@@ -509,7 +510,26 @@ def fluid_cache_multiprocessing_start_$ID$(function, framenr, file_name=None, fo
         p$ID$ = multiprocessing.Process(target=function, args=args)\n\
         p$ID$.start()\n\
         if do_join:\n\
-            p$ID$.join()\n";
+            p$ID$.join()\n\
+\n\
+# Forked writers save a copy-on-write snapshot of the grids while the next frames are simulated\n\
+if 'fluid_cache_writers_s$ID$' not in globals(): fluid_cache_writers_s$ID$ = []\n\
+\n\
+def fluid_cache_save_async_$ID$(**kwargs):\n\
+    mantaMsg('Saving cache asynchronously')\n\
+    # Drop finished writers and wait for the oldest ones, every snapshot may end up as a full copy of the grids\n\
+    fluid_cache_writers_s$ID$[:] = [p for p in fluid_cache_writers_s$ID$ if p.is_alive()]\n\
+    while len(fluid_cache_writers_s$ID$) >= maxMPSaveWriters:\n\
+        fluid_cache_writers_s$ID$.pop(0).join()\n\
+    p = multiprocessing.get_context('fork').Process(target=fluid_file_export_s$ID$, kwargs=kwargs)\n\
+    p.start()\n\
+    fluid_cache_writers_s$ID$.append(p)\n\
+\n\
+def fluid_cache_join_writers_$ID$():\n\
+    mantaMsg('Waiting for asynchronous cache saves')\n\
+    for p in fluid_cache_writers_s$ID$:\n\
+        p.join()\n\
+    fluid_cache_writers_s$ID$.clear()\n";
 
 const std::string fluid_bake_data =
     "\n\
@@ -720,7 +740,7 @@ def fluid_save_guiding_$ID$(path, framenr, file_format, resumable):\n\
     if not withMPSave or isWindows:\n\
         fluid_file_export_s$ID$(dict=dict, framenr=framenr, file_format=file_format, path=path, file_name=file_guiding_s$ID$)\n\
     else:\n\
-        fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, file_name=file_guiding_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n";
+        fluid_cache_save_async_$ID$(dict=dict, framenr=framenr, file_format=file_format, path=path, file_name=file_guiding_s$ID$)\n";
 
 //////////////////////////////////////////////////////////////////////
 // STANDALONE MODE
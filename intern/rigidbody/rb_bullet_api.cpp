@@ -51,12 +51,32 @@
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 #include "BulletCollision/Gimpact/btGImpactShape.h"
 
+#if BT_THREADSAFE && defined(WITH_TBB)
+#  include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#  include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#  include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#  include "LinearMath/btThreads.h"
+
+#  include <algorithm>
+#  include <mutex>
+
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/parallel_reduce.h>
+#  include <tbb/task_arena.h>
+
+/* Step the dynamics worlds on multiple threads, see #rbTaskScheduler. */
+#  define WITH_BULLET_MT
+#endif
+
 struct rbDynamicsWorld {
   btDiscreteDynamicsWorld *dynamicsWorld;
   btDefaultCollisionConfiguration *collisionConfiguration;
   btDispatcher *dispatcher;
   btBroadphaseInterface *pairCache;
   btConstraintSolver *constraintSolver;
+  /* Multi-threaded solver for islands too large to be solved by a single thread, may be null. */
+  btConstraintSolver *constraintSolverMt;
   btOverlapFilterCallback *filterCallback;
 };
 struct rbRigidBody {
@@ -101,6 +121,70 @@ struct rbFilterCallback : public btOverlapFilterCallback {
   }
 };
 
+#ifdef WITH_BULLET_MT
+/* Runs the parallel loops of the multi-threaded dynamics world with TBB, so that Bullet shares
+ * the worker threads of the rest of Blender instead of creating its own. */
+class rbTaskScheduler : public btITaskScheduler {
+ private:
+  int num_threads_;
+
+ public:
+  rbTaskScheduler() : btITaskScheduler("TBB")
+  {
+    num_threads_ = getMaxNumThreads();
+  }
+
+  int getMaxNumThreads() const override
+  {
+    /* Bullet keeps per-thread data for a limited amount of threads. */
+    return std::min(int(BT_MAX_THREAD_COUNT), tbb::this_task_arena::max_concurrency());
+  }
+
+  int getNumThreads() const override
+  {
+    return num_threads_;
+  }
+
+  void setNumThreads(int num_threads) override
+  {
+    num_threads_ = std::max(1, std::min(getMaxNumThreads(), num_threads));
+  }
+
+  void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body) override
+  {
+    tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize),
+                      [&](const tbb::blocked_range<int> &range) {
+                        body.forLoop(range.begin(), range.end());
+                      });
+  }
+
+  btScalar parallelSum(int iBegin,
+                       int iEnd,
+                       int grainSize,
+                       const btIParallelSumBody &body) override
+  {
+    return tbb::parallel_reduce(
+        tbb::blocked_range<int>(iBegin, iEnd, grainSize),
+        btScalar(0),
+        [&](const tbb::blocked_range<int> &range, btScalar sum) {
+          return sum + body.sumLoop(range.begin(), range.end());
+        },
+        [](btScalar a, btScalar b) { return a + b; });
+  }
+};
+
+static btITaskScheduler *rb_task_scheduler_ensure()
+{
+  static rbTaskScheduler task_scheduler;
+  static std::once_flag init_flag;
+  /* Bullet requires the scheduler to be set from the first thread using it, which fails when the
+   * thread index was already assigned by some other Bullet call. Worlds are stepped on a single
+   * thread in that case. */
+  std::call_once(init_flag, []() { btSetTaskScheduler(&task_scheduler); });
+  return (btGetTaskScheduler() == &task_scheduler) ? &task_scheduler : nullptr;
+}
+#endif
+
 static inline void copy_v3_btvec3(float vec[3], const btVector3 &btvec)
 {
   vec[0] = (float)btvec[0];
@@ -122,12 +206,23 @@ static inline void copy_quat_btquat(float quat[4], const btQuaternion &btquat)
 
 rbDynamicsWorld *RB_dworld_new(const float gravity[3])
 {
-  rbDynamicsWorld *world = new rbDynamicsWorld;
+  rbDynamicsWorld *world = new rbDynamicsWorld();
+
+#ifdef WITH_BULLET_MT
+  btITaskScheduler *task_scheduler = rb_task_scheduler_ensure();
+#endif
 
   /* collision detection/handling */
   world->collisionConfiguration = new btDefaultCollisionConfiguration();
 
-  world->dispatcher = new btCollisionDispatcher(world->collisionConfiguration);
+#ifdef WITH_BULLET_MT
+  if (task_scheduler) {
+    world->dispatcher = new btCollisionDispatcherMt(world->collisionConfiguration);
+  }
+#endif
+  if (world->dispatcher == nullptr) {
+    world->dispatcher = new btCollisionDispatcher(world->collisionConfiguration);
+  }
   btGImpactCollisionAlgorithm::registerAlgorithm((btCollisionDispatcher *)world->dispatcher);
 
   world->pairCache = new btDbvtBroadphase();
@@ -135,12 +230,31 @@ rbDynamicsWorld *RB_dworld_new(const float gravity[3])
   world->filterCallback = new rbFilterCallback();
   world->pairCache->getOverlappingPairCache()->setOverlapFilterCallback(world->filterCallback);
 
-  /* constraint solving */
-  world->constraintSolver = new btSequentialImpulseConstraintSolver();
-
-  /* world */
-  world->dynamicsWorld = new btDiscreteDynamicsWorld(
-      world->dispatcher, world->pairCache, world->constraintSolver, world->collisionConfiguration);
+#ifdef WITH_BULLET_MT
+  if (task_scheduler) {
+    /* Islands are solved in parallel by a pool of solvers, one per thread. */
+    btConstraintSolverPoolMt *solver_pool = new btConstraintSolverPoolMt(
+        task_scheduler->getNumThreads());
+    world->constraintSolver = solver_pool;
+    world->constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+
+    world->dynamicsWorld = new btDiscreteDynamicsWorldMt(world->dispatcher,
+                                                         world->pairCache,
+                                                         solver_pool,
+                                                         world->constraintSolverMt,
+                                                         world->collisionConfiguration);
+  }
+#endif
+  if (world->dynamicsWorld == nullptr) {
+    /* constraint solving */
+    world->constraintSolver = new btSequentialImpulseConstraintSolver();
+
+    /* world */
+    world->dynamicsWorld = new btDiscreteDynamicsWorld(world->dispatcher,
+                                                       world->pairCache,
+                                                       world->constraintSolver,
+                                                       world->collisionConfiguration);
+  }
 
   RB_dworld_set_gravity(world, gravity);
 
@@ -151,6 +265,7 @@ void RB_dworld_delete(rbDynamicsWorld *world)
 {
   /* bullet doesn't like if we free these in a different order */
   delete world->dynamicsWorld;
+  delete world->constraintSolverMt;
   delete world->constraintSolver;
   delete world->pairCache;
   delete world->dispatcher;
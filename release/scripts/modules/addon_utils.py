@@ -321,6 +321,11 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     if default_set:
         _addon_ensure(module_name)
 
+    use_timing = _bpy.app.debug_startup_timing
+    if use_timing:
+        from time import perf_counter
+        time_start = perf_counter()
+
     # Split registering up into 3 steps so we can undo
     # if it fails par way through.
 
@@ -387,6 +392,9 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     if _bpy.app.debug_python:
         print("\taddon_utils.enable", mod.__name__)
 
+    if use_timing:
+        print("Add-on %r enabled in %.2f ms" % (module_name, (perf_counter() - time_start) * 1000.0))
+
     return mod
 
 
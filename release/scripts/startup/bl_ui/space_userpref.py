@@ -2308,6 +2308,9 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
                 ({"property": "use_full_frame_compositor"}, "T88150"),
                 ({"property": "enable_eevee_next"}, "T93220"),
                 ({"property": "use_draw_manager_acquire_lock"}, "T98016"),
+                ({"property": "use_undo_skip_unchanged_ids"}, None),
+                ({"property": "use_viewport_mesh_lod"}, None),
+                ({"property": "use_sequencer_hardware_decode"}, None),
             ),
         )
 
@@ -249,6 +249,11 @@ void free_bvhtree_from_pointcloud(struct BVHTreeFromPointCloud *data);
 
 bool bvhcache_has_tree(const struct BVHCache *bvh_cache, const BVHTree *tree);
 struct BVHCache *bvhcache_init(void);
+/**
+ * Tag the trees of a BVH-cache as outdated after the vertex positions changed while the topology
+ * stayed the same. Outdated trees are refit instead of rebuilt when they are requested again.
+ */
+void bvhcache_tag_positions_changed(struct BVHCache *bvh_cache);
 /**
  * Frees a BVH-cache.
  */
@@ -48,10 +48,12 @@ void BKE_cachefile_reader_free(struct CacheFile *cache_file, struct CacheReader
  * Determine whether the #CacheFile should use a render engine procedural. If so, data is not read
  * from the file and bounding boxes are used to represent the objects in the Scene.
  * Render engines will receive the bounding box as a placeholder but can instead
- * load the data directly if they support it.
+ * load the data directly if they support it. Some render engines only support it for final
+ * renders, as given by \a is_final_render.
  */
 bool BKE_cache_file_uses_render_procedural(const struct CacheFile *cache_file,
-                                           struct Scene *scene);
+                                           struct Scene *scene,
+                                           bool is_final_render);
 
 /**
  * Add a layer to the cache_file. Return NULL if the `filepath` is already that of an existing
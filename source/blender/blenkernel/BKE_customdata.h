@@ -66,6 +66,20 @@ typedef enum eCDAllocType {
    * if all layer values will be set by the caller after creating the layer.
    */
   CD_CONSTRUCT = 5,
+  /**
+   * Share the data of layers with the source instead of copying it, for layer types which don't
+   * own any additional allocations. The data is reference counted, so it stays valid when the
+   * source layer is freed. The new layers are flagged like #CD_REFERENCE ones, so the data is
+   * duplicated when it is requested for writing (see #CustomData_duplicate_referenced_layer).
+   * Other layers are duplicated.
+   */
+  CD_SHARE = 6,
+  /**
+   * Like #CD_SHARE, but the shared data becomes immutable for the source as well: its layers are
+   * flagged like #CD_REFERENCE ones and copy the data before it is modified. Used when the source
+   * can't be modified while it's shared anyway, like geometry that is shared in geometry nodes.
+   */
+  CD_SHARE_IMMUTABLE = 7,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (eCustomDataMask)((eCustomDataMask)1 << (eCustomDataMask)(_type))
@@ -67,6 +67,16 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /**
+   * Vertices changed by the last update of a modal edit along with their connected vertices,
+   * so modifiers only need to update these, see #ModifierPartialUpdate.
+   * Null when any vertex may have changed.
+   */
+  int *partial_update_verts;
+  int partial_update_verts_len;
+  /** Increased on every change of `partial_update_verts`. */
+  int partial_update_id;
+
 } BMEditMesh;
 
 /* editmesh.cc */
@@ -81,6 +91,22 @@ void BKE_editmesh_looptri_calc_with_partial(BMEditMesh *em, struct BMPartialUpda
 void BKE_editmesh_looptri_and_normals_calc_with_partial(BMEditMesh *em,
                                                         struct BMPartialUpdate *bmpinfo);
 
+/**
+ * Set the vertices changed by a modal edit, for partial updates of the modifiers.
+ * Takes ownership of \a verts, which is extended to the connected vertices.
+ * Call #BKE_editmesh_partial_update_tag for following changes of the same vertices and
+ * #BKE_editmesh_partial_update_clear once done.
+ */
+void BKE_editmesh_partial_update_set(BMEditMesh *em, int *verts, int verts_len);
+/**
+ * Tag the vertices set by #BKE_editmesh_partial_update_set as changed again.
+ */
+void BKE_editmesh_partial_update_tag(BMEditMesh *em);
+/**
+ * Stop partial updates, following evaluations update all vertices.
+ */
+void BKE_editmesh_partial_update_clear(BMEditMesh *em);
+
 /**
  * Performing the face normal calculation at the same time as tessellation
  * gives a reasonable performance boost (approx ~20% faster).
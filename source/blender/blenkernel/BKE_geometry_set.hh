@@ -134,6 +134,12 @@ struct GeometrySet {
    * component of the given type.
    */
   GeometryComponent &get_component_for_write(GeometryComponentType component_type);
+  /**
+   * The number of components that #get_component_for_write copied on the calling thread because
+   * they were shared. Only the difference between two calls is meaningful, it's used for
+   * profiling.
+   */
+  static int64_t copied_components_num_on_thread();
   template<typename Component> Component &get_component_for_write()
   {
     BLI_STATIC_ASSERT(is_geometry_component_v<Component>, "");
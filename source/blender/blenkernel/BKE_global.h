@@ -150,6 +150,8 @@ enum {
   /** Support simulating events (for testing). */
   G_FLAG_EVENT_SIMULATE = (1 << 3),
   G_FLAG_USERPREF_NO_SAVE_ON_EXIT = (1 << 4),
+  /** Keep the evaluated render dependency graph between frames of an animation render. */
+  G_FLAG_RENDER_PERSISTENT_DEPSGRAPH = (1 << 5),
 
   G_FLAG_SCRIPT_AUTOEXEC = (1 << 13),
   /** When this flag is set ignore the prefs #USER_SCRIPT_AUTOEXEC_DISABLE. */
@@ -161,7 +163,7 @@ enum {
 /** Don't overwrite these flags when reading a file. */
 #define G_FLAG_ALL_RUNTIME \
   (G_FLAG_SCRIPT_AUTOEXEC | G_FLAG_SCRIPT_OVERRIDE_PREF | G_FLAG_EVENT_SIMULATE | \
-   G_FLAG_USERPREF_NO_SAVE_ON_EXIT | \
+   G_FLAG_USERPREF_NO_SAVE_ON_EXIT | G_FLAG_RENDER_PERSISTENT_DEPSGRAPH | \
 \
    /* #BPY_python_reset is responsible for resetting these flags on file load. */ \
    G_FLAG_SCRIPT_AUTOEXEC_FAIL | G_FLAG_SCRIPT_AUTOEXEC_FAIL_QUIET)
@@ -177,7 +179,7 @@ enum {
   G_DEBUG_EVENTS = (1 << 3),                /* input/window/screen events */
   G_DEBUG_HANDLERS = (1 << 4),              /* events handling */
   G_DEBUG_WM = (1 << 5),                    /* operator, undo */
-  G_DEBUG_JOBS = (1 << 6),                  /* jobs time profiling */
+  G_DEBUG_JOBS = (1 << 6),                  /* jobs and parallel loops time profiling */
   G_DEBUG_FREESTYLE = (1 << 7),             /* freestyle messages */
   G_DEBUG_DEPSGRAPH_BUILD = (1 << 8),       /* depsgraph construction messages */
   G_DEBUG_DEPSGRAPH_EVAL = (1 << 9),        /* depsgraph evaluation messages */
@@ -199,6 +201,9 @@ enum {
 
   G_DEBUG_GHOST = (1 << 22),  /* Debug GHOST module. */
   G_DEBUG_WINTAB = (1 << 23), /* Debug Wintab. */
+
+  G_DEBUG_GEOMETRY_NODES_PROFILE = (1 << 24), /* Profile geometry nodes evaluation. */
+  G_DEBUG_STARTUP_TIMING = (1 << 25),         /* Time startup stages and add-ons. */
 };
 
 #define G_DEBUG_ALL \
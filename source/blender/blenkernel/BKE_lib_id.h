@@ -159,6 +159,11 @@ enum {
   /** When copying local sub-data (like constraints or modifiers), do not set their "library
    * override local data" flag. */
   LIB_ID_COPY_NO_LIB_OVERRIDE_LOCAL_DATA_FLAG = 1 << 22,
+  /**
+   * Mesh: Share the CD data layers with the source until either of them modifies them, see
+   * #CD_SHARE_IMMUTABLE.
+   */
+  LIB_ID_COPY_CD_SHARE = 1 << 23,
 
   /* *** XXX Hackish/not-so-nice specific behaviors needed for some corner cases. *** */
   /* *** Ideally we should not have those, but we need them for now... *** */
@@ -486,6 +491,16 @@ void BKE_lib_id_swap_full(struct Main *bmain, struct ID *id_a, struct ID *id_b);
  * immediately before or after that pointer. It must always be into given \a lb list.
  */
 void id_sort_by_name(struct ListBase *lb, struct ID *id, struct ID *id_sorting_hint);
+/**
+ * Defer sorting the IDs created or renamed in \a bmain until the matching
+ * #BKE_main_id_sort_defer_end call, which sorts every list of \a bmain once. Inserting every ID
+ * in its sorted position is quadratic when creating many IDs with unrelated names.
+ * Calls can be nested, lists are only sorted at the end of the outermost one.
+ *
+ * \note Lists are not sorted in between, so code looking up IDs must not rely on it.
+ */
+void BKE_main_id_sort_defer_begin(struct Main *bmain);
+void BKE_main_id_sort_defer_end(struct Main *bmain);
 /**
  * Expand ID usages of given id as 'extern' (and no more indirect) linked data.
  * Used by ID copy/make_local functions.
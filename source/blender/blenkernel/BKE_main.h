@@ -138,6 +138,12 @@ typedef struct Main {
    */
   bool is_locked_for_linking;
 
+  /**
+   * While non-zero, sorting new and renamed IDs by name in their list is deferred,
+   * see #BKE_main_id_sort_defer_begin.
+   */
+  int id_sort_defer_level;
+
   BlendThumbnail *blen_thumb;
 
   struct Library *curlib;
@@ -357,6 +357,21 @@ void BKE_mesh_recalc_looptri_with_normals(const struct MLoop *mloop,
                                           int totpoly,
                                           struct MLoopTri *mlooptri,
                                           const float (*poly_normals)[3]);
+/**
+ * Update an existing tessellation after the vertex positions changed, the topology must be the
+ * same as when the tessellation was calculated. Only quads and n-gons are recalculated, since
+ * the triangulation of triangles doesn't depend on the positions.
+ *
+ * \param poly_normals: Optional pre-calculated polygon normals, see
+ * #BKE_mesh_recalc_looptri_with_normals.
+ */
+void BKE_mesh_update_looptri_positions(const struct MLoop *mloop,
+                                       const struct MPoly *mpoly,
+                                       const struct MVert *mvert,
+                                       int totloop,
+                                       int totpoly,
+                                       struct MLoopTri *mlooptri,
+                                       const float (*poly_normals)[3]);
 
 /* *** mesh_normals.cc *** */
 
@@ -919,6 +934,9 @@ bool BKE_mesh_validate_material_indices(struct Mesh *me);
 /**
  * Validate the mesh, \a do_fixes requires \a mesh to be non-null.
  *
+ * The mesh is checked in parallel first. The slower serial checks, which report and fix the
+ * problems, only run when that finds something.
+ *
  * \return false if no changes needed to be made.
  *
  * Vertex Normals
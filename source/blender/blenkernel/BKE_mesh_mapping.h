@@ -20,6 +20,7 @@ struct MLoopTri;
 struct MLoopUV;
 struct MPoly;
 struct MVert;
+struct Mesh;
 
 /* UvVertMap */
 #define STD_UV_CONNECT_LIMIT 0.0001f
@@ -331,6 +332,25 @@ int *BKE_mesh_calc_smoothgroups(const struct MEdge *medge,
     ((_tri)[2] == _v) ? 2 : \
                         -1))
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Topology Cache
+ *
+ * Adjacency maps that are computed when they are first needed and are kept on the mesh until
+ * its topology changes, so that they can be reused when only the positions change.
+ * \{ */
+
+struct MeshTopologyCache;
+
+struct MeshTopologyCache *BKE_mesh_topology_cache_new(void);
+void BKE_mesh_topology_cache_free(struct MeshTopologyCache *cache);
+/**
+ * Free all cached maps. Must be called when the topology of the mesh changes, while no other
+ * thread accesses the mesh.
+ */
+void BKE_mesh_topology_cache_clear(struct MeshTopologyCache *cache);
+
+/** \} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -338,6 +358,36 @@ int *BKE_mesh_calc_smoothgroups(const struct MEdge *medge,
 #ifdef __cplusplus
 namespace blender::mesh_topology {
 
+/**
+ * Maps every element to a group of other elements, e.g. every vertex to the corners around it.
+ * The groups are stored contiguously, the group of element `i` starts at `offsets[i]` and ends
+ * before `offsets[i + 1]`.
+ */
+struct GroupedIndices {
+  Span<int> offsets;
+  Span<int> indices;
+
+  int64_t size() const
+  {
+    return offsets.is_empty() ? 0 : offsets.size() - 1;
+  }
+
+  Span<int> operator[](const int64_t index) const
+  {
+    return indices.slice(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+};
+
+/**
+ * Lazily computed maps that are cached on the mesh, see #MeshTopologyCache. They are valid until
+ * the topology of the mesh changes. The indices of every group are sorted.
+ */
+Span<int> corner_to_poly_map(const Mesh &mesh);
+GroupedIndices vert_to_corner_map(const Mesh &mesh);
+GroupedIndices vert_to_poly_map(const Mesh &mesh);
+GroupedIndices vert_to_edge_map(const Mesh &mesh);
+GroupedIndices edge_to_poly_map(const Mesh &mesh);
+
 Array<int> build_corner_to_poly_map(Span<MPoly> polys, int loops_num);
 
 Array<Vector<int>> build_vert_to_edge_map(Span<MEdge> edges, int verts_num);
@@ -41,6 +41,11 @@ void BKE_mesh_runtime_free_data(struct Mesh *mesh);
  * it's deformed only, or that its custom data layers are out of date.)
  */
 void BKE_mesh_runtime_reset_on_copy(struct Mesh *mesh, int flag);
+/**
+ * Return a new unique value for #Mesh_Runtime.data_version, to be used when the topology or
+ * attributes of a mesh may have changed.
+ */
+uint32_t BKE_mesh_runtime_data_version_new(void);
 int BKE_mesh_runtime_looptri_len(const struct Mesh *mesh);
 void BKE_mesh_runtime_looptri_recalc(struct Mesh *mesh);
 /**
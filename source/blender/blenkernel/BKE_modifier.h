@@ -101,8 +101,15 @@ typedef enum {
 
   /** Accepts #BMesh input (without conversion). */
   eModifierTypeFlag_AcceptsBMesh = (1 << 11),
+
+  /**
+   * Deform only modifier where the result of each vertex only depends on its own coordinates
+   * and normal, so it can keep its previous result and only update the vertices of
+   * #ModifierEvalContext.partial_update.
+   */
+  eModifierTypeFlag_SupportsPartialUpdate = (1 << 12),
 } ModifierTypeFlag;
-ENUM_OPERATORS(ModifierTypeFlag, eModifierTypeFlag_AcceptsBMesh)
+ENUM_OPERATORS(ModifierTypeFlag, eModifierTypeFlag_SupportsPartialUpdate)
 
 typedef void (*IDWalkFunc)(void *userData, struct Object *ob, struct ID **idpoin, int cb_flag);
 typedef void (*TexWalkFunc)(void *userData,
@@ -134,12 +141,30 @@ typedef struct ModifierUpdateDepsgraphContext {
   struct DepsNodeHandle *node;
 } ModifierUpdateDepsgraphContext;
 
+/**
+ * Vertices changed since the previous evaluation of the modifier stack, passed to the modifiers
+ * supporting #eModifierTypeFlag_SupportsPartialUpdate while editing (see
+ * #BKE_editmesh_partial_update_set).
+ */
+typedef struct ModifierPartialUpdate {
+  /** Changed vertices and their connected vertices, null when all vertices may have changed. */
+  const int *verts;
+  int verts_len;
+  /**
+   * Increased on every change, a modifier can only update the changed vertices when its previous
+   * result was calculated for `update_id - 1`.
+   */
+  int update_id;
+} ModifierPartialUpdate;
+
 /* Contains the information for deformXXX and applyXXX functions below that
  * doesn't change between consecutive modifiers. */
 typedef struct ModifierEvalContext {
   struct Depsgraph *depsgraph;
   struct Object *object;
   ModifierApplyFlag flag;
+  /** Only set for modifiers supporting #eModifierTypeFlag_SupportsPartialUpdate. */
+  const ModifierPartialUpdate *partial_update;
 } ModifierEvalContext;
 
 typedef struct ModifierTypeInfo {
@@ -330,6 +330,11 @@ typedef struct bNodeType {
    * responsibility of the caller. */
   NodeGetCompositorShaderNodeFunction get_compositor_shader_node;
 
+  /* A message for nodes whose realtime compositor operation is only a placeholder, for instance
+   * one that passes its input through. Final renders fall back to the CPU compositor for node
+   * trees that use such nodes. The message is static and requires no memory handling. */
+  const char *realtime_compositor_unsupported_message;
+
   /* Build a multi-function for this node. */
   NodeMultiFunctionBuildFunction build_multi_function;
 
@@ -340,6 +345,12 @@ typedef struct bNodeType {
    * performance by specifying required data in one call and using it for calculations in another.
    */
   bool geometry_node_execute_supports_laziness;
+  /**
+   * If true, the outputs of the node are cached across evaluations of the node tree, when the node
+   * is evaluated again with the same settings and inputs. Only useful for slow nodes, because all
+   * input geometry is hashed.
+   */
+  bool geometry_node_cache_outputs;
 
   /* Declares which sockets the node has. */
   NodeDeclareFunction declare;
@@ -115,6 +115,8 @@ typedef enum {
   PBVH_UpdateDrawBuffers = 1 << 4,
   PBVH_UpdateRedraw = 1 << 5,
   PBVH_UpdateMask = 1 << 6,
+  /** Draw buffers were freed to save GPU memory, rebuild them once the node is visible. */
+  PBVH_DrawBuffersEvicted = 1 << 7,
   PBVH_UpdateVisibility = 1 << 8,
 
   PBVH_RebuildDrawBuffers = 1 << 9,
@@ -49,6 +49,8 @@ extern "C" {
 #define PTCACHE_TYPE_SIM_PARTICLES 7
 
 /* high bits reserved for flags that need to be stored in file */
+/* Data is stored one array per data type, each optionally compressed, instead of interleaved
+ * per point. Uncompressed caches are also written this way, the flag name is historical. */
 #define PTCACHE_TYPEFLAG_COMPRESS (1 << 16)
 #define PTCACHE_TYPEFLAG_EXTRADATA (1 << 17)
 
@@ -168,6 +168,9 @@ typedef struct Subdiv {
   struct SubdivDisplacement *displacement_evaluator;
   /* Statistics for debugging. */
   SubdivStats stats;
+  /* Hash of the mesh topology this subdivision surface was last updated from, used to skip the
+   * topology comparison when updating from a deformed mesh. Zero when not created from a mesh. */
+  uint64_t mesh_topology_hash;
 
   /* Cached values, are not supposed to be accessed directly. */
   struct {
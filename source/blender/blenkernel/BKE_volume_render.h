@@ -28,8 +28,13 @@ typedef struct DenseFloatVolumeGrid {
   float *voxels;
 } DenseFloatVolumeGrid;
 
+/**
+ * Extract the active voxels of the grid into a dense buffer. Grids larger than \a max_resolution
+ * along any axis are resampled to a lower resolution first, unless it's zero.
+ */
 bool BKE_volume_grid_dense_floats(const struct Volume *volume,
                                   const struct VolumeGrid *volume_grid,
+                                  int max_resolution,
                                   DenseFloatVolumeGrid *r_dense_grid);
 void BKE_volume_dense_float_grid_clear(DenseFloatVolumeGrid *dense_grid);
 
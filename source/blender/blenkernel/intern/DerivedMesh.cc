@@ -1285,6 +1285,15 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       depsgraph, ob, (ModifierApplyFlag)(MOD_APPLY_USECACHE | apply_render)};
   const ModifierEvalContext mectx_orco = {depsgraph, ob, MOD_APPLY_ORCO};
 
+  /* Deform modifiers at the start of the stack supporting it only update the vertices changed by
+   * the edit, following modifiers never do since their input can change anywhere. */
+  const ModifierPartialUpdate partial_update = {em_input->partial_update_verts,
+                                                em_input->partial_update_verts_len,
+                                                em_input->partial_update_id};
+  ModifierEvalContext mectx_partial = mectx;
+  mectx_partial.partial_update = &partial_update;
+  bool use_partial_update = true;
+
   /* Get effective list of modifiers to execute. Some effects like shape keys
    * are added as virtual modifiers before the user created modifiers. */
   VirtualModifierData virtualModifierData;
@@ -1323,6 +1332,10 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       continue;
     }
 
+    if (!(mti->flags & eModifierTypeFlag_SupportsPartialUpdate)) {
+      use_partial_update = false;
+    }
+
     /* Add an orco mesh as layer if needed by this modifier. */
     if (mesh_final && mesh_orco && mti->requiredDataMask) {
       CustomData_MeshMasks mask = {0};
@@ -1358,12 +1371,14 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
       }
 
+      const ModifierEvalContext *mectx_deform = use_partial_update ? &mectx_partial : &mectx;
       if (mti->deformVertsEM) {
         BKE_modifier_deform_vertsEM(
-            md, &mectx, em_input, mesh_final, deformed_verts, num_deformed_verts);
+            md, mectx_deform, em_input, mesh_final, deformed_verts, num_deformed_verts);
       }
       else {
-        BKE_modifier_deform_verts(md, &mectx, mesh_final, deformed_verts, num_deformed_verts);
+        BKE_modifier_deform_verts(
+            md, mectx_deform, mesh_final, deformed_verts, num_deformed_verts);
       }
     }
     else {
@@ -1709,6 +1724,78 @@ static void object_get_datamask(const Depsgraph *depsgraph,
   }
 }
 
+/** The draw cache of a deformed evaluated mesh, kept while the object is evaluated again. */
+struct MeshEvalBatchCache {
+  void *batch_cache = nullptr;
+  uint32_t data_version = 0;
+  int totvert = 0;
+  int totedge = 0;
+  int totpoly = 0;
+  int totloop = 0;
+  CustomData_MeshMasks data_mask;
+};
+
+/**
+ * Take the draw cache of the evaluated mesh before it is freed, when the object is only deformed.
+ * If the new evaluated mesh is deformed from the same data, only the buffers that depend on the
+ * positions have to be updated, the index buffers and attributes can be reused.
+ */
+static MeshEvalBatchCache mesh_eval_batch_cache_take(Object *ob)
+{
+  MeshEvalBatchCache prev;
+  if (ob->mode != OB_MODE_OBJECT || ((Mesh *)ob->data)->edit_mesh != nullptr) {
+    return prev;
+  }
+  if (ob->runtime.data_eval == nullptr || !ob->runtime.is_data_eval_owned ||
+      GS(ob->runtime.data_eval->name) != ID_ME) {
+    return prev;
+  }
+  Mesh *mesh_eval = (Mesh *)ob->runtime.data_eval;
+  if (!mesh_eval->runtime.deformed_only || mesh_eval->runtime.batch_cache == nullptr) {
+    return prev;
+  }
+  prev.batch_cache = mesh_eval->runtime.batch_cache;
+  prev.data_version = mesh_eval->runtime.data_version;
+  prev.totvert = mesh_eval->totvert;
+  prev.totedge = mesh_eval->totedge;
+  prev.totpoly = mesh_eval->totpoly;
+  prev.totloop = mesh_eval->totloop;
+  prev.data_mask = ob->runtime.last_data_mask;
+  mesh_eval->runtime.batch_cache = nullptr;
+  return prev;
+}
+
+/** Give the draw cache taken before the evaluation to the new evaluated mesh, or free it. */
+static void mesh_eval_batch_cache_restore(Object *ob, MeshEvalBatchCache &prev)
+{
+  if (prev.batch_cache == nullptr) {
+    return;
+  }
+  Mesh *mesh_eval = (Mesh *)ob->runtime.data_eval;
+  const bool is_reusable = mesh_eval != nullptr && ob->runtime.is_data_eval_owned &&
+                           GS(mesh_eval->id.name) == ID_ME &&
+                           mesh_eval->runtime.batch_cache == nullptr &&
+                           mesh_eval->runtime.deformed_only && mesh_eval->edit_mesh == nullptr &&
+                           mesh_eval->runtime.data_version == prev.data_version &&
+                           mesh_eval->totvert == prev.totvert &&
+                           mesh_eval->totedge == prev.totedge &&
+                           mesh_eval->totpoly == prev.totpoly &&
+                           mesh_eval->totloop == prev.totloop &&
+                           CustomData_MeshMasks_are_matching(&ob->runtime.last_data_mask,
+                                                             &prev.data_mask);
+  if (is_reusable) {
+    mesh_eval->runtime.batch_cache = prev.batch_cache;
+    BKE_mesh_batch_cache_dirty_tag(mesh_eval, BKE_MESH_BATCH_DIRTY_DEFORM);
+  }
+  else {
+    /* The draw cache can only be freed through a mesh. */
+    Mesh *mesh_tmp = BKE_mesh_new_nomain(0, 0, 0, 0, 0);
+    mesh_tmp->runtime.batch_cache = prev.batch_cache;
+    BKE_id_free(nullptr, mesh_tmp);
+  }
+  prev.batch_cache = nullptr;
+}
+
 void makeDerivedMesh(struct Depsgraph *depsgraph,
                      const Scene *scene,
                      Object *ob,
@@ -1720,6 +1807,7 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  MeshEvalBatchCache prev_batch_cache = mesh_eval_batch_cache_take(ob);
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1741,6 +1829,8 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
   else {
     mesh_build_data(depsgraph, scene, ob, &cddata_masks, need_mapping);
   }
+
+  mesh_eval_batch_cache_restore(ob, prev_batch_cache);
 }
 
 /***/
@@ -20,6 +20,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -580,6 +581,89 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* Below this number of F-Curves, evaluating them in parallel isn't worth the overhead. */
+#define FCURVES_PARALLEL_THRESHOLD 256
+
+typedef struct FCurveEvalItem {
+  FCurve *fcu;
+  PathResolvedRNA anim_rna;
+  float curval;
+} FCurveEvalItem;
+
+typedef struct FCurvesEvalData {
+  FCurveEvalItem *items;
+  const AnimationEvalContext *anim_eval_context;
+} FCurvesEvalData;
+
+static void animsys_evaluate_fcurves_fn(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  FCurvesEvalData *data = userdata;
+  FCurveEvalItem *item = &data->items[i];
+  item->curval = calculate_fcurve(&item->anim_rna, item->fcu, data->anim_eval_context);
+}
+
+/**
+ * Evaluate the F-Curves of large lists in parallel. Paths are resolved and values written to
+ * RNA in the list order, only the evaluation of the curves themselves is threaded.
+ * Returns false when the list should be evaluated serially instead.
+ */
+static bool animsys_evaluate_fcurves_parallel(PointerRNA *ptr,
+                                              ListBase *list,
+                                              const AnimationEvalContext *anim_eval_context,
+                                              bool flush_to_original)
+{
+  if (BLI_listbase_count_at_most(list, FCURVES_PARALLEL_THRESHOLD) <
+      FCURVES_PARALLEL_THRESHOLD) {
+    return false;
+  }
+
+  int items_num = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
+    /* Drivers may read properties written by the other curves. */
+    if (fcu->driver) {
+      return false;
+    }
+    if (is_fcurve_evaluatable(fcu)) {
+      items_num++;
+    }
+  }
+
+  FCurveEvalItem *items = MEM_malloc_arrayN(items_num, sizeof(*items), __func__);
+  items_num = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
+    if (!is_fcurve_evaluatable(fcu)) {
+      continue;
+    }
+    FCurveEvalItem *item = &items[items_num];
+    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &item->anim_rna)) {
+      item->fcu = fcu;
+      items_num++;
+    }
+  }
+
+  FCurvesEvalData data = {
+      .items = items,
+      .anim_eval_context = anim_eval_context,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, items_num, &data, animsys_evaluate_fcurves_fn, &settings);
+
+  for (int i = 0; i < items_num; i++) {
+    FCurveEvalItem *item = &items[i];
+    BKE_animsys_write_to_rna_path(&item->anim_rna, item->curval);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, item->fcu->rna_path, item->fcu->array_index, item->curval);
+    }
+  }
+
+  MEM_freeN(items);
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -590,6 +674,10 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  if (animsys_evaluate_fcurves_parallel(ptr, list, anim_eval_context, flush_to_original)) {
+    return;
+  }
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
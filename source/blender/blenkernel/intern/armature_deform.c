@@ -241,6 +241,11 @@ typedef struct ArmatureUserdata {
 
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
+  /**
+   * Deform matrix of the bone of each vertex group from and to the target object space,
+   * only used for linear deformation by bones without B-Bone segments.
+   */
+  float (*deform_mats_from_defbase)[4][4];
 
   float premat[4][4];
   float postmat[4][4];
@@ -251,6 +256,67 @@ typedef struct ArmatureUserdata {
   } bmesh;
 } ArmatureUserdata;
 
+/**
+ * Deform by vertex groups with #ArmatureUserdata.deform_mats_from_defbase, accumulating the bone
+ * matrices so the coordinates are only transformed once.
+ *
+ * \return false when no vertex group has a bone, in which case envelopes may still be used.
+ */
+static bool armature_vert_task_with_dvert_linear(const ArmatureUserdata *data,
+                                                 const int i,
+                                                 const MDeformVert *dvert)
+{
+  float(*const vert_coords)[3] = data->vert_coords;
+  float armature_weight = 1.0f;
+  float mat_accum[4][4];
+  float contrib = 0.0f;
+  bool deformed = false;
+
+  if (data->armature_def_nr != -1) {
+    armature_weight = BKE_defvert_find_weight(dvert, data->armature_def_nr);
+
+    if (data->invert_vgroup) {
+      armature_weight = 1.0f - armature_weight;
+    }
+  }
+
+  if (armature_weight == 0.0f) {
+    return true;
+  }
+
+  zero_m4(mat_accum);
+
+  const MDeformWeight *dw = dvert->dw;
+  for (uint j = dvert->totweight; j != 0; j--, dw++) {
+    const uint index = dw->def_nr;
+    if (index < data->defbase_len && data->pchan_from_defbase[index]) {
+      deformed = true;
+      if (dw->weight != 0.0f) {
+        madd_m4_m4m4fl(mat_accum, mat_accum, data->deform_mats_from_defbase[index], dw->weight);
+        contrib += dw->weight;
+      }
+    }
+  }
+
+  if (!deformed) {
+    return false;
+  }
+
+  /* actually should be EPSILON? weight values and contrib can be like 10e-39 small */
+  if (contrib > 0.0001f) {
+    float co[3];
+    mul_m4_fl(mat_accum, 1.0f / contrib);
+    mul_v3_m4v3(co, mat_accum, vert_coords[i]);
+    if (armature_weight != 1.0f) {
+      interp_v3_v3v3(vert_coords[i], vert_coords[i], co, armature_weight);
+    }
+    else {
+      copy_v3_v3(vert_coords[i], co);
+    }
+  }
+  return true;
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -272,6 +338,12 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   float armature_weight = 1.0f; /* default to 1 if no overall def group */
   float prevco_weight = 1.0f;   /* weight for optional cached vertexcos */
 
+  if (data->deform_mats_from_defbase && dvert && dvert->totweight) {
+    if (armature_vert_task_with_dvert_linear(data, i, dvert)) {
+      return;
+    }
+  }
+
   if (use_quaternion) {
     memset(&sumdq, 0, sizeof(DualQuat));
     dq = &sumdq;
@@ -550,6 +622,43 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     }
   }
 
+  float obinv[4][4];
+  float postmat[4][4], premat[4][4];
+  invert_m4_m4(obinv, ob_target->obmat);
+
+  mul_m4_m4m4(postmat, obinv, ob_arm->obmat);
+  invert_m4_m4(premat, postmat);
+
+  /* Bone matrices can be combined with the object matrices once when they are the same for all
+   * the vertices (linear deformation without B-Bones or envelope weights). */
+  float(*deform_mats_from_defbase)[4][4] = NULL;
+  if (use_dverts && !use_quaternion && vert_deform_mats == NULL && vert_coords_prev == NULL) {
+    bool use_linear = true;
+    for (int i = 0; i < defbase_len; i++) {
+      const bPoseChannel *pchan = pchan_from_defbase[i];
+      if (pchan == NULL) {
+        continue;
+      }
+      const Bone *bone = pchan->bone;
+      if ((bone->flag & BONE_MULT_VG_ENV) ||
+          (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments)) {
+        use_linear = false;
+        break;
+      }
+    }
+
+    if (use_linear) {
+      deform_mats_from_defbase = MEM_malloc_arrayN(
+          defbase_len, sizeof(*deform_mats_from_defbase), __func__);
+      for (int i = 0; i < defbase_len; i++) {
+        const bPoseChannel *pchan = pchan_from_defbase[i];
+        if (pchan != NULL) {
+          mul_m4_series(deform_mats_from_defbase[i], postmat, pchan->chan_mat, premat);
+        }
+      }
+    }
+  }
+
   ArmatureUserdata data = {
       .ob_arm = ob_arm,
       .me_target = me_target,
@@ -565,17 +674,15 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .dverts_len = dverts_len,
       .pchan_from_defbase = pchan_from_defbase,
       .defbase_len = defbase_len,
+      .deform_mats_from_defbase = deform_mats_from_defbase,
       .bmesh =
           {
               .cd_dvert_offset = cd_dvert_offset,
           },
   };
 
-  float obinv[4][4];
-  invert_m4_m4(obinv, ob_target->obmat);
-
-  mul_m4_m4m4(data.postmat, obinv, ob_arm->obmat);
-  invert_m4_m4(data.premat, data.postmat);
+  copy_m4_m4(data.postmat, postmat);
+  copy_m4_m4(data.premat, premat);
 
   if (em_target != NULL) {
     /* While this could cause an extra loop over mesh data, in most cases this will
@@ -604,6 +711,9 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   if (pchan_from_defbase) {
     MEM_freeN(pchan_from_defbase);
   }
+  if (deform_mats_from_defbase) {
+    MEM_freeN(deform_mats_from_defbase);
+  }
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
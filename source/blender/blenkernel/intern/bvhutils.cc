@@ -37,6 +37,8 @@ using blender::VArray;
 
 struct BVHCacheItem {
   bool is_filled;
+  /** The positions changed since the tree has been built, but the topology is still the same. */
+  bool positions_dirty;
   BVHTree *tree;
 };
 
@@ -77,7 +79,7 @@ static bool bvhcache_find(BVHCache **bvh_cache_p,
   }
   BVHCache *bvh_cache = *bvh_cache_p;
 
-  if (bvh_cache->items[type].is_filled) {
+  if (bvh_cache->items[type].is_filled && !bvh_cache->items[type].positions_dirty) {
     *r_tree = bvh_cache->items[type].tree;
     return true;
   }
@@ -136,6 +138,24 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
   item->is_filled = true;
 }
 
+void bvhcache_tag_positions_changed(BVHCache *bvh_cache)
+{
+  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    BVHCacheItem *item = &bvh_cache->items[index];
+    if (!item->is_filled) {
+      continue;
+    }
+    if (ELEM(index, BVHTREE_FROM_EM_VERTS, BVHTREE_FROM_EM_EDGES, BVHTREE_FROM_EM_LOOPTRI)) {
+      /* Edit-mesh trees are not refit, they are rebuilt when they are requested again. */
+      BLI_bvhtree_free(item->tree);
+      item->tree = nullptr;
+      item->is_filled = false;
+      continue;
+    }
+    item->positions_dirty = true;
+  }
+}
+
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
@@ -1217,6 +1237,147 @@ static BLI_bitmap *looptri_no_hidden_map_get(const MPoly *mpoly,
   return looptri_mask;
 }
 
+/**
+ * Update the bounds of a tree that has been built from the elements that are not masked out, in
+ * the same order. #get_coords fills in the coordinates of an element and returns their number.
+ */
+template<typename GetCoordsFn>
+static void bvhtree_refit_leafs(BVHTree *tree,
+                                const int elems_num,
+                                const BLI_bitmap *mask,
+                                const GetCoordsFn &get_coords)
+{
+  int leaf_index = 0;
+  for (int i = 0; i < elems_num; i++) {
+    if (mask && !BLI_BITMAP_TEST_BOOL(mask, i)) {
+      continue;
+    }
+    float co[4][3];
+    const int points_num = get_coords(i, co);
+    BLI_bvhtree_update_node(tree, leaf_index, co[0], nullptr, points_num);
+    leaf_index++;
+  }
+  BLI_assert(leaf_index == BLI_bvhtree_get_len(tree));
+  BLI_bvhtree_update_tree(tree);
+}
+
+/**
+ * Update the bounds of a cached tree after the positions of the mesh changed. This is much
+ * cheaper than building a new tree, but the quality of the tree gets worse when the mesh is
+ * deformed a lot.
+ *
+ * eturn False when the number of elements in the tree changed, so that it has to be rebuilt.
+ */
+static bool bvhtree_from_mesh_refit(BVHTree *tree,
+                                    const Mesh *mesh,
+                                    const BVHCacheType bvh_cache_type,
+                                    const MLoopTri *looptri,
+                                    const int looptri_len)
+{
+  const Span<MVert> verts = mesh->verts();
+  const Span<MEdge> edges = mesh->edges();
+  const Span<MLoop> loops = mesh->loops();
+  const MFace *faces = (const MFace *)CustomData_get_layer(&mesh->fdata, CD_MFACE);
+
+  BLI_bitmap *mask = nullptr;
+  int mask_bits_act_len = -1;
+  int elems_num = 0;
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_LOOSEVERTS:
+      mask = loose_verts_map_get(
+          edges.data(), mesh->totedge, verts.data(), mesh->totvert, &mask_bits_act_len);
+      ATTR_FALLTHROUGH;
+    case BVHTREE_FROM_VERTS:
+      elems_num = mesh->totvert;
+      break;
+    case BVHTREE_FROM_LOOSEEDGES:
+      mask = loose_edges_map_get(edges.data(), mesh->totedge, &mask_bits_act_len);
+      ATTR_FALLTHROUGH;
+    case BVHTREE_FROM_EDGES:
+      elems_num = mesh->totedge;
+      break;
+    case BVHTREE_FROM_FACES:
+      elems_num = faces ? mesh->totface : 0;
+      break;
+    case BVHTREE_FROM_LOOPTRI_NO_HIDDEN: {
+      blender::bke::AttributeAccessor attributes = mesh->attributes();
+      mask = looptri_no_hidden_map_get(
+          mesh->polys().data(),
+          attributes.lookup_or_default(".hide_poly", ATTR_DOMAIN_FACE, false),
+          looptri_len,
+          &mask_bits_act_len);
+      ATTR_FALLTHROUGH;
+    }
+    case BVHTREE_FROM_LOOPTRI:
+      elems_num = looptri_len;
+      break;
+    case BVHTREE_FROM_EM_VERTS:
+    case BVHTREE_FROM_EM_EDGES:
+    case BVHTREE_FROM_EM_LOOPTRI:
+    case BVHTREE_MAX_ITEM:
+      BLI_assert(false);
+      break;
+  }
+
+  const int active_num = mask ? mask_bits_act_len : elems_num;
+  const int tree_len = tree ? BLI_bvhtree_get_len(tree) : 0;
+  if (active_num != tree_len) {
+    MEM_SAFE_FREE(mask);
+    return false;
+  }
+  if (tree == nullptr) {
+    return true;
+  }
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+    case BVHTREE_FROM_LOOSEVERTS:
+      bvhtree_refit_leafs(tree, elems_num, mask, [&](const int i, float co[4][3]) {
+        copy_v3_v3(co[0], verts[i].co);
+        return 1;
+      });
+      break;
+    case BVHTREE_FROM_EDGES:
+    case BVHTREE_FROM_LOOSEEDGES:
+      bvhtree_refit_leafs(tree, elems_num, mask, [&](const int i, float co[4][3]) {
+        copy_v3_v3(co[0], verts[edges[i].v1].co);
+        copy_v3_v3(co[1], verts[edges[i].v2].co);
+        return 2;
+      });
+      break;
+    case BVHTREE_FROM_FACES:
+      bvhtree_refit_leafs(tree, elems_num, mask, [&](const int i, float co[4][3]) {
+        copy_v3_v3(co[0], verts[faces[i].v1].co);
+        copy_v3_v3(co[1], verts[faces[i].v2].co);
+        copy_v3_v3(co[2], verts[faces[i].v3].co);
+        if (faces[i].v4) {
+          copy_v3_v3(co[3], verts[faces[i].v4].co);
+          return 4;
+        }
+        return 3;
+      });
+      break;
+    case BVHTREE_FROM_LOOPTRI:
+    case BVHTREE_FROM_LOOPTRI_NO_HIDDEN:
+      bvhtree_refit_leafs(tree, elems_num, mask, [&](const int i, float co[4][3]) {
+        copy_v3_v3(co[0], verts[loops[looptri[i].tri[0]].v].co);
+        copy_v3_v3(co[1], verts[loops[looptri[i].tri[1]].v].co);
+        copy_v3_v3(co[2], verts[loops[looptri[i].tri[2]].v].co);
+        return 3;
+      });
+      break;
+    case BVHTREE_FROM_EM_VERTS:
+    case BVHTREE_FROM_EM_EDGES:
+    case BVHTREE_FROM_EM_LOOPTRI:
+    case BVHTREE_MAX_ITEM:
+      break;
+  }
+
+  MEM_SAFE_FREE(mask);
+  return true;
+}
+
 BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                    const struct Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
@@ -1257,6 +1418,23 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
     return data->tree;
   }
 
+  BVHCacheItem *cache_item = &(*bvh_cache_p)->items[bvh_cache_type];
+  if (cache_item->is_filled) {
+    /* Only the positions changed since the tree has been built, so it can be refit. */
+    BLI_assert(cache_item->positions_dirty);
+    if (bvhtree_from_mesh_refit(cache_item->tree, mesh, bvh_cache_type, looptri, looptri_len)) {
+      cache_item->positions_dirty = false;
+      data->tree = cache_item->tree;
+      data->cached = true;
+      bvhcache_unlock(*bvh_cache_p, lock_started);
+      return data->tree;
+    }
+    BLI_bvhtree_free(cache_item->tree);
+    cache_item->tree = nullptr;
+    cache_item->is_filled = false;
+    cache_item->positions_dirty = false;
+  }
+
   /* Create BVHTree. */
 
   BLI_bitmap *mask = nullptr;
@@ -417,12 +417,14 @@ double BKE_cachefile_time_offset(const CacheFile *cache_file, const double time,
   return cache_file->is_sequence ? frame : frame / fps - time_offset;
 }
 
-bool BKE_cache_file_uses_render_procedural(const CacheFile *cache_file, Scene *scene)
+bool BKE_cache_file_uses_render_procedural(const CacheFile *cache_file,
+                                           Scene *scene,
+                                           const bool is_final_render)
 {
   RenderEngineType *render_engine_type = RE_engines_find(scene->r.engine);
 
   if (cache_file->type != CACHEFILE_TYPE_ALEMBIC ||
-      !RE_engine_supports_alembic_procedural(render_engine_type, scene)) {
+      !RE_engine_supports_alembic_procedural(render_engine_type, scene, is_final_render)) {
     return false;
   }
 
@@ -5363,7 +5363,8 @@ static void transformcache_evaluate(bConstraint *con, bConstraintOb *cob, ListBa
   }
 
   /* Do not process data if using a render time procedural. */
-  if (BKE_cache_file_uses_render_procedural(cache_file, scene)) {
+  if (BKE_cache_file_uses_render_procedural(
+          cache_file, scene, DEG_get_mode(cob->depsgraph) == DAG_EVAL_RENDER)) {
     return;
   }
 
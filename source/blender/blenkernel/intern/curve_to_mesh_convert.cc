@@ -18,6 +18,15 @@
 
 namespace blender::bke {
 
+/**
+ * Grain size for loops over the rings of a single curve combination, so that long main curves
+ * are split between threads, on top of the parallelism over combinations.
+ */
+static int ring_grain_size(const int profile_point_num)
+{
+  return std::max(4096 / std::max(profile_point_num, 1), 1);
+}
+
 static void mark_edges_sharp(MutableSpan<MEdge> edges)
 {
   for (MEdge &edge : edges) {
@@ -92,44 +101,48 @@ static void fill_mesh_topology(const int vert_offset,
   }
 
   /* Calculate poly and corner indices. */
-  for (const int i_ring : IndexRange(main_segment_num)) {
-    const int i_next_ring = (i_ring == main_point_num - 1) ? 0 : i_ring + 1;
-
-    const int ring_vert_offset = vert_offset + profile_point_num * i_ring;
-    const int next_ring_vert_offset = vert_offset + profile_point_num * i_next_ring;
-
-    const int ring_edge_start = profile_edges_start + profile_segment_num * i_ring;
-    const int next_ring_edge_offset = profile_edges_start + profile_segment_num * i_next_ring;
-
-    const int ring_poly_offset = poly_offset + i_ring * profile_segment_num;
-    const int ring_loop_offset = loop_offset + i_ring * profile_segment_num * 4;
-
-    for (const int i_profile : IndexRange(profile_segment_num)) {
-      const int ring_segment_loop_offset = ring_loop_offset + i_profile * 4;
-      const int i_next_profile = (i_profile == profile_point_num - 1) ? 0 : i_profile + 1;
-
-      const int main_edge_start = main_edges_start + main_segment_num * i_profile;
-      const int next_main_edge_start = main_edges_start + main_segment_num * i_next_profile;
-
-      MPoly &poly = polys[ring_poly_offset + i_profile];
-      poly.loopstart = ring_segment_loop_offset;
-      poly.totloop = 4;
-      poly.flag = ME_SMOOTH;
-
-      MLoop &loop_a = loops[ring_segment_loop_offset];
-      loop_a.v = ring_vert_offset + i_profile;
-      loop_a.e = ring_edge_start + i_profile;
-      MLoop &loop_b = loops[ring_segment_loop_offset + 1];
-      loop_b.v = ring_vert_offset + i_next_profile;
-      loop_b.e = next_main_edge_start + i_ring;
-      MLoop &loop_c = loops[ring_segment_loop_offset + 2];
-      loop_c.v = next_ring_vert_offset + i_next_profile;
-      loop_c.e = next_ring_edge_offset + i_profile;
-      MLoop &loop_d = loops[ring_segment_loop_offset + 3];
-      loop_d.v = next_ring_vert_offset + i_profile;
-      loop_d.e = main_edge_start + i_ring;
-    }
-  }
+  threading::parallel_for(
+      IndexRange(main_segment_num), ring_grain_size(profile_point_num), [&](IndexRange range) {
+        for (const int i_ring : range) {
+          const int i_next_ring = (i_ring == main_point_num - 1) ? 0 : i_ring + 1;
+
+          const int ring_vert_offset = vert_offset + profile_point_num * i_ring;
+          const int next_ring_vert_offset = vert_offset + profile_point_num * i_next_ring;
+
+          const int ring_edge_start = profile_edges_start + profile_segment_num * i_ring;
+          const int next_ring_edge_offset = profile_edges_start +
+                                            profile_segment_num * i_next_ring;
+
+          const int ring_poly_offset = poly_offset + i_ring * profile_segment_num;
+          const int ring_loop_offset = loop_offset + i_ring * profile_segment_num * 4;
+
+          for (const int i_profile : IndexRange(profile_segment_num)) {
+            const int ring_segment_loop_offset = ring_loop_offset + i_profile * 4;
+            const int i_next_profile = (i_profile == profile_point_num - 1) ? 0 : i_profile + 1;
+
+            const int main_edge_start = main_edges_start + main_segment_num * i_profile;
+            const int next_main_edge_start = main_edges_start + main_segment_num * i_next_profile;
+
+            MPoly &poly = polys[ring_poly_offset + i_profile];
+            poly.loopstart = ring_segment_loop_offset;
+            poly.totloop = 4;
+            poly.flag = ME_SMOOTH;
+
+            MLoop &loop_a = loops[ring_segment_loop_offset];
+            loop_a.v = ring_vert_offset + i_profile;
+            loop_a.e = ring_edge_start + i_profile;
+            MLoop &loop_b = loops[ring_segment_loop_offset + 1];
+            loop_b.v = ring_vert_offset + i_next_profile;
+            loop_b.e = next_main_edge_start + i_ring;
+            MLoop &loop_c = loops[ring_segment_loop_offset + 2];
+            loop_c.v = next_ring_vert_offset + i_next_profile;
+            loop_c.e = next_ring_edge_offset + i_profile;
+            MLoop &loop_d = loops[ring_segment_loop_offset + 3];
+            loop_d.v = next_ring_vert_offset + i_profile;
+            loop_d.e = main_edge_start + i_ring;
+          }
+        }
+      });
 
   const bool has_caps = fill_caps && !main_cyclic && profile_cyclic;
   if (has_caps) {
@@ -194,31 +207,36 @@ static void fill_mesh_positions(const int main_point_num,
                                 MutableSpan<MVert> mesh_positions)
 {
   if (profile_point_num == 1) {
-    for (const int i_ring : IndexRange(main_point_num)) {
-      float4x4 point_matrix = float4x4::from_normalized_axis_data(
-          main_positions[i_ring], normals[i_ring], tangents[i_ring]);
-      if (!radii.is_empty()) {
-        point_matrix.apply_scale(radii[i_ring]);
+    threading::parallel_for(IndexRange(main_point_num), 4096, [&](IndexRange range) {
+      for (const int i_ring : range) {
+        float4x4 point_matrix = float4x4::from_normalized_axis_data(
+            main_positions[i_ring], normals[i_ring], tangents[i_ring]);
+        if (!radii.is_empty()) {
+          point_matrix.apply_scale(radii[i_ring]);
+        }
+
+        MVert &vert = mesh_positions[i_ring];
+        copy_v3_v3(vert.co, point_matrix * profile_positions.first());
       }
-
-      MVert &vert = mesh_positions[i_ring];
-      copy_v3_v3(vert.co, point_matrix * profile_positions.first());
-    }
+    });
   }
   else {
-    for (const int i_ring : IndexRange(main_point_num)) {
-      float4x4 point_matrix = float4x4::from_normalized_axis_data(
-          main_positions[i_ring], normals[i_ring], tangents[i_ring]);
-      if (!radii.is_empty()) {
-        point_matrix.apply_scale(radii[i_ring]);
-      }
-
-      const int ring_vert_start = i_ring * profile_point_num;
-      for (const int i_profile : IndexRange(profile_point_num)) {
-        MVert &vert = mesh_positions[ring_vert_start + i_profile];
-        copy_v3_v3(vert.co, point_matrix * profile_positions[i_profile]);
-      }
-    }
+    threading::parallel_for(
+        IndexRange(main_point_num), ring_grain_size(profile_point_num), [&](IndexRange range) {
+          for (const int i_ring : range) {
+            float4x4 point_matrix = float4x4::from_normalized_axis_data(
+                main_positions[i_ring], normals[i_ring], tangents[i_ring]);
+            if (!radii.is_empty()) {
+              point_matrix.apply_scale(radii[i_ring]);
+            }
+
+            const int ring_vert_start = i_ring * profile_point_num;
+            for (const int i_profile : IndexRange(profile_point_num)) {
+              MVert &vert = mesh_positions[ring_vert_start + i_profile];
+              copy_v3_v3(vert.co, point_matrix * profile_positions[i_profile]);
+            }
+          }
+        });
   }
 }
 
@@ -12,7 +12,9 @@
 #include "BLI_bounds.hh"
 #include "BLI_index_mask_ops.hh"
 #include "BLI_length_parameterize.hh"
+#include "BLI_map.hh"
 #include "BLI_math_rotation.hh"
+#include "BLI_math_vector_span.hh"
 #include "BLI_task.hh"
 
 #include "DNA_curves_types.h"
@@ -566,6 +568,26 @@ Array<int> CurvesGeometry::point_to_curve_map() const
   return map;
 }
 
+/** The settings that a NURBS basis cache depends on, apart from the control points. */
+struct NURBSBasisKey {
+  int points_num;
+  int evaluated_points_num;
+  int8_t order;
+  bool is_cyclic;
+  KnotsMode mode;
+
+  uint64_t hash() const
+  {
+    return get_default_hash_4(points_num, evaluated_points_num, order, is_cyclic << 8 | mode);
+  }
+
+  friend bool operator==(const NURBSBasisKey &a, const NURBSBasisKey &b)
+  {
+    return a.points_num == b.points_num && a.evaluated_points_num == b.evaluated_points_num &&
+           a.order == b.order && a.is_cyclic == b.is_cyclic && a.mode == b.mode;
+  }
+};
+
 void CurvesGeometry::ensure_nurbs_basis_cache() const
 {
   if (!this->runtime->nurbs_basis_cache_dirty) {
@@ -592,8 +614,26 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
     VArray<int8_t> orders = this->nurbs_orders();
     VArray<int8_t> knots_modes = this->nurbs_knots_modes();
 
+    /* Curves with the same number of points, resolution and knots settings have the same basis,
+     * it is only calculated for the first one of them and copied to the others. */
+    Array<int> basis_sources(nurbs_mask.size());
+    Map<NURBSBasisKey, int> first_curve_by_key;
+    for (const int i : nurbs_mask.index_range()) {
+      const int curve_index = nurbs_mask[i];
+      const NURBSBasisKey key{this->points_num_for_curve(curve_index),
+                              int(this->evaluated_points_for_curve(curve_index).size()),
+                              orders[curve_index],
+                              cyclic[curve_index],
+                              KnotsMode(knots_modes[curve_index])};
+      basis_sources[i] = first_curve_by_key.lookup_or_add(key, curve_index);
+    }
+
     threading::parallel_for(nurbs_mask.index_range(), 64, [&](const IndexRange range) {
-      for (const int curve_index : nurbs_mask.slice(range)) {
+      for (const int i : range) {
+        const int curve_index = nurbs_mask[i];
+        if (basis_sources[i] != curve_index) {
+          continue;
+        }
         const IndexRange points = this->points_for_curve(curve_index);
         const IndexRange evaluated_points = this->evaluated_points_for_curve(curve_index);
 
@@ -617,6 +657,17 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
                                              basis_caches[curve_index]);
       }
     });
+
+    if (first_curve_by_key.size() < nurbs_mask.size()) {
+      threading::parallel_for(nurbs_mask.index_range(), 64, [&](const IndexRange range) {
+        for (const int i : range) {
+          const int curve_index = nurbs_mask[i];
+          if (basis_sources[i] != curve_index) {
+            basis_caches[curve_index] = basis_caches[basis_sources[i]];
+          }
+        }
+      });
+    }
   });
 
   this->runtime->nurbs_basis_cache_dirty = false;
@@ -1016,9 +1067,7 @@ static void translate_positions(MutableSpan<float3> positions, const float3 &tra
 static void transform_positions(MutableSpan<float3> positions, const float4x4 &matrix)
 {
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-    for (float3 &position : positions.slice(range)) {
-      position = matrix * position;
-    }
+    math::transform_points(matrix, positions.slice(range));
   });
 }
 
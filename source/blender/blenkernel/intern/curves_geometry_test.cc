@@ -405,6 +405,48 @@ TEST(curves_geometry, NURBSEvaluation)
   }
 }
 
+TEST(curves_geometry, NURBSEvaluationSharedBasis)
+{
+  /* The first two curves have the same basis, the last one has more points. */
+  CurvesGeometry curves(13, 3);
+  curves.fill_curve_types(CURVE_TYPE_NURBS);
+  curves.resolution_for_write().fill(10);
+  MutableSpan<int> offsets = curves.offsets_for_write();
+  offsets[0] = 0;
+  offsets[1] = 4;
+  offsets[2] = 8;
+  offsets[3] = 13;
+
+  MutableSpan<float3> positions = curves.positions_for_write();
+  const float3 offset{0, 0, 2};
+  for (const int i : IndexRange(5)) {
+    positions[8 + i] = {float(i), float(i % 2), 0};
+  }
+  positions[0] = {1, 1, 0};
+  positions[1] = {0, 1, 0};
+  positions[2] = {0, 0, 0};
+  positions[3] = {-1, 0, 0};
+  for (const int i : IndexRange(4)) {
+    positions[4 + i] = positions[i] + offset;
+  }
+  curves.nurbs_weights_for_write().fill(1.0f);
+
+  Span<float3> evaluated_positions = curves.evaluated_positions();
+  const IndexRange evaluated_points_0 = curves.evaluated_points_for_curve(0);
+  const IndexRange evaluated_points_1 = curves.evaluated_points_for_curve(1);
+  const IndexRange evaluated_points_2 = curves.evaluated_points_for_curve(2);
+  EXPECT_EQ(evaluated_points_0.size(), evaluated_points_1.size());
+  EXPECT_GT(evaluated_points_2.size(), evaluated_points_0.size());
+  for (const int i : IndexRange(evaluated_points_0.size())) {
+    const float3 expected = evaluated_positions[evaluated_points_0[i]] + offset;
+    EXPECT_V3_NEAR(evaluated_positions[evaluated_points_1[i]], expected, 1e-5f);
+  }
+  const float3 first_expected{0.166667, 0.833333, 0};
+  const float3 last_expected{-0.166667, 0.166667, 0};
+  EXPECT_V3_NEAR(evaluated_positions[evaluated_points_0.first()], first_expected, 1e-5f);
+  EXPECT_V3_NEAR(evaluated_positions[evaluated_points_0.last()], last_expected, 1e-5f);
+}
+
 TEST(curves_geometry, BezierGenericEvaluation)
 {
   CurvesGeometry curves(3, 1);
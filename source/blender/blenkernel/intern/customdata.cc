@@ -10,6 +10,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <atomic>
+
 /* Since we have versioning code here (CustomData_verify_versions()). */
 #define DNA_DEPRECATED_ALLOW
 
@@ -53,6 +55,8 @@
 
 #include "bmesh.h"
 
+#include "atomic_ops.h"
+
 #include "CLG_log.h"
 
 /* only for customdata_data_transfer_interp_normal_normals */
@@ -2241,6 +2245,53 @@ void customData_mask_layers__print(const CustomData_MeshMasks *mask)
 
 static void customData_update_offsets(CustomData *data);
 
+/**
+ * Owner of layer data which is shared between layers of different #CustomData, see #CD_SHARE.
+ *
+ * Only used for layer types which don't own any additional allocations, so freeing the data does
+ * not require any type information. Every layer which has the sharing info set is a user, and the
+ * data is freed together with the last user.
+ */
+struct CustomDataSharingInfo {
+  std::atomic<int> users;
+  void *data;
+};
+
+static bool customData_layer_type_is_shareable(const LayerTypeInfo *typeInfo)
+{
+  return typeInfo->free == nullptr;
+}
+
+/* The source layer might be shared by multiple threads at once (for example when the same ID is
+ * copied by multiple dependency graphs), so the sharing info is created atomically. */
+static CustomDataSharingInfo *customData_layer_ensure_sharing(CustomDataLayer *layer)
+{
+  if (layer->sharing_info == nullptr) {
+    CustomDataSharingInfo *sharing_info = MEM_new<CustomDataSharingInfo>(__func__);
+    sharing_info->users = 1;
+    sharing_info->data = layer->data;
+    if (atomic_cas_ptr((void **)&layer->sharing_info, nullptr, sharing_info) != nullptr) {
+      MEM_delete(sharing_info);
+    }
+  }
+  return layer->sharing_info;
+}
+
+/**
+ * Remove the layer from the users of its shared data.
+ * \return True when the layer was the last user, and the caller is responsible for the data.
+ */
+static bool customData_layer_release_sharing(CustomDataLayer *layer)
+{
+  CustomDataSharingInfo *sharing_info = layer->sharing_info;
+  layer->sharing_info = nullptr;
+  if (sharing_info->users.fetch_sub(1) == 1) {
+    MEM_delete(sharing_info);
+    return true;
+  }
+  return false;
+}
+
 static CustomDataLayer *customData_add_layer__internal(CustomData *data,
                                                        int type,
                                                        eCDAllocType alloctype,
@@ -2325,6 +2376,8 @@ bool CustomData_merge(const CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
+      case CD_SHARE_IMMUTABLE:
         data = layer->data;
         break;
       default:
@@ -2332,7 +2385,29 @@ bool CustomData_merge(const CustomData *source,
         break;
     }
 
-    if ((alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
+    CustomDataSharingInfo *sharing_info = nullptr;
+    if (ELEM(alloctype, CD_SHARE, CD_SHARE_IMMUTABLE)) {
+      /* Data which is only referenced by the source has no owner which could be shared. */
+      if (data != nullptr && totelem > 0 &&
+          customData_layer_type_is_shareable(layerType_getInfo(type)) &&
+          (layer->sharing_info != nullptr || !(flag & CD_FLAG_NOFREE))) {
+        CustomDataLayer *source_layer = const_cast<CustomDataLayer *>(layer);
+        sharing_info = customData_layer_ensure_sharing(source_layer);
+        sharing_info->users.fetch_add(1);
+        if (alloctype == CD_SHARE_IMMUTABLE && !(flag & CD_FLAG_NOFREE)) {
+          /* The source has to copy the data before writing to it as well. Other threads can
+           * share the same source at the same time. */
+          atomic_fetch_and_or_int32(&source_layer->flag, CD_FLAG_NOFREE);
+        }
+      }
+      newlayer = customData_add_layer__internal(dest,
+                                                type,
+                                                sharing_info ? CD_REFERENCE : CD_DUPLICATE,
+                                                data,
+                                                totelem,
+                                                layer->name);
+    }
+    else if ((alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
@@ -2361,8 +2436,18 @@ bool CustomData_merge(const CustomData *source,
         }
       }
       if (alloctype == CD_ASSIGN) {
+        /* The new layer becomes the user of the shared data instead. */
+        newlayer->sharing_info = layer->sharing_info;
+        layer->sharing_info = nullptr;
         layer->data = nullptr;
       }
+      else {
+        newlayer->sharing_info = sharing_info;
+      }
+    }
+    else if (sharing_info != nullptr) {
+      /* The source layer is still a user, so the data is never freed here. */
+      sharing_info->users.fetch_sub(1);
     }
   }
 
@@ -2423,7 +2508,22 @@ void CustomData_realloc(CustomData *data, const int old_size, const int new_size
 
     const int64_t old_size_in_bytes = int64_t(old_size) * typeInfo->size;
     const int64_t new_size_in_bytes = int64_t(new_size) * typeInfo->size;
-    if (layer->flag & CD_FLAG_NOFREE) {
+    if (layer->sharing_info != nullptr) {
+      /* Shared data might still be used by other layers, so it can not be reallocated. */
+      void *old_data = layer->data;
+      layer->data = MEM_malloc_arrayN(new_size, typeInfo->size, __func__);
+      if (typeInfo->copy) {
+        typeInfo->copy(old_data, layer->data, std::min(old_size, new_size));
+      }
+      else {
+        std::memcpy(layer->data, old_data, std::min(old_size_in_bytes, new_size_in_bytes));
+      }
+      if (customData_layer_release_sharing(layer)) {
+        MEM_freeN(old_data);
+      }
+      layer->flag &= ~CD_FLAG_NOFREE;
+    }
+    else if (layer->flag & CD_FLAG_NOFREE) {
       const void *old_data = layer->data;
       layer->data = MEM_malloc_arrayN(new_size, typeInfo->size, __func__);
       if (typeInfo->copy) {
@@ -2482,7 +2582,12 @@ static void customData_free_layer__internal(CustomDataLayer *layer, const int to
     BKE_anonymous_attribute_id_decrement_weak(layer->anonymous_id);
     layer->anonymous_id = nullptr;
   }
-  if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
+  if (layer->sharing_info != nullptr) {
+    if (customData_layer_release_sharing(layer)) {
+      MEM_freeN(layer->data);
+    }
+  }
+  else if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
     typeInfo = layerType_getInfo(layer->type);
 
     if (typeInfo->free) {
@@ -2857,6 +2962,11 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
         flag |= CD_FLAG_NOFREE;
       }
       break;
+    case CD_SHARE:
+    case CD_SHARE_IMMUTABLE:
+      /* Only supported when copying layers, see #CustomData_merge. */
+      BLI_assert_unreachable();
+      ATTR_FALLTHROUGH;
     case CD_DUPLICATE:
       if (totelem > 0) {
         newlayerdata = MEM_malloc_arrayN(totelem, typeInfo->size, layerType_getName(type));
@@ -3110,12 +3220,19 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
+  if (layer->sharing_info != nullptr && layer->sharing_info->users == 1) {
+    /* All other users are gone, so the layer can take over the data without copying it. */
+    customData_layer_release_sharing(layer);
+    layer->flag &= ~CD_FLAG_NOFREE;
+  }
+
   if (layer->flag & CD_FLAG_NOFREE) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
      * CD_MDEFORMVERT, which has pointers to allocated data...
      * So in case a custom copy function is defined, use it!
      */
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    void *old_data = layer->data;
 
     if (typeInfo->copy) {
       void *dst_data = MEM_malloc_arrayN(
@@ -3127,6 +3244,11 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
       layer->data = MEM_dupallocN(layer->data);
     }
 
+    /* Remaining users keep the shared data, the copy is owned by this layer. */
+    if (layer->sharing_info != nullptr && customData_layer_release_sharing(layer)) {
+      MEM_freeN(old_data);
+    }
+
     layer->flag &= ~CD_FLAG_NOFREE;
   }
 
@@ -4355,6 +4477,7 @@ void CustomData_blend_write_prepare(CustomData &data,
       continue;
     }
     layers_to_write.append(layer);
+    layers_to_write.last().sharing_info = nullptr;
   }
   data.totlayer = layers_to_write.size();
   data.maxlayer = data.totlayer;
@@ -5314,6 +5437,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing_info = nullptr;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
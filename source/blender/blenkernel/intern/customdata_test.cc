@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_customdata.h"
+
+#include "DNA_customdata_types.h"
+
+namespace blender::bke::tests {
+
+static CustomData create_float_custom_data(const int totelem)
+{
+  CustomData data;
+  CustomData_reset(&data);
+  float *values = static_cast<float *>(
+      CustomData_add_layer_named(&data, CD_PROP_FLOAT, CD_SET_DEFAULT, nullptr, totelem, "a"));
+  for (const int i : IndexRange(totelem)) {
+    values[i] = float(i);
+  }
+  return data;
+}
+
+TEST(customdata, share_outlives_source)
+{
+  const int totelem = 16;
+  CustomData src = create_float_custom_data(totelem);
+  const float *src_values = static_cast<const float *>(CustomData_get_layer(&src, CD_PROP_FLOAT));
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, totelem);
+  const float *dst_values = static_cast<const float *>(CustomData_get_layer(&dst, CD_PROP_FLOAT));
+  EXPECT_EQ(dst_values, src_values);
+
+  /* The shared data stays valid for the copy. */
+  CustomData_free(&src, totelem);
+  for (const int i : IndexRange(totelem)) {
+    EXPECT_EQ(dst_values[i], float(i));
+  }
+
+  CustomData_free(&dst, totelem);
+}
+
+TEST(customdata, share_duplicate_for_write)
+{
+  const int totelem = 16;
+  CustomData src = create_float_custom_data(totelem);
+  const float *src_values = static_cast<const float *>(CustomData_get_layer(&src, CD_PROP_FLOAT));
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, totelem);
+  float *dst_values = static_cast<float *>(
+      CustomData_duplicate_referenced_layer(&dst, CD_PROP_FLOAT, totelem));
+  EXPECT_NE(dst_values, src_values);
+  dst_values[0] = -1.0f;
+  EXPECT_EQ(src_values[0], 0.0f);
+
+  CustomData_free(&dst, totelem);
+  CustomData_free(&src, totelem);
+}
+
+TEST(customdata, share_realloc)
+{
+  const int totelem = 16;
+  CustomData src = create_float_custom_data(totelem);
+  const float *src_values = static_cast<const float *>(CustomData_get_layer(&src, CD_PROP_FLOAT));
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, totelem);
+
+  /* Growing the source must not affect the data used by the copy. */
+  CustomData_realloc(&src, totelem, totelem * 2);
+  EXPECT_NE(CustomData_get_layer(&src, CD_PROP_FLOAT), src_values);
+  const float *dst_values = static_cast<const float *>(CustomData_get_layer(&dst, CD_PROP_FLOAT));
+  EXPECT_EQ(dst_values, src_values);
+  EXPECT_EQ(dst_values[totelem - 1], float(totelem - 1));
+
+  CustomData_free(&src, totelem * 2);
+  CustomData_free(&dst, totelem);
+}
+
+TEST(customdata, share_immutable_source_duplicate_for_write)
+{
+  const int totelem = 16;
+  CustomData src = create_float_custom_data(totelem);
+  const float *shared_values = static_cast<const float *>(
+      CustomData_get_layer(&src, CD_PROP_FLOAT));
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE_IMMUTABLE, totelem);
+
+  /* The source copies the data as well, instead of modifying the data used by the copy. */
+  float *src_values = static_cast<float *>(
+      CustomData_duplicate_referenced_layer(&src, CD_PROP_FLOAT, totelem));
+  EXPECT_NE(src_values, shared_values);
+  src_values[0] = -1.0f;
+  const float *dst_values = static_cast<const float *>(CustomData_get_layer(&dst, CD_PROP_FLOAT));
+  EXPECT_EQ(dst_values, shared_values);
+  EXPECT_EQ(dst_values[0], 0.0f);
+
+  CustomData_free(&src, totelem);
+  CustomData_free(&dst, totelem);
+}
+
+TEST(customdata, share_last_user_takes_ownership)
+{
+  const int totelem = 16;
+  CustomData src = create_float_custom_data(totelem);
+  const float *shared_values = static_cast<const float *>(
+      CustomData_get_layer(&src, CD_PROP_FLOAT));
+
+  CustomData dst;
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE_IMMUTABLE, totelem);
+  CustomData_free(&src, totelem);
+
+  /* The data isn't copied when there are no other users anymore. */
+  float *dst_values = static_cast<float *>(
+      CustomData_duplicate_referenced_layer(&dst, CD_PROP_FLOAT, totelem));
+  EXPECT_EQ(dst_values, shared_values);
+  EXPECT_FALSE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+
+  CustomData_free(&dst, totelem);
+}
+
+}  // namespace blender::bke::tests
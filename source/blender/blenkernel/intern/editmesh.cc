@@ -47,6 +47,8 @@ BMEditMesh *BKE_editmesh_copy(BMEditMesh *em)
    * in that case it makes more sense to do the
    * tessellation only when/if that copy ends up getting used. */
   em_copy->looptris = nullptr;
+  em_copy->partial_update_verts = nullptr;
+  em_copy->partial_update_verts_len = 0;
 
   /* Copy various settings. */
   em_copy->selectmode = em->selectmode;
@@ -168,6 +170,65 @@ void BKE_editmesh_looptri_and_normals_calc_with_partial(BMEditMesh *em, BMPartia
   BM_mesh_normals_update_with_partial_ex(em->bm, bmpinfo, &normals_params);
 }
 
+void BKE_editmesh_partial_update_set(BMEditMesh *em, int *verts, int verts_len)
+{
+  BMesh *bm = em->bm;
+  BLI_bitmap *verts_tag = BLI_BITMAP_NEW(bm->totvert, __func__);
+  int verts_tag_len = 0;
+
+  BM_mesh_elem_table_ensure(bm, BM_VERT);
+  BM_mesh_elem_index_ensure(bm, BM_VERT);
+
+  /* Normals of all the vertices of the faces using a changed vertex change too. */
+  for (int i = 0; i < verts_len; i++) {
+    BMVert *v = BM_vert_at_index(bm, verts[i]);
+    if (!BLI_BITMAP_TEST(verts_tag, verts[i])) {
+      BLI_BITMAP_ENABLE(verts_tag, verts[i]);
+      verts_tag_len++;
+    }
+    BMIter iter;
+    BMLoop *l;
+    BM_ITER_ELEM (l, &iter, v, BM_LOOPS_OF_VERT) {
+      BMLoop *l_iter = l;
+      do {
+        const int index = BM_elem_index_get(l_iter->v);
+        if (!BLI_BITMAP_TEST(verts_tag, index)) {
+          BLI_BITMAP_ENABLE(verts_tag, index);
+          verts_tag_len++;
+        }
+      } while ((l_iter = l_iter->next) != l);
+    }
+  }
+
+  MEM_freeN(verts);
+  verts = static_cast<int *>(MEM_malloc_arrayN(verts_tag_len, sizeof(int), __func__));
+  verts_len = 0;
+  for (int i = 0; i < bm->totvert; i++) {
+    if (BLI_BITMAP_TEST(verts_tag, i)) {
+      verts[verts_len++] = i;
+    }
+  }
+  MEM_freeN(verts_tag);
+
+  MEM_SAFE_FREE(em->partial_update_verts);
+  em->partial_update_verts = verts;
+  em->partial_update_verts_len = verts_len;
+  em->partial_update_id++;
+}
+
+void BKE_editmesh_partial_update_tag(BMEditMesh *em)
+{
+  BLI_assert(em->partial_update_verts != nullptr);
+  em->partial_update_id++;
+}
+
+void BKE_editmesh_partial_update_clear(BMEditMesh *em)
+{
+  MEM_SAFE_FREE(em->partial_update_verts);
+  em->partial_update_verts_len = 0;
+  em->partial_update_id++;
+}
+
 void BKE_editmesh_free_data(BMEditMesh *em)
 {
 
@@ -175,6 +236,8 @@ void BKE_editmesh_free_data(BMEditMesh *em)
     MEM_freeN(em->looptris);
   }
 
+  MEM_SAFE_FREE(em->partial_update_verts);
+
   if (em->bm) {
     BM_mesh_free(em->bm);
   }
@@ -22,6 +22,7 @@
 #include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_sort_utils.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1034,6 +1035,23 @@ float fcurve_samplingcb_evalcurve(FCurve *fcu, void *UNUSED(data), float evaltim
   return evaluate_fcurve(fcu, evaltime);
 }
 
+typedef struct SamplesEvalData {
+  FCurve *fcu;
+  FPoint *fpt;
+  int start;
+} SamplesEvalData;
+
+static void fcurve_store_samples_evalcurve_fn(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SamplesEvalData *data = userdata;
+  FPoint *fpt = &data->fpt[i];
+  const float cfra = (float)(data->start + i);
+  fpt->vec[0] = cfra;
+  fpt->vec[1] = evaluate_fcurve(data->fcu, cfra);
+}
+
 void fcurve_store_samples(FCurve *fcu, void *data, int start, int end, FcuSampleFunc sample_cb)
 {
   FPoint *fpt, *new_fpt;
@@ -1054,9 +1072,24 @@ void fcurve_store_samples(FCurve *fcu, void *data, int start, int end, FcuSample
   fpt = new_fpt = MEM_callocN(sizeof(FPoint) * (end - start + 1), "FPoint Samples");
 
   /* Use the sampling callback at 1-frame intervals from start to end frames. */
-  for (cfra = start; cfra <= end; cfra++, fpt++) {
-    fpt->vec[0] = (float)cfra;
-    fpt->vec[1] = sample_cb(fcu, data, (float)cfra);
+  if (sample_cb == fcurve_samplingcb_evalcurve) {
+    /* Evaluating the curve only reads it, so the frames can be sampled in parallel. */
+    SamplesEvalData eval_data = {
+        .fcu = fcu,
+        .fpt = new_fpt,
+        .start = start,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(
+        0, end - start + 1, &eval_data, fcurve_store_samples_evalcurve_fn, &settings);
+  }
+  else {
+    for (cfra = start; cfra <= end; cfra++, fpt++) {
+      fpt->vec[0] = (float)cfra;
+      fpt->vec[1] = sample_cb(fcu, data, (float)cfra);
+    }
   }
 
   /* Free any existing sample/keyframe data on curve. */
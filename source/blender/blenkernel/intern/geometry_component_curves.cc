@@ -35,7 +35,10 @@ GeometryComponent *CurveComponent::copy() const
 {
   CurveComponent *new_component = new CurveComponent();
   if (curves_ != nullptr) {
-    new_component->curves_ = BKE_curves_copy_for_eval(curves_, false);
+    /* Share the attribute arrays until they are modified, so that writing one attribute of a
+     * shared geometry only copies that attribute. */
+    new_component->curves_ = reinterpret_cast<Curves *>(BKE_id_copy_ex(
+        nullptr, &curves_->id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -37,7 +37,10 @@ GeometryComponent *MeshComponent::copy() const
 {
   MeshComponent *new_component = new MeshComponent();
   if (mesh_ != nullptr) {
-    new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    /* Share the attribute arrays until they are modified, so that writing one attribute of a
+     * shared geometry only copies that attribute. */
+    new_component->mesh_ = reinterpret_cast<Mesh *>(BKE_id_copy_ex(
+        nullptr, &mesh_->id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
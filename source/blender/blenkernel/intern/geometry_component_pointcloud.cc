@@ -25,7 +25,10 @@ GeometryComponent *PointCloudComponent::copy() const
 {
   PointCloudComponent *new_component = new PointCloudComponent();
   if (pointcloud_ != nullptr) {
-    new_component->pointcloud_ = BKE_pointcloud_copy_for_eval(pointcloud_, false);
+    /* Share the attribute arrays until they are modified, so that writing one attribute of a
+     * shared geometry only copies that attribute. */
+    new_component->pointcloud_ = reinterpret_cast<PointCloud *>(BKE_id_copy_ex(
+        nullptr, &pointcloud_->id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -124,6 +124,9 @@ GeometrySet::~GeometrySet() = default;
 GeometrySet &GeometrySet::operator=(const GeometrySet &other) = default;
 GeometrySet &GeometrySet::operator=(GeometrySet &&other) = default;
 
+/** Incremented whenever a shared component is copied on the current thread. */
+static thread_local int64_t copied_components_num = 0;
+
 GeometryComponent &GeometrySet::get_component_for_write(GeometryComponentType component_type)
 {
   GeometryComponentPtr &component_ptr = components_[component_type];
@@ -139,9 +142,15 @@ GeometryComponent &GeometrySet::get_component_for_write(GeometryComponentType co
   /* If the referenced component is shared, make a copy. The copy is not shared and is
    * therefore mutable. */
   component_ptr = component_ptr->copy();
+  copied_components_num++;
   return *component_ptr;
 }
 
+int64_t GeometrySet::copied_components_num_on_thread()
+{
+  return copied_components_num;
+}
+
 GeometryComponent *GeometrySet::get_component_ptr(GeometryComponentType type)
 {
   if (this->has(type)) {
@@ -13,6 +13,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -684,21 +685,55 @@ static void copy_frame_to_eval_cb(bGPDlayer *gpl,
   copy_frame_to_eval_ex(gpf->runtime.gpf_orig, gpf);
 }
 
+typedef struct CopyActiveFramesData {
+  Depsgraph *depsgraph;
+  Scene *scene;
+  Object *ob;
+  bGPDlayer **layers;
+} CopyActiveFramesData;
+
+static void copy_active_frame_to_eval_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CopyActiveFramesData *data = (CopyActiveFramesData *)userdata;
+  bGPDlayer *gpl_eval = data->layers[i];
+
+  /* Remap layer active frame with time modifiers applied. */
+  bGPDframe *gpf_eval = gpl_eval->actframe;
+  int remap_cfra = gpencil_remap_time_get(data->depsgraph, data->scene, data->ob, gpl_eval);
+  if (gpf_eval == NULL || gpf_eval->framenum != remap_cfra) {
+    gpl_eval->actframe = BKE_gpencil_layer_frame_get(gpl_eval, remap_cfra, GP_GETFRAME_USE_PREV);
+  }
+  /* Always copy active frame to eval, because the modifiers always evaluate the active frame,
+   * even if it's not visible (e.g. the layer is hidden). */
+  if (gpl_eval->actframe != NULL) {
+    copy_frame_to_eval_ex(gpl_eval->actframe->runtime.gpf_orig, gpl_eval->actframe);
+  }
+}
+
 static void gpencil_copy_visible_frames_to_eval(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
-  /* Remap layers active frame with time modifiers applied. */
+  /* Layers only write to their own active frame, copy them in parallel. */
   bGPdata *gpd_eval = ob->data;
-  LISTBASE_FOREACH (bGPDlayer *, gpl_eval, &gpd_eval->layers) {
-    bGPDframe *gpf_eval = gpl_eval->actframe;
-    int remap_cfra = gpencil_remap_time_get(depsgraph, scene, ob, gpl_eval);
-    if (gpf_eval == NULL || gpf_eval->framenum != remap_cfra) {
-      gpl_eval->actframe = BKE_gpencil_layer_frame_get(gpl_eval, remap_cfra, GP_GETFRAME_USE_PREV);
-    }
-    /* Always copy active frame to eval, because the modifiers always evaluate the active frame,
-     * even if it's not visible (e.g. the layer is hidden). */
-    if (gpl_eval->actframe != NULL) {
-      copy_frame_to_eval_ex(gpl_eval->actframe->runtime.gpf_orig, gpl_eval->actframe);
+  const int layers_len = BLI_listbase_count(&gpd_eval->layers);
+  if (layers_len > 0) {
+    CopyActiveFramesData data = {
+        .depsgraph = depsgraph,
+        .scene = scene,
+        .ob = ob,
+        .layers = MEM_malloc_arrayN(layers_len, sizeof(bGPDlayer *), __func__),
+    };
+    int i = 0;
+    LISTBASE_FOREACH (bGPDlayer *, gpl_eval, &gpd_eval->layers) {
+      data.layers[i++] = gpl_eval;
     }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, layers_len, &data, copy_active_frame_to_eval_fn, &settings);
+    MEM_freeN(data.layers);
   }
 
   /* Copy visible frames that are not the active one to evaluated version. */
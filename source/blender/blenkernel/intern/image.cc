@@ -463,6 +463,7 @@ static ImBuf *image_load_image_file(
 static ImBuf *image_acquire_ibuf(Image *ima, ImageUser *iuser, void **r_lock);
 static void image_update_views_format(Image *ima, ImageUser *iuser);
 static void image_add_view(Image *ima, const char *viewname, const char *filepath);
+static void image_multilayer_pass_ensure_loaded(Image *ima, RenderPass *rpass);
 
 /* max int, to indicate we don't store sequences in ibuf */
 #define IMA_NO_INDEX 0x7FEFEFEF
@@ -3734,6 +3735,15 @@ RenderResult *BKE_image_acquire_renderresult(Scene *scene, Image *ima)
   RenderResult *rr = nullptr;
   if (ima->rr) {
     rr = ima->rr;
+
+    /* Users of the whole render result read the pixels of all passes. */
+    BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+    LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+      LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+        image_multilayer_pass_ensure_loaded(ima, rpass);
+      }
+    }
+    BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
   }
   else if (ima->type == IMA_TYPE_R_RESULT) {
     if (ima->render_slot == ima->last_render_slot) {
@@ -3873,8 +3883,105 @@ static void image_create_multilayer(Image *ima, ImBuf *ibuf, int framenr)
   /* set proper views */
   image_init_multilayer_multiview(ima, ima->rr);
 }
+
+/* Multilayer files that are loaded from disk only read the layers and passes of the render
+ * result at first, the pixels of a pass are read the first time it's used. Files with dozens of
+ * passes of which only a few are used then don't need all of them in memory. */
+static bool image_create_multilayer_lazy(Image *ima, const char *filepath, int framenr)
+{
+  if (!BLI_path_extension_check(filepath, ".exr")) {
+    return false;
+  }
+
+  void *exrhandle = IMB_exr_get_handle();
+  int width, height;
+  if (!IMB_exr_begin_read_layers(exrhandle, filepath, &width, &height)) {
+    IMB_exr_close(exrhandle);
+    return false;
+  }
+
+  /* Same default as when loading the image buffer. */
+  if (ima->colorspace_settings.name[0] == '\0') {
+    STRNCPY(ima->colorspace_settings.name,
+            IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DEFAULT_FLOAT));
+  }
+  const char *colorspace = ima->colorspace_settings.name;
+  bool predivide = (ima->alpha_mode == IMA_ALPHA_PREMUL);
+
+  ima->rr = RE_MultilayerConvert(exrhandle, colorspace, predivide, width, height);
+
+  if (ima->rr != nullptr) {
+    ImBuf *ibuf = IMB_allocImBuf(width, height, 32, 0);
+    IMB_exr_read_metadata(exrhandle, ibuf);
+    ima->rr->framenr = framenr;
+    BKE_stamp_info_from_imbuf(ima->rr, ibuf);
+    IMB_freeImBuf(ibuf);
+  }
+  IMB_exr_close(exrhandle);
+
+  /* set proper views */
+  image_init_multilayer_multiview(ima, ima->rr);
+
+  return ima->rr != nullptr;
+}
 #endif /* WITH_OPENEXR */
 
+/** Read the pixels of a pass of a lazily loaded multilayer image if not done yet. */
+static void image_multilayer_pass_ensure_loaded(Image *ima, RenderPass *rpass)
+{
+  if (rpass->rect != nullptr || rpass->channels == 0) {
+    return;
+  }
+
+  RenderLayer *rl = nullptr;
+  LISTBASE_FOREACH (RenderLayer *, rl_iter, &ima->rr->layers) {
+    if (BLI_findindex(&rl_iter->passes, rpass) != -1) {
+      rl = rl_iter;
+      break;
+    }
+  }
+  BLI_assert(rl != nullptr);
+
+  /* Missing pixels are black, like unloaded render passes. */
+  rpass->rect = static_cast<float *>(MEM_callocN(
+      sizeof(float) * rpass->channels * size_t(rpass->rectx) * rpass->recty, "loaded pass"));
+
+#ifdef WITH_OPENEXR
+  /* Same file path as in #load_image_single, lazy loading is only used for its first view. */
+  char filepath[FILE_MAX];
+  ImageUser iuser_t{};
+  iuser_t.framenr = ima->lastframe;
+  BKE_image_user_file_path(&iuser_t, ima, filepath);
+
+  void *exrhandle = IMB_exr_get_handle();
+  int width, height;
+  bool success = false;
+  if (IMB_exr_begin_read_layers(exrhandle, filepath, &width, &height) &&
+      width == rpass->rectx && height == rpass->recty) {
+    success = IMB_exr_read_pass(exrhandle, rl->name, rpass->name, rpass->view, rpass->rect);
+  }
+  IMB_exr_close(exrhandle);
+
+  if (!success) {
+    printf("error, could not load pass %s of layer %s from %s\n", rpass->name, rl->name, filepath);
+    return;
+  }
+
+  if (rpass->channels >= 3) {
+    IMB_colormanagement_transform(
+        rpass->rect,
+        rpass->rectx,
+        rpass->recty,
+        rpass->channels,
+        ima->colorspace_settings.name,
+        IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_SCENE_LINEAR),
+        ima->alpha_mode == IMA_ALPHA_PREMUL);
+  }
+#else
+  UNUSED_VARS(rl);
+#endif
+}
+
 /** Common stuff to do with images after loading. */
 static void image_init_after_load(Image *ima, ImageUser *iuser, ImBuf *UNUSED(ibuf))
 {
@@ -4134,6 +4241,16 @@ static ImBuf *load_image_single(Image *ima,
 
     BKE_image_user_file_path(&iuser_t, ima, filepath);
 
+#ifdef WITH_OPENEXR
+    if (!is_sequence && ima->source == IMA_SRC_FILE && image_num_viewfiles(ima) == 1 &&
+        ima->rr == nullptr && image_create_multilayer_lazy(ima, filepath, cfra)) {
+      ima->type = IMA_TYPE_MULTILAYER;
+      /* Pixels are in the render result, see the multilayer case below. */
+      *r_cache_ibuf = false;
+      return nullptr;
+    }
+#endif
+
     /* read ibuf */
     flag |= IB_metadata;
     flag |= imbuf_alpha_flags_for_image(ima);
@@ -4266,6 +4383,8 @@ static ImBuf *image_get_ibuf_multilayer(Image *ima, ImageUser *iuser)
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
 
     if (rpass) {
+      image_multilayer_pass_ensure_loaded(ima, rpass);
+
       ibuf = IMB_allocImBuf(ima->rr->rectx, ima->rr->recty, 32, 0);
 
       image_init_after_load(ima, iuser, ibuf);
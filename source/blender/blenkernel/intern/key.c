@@ -15,6 +15,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -927,6 +928,9 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start; /* key elemsize yes! */
         from += key->elemsize * start;
+        if (weights) {
+          weights += start / step;
+        }
 
         for (b = start; b < end; b += step) {
 
@@ -1382,6 +1386,34 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+typedef struct MeshKeyRelativeData {
+  Key *key;
+  KeyBlock *actkb;
+  float **per_keyblock_weights;
+  char *out;
+  int tot;
+} MeshKeyRelativeData;
+
+/* Number of vertices evaluated by each parallel task, the ranges write separate vertices. */
+#define MESH_KEY_RELATIVE_CHUNK_SIZE 4096
+
+static void do_mesh_key_relative_chunk_fn(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshKeyRelativeData *data = userdata;
+  const int start = chunk * MESH_KEY_RELATIVE_CHUNK_SIZE;
+  const int end = min_ii(start + MESH_KEY_RELATIVE_CHUNK_SIZE, data->tot);
+  key_evaluate_relative(start,
+                        end,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1392,8 +1424,32 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    /* The edit-mode data of the active key is copied on every call (see #key_block_get_data)
+     * and a reference key with a different size is resampled from the start, only evaluate
+     * ranges in parallel otherwise. */
+    const Mesh *me = (const Mesh *)key->from;
+    if (tot > MESH_KEY_RELATIVE_CHUNK_SIZE && me->edit_mesh == NULL && key->refkey &&
+        key->refkey->totelem == tot) {
+      MeshKeyRelativeData data = {
+          .key = key,
+          .actkb = actkb,
+          .per_keyblock_weights = per_keyblock_weights,
+          .out = out,
+          .tot = tot,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(0,
+                              divide_ceil_u(tot, MESH_KEY_RELATIVE_CHUNK_SIZE),
+                              &data,
+                              do_mesh_key_relative_chunk_fn,
+                              &settings);
+    }
+    else {
+      key_evaluate_relative(
+          0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    }
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
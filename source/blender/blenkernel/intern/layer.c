@@ -1068,6 +1068,12 @@ static void layer_collection_sync(ViewLayer *view_layer,
 
   BLI_assert(layer_resync->is_used);
 
+  /* In the common case of an unchanged hierarchy, the existing children layers match the
+   * children collections in the same order. As long as they do, use them directly instead of
+   * searching the old hierarchy, which is quadratic in the number of children. Since children
+   * collections are unique, this gives the same layer than #layer_collection_resync_find. */
+  LayerCollectionResync *child_layer_resync_next = layer_resync->children_layer_resync.first;
+
   uint64_t skipped_children = 0;
   LISTBASE_FOREACH (CollectionChild *, child, &layer_resync->collection->children) {
     Collection *child_collection = child->collection;
@@ -1076,8 +1082,16 @@ static void layer_collection_sync(ViewLayer *view_layer,
       skipped_children++;
       continue;
     }
-    LayerCollectionResync *child_layer_resync = layer_collection_resync_find(layer_resync,
-                                                                             child_collection);
+    LayerCollectionResync *child_layer_resync = NULL;
+    if (child_layer_resync_next != NULL &&
+        child_layer_resync_next->collection == child_collection) {
+      child_layer_resync = child_layer_resync_next;
+      child_layer_resync_next = child_layer_resync_next->next;
+    }
+    else {
+      child_layer_resync_next = NULL;
+      child_layer_resync = layer_collection_resync_find(layer_resync, child_collection);
+    }
 
     if (child_layer_resync != NULL) {
       BLI_assert(child_layer_resync->collection != NULL);
@@ -1477,6 +1477,101 @@ void id_sort_by_name(ListBase *lb, ID *id, ID *id_sorting_hint)
 #undef ID_SORT_STEP_SIZE
 }
 
+typedef struct IDSortItem {
+  ID *id;
+  /* Index of the library of the ID, in the order they first appear in the list. */
+  int lib_index;
+  int index;
+} IDSortItem;
+
+static int id_sort_item_cmp(const void *a_v, const void *b_v)
+{
+  const IDSortItem *a = a_v;
+  const IDSortItem *b = b_v;
+  if (a->lib_index != b->lib_index) {
+    return a->lib_index < b->lib_index ? -1 : 1;
+  }
+  const int name_cmp = BLI_strcasecmp(a->id->name, b->id->name);
+  if (name_cmp != 0) {
+    return name_cmp;
+  }
+  /* Keep the order of IDs with the same name, like inserting them one by one does. */
+  return a->index < b->index ? -1 : 1;
+}
+
+static bool id_listbase_is_sorted(const ListBase *lb)
+{
+  LISTBASE_FOREACH (const ID *, id, lb) {
+    const ID *id_next = id->next;
+    if (id_next != NULL && id_next->lib == id->lib &&
+        BLI_strcasecmp(id->name, id_next->name) > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Sort the whole list at once, keeping the IDs of every library together in the order the
+ * libraries first appear. */
+static void id_listbase_sort_by_name(ListBase *lb)
+{
+  if (id_listbase_is_sorted(lb)) {
+    return;
+  }
+
+  const int items_num = BLI_listbase_count(lb);
+  IDSortItem *items = MEM_malloc_arrayN(items_num, sizeof(*items), __func__);
+  GHash *lib_indices = BLI_ghash_ptr_new(__func__);
+  int index = 0;
+  LISTBASE_FOREACH (ID *, id, lb) {
+    void **lib_index_p;
+    if (!BLI_ghash_ensure_p(lib_indices, id->lib, &lib_index_p)) {
+      *lib_index_p = POINTER_FROM_INT(BLI_ghash_len(lib_indices) - 1);
+    }
+    items[index].id = id;
+    items[index].lib_index = POINTER_AS_INT(*lib_index_p);
+    items[index].index = index;
+    index++;
+  }
+  BLI_ghash_free(lib_indices, NULL, NULL);
+
+  qsort(items, (size_t)items_num, sizeof(*items), id_sort_item_cmp);
+
+  BLI_listbase_clear(lb);
+  for (int i = 0; i < items_num; i++) {
+    BLI_addtail(lb, items[i].id);
+  }
+  MEM_freeN(items);
+}
+
+void BKE_main_id_sort_defer_begin(Main *bmain)
+{
+  bmain->id_sort_defer_level++;
+}
+
+void BKE_main_id_sort_defer_end(Main *bmain)
+{
+  BLI_assert(bmain->id_sort_defer_level > 0);
+  bmain->id_sort_defer_level--;
+  if (bmain->id_sort_defer_level > 0) {
+    return;
+  }
+
+  ListBase *lbarray[INDEX_ID_MAX];
+  int a = set_listbasepointers(bmain, lbarray);
+  while (a--) {
+    id_listbase_sort_by_name(lbarray[a]);
+  }
+}
+
+static void id_sort_by_name_or_defer(Main *bmain, ListBase *lb, ID *id)
+{
+  if (bmain->id_sort_defer_level > 0) {
+    return;
+  }
+  id_sort_by_name(lb, id, NULL);
+}
+
 bool BKE_id_new_name_validate(
     struct Main *bmain, ListBase *lb, ID *id, const char *tname, const bool do_linked_data)
 {
@@ -1485,7 +1580,7 @@ bool BKE_id_new_name_validate(
 
   /* If library, don't rename (unless explicitly required), but do ensure proper sorting. */
   if (!do_linked_data && ID_IS_LINKED(id)) {
-    id_sort_by_name(lb, id, NULL);
+    id_sort_by_name_or_defer(bmain, lb, id);
 
     return result;
   }
@@ -1511,7 +1606,7 @@ bool BKE_id_new_name_validate(
   result = BKE_main_namemap_get_name(bmain, id, name);
 
   strcpy(id->name + 2, name);
-  id_sort_by_name(lb, id, NULL);
+  id_sort_by_name_or_defer(bmain, lb, id);
   return result;
 }
 
@@ -1807,10 +1902,12 @@ void BKE_library_make_local(Main *bmain,
    * ID in a separated loop,
    * as lbarray ordering is not enough to ensure us we did catch all dependencies
    * (e.g. if making local a parent object before its child...). See T48907. */
-  /* TODO: This is now the biggest step by far (in term of processing time).
-   * We may be able to gain here by using again main->relations mapping, but...
-   * this implies BKE_libblock_remap & co to be able to update main->relations on the fly.
-   * Have to think about it a bit more, and see whether new code is OK first, anyway. */
+  /* This used to be the biggest step by far (in term of processing time), since each remapping
+   * had to check the whole Main. All new IDs now exist, so the relations mapping can be computed
+   * once, and BKE_libblock_remap & co only process the known users of each remapped ID. */
+  if (copied_ids != NULL) {
+    BKE_main_relations_create(bmain, 0);
+  }
   for (LinkNode *it = copied_ids; it; it = it->next) {
     ID *id = it->link;
 
@@ -1829,6 +1926,7 @@ void BKE_library_make_local(Main *bmain,
       id_us_ensure_real(id->newid);
     }
   }
+  BKE_main_relations_free(bmain);
 
 #ifdef DEBUG_TIME
   printf("Step 4: Remap local usages of old (linked) ID to new (local) ID: Done.\n");
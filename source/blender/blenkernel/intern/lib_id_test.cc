@@ -214,6 +214,31 @@ TEST(lib_id_main_unique_name, ids_sorted_by_default_with_libraries)
   EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
 }
 
+TEST(lib_id_main_sort, deferred_sort_with_libraries)
+{
+  LibIDMainSortTestContext ctx;
+
+  Library *lib_one = static_cast<Library *>(BKE_id_new(ctx.bmain, ID_LI, "LibOne"));
+
+  ID *id_foo = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Foo"));
+  ID *id_l1b = add_id_in_library(ctx.bmain, "B", lib_one);
+
+  BKE_main_id_sort_defer_begin(ctx.bmain);
+  ID *id_yes = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Yes"));
+  ID *id_bar = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Bar"));
+  BKE_main_id_sort_defer_begin(ctx.bmain);
+  ID *id_baz = static_cast<ID *>(BKE_id_new(ctx.bmain, ID_OB, "Baz"));
+  BKE_main_id_sort_defer_end(ctx.bmain);
+
+  /* Only sorted at the end of the outermost deferring. */
+  test_lib_id_main_sort_check_order({id_foo, id_l1b, id_yes, id_bar, id_baz});
+
+  BKE_main_id_sort_defer_end(ctx.bmain);
+  test_lib_id_main_sort_check_order({id_bar, id_baz, id_foo, id_yes, id_l1b});
+
+  EXPECT_TRUE(BKE_main_namemap_validate(ctx.bmain));
+}
+
 TEST(lib_id_main_unique_name, name_too_long_handling)
 {
   LibIDMainSortTestContext ctx;
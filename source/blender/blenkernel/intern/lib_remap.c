@@ -8,7 +8,11 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
 #include "BLI_linklist.h"
+#include "BLI_mempool.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -437,6 +441,66 @@ static void libblock_remap_reset_remapping_status_callback(ID *old_id,
   }
 }
 
+typedef struct LibblockRemapRelationsData {
+  MainIDRelations *relations;
+  GSet *owner_ids;
+} LibblockRemapRelationsData;
+
+/* Gather the IDs using \a old_id according to `bmain->relations`. */
+static void libblock_remap_relations_owners_collect_cb(ID *old_id,
+                                                       ID *UNUSED(new_id),
+                                                       void *user_data)
+{
+  LibblockRemapRelationsData *data = user_data;
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(data->relations->relations_from_pointers, old_id);
+  if (entry == NULL) {
+    return;
+  }
+
+  for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
+       from_id_entry = from_id_entry->next) {
+    ID *id_owner = from_id_entry->id_pointer.from;
+    /* Embedded IDs are processed through their owner, as in the whole Main case. */
+    if (id_owner->flag & LIB_EMBEDDED_DATA) {
+      id_owner = BKE_id_owner_get(id_owner);
+    }
+    if (id_owner != NULL) {
+      BLI_gset_add(data->owner_ids, id_owner);
+    }
+  }
+}
+
+/* Users of \a old_id may now be using \a new_id instead, add them to its users in
+ * `bmain->relations`. Users list of \a old_id is kept as is, so that it remains a superset of the
+ * actual users of each ID, which is all that is needed for further remappings. */
+static void libblock_remap_relations_update_cb(ID *old_id, ID *new_id, void *user_data)
+{
+  MainIDRelations *relations = user_data;
+  if (new_id == NULL || new_id == old_id) {
+    return;
+  }
+
+  MainIDRelationsEntry *old_entry = BLI_ghash_lookup(relations->relations_from_pointers, old_id);
+  if (old_entry == NULL || old_entry->from_ids == NULL) {
+    return;
+  }
+
+  MainIDRelationsEntry **new_entry_p;
+  if (!BLI_ghash_ensure_p(relations->relations_from_pointers, new_id, (void ***)&new_entry_p)) {
+    *new_entry_p = MEM_callocN(sizeof(**new_entry_p), __func__);
+    (*new_entry_p)->session_uuid = new_id->session_uuid;
+  }
+  MainIDRelationsEntry *new_entry = *new_entry_p;
+
+  for (MainIDRelationsEntryItem *from_id_entry = old_entry->from_ids; from_id_entry != NULL;
+       from_id_entry = from_id_entry->next) {
+    MainIDRelationsEntryItem *new_from_id_entry = BLI_mempool_alloc(relations->entry_items_pool);
+    *new_from_id_entry = *from_id_entry;
+    new_from_id_entry->next = new_entry->from_ids;
+    new_entry->from_ids = new_from_id_entry;
+  }
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -445,6 +509,8 @@ static void libblock_remap_reset_remapping_status_callback(ID *old_id,
  *   (remapping \a old_id to \a new_id).
  *   The whole \a bmain database is checked, and all pointers to \a old_id
  *   are remapped to \a new_id.
+ *   If `bmain->relations` exists, only the IDs using \a old_id according to it are checked, it
+ *   must then be up to date with the content of \a bmain.
  * - \a id is non-NULL:
  *   + If \a old_id is NULL, \a new_id must also be NULL,
  *     and all ID pointers from \a id are cleared
@@ -488,6 +554,28 @@ static void libblock_remap_data(Main *bmain,
     BKE_library_foreach_ID_link(
         NULL, id, foreach_libblock_remap_callback, &id_remap_data, foreach_id_flags);
   }
+  else if (bmain->relations != NULL &&
+           (remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) == 0) {
+    /* Only check the known users of the remapped IDs instead of the whole Main. Relations do not
+     * store internal runtime pointers, so those still need the brute force approach below. */
+    LibblockRemapRelationsData relations_data = {
+        .relations = bmain->relations,
+        .owner_ids = BLI_gset_ptr_new(__func__),
+    };
+    BKE_id_remapper_iter(
+        id_remapper, libblock_remap_relations_owners_collect_cb, &relations_data);
+
+    GSET_FOREACH_BEGIN (ID *, id_curr, relations_data.owner_ids) {
+      id_remap_data.id_owner = id_curr;
+      libblock_remap_data_preprocess(id_remap_data.id_owner, remap_type, id_remapper);
+      BKE_library_foreach_ID_link(
+          NULL, id_curr, foreach_libblock_remap_callback, &id_remap_data, foreach_id_flags);
+    }
+    GSET_FOREACH_END();
+    BLI_gset_free(relations_data.owner_ids, NULL);
+
+    BKE_id_remapper_iter(id_remapper, libblock_remap_relations_update_cb, bmain->relations);
+  }
   else {
     /* Note that this is a very 'brute force' approach,
      * maybe we could use some depsgraph to only process objects actually using given old_id...
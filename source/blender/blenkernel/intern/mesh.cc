@@ -104,6 +104,10 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
   const Mesh *mesh_src = (const Mesh *)id_src;
 
   BKE_mesh_runtime_reset_on_copy(mesh_dst, flag);
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    /* The layers are shared with the source, so the data is still the same. */
+    mesh_dst->runtime.data_version = mesh_src->runtime.data_version;
+  }
   /* Copy face dot tags, since meshes may be duplicated after a subsurf modifier
    * or node, but we still need to be able to draw face center vertices. */
   mesh_dst->runtime.subsurf_face_dot_tags = static_cast<uint32_t *>(
@@ -137,7 +141,17 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   BKE_defgroup_copy_list(&mesh_dst->vertex_group_names, &mesh_src->vertex_group_names);
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & LIB_ID_COPY_CD_SHARE) {
+    alloc_type = CD_SHARE_IMMUTABLE;
+  }
+  else if (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) {
+    /* Copy-on-write copies share the arrays with the original mesh until they are modified. */
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&mesh_src->vdata, &mesh_dst->vdata, mask.vmask, alloc_type, mesh_dst->totvert);
   CustomData_copy(&mesh_src->edata, &mesh_dst->edata, mask.emask, alloc_type, mesh_dst->totedge);
   CustomData_copy(&mesh_src->ldata, &mesh_dst->ldata, mask.lmask, alloc_type, mesh_dst->totloop);
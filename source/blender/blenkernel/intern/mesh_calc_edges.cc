@@ -2,15 +2,21 @@
 
 /** \file
  * \ingroup bke
+ *
+ * Edges are deduplicated by sorting instead of hashing: every face corner emits a key for the
+ * edge to the next corner in its polygon, and the keys are sorted with a parallel radix sort.
+ * Equal keys are next to each other then, so every run of equal keys becomes one edge. This
+ * scales with the number of cores and, unlike distributing the edges over multiple hash tables,
+ * the resulting edge order does not depend on the number of threads.
  */
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 
-#include "BLI_map.hh"
+#include "BLI_array.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
-#include "BLI_threads.h"
 #include "BLI_timeit.hh"
 
 #include "BKE_attribute.hh"
@@ -19,191 +25,172 @@
 
 namespace blender::bke::calc_edges {
 
-/** This is used to uniquely identify edges in a hash map. */
-struct OrderedEdge {
-  int v_low, v_high;
+/** Number of sorted keys that are processed by one task when looking for unique edges. */
+constexpr int64_t chunk_size = 64 * 1024;
 
-  OrderedEdge(const int v1, const int v2)
-  {
-    if (v1 < v2) {
-      v_low = v1;
-      v_high = v2;
-    }
-    else {
-      v_low = v2;
-      v_high = v1;
-    }
-  }
-
-  OrderedEdge(const uint v1, const uint v2) : OrderedEdge(int(v1), int(v2))
-  {
-  }
-
-  uint64_t hash() const
-  {
-    return (this->v_low << 8) ^ this->v_high;
-  }
-
-  /** Return a hash value that is likely to be different in the low bits from the normal `hash()`
-   * function. This is necessary to avoid collisions in #BKE_mesh_calc_edges. */
-  uint64_t hash2() const
-  {
-    return this->v_low;
-  }
-
-  friend bool operator==(const OrderedEdge &e1, const OrderedEdge &e2)
-  {
-    BLI_assert(e1.v_low < e1.v_high);
-    BLI_assert(e2.v_low < e2.v_high);
-    return e1.v_low == e2.v_low && e1.v_high == e2.v_high;
-  }
-};
+/**
+ * Key that identifies an edge independent of its direction. Sorting the keys sorts the edges by
+ * their lower vertex index first.
+ */
+static uint64_t edge_key(const uint v1, const uint v2)
+{
+  const uint64_t v_low = std::min(v1, v2);
+  const uint64_t v_high = std::max(v1, v2);
+  return (v_low << 32) | v_high;
+}
 
-/* The map first contains an edge pointer and later an index. */
-union OrigEdgeOrIndex {
-  const MEdge *original_edge;
-  int index;
-};
-using EdgeMap = Map<OrderedEdge, OrigEdgeOrIndex>;
+static uint edge_key_v_low(const uint64_t key)
+{
+  return uint(key >> 32);
+}
 
-static void reserve_hash_maps(const Mesh *mesh,
-                              const bool keep_existing_edges,
-                              MutableSpan<EdgeMap> edge_maps)
+static uint edge_key_v_high(const uint64_t key)
 {
-  const int totedge_guess = std::max(keep_existing_edges ? mesh->totedge : 0, mesh->totpoly * 2);
-  threading::parallel_for_each(
-      edge_maps, [&](EdgeMap &edge_map) { edge_map.reserve(totedge_guess / edge_maps.size()); });
+  return uint(key & 0xFFFFFFFF);
 }
 
-static void add_existing_edges_to_hash_maps(Mesh *mesh,
-                                            MutableSpan<EdgeMap> edge_maps,
-                                            uint32_t parallel_mask)
+/**
+ * Used for corners whose next corner uses the same vertex, which only happens when the mesh data
+ * is invalid. Since the lower vertex index of a valid key is always smaller than the higher one,
+ * this can't collide with a real edge. It's the largest key, so these corners are sorted last.
+ */
+constexpr uint64_t invalid_edge_key = std::numeric_limits<uint64_t>::max();
+
+/**
+ * Create a key for every existing edge that is kept and for every face corner. Existing edges
+ * come first, so that the stable sort keeps them in front of the corners that use the same edge.
+ * The value of an existing edge is its index, the value of a corner is its index offset by the
+ * number of existing edges.
+ */
+static void create_edge_keys(const Mesh &mesh,
+                             const int existing_edges_num,
+                             MutableSpan<uint64_t> r_keys,
+                             MutableSpan<int> r_values)
 {
-  /* Assume existing edges are valid. */
-  const Span<MEdge> edges = mesh->edges();
-  threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
-    const int task_index = &edge_map - edge_maps.data();
-    for (const MEdge &edge : edges) {
-      OrderedEdge ordered_edge{edge.v1, edge.v2};
-      /* Only add the edge when it belongs into this map. */
-      if (task_index == (parallel_mask & ordered_edge.hash2())) {
-        edge_map.add_new(ordered_edge, {&edge});
-      }
+  const Span<MEdge> edges = mesh.edges();
+  const Span<MPoly> polys = mesh.polys();
+  const Span<MLoop> loops = mesh.loops();
+
+  threading::parallel_for(IndexRange(existing_edges_num), 4096, [&](const IndexRange range) {
+    for (const int edge_i : range) {
+      /* Assume existing edges are valid. */
+      r_keys[edge_i] = edge_key(edges[edge_i].v1, edges[edge_i].v2);
+      r_values[edge_i] = edge_i;
     }
   });
-}
 
-static void add_polygon_edges_to_hash_maps(Mesh *mesh,
-                                           MutableSpan<EdgeMap> edge_maps,
-                                           uint32_t parallel_mask)
-{
-  const Span<MPoly> polys = mesh->polys();
-  const Span<MLoop> loops = mesh->loops();
-  threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
-    const int task_index = &edge_map - edge_maps.data();
-    for (const MPoly &poly : polys) {
-      Span<MLoop> poly_loops = loops.slice(poly.loopstart, poly.totloop);
-      const MLoop *prev_loop = &poly_loops.last();
-      for (const MLoop &next_loop : poly_loops) {
-        /* Can only be the same when the mesh data is invalid. */
-        if (prev_loop->v != next_loop.v) {
-          OrderedEdge ordered_edge{prev_loop->v, next_loop.v};
-          /* Only add the edge when it belongs into this map. */
-          if (task_index == (parallel_mask & ordered_edge.hash2())) {
-            edge_map.lookup_or_add(ordered_edge, {nullptr});
-          }
-        }
-        prev_loop = &next_loop;
+  MutableSpan<uint64_t> corner_keys = r_keys.drop_front(existing_edges_num);
+  MutableSpan<int> corner_values = r_values.drop_front(existing_edges_num);
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int poly_i : range) {
+      const MPoly &poly = polys[poly_i];
+      const IndexRange poly_corners(poly.loopstart, poly.totloop);
+      int corner_prev = int(poly_corners.last());
+      for (const int corner : poly_corners) {
+        const uint v_prev = loops[corner_prev].v;
+        const uint v_next = loops[corner].v;
+        /* The edge between two corners is stored in the first one. */
+        corner_keys[corner_prev] = v_prev == v_next ? invalid_edge_key :
+                                                      edge_key(v_prev, v_next);
+        corner_values[corner_prev] = existing_edges_num + corner_prev;
+        corner_prev = corner;
       }
     }
   });
 }
 
-static void serialize_and_initialize_deduplicated_edges(MutableSpan<EdgeMap> edge_maps,
-                                                        MutableSpan<MEdge> new_edges)
+/**
+ * Find the number of unique edges in every chunk of the sorted keys that are not existing edges.
+ * They become offsets for the new edges of every chunk afterwards.
+ * \return The total number of new edges.
+ */
+static int count_new_edges_per_chunk(const Span<uint64_t> sorted_keys,
+                                     const Span<int> sorted_values,
+                                     const int existing_edges_num,
+                                     MutableSpan<int> r_chunk_offsets)
 {
-  /* All edges are distributed in the hash tables now. They have to be serialized into a single
-   * array below. To be able to parallelize this, we have to compute edge index offsets for each
-   * map. */
-  Array<int> edge_index_offsets(edge_maps.size());
-  edge_index_offsets[0] = 0;
-  for (const int i : IndexRange(edge_maps.size() - 1)) {
-    edge_index_offsets[i + 1] = edge_index_offsets[i] + edge_maps[i].size();
-  }
-
-  threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
-    const int task_index = &edge_map - edge_maps.data();
-
-    int new_edge_index = edge_index_offsets[task_index];
-    for (EdgeMap::MutableItem item : edge_map.items()) {
-      MEdge &new_edge = new_edges[new_edge_index];
-      const MEdge *orig_edge = item.value.original_edge;
-      if (orig_edge != nullptr) {
-        /* Copy values from original edge. */
-        new_edge = *orig_edge;
-      }
-      else {
-        /* Initialize new edge. */
-        new_edge.v1 = item.key.v_low;
-        new_edge.v2 = item.key.v_high;
-        new_edge.flag = ME_EDGEDRAW | ME_EDGERENDER;
+  threading::parallel_for(r_chunk_offsets.index_range(), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      const IndexRange range = IndexRange(chunk * chunk_size, chunk_size)
+                                   .intersect(sorted_keys.index_range());
+      int count = 0;
+      for (const int64_t i : range) {
+        const bool is_first_of_edge = i == 0 || sorted_keys[i] != sorted_keys[i - 1];
+        if (is_first_of_edge && sorted_keys[i] != invalid_edge_key &&
+            sorted_values[i] >= existing_edges_num) {
+          count++;
+        }
       }
-      item.value.index = new_edge_index;
-      new_edge_index++;
+      r_chunk_offsets[chunk] = count;
     }
   });
+  int offset = existing_edges_num;
+  for (int &chunk_offset : r_chunk_offsets) {
+    const int count = chunk_offset;
+    chunk_offset = offset;
+    offset += count;
+  }
+  return offset - existing_edges_num;
 }
 
-static void update_edge_indices_in_poly_loops(Mesh *mesh,
-                                              Span<EdgeMap> edge_maps,
-                                              uint32_t parallel_mask)
+/**
+ * Initialize the new edges and set the edge index of every corner. Every chunk starts with the
+ * first edge whose key starts in that chunk, so chunks can be processed independently. A run of
+ * equal keys that starts in the previous chunk is handled by that chunk.
+ */
+static void scatter_edge_indices(const Span<uint64_t> sorted_keys,
+                                 const Span<int> sorted_values,
+                                 const int existing_edges_num,
+                                 const Span<int> chunk_offsets,
+                                 MutableSpan<MEdge> new_edges,
+                                 MutableSpan<MLoop> loops)
 {
-  const Span<MPoly> polys = mesh->polys();
-  MutableSpan<MLoop> loops = mesh->loops_for_write();
-  threading::parallel_for(IndexRange(mesh->totpoly), 100, [&](IndexRange range) {
-    for (const int poly_index : range) {
-      const MPoly &poly = polys[poly_index];
-      MutableSpan<MLoop> poly_loops = loops.slice(poly.loopstart, poly.totloop);
+  const int64_t size = sorted_keys.size();
+  threading::parallel_for(chunk_offsets.index_range(), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      int64_t i = chunk * chunk_size;
+      const int64_t chunk_end = std::min(i + chunk_size, size);
+      /* Skip the end of an edge that starts in the previous chunk. */
+      while (i < chunk_end && i > 0 && sorted_keys[i] == sorted_keys[i - 1]) {
+        i++;
+      }
+      int new_edge_index = chunk_offsets[chunk];
+      while (i < chunk_end) {
+        const uint64_t key = sorted_keys[i];
+        if (key == invalid_edge_key) {
+          /* This is an invalid edge; normally this does not happen in Blender,
+           * but it can be part of an imported mesh with invalid geometry. See
+           * T76514. */
+          for (; i < size; i++) {
+            loops[sorted_values[i] - existing_edges_num].e = 0;
+          }
+          break;
+        }
 
-      MLoop *prev_loop = &poly_loops.last();
-      for (MLoop &next_loop : poly_loops) {
         int edge_index;
-        if (prev_loop->v != next_loop.v) {
-          OrderedEdge ordered_edge{prev_loop->v, next_loop.v};
-          /* Double lookup: First find the map that contains the edge, then lookup the edge. */
-          const EdgeMap &edge_map = edge_maps[parallel_mask & ordered_edge.hash2()];
-          edge_index = edge_map.lookup(ordered_edge).index;
+        if (sorted_values[i] < existing_edges_num) {
+          edge_index = sorted_values[i];
+          i++;
         }
         else {
-          /* This is an invalid edge; normally this does not happen in Blender,
-           * but it can be part of an imported mesh with invalid geometry. See
-           * T76514. */
-          edge_index = 0;
+          edge_index = new_edge_index++;
+          MEdge &new_edge = new_edges[edge_index];
+          new_edge.v1 = edge_key_v_low(key);
+          new_edge.v2 = edge_key_v_high(key);
+          new_edge.flag = ME_EDGEDRAW | ME_EDGERENDER;
+        }
+        /* The rest of the run may extend into the next chunk. */
+        for (; i < size && sorted_keys[i] == key; i++) {
+          /* Skip duplicates of existing edges, which only exist when the mesh data is invalid. */
+          if (sorted_values[i] >= existing_edges_num) {
+            loops[sorted_values[i] - existing_edges_num].e = uint(edge_index);
+          }
         }
-        prev_loop->e = edge_index;
-        prev_loop = &next_loop;
       }
     }
   });
 }
 
-static int get_parallel_maps_count(const Mesh *mesh)
-{
-  /* Don't use parallelization when the mesh is small. */
-  if (mesh->totpoly < 1000) {
-    return 1;
-  }
-  /* Use at most 8 separate hash tables. Using more threads has diminishing returns. These threads
-   * can better do something more useful instead. */
-  const int system_thread_count = BLI_system_thread_count();
-  return power_of_2_min_i(std::min(8, system_thread_count));
-}
-
-static void clear_hash_tables(MutableSpan<EdgeMap> edge_maps)
-{
-  threading::parallel_for_each(edge_maps, [](EdgeMap &edge_map) { edge_map.clear(); });
-}
-
 }  // namespace blender::bke::calc_edges
 
 void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select_new_edges)
@@ -212,31 +199,26 @@ void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select
   using namespace blender::bke;
   using namespace blender::bke::calc_edges;
 
-  /* Parallelization is achieved by having multiple hash tables for different subsets of edges.
-   * Each edge is assigned to one of the hash maps based on the lower bits of a hash value. */
-  const int parallel_maps = get_parallel_maps_count(mesh);
-  BLI_assert(is_power_of_2_i(parallel_maps));
-  const uint32_t parallel_mask = uint32_t(parallel_maps) - 1;
-  Array<EdgeMap> edge_maps(parallel_maps);
-  reserve_hash_maps(mesh, keep_existing_edges, edge_maps);
+  const int existing_edges_num = keep_existing_edges ? mesh->totedge : 0;
+  const int64_t keys_num = int64_t(existing_edges_num) + mesh->totloop;
 
-  /* Add all edges. */
-  if (keep_existing_edges) {
-    calc_edges::add_existing_edges_to_hash_maps(mesh, edge_maps, parallel_mask);
-  }
-  calc_edges::add_polygon_edges_to_hash_maps(mesh, edge_maps, parallel_mask);
+  Array<uint64_t> keys(keys_num, NoInitialization());
+  Array<int> values(keys_num, NoInitialization());
+  create_edge_keys(*mesh, existing_edges_num, keys, values);
+  parallel_radix_sort<uint64_t, int>(keys, values);
 
-  /* Compute total number of edges. */
-  int new_totedge = 0;
-  for (EdgeMap &edge_map : edge_maps) {
-    new_totedge += edge_map.size();
-  }
+  const int64_t chunks_num = (keys_num + chunk_size - 1) / chunk_size;
+  Array<int> chunk_offsets(chunks_num);
+  const int new_edges_num = count_new_edges_per_chunk(
+      keys, values, existing_edges_num, chunk_offsets);
+  const int new_totedge = existing_edges_num + new_edges_num;
 
-  /* Create new edges. */
+  /* Create new edges, the existing edges that are kept stay at the start in the same order. */
   MutableSpan<MEdge> new_edges{
       static_cast<MEdge *>(MEM_calloc_arrayN(new_totedge, sizeof(MEdge), __func__)), new_totedge};
-  calc_edges::serialize_and_initialize_deduplicated_edges(edge_maps, new_edges);
-  calc_edges::update_edge_indices_in_poly_loops(mesh, edge_maps, parallel_mask);
+  new_edges.take_front(existing_edges_num).copy_from(mesh->edges().take_front(existing_edges_num));
+  scatter_edge_indices(
+      keys, values, existing_edges_num, chunk_offsets, new_edges, mesh->loops_for_write());
 
   /* Free old CustomData and assign new one. */
   CustomData_free(&mesh->edata, mesh->totedge);
@@ -249,19 +231,8 @@ void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select
     SpanAttributeWriter<bool> select_edge = attributes.lookup_or_add_for_write_span<bool>(
         ".select_edge", ATTR_DOMAIN_EDGE);
     if (select_edge) {
-      int new_edge_index = 0;
-      for (const EdgeMap &edge_map : edge_maps) {
-        for (EdgeMap::Item item : edge_map.items()) {
-          if (item.value.original_edge == nullptr) {
-            select_edge.span[new_edge_index] = true;
-          }
-          new_edge_index++;
-        }
-      }
+      select_edge.span.drop_front(existing_edges_num).fill(true);
       select_edge.finish();
     }
   }
-
-  /* Explicitly clear edge maps, because that way it can be parallelized. */
-  clear_hash_tables(edge_maps);
 }
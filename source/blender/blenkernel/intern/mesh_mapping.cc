@@ -7,8 +7,12 @@
  * eg: polys connected to verts, UV's connected to verts.
  */
 
+#include <atomic>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
+#include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_vec_types.h"
 
@@ -588,6 +592,234 @@ Array<Vector<int>> build_vert_to_corner_map(const Span<MLoop> loops, const int v
 
 }  // namespace blender::mesh_topology
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Topology Cache
+ * \{ */
+
+struct MeshTopologyCache {
+  struct Map {
+    /** Set after the arrays have been computed, checked without locking the mutex. */
+    std::atomic<bool> is_cached = false;
+    /** Size of the mesh domains when the map was computed, to detect outdated maps. */
+    int64_t elements_num = 0;
+    int64_t indices_num = 0;
+    blender::Array<int> offsets;
+    blender::Array<int> indices;
+  };
+
+  std::mutex mutex;
+  Map corner_to_poly;
+  Map vert_to_corner;
+  Map vert_to_poly;
+  Map vert_to_edge;
+  Map edge_to_poly;
+};
+
+MeshTopologyCache *BKE_mesh_topology_cache_new()
+{
+  return MEM_new<MeshTopologyCache>(__func__);
+}
+
+void BKE_mesh_topology_cache_free(MeshTopologyCache *cache)
+{
+  MEM_delete(cache);
+}
+
+void BKE_mesh_topology_cache_clear(MeshTopologyCache *cache)
+{
+  if (cache == nullptr) {
+    return;
+  }
+  for (MeshTopologyCache::Map *map : {&cache->corner_to_poly,
+                                      &cache->vert_to_corner,
+                                      &cache->vert_to_poly,
+                                      &cache->vert_to_edge,
+                                      &cache->edge_to_poly}) {
+    map->is_cached = false;
+    map->offsets = {};
+    map->indices = {};
+  }
+}
+
+namespace blender::mesh_topology {
+
+/**
+ * Compute the map if it has not been cached yet or if the size of the mesh changed since then.
+ * The map is only computed once when it is requested from multiple threads at the same time.
+ */
+template<typename ComputeFn>
+static const MeshTopologyCache::Map &ensure_cached_map(const Mesh &mesh,
+                                                       MeshTopologyCache::Map &map,
+                                                       const int64_t elements_num,
+                                                       const int64_t indices_num,
+                                                       const ComputeFn &compute_fn)
+{
+  const auto is_up_to_date = [&]() {
+    return map.is_cached.load(std::memory_order_acquire) && map.elements_num == elements_num &&
+           map.indices_num == indices_num;
+  };
+  if (is_up_to_date()) {
+    return map;
+  }
+  std::lock_guard lock{mesh.runtime.topology_cache->mutex};
+  if (is_up_to_date()) {
+    return map;
+  }
+  /* Isolate task because a mutex is locked and computing the map may be multi-threaded. */
+  threading::isolate_task([&]() { compute_fn(map.offsets, map.indices); });
+  map.elements_num = elements_num;
+  map.indices_num = indices_num;
+  map.is_cached.store(true, std::memory_order_release);
+  return map;
+}
+
+/**
+ * Build grouped indices with a counting sort. The callback is called twice with a function that
+ * has to be called with a group and an index for every element of every group. Since the indices
+ * are added in the order they are passed, they are sorted if the callback iterates in order.
+ */
+template<typename ForeachFn>
+static void build_grouped_indices(const int groups_num,
+                                  const int64_t indices_num,
+                                  const ForeachFn &foreach_fn,
+                                  Array<int> &r_offsets,
+                                  Array<int> &r_indices)
+{
+  r_offsets.reinitialize(groups_num + 1);
+  r_offsets.fill(0);
+  foreach_fn([&](const int group, const int /*index*/) { r_offsets[group]++; });
+  int offset = 0;
+  for (const int64_t group : IndexRange(groups_num)) {
+    const int count = r_offsets[group];
+    r_offsets[group] = offset;
+    offset += count;
+  }
+  r_offsets[groups_num] = offset;
+  BLI_assert(offset == indices_num);
+
+  Array<int> fill_offsets(r_offsets.as_span().drop_back(1));
+  r_indices.reinitialize(indices_num);
+  foreach_fn([&](const int group, const int index) { r_indices[fill_offsets[group]++] = index; });
+}
+
+Span<int> corner_to_poly_map(const Mesh &mesh)
+{
+  const MeshTopologyCache::Map &map = ensure_cached_map(
+      mesh,
+      mesh.runtime.topology_cache->corner_to_poly,
+      mesh.totpoly,
+      mesh.totloop,
+      [&](Array<int> & /*r_offsets*/, Array<int> &r_indices) {
+        r_indices = build_corner_to_poly_map(mesh.polys(), mesh.totloop);
+      });
+  return map.indices;
+}
+
+GroupedIndices vert_to_corner_map(const Mesh &mesh)
+{
+  const MeshTopologyCache::Map &map = ensure_cached_map(
+      mesh,
+      mesh.runtime.topology_cache->vert_to_corner,
+      mesh.totvert,
+      mesh.totloop,
+      [&](Array<int> &r_offsets, Array<int> &r_indices) {
+        const Span<MLoop> loops = mesh.loops();
+        build_grouped_indices(
+            mesh.totvert,
+            loops.size(),
+            [&](const auto &add_fn) {
+              for (const int64_t corner : loops.index_range()) {
+                add_fn(int(loops[corner].v), int(corner));
+              }
+            },
+            r_offsets,
+            r_indices);
+      });
+  return {map.offsets, map.indices};
+}
+
+GroupedIndices vert_to_poly_map(const Mesh &mesh)
+{
+  const MeshTopologyCache::Map &map = ensure_cached_map(
+      mesh,
+      mesh.runtime.topology_cache->vert_to_poly,
+      mesh.totvert,
+      mesh.totloop,
+      [&](Array<int> &r_offsets, Array<int> &r_indices) {
+        const Span<MPoly> polys = mesh.polys();
+        const Span<MLoop> loops = mesh.loops();
+        build_grouped_indices(
+            mesh.totvert,
+            loops.size(),
+            [&](const auto &add_fn) {
+              for (const int64_t poly_i : polys.index_range()) {
+                const MPoly &poly = polys[poly_i];
+                for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+                  add_fn(int(loop.v), int(poly_i));
+                }
+              }
+            },
+            r_offsets,
+            r_indices);
+      });
+  return {map.offsets, map.indices};
+}
+
+GroupedIndices vert_to_edge_map(const Mesh &mesh)
+{
+  const MeshTopologyCache::Map &map = ensure_cached_map(
+      mesh,
+      mesh.runtime.topology_cache->vert_to_edge,
+      mesh.totvert,
+      int64_t(mesh.totedge) * 2,
+      [&](Array<int> &r_offsets, Array<int> &r_indices) {
+        const Span<MEdge> edges = mesh.edges();
+        build_grouped_indices(
+            mesh.totvert,
+            edges.size() * 2,
+            [&](const auto &add_fn) {
+              for (const int64_t edge_i : edges.index_range()) {
+                add_fn(int(edges[edge_i].v1), int(edge_i));
+                add_fn(int(edges[edge_i].v2), int(edge_i));
+              }
+            },
+            r_offsets,
+            r_indices);
+      });
+  return {map.offsets, map.indices};
+}
+
+GroupedIndices edge_to_poly_map(const Mesh &mesh)
+{
+  const MeshTopologyCache::Map &map = ensure_cached_map(
+      mesh,
+      mesh.runtime.topology_cache->edge_to_poly,
+      mesh.totedge,
+      mesh.totloop,
+      [&](Array<int> &r_offsets, Array<int> &r_indices) {
+        const Span<MPoly> polys = mesh.polys();
+        const Span<MLoop> loops = mesh.loops();
+        build_grouped_indices(
+            mesh.totedge,
+            loops.size(),
+            [&](const auto &add_fn) {
+              for (const int64_t poly_i : polys.index_range()) {
+                const MPoly &poly = polys[poly_i];
+                for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+                  add_fn(int(loop.e), int(poly_i));
+                }
+              }
+            },
+            r_offsets,
+            r_indices);
+      });
+  return {map.offsets, map.indices};
+}
+
+}  // namespace blender::mesh_topology
+
+/** \} */
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
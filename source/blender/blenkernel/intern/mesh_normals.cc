@@ -9,6 +9,7 @@
  * \see bmesh_mesh_normals.c for the equivalent #BMesh functionality.
  */
 
+#include <atomic>
 #include <climits>
 
 #include "MEM_guardedalloc.h"
@@ -33,12 +34,16 @@
 #include "BKE_editmesh_cache.h"
 #include "BKE_global.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 
 #include "atomic_ops.h"
 
 using blender::BitVector;
+using blender::float3;
+using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
+using blender::mesh_topology::GroupedIndices;
 
 // #define DEBUG_TIME
 
@@ -340,6 +345,97 @@ void BKE_mesh_calc_normals_poly_and_vertex(const MVert *mvert,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Normal Calculation (Vertices, Gathered)
+ *
+ * Instead of adding the weighted normal of every polygon to its vertices, which requires atomic
+ * operations, every vertex gathers the normals of the polygons around it. This uses a map from
+ * vertices to face corners that only depends on the topology, so it is taken from the topology
+ * cache of the mesh.
+ * Because the corners of a vertex are always added in the same order, the result does not
+ * depend on the number of threads.
+ * \{ */
+
+static void mesh_calc_normals_poly_newell(const Span<MVert> verts,
+                                          const Span<MPoly> polys,
+                                          const Span<MLoop> loops,
+                                          MutableSpan<float3> r_poly_normals)
+{
+  blender::threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int poly_i : range) {
+      const MPoly &poly = polys[poly_i];
+      const Span<MLoop> poly_loops = loops.slice(poly.loopstart, poly.totloop);
+      /* Same as in #mesh_calc_normals_poly_and_vertex_accum_fn. */
+      float3 &pnor = r_poly_normals[poly_i];
+      pnor = float3(0.0f);
+      const float *v_curr = verts[poly_loops.last().v].co;
+      for (const MLoop &loop : poly_loops) {
+        const float *v_next = verts[loop.v].co;
+        add_newell_cross_v3_v3v3(pnor, v_curr, v_next);
+        v_curr = v_next;
+      }
+      if (UNLIKELY(normalize_v3(pnor) == 0.0f)) {
+        pnor[2] = 1.0f; /* Other axes set to zero. */
+      }
+    }
+  });
+}
+
+/**
+ * \return False if the maps do not match the topology of the mesh, which happens when the
+ * topology cache has not been cleared after changing the topology. In that case the vertex
+ * normals are not valid.
+ */
+static bool mesh_calc_normals_vert_gather(const GroupedIndices vert_to_corner,
+                                          const Span<int> corner_to_poly,
+                                          const Span<MVert> verts,
+                                          const Span<MPoly> polys,
+                                          const Span<MLoop> loops,
+                                          const Span<float3> poly_normals,
+                                          MutableSpan<float3> r_vert_normals)
+{
+  if (vert_to_corner.size() != verts.size() || corner_to_poly.size() != loops.size()) {
+    return false;
+  }
+
+  std::atomic<bool> map_is_valid = true;
+  blender::threading::parallel_for(verts.index_range(), 1024, [&](const IndexRange range) {
+    for (const int vert_i : range) {
+      const float3 co = verts[vert_i].co;
+      float3 vnor(0.0f);
+      for (const int corner : vert_to_corner[vert_i]) {
+        const int poly_i = corner_to_poly[corner];
+        const MPoly &poly = polys[poly_i];
+        const int poly_end = poly.loopstart + poly.totloop;
+        if (UNLIKELY(loops[corner].v != vert_i || corner < poly.loopstart || corner >= poly_end)) {
+          map_is_valid.store(false, std::memory_order_relaxed);
+          return;
+        }
+        const int corner_prev = (corner == poly.loopstart) ? poly_end - 1 : corner - 1;
+        const int corner_next = (corner == poly_end - 1) ? poly.loopstart : corner + 1;
+
+        float3 edvec_prev = float3(verts[loops[corner_prev].v].co) - co;
+        float3 edvec_next = float3(verts[loops[corner_next].v].co) - co;
+        normalize_v3(edvec_prev);
+        normalize_v3(edvec_next);
+
+        /* Weight the polygon normal by the angle between the two edges incident on the vertex. */
+        const float fac = saacos(dot_v3v3(edvec_prev, edvec_next));
+        madd_v3_v3fl(vnor, poly_normals[poly_i], fac);
+      }
+
+      if (UNLIKELY(normalize_v3(vnor) == 0.0f)) {
+        /* Following Mesh convention; we use vertex coordinate itself for normal in this case. */
+        normalize_v3_v3(vnor, co);
+      }
+      r_vert_normals[vert_i] = vnor;
+    }
+  });
+  return map_is_valid;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Normal Calculation
  * \{ */
@@ -375,15 +471,31 @@ const float (*BKE_mesh_vertex_normals_ensure(const Mesh *mesh))[3]
 
     vert_normals = BKE_mesh_vertex_normals_for_write(&mesh_mutable);
     poly_normals = BKE_mesh_poly_normals_for_write(&mesh_mutable);
-
-    BKE_mesh_calc_normals_poly_and_vertex(verts.data(),
-                                          verts.size(),
-                                          loops.data(),
-                                          loops.size(),
-                                          polys.data(),
-                                          polys.size(),
-                                          poly_normals,
-                                          vert_normals);
+    const MutableSpan<float3> vert_normals_span(reinterpret_cast<float3 *>(vert_normals),
+                                                verts.size());
+    const MutableSpan<float3> poly_normals_span(reinterpret_cast<float3 *>(poly_normals),
+                                                polys.size());
+
+    mesh_calc_normals_poly_newell(verts, polys, loops, poly_normals_span);
+
+    if (!mesh_calc_normals_vert_gather(blender::mesh_topology::vert_to_corner_map(*mesh),
+                                       blender::mesh_topology::corner_to_poly_map(*mesh),
+                                       verts,
+                                       polys,
+                                       loops,
+                                       poly_normals_span,
+                                       vert_normals_span)) {
+      /* The topology changed without clearing the cache, e.g. when the winding order of faces was
+       * changed in place. Fall back to accumulating the normals of every face. */
+      BKE_mesh_calc_normals_poly_and_vertex(BKE_mesh_verts(mesh),
+                                            mesh->totvert,
+                                            BKE_mesh_loops(mesh),
+                                            mesh->totloop,
+                                            BKE_mesh_polys(mesh),
+                                            mesh->totpoly,
+                                            poly_normals,
+                                            vert_normals);
+    }
 
     BKE_mesh_vertex_normals_clear_dirty(&mesh_mutable);
     BKE_mesh_poly_normals_clear_dirty(&mesh_mutable);
@@ -19,6 +19,7 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
@@ -67,15 +68,25 @@ static void mesh_runtime_free_mutexes(Mesh *mesh)
   }
 }
 
+uint32_t BKE_mesh_runtime_data_version_new()
+{
+  static uint32_t data_version = 0;
+  return atomic_add_and_fetch_uint32(&data_version, 1);
+}
+
 void BKE_mesh_runtime_init_data(Mesh *mesh)
 {
   mesh_runtime_init_mutexes(mesh);
+  mesh->runtime.data_version = BKE_mesh_runtime_data_version_new();
+  mesh->runtime.topology_cache = BKE_mesh_topology_cache_new();
 }
 
 void BKE_mesh_runtime_free_data(Mesh *mesh)
 {
   BKE_mesh_runtime_clear_cache(mesh);
   mesh_runtime_free_mutexes(mesh);
+  BKE_mesh_topology_cache_free(mesh->runtime.topology_cache);
+  mesh->runtime.topology_cache = nullptr;
 }
 
 void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
@@ -91,12 +102,16 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   runtime->shrinkwrap_data = nullptr;
   runtime->subsurf_face_dot_tags = nullptr;
 
+  runtime->looptris_positions_dirty = false;
   runtime->vert_normals_dirty = true;
   runtime->poly_normals_dirty = true;
   runtime->vert_normals = nullptr;
   runtime->poly_normals = nullptr;
+  runtime->data_version = BKE_mesh_runtime_data_version_new();
 
   mesh_runtime_init_mutexes(mesh);
+  /* The topology cache is not shared, the copy may be modified independently. */
+  runtime->topology_cache = BKE_mesh_topology_cache_new();
 }
 
 void BKE_mesh_runtime_clear_cache(Mesh *mesh)
@@ -184,6 +199,28 @@ void BKE_mesh_runtime_looptri_recalc(Mesh *mesh)
                  mesh->runtime.looptris.array,
                  mesh->runtime.looptris.array_wip);
   mesh->runtime.looptris.array_wip = nullptr;
+  mesh->runtime.looptris_positions_dirty = false;
+}
+
+/**
+ * Update the triangles of quads and n-gons in place after the positions changed, which avoids
+ * reallocating the array and recalculating the triangles of triangles.
+ */
+static void mesh_looptri_update_positions(Mesh *mesh)
+{
+  const Span<MVert> verts = mesh->verts();
+  const Span<MPoly> polys = mesh->polys();
+  const Span<MLoop> loops = mesh->loops();
+  BKE_mesh_update_looptri_positions(loops.data(),
+                                    polys.data(),
+                                    verts.data(),
+                                    mesh->totloop,
+                                    mesh->totpoly,
+                                    mesh->runtime.looptris.array,
+                                    BKE_mesh_poly_normals_are_dirty(mesh) ?
+                                        nullptr :
+                                        BKE_mesh_poly_normals_ensure(mesh));
+  mesh->runtime.looptris_positions_dirty = false;
 }
 
 int BKE_mesh_runtime_looptri_len(const Mesh *mesh)
@@ -201,6 +238,19 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(const Mesh *mesh)
 
   MLoopTri *looptri = mesh->runtime.looptris.array;
 
+  if (looptri != nullptr && mesh->runtime.looptris_positions_dirty) {
+    if (mesh->runtime.looptris.len == poly_to_tri_count(mesh->totpoly, mesh->totloop)) {
+      /* Must isolate multithreaded tasks while holding a mutex lock. */
+      blender::threading::isolate_task(
+          [&]() { mesh_looptri_update_positions(const_cast<Mesh *>(mesh)); });
+    }
+    else {
+      /* The topology changed without clearing the geometry data, recalculate everything. */
+      MEM_SAFE_FREE(const_cast<Mesh *>(mesh)->runtime.looptris.array);
+      looptri = nullptr;
+    }
+  }
+
   if (looptri != nullptr) {
     BLI_assert(BKE_mesh_runtime_looptri_len(mesh) == mesh->runtime.looptris.len);
   }
@@ -268,6 +318,15 @@ bool BKE_mesh_runtime_clear_edit_data(Mesh *mesh)
 
 void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
 {
+  /* The cached trees can't be refit when the topology changed. */
+  if (mesh->runtime.bvh_cache) {
+    bvhcache_free(mesh->runtime.bvh_cache);
+    mesh->runtime.bvh_cache = nullptr;
+  }
+  BKE_mesh_topology_cache_clear(mesh->runtime.topology_cache);
+  MEM_SAFE_FREE(mesh->runtime.looptris.array);
+  mesh->runtime.looptris_positions_dirty = false;
+  mesh->runtime.data_version = BKE_mesh_runtime_data_version_new();
   BKE_mesh_tag_coords_changed(mesh);
 
   /* TODO(sergey): Does this really belong here? */
@@ -283,10 +342,12 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
 void BKE_mesh_tag_coords_changed(Mesh *mesh)
 {
   BKE_mesh_normals_tag_dirty(mesh);
-  MEM_SAFE_FREE(mesh->runtime.looptris.array);
+  /* The topology is unchanged, so the triangles can be updated in place. */
+  if (mesh->runtime.looptris.array != nullptr) {
+    mesh->runtime.looptris_positions_dirty = true;
+  }
   if (mesh->runtime.bvh_cache) {
-    bvhcache_free(mesh->runtime.bvh_cache);
-    mesh->runtime.bvh_cache = nullptr;
+    bvhcache_tag_positions_changed(mesh->runtime.bvh_cache);
   }
 }
 
@@ -20,7 +20,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
-#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
@@ -30,6 +30,10 @@
 
 /** Compared against total loops. */
 #define MESH_FACE_TESSELLATE_THREADED_LIMIT 4096
+/** Number of polygons that are tessellated together, with a single memory arena. */
+#define MESH_FACE_TESSELLATE_CHUNK_SIZE 1024
+
+using blender::IndexRange;
 
 /* -------------------------------------------------------------------- */
 /** \name Loop Tessellation
@@ -173,137 +177,140 @@ static void mesh_calc_tessellation_for_face_with_normal(const MLoop *mloop,
       mloop, mpoly, mvert, poly_index, mlt, pf_arena_p, true, normal_precalc);
 }
 
-static void mesh_recalc_looptri__single_threaded(const MLoop *mloop,
-                                                 const MPoly *mpoly,
-                                                 const MVert *mvert,
-                                                 int totloop,
-                                                 int totpoly,
-                                                 MLoopTri *mlooptri,
-                                                 const float (*poly_normals)[3])
+/**
+ * Fast path for chunks that only contain quads, which are very common. The indices of all
+ * triangles are written first in a simple loop that the compiler can vectorize, the triangles of
+ * quads whose diagonal would be degenerate are flipped afterwards.
+ *
+ * \param chunk_looptris: The triangles of the first polygon in the chunk.
+ */
+static void mesh_calc_tessellation_for_quads(const MLoop *mloop,
+                                             const MPoly *mpoly,
+                                             const MVert *mvert,
+                                             const IndexRange polys_range,
+                                             MLoopTri *chunk_looptris,
+                                             const float (*poly_normals)[3])
+{
+  for (const int64_t i : IndexRange(polys_range.size())) {
+    const uint poly_index = uint(polys_range[i]);
+    const uint mp_loopstart = uint(mpoly[poly_index].loopstart);
+    MLoopTri *mlt = &chunk_looptris[i * 2];
+    ARRAY_SET_ITEMS(mlt[0].tri, mp_loopstart, mp_loopstart + 1, mp_loopstart + 2);
+    ARRAY_SET_ITEMS(mlt[1].tri, mp_loopstart, mp_loopstart + 2, mp_loopstart + 3);
+    mlt[0].poly = poly_index;
+    mlt[1].poly = poly_index;
+  }
+  for (const int64_t i : IndexRange(polys_range.size())) {
+    const int64_t poly_index = polys_range[i];
+    const MLoop *ml = &mloop[mpoly[poly_index].loopstart];
+    const float *co_0 = mvert[ml[0].v].co;
+    const float *co_1 = mvert[ml[1].v].co;
+    const float *co_2 = mvert[ml[2].v].co;
+    const float *co_3 = mvert[ml[3].v].co;
+    if (UNLIKELY(poly_normals ? is_quad_flip_v3_first_third_fast_with_normal(
+                                    co_0, co_1, co_2, co_3, poly_normals[poly_index]) :
+                                is_quad_flip_v3_first_third_fast(co_0, co_1, co_2, co_3))) {
+      /* Flip out of degenerate 0-2 state, see #mesh_calc_tessellation_for_face_impl. */
+      MLoopTri *mlt = &chunk_looptris[i * 2];
+      mlt[0].tri[2] = mlt[1].tri[2];
+      mlt[1].tri[0] = mlt[0].tri[1];
+    }
+  }
+}
+
+/**
+ * \param skip_tris: Only calculate the triangles of quads and n-gons, used when only the vertex
+ * positions changed, since the triangulation of triangles doesn't depend on them.
+ */
+static void mesh_calc_tessellation_for_chunk(const MLoop *mloop,
+                                             const MPoly *mpoly,
+                                             const MVert *mvert,
+                                             const IndexRange polys_range,
+                                             MLoopTri *mlooptri,
+                                             const float (*poly_normals)[3],
+                                             const bool skip_tris,
+                                             MemArena **pf_arena_p)
 {
-  MemArena *pf_arena = nullptr;
-  const MPoly *mp = mpoly;
-  uint tri_index = 0;
+  const int first_poly = int(polys_range.first());
+  const int last_poly = int(polys_range.last());
+  const int chunk_loops_num = mpoly[last_poly].loopstart + mpoly[last_poly].totloop -
+                              mpoly[first_poly].loopstart;
+  if (chunk_loops_num == int(polys_range.size()) * 4) {
+    bool only_quads = true;
+    for (const int64_t poly_index : polys_range) {
+      if (mpoly[poly_index].totloop != 4) {
+        only_quads = false;
+        break;
+      }
+    }
+    if (only_quads) {
+      const int tri_index = poly_to_tri_count(first_poly, mpoly[first_poly].loopstart);
+      mesh_calc_tessellation_for_quads(
+          mloop, mpoly, mvert, polys_range, &mlooptri[tri_index], poly_normals);
+      return;
+    }
+  }
 
-  if (poly_normals != nullptr) {
-    for (uint poly_index = 0; poly_index < uint(totpoly); poly_index++, mp++) {
+  for (const int64_t poly_index : polys_range) {
+    const MPoly &mp = mpoly[poly_index];
+    if (skip_tris && mp.totloop == 3) {
+      continue;
+    }
+    const int tri_index = poly_to_tri_count(int(poly_index), mp.loopstart);
+    if (poly_normals != nullptr) {
       mesh_calc_tessellation_for_face_with_normal(mloop,
                                                   mpoly,
                                                   mvert,
-                                                  poly_index,
+                                                  uint(poly_index),
                                                   &mlooptri[tri_index],
-                                                  &pf_arena,
+                                                  pf_arena_p,
                                                   poly_normals[poly_index]);
-      tri_index += uint(mp->totloop - 2);
     }
-  }
-  else {
-    for (uint poly_index = 0; poly_index < uint(totpoly); poly_index++, mp++) {
+    else {
       mesh_calc_tessellation_for_face(
-          mloop, mpoly, mvert, poly_index, &mlooptri[tri_index], &pf_arena);
-      tri_index += uint(mp->totloop - 2);
+          mloop, mpoly, mvert, uint(poly_index), &mlooptri[tri_index], pf_arena_p);
     }
   }
-
-  if (pf_arena) {
-    BLI_memarena_free(pf_arena);
-    pf_arena = nullptr;
-  }
-  BLI_assert(tri_index == uint(poly_to_tri_count(totpoly, totloop)));
-  UNUSED_VARS_NDEBUG(totloop);
-}
-
-struct TessellationUserData {
-  const MLoop *mloop;
-  const MPoly *mpoly;
-  const MVert *mvert;
-
-  /** Output array. */
-  MLoopTri *mlooptri;
-
-  /** Optional pre-calculated polygon normals array. */
-  const float (*poly_normals)[3];
-};
-
-struct TessellationUserTLS {
-  MemArena *pf_arena;
-};
-
-static void mesh_calc_tessellation_for_face_fn(void *__restrict userdata,
-                                               const int index,
-                                               const TaskParallelTLS *__restrict tls)
-{
-  const TessellationUserData *data = static_cast<const TessellationUserData *>(userdata);
-  TessellationUserTLS *tls_data = static_cast<TessellationUserTLS *>(tls->userdata_chunk);
-  const int tri_index = poly_to_tri_count(index, data->mpoly[index].loopstart);
-  mesh_calc_tessellation_for_face_impl(data->mloop,
-                                       data->mpoly,
-                                       data->mvert,
-                                       uint(index),
-                                       &data->mlooptri[tri_index],
-                                       &tls_data->pf_arena,
-                                       false,
-                                       nullptr);
 }
 
-static void mesh_calc_tessellation_for_face_with_normal_fn(void *__restrict userdata,
-                                                           const int index,
-                                                           const TaskParallelTLS *__restrict tls)
+/**
+ * Polygons are tessellated in chunks of at most #MESH_FACE_TESSELLATE_CHUNK_SIZE, which are
+ * processed in parallel for larger meshes. Every chunk can be processed independently, because
+ * the first triangle of every polygon can be found from its first corner.
+ */
+static void mesh_recalc_looptri__chunked(const MLoop *mloop,
+                                         const MPoly *mpoly,
+                                         const MVert *mvert,
+                                         int totloop,
+                                         int totpoly,
+                                         MLoopTri *mlooptri,
+                                         const float (*poly_normals)[3],
+                                         const bool skip_tris)
 {
-  const TessellationUserData *data = static_cast<const TessellationUserData *>(userdata);
-  TessellationUserTLS *tls_data = static_cast<TessellationUserTLS *>(tls->userdata_chunk);
-  const int tri_index = poly_to_tri_count(index, data->mpoly[index].loopstart);
-  mesh_calc_tessellation_for_face_impl(data->mloop,
-                                       data->mpoly,
-                                       data->mvert,
-                                       uint(index),
-                                       &data->mlooptri[tri_index],
-                                       &tls_data->pf_arena,
-                                       true,
-                                       data->poly_normals[index]);
-}
+  const auto calc_range = [&](const IndexRange range) {
+    MemArena *pf_arena = nullptr;
+    for (int64_t chunk_start = range.start(); chunk_start < range.one_after_last();
+         chunk_start += MESH_FACE_TESSELLATE_CHUNK_SIZE) {
+      const IndexRange chunk = IndexRange(chunk_start, MESH_FACE_TESSELLATE_CHUNK_SIZE)
+                                   .intersect(range);
+      mesh_calc_tessellation_for_chunk(
+          mloop, mpoly, mvert, chunk, mlooptri, poly_normals, skip_tris, &pf_arena);
+    }
+    if (pf_arena) {
+      BLI_memarena_free(pf_arena);
+    }
+  };
 
-static void mesh_calc_tessellation_for_face_free_fn(const void *__restrict UNUSED(userdata),
-                                                    void *__restrict tls_v)
-{
-  TessellationUserTLS *tls_data = static_cast<TessellationUserTLS *>(tls_v);
-  if (tls_data->pf_arena) {
-    BLI_memarena_free(tls_data->pf_arena);
+  if (totpoly == 0) {
+    return;
+  }
+  if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
+    calc_range(IndexRange(totpoly));
+  }
+  else {
+    blender::threading::parallel_for(
+        IndexRange(totpoly), MESH_FACE_TESSELLATE_CHUNK_SIZE, calc_range);
   }
-}
-
-static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
-                                                const MPoly *mpoly,
-                                                const MVert *mvert,
-                                                int UNUSED(totloop),
-                                                int totpoly,
-                                                MLoopTri *mlooptri,
-                                                const float (*poly_normals)[3])
-{
-  struct TessellationUserTLS tls_data_dummy = {nullptr};
-
-  struct TessellationUserData data {
-  };
-  data.mloop = mloop;
-  data.mpoly = mpoly;
-  data.mvert = mvert;
-  data.mlooptri = mlooptri;
-  data.poly_normals = poly_normals;
-
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-
-  settings.userdata_chunk = &tls_data_dummy;
-  settings.userdata_chunk_size = sizeof(tls_data_dummy);
-
-  settings.func_free = mesh_calc_tessellation_for_face_free_fn;
-
-  BLI_task_parallel_range(0,
-                          totpoly,
-                          &data,
-                          poly_normals ? mesh_calc_tessellation_for_face_with_normal_fn :
-                                         mesh_calc_tessellation_for_face_fn,
-                          &settings);
 }
 
 void BKE_mesh_recalc_looptri(const MLoop *mloop,
@@ -313,12 +320,7 @@ void BKE_mesh_recalc_looptri(const MLoop *mloop,
                              int totpoly,
                              MLoopTri *mlooptri)
 {
-  if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
-    mesh_recalc_looptri__single_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri, nullptr);
-  }
-  else {
-    mesh_recalc_looptri__multi_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri, nullptr);
-  }
+  mesh_recalc_looptri__chunked(mloop, mpoly, mvert, totloop, totpoly, mlooptri, nullptr, false);
 }
 
 void BKE_mesh_recalc_looptri_with_normals(const MLoop *mloop,
@@ -330,14 +332,20 @@ void BKE_mesh_recalc_looptri_with_normals(const MLoop *mloop,
                                           const float (*poly_normals)[3])
 {
   BLI_assert(poly_normals != nullptr);
-  if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
-    mesh_recalc_looptri__single_threaded(
-        mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals);
-  }
-  else {
-    mesh_recalc_looptri__multi_threaded(
-        mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals);
-  }
+  mesh_recalc_looptri__chunked(
+      mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals, false);
+}
+
+void BKE_mesh_update_looptri_positions(const MLoop *mloop,
+                                       const MPoly *mpoly,
+                                       const MVert *mvert,
+                                       int totloop,
+                                       int totpoly,
+                                       MLoopTri *mlooptri,
+                                       const float (*poly_normals)[3])
+{
+  mesh_recalc_looptri__chunked(
+      mloop, mpoly, mvert, totloop, totpoly, mlooptri, poly_normals, true);
 }
 
 /** \} */
@@ -5,6 +5,7 @@
  * \ingroup bke
  */
 
+#include <atomic>
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
@@ -19,10 +20,14 @@
 
 #include "BLI_sys_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_edgehash.h"
 #include "BLI_math_base.h"
 #include "BLI_math_vector.h"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.h"
@@ -186,6 +191,308 @@ static int search_polyloop_cmp(const void *v1, const void *v2)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Parallel Validity Check
+ *
+ * Most meshes that are validated don't have any problems. This checks all the conditions that
+ * #mesh_validate_and_fix_arrays tests without modifying anything or printing messages, but
+ * processes the elements in parallel chunks. Only when it finds a problem, the serial code is
+ * needed to report and fix it.
+ * \{ */
+
+namespace blender::bke::mesh_validate {
+
+/** Return true if the function is true for all indices in the range. */
+template<typename Fn>
+static bool parallel_all_of(const IndexRange range, const int64_t grain_size, const Fn &fn)
+{
+  std::atomic<bool> is_valid = true;
+  threading::parallel_for(range, grain_size, [&](const IndexRange sub_range) {
+    if (!is_valid.load(std::memory_order_relaxed)) {
+      return;
+    }
+    for (const int64_t i : sub_range) {
+      if (!fn(i)) {
+        is_valid.store(false, std::memory_order_relaxed);
+        return;
+      }
+    }
+  });
+  return is_valid;
+}
+
+static uint64_t edge_key(const uint v1, const uint v2)
+{
+  return (uint64_t(std::min(v1, v2)) << 32) | uint64_t(std::max(v1, v2));
+}
+
+/** Check that no key is contained twice in the sorted keys. */
+static bool sorted_keys_are_unique(const Span<uint64_t> sorted_keys)
+{
+  return parallel_all_of(sorted_keys.index_range().drop_front(1), 4096, [&](const int64_t i) {
+    return sorted_keys[i] != sorted_keys[i - 1];
+  });
+}
+
+static bool verts_are_valid(const Span<MVert> verts, const float (*vert_normals)[3])
+{
+  return parallel_all_of(verts.index_range(), 2048, [&](const int64_t i) {
+    const float *co = verts[i].co;
+    if (!(isfinite(co[0]) && isfinite(co[1]) && isfinite(co[2]))) {
+      return false;
+    }
+    /* See the zero normal check in #mesh_validate_and_fix_arrays. */
+    return !(vert_normals && is_zero_v3(vert_normals[i]) && !is_zero_v3(co));
+  });
+}
+
+static bool edges_are_valid(const Span<MEdge> edges, const uint totvert)
+{
+  const bool edges_have_valid_verts = parallel_all_of(
+      edges.index_range(), 4096, [&](const int64_t i) {
+        const MEdge &edge = edges[i];
+        return edge.v1 != edge.v2 && edge.v1 < totvert && edge.v2 < totvert;
+      });
+  if (!edges_have_valid_verts) {
+    return false;
+  }
+  Array<uint64_t> keys(edges.size(), NoInitialization());
+  threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      keys[i] = edge_key(edges[i].v1, edges[i].v2);
+    }
+  });
+  parallel_radix_sort(keys.as_mutable_span());
+  return sorted_keys_are_unique(keys);
+}
+
+/**
+ * Check that the polygons use all loops exactly once. The serial code allows polygons to be in
+ * a different order than their loops, but that is rare enough to be handled by it alone.
+ */
+static bool poly_loop_ranges_are_valid(const Span<MPoly> polys, const uint totloop)
+{
+  if (polys.is_empty()) {
+    return totloop == 0;
+  }
+  if (polys.first().loopstart != 0 ||
+      int64_t(polys.last().loopstart) + polys.last().totloop != int64_t(totloop)) {
+    return false;
+  }
+  return parallel_all_of(polys.index_range(), 4096, [&](const int64_t i) {
+    const MPoly &poly = polys[i];
+    if (poly.totloop < 3) {
+      return false;
+    }
+    return i == 0 || polys[i - 1].loopstart + polys[i - 1].totloop == poly.loopstart;
+  });
+}
+
+/** Order independent hash of the vertices of a polygon, used to find polygons with equal
+ * vertices. */
+static uint64_t poly_verts_hash(const Span<MLoop> poly_loops)
+{
+  uint64_t hash = uint64_t(poly_loops.size());
+  for (const MLoop &loop : poly_loops) {
+    uint64_t x = uint64_t(loop.v) * uint64_t(0x9E3779B97F4A7C15);
+    x ^= x >> 29;
+    x *= uint64_t(0xBF58476D1CE4E5B9);
+    x ^= x >> 32;
+    hash += x;
+  }
+  return hash;
+}
+
+static void poly_sorted_verts(const Span<MLoop> poly_loops, Vector<uint, 32> &r_verts)
+{
+  r_verts.clear();
+  for (const MLoop &loop : poly_loops) {
+    r_verts.append(loop.v);
+  }
+  std::sort(r_verts.begin(), r_verts.end());
+}
+
+/** Polygons with this many corners are checked for duplicate vertices by comparing all pairs. */
+constexpr int64_t poly_small_size = 16;
+
+static bool poly_corners_are_valid(const Span<MLoop> poly_loops,
+                                   const Span<MEdge> edges,
+                                   const uint totvert,
+                                   Vector<uint, 32> &verts_buffer)
+{
+  for (const int64_t corner : poly_loops.index_range()) {
+    const MLoop &loop = poly_loops[corner];
+    const MLoop &loop_next = poly_loops[(corner + 1) % poly_loops.size()];
+    if (loop.v >= totvert || loop.e >= uint(edges.size())) {
+      return false;
+    }
+    /* All edges are valid and unique, so an edge that uses the right vertices is the same one
+     * that would be found in the edge hash of the serial code. */
+    const MEdge &edge = edges[loop.e];
+    if (!((edge.v1 == loop.v && edge.v2 == loop_next.v) ||
+          (edge.v1 == loop_next.v && edge.v2 == loop.v))) {
+      return false;
+    }
+  }
+  if (poly_loops.size() <= poly_small_size) {
+    for (const int64_t i : poly_loops.index_range()) {
+      for (const int64_t j : poly_loops.index_range().drop_front(i + 1)) {
+        if (poly_loops[i].v == poly_loops[j].v) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  poly_sorted_verts(poly_loops, verts_buffer);
+  return std::adjacent_find(verts_buffer.begin(), verts_buffer.end()) == verts_buffer.end();
+}
+
+static bool polys_are_valid(const Mesh &mesh,
+                            const Span<MPoly> polys,
+                            const Span<MLoop> loops,
+                            const Span<MEdge> edges,
+                            const uint totvert)
+{
+  if (!poly_loop_ranges_are_valid(polys, uint(loops.size()))) {
+    return false;
+  }
+
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  if (const VArray<int> material_indices = attributes.lookup<int>("material_index",
+                                                                  ATTR_DOMAIN_FACE)) {
+    const VArraySpan<int> material_indices_span(material_indices);
+    if (!parallel_all_of(polys.index_range(), 4096, [&](const int64_t i) {
+          return material_indices_span[i] >= 0;
+        })) {
+      return false;
+    }
+  }
+
+  const bool corners_are_valid = parallel_all_of(polys.index_range(), 1024, [&](const int64_t i) {
+    const MPoly &poly = polys[i];
+    Vector<uint, 32> verts_buffer;
+    return poly_corners_are_valid(
+        loops.slice(poly.loopstart, poly.totloop), edges, totvert, verts_buffer);
+  });
+  if (!corners_are_valid) {
+    return false;
+  }
+
+  /* Find polygons that use the same vertices. Only polygons with the same hash have to be
+   * compared, which is rare. */
+  Array<uint64_t> hashes(polys.size(), NoInitialization());
+  Array<int> sorted_polys(polys.size(), NoInitialization());
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      hashes[i] = poly_verts_hash(loops.slice(polys[i].loopstart, polys[i].totloop));
+      sorted_polys[i] = int(i);
+    }
+  });
+  parallel_radix_sort<uint64_t, int>(hashes, sorted_polys);
+  return parallel_all_of(hashes.index_range().drop_front(1), 1024, [&](const int64_t i) {
+    if (hashes[i] != hashes[i - 1]) {
+      return true;
+    }
+    /* Compare all previous polygons with the same hash. */
+    const MPoly &poly = polys[sorted_polys[i]];
+    Vector<uint, 32> verts;
+    Vector<uint, 32> other_verts;
+    poly_sorted_verts(loops.slice(poly.loopstart, poly.totloop), verts);
+    for (int64_t other = i - 1; other >= 0 && hashes[other] == hashes[i]; other--) {
+      const MPoly &other_poly = polys[sorted_polys[other]];
+      poly_sorted_verts(loops.slice(other_poly.loopstart, other_poly.totloop), other_verts);
+      if (verts.as_span() == other_verts.as_span()) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+static bool deform_verts_are_valid(const Span<MDeformVert> dverts)
+{
+  return parallel_all_of(dverts.index_range(), 2048, [&](const int64_t i) {
+    for (const MDeformWeight &dw : Span(dverts[i].dw, dverts[i].totweight)) {
+      if (!(dw.weight >= 0.0f && dw.weight <= 1.0f) || dw.def_nr >= INT_MAX) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+static bool mselect_is_valid(const Mesh &mesh)
+{
+  for (const MSelect &msel : Span(mesh.mselect, mesh.mselect ? mesh.totselect : 0)) {
+    int tot_elem = 0;
+    switch (msel.type) {
+      case ME_VSEL:
+        tot_elem = mesh.totvert;
+        break;
+      case ME_ESEL:
+        tot_elem = mesh.totedge;
+        break;
+      case ME_FSEL:
+        tot_elem = mesh.totpoly;
+        break;
+    }
+    if (msel.index < 0 || msel.index > tot_elem) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * \return True when #mesh_validate_and_fix_arrays would neither find nor fix any problem.
+ * False doesn't necessarily mean that the mesh is invalid, only that the serial check is needed.
+ */
+static bool mesh_arrays_are_valid(Mesh &mesh,
+                                  const Span<MVert> verts,
+                                  const Span<MEdge> edges,
+                                  const MFace *mfaces,
+                                  const Span<MLoop> loops,
+                                  const Span<MPoly> polys,
+                                  const MDeformVert *dverts)
+{
+  if (mfaces && polys.data() == nullptr) {
+    /* Legacy tessellated faces are only checked by the serial code. */
+    return false;
+  }
+  if (edges.is_empty() && !polys.is_empty()) {
+    return false;
+  }
+
+  const float(*vert_normals)[3] = nullptr;
+  BKE_mesh_assert_normals_dirty_or_calculated(&mesh);
+  if (!BKE_mesh_vertex_normals_are_dirty(&mesh)) {
+    vert_normals = BKE_mesh_vertex_normals_ensure(&mesh);
+  }
+
+  const uint totvert = uint(verts.size());
+  bool verts_valid = true;
+  bool edges_valid = true;
+  threading::parallel_invoke(
+      verts.size() + edges.size() > 4096,
+      [&]() { verts_valid = verts_are_valid(verts, vert_normals); },
+      [&]() { edges_valid = edges_are_valid(edges, totvert); });
+  if (!(verts_valid && edges_valid)) {
+    return false;
+  }
+  if (!polys_are_valid(mesh, polys, loops, edges, totvert)) {
+    return false;
+  }
+  if (dverts && !deform_verts_are_valid(Span(dverts, verts.size()))) {
+    return false;
+  }
+  return mselect_is_valid(mesh);
+}
+
+}  // namespace blender::bke::mesh_validate
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Validation
  * \{ */
@@ -205,21 +512,21 @@ static int search_polyloop_cmp(const void *v1, const void *v2)
   } while (0)
 
 /* NOLINTNEXTLINE: readability-function-size */
-bool BKE_mesh_validate_arrays(Mesh *mesh,
-                              MVert *mverts,
-                              uint totvert,
-                              MEdge *medges,
-                              uint totedge,
-                              MFace *mfaces,
-                              uint totface,
-                              MLoop *mloops,
-                              uint totloop,
-                              MPoly *mpolys,
-                              uint totpoly,
-                              MDeformVert *dverts, /* assume totvert length */
-                              const bool do_verbose,
-                              const bool do_fixes,
-                              bool *r_changed)
+static bool mesh_validate_and_fix_arrays(Mesh *mesh,
+                                         MVert *mverts,
+                                         uint totvert,
+                                         MEdge *medges,
+                                         uint totedge,
+                                         MFace *mfaces,
+                                         uint totface,
+                                         MLoop *mloops,
+                                         uint totloop,
+                                         MPoly *mpolys,
+                                         uint totpoly,
+                                         MDeformVert *dverts, /* assume totvert length */
+                                         const bool do_verbose,
+                                         const bool do_fixes,
+                                         bool *r_changed)
 {
 #define REMOVE_EDGE_TAG(_me) \
   { \
@@ -936,6 +1243,54 @@ bool BKE_mesh_validate_arrays(Mesh *mesh,
   return is_valid;
 }
 
+bool BKE_mesh_validate_arrays(Mesh *mesh,
+                              MVert *mverts,
+                              uint totvert,
+                              MEdge *medges,
+                              uint totedge,
+                              MFace *mfaces,
+                              uint totface,
+                              MLoop *mloops,
+                              uint totloop,
+                              MPoly *mpolys,
+                              uint totpoly,
+                              MDeformVert *dverts,
+                              const bool do_verbose,
+                              const bool do_fixes,
+                              bool *r_changed)
+{
+  using namespace blender;
+  using namespace blender::bke::mesh_validate;
+  if (mesh_arrays_are_valid(*mesh,
+                            Span(mverts, totvert),
+                            Span(medges, totedge),
+                            mfaces,
+                            Span(mloops, totloop),
+                            Span(mpolys, totpoly),
+                            dverts)) {
+    PRINT_MSG(
+        "verts(%u), edges(%u), loops(%u), polygons(%u)", totvert, totedge, totloop, totpoly);
+    PRINT_MSG("%s: finished\n\n", __func__);
+    *r_changed = false;
+    return true;
+  }
+  return mesh_validate_and_fix_arrays(mesh,
+                                      mverts,
+                                      totvert,
+                                      medges,
+                                      totedge,
+                                      mfaces,
+                                      totface,
+                                      mloops,
+                                      totloop,
+                                      mpolys,
+                                      totpoly,
+                                      dverts,
+                                      do_verbose,
+                                      do_fixes,
+                                      r_changed);
+}
+
 static bool mesh_validate_customdata(CustomData *data,
                                      eCustomDataMask mask,
                                      const uint totitems,
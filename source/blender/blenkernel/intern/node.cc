@@ -74,6 +74,7 @@
 #include "NOD_function.h"
 #include "NOD_geometry.h"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_output_cache.hh"
 #include "NOD_node_declaration.hh"
 #include "NOD_shader.h"
 #include "NOD_socket.h"
@@ -4895,6 +4896,8 @@ void BKE_node_system_init()
 
 void BKE_node_system_exit()
 {
+  blender::nodes::node_output_cache::clear();
+
   if (nodetypes_hash) {
     NODE_TYPES_BEGIN (nt) {
       if (nt->rna_ext.free) {
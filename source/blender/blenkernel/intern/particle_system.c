@@ -30,6 +30,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_edgehash.h"
+#include "BLI_hash.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -2224,6 +2225,7 @@ typedef struct EfData {
   ParticleTexture ptex;
   ParticleSimulationData *sim;
   ParticleData *pa;
+  RNG *rng;
 } EfData;
 static void basic_force_cb(void *efdata_v, ParticleKey *state, float *force, float *impulse)
 {
@@ -2232,7 +2234,7 @@ static void basic_force_cb(void *efdata_v, ParticleKey *state, float *force, flo
   ParticleSettings *part = sim->psys->part;
   ParticleData *pa = efdata->pa;
   EffectedPoint epoint;
-  RNG *rng = sim->rng;
+  RNG *rng = efdata->rng;
 
   /* add effectors */
   pd_point_from_particle(efdata->sim, efdata->pa, state, &epoint);
@@ -2265,8 +2267,9 @@ static void basic_force_cb(void *efdata_v, ParticleKey *state, float *force, flo
     copy_v3_v3(pa->state.ave, epoint.ave);
   }
 }
-/* gathers all forces that effect particles and calculates a new state for the particle */
-static void basic_integrate(ParticleSimulationData *sim, int p, float dfra, float cfra)
+/* Gathers all forces that effect particles and calculates a new state for the particle.
+ * Random forces are taken from the given generator. */
+static void basic_integrate(ParticleSimulationData *sim, int p, float dfra, float cfra, RNG *rng)
 {
   ParticleSettings *part = sim->psys->part;
   ParticleData *pa = sim->psys->particles + p;
@@ -2279,6 +2282,7 @@ static void basic_integrate(ParticleSimulationData *sim, int p, float dfra, floa
 
   efdata.pa = pa;
   efdata.sim = sim;
+  efdata.rng = rng;
 
   /* add global acceleration (gravitation) */
   if (psys_uses_gravity(sim) &&
@@ -2878,16 +2882,15 @@ static int collision_detect(ParticleData *pa,
 
   return hit->index >= 0;
 }
-static int collision_response(ParticleSimulationData *sim,
-                              ParticleData *pa,
+static int collision_response(ParticleData *pa,
                               ParticleCollision *col,
                               BVHTreeRayHit *hit,
                               int kill,
-                              int dynamic_rotation)
+                              int dynamic_rotation,
+                              RNG *rng)
 {
   ParticleCollisionElement *pce = &col->pce;
   PartDeflect *pd = col->hit->pd;
-  RNG *rng = sim->rng;
   /* point of collision */
   float co[3];
   /* location factor of collision between this iteration */
@@ -3103,7 +3106,7 @@ static void collision_fail(ParticleData *pa, ParticleCollision *col)
  * -uses Newton-Rhapson iteration to find the collisions
  * -handles spherical particles and (nearly) point like particles
  */
-static void collision_check(ParticleSimulationData *sim, int p, float dfra, float cfra)
+static void collision_check(ParticleSimulationData *sim, int p, float dfra, float cfra, RNG *rng)
 {
   ParticleSettings *part = sim->psys->part;
   ParticleData *pa = sim->psys->particles + p;
@@ -3153,9 +3156,12 @@ static void collision_check(ParticleSimulationData *sim, int p, float dfra, floa
       if (collision_count == PARTICLE_COLLISION_MAX_COLLISIONS) {
         collision_fail(pa, &col);
       }
-      else if (collision_response(
-                   sim, pa, &col, &hit, part->flag & PART_DIE_ON_COL, part->flag & PART_ROT_DYN) ==
-               0) {
+      else if (collision_response(pa,
+                                  &col,
+                                  &hit,
+                                  part->flag & PART_DIE_ON_COL,
+                                  part->flag & PART_ROT_DYN,
+                                  rng) == 0) {
         return;
       }
     }
@@ -3683,9 +3689,55 @@ typedef struct DynamicStepSolverTaskData {
   float timestep;
   float dtime;
 
+  /* Seed of the random numbers of the step, combined with the particle index. */
+  uint rng_seed;
+
   SpinLock spin;
 } DynamicStepSolverTaskData;
 
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict tls)
+{
+  DynamicStepSolverTaskData *data = userdata;
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* Thread local generator, seeded per particle so that results don't depend on the order
+   * particles are evaluated in. */
+  RNG **rng = tls->userdata_chunk;
+  if (*rng == NULL) {
+    *rng = BLI_rng_new(0);
+  }
+  BLI_rng_srandom(*rng, BLI_hash_int_2d(data->rng_seed, (uint)p));
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra, *rng);
+
+  /* deflection */
+  if (sim->colliders) {
+    collision_check(sim, p, pa->state.time, data->cfra, *rng);
+  }
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+static void dynamics_step_newton_free(const void *__restrict UNUSED(userdata),
+                                      void *__restrict chunk)
+{
+  RNG **rng = chunk;
+  if (*rng) {
+    BLI_rng_free(*rng);
+  }
+}
+
 static void dynamics_step_sphdata_reduce(const void *__restrict UNUSED(userdata),
                                          void *__restrict join_v,
                                          void *__restrict chunk_v)
@@ -3721,13 +3773,13 @@ static void dynamics_step_sph_ddr_task_cb_ex(void *__restrict userdata,
   }
 
   /* do global forces & effectors */
-  basic_integrate(sim, p, pa->state.time, data->cfra);
+  basic_integrate(sim, p, pa->state.time, data->cfra, sim->rng);
 
   /* actual fluids calculations */
   sph_integrate(sim, pa, pa->state.time, sphdata);
 
   if (sim->colliders) {
-    collision_check(sim, p, pa->state.time, data->cfra);
+    collision_check(sim, p, pa->state.time, data->cfra, sim->rng);
   }
 
   /* SPH particles are not physical particles, just interpolation
@@ -3752,7 +3804,7 @@ static void dynamics_step_sph_classical_basic_integrate_task_cb_ex(
     return;
   }
 
-  basic_integrate(sim, p, pa->state.time, data->cfra);
+  basic_integrate(sim, p, pa->state.time, data->cfra, sim->rng);
 }
 
 static void dynamics_step_sph_classical_calc_density_task_cb_ex(
@@ -3794,7 +3846,7 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   sph_integrate(sim, pa, pa->state.time, sphdata);
 
   if (sim->colliders) {
-    collision_check(sim, p, pa->state.time, data->cfra);
+    collision_check(sim, p, pa->state.time, data->cfra, sim->rng);
   }
 
   /* SPH particles are not physical particles, just interpolation
@@ -3934,19 +3986,24 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
-
-        /* deflection */
-        if (sim->colliders) {
-          collision_check(sim, p, pa->state.time, cfra);
-        }
-
-        /* rotations */
-        basic_rotate(part, pa, pa->state.time, timestep);
-      }
+      DynamicStepSolverTaskData task_data = {
+          .sim = sim,
+          .cfra = cfra,
+          .timestep = timestep,
+          .dtime = dtime,
+          .rng_seed = 31415926 + (int)cfra + psys->seed,
+      };
+      /* Each thread allocates its own generator. */
+      RNG *rng = NULL;
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (psys->totpart > 100);
+      settings.userdata_chunk = &rng;
+      settings.userdata_chunk_size = sizeof(rng);
+      settings.func_free = dynamics_step_newton_free;
+      BLI_task_parallel_range(
+          0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
       break;
     }
     case PART_PHYS_BOIDS: {
@@ -3961,7 +4018,7 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
           /* deflection */
           if (sim->colliders) {
-            collision_check(sim, p, pa->state.time, cfra);
+            collision_check(sim, p, pa->state.time, cfra, sim->rng);
           }
         }
       }
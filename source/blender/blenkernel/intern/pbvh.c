@@ -2792,10 +2792,71 @@ static bool pbvh_draw_search_cb(PBVHNode *node, void *data_v)
     return false;
   }
 
+  if (node->flag & PBVH_DrawBuffersEvicted) {
+    /* The node is visible again. */
+    node->flag &= ~PBVH_DrawBuffersEvicted;
+    node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+  }
+
   data->accum_update_flag |= node->flag;
   return true;
 }
 
+static int pbvh_node_draw_frame_cmp(const void *a_v, const void *b_v)
+{
+  const PBVHNode *a = *(const PBVHNode **)a_v;
+  const PBVHNode *b = *(const PBVHNode **)b_v;
+  return (a->draw_frame > b->draw_frame) - (a->draw_frame < b->draw_frame);
+}
+
+/**
+ * Free the draw buffers of nodes outside of the view when the GPU memory budget is exceeded,
+ * starting with the nodes that were not visible for the longest time. They are rebuilt once the
+ * nodes are visible again.
+ */
+static void pbvh_evict_draw_buffers(PBVH *pbvh)
+{
+  const uint64_t budget = DRW_pbvh_gpu_memory_budget();
+  if (budget == 0) {
+    return;
+  }
+
+  uint64_t memory = 0;
+  int candidates_num = 0;
+  for (int i = 0; i < pbvh->totnode; i++) {
+    PBVHNode *node = &pbvh->nodes[i];
+    if (node->draw_batches) {
+      memory += DRW_pbvh_node_gpu_memory_usage(node->draw_batches);
+      if (node->draw_frame != pbvh->draw_frame) {
+        candidates_num++;
+      }
+    }
+  }
+  if (memory <= budget || candidates_num == 0) {
+    return;
+  }
+
+  PBVHNode **candidates = MEM_malloc_arrayN(candidates_num, sizeof(PBVHNode *), __func__);
+  int candidate = 0;
+  for (int i = 0; i < pbvh->totnode; i++) {
+    PBVHNode *node = &pbvh->nodes[i];
+    if (node->draw_batches && node->draw_frame != pbvh->draw_frame) {
+      candidates[candidate++] = node;
+    }
+  }
+  qsort(candidates, candidates_num, sizeof(PBVHNode *), pbvh_node_draw_frame_cmp);
+
+  for (int i = 0; i < candidates_num && memory > budget; i++) {
+    PBVHNode *node = candidates[i];
+    memory -= DRW_pbvh_node_gpu_memory_usage(node->draw_batches);
+    pbvh_free_draw_buffers(pbvh, node);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag |= PBVH_DrawBuffersEvicted;
+  }
+
+  MEM_freeN(candidates);
+}
+
 void BKE_pbvh_draw_cb(PBVH *pbvh,
                       bool update_only_visible,
                       PBVHFrustumPlanes *update_frustum,
@@ -2811,6 +2872,7 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
   int update_flag = 0;
 
   pbvh->draw_cache_invalid = false;
+  pbvh->draw_frame++;
 
   /* Search for nodes that need updates. */
   if (update_only_visible) {
@@ -2842,6 +2904,7 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
 
   for (int i = 0; i < totnode; i++) {
     PBVHNode *node = nodes[i];
+    node->draw_frame = pbvh->draw_frame;
     if (!(node->flag & PBVH_FullyHidden)) {
       pbvh_draw_args_init(pbvh, &args, node);
 
@@ -2850,6 +2913,11 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
   }
 
   MEM_SAFE_FREE(nodes);
+
+  /* Don't free buffers while painting, updates aren't limited to the visible nodes then. */
+  if (update_only_visible) {
+    pbvh_evict_draw_buffers(pbvh);
+  }
 }
 
 void BKE_pbvh_draw_debug_cb(PBVH *pbvh,
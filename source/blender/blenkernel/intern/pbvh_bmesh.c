@@ -11,6 +11,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -366,20 +367,20 @@ static void pbvh_bmesh_node_split(PBVH *pbvh, const BBC *bbc_array, int node_ind
   n->orig_vb = n->vb;
 }
 
-/* Recursively split the node if it exceeds the leaf_limit */
-static bool pbvh_bmesh_node_limit_ensure(PBVH *pbvh, int node_index)
+/**
+ * For each face of a node exceeding the leaf_limit, store the AABB and AABB centroid. Returns null
+ * when the node doesn't need to be split. Only touches the faces of the node, so it can run for
+ * several nodes in parallel.
+ */
+static BBC *pbvh_bmesh_node_bbc_array_create(PBVH *pbvh, int node_index)
 {
   GSet *bm_faces = pbvh->nodes[node_index].bm_faces;
   const int bm_faces_size = BLI_gset_len(bm_faces);
   if (bm_faces_size <= pbvh->leaf_limit) {
     /* Node limit not exceeded */
-    return false;
+    return NULL;
   }
 
-  /* Trigger draw manager cache invalidation. */
-  pbvh->draw_cache_invalid = true;
-
-  /* For each BMFace, store the AABB and AABB centroid */
   BBC *bbc_array = MEM_mallocN(sizeof(BBC) * bm_faces_size, "BBC");
 
   GSetIterator gs_iter;
@@ -399,14 +400,8 @@ static bool pbvh_bmesh_node_limit_ensure(PBVH *pbvh, int node_index)
     /* so we can do direct lookups on 'bbc_array' */
     BM_elem_index_set(f, i); /* set_dirty! */
   }
-  /* Likely this is already dirty. */
-  pbvh->header.bm->elem_index_dirty |= BM_FACE;
-
-  pbvh_bmesh_node_split(pbvh, bbc_array, node_index);
 
-  MEM_freeN(bbc_array);
-
-  return true;
+  return bbc_array;
 }
 
 /**********************************************************************/
@@ -2080,21 +2075,210 @@ void BKE_pbvh_bmesh_node_save_orig(BMesh *bm, PBVHNode *node)
   node->bm_tot_ortri = i;
 }
 
-void BKE_pbvh_bmesh_after_stroke(PBVH *pbvh)
+/**
+ * Collapse the subtrees that lost most of their faces into single leaves, since splitting alone
+ * leaves a growing number of nearly empty leaves after long dyntopo sessions.
+ * Returns the number of faces in the subtree.
+ */
+static int pbvh_bmesh_node_merge_recursive(PBVH *pbvh, int node_index, bool *r_merged)
 {
+  const int cd_vert_node_offset = pbvh->cd_vert_node_offset;
+  const int cd_face_node_offset = pbvh->cd_face_node_offset;
+  PBVHNode *n = &pbvh->nodes[node_index];
+
+  if (n->flag & PBVH_Leaf) {
+    return BLI_gset_len(n->bm_faces);
+  }
+
+  const int children = n->children_offset;
+  const int totface = pbvh_bmesh_node_merge_recursive(pbvh, children, r_merged) +
+                      pbvh_bmesh_node_merge_recursive(pbvh, children + 1, r_merged);
+
+  /* Leave room for the faces added by the next strokes, so merged leaves aren't split again right
+   * away. */
+  if (totface > pbvh->leaf_limit / 2) {
+    return totface;
+  }
+
+  /* Both children have fewer faces, so they were merged into leaves already. */
+  n->bm_faces = BLI_gset_ptr_new_ex("bm_faces", totface);
+  n->bm_unique_verts = BLI_gset_ptr_new("bm_unique_verts");
+  n->bm_other_verts = BLI_gset_ptr_new("bm_other_verts");
+  BB_reset(&n->vb);
+  bool fully_hidden = true;
+
+  for (int i = 0; i < 2; i++) {
+    PBVHNode *c = &pbvh->nodes[children + i];
+    BLI_assert(c->flag & PBVH_Leaf);
+    GSetIterator gs_iter;
+
+    GSET_ITER (gs_iter, c->bm_faces) {
+      BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+      BM_ELEM_CD_SET_INT(f, cd_face_node_offset, node_index);
+      BLI_gset_insert(n->bm_faces, f);
+    }
+    GSET_ITER (gs_iter, c->bm_unique_verts) {
+      BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+      BM_ELEM_CD_SET_INT(v, cd_vert_node_offset, node_index);
+      BLI_gset_insert(n->bm_unique_verts, v);
+    }
+    BB_expand_with_bb(&n->vb, &c->vb);
+    fully_hidden &= BKE_pbvh_node_fully_hidden_get(c);
+  }
+
+  for (int i = 0; i < 2; i++) {
+    PBVHNode *c = &pbvh->nodes[children + i];
+    GSetIterator gs_iter;
+
+    /* Verts of one child used by the other one are now unique to this node. */
+    GSET_ITER (gs_iter, c->bm_other_verts) {
+      BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+      if (BM_ELEM_CD_GET_INT(v, cd_vert_node_offset) != node_index) {
+        BLI_gset_add(n->bm_other_verts, v);
+      }
+    }
+
+    BLI_gset_free(c->bm_faces, NULL);
+    BLI_gset_free(c->bm_unique_verts, NULL);
+    BLI_gset_free(c->bm_other_verts, NULL);
+    MEM_SAFE_FREE(c->layer_disp);
+    pbvh_bmesh_node_drop_orig(c);
+    if (c->draw_batches) {
+      DRW_pbvh_node_free(c->draw_batches);
+    }
+    memset(c, 0, sizeof(*c));
+  }
+
+  n->orig_vb = n->vb;
+  n->flag |= PBVH_Leaf | PBVH_UpdateNormals;
+  n->children_offset = 0;
+  BKE_pbvh_node_mark_rebuild_draw(n);
+  BKE_pbvh_node_fully_hidden_set(n, fully_hidden);
+
+  *r_merged = true;
+  return totface;
+}
+
+/**
+ * Remove the nodes that are not reachable from the root anymore after merging, updating the node
+ * indices stored in the faces and vertices of the moved leaves.
+ */
+static void pbvh_bmesh_nodes_compact(PBVH *pbvh)
+{
+  const int cd_vert_node_offset = pbvh->cd_vert_node_offset;
+  const int cd_face_node_offset = pbvh->cd_face_node_offset;
+  int *node_map = MEM_malloc_arrayN(pbvh->totnode, sizeof(int), __func__);
+
+  /* Children always come after their parent, and stay next to each other. */
+  copy_vn_i(node_map, pbvh->totnode, -1);
+  node_map[0] = 0;
+  int totnode = 0;
   for (int i = 0; i < pbvh->totnode; i++) {
-    PBVHNode *n = &pbvh->nodes[i];
-    if (n->flag & PBVH_Leaf) {
-      /* Free orco/ortri data */
-      pbvh_bmesh_node_drop_orig(n);
+    if (node_map[i] == -1) {
+      continue;
+    }
+    node_map[i] = totnode++;
+    const PBVHNode *n = &pbvh->nodes[i];
+    if (!(n->flag & PBVH_Leaf)) {
+      node_map[n->children_offset] = 0;
+      node_map[n->children_offset + 1] = 0;
+    }
+  }
+
+  if (totnode == pbvh->totnode) {
+    MEM_freeN(node_map);
+    return;
+  }
 
-      /* Recursively split nodes that have gotten too many
-       * elements */
-      pbvh_bmesh_node_limit_ensure(pbvh, i);
+  for (int i = 0; i < pbvh->totnode; i++) {
+    const int new_index = node_map[i];
+    if (new_index == -1) {
+      continue;
+    }
+    PBVHNode *n = &pbvh->nodes[new_index];
+    if (new_index != i) {
+      *n = pbvh->nodes[i];
     }
+
+    if (!(n->flag & PBVH_Leaf)) {
+      n->children_offset = node_map[n->children_offset];
+    }
+    else if (new_index != i) {
+      GSetIterator gs_iter;
+      GSET_ITER (gs_iter, n->bm_faces) {
+        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+        BM_ELEM_CD_SET_INT(f, cd_face_node_offset, new_index);
+      }
+      GSET_ITER (gs_iter, n->bm_unique_verts) {
+        BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+        BM_ELEM_CD_SET_INT(v, cd_vert_node_offset, new_index);
+      }
+    }
+  }
+
+  /* The data of the removed nodes was freed or moved, clear them so they can be reused. */
+  memset(&pbvh->nodes[totnode], 0, sizeof(PBVHNode) * (pbvh->totnode - totnode));
+  pbvh->totnode = totnode;
+
+  MEM_freeN(node_map);
+}
+
+typedef struct AfterStrokeData {
+  PBVH *pbvh;
+  BBC **bbc_arrays;
+} AfterStrokeData;
+
+static void pbvh_bmesh_after_stroke_task_cb(void *__restrict userdata,
+                                            const int n,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AfterStrokeData *data = userdata;
+  PBVHNode *node = &data->pbvh->nodes[n];
+  if (node->flag & PBVH_Leaf) {
+    /* Free orco/ortri data */
+    pbvh_bmesh_node_drop_orig(node);
+
+    data->bbc_arrays[n] = pbvh_bmesh_node_bbc_array_create(data->pbvh, n);
   }
 }
 
+void BKE_pbvh_bmesh_after_stroke(PBVH *pbvh)
+{
+  /* Merge nodes that have lost most of their elements, keeping the leaves balanced. */
+  bool merged = false;
+  pbvh_bmesh_node_merge_recursive(pbvh, 0, &merged);
+  if (merged) {
+    pbvh_bmesh_nodes_compact(pbvh);
+    pbvh->draw_cache_invalid = true;
+  }
+
+  const int totnode = pbvh->totnode;
+  AfterStrokeData data = {
+      .pbvh = pbvh,
+      .bbc_arrays = MEM_calloc_arrayN(totnode, sizeof(BBC *), __func__),
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totnode);
+  BLI_task_parallel_range(0, totnode, &data, pbvh_bmesh_after_stroke_task_cb, &settings);
+
+  /* Recursively split nodes that have gotten too many elements. Splitting grows the nodes array,
+   * so it can't run in parallel. */
+  for (int i = 0; i < totnode; i++) {
+    if (data.bbc_arrays[i]) {
+      /* Trigger draw manager cache invalidation. */
+      pbvh->draw_cache_invalid = true;
+      /* Likely this is already dirty. */
+      pbvh->header.bm->elem_index_dirty |= BM_FACE;
+
+      pbvh_bmesh_node_split(pbvh, data.bbc_arrays[i], i);
+      MEM_freeN(data.bbc_arrays[i]);
+    }
+  }
+
+  MEM_freeN(data.bbc_arrays);
+}
+
 void BKE_pbvh_bmesh_detail_size_set(PBVH *pbvh, float detail_size)
 {
   pbvh->bm_max_edge_len = detail_size;
@@ -128,6 +128,9 @@ struct PBVHNode {
    * debug draw mode (when G.debug_value / bpy.app.debug_value is 889).
    */
   int debug_draw_gen;
+
+  /* Last redraw in which the node was in the view, see #PBVH.draw_frame. */
+  int draw_frame;
 };
 
 typedef enum { PBVH_DYNTOPO_SMOOTH_SHADING = 1 } PBVHFlags;
@@ -213,6 +216,10 @@ struct PBVH {
   /* Used by DynTopo to invalidate the draw cache. */
   bool draw_cache_invalid;
 
+  /* Incremented on every redraw, the draw buffers of nodes that were not visible for the longest
+   * time are freed first when the GPU memory budget is exceeded. */
+  int draw_frame;
+
   struct PBVHGPUFormat *vbo_id;
 };
 
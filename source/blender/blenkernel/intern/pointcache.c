@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -56,10 +57,6 @@
 
 #include "BIK_api.h"
 
-#ifdef WITH_BULLET
-#  include "RBI_api.h"
-#endif
-
 #ifdef WITH_LZO
 #  ifdef WITH_SYSTEM_LZO
 #    include <lzo/lzo1x.h>
@@ -76,6 +73,10 @@
 #  include "LzmaLib.h"
 #endif
 
+#include <zstd.h>
+
+#define ZSTD_COMPRESSION_LEVEL 3
+
 /* needed for directory lookup */
 #ifndef WIN32
 #  include <dirent.h>
@@ -763,11 +764,8 @@ static int ptcache_rigidbody_write(int index, void *rb_v, void **data, int UNUSE
   if (ob && ob->rigidbody_object) {
     RigidBodyOb *rbo = ob->rigidbody_object;
 
+    /* Transforms were copied from the physics objects after the simulation step. */
     if (rbo->type == RBO_TYPE_ACTIVE && rbo->shared->physics_object != NULL) {
-#ifdef WITH_BULLET
-      RB_body_get_position(rbo->shared->physics_object, rbo->pos);
-      RB_body_get_orientation(rbo->shared->physics_object, rbo->orn);
-#endif
       PTCACHE_DATA_FROM(data, BPHYS_DATA_LOCATION, rbo->pos);
       PTCACHE_DATA_FROM(data, BPHYS_DATA_ROTATION, rbo->orn);
     }
@@ -1534,6 +1532,9 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == 3) {
+        r = ZSTD_isError(ZSTD_decompress(result, len, in, in_len));
+      }
       MEM_freeN(in);
     }
   }
@@ -1554,8 +1555,6 @@ static int ptcache_file_compressed_write(
   uchar *props = MEM_callocN(sizeof(char[16]), "tmp");
   size_t sizeOfIt = 5;
 
-  (void)mode; /* unused when building w/o compression */
-
 #ifdef WITH_LZO
   out_len = LZO_OUT_LEN(in_len);
   if (mode == 1) {
@@ -1595,6 +1594,25 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == 3) {
+    /* Large frames are split in jobs compressed on multiple threads, this is ignored when zstd is
+     * built without threading support. */
+    ZSTD_CCtx *ctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, ZSTD_COMPRESSION_LEVEL);
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers, BLI_system_thread_count());
+
+    /* The output buffer is at least #LZO_OUT_LEN long, which is larger than the zstd bound. */
+    out_len = ZSTD_compress2(ctx, out, ZSTD_compressBound(in_len), in, in_len);
+    ZSTD_freeCCtx(ctx);
+
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      r = 1;
+      compressed = 0;
+    }
+    else {
+      compressed = 3;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
@@ -1637,19 +1655,6 @@ static int ptcache_file_data_read(PTCacheFile *pf)
 
   return 1;
 }
-static int ptcache_file_data_write(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
   uint typeflag = 0;
@@ -1958,6 +1963,7 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
       }
     }
     else {
+      /* Data interleaved per point, written by older versions without compression. */
       void *cur[BPHYS_TOT_DATA];
       BKE_ptcache_mem_pointers_init(pm, cur);
       ptcache_file_pointers_init(pf);
@@ -2037,38 +2043,24 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
     pf->flag |= PTCACHE_TYPEFLAG_EXTRADATA;
   }
 
-  if (pid->cache->compression) {
-    pf->flag |= PTCACHE_TYPEFLAG_COMPRESS;
-  }
+  /* Always write the data arrays of each type one after the other, even without compression.
+   * Compared to the interleaved layout of older files, this allows reading each one at once. */
+  pf->flag |= PTCACHE_TYPEFLAG_COMPRESS;
 
   if (!ptcache_file_header_begin_write(pf) || !pid->write_header(pf)) {
     error = 1;
   }
 
   if (!error) {
-    if (pid->cache->compression) {
-      for (i = 0; i < BPHYS_TOT_DATA; i++) {
-        if (pm->data[i]) {
-          uint in_len = pm->totpoint * ptcache_data_size[i];
-          uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
-          ptcache_file_compressed_write(
-              pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
-        }
-      }
-    }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
+    for (i = 0; i < BPHYS_TOT_DATA; i++) {
+      if (pm->data[i]) {
+        uint in_len = pm->totpoint * ptcache_data_size[i];
+        uchar *out = pid->cache->compression ?
+                         (uchar *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer") :
+                         NULL;
+        ptcache_file_compressed_write(
+            pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
+        MEM_SAFE_FREE(out);
       }
     }
   }
@@ -2084,16 +2076,13 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
       ptcache_file_write(pf, &extra->type, 1, sizeof(uint));
       ptcache_file_write(pf, &extra->totdata, 1, sizeof(uint));
 
-      if (pid->cache->compression) {
-        uint in_len = extra->totdata * ptcache_extra_datasize[extra->type];
-        uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
-        ptcache_file_compressed_write(
-            pf, (uchar *)(extra->data), in_len, out, pid->cache->compression);
-        MEM_freeN(out);
-      }
-      else {
-        ptcache_file_write(pf, extra->data, extra->totdata, ptcache_extra_datasize[extra->type]);
-      }
+      uint in_len = extra->totdata * ptcache_extra_datasize[extra->type];
+      uchar *out = pid->cache->compression ?
+                       (uchar *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer") :
+                       NULL;
+      ptcache_file_compressed_write(
+          pf, (uchar *)(extra->data), in_len, out, pid->cache->compression);
+      MEM_SAFE_FREE(out);
     }
   }
 
@@ -19,6 +19,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -2032,6 +2033,34 @@ static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBod
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 }
 
+static void rigidbody_update_sim_transforms_cb(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RigidBodyWorld *rbw = userdata;
+  Object *ob = rbw->objects[index];
+  RigidBodyOb *rbo = ob ? ob->rigidbody_object : NULL;
+
+  if (rbo && rbo->type == RBO_TYPE_ACTIVE && rbo->shared->physics_object) {
+    RB_body_get_position(rbo->shared->physics_object, rbo->pos);
+    RB_body_get_orientation(rbo->shared->physics_object, rbo->orn);
+  }
+}
+
+/* Copy the simulated transforms of all active bodies before they are written to the point cache,
+ * in one pass instead of object by object. */
+static void rigidbody_update_sim_transforms(RigidBodyWorld *rbw)
+{
+  if (rbw->objects == NULL) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, rbw->numbodies, rbw, rigidbody_update_sim_transforms_cb, &settings);
+}
+
 bool BKE_rigidbody_check_sim_running(RigidBodyWorld *rbw, float ctime)
 {
   return (rbw && (rbw->flag & RBW_FLAG_MUTED) == 0 && ctime > rbw->shared->pointcache->startframe);
@@ -2232,6 +2261,7 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
   if (compare_ff_relative(ctime, rbw->ltime + 1, FLT_EPSILON, 64)) {
     /* write cache for first frame when on second frame */
     if (rbw->ltime == startframe && (cache->flag & PTCACHE_OUTDATED || cache->last_exact == 0)) {
+      rigidbody_update_sim_transforms(rbw);
       BKE_ptcache_write(&pid, startframe);
     }
 
@@ -2258,6 +2288,7 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
     rigidbody_free_substep_data(&kinematic_substep_targets);
 
     rigidbody_update_simulation_post_step(depsgraph, rbw);
+    rigidbody_update_sim_transforms(rbw);
 
     /* write cache for current frame */
     BKE_ptcache_validate(cache, (int)ctime);
@@ -11,8 +11,11 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_utildefines.h"
 
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
 #include "BKE_modifier.h"
 #include "BKE_subdiv_modifier.h"
 
@@ -168,14 +171,85 @@ Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
   return BKE_subdiv_new_from_converter(settings, converter);
 }
 
+static void mesh_topology_hash_add(BLI_HashMurmur2A mm2[2], const void *data, const size_t len)
+{
+  BLI_hash_mm2a_add(&mm2[0], data, len);
+  BLI_hash_mm2a_add(&mm2[1], data, len);
+}
+
+static void mesh_topology_hash_add_layer(BLI_HashMurmur2A mm2[2],
+                                         const void *data,
+                                         const size_t len)
+{
+  BLI_hash_mm2a_add_int(&mm2[0], data != NULL);
+  BLI_hash_mm2a_add_int(&mm2[1], data != NULL);
+  if (data != NULL) {
+    mesh_topology_hash_add(mm2, data, len);
+  }
+}
+
+/**
+ * Hash everything the mesh converter feeds to the topology refiner. Non zero, so it is never equal
+ * to the hash of a subdivision surface which was not created from a mesh.
+ *
+ * Flags stored alongside the topology, like selection, are hashed as well. Changing them only
+ * makes the full comparison with the topology refiner run.
+ */
+static uint64_t mesh_topology_hash(const Mesh *mesh)
+{
+  /* Two 32 bit hashes, so that collisions are unlikely enough to skip the full comparison. */
+  BLI_HashMurmur2A mm2[2];
+  BLI_hash_mm2a_init(&mm2[0], 0);
+  BLI_hash_mm2a_init(&mm2[1], 0x9e3779b9);
+
+  const int counts[4] = {mesh->totvert, mesh->totedge, mesh->totpoly, mesh->totloop};
+  mesh_topology_hash_add(mm2, counts, sizeof(counts));
+  mesh_topology_hash_add(mm2, BKE_mesh_edges(mesh), sizeof(MEdge) * mesh->totedge);
+  mesh_topology_hash_add(mm2, BKE_mesh_polys(mesh), sizeof(MPoly) * mesh->totpoly);
+  mesh_topology_hash_add(mm2, BKE_mesh_loops(mesh), sizeof(MLoop) * mesh->totloop);
+
+  mesh_topology_hash_add_layer(
+      mm2, CustomData_get_layer(&mesh->vdata, CD_CREASE), sizeof(float) * mesh->totvert);
+  mesh_topology_hash_add_layer(
+      mm2, CustomData_get_layer(&mesh->edata, CD_CREASE), sizeof(float) * mesh->totedge);
+  const bool *hide_poly = CustomData_get_layer_named(&mesh->pdata, CD_PROP_BOOL, ".hide_poly");
+  mesh_topology_hash_add_layer(mm2, hide_poly, sizeof(bool) * mesh->totpoly);
+
+  /* UV maps define the face-varying topology. */
+  const int num_uv_layers = CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV);
+  BLI_hash_mm2a_add_int(&mm2[0], num_uv_layers);
+  BLI_hash_mm2a_add_int(&mm2[1], num_uv_layers);
+  for (int i = 0; i < num_uv_layers; i++) {
+    mesh_topology_hash_add(mm2,
+                           CustomData_get_layer_n(&mesh->ldata, CD_MLOOPUV, i),
+                           sizeof(MLoopUV) * mesh->totloop);
+  }
+
+  const uint64_t hash = ((uint64_t)BLI_hash_mm2a_end(&mm2[0]) << 32) |
+                        BLI_hash_mm2a_end(&mm2[1]);
+  return hash != 0 ? hash : 1;
+}
+
 Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
                                     const SubdivSettings *settings,
                                     const Mesh *mesh)
 {
+  /* Deforming meshes keep the same topology on every frame, avoid creating the converter and
+   * comparing it with the topology refiner then. */
+  const uint64_t topology_hash = mesh_topology_hash(mesh);
+  if (subdiv != NULL && subdiv->topology_refiner != NULL &&
+      subdiv->mesh_topology_hash == topology_hash &&
+      BKE_subdiv_settings_equal(&subdiv->settings, settings)) {
+    return subdiv;
+  }
+
   OpenSubdiv_Converter converter;
   BKE_subdiv_converter_init_for_mesh(&converter, settings, mesh);
   subdiv = BKE_subdiv_update_from_converter(subdiv, settings, &converter);
   BKE_subdiv_converter_free(&converter);
+  if (subdiv != NULL) {
+    subdiv->mesh_topology_hash = topology_hash;
+  }
   return subdiv;
 }
 
@@ -972,6 +972,39 @@ bool BKE_volume_save(const Volume *volume,
 #endif
 }
 
+#ifdef WITH_OPENVDB
+/* Bounds of a grid that is not loaded yet, from the active voxel bounding box statistics that
+ * OpenVDB writes in the grid metadata of files. Avoids reading the whole tree only for them. */
+static bool volume_grid_file_bounds(const VolumeGrid *volume_grid, float3 &r_min, float3 &r_max)
+{
+  if (BKE_volume_grid_is_loaded(volume_grid)) {
+    return false;
+  }
+
+  openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_metadata(volume_grid);
+  openvdb::Vec3IMetadata::ConstPtr bbox_min = grid->getMetadata<openvdb::Vec3IMetadata>(
+      openvdb::GridBase::META_FILE_BBOX_MIN);
+  openvdb::Vec3IMetadata::ConstPtr bbox_max = grid->getMetadata<openvdb::Vec3IMetadata>(
+      openvdb::GridBase::META_FILE_BBOX_MAX);
+  if (!bbox_min || !bbox_max) {
+    return false;
+  }
+
+  const openvdb::CoordBBox coordbbox(openvdb::Coord(bbox_min->value()),
+                                     openvdb::Coord(bbox_max->value()));
+  if (coordbbox.empty()) {
+    return false;
+  }
+
+  openvdb::BBoxd bbox = grid->transform().indexToWorld(coordbbox);
+
+  r_min = float3(float(bbox.min().x()), float(bbox.min().y()), float(bbox.min().z()));
+  r_max = float3(float(bbox.max().x()), float(bbox.max().y()), float(bbox.max().z()));
+
+  return true;
+}
+#endif
+
 bool BKE_volume_min_max(const Volume *volume, float3 &r_min, float3 &r_max)
 {
   bool have_minmax = false;
@@ -982,9 +1015,16 @@ bool BKE_volume_min_max(const Volume *volume, float3 &r_min, float3 &r_max)
   if (BKE_volume_load(const_cast<Volume *>(volume), G.main)) {
     for (const int i : IndexRange(BKE_volume_num_grids(volume))) {
       const VolumeGrid *volume_grid = BKE_volume_grid_get_for_read(volume, i);
-      openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_read(volume, volume_grid);
       float3 grid_min;
       float3 grid_max;
+      if (volume_grid_file_bounds(volume_grid, grid_min, grid_max)) {
+        DO_MIN(grid_min, r_min);
+        DO_MAX(grid_max, r_max);
+        have_minmax = true;
+        continue;
+      }
+
+      openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_read(volume, volume_grid);
       if (BKE_volume_grid_bounds(grid, grid_min, grid_max)) {
         DO_MIN(grid_min, r_min);
         DO_MAX(grid_max, r_max);
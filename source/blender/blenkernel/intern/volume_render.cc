@@ -70,6 +70,12 @@ static void extract_dense_float_voxels(const VolumeGridType grid_type,
   }
 }
 
+static int bbox_max_dim(const openvdb::CoordBBox &bbox)
+{
+  const openvdb::Coord dim = bbox.dim();
+  return std::max({dim.x(), dim.y(), dim.z()});
+}
+
 static void create_texture_to_object_matrix(const openvdb::Mat4d &grid_transform,
                                             const openvdb::CoordBBox &bbox,
                                             float r_texture_to_object[4][4])
@@ -90,17 +96,39 @@ static void create_texture_to_object_matrix(const openvdb::Mat4d &grid_transform
 
 bool BKE_volume_grid_dense_floats(const Volume *volume,
                                   const VolumeGrid *volume_grid,
+                                  const int max_resolution,
                                   DenseFloatVolumeGrid *r_dense_grid)
 {
 #ifdef WITH_OPENVDB
   const VolumeGridType grid_type = BKE_volume_grid_type(volume_grid);
   openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_read(volume, volume_grid);
 
-  const openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
+  openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
   if (bbox.empty()) {
     return false;
   }
 
+  /* Resample grids larger than the maximum resolution before extracting them, rather than
+   * allocating dense voxels that can't be used. */
+  if (max_resolution > 0 && bbox_max_dim(bbox) > max_resolution) {
+    float resolution_factor = float(max_resolution) / float(bbox_max_dim(bbox));
+    /* Sampling can extend the bounding box by a voxel, retry with a lower factor if needed. */
+    for (int attempt = 0; attempt < 4; attempt++) {
+      openvdb::GridBase::ConstPtr resampled_grid = BKE_volume_grid_create_with_changed_resolution(
+          grid_type, *grid, resolution_factor);
+      const openvdb::CoordBBox resampled_bbox = resampled_grid->evalActiveVoxelBoundingBox();
+      if (resampled_bbox.empty()) {
+        return false;
+      }
+      if (bbox_max_dim(resampled_bbox) <= max_resolution || attempt == 3) {
+        grid = resampled_grid;
+        bbox = resampled_bbox;
+        break;
+      }
+      resolution_factor *= float(max_resolution) / float(bbox_max_dim(resampled_bbox));
+    }
+  }
+
   const openvdb::Vec3i resolution = bbox.dim().asVec3i();
   const int64_t num_voxels = int64_t(resolution[0]) * int64_t(resolution[1]) *
                              int64_t(resolution[2]);
@@ -121,7 +149,7 @@ bool BKE_volume_grid_dense_floats(const Volume *volume,
   copy_v3_v3_int(r_dense_grid->resolution, resolution.asV());
   return true;
 #endif
-  UNUSED_VARS(volume, volume_grid, r_dense_grid);
+  UNUSED_VARS(volume, volume_grid, max_resolution, r_dense_grid);
   return false;
 }
 
@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::threading::ConcurrentMap<Key, Value>` is a hash map that can be modified by many
+ * threads at the same time. It is meant for algorithms that build a large hash table in parallel,
+ * which otherwise have to build a map per thread and merge them afterwards.
+ *
+ * The map is split into many shards. Every shard is a #SwissMap that is protected by its own
+ * mutex. The shard of a key is determined by its hash, so different threads rarely wait for each
+ * other as long as there are many more shards than threads.
+ *
+ * Values are returned by copy, because references into a shard are invalidated when another
+ * thread grows it. Callbacks passed to methods like #add_or_modify are called while the shard is
+ * locked, so they may access the value in place but must not access the map themselves.
+ *
+ * Once all threads are done modifying the map, the shards can be accessed directly with
+ * #shard. This allows iterating over all elements in parallel without any locking.
+ *
+ * Note that the iteration order of the elements depends on the order in which they were added.
+ * When elements are added from multiple threads, the order is not deterministic.
+ */
+
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
+#include "BLI_swiss_map.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender::threading {
+
+/**
+ * Default number of shards used by concurrent hash tables. Using many more shards than threads
+ * reduces the likelihood that two threads need the same shard at the same time. An empty shard
+ * only needs a few bytes.
+ */
+constexpr int64_t concurrent_hash_table_default_shards_num = 256;
+
+/** Find the shard of a key based on its hash. */
+inline int64_t concurrent_hash_table_shard_index(const uint64_t hash, const uint64_t shard_mask)
+{
+  /* Use different bits of the hash than #SwissMap does, so that the keys within one shard still
+   * have well distributed hashes. */
+  const uint64_t h = hash * uint64_t(0xFF51AFD7ED558CCD);
+  return int64_t((h >> 40) & shard_mask);
+}
+
+template<typename Key,
+         typename Value,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality,
+         typename Allocator = GuardedAllocator>
+class ConcurrentMap : NonCopyable, NonMovable {
+ public:
+  using ShardMap = SwissMap<Key, Value, Hash, IsEqual, Allocator>;
+
+ private:
+  /* Make sure that the mutexes of different shards are not in the same cache line. */
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    ShardMap map;
+  };
+
+  Array<Shard, 0, Allocator> shards_;
+  uint64_t shard_mask_;
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+
+ public:
+  /**
+   * \param shards_num: Will be rounded up to a power of two.
+   */
+  explicit ConcurrentMap(const int64_t shards_num = concurrent_hash_table_default_shards_num)
+      : shards_(int64_t(power_of_2_max_u(uint(std::max<int64_t>(shards_num, 1)))))
+  {
+    shard_mask_ = uint64_t(shards_.size() - 1);
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->add_as(key, value);
+  }
+  bool add(Key &&key, Value &&value)
+  {
+    return this->add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_as(std::forward<ForwardKey>(key), std::forward<ForwardValue>(value)...);
+  }
+
+  /**
+   * Adds a key-value-pair to the map. If the map contained the key already, the corresponding
+   * value will be replaced. Returns true when the key has been newly added.
+   */
+  bool add_overwrite(const Key &key, const Value &value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_overwrite(key, value);
+  }
+
+  /**
+   * Get the value that is stored for the key. If there is none yet, the given value is added
+   * first. A copy of the value in the map is returned.
+   */
+  Value lookup_or_add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_cb(key, [&]() { return value; });
+  }
+
+  /**
+   * Get the value that is stored for the key. If there is none yet, create_value is called to
+   * create a new value first. This allows multiple threads to agree on a single value for every
+   * key, e.g. an index. A copy of the value in the map is returned.
+   */
+  template<typename CreateValueF>
+  Value lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.lookup_or_add_cb(key, create_value);
+  }
+
+  /**
+   * Call create_value when the key is not in the map yet, otherwise call modify_value. Both are
+   * called with a pointer to the value while the shard is locked. See #Map::add_or_modify.
+   */
+  template<typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify(const Key &key,
+                     const CreateValueF &create_value,
+                     const ModifyValueF &modify_value) -> decltype(create_value(nullptr))
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_or_modify(key, create_value, modify_value);
+  }
+
+  /**
+   * Returns true if there is a key in the map that compares equal to the given key.
+   */
+  bool contains(const Key &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.contains(key);
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the map,
+   * the provided default value is returned.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.lookup_default(key, default_value);
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. Returns true when the key was contained.
+   */
+  bool remove(const Key &key)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.remove(key);
+  }
+
+  /**
+   * Make sure that approximately the given number of elements can be added without growing the
+   * shards. Must not be called while other threads use the map.
+   */
+  void reserve(const int64_t n)
+  {
+    const int64_t n_per_shard = n / shards_.size() + 1;
+    for (Shard &shard : shards_) {
+      shard.map.reserve(n_per_shard);
+    }
+  }
+
+  /**
+   * Returns the total number of key-value-pairs. Must not be called while other threads modify
+   * the map.
+   */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Shard &shard : shards_) {
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Removes all key-value-pairs. Must not be called while other threads use the map.
+   */
+  void clear()
+  {
+    for (Shard &shard : shards_) {
+      shard.map.clear();
+    }
+  }
+
+  int64_t shards_num() const
+  {
+    return shards_.size();
+  }
+
+  /**
+   * Direct access to the map of a shard, e.g. to iterate over all elements in parallel. Must not
+   * be used while other threads modify the map.
+   */
+  ShardMap &shard(const int64_t index)
+  {
+    return shards_[index].map;
+  }
+  const ShardMap &shard(const int64_t index) const
+  {
+    return shards_[index].map;
+  }
+
+ private:
+  Shard &shard_for_key(const Key &key)
+  {
+    return shards_[concurrent_hash_table_shard_index(hash_(key), shard_mask_)];
+  }
+
+  const Shard &shard_for_key(const Key &key) const
+  {
+    return const_cast<ConcurrentMap *>(this)->shard_for_key(key);
+  }
+};
+
+}  // namespace blender::threading
@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::threading::ConcurrentSet<Key>` is a set that can be modified by many threads at the
+ * same time. It is sharded in the same way as #ConcurrentMap, see BLI_concurrent_map.hh.
+ */
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_swiss_set.hh"
+
+namespace blender::threading {
+
+template<typename Key,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality,
+         typename Allocator = GuardedAllocator>
+class ConcurrentSet : NonCopyable, NonMovable {
+ public:
+  using ShardSet = SwissSet<Key, Hash, IsEqual, Allocator>;
+
+ private:
+  /* Make sure that the mutexes of different shards are not in the same cache line. */
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    ShardSet set;
+  };
+
+  Array<Shard, 0, Allocator> shards_;
+  uint64_t shard_mask_;
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+
+ public:
+  /**
+   * \param shards_num: Will be rounded up to a power of two.
+   */
+  explicit ConcurrentSet(const int64_t shards_num = concurrent_hash_table_default_shards_num)
+      : shards_(int64_t(power_of_2_max_u(uint(std::max<int64_t>(shards_num, 1)))))
+  {
+    shard_mask_ = uint64_t(shards_.size() - 1);
+  }
+
+  /**
+   * Add a key to the set. Returns true when the key has been newly added. When multiple threads
+   * add the same key at the same time, true is returned for exactly one of them.
+   */
+  bool add(const Key &key)
+  {
+    return this->add_as(key);
+  }
+  bool add(Key &&key)
+  {
+    return this->add_as(std::move(key));
+  }
+  template<typename ForwardKey> bool add_as(ForwardKey &&key)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.set.add_as(std::forward<ForwardKey>(key));
+  }
+
+  /**
+   * Returns true if the key is in the set.
+   */
+  bool contains(const Key &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.set.contains(key);
+  }
+
+  /**
+   * Deletes the key from the set. Returns true when the key did exist beforehand.
+   */
+  bool remove(const Key &key)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.set.remove(key);
+  }
+
+  /**
+   * Make sure that approximately the given number of keys can be added without growing the
+   * shards. Must not be called while other threads use the set.
+   */
+  void reserve(const int64_t n)
+  {
+    const int64_t n_per_shard = n / shards_.size() + 1;
+    for (Shard &shard : shards_) {
+      shard.set.reserve(n_per_shard);
+    }
+  }
+
+  /**
+   * Returns the total number of keys. Must not be called while other threads modify the set.
+   */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Shard &shard : shards_) {
+      size += shard.set.size();
+    }
+    return size;
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Removes all keys. Must not be called while other threads use the set.
+   */
+  void clear()
+  {
+    for (Shard &shard : shards_) {
+      shard.set.clear();
+    }
+  }
+
+  int64_t shards_num() const
+  {
+    return shards_.size();
+  }
+
+  /**
+   * Direct access to the set of a shard, e.g. to iterate over all keys in parallel. Must not be
+   * used while other threads modify the set.
+   */
+  const ShardSet &shard(const int64_t index) const
+  {
+    return shards_[index].set;
+  }
+
+ private:
+  Shard &shard_for_key(const Key &key)
+  {
+    return shards_[concurrent_hash_table_shard_index(hash_(key), shard_mask_)];
+  }
+
+  const Shard &shard_for_key(const Key &key) const
+  {
+    return const_cast<ConcurrentSet *>(this)->shard_for_key(key);
+  }
+};
+
+}  // namespace blender::threading
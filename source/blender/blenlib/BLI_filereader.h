@@ -30,12 +30,23 @@ struct FileReader;
 typedef ssize_t (*FileReaderReadFn)(struct FileReader *reader, void *buffer, size_t size);
 typedef off64_t (*FileReaderSeekFn)(struct FileReader *reader, off64_t offset, int whence);
 typedef void (*FileReaderCloseFn)(struct FileReader *reader);
+/**
+ * Return a pointer to `size` bytes of the underlying data starting at `offset`,
+ * without copying and without changing the current read offset.
+ * Returns NULL when the requested range is not available.
+ */
+typedef const void *(*FileReaderPeekFn)(struct FileReader *reader, off64_t offset, size_t size);
 
 /** General structure for all #FileReaders, implementations add custom fields at the end. */
 typedef struct FileReader {
   FileReaderReadFn read;
   FileReaderSeekFn seek;
   FileReaderCloseFn close;
+  /**
+   * Optional, only set for readers that are backed by memory (including memory-mapped files).
+   * Allows callers to use the data in-place instead of reading it into a separate buffer.
+   */
+  FileReaderPeekFn peek;
 
   off64_t offset;
 } FileReader;
@@ -60,6 +71,12 @@ FileReader *BLI_filereader_new_zstd(FileReader *base) ATTR_WARN_UNUSED_RESULT AT
 /** Create #FileReader from applying `Gzip` decompression on an underlying file. */
 FileReader *BLI_filereader_new_gzip(FileReader *base) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
 
+/**
+ * Check if an IO error occurred while accessing memory returned by #FileReader.peek.
+ * Always false for readers that are not backed by a memory-mapped file.
+ */
+bool BLI_filereader_peek_io_error(FileReader *reader) ATTR_NONNULL();
+
 #ifdef __cplusplus
 }
 #endif
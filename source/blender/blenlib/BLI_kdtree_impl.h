@@ -57,6 +57,36 @@ void BLI_kdtree_nd_(range_search_cb)(
     bool (*search_cb)(void *user_data, int index, const float co[KD_DIMS], float dist_sq),
     void *user_data);
 
+/**
+ * Find the nearest points for many query points in parallel.
+ *
+ * \param r_nearest: Array of `co_len * nearest_len_capacity` elements. The points found for query
+ * `i` are stored sorted by distance, starting at `i * nearest_len_capacity`.
+ * \param r_nearest_len: Array of `co_len` elements, filled with the number of points found for
+ * every query.
+ */
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          uint nearest_len_capacity,
+                                          int *r_nearest_len) ATTR_NONNULL(1, 4, 6);
+/**
+ * Range search for many query points in parallel.
+ *
+ * \param r_offsets: Array of `co_len + 1` elements. The indices of the points found for query `i`
+ * are `r_indices[r_offsets[i]]` up to `r_indices[r_offsets[i + 1]]`, in no particular order.
+ * \param r_indices: Allocated array of all found indices (caller is responsible for freeing),
+ * null when no points were found.
+ * \return The total number of found points.
+ */
+int BLI_kdtree_nd_(range_search_batch)(const KDTree *tree,
+                                       const float (*co)[KD_DIMS],
+                                       uint co_len,
+                                       float range,
+                                       int *r_offsets,
+                                       int **r_indices) ATTR_NONNULL(1, 5, 6);
+
 int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          float range,
                                          bool use_index_order,
@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Vector math operations applied to all elements of spans at once. The loops are compiled for
+ * multiple instruction sets, and the widest one supported by the CPU is chosen at runtime.
+ * Results are the same as applying the equivalent #BLI_math_vector.hh functions element-wise.
+ *
+ * These functions are single threaded, callers are expected to split the work into chunks
+ * with #threading::parallel_for first.
+ */
+
+#include "BLI_float4x4.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
+
+namespace blender::math {
+
+/** Transform all points by the matrix, including its translation. */
+void transform_points(const float4x4 &transform, MutableSpan<float3> points);
+void transform_points(const float4x4 &transform, Span<float3> src, MutableSpan<float3> dst);
+
+/** Normalize all vectors in place, vectors which are too short become zero. */
+void normalize_all(MutableSpan<float3> vectors);
+
+/** Dot products of the vectors with the same index in both spans. */
+void dot(Span<float3> a, Span<float3> b, MutableSpan<float> r_dot);
+/** Cross products of the vectors with the same index in both spans. */
+void cross(Span<float3> a, Span<float3> b, MutableSpan<float3> r_cross);
+
+/** Expand the element-wise minimum and maximum with all values. */
+void min_max(Span<float3> values, float3 &min, float3 &max);
+
+}  // namespace blender::math
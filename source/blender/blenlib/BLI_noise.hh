@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -103,6 +104,23 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        float roughness,
                                        float distortion);
 
+/**
+ * Batch versions of the distorted fractal perlin noise for many 3D positions with the same
+ * octaves, roughness and distortion. They are vectorized and give the same results as calling
+ * the single value functions for every position.
+ */
+
+void perlin_fractal_distorted(Span<float3> positions,
+                              float octaves,
+                              float roughness,
+                              float distortion,
+                              MutableSpan<float> r_values);
+void perlin_float3_fractal_distorted(Span<float3> positions,
+                                     float octaves,
+                                     float roughness,
+                                     float distortion,
+                                     MutableSpan<float3> r_values);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -12,6 +12,13 @@
 #  include <algorithm>
 #endif
 
+#include <cstring>
+#include <type_traits>
+
+#include "BLI_array.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
+
 namespace blender {
 
 #ifdef WITH_TBB
@@ -29,4 +36,171 @@ void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const C
 }
 #endif
 
+namespace radix_sort_detail {
+
+/** Number of bits that are sorted in one pass. */
+constexpr int digit_bits = 8;
+constexpr int64_t digits_num = int64_t(1) << digit_bits;
+/** Number of elements that one task processes in the counting and scatter steps. */
+constexpr int64_t chunk_size = 64 * 1024;
+
+template<typename T> constexpr bool is_radix_sortable_v = std::is_integral_v<T> ||
+                                                          std::is_floating_point_v<T>;
+
+/** Used as value type when only keys are sorted. */
+struct NoValues {
+};
+
+template<typename T> using RadixKey = std::conditional_t<sizeof(T) <= 4, uint32_t, uint64_t>;
+
+/**
+ * Map a key to an unsigned integer with the same order. Floats are ordered by their bit pattern,
+ * so -0.0 comes before 0.0 and NaN values are sorted to the start or end depending on their sign.
+ */
+template<typename T> inline RadixKey<T> to_radix_key(const T value)
+{
+  using UInt = RadixKey<T>;
+  constexpr UInt sign_bit = UInt(1) << (sizeof(T) * 8 - 1);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    return (bits & sign_bit) ? UInt(~bits) : UInt(bits | sign_bit);
+  }
+  else if constexpr (std::is_signed_v<T>) {
+    return UInt(std::make_unsigned_t<T>(value)) ^ sign_bit;
+  }
+  else {
+    return UInt(value);
+  }
+}
+
+/**
+ * Stable LSD radix sort. The values are optional and are reordered in the same way as the keys.
+ * Chunks of the input are counted and scattered in parallel. Passes in which all keys have the
+ * same digit are skipped, which makes sorting small numbers in large integer types cheap.
+ */
+template<typename KeyT, typename ValueT>
+void parallel_radix_sort_impl(MutableSpan<KeyT> keys, MutableSpan<ValueT> values)
+{
+  constexpr bool has_values = !std::is_same_v<ValueT, NoValues>;
+  constexpr int passes_num = int(sizeof(KeyT) * 8 / digit_bits);
+  const int64_t size = keys.size();
+  if (size <= 1) {
+    return;
+  }
+  const int64_t chunks_num = (size + chunk_size - 1) / chunk_size;
+
+  Array<KeyT> keys_buffer(size, NoInitialization());
+  MutableSpan<KeyT> src_keys = keys;
+  MutableSpan<KeyT> dst_keys = keys_buffer;
+  Array<ValueT> values_buffer(has_values ? size : 0, NoInitialization());
+  MutableSpan<ValueT> src_values = values;
+  MutableSpan<ValueT> dst_values;
+  if constexpr (has_values) {
+    dst_values = values_buffer;
+  }
+
+  /* Number of elements with a specific digit in each chunk. Becomes the offsets later on. */
+  Array<int64_t> offsets(chunks_num * digits_num);
+
+  for (const int pass : IndexRange(passes_num)) {
+    const int shift = pass * digit_bits;
+    const auto get_digit = [&](const KeyT key) {
+      return int64_t((to_radix_key(key) >> shift) & (digits_num - 1));
+    };
+
+    offsets.fill(0);
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        MutableSpan<int64_t> counts = offsets.as_mutable_span().slice(chunk * digits_num,
+                                                                      digits_num);
+        const IndexRange range = IndexRange(chunk * chunk_size, chunk_size).intersect(
+            IndexRange(size));
+        for (const int64_t i : range) {
+          counts[get_digit(src_keys[i])]++;
+        }
+      }
+    });
+
+    /* Convert counts to offsets. All elements of one digit come before the elements of the next
+     * digit, and within a digit the chunks are in order, which keeps the sort stable. */
+    int64_t offset = 0;
+    bool is_single_digit = false;
+    for (const int64_t digit : IndexRange(digits_num)) {
+      const int64_t digit_offset = offset;
+      for (const int64_t chunk : IndexRange(chunks_num)) {
+        int64_t &count = offsets[chunk * digits_num + digit];
+        const int64_t digit_chunk_size = count;
+        count = offset;
+        offset += digit_chunk_size;
+      }
+      if (offset - digit_offset == size) {
+        is_single_digit = true;
+        break;
+      }
+    }
+    if (is_single_digit) {
+      /* All keys have the same digit, so this pass would not change anything. */
+      continue;
+    }
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        MutableSpan<int64_t> chunk_offsets = offsets.as_mutable_span().slice(chunk * digits_num,
+                                                                             digits_num);
+        const IndexRange range = IndexRange(chunk * chunk_size, chunk_size).intersect(
+            IndexRange(size));
+        for (const int64_t i : range) {
+          const int64_t dst_index = chunk_offsets[get_digit(src_keys[i])]++;
+          dst_keys[dst_index] = src_keys[i];
+          if constexpr (has_values) {
+            dst_values[dst_index] = src_values[i];
+          }
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    if constexpr (has_values) {
+      std::swap(src_values, dst_values);
+    }
+  }
+
+  if (src_keys.data() != keys.data()) {
+    threading::parallel_for(IndexRange(size), 64 * 1024, [&](const IndexRange range) {
+      keys.slice(range).copy_from(src_keys.slice(range));
+      if constexpr (has_values) {
+        values.slice(range).copy_from(src_values.slice(range));
+      }
+    });
+  }
+}
+
+}  // namespace radix_sort_detail
+
+/**
+ * Sort integer or floating point keys in ascending order with a parallel radix sort. This is much
+ * faster than comparison based sorting for large arrays.
+ *
+ * Floats are ordered by their bit pattern, so -0.0 comes before 0.0.
+ */
+template<typename KeyT> void parallel_radix_sort(MutableSpan<KeyT> keys)
+{
+  static_assert(radix_sort_detail::is_radix_sortable_v<KeyT>);
+  radix_sort_detail::parallel_radix_sort_impl<KeyT, radix_sort_detail::NoValues>(keys, {});
+}
+
+/**
+ * Sort the keys in ascending order and reorder the values in the same way. The sort is stable:
+ * values with equal keys keep their relative order. A common use case is to sort indices by
+ * a key, e.g. a Morton code.
+ */
+template<typename KeyT, typename ValueT>
+void parallel_radix_sort(MutableSpan<KeyT> keys, MutableSpan<ValueT> values)
+{
+  static_assert(radix_sort_detail::is_radix_sortable_v<KeyT>);
+  static_assert(std::is_trivially_copyable_v<ValueT>);
+  BLI_assert(keys.size() == values.size());
+  radix_sort_detail::parallel_radix_sort_impl<KeyT, ValueT>(keys, values);
+}
+
 }  // namespace blender
@@ -0,0 +1,1182 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::SwissMap<Key, Value>` is a hash map with the same interface as `blender::Map`, but
+ * a different memory layout. It is meant for hot code that performs a very large number of
+ * insertions and lookups, e.g. when deduplicating the edges of a mesh.
+ *
+ * The hash table is implemented as a "swiss table" (see BLI_swiss_table.hh). Next to the slot
+ * array there is an array of control bytes, one for every slot. When looking up a key, the
+ * control bytes of 16 slots are compared with a few bits of the hash at once. Only slots whose
+ * control byte matched have to be compared with the key. This allows a higher max load factor
+ * (7/8 instead of 1/2) and keeps the number of actual key comparisons very low.
+ *
+ * Compared to `blender::Map`:
+ * - Switching between the two only requires changing the type, the methods have the same names
+ *   and semantics.
+ * - There is no small buffer optimization. An empty SwissMap does not allocate.
+ * - The probing strategy and slot type cannot be customized.
+ * - The hash provided by #Hash is remixed internally, so it does not have to be well distributed.
+ *   However, it has to be cheap, since it is recomputed when the map grows.
+ *
+ * `blender::Map` is still the better default choice for small maps.
+ */
+
+#include <algorithm>
+#include <optional>
+
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_swiss_table.hh"
+
+namespace blender {
+
+template<
+    /** Type of the keys stored in the map. Keys have to be movable. */
+    typename Key,
+    /** Type of the value that is stored per key. It has to be movable as well. */
+    typename Value,
+    /** The hash function used to hash the keys. See BLI_hash.hh. */
+    typename Hash = DefaultHash<Key>,
+    /** The equality operator used to compare keys. */
+    typename IsEqual = DefaultEquality,
+    /** The allocator used by this map. */
+    typename Allocator = GuardedAllocator>
+class SwissMap {
+ public:
+  using size_type = int64_t;
+
+ private:
+  struct Slot {
+    TypedBuffer<Key> key;
+    TypedBuffer<Value> value;
+  };
+
+  /**
+   * Control bytes of all slots. The number of slots is a power of two and a multiple of the group
+   * size. When no slots are allocated, this points to #swiss_table::empty_group.
+   */
+  int8_t *ctrl_;
+  Slot *slots_;
+  int64_t capacity_;
+
+  int64_t occupied_slots_;
+  int64_t removed_slots_;
+
+  /**
+   * The maximum number of slots that can be used (either occupied or removed) until the map has to
+   * grow. This is the total number of slots times the max load factor.
+   */
+  int64_t usable_slots_;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+  BLI_NO_UNIQUE_ADDRESS Allocator allocator_;
+
+  /** The max load factor is 7/8 = 87.5%. */
+#define LOAD_FACTOR 7, 8
+
+ public:
+  SwissMap(Allocator allocator = {}) noexcept
+      : ctrl_(const_cast<int8_t *>(swiss_table::empty_group)),
+        slots_(nullptr),
+        capacity_(0),
+        occupied_slots_(0),
+        removed_slots_(0),
+        usable_slots_(0),
+        hash_(),
+        is_equal_(),
+        allocator_(allocator)
+  {
+  }
+
+  SwissMap(NoExceptConstructor, Allocator allocator = {}) noexcept : SwissMap(allocator)
+  {
+  }
+
+  ~SwissMap()
+  {
+    this->destruct_and_free();
+  }
+
+  SwissMap(const SwissMap &other)
+      : SwissMap(NoExceptConstructor(), other.allocator_)
+  {
+    hash_ = other.hash_;
+    is_equal_ = other.is_equal_;
+    if (other.occupied_slots_ == 0) {
+      return;
+    }
+    this->allocate(other.capacity_);
+    for (const int64_t i : IndexRange(capacity_)) {
+      const int8_t ctrl = other.ctrl_[i];
+      if (swiss_table::ctrl_is_occupied(ctrl)) {
+        /* Only mark the slot as occupied once it is fully constructed, so that the destructor
+         * cleans up correctly if a copy constructor throws. */
+        new (slots_[i].key.ptr()) Key(*other.slots_[i].key);
+        try {
+          new (slots_[i].value.ptr()) Value(*other.slots_[i].value);
+        }
+        catch (...) {
+          slots_[i].key.ref().~Key();
+          throw;
+        }
+        occupied_slots_++;
+      }
+      else if (ctrl == swiss_table::ctrl_removed) {
+        /* Removed slots have to be kept, because probing sequences may continue past them. */
+        removed_slots_++;
+      }
+      ctrl_[i] = ctrl;
+    }
+  }
+
+  SwissMap(SwissMap &&other) noexcept
+      : ctrl_(other.ctrl_),
+        slots_(other.slots_),
+        capacity_(other.capacity_),
+        occupied_slots_(other.occupied_slots_),
+        removed_slots_(other.removed_slots_),
+        usable_slots_(other.usable_slots_),
+        hash_(std::move(other.hash_)),
+        is_equal_(std::move(other.is_equal_)),
+        allocator_(other.allocator_)
+  {
+    other.noexcept_reset();
+  }
+
+  SwissMap &operator=(const SwissMap &other)
+  {
+    return copy_assign_container(*this, other);
+  }
+
+  SwissMap &operator=(SwissMap &&other)
+  {
+    return move_assign_container(*this, std::move(other));
+  }
+
+  /**
+   * Insert a new key-value-pair into the map. This invokes undefined behavior when the key is in
+   * the map already.
+   */
+  void add_new(const Key &key, const Value &value)
+  {
+    this->add_new_as(key, value);
+  }
+  void add_new(const Key &key, Value &&value)
+  {
+    this->add_new_as(key, std::move(value));
+  }
+  void add_new(Key &&key, const Value &value)
+  {
+    this->add_new_as(std::move(key), value);
+  }
+  void add_new(Key &&key, Value &&value)
+  {
+    this->add_new_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  void add_new_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    BLI_assert(!this->contains_as(key));
+    this->ensure_can_add();
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash_(key));
+    const int64_t index = this->find_free_slot(mixed_hash);
+    this->occupy_slot(index,
+                      swiss_table::hash_to_ctrl(mixed_hash),
+                      std::forward<ForwardKey>(key),
+                      std::forward<ForwardValue>(value)...);
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->add_as(key, value);
+  }
+  bool add(const Key &key, Value &&value)
+  {
+    return this->add_as(key, std::move(value));
+  }
+  bool add(Key &&key, const Value &value)
+  {
+    return this->add_as(std::move(key), value);
+  }
+  bool add(Key &&key, Value &&value)
+  {
+    return this->add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    if (search.found) {
+      return false;
+    }
+    this->occupy_slot(search.index,
+                      search.ctrl,
+                      std::forward<ForwardKey>(key),
+                      std::forward<ForwardValue>(value)...);
+    return true;
+  }
+
+  /**
+   * Adds a key-value-pair to the map. If the map contained the key already, the corresponding
+   * value will be replaced.
+   * Returns true when the key has been newly added.
+   */
+  bool add_overwrite(const Key &key, const Value &value)
+  {
+    return this->add_overwrite_as(key, value);
+  }
+  bool add_overwrite(const Key &key, Value &&value)
+  {
+    return this->add_overwrite_as(key, std::move(value));
+  }
+  bool add_overwrite(Key &&key, const Value &value)
+  {
+    return this->add_overwrite_as(std::move(key), value);
+  }
+  bool add_overwrite(Key &&key, Value &&value)
+  {
+    return this->add_overwrite_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_overwrite_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    if (search.found) {
+      Value &old_value = *slots_[search.index].value;
+      old_value.~Value();
+      new (&old_value) Value(std::forward<ForwardValue>(value)...);
+      return false;
+    }
+    this->occupy_slot(search.index,
+                      search.ctrl,
+                      std::forward<ForwardKey>(key),
+                      std::forward<ForwardValue>(value)...);
+    return true;
+  }
+
+  /**
+   * Returns true if there is a key in the map that compares equal to the given key.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return this->find_slot(key, hash_(key)) != -1;
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. Returns true when the key was contained and is
+   * now removed, otherwise false.
+   */
+  bool remove(const Key &key)
+  {
+    return this->remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    if (index == -1) {
+      return false;
+    }
+    this->remove_slot(index);
+    return true;
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. This invokes undefined behavior when the key is
+   * not in the map.
+   */
+  void remove_contained(const Key &key)
+  {
+    this->remove_contained_as(key);
+  }
+  template<typename ForwardKey> void remove_contained_as(const ForwardKey &key)
+  {
+    this->remove_slot(this->find_contained_slot(key));
+  }
+
+  /**
+   * Get the value that is stored for the given key and remove it from the map. This invokes
+   * undefined behavior when the key is not in the map.
+   */
+  Value pop(const Key &key)
+  {
+    return this->pop_as(key);
+  }
+  template<typename ForwardKey> Value pop_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_contained_slot(key);
+    Value value = std::move(*slots_[index].value);
+    this->remove_slot(index);
+    return value;
+  }
+
+  /**
+   * Get the value that is stored for the given key and remove it from the map. If the key is not
+   * in the map, a value-less optional is returned.
+   */
+  std::optional<Value> pop_try(const Key &key)
+  {
+    return this->pop_try_as(key);
+  }
+  template<typename ForwardKey> std::optional<Value> pop_try_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    if (index == -1) {
+      return {};
+    }
+    std::optional<Value> value = std::move(*slots_[index].value);
+    this->remove_slot(index);
+    return value;
+  }
+
+  /**
+   * Get the value that corresponds to the given key and remove it from the map. If the key is not
+   * in the map, return the given default value instead.
+   */
+  Value pop_default(const Key &key, const Value &default_value)
+  {
+    return this->pop_default_as(key, default_value);
+  }
+  Value pop_default(const Key &key, Value &&default_value)
+  {
+    return this->pop_default_as(key, std::move(default_value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value pop_default_as(const ForwardKey &key, ForwardValue &&...default_value)
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    if (index == -1) {
+      return Value(std::forward<ForwardValue>(default_value)...);
+    }
+    Value value = std::move(*slots_[index].value);
+    this->remove_slot(index);
+    return value;
+  }
+
+  /**
+   * When the key did not yet exist in the map, the create_value function is called. Otherwise the
+   * modify_value function is called. See #Map::add_or_modify.
+   */
+  template<typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify(const Key &key,
+                     const CreateValueF &create_value,
+                     const ModifyValueF &modify_value) -> decltype(create_value(nullptr))
+  {
+    return this->add_or_modify_as(key, create_value, modify_value);
+  }
+  template<typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify(Key &&key, const CreateValueF &create_value, const ModifyValueF &modify_value)
+      -> decltype(create_value(nullptr))
+  {
+    return this->add_or_modify_as(std::move(key), create_value, modify_value);
+  }
+  template<typename ForwardKey, typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify_as(ForwardKey &&key,
+                        const CreateValueF &create_value,
+                        const ModifyValueF &modify_value) -> decltype(create_value(nullptr))
+  {
+    using CreateReturnT = decltype(create_value(nullptr));
+    using ModifyReturnT = decltype(modify_value(nullptr));
+    BLI_STATIC_ASSERT((std::is_same_v<CreateReturnT, ModifyReturnT>),
+                      "Both callbacks should return the same type.");
+
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    Slot &slot = slots_[search.index];
+    if (search.found) {
+      return modify_value(slot.value.ptr());
+    }
+    Value *value_ptr = slot.value.ptr();
+    if constexpr (std::is_void_v<CreateReturnT>) {
+      create_value(value_ptr);
+      this->occupy_slot_with_value(search.index, search.ctrl, std::forward<ForwardKey>(key));
+      return;
+    }
+    else {
+      auto &&return_value = create_value(value_ptr);
+      this->occupy_slot_with_value(search.index, search.ctrl, std::forward<ForwardKey>(key));
+      return return_value;
+    }
+  }
+
+  /**
+   * Returns a pointer to the value that corresponds to the given key. If the key is not in the
+   * map, nullptr is returned.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    return this->lookup_ptr_as(key);
+  }
+  Value *lookup_ptr(const Key &key)
+  {
+    return this->lookup_ptr_as(key);
+  }
+  template<typename ForwardKey> const Value *lookup_ptr_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    return (index == -1) ? nullptr : slots_[index].value.ptr();
+  }
+  template<typename ForwardKey> Value *lookup_ptr_as(const ForwardKey &key)
+  {
+    return const_cast<Value *>(const_cast<const SwissMap *>(this)->lookup_ptr_as(key));
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. This invokes undefined
+   * behavior when the key is not in the map.
+   */
+  const Value &lookup(const Key &key) const
+  {
+    return this->lookup_as(key);
+  }
+  Value &lookup(const Key &key)
+  {
+    return this->lookup_as(key);
+  }
+  template<typename ForwardKey> const Value &lookup_as(const ForwardKey &key) const
+  {
+    return *slots_[this->find_contained_slot(key)].value;
+  }
+  template<typename ForwardKey> Value &lookup_as(const ForwardKey &key)
+  {
+    return *slots_[this->find_contained_slot(key)].value;
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the
+   * map, the provided default_value is returned.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    return this->lookup_default_as(key, default_value);
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value lookup_default_as(const ForwardKey &key, ForwardValue &&...default_value) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    if (ptr != nullptr) {
+      return *ptr;
+    }
+    return Value(std::forward<ForwardValue>(default_value)...);
+  }
+
+  /**
+   * Returns a reference to the value corresponding to the given key. If the key is not in the map,
+   * a new key-value-pair is added and a reference to the value in the map is returned.
+   */
+  Value &lookup_or_add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_as(key, value);
+  }
+  Value &lookup_or_add(const Key &key, Value &&value)
+  {
+    return this->lookup_or_add_as(key, std::move(value));
+  }
+  Value &lookup_or_add(Key &&key, const Value &value)
+  {
+    return this->lookup_or_add_as(std::move(key), value);
+  }
+  Value &lookup_or_add(Key &&key, Value &&value)
+  {
+    return this->lookup_or_add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value &lookup_or_add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    if (!search.found) {
+      this->occupy_slot(search.index,
+                        search.ctrl,
+                        std::forward<ForwardKey>(key),
+                        std::forward<ForwardValue>(value)...);
+    }
+    return *slots_[search.index].value;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added. The create_value callback is only called when the key did
+   * not exist yet.
+   */
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(key, create_value);
+  }
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(Key &&key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(std::move(key), create_value);
+  }
+  template<typename ForwardKey, typename CreateValueF>
+  Value &lookup_or_add_cb_as(ForwardKey &&key, const CreateValueF &create_value)
+  {
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    if (!search.found) {
+      this->occupy_slot(search.index, search.ctrl, std::forward<ForwardKey>(key), create_value());
+    }
+    return *slots_[search.index].value;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added with a default constructed value.
+   */
+  Value &lookup_or_add_default(const Key &key)
+  {
+    return this->lookup_or_add_default_as(key);
+  }
+  Value &lookup_or_add_default(Key &&key)
+  {
+    return this->lookup_or_add_default_as(std::move(key));
+  }
+  template<typename ForwardKey> Value &lookup_or_add_default_as(ForwardKey &&key)
+  {
+    return this->lookup_or_add_cb_as(std::forward<ForwardKey>(key), []() { return Value(); });
+  }
+
+  /**
+   * Returns the key that is stored in the map that compares equal to the given key. This invokes
+   * undefined behavior when the key is not in the map.
+   */
+  const Key &lookup_key(const Key &key) const
+  {
+    return this->lookup_key_as(key);
+  }
+  template<typename ForwardKey> const Key &lookup_key_as(const ForwardKey &key) const
+  {
+    return *slots_[this->find_contained_slot(key)].key;
+  }
+
+  /* Common base class for all iterators below. */
+  struct BaseIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+
+   protected:
+    const int8_t *ctrl_;
+    Slot *slots_;
+    int64_t total_slots_;
+    int64_t current_slot_;
+
+    friend SwissMap;
+
+   public:
+    BaseIterator(const int8_t *ctrl,
+                 const Slot *slots,
+                 const int64_t total_slots,
+                 const int64_t current_slot)
+        : ctrl_(ctrl),
+          slots_(const_cast<Slot *>(slots)),
+          total_slots_(total_slots),
+          current_slot_(current_slot)
+    {
+    }
+
+    BaseIterator &operator++()
+    {
+      while (++current_slot_ < total_slots_) {
+        if (swiss_table::ctrl_is_occupied(ctrl_[current_slot_])) {
+          break;
+        }
+      }
+      return *this;
+    }
+
+    BaseIterator operator++(int)
+    {
+      BaseIterator copied_iterator = *this;
+      ++(*this);
+      return copied_iterator;
+    }
+
+    friend bool operator!=(const BaseIterator &a, const BaseIterator &b)
+    {
+      BLI_assert(a.slots_ == b.slots_);
+      BLI_assert(a.total_slots_ == b.total_slots_);
+      return a.current_slot_ != b.current_slot_;
+    }
+
+    friend bool operator==(const BaseIterator &a, const BaseIterator &b)
+    {
+      return !(a != b);
+    }
+
+   protected:
+    Slot &current_slot() const
+    {
+      return slots_[current_slot_];
+    }
+  };
+
+  template<typename SubIterator> class BaseIteratorRange : public BaseIterator {
+   public:
+    BaseIteratorRange(const int8_t *ctrl,
+                      const Slot *slots,
+                      int64_t total_slots,
+                      int64_t current_slot)
+        : BaseIterator(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    SubIterator begin() const
+    {
+      for (int64_t i = 0; i < this->total_slots_; i++) {
+        if (swiss_table::ctrl_is_occupied(this->ctrl_[i])) {
+          return SubIterator(this->ctrl_, this->slots_, this->total_slots_, i);
+        }
+      }
+      return this->end();
+    }
+
+    SubIterator end() const
+    {
+      return SubIterator(this->ctrl_, this->slots_, this->total_slots_, this->total_slots_);
+    }
+  };
+
+  class KeyIterator final : public BaseIteratorRange<KeyIterator> {
+   public:
+    using value_type = Key;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    using BaseIteratorRange<KeyIterator>::BaseIteratorRange;
+
+    const Key &operator*() const
+    {
+      return *this->current_slot().key;
+    }
+  };
+
+  class ValueIterator final : public BaseIteratorRange<ValueIterator> {
+   public:
+    using value_type = Value;
+    using pointer = const Value *;
+    using reference = const Value &;
+
+    using BaseIteratorRange<ValueIterator>::BaseIteratorRange;
+
+    const Value &operator*() const
+    {
+      return *this->current_slot().value;
+    }
+  };
+
+  class MutableValueIterator final : public BaseIteratorRange<MutableValueIterator> {
+   public:
+    using value_type = Value;
+    using pointer = Value *;
+    using reference = Value &;
+
+    using BaseIteratorRange<MutableValueIterator>::BaseIteratorRange;
+
+    Value &operator*()
+    {
+      return *this->current_slot().value;
+    }
+  };
+
+  struct Item {
+    const Key &key;
+    const Value &value;
+  };
+
+  struct MutableItem {
+    const Key &key;
+    Value &value;
+
+    operator Item() const
+    {
+      return Item{key, value};
+    }
+  };
+
+  class ItemIterator final : public BaseIteratorRange<ItemIterator> {
+   public:
+    using value_type = Item;
+    using pointer = Item *;
+    using reference = Item &;
+
+    using BaseIteratorRange<ItemIterator>::BaseIteratorRange;
+
+    Item operator*() const
+    {
+      const Slot &slot = this->current_slot();
+      return {*slot.key, *slot.value};
+    }
+  };
+
+  class MutableItemIterator final : public BaseIteratorRange<MutableItemIterator> {
+   public:
+    using value_type = MutableItem;
+    using pointer = MutableItem *;
+    using reference = MutableItem &;
+
+    using BaseIteratorRange<MutableItemIterator>::BaseIteratorRange;
+
+    MutableItem operator*() const
+    {
+      Slot &slot = this->current_slot();
+      return {*slot.key, *slot.value};
+    }
+  };
+
+  /**
+   * Allows writing a range-for loop that iterates over all keys. The iterator is invalidated, when
+   * the map is changed.
+   */
+  KeyIterator keys() const
+  {
+    return KeyIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all values in the map. The iterator is invalidated, when the map is
+   * changed.
+   */
+  ValueIterator values() const
+  {
+    return ValueIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all values in the map and allows you to change the values. The
+   * iterator is invalidated, when the map is changed.
+   */
+  MutableValueIterator values()
+  {
+    return MutableValueIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all key-value-pairs in the map. The iterator is invalidated, when the
+   * map is changed.
+   */
+  ItemIterator items() const
+  {
+    return ItemIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all key-value-pairs in the map that also allows modifying the values
+   * (but not the keys). The iterator is invalidated, when the map is changed.
+   */
+  MutableItemIterator items()
+  {
+    return MutableItemIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Remove the key-value-pair that the iterator is currently pointing at.
+   * It is valid to call this method while iterating over the map. However, after this method has
+   * been called, the removed element must not be accessed anymore.
+   */
+  void remove(const BaseIterator &iterator)
+  {
+    BLI_assert(swiss_table::ctrl_is_occupied(ctrl_[iterator.current_slot_]));
+    this->remove_slot(iterator.current_slot_);
+  }
+
+  /**
+   * Remove all key-value-pairs for that the given predicate is true.
+   */
+  template<typename Predicate> void remove_if(Predicate &&predicate)
+  {
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (swiss_table::ctrl_is_occupied(ctrl_[i])) {
+        Slot &slot = slots_[i];
+        if (predicate(MutableItem{*slot.key, *slot.value})) {
+          this->remove_slot(i);
+        }
+      }
+    }
+  }
+
+  /**
+   * Print common statistics like size and collision count. This is useful for debugging purposes.
+   */
+  void print_stats(StringRef name = "") const
+  {
+    HashTableStats stats(*this, this->keys());
+    stats.print(name);
+  }
+
+  /**
+   * Return the number of key-value-pairs that are stored in the map.
+   */
+  int64_t size() const
+  {
+    return occupied_slots_;
+  }
+
+  /**
+   * Returns true if there are no elements in the map.
+   */
+  bool is_empty() const
+  {
+    return occupied_slots_ == 0;
+  }
+
+  /**
+   * Returns the number of available slots. This is mostly for debugging purposes.
+   */
+  int64_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * Returns the amount of removed slots in the map. This is mostly for debugging purposes.
+   */
+  int64_t removed_amount() const
+  {
+    return removed_slots_;
+  }
+
+  /**
+   * Returns the bytes required per element. This is mostly for debugging purposes.
+   */
+  int64_t size_per_element() const
+  {
+    return sizeof(Slot) + sizeof(int8_t);
+  }
+
+  /**
+   * Returns the approximate memory requirements of the map in bytes.
+   */
+  int64_t size_in_bytes() const
+  {
+    return this->size_per_element() * capacity_;
+  }
+
+  /**
+   * Potentially resize the map such that the specified number of elements can be added without
+   * another grow operation.
+   */
+  void reserve(const int64_t n)
+  {
+    if (usable_slots_ - removed_slots_ < n) {
+      this->realloc_and_reinsert(n);
+    }
+  }
+
+  /**
+   * Removes all key-value-pairs from the map. The allocated slots are kept.
+   */
+  void clear()
+  {
+    this->destruct_occupied();
+    std::fill_n(ctrl_, capacity_, swiss_table::ctrl_empty);
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+  }
+
+  /**
+   * Get the number of groups that have to be visited in addition to the first one to find the key
+   * or determine that it is not in the map.
+   */
+  int64_t count_collisions(const Key &key) const
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash_(key));
+    const int8_t ctrl = swiss_table::hash_to_ctrl(mixed_hash);
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    int64_t collisions = 0;
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      for (const int64_t i : group.match(ctrl)) {
+        if (is_equal_(key, *slots_[offset + i].key)) {
+          return collisions;
+        }
+      }
+      if (group.match_empty()) {
+        return collisions;
+      }
+      collisions++;
+      probe.next();
+    }
+  }
+
+ private:
+  struct SlotSearch {
+    /** Index of the slot that contains the key or of the slot where it should be inserted. */
+    int64_t index;
+    /** Control byte for the key. */
+    int8_t ctrl;
+    bool found;
+  };
+
+  uint64_t group_mask() const
+  {
+    return uint64_t(std::max<int64_t>(capacity_ / swiss_table::group_width, 1) - 1);
+  }
+
+  static size_t slots_offset(const int64_t capacity)
+  {
+    return size_t(ceil_to_multiple_ul(size_t(capacity), alignof(Slot)));
+  }
+
+  static constexpr size_t buffer_alignment()
+  {
+    return std::max<size_t>(swiss_table::group_width, alignof(Slot));
+  }
+
+  /** Allocate control bytes and slots for the given number of slots and mark them as empty. */
+  void allocate(const int64_t capacity)
+  {
+    BLI_assert(capacity_ == 0);
+    BLI_assert(capacity % swiss_table::group_width == 0);
+    BLI_assert((capacity & (capacity - 1)) == 0);
+    const size_t offset = slots_offset(capacity);
+    void *buffer = allocator_.allocate(
+        offset + sizeof(Slot) * size_t(capacity), buffer_alignment(), AT);
+    ctrl_ = static_cast<int8_t *>(buffer);
+    slots_ = reinterpret_cast<Slot *>(static_cast<char *>(buffer) + offset);
+    capacity_ = capacity;
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+    usable_slots_ = floor_multiplication_with_fraction(capacity, LOAD_FACTOR);
+    std::fill_n(ctrl_, capacity, swiss_table::ctrl_empty);
+  }
+
+  void destruct_occupied()
+  {
+    if constexpr (!(std::is_trivially_destructible_v<Key> &&
+                    std::is_trivially_destructible_v<Value>)) {
+      for (const int64_t i : IndexRange(capacity_)) {
+        if (swiss_table::ctrl_is_occupied(ctrl_[i])) {
+          slots_[i].key.ref().~Key();
+          slots_[i].value.ref().~Value();
+        }
+      }
+    }
+  }
+
+  void destruct_and_free()
+  {
+    if (capacity_ > 0) {
+      this->destruct_occupied();
+      allocator_.deallocate(ctrl_);
+    }
+  }
+
+  /**
+   * Reset the map to the empty state without destructing the stored elements. Used after the
+   * elements have been moved elsewhere.
+   */
+  void noexcept_reset() noexcept
+  {
+    ctrl_ = const_cast<int8_t *>(swiss_table::empty_group);
+    slots_ = nullptr;
+    capacity_ = 0;
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+    usable_slots_ = 0;
+  }
+
+  BLI_NOINLINE void realloc_and_reinsert(const int64_t min_usable_slots)
+  {
+    int64_t total_slots, usable_slots;
+    LoadFactor(LOAD_FACTOR).compute_total_and_usable_slots(
+        swiss_table::group_width, min_usable_slots, &total_slots, &usable_slots);
+
+    int8_t *old_ctrl = ctrl_;
+    Slot *old_slots = slots_;
+    const int64_t old_capacity = capacity_;
+
+    capacity_ = 0;
+    this->allocate(total_slots);
+    for (const int64_t i : IndexRange(old_capacity)) {
+      if (swiss_table::ctrl_is_occupied(old_ctrl[i])) {
+        Slot &old_slot = old_slots[i];
+        try {
+          this->add_after_grow(old_slot);
+        }
+        catch (...) {
+          /* Destruct all elements in both tables and leave the map in an empty state. */
+          this->destruct_and_free();
+          for (const int64_t j : IndexRange(i, old_capacity - i)) {
+            if (swiss_table::ctrl_is_occupied(old_ctrl[j])) {
+              old_slots[j].key.ref().~Key();
+              old_slots[j].value.ref().~Value();
+            }
+          }
+          allocator_.deallocate(old_ctrl);
+          this->noexcept_reset();
+          throw;
+        }
+        old_slot.key.ref().~Key();
+        old_slot.value.ref().~Value();
+      }
+    }
+    if (old_capacity > 0) {
+      allocator_.deallocate(old_ctrl);
+    }
+  }
+
+  /** Move the element into the newly allocated slots, which are known to not contain it. */
+  void add_after_grow(Slot &old_slot)
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash_(*old_slot.key));
+    const int64_t index = this->find_free_slot(mixed_hash);
+    Slot &new_slot = slots_[index];
+    new (new_slot.value.ptr()) Value(std::move(*old_slot.value));
+    this->occupy_slot_with_value(
+        index, swiss_table::hash_to_ctrl(mixed_hash), std::move(*old_slot.key));
+  }
+
+  void ensure_can_add()
+  {
+    if (occupied_slots_ + removed_slots_ >= usable_slots_) {
+      this->realloc_and_reinsert(occupied_slots_ + 1);
+      BLI_assert(occupied_slots_ + removed_slots_ < usable_slots_);
+    }
+  }
+
+  template<typename ForwardKey>
+  int64_t find_slot(const ForwardKey &key, const uint64_t hash) const
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash);
+    const int8_t ctrl = swiss_table::hash_to_ctrl(mixed_hash);
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      for (const int64_t i : group.match(ctrl)) {
+        if (is_equal_(key, *slots_[offset + i].key)) {
+          return offset + i;
+        }
+      }
+      if (group.match_empty()) {
+        return -1;
+      }
+      probe.next();
+    }
+  }
+
+  template<typename ForwardKey> int64_t find_contained_slot(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    BLI_assert(index >= 0);
+    return index;
+  }
+
+  /** Find the first slot in the probing sequence that a new key can be inserted into. */
+  int64_t find_free_slot(const uint64_t mixed_hash) const
+  {
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      if (const swiss_table::GroupMask free = group.match_empty_or_removed()) {
+        return offset + free.first();
+      }
+      probe.next();
+    }
+  }
+
+  /**
+   * Find the slot that contains the key. If there is none, find the slot the key should be
+   * inserted into. The caller has to make sure that there is a free slot.
+   */
+  template<typename ForwardKey>
+  SlotSearch find_slot_or_free_slot(const ForwardKey &key, const uint64_t hash) const
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash);
+    const int8_t ctrl = swiss_table::hash_to_ctrl(mixed_hash);
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    int64_t free_index = -1;
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      for (const int64_t i : group.match(ctrl)) {
+        if (is_equal_(key, *slots_[offset + i].key)) {
+          return {offset + i, ctrl, true};
+        }
+      }
+      if (free_index == -1) {
+        if (const swiss_table::GroupMask free = group.match_empty_or_removed()) {
+          free_index = offset + free.first();
+        }
+      }
+      if (group.match_empty()) {
+        return {free_index, ctrl, false};
+      }
+      probe.next();
+    }
+  }
+
+  template<typename ForwardKey, typename... ForwardValue>
+  void occupy_slot(const int64_t index,
+                   const int8_t ctrl,
+                   ForwardKey &&key,
+                   ForwardValue &&...value)
+  {
+    Slot &slot = slots_[index];
+    new (slot.value.ptr()) Value(std::forward<ForwardValue>(value)...);
+    this->occupy_slot_with_value(index, ctrl, std::forward<ForwardKey>(key));
+  }
+
+  /** Like #occupy_slot, but the value has been constructed in the slot already. */
+  template<typename ForwardKey>
+  void occupy_slot_with_value(const int64_t index, const int8_t ctrl, ForwardKey &&key)
+  {
+    BLI_assert(!swiss_table::ctrl_is_occupied(ctrl_[index]));
+    Slot &slot = slots_[index];
+    try {
+      new (slot.key.ptr()) Key(std::forward<ForwardKey>(key));
+    }
+    catch (...) {
+      slot.value.ref().~Value();
+      throw;
+    }
+    if (ctrl_[index] == swiss_table::ctrl_removed) {
+      removed_slots_--;
+    }
+    ctrl_[index] = ctrl;
+    occupied_slots_++;
+  }
+
+  void remove_slot(const int64_t index)
+  {
+    BLI_assert(swiss_table::ctrl_is_occupied(ctrl_[index]));
+    Slot &slot = slots_[index];
+    slot.key.ref().~Key();
+    slot.value.ref().~Value();
+    occupied_slots_--;
+    /* Lookups only stop at groups that contain an empty slot. If the group has an empty slot
+     * already, no probing sequence continues past it, so the slot can become empty again. */
+    const int64_t group_offset = index & ~(swiss_table::group_width - 1);
+    if (swiss_table::Group(ctrl_ + group_offset).match_empty()) {
+      ctrl_[index] = swiss_table::ctrl_empty;
+    }
+    else {
+      ctrl_[index] = swiss_table::ctrl_removed;
+      removed_slots_++;
+    }
+  }
+};
+
+#undef LOAD_FACTOR
+
+}  // namespace blender
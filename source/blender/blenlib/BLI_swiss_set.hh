@@ -0,0 +1,777 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::SwissSet<Key>` is an unordered container for unique elements of type `Key`. It has
+ * the same interface as `blender::Set`, but is implemented as a "swiss table" like
+ * `blender::SwissMap`. See BLI_swiss_map.hh and BLI_swiss_table.hh for details on when to use it
+ * and how it works.
+ */
+
+#include <algorithm>
+
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_span.hh"
+#include "BLI_swiss_table.hh"
+
+namespace blender {
+
+template<
+    /** Type of the elements that are stored in this set. It has to be movable. */
+    typename Key,
+    /** The hash function used to hash the keys. See BLI_hash.hh. */
+    typename Hash = DefaultHash<Key>,
+    /** The equality operator used to compare keys. */
+    typename IsEqual = DefaultEquality,
+    /** The allocator used by this set. */
+    typename Allocator = GuardedAllocator>
+class SwissSet {
+ public:
+  using size_type = int64_t;
+
+ private:
+  using Slot = TypedBuffer<Key>;
+
+  /**
+   * Control bytes of all slots. The number of slots is a power of two and a multiple of the group
+   * size. When no slots are allocated, this points to #swiss_table::empty_group.
+   */
+  int8_t *ctrl_;
+  Slot *slots_;
+  int64_t capacity_;
+
+  int64_t occupied_slots_;
+  int64_t removed_slots_;
+
+  /**
+   * The maximum number of slots that can be used (either occupied or removed) until the set has to
+   * grow. This is the total number of slots times the max load factor.
+   */
+  int64_t usable_slots_;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+  BLI_NO_UNIQUE_ADDRESS Allocator allocator_;
+
+  /** The max load factor is 7/8 = 87.5%. */
+#define LOAD_FACTOR 7, 8
+
+ public:
+  SwissSet(Allocator allocator = {}) noexcept
+      : ctrl_(const_cast<int8_t *>(swiss_table::empty_group)),
+        slots_(nullptr),
+        capacity_(0),
+        occupied_slots_(0),
+        removed_slots_(0),
+        usable_slots_(0),
+        hash_(),
+        is_equal_(),
+        allocator_(allocator)
+  {
+  }
+
+  SwissSet(NoExceptConstructor, Allocator allocator = {}) noexcept : SwissSet(allocator)
+  {
+  }
+
+  SwissSet(Span<Key> keys, Allocator allocator = {}) : SwissSet(NoExceptConstructor(), allocator)
+  {
+    this->add_multiple(keys);
+  }
+
+  SwissSet(const std::initializer_list<Key> &keys) : SwissSet(Span<Key>(keys))
+  {
+  }
+
+  ~SwissSet()
+  {
+    this->destruct_and_free();
+  }
+
+  SwissSet(const SwissSet &other) : SwissSet(NoExceptConstructor(), other.allocator_)
+  {
+    hash_ = other.hash_;
+    is_equal_ = other.is_equal_;
+    if (other.occupied_slots_ == 0) {
+      return;
+    }
+    this->allocate(other.capacity_);
+    for (const int64_t i : IndexRange(capacity_)) {
+      const int8_t ctrl = other.ctrl_[i];
+      if (swiss_table::ctrl_is_occupied(ctrl)) {
+        new (slots_[i].ptr()) Key(*other.slots_[i]);
+        occupied_slots_++;
+      }
+      else if (ctrl == swiss_table::ctrl_removed) {
+        /* Removed slots have to be kept, because probing sequences may continue past them. */
+        removed_slots_++;
+      }
+      ctrl_[i] = ctrl;
+    }
+  }
+
+  SwissSet(SwissSet &&other) noexcept
+      : ctrl_(other.ctrl_),
+        slots_(other.slots_),
+        capacity_(other.capacity_),
+        occupied_slots_(other.occupied_slots_),
+        removed_slots_(other.removed_slots_),
+        usable_slots_(other.usable_slots_),
+        hash_(std::move(other.hash_)),
+        is_equal_(std::move(other.is_equal_)),
+        allocator_(other.allocator_)
+  {
+    other.noexcept_reset();
+  }
+
+  SwissSet &operator=(const SwissSet &other)
+  {
+    return copy_assign_container(*this, other);
+  }
+
+  SwissSet &operator=(SwissSet &&other)
+  {
+    return move_assign_container(*this, std::move(other));
+  }
+
+  /**
+   * Add a new key to the set. This invokes undefined behavior when the key is in the set already.
+   */
+  void add_new(const Key &key)
+  {
+    this->add_new_as(key);
+  }
+  void add_new(Key &&key)
+  {
+    this->add_new_as(std::move(key));
+  }
+  template<typename ForwardKey> void add_new_as(ForwardKey &&key)
+  {
+    BLI_assert(!this->contains_as(key));
+    this->ensure_can_add();
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash_(key));
+    const int64_t index = this->find_free_slot(mixed_hash);
+    this->occupy_slot(index, swiss_table::hash_to_ctrl(mixed_hash), std::forward<ForwardKey>(key));
+  }
+
+  /**
+   * Add a key to the set. If the key exists in the set already, nothing is done. Returns true when
+   * the key has been newly added.
+   */
+  bool add(const Key &key)
+  {
+    return this->add_as(key);
+  }
+  bool add(Key &&key)
+  {
+    return this->add_as(std::move(key));
+  }
+  template<typename ForwardKey> bool add_as(ForwardKey &&key)
+  {
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    if (search.found) {
+      return false;
+    }
+    this->occupy_slot(search.index, search.ctrl, std::forward<ForwardKey>(key));
+    return true;
+  }
+
+  /**
+   * Convenience function to add many keys to the set at once. Duplicates are removed
+   * automatically.
+   */
+  void add_multiple(Span<Key> keys)
+  {
+    for (const Key &key : keys) {
+      this->add(key);
+    }
+  }
+
+  /**
+   * Convenience function to add many new keys to the set at once. The keys must not exist in the
+   * set before and there must not be duplicates in the array.
+   */
+  void add_multiple_new(Span<Key> keys)
+  {
+    for (const Key &key : keys) {
+      this->add_new(key);
+    }
+  }
+
+  /**
+   * Returns true if the key is in the set.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return this->find_slot(key, hash_(key)) != -1;
+  }
+
+  /**
+   * Returns the key that is stored in the set that compares equal to the given key. This invokes
+   * undefined behavior when the key is not in the set.
+   */
+  const Key &lookup_key(const Key &key) const
+  {
+    return this->lookup_key_as(key);
+  }
+  template<typename ForwardKey> const Key &lookup_key_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    BLI_assert(index >= 0);
+    return *slots_[index];
+  }
+
+  /**
+   * Returns the key that is stored in the set that compares equal to the given key. If the key is
+   * not in the set, the given default value is returned instead.
+   */
+  const Key &lookup_key_default(const Key &key, const Key &default_value) const
+  {
+    return this->lookup_key_default_as(key, default_value);
+  }
+  template<typename ForwardKey>
+  const Key &lookup_key_default_as(const ForwardKey &key, const Key &default_key) const
+  {
+    const Key *ptr = this->lookup_key_ptr_as(key);
+    if (ptr == nullptr) {
+      return default_key;
+    }
+    return *ptr;
+  }
+
+  /**
+   * Returns a pointer to the key that is stored in the set that compares equal to the given key.
+   * If the key is not in the set, nullptr is returned instead.
+   */
+  const Key *lookup_key_ptr(const Key &key) const
+  {
+    return this->lookup_key_ptr_as(key);
+  }
+  template<typename ForwardKey> const Key *lookup_key_ptr_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    return (index == -1) ? nullptr : slots_[index].ptr();
+  }
+
+  /**
+   * Returns the key in the set that compares equal to the given key. If it does not exist, the key
+   * is newly added.
+   */
+  const Key &lookup_key_or_add(const Key &key)
+  {
+    return this->lookup_key_or_add_as(key);
+  }
+  const Key &lookup_key_or_add(Key &&key)
+  {
+    return this->lookup_key_or_add_as(std::move(key));
+  }
+  template<typename ForwardKey> const Key &lookup_key_or_add_as(ForwardKey &&key)
+  {
+    this->ensure_can_add();
+    const SlotSearch search = this->find_slot_or_free_slot(key, hash_(key));
+    if (!search.found) {
+      this->occupy_slot(search.index, search.ctrl, std::forward<ForwardKey>(key));
+    }
+    return *slots_[search.index];
+  }
+
+  /**
+   * Deletes the key from the set. Returns true when the key did exist beforehand, otherwise false.
+   */
+  bool remove(const Key &key)
+  {
+    return this->remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    if (index == -1) {
+      return false;
+    }
+    this->remove_slot(index);
+    return true;
+  }
+
+  /**
+   * Deletes the key from the set. This invokes undefined behavior when the key is not in the set.
+   */
+  void remove_contained(const Key &key)
+  {
+    this->remove_contained_as(key);
+  }
+  template<typename ForwardKey> void remove_contained_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_slot(key, hash_(key));
+    BLI_assert(index >= 0);
+    this->remove_slot(index);
+  }
+
+  /**
+   * An iterator that can iterate over all keys in the set. The iterator is invalidated when the
+   * set is moved or when it is grown.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using pointer = const Key *;
+    using reference = const Key &;
+    using difference_type = std::ptrdiff_t;
+
+   private:
+    const int8_t *ctrl_;
+    const Slot *slots_;
+    int64_t total_slots_;
+    int64_t current_slot_;
+
+    friend SwissSet;
+
+   public:
+    Iterator(const int8_t *ctrl, const Slot *slots, int64_t total_slots, int64_t current_slot)
+        : ctrl_(ctrl), slots_(slots), total_slots_(total_slots), current_slot_(current_slot)
+    {
+    }
+
+    Iterator &operator++()
+    {
+      while (++current_slot_ < total_slots_) {
+        if (swiss_table::ctrl_is_occupied(ctrl_[current_slot_])) {
+          break;
+        }
+      }
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator copied_iterator = *this;
+      ++(*this);
+      return copied_iterator;
+    }
+
+    const Key &operator*() const
+    {
+      return *slots_[current_slot_];
+    }
+
+    const Key *operator->() const
+    {
+      return slots_[current_slot_].ptr();
+    }
+
+    friend bool operator!=(const Iterator &a, const Iterator &b)
+    {
+      BLI_assert(a.slots_ == b.slots_);
+      BLI_assert(a.total_slots_ == b.total_slots_);
+      return a.current_slot_ != b.current_slot_;
+    }
+
+    friend bool operator==(const Iterator &a, const Iterator &b)
+    {
+      return !(a != b);
+    }
+  };
+
+  Iterator begin() const
+  {
+    for (int64_t i = 0; i < capacity_; i++) {
+      if (swiss_table::ctrl_is_occupied(ctrl_[i])) {
+        return Iterator(ctrl_, slots_, capacity_, i);
+      }
+    }
+    return this->end();
+  }
+
+  Iterator end() const
+  {
+    return Iterator(ctrl_, slots_, capacity_, capacity_);
+  }
+
+  /**
+   * Remove the key that the iterator is currently pointing at. It is valid to call this method
+   * while iterating over the set. However, after this method has been called, the removed element
+   * must not be accessed anymore.
+   */
+  void remove(const Iterator &it)
+  {
+    BLI_assert(swiss_table::ctrl_is_occupied(ctrl_[it.current_slot_]));
+    this->remove_slot(it.current_slot_);
+  }
+
+  /**
+   * Remove all values for which the given predicate is true.
+   */
+  template<typename Predicate> void remove_if(Predicate &&predicate)
+  {
+    for (const int64_t i : IndexRange(capacity_)) {
+      if (swiss_table::ctrl_is_occupied(ctrl_[i])) {
+        if (predicate(*slots_[i])) {
+          this->remove_slot(i);
+        }
+      }
+    }
+  }
+
+  /**
+   * Print common statistics like size and collision count. This is useful for debugging purposes.
+   */
+  void print_stats(StringRef name = "") const
+  {
+    HashTableStats stats(*this, *this);
+    stats.print(name);
+  }
+
+  /**
+   * Get the number of groups that have to be visited in addition to the first one to find the key
+   * or determine that it is not in the set.
+   */
+  int64_t count_collisions(const Key &key) const
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash_(key));
+    const int8_t ctrl = swiss_table::hash_to_ctrl(mixed_hash);
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    int64_t collisions = 0;
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      for (const int64_t i : group.match(ctrl)) {
+        if (is_equal_(key, *slots_[offset + i])) {
+          return collisions;
+        }
+      }
+      if (group.match_empty()) {
+        return collisions;
+      }
+      collisions++;
+      probe.next();
+    }
+  }
+
+  /**
+   * Remove all elements from the set. The allocated slots are kept.
+   */
+  void clear()
+  {
+    this->destruct_occupied();
+    std::fill_n(ctrl_, capacity_, swiss_table::ctrl_empty);
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+  }
+
+  /**
+   * Returns the number of keys stored in the set.
+   */
+  int64_t size() const
+  {
+    return occupied_slots_;
+  }
+
+  /**
+   * Returns true if no keys are stored.
+   */
+  bool is_empty() const
+  {
+    return occupied_slots_ == 0;
+  }
+
+  /**
+   * Returns the number of available slots. This is mostly for debugging purposes.
+   */
+  int64_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * Returns the amount of removed slots in the set. This is mostly for debugging purposes.
+   */
+  int64_t removed_amount() const
+  {
+    return removed_slots_;
+  }
+
+  /**
+   * Returns the bytes required per element. This is mostly for debugging purposes.
+   */
+  int64_t size_per_element() const
+  {
+    return sizeof(Slot) + sizeof(int8_t);
+  }
+
+  /**
+   * Returns the approximate memory requirements of the set in bytes.
+   */
+  int64_t size_in_bytes() const
+  {
+    return this->size_per_element() * capacity_;
+  }
+
+  /**
+   * Potentially resize the set such that it can hold the specified number of keys without another
+   * grow operation.
+   */
+  void reserve(const int64_t n)
+  {
+    if (usable_slots_ - removed_slots_ < n) {
+      this->realloc_and_reinsert(n);
+    }
+  }
+
+  /**
+   * Returns true if there is a key that exists in both sets.
+   */
+  static bool Intersects(const SwissSet &a, const SwissSet &b)
+  {
+    /* Make sure we iterate over the shorter set. */
+    if (a.size() > b.size()) {
+      return Intersects(b, a);
+    }
+
+    for (const Key &key : a) {
+      if (b.contains(key)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Returns true if no key from a is also in b and vice versa.
+   */
+  static bool Disjoint(const SwissSet &a, const SwissSet &b)
+  {
+    return !Intersects(a, b);
+  }
+
+ private:
+  struct SlotSearch {
+    /** Index of the slot that contains the key or of the slot where it should be inserted. */
+    int64_t index;
+    /** Control byte for the key. */
+    int8_t ctrl;
+    bool found;
+  };
+
+  uint64_t group_mask() const
+  {
+    return uint64_t(std::max<int64_t>(capacity_ / swiss_table::group_width, 1) - 1);
+  }
+
+  static size_t slots_offset(const int64_t capacity)
+  {
+    return size_t(ceil_to_multiple_ul(size_t(capacity), alignof(Slot)));
+  }
+
+  static constexpr size_t buffer_alignment()
+  {
+    return std::max<size_t>(swiss_table::group_width, alignof(Slot));
+  }
+
+  /** Allocate control bytes and slots for the given number of slots and mark them as empty. */
+  void allocate(const int64_t capacity)
+  {
+    BLI_assert(capacity_ == 0);
+    BLI_assert(capacity % swiss_table::group_width == 0);
+    BLI_assert((capacity & (capacity - 1)) == 0);
+    const size_t offset = slots_offset(capacity);
+    void *buffer = allocator_.allocate(
+        offset + sizeof(Slot) * size_t(capacity), buffer_alignment(), AT);
+    ctrl_ = static_cast<int8_t *>(buffer);
+    slots_ = reinterpret_cast<Slot *>(static_cast<char *>(buffer) + offset);
+    capacity_ = capacity;
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+    usable_slots_ = floor_multiplication_with_fraction(capacity, LOAD_FACTOR);
+    std::fill_n(ctrl_, capacity, swiss_table::ctrl_empty);
+  }
+
+  void destruct_occupied()
+  {
+    if constexpr (!std::is_trivially_destructible_v<Key>) {
+      for (const int64_t i : IndexRange(capacity_)) {
+        if (swiss_table::ctrl_is_occupied(ctrl_[i])) {
+          slots_[i].ref().~Key();
+        }
+      }
+    }
+  }
+
+  void destruct_and_free()
+  {
+    if (capacity_ > 0) {
+      this->destruct_occupied();
+      allocator_.deallocate(ctrl_);
+    }
+  }
+
+  /**
+   * Reset the set to the empty state without destructing the stored elements. Used after the
+   * elements have been moved elsewhere.
+   */
+  void noexcept_reset() noexcept
+  {
+    ctrl_ = const_cast<int8_t *>(swiss_table::empty_group);
+    slots_ = nullptr;
+    capacity_ = 0;
+    occupied_slots_ = 0;
+    removed_slots_ = 0;
+    usable_slots_ = 0;
+  }
+
+  BLI_NOINLINE void realloc_and_reinsert(const int64_t min_usable_slots)
+  {
+    int64_t total_slots, usable_slots;
+    LoadFactor(LOAD_FACTOR).compute_total_and_usable_slots(
+        swiss_table::group_width, min_usable_slots, &total_slots, &usable_slots);
+
+    int8_t *old_ctrl = ctrl_;
+    Slot *old_slots = slots_;
+    const int64_t old_capacity = capacity_;
+
+    capacity_ = 0;
+    this->allocate(total_slots);
+    for (const int64_t i : IndexRange(old_capacity)) {
+      if (swiss_table::ctrl_is_occupied(old_ctrl[i])) {
+        Key &old_key = *old_slots[i];
+        try {
+          const uint64_t mixed_hash = swiss_table::mix_hash(hash_(old_key));
+          const int64_t index = this->find_free_slot(mixed_hash);
+          this->occupy_slot(index, swiss_table::hash_to_ctrl(mixed_hash), std::move(old_key));
+        }
+        catch (...) {
+          /* Destruct all elements in both tables and leave the set in an empty state. */
+          this->destruct_and_free();
+          for (const int64_t j : IndexRange(i, old_capacity - i)) {
+            if (swiss_table::ctrl_is_occupied(old_ctrl[j])) {
+              old_slots[j].ref().~Key();
+            }
+          }
+          allocator_.deallocate(old_ctrl);
+          this->noexcept_reset();
+          throw;
+        }
+        old_key.~Key();
+      }
+    }
+    if (old_capacity > 0) {
+      allocator_.deallocate(old_ctrl);
+    }
+  }
+
+  void ensure_can_add()
+  {
+    if (occupied_slots_ + removed_slots_ >= usable_slots_) {
+      this->realloc_and_reinsert(occupied_slots_ + 1);
+      BLI_assert(occupied_slots_ + removed_slots_ < usable_slots_);
+    }
+  }
+
+  template<typename ForwardKey>
+  int64_t find_slot(const ForwardKey &key, const uint64_t hash) const
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash);
+    const int8_t ctrl = swiss_table::hash_to_ctrl(mixed_hash);
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      for (const int64_t i : group.match(ctrl)) {
+        if (is_equal_(key, *slots_[offset + i])) {
+          return offset + i;
+        }
+      }
+      if (group.match_empty()) {
+        return -1;
+      }
+      probe.next();
+    }
+  }
+
+  /** Find the first slot in the probing sequence that a new key can be inserted into. */
+  int64_t find_free_slot(const uint64_t mixed_hash) const
+  {
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      if (const swiss_table::GroupMask free = group.match_empty_or_removed()) {
+        return offset + free.first();
+      }
+      probe.next();
+    }
+  }
+
+  /**
+   * Find the slot that contains the key. If there is none, find the slot the key should be
+   * inserted into. The caller has to make sure that there is a free slot.
+   */
+  template<typename ForwardKey>
+  SlotSearch find_slot_or_free_slot(const ForwardKey &key, const uint64_t hash) const
+  {
+    const uint64_t mixed_hash = swiss_table::mix_hash(hash);
+    const int8_t ctrl = swiss_table::hash_to_ctrl(mixed_hash);
+    swiss_table::GroupProbeSequence probe(mixed_hash, this->group_mask());
+    int64_t free_index = -1;
+    while (true) {
+      const int64_t offset = probe.offset();
+      const swiss_table::Group group(ctrl_ + offset);
+      for (const int64_t i : group.match(ctrl)) {
+        if (is_equal_(key, *slots_[offset + i])) {
+          return {offset + i, ctrl, true};
+        }
+      }
+      if (free_index == -1) {
+        if (const swiss_table::GroupMask free = group.match_empty_or_removed()) {
+          free_index = offset + free.first();
+        }
+      }
+      if (group.match_empty()) {
+        return {free_index, ctrl, false};
+      }
+      probe.next();
+    }
+  }
+
+  template<typename ForwardKey>
+  void occupy_slot(const int64_t index, const int8_t ctrl, ForwardKey &&key)
+  {
+    BLI_assert(!swiss_table::ctrl_is_occupied(ctrl_[index]));
+    new (slots_[index].ptr()) Key(std::forward<ForwardKey>(key));
+    if (ctrl_[index] == swiss_table::ctrl_removed) {
+      removed_slots_--;
+    }
+    ctrl_[index] = ctrl;
+    occupied_slots_++;
+  }
+
+  void remove_slot(const int64_t index)
+  {
+    BLI_assert(swiss_table::ctrl_is_occupied(ctrl_[index]));
+    slots_[index].ref().~Key();
+    occupied_slots_--;
+    /* Lookups only stop at groups that contain an empty slot. If the group has an empty slot
+     * already, no probing sequence continues past it, so the slot can become empty again. */
+    const int64_t group_offset = index & ~(swiss_table::group_width - 1);
+    if (swiss_table::Group(ctrl_ + group_offset).match_empty()) {
+      ctrl_[index] = swiss_table::ctrl_empty;
+    }
+    else {
+      ctrl_[index] = swiss_table::ctrl_removed;
+      removed_slots_++;
+    }
+  }
+};
+
+#undef LOAD_FACTOR
+
+}  // namespace blender
@@ -0,0 +1,226 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Building blocks shared by the "swiss table" style hash tables #blender::SwissMap and
+ * #blender::SwissSet.
+ *
+ * Instead of storing the state of a slot inside the slot itself (like the slot types in
+ * BLI_map_slots.hh do), these hash tables keep a separate array with one control byte per slot.
+ * A control byte is either #ctrl_empty, #ctrl_removed or (when the slot is occupied) the lower
+ * seven bits of the hash of the key stored in the slot. Slots are grouped into groups of
+ * #group_width slots. The control bytes of a group can be compared with the hash of a key all at
+ * once using SSE2 (or NEON through sse2neon). Only slots whose control byte matched have to be
+ * compared with the key, which makes lookups very cheap even at high load factors.
+ *
+ * Groups are probed using triangular numbers. Since the number of groups is always a power of
+ * two, every group is visited eventually.
+ */
+
+#include "BLI_math_bits.h"
+#include "BLI_simd.h"
+#include "BLI_sys_types.h"
+#include "BLI_utildefines.h"
+
+namespace blender::swiss_table {
+
+/** Number of slots whose control bytes are checked at once. */
+constexpr int64_t group_width = 16;
+
+constexpr int8_t ctrl_empty = -128;
+constexpr int8_t ctrl_removed = -2;
+
+/**
+ * Control bytes of a table without any slots. Using this instead of a null pointer avoids having
+ * to check for the empty case in every lookup.
+ */
+alignas(group_width) inline constexpr int8_t empty_group[group_width] = {
+    -128, -128, -128, -128, -128, -128, -128, -128,
+    -128, -128, -128, -128, -128, -128, -128, -128};
+static_assert(ctrl_empty == -128);
+
+/** Occupied slots have a control byte that is not negative. */
+inline bool ctrl_is_occupied(const int8_t ctrl)
+{
+  return ctrl >= 0;
+}
+
+/**
+ * Scramble the hash provided by the user, so that the seven bits stored in the control bytes and
+ * the bits used to find the first group both depend on the entire hash. This is necessary because
+ * many hash functions in Blender (e.g. for integers) return the key itself.
+ */
+inline uint64_t mix_hash(const uint64_t hash)
+{
+  const uint64_t h = hash * uint64_t(0x9E3779B97F4A7C15);
+  return h ^ (h >> 32);
+}
+
+/** The part of the mixed hash that is used to find the first group to probe. */
+inline uint64_t hash_to_group(const uint64_t mixed_hash)
+{
+  return mixed_hash >> 7;
+}
+
+/** The part of the mixed hash that is stored in the control bytes. */
+inline int8_t hash_to_ctrl(const uint64_t mixed_hash)
+{
+  return int8_t(mixed_hash & 0x7F);
+}
+
+/**
+ * Bit mask with one bit per slot in a group. Can be used in a range-for loop to iterate over the
+ * indices of all set bits.
+ */
+class GroupMask {
+ private:
+  uint32_t mask_;
+
+ public:
+  explicit GroupMask(const uint32_t mask) : mask_(mask)
+  {
+  }
+
+  operator bool() const
+  {
+    return mask_ != 0;
+  }
+
+  int64_t first() const
+  {
+    BLI_assert(mask_ != 0);
+    return int64_t(bitscan_forward_uint(mask_));
+  }
+
+  GroupMask begin() const
+  {
+    return *this;
+  }
+
+  GroupMask end() const
+  {
+    return GroupMask(0);
+  }
+
+  int64_t operator*() const
+  {
+    return this->first();
+  }
+
+  GroupMask &operator++()
+  {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+
+  friend bool operator!=(const GroupMask &a, const GroupMask &b)
+  {
+    return a.mask_ != b.mask_;
+  }
+};
+
+/**
+ * The control bytes of one group. The pointer passed to the constructor has to be aligned to
+ * #group_width bytes.
+ */
+class Group {
+ private:
+#ifdef BLI_HAVE_SSE2
+  __m128i ctrl_;
+#else
+  const int8_t *ctrl_;
+#endif
+
+ public:
+  explicit Group(const int8_t *ctrl)
+  {
+    BLI_assert((uintptr_t(ctrl) % group_width) == 0);
+#ifdef BLI_HAVE_SSE2
+    ctrl_ = _mm_load_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    ctrl_ = ctrl;
+#endif
+  }
+
+  /** Slots whose control byte is equal to the given one. */
+  GroupMask match(const int8_t ctrl) const
+  {
+#ifdef BLI_HAVE_SSE2
+    const __m128i cmp = _mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(ctrl));
+    return GroupMask(uint32_t(_mm_movemask_epi8(cmp)));
+#else
+    uint32_t mask = 0;
+    for (int64_t i = 0; i < group_width; i++) {
+      mask |= uint32_t(ctrl_[i] == ctrl) << i;
+    }
+    return GroupMask(mask);
+#endif
+  }
+
+  /** Slots that have never been occupied. */
+  GroupMask match_empty() const
+  {
+    return this->match(ctrl_empty);
+  }
+
+  /** Slots that are either empty or removed, i.e. slots that a new key can be inserted into. */
+  GroupMask match_empty_or_removed() const
+  {
+#ifdef BLI_HAVE_SSE2
+    return GroupMask(uint32_t(_mm_movemask_epi8(ctrl_)));
+#else
+    uint32_t mask = 0;
+    for (int64_t i = 0; i < group_width; i++) {
+      mask |= uint32_t(ctrl_[i] < 0) << i;
+    }
+    return GroupMask(mask);
+#endif
+  }
+
+  /** Occupied slots. */
+  GroupMask match_occupied() const
+  {
+#ifdef BLI_HAVE_SSE2
+    return GroupMask(uint32_t(~_mm_movemask_epi8(ctrl_)) & 0xFFFF);
+#else
+    uint32_t mask = 0;
+    for (int64_t i = 0; i < group_width; i++) {
+      mask |= uint32_t(ctrl_[i] >= 0) << i;
+    }
+    return GroupMask(mask);
+#endif
+  }
+};
+
+/**
+ * Produces the sequence of groups to probe for a given hash.
+ */
+class GroupProbeSequence {
+ private:
+  uint64_t group_mask_;
+  uint64_t group_;
+  uint64_t step_ = 0;
+
+ public:
+  GroupProbeSequence(const uint64_t mixed_hash, const uint64_t group_mask)
+      : group_mask_(group_mask), group_(hash_to_group(mixed_hash) & group_mask)
+  {
+  }
+
+  /** Index of the first slot in the current group. */
+  int64_t offset() const
+  {
+    return int64_t(group_ * group_width);
+  }
+
+  void next()
+  {
+    step_++;
+    group_ = (group_ + step_) & group_mask_;
+  }
+};
+
+}  // namespace blender::swiss_table
@@ -34,6 +34,11 @@ struct BLI_mempool;
 void BLI_task_scheduler_init(void);
 void BLI_task_scheduler_exit(void);
 int BLI_task_scheduler_num_threads(void);
+/**
+ * Print utilization statistics of parallel loops which choose their grain size automatically,
+ * see `blender::threading::AdaptiveGrainSize`.
+ */
+void BLI_task_parallel_statistics_print(void);
 
 /** \} */
 
@@ -30,9 +30,15 @@
 #  endif
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+
+#include "BLI_function_ref.hh"
 #include "BLI_index_range.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_utildefines.h"
+#include "BLI_utility_mixins.hh"
 
 namespace blender::threading {
 
@@ -71,6 +77,130 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
   function(range);
 }
 
+/**
+ * Grain size which is chosen automatically based on how long it takes to process a single
+ * element. It is meant to be stored in a static variable at the call site, so that the measured
+ * cost is reused by later calls and statistics are accumulated per call site:
+ *
+ * \code{.cc}
+ * static threading::AdaptiveGrainSize grain_size("mesh_calc_poly_normals");
+ * threading::parallel_for(polys.index_range(), grain_size, [&](const IndexRange range) {...});
+ * \endcode
+ *
+ * The first call runs a few growing sub-ranges on the calling thread to estimate the cost per
+ * element. Work is then split into tasks which take roughly #target_task_time to execute. The
+ * estimate is refined with the timing of every task.
+ */
+class AdaptiveGrainSize : NonCopyable, NonMovable {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /** Preferred execution time of a single task, long enough to hide the scheduling overhead. */
+  static constexpr int64_t target_task_time_ns = 50000;
+  /** Minimum measured time before the cost estimate is trusted. */
+  static constexpr int64_t min_estimate_time_ns = 10000;
+
+ private:
+  const char *name_;
+  /** Estimated time to process a single element, zero until enough timing is measured. */
+  std::atomic<double> element_time_ns_ = 0.0;
+  /** Timing of sub-ranges measured so far by the current estimate. */
+  std::atomic<int64_t> measured_elements_num_ = 0;
+  std::atomic<int64_t> measured_time_ns_ = 0;
+
+  /** Statistics for #print_statistics. */
+  std::atomic<int64_t> calls_num_ = 0;
+  std::atomic<int64_t> parallel_calls_num_ = 0;
+  std::atomic<int64_t> tasks_num_ = 0;
+  std::atomic<int64_t> busy_time_ns_ = 0;
+  std::atomic<int64_t> available_time_ns_ = 0;
+
+  /** All call sites are kept in a list, so that their statistics can be printed. */
+  AdaptiveGrainSize *next_ = nullptr;
+
+ public:
+  explicit AdaptiveGrainSize(const char *name);
+
+  const char *name() const
+  {
+    return name_;
+  }
+
+  /** Grain size to use based on the current estimate, or zero when there is no estimate yet. */
+  int64_t grain_size() const;
+
+  /** Measured time it took to process the given number of elements. */
+  void add_sample(int64_t elements_num, int64_t time_ns);
+  /** Account one call, with the time that all threads spent running tasks of it. */
+  void add_call(bool is_parallel, int64_t tasks_num, int64_t busy_time_ns, int64_t wall_time_ns);
+
+  /** Fraction of the available thread time that was spent running tasks, in the 0..1 range. */
+  float utilization() const;
+
+  /**
+   * Print statistics of all call sites which ran in parallel at least once. Call sites where
+   * threads were idle for more than half of the time are marked as poorly utilized.
+   */
+  static void print_statistics(std::ostream &stream);
+
+  static int64_t time_ns_since(const Clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  }
+};
+
+/**
+ * Same as #parallel_for, but the grain size is chosen automatically based on the measured cost
+ * of processing an element. See #AdaptiveGrainSize.
+ */
+template<typename Function>
+void parallel_for(IndexRange range, AdaptiveGrainSize &grain_size, const Function &function)
+{
+  if (range.size() == 0) {
+    return;
+  }
+  int64_t grain = grain_size.grain_size();
+  IndexRange remaining = range;
+  if (grain == 0) {
+    /* Estimate the cost of a single element by processing growing sub-ranges, the work done
+     * here is not wasted since the sub-ranges are not processed again. */
+    for (int64_t probe_size = 1; grain == 0 && !remaining.is_empty(); probe_size *= 2) {
+      const IndexRange probe = remaining.take_front(probe_size);
+      const AdaptiveGrainSize::Clock::time_point start = AdaptiveGrainSize::Clock::now();
+      function(probe);
+      grain_size.add_sample(probe.size(), AdaptiveGrainSize::time_ns_since(start));
+      remaining = remaining.drop_front(probe.size());
+      grain = grain_size.grain_size();
+    }
+    if (remaining.is_empty()) {
+      grain_size.add_call(false, 0, 0, 0);
+      return;
+    }
+  }
+#ifdef WITH_TBB
+  if (remaining.size() > grain) {
+    lazy_threading::send_hint();
+    std::atomic<int64_t> tasks_num = 0;
+    std::atomic<int64_t> busy_time_ns = 0;
+    const AdaptiveGrainSize::Clock::time_point start = AdaptiveGrainSize::Clock::now();
+    tbb::parallel_for(
+        tbb::blocked_range<int64_t>(remaining.first(), remaining.one_after_last(), grain),
+        [&](const tbb::blocked_range<int64_t> &subrange) {
+          const AdaptiveGrainSize::Clock::time_point task_start = AdaptiveGrainSize::Clock::now();
+          function(IndexRange(subrange.begin(), subrange.size()));
+          const int64_t task_time_ns = AdaptiveGrainSize::time_ns_since(task_start);
+          grain_size.add_sample(subrange.size(), task_time_ns);
+          tasks_num.fetch_add(1, std::memory_order_relaxed);
+          busy_time_ns.fetch_add(task_time_ns, std::memory_order_relaxed);
+        });
+    grain_size.add_call(true, tasks_num, busy_time_ns, AdaptiveGrainSize::time_ns_since(start));
+    return;
+  }
+#endif
+  function(remaining);
+  grain_size.add_call(false, 0, 0, 0);
+}
+
 template<typename Value, typename Function, typename Reduction>
 Value parallel_reduce(IndexRange range,
                       int64_t grain_size,
@@ -125,6 +255,26 @@ void parallel_invoke(const bool use_threading, Functions &&...functions)
   }
 }
 
+/**
+ * Number of NUMA nodes that work can be bound to with #execute_on_numa_node.
+ * This is 1 on systems without multiple NUMA nodes, or when the topology is unknown.
+ */
+int numa_nodes_num();
+
+/**
+ * Run the function in a task arena whose threads are pinned to the given NUMA node, so that the
+ * function and all tasks spawned by it stay on that node. The calling thread joins the arena and
+ * waits for the function to finish. On systems with a single node, the function is called
+ * directly.
+ */
+void execute_on_numa_node(int numa_node_index, FunctionRef<void()> function);
+
+/**
+ * Allocate zero-initialized memory whose pages are placed on the given NUMA node, by touching
+ * them first from threads of that node. Free with #MEM_freeN.
+ */
+void *numa_calloc(size_t size, int numa_node_index, const char *name);
+
 /** See #BLI_task_isolate for a description of what isolating a task means. */
 template<typename Function> void isolate_task(const Function &function)
 {
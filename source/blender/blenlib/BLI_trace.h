@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Lightweight recording of timed events from all threads, written to a file in the Chrome trace
+ * event format, which can be loaded into `chrome://tracing` or Perfetto.
+ *
+ * Events are only recorded between #BLI_trace_begin_recording and #BLI_trace_end_recording, when
+ * not recording the cost of an event is a single atomic load. Every thread appends to its own
+ * buffer, so threads don't wait for each other.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start recording events, they are written to the given file when recording ends. Does nothing
+ * when already recording.
+ */
+void BLI_trace_begin_recording(const char *filepath);
+/**
+ * Stop recording and write the recorded events. Returns false when not recording or the file
+ * couldn't be written.
+ */
+bool BLI_trace_end_recording(void);
+bool BLI_trace_is_recording(void);
+
+/**
+ * Get the start time of an event to pass to #BLI_trace_event_end, zero when not recording.
+ */
+uint64_t BLI_trace_event_begin(void);
+/**
+ * Record an event with the given start time. The name is not copied, it has to be a static
+ * string.
+ */
+void BLI_trace_event_end(const char *name, uint64_t start_time);
+
+#ifdef __cplusplus
+}
+
+namespace blender::trace {
+
+/** Records an event for the lifetime of the object, see #BLI_TRACE_SCOPE. */
+class ScopedEvent {
+ private:
+  const char *name_;
+  uint64_t start_time_;
+
+ public:
+  ScopedEvent(const char *name) : name_(name), start_time_(BLI_trace_event_begin())
+  {
+  }
+
+  ~ScopedEvent()
+  {
+    if (start_time_ != 0) {
+      BLI_trace_event_end(name_, start_time_);
+    }
+  }
+};
+
+}  // namespace blender::trace
+
+#  define BLI_TRACE_SCOPE(name) blender::trace::ScopedEvent trace_scoped_event(name)
+
+#endif
@@ -54,6 +54,15 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Branches with more leafs are refitted and partitioned in parallel. */
+#define KDOPBVH_PARALLEL_LEAF_THRESHOLD (64 * 1024)
+/* Number of leafs processed by one task when refitting or partitioning a single branch. */
+#define KDOPBVH_PARALLEL_CHUNK_SIZE (16 * 1024)
+/* Number of bins used to partition large branches. */
+#define KDOPBVH_PARTITION_BINS 1024
+/* Max number of floats in a bounding volume. */
+#define KDOPBVH_CHUNK_BV_SIZE 26
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -420,6 +429,279 @@ static char get_largest_axis(const float *bv)
   return 5; /* max z axis */
 }
 
+/*
+ * Parallel refit and partition of large branches.
+ *
+ * The levels close to the root of the tree only have a few branches, so building them in
+ * parallel per branch does not help much. Instead, the leafs of large branches are refitted and
+ * partitioned in parallel.
+ *
+ * The partitioning uses binning: the split axis is divided into #KDOPBVH_PARTITION_BINS bins, the
+ * leafs are counted per bin, and all leafs are moved into the range of their bin. Only the bin
+ * that contains the requested element still has to be partitioned. Chunks have a fixed size, so
+ * the resulting order does not depend on the number of threads.
+ */
+
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  int start, end;
+  /** Bounding volume of every chunk, #KDOPBVH_CHUNK_BV_SIZE floats per chunk. */
+  float *chunk_bv;
+} BVHRefitData;
+
+static void refit_kdop_hull_chunk_cb(void *__restrict userdata,
+                                     const int chunk,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRefitData *data = userdata;
+  const int chunk_start = data->start + chunk * KDOPBVH_PARALLEL_CHUNK_SIZE;
+  const int chunk_end = min_ii(chunk_start + KDOPBVH_PARALLEL_CHUNK_SIZE, data->end);
+
+  BVHNode chunk_node;
+  chunk_node.bv = &data->chunk_bv[chunk * KDOPBVH_CHUNK_BV_SIZE];
+  refit_kdop_hull(data->tree, &chunk_node, chunk_start, chunk_end);
+}
+
+/**
+ * Same as #refit_kdop_hull, but computes the bounds of large ranges in parallel.
+ */
+static void refit_kdop_hull_parallel(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  if (end - start <= KDOPBVH_PARALLEL_LEAF_THRESHOLD) {
+    refit_kdop_hull(tree, node, start, end);
+    return;
+  }
+
+  const int chunks_num = (end - start + KDOPBVH_PARALLEL_CHUNK_SIZE - 1) /
+                         KDOPBVH_PARALLEL_CHUNK_SIZE;
+  BVHRefitData data = {
+      .tree = tree,
+      .start = start,
+      .end = end,
+      .chunk_bv = MEM_mallocN(sizeof(float) * KDOPBVH_CHUNK_BV_SIZE * (size_t)chunks_num,
+                              __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, chunks_num, &data, refit_kdop_hull_chunk_cb, &settings);
+
+  float *__restrict bv = node->bv;
+  node_minmax_init(tree, node);
+  for (int chunk = 0; chunk < chunks_num; chunk++) {
+    const float *__restrict chunk_bv = &data.chunk_bv[chunk * KDOPBVH_CHUNK_BV_SIZE];
+    for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+      bv[2 * axis_iter] = min_ff(bv[2 * axis_iter], chunk_bv[2 * axis_iter]);
+      bv[2 * axis_iter + 1] = max_ff(bv[2 * axis_iter + 1], chunk_bv[2 * axis_iter + 1]);
+    }
+  }
+
+  MEM_freeN(data.chunk_bv);
+}
+
+typedef struct BVHPartitionData {
+  BVHNode **a;
+  /** Leafs are moved here first and copied back afterwards. */
+  BVHNode **buffer;
+  int begin, end;
+  int axis;
+
+  /** Lower and upper bound of the keys in every chunk. */
+  float *chunk_minmax;
+  /** Number of leafs per bin in every chunk. */
+  int *chunk_bins;
+  /** Where the leafs below, inside and above #split_bin of every chunk are moved to. */
+  int *chunk_offsets;
+
+  float key_min;
+  double bins_per_key;
+  int split_bin;
+} BVHPartitionData;
+
+BLI_INLINE void partition_chunk_range(const BVHPartitionData *data,
+                                      const int chunk,
+                                      int *r_chunk_begin,
+                                      int *r_chunk_end)
+{
+  *r_chunk_begin = data->begin + chunk * KDOPBVH_PARALLEL_CHUNK_SIZE;
+  *r_chunk_end = min_ii(*r_chunk_begin + KDOPBVH_PARALLEL_CHUNK_SIZE, data->end);
+}
+
+BLI_INLINE int partition_key_bin(const BVHPartitionData *data, const float key)
+{
+  /* The computation is done in double precision, so that it can't overflow. */
+  const double bin = ((double)key - (double)data->key_min) * data->bins_per_key;
+  return (bin < KDOPBVH_PARTITION_BINS) ? max_ii((int)bin, 0) : KDOPBVH_PARTITION_BINS - 1;
+}
+
+static void partition_minmax_chunk_cb(void *__restrict userdata,
+                                      const int chunk,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHPartitionData *data = userdata;
+  int chunk_begin, chunk_end;
+  partition_chunk_range(data, chunk, &chunk_begin, &chunk_end);
+
+  float key_min = FLT_MAX;
+  float key_max = -FLT_MAX;
+  for (int i = chunk_begin; i < chunk_end; i++) {
+    const float key = data->a[i]->bv[data->axis];
+    key_min = min_ff(key_min, key);
+    key_max = max_ff(key_max, key);
+  }
+  data->chunk_minmax[chunk * 2] = key_min;
+  data->chunk_minmax[chunk * 2 + 1] = key_max;
+}
+
+static void partition_count_chunk_cb(void *__restrict userdata,
+                                     const int chunk,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHPartitionData *data = userdata;
+  int chunk_begin, chunk_end;
+  partition_chunk_range(data, chunk, &chunk_begin, &chunk_end);
+
+  int *bins = &data->chunk_bins[chunk * KDOPBVH_PARTITION_BINS];
+  memset(bins, 0, sizeof(int) * KDOPBVH_PARTITION_BINS);
+  for (int i = chunk_begin; i < chunk_end; i++) {
+    bins[partition_key_bin(data, data->a[i]->bv[data->axis])]++;
+  }
+}
+
+static void partition_scatter_chunk_cb(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHPartitionData *data = userdata;
+  int chunk_begin, chunk_end;
+  partition_chunk_range(data, chunk, &chunk_begin, &chunk_end);
+
+  int offsets[3];
+  copy_v3_v3_int(offsets, &data->chunk_offsets[chunk * 3]);
+  for (int i = chunk_begin; i < chunk_end; i++) {
+    const int bin = partition_key_bin(data, data->a[i]->bv[data->axis]);
+    const int group = (bin < data->split_bin) ? 0 : ((bin == data->split_bin) ? 1 : 2);
+    data->buffer[offsets[group]++] = data->a[i];
+  }
+}
+
+static void partition_copy_chunk_cb(void *__restrict userdata,
+                                    const int chunk,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHPartitionData *data = userdata;
+  int chunk_begin, chunk_end;
+  partition_chunk_range(data, chunk, &chunk_begin, &chunk_end);
+
+  memcpy(&data->a[chunk_begin],
+         &data->buffer[chunk_begin - data->begin],
+         sizeof(BVHNode *) * (size_t)(chunk_end - chunk_begin));
+}
+
+/**
+ * Same as #partition_nth_element, but large ranges are partitioned in parallel.
+ */
+static void partition_nth_element_parallel(
+    BVHNode **a, int begin, int end, const int n, const int axis)
+{
+  if (end - begin <= KDOPBVH_PARALLEL_LEAF_THRESHOLD) {
+    partition_nth_element(a, begin, end, n, axis);
+    return;
+  }
+
+  const int max_chunks_num = (end - begin + KDOPBVH_PARALLEL_CHUNK_SIZE - 1) /
+                             KDOPBVH_PARALLEL_CHUNK_SIZE;
+  BVHPartitionData data = {
+      .a = a,
+      .buffer = MEM_mallocN(sizeof(BVHNode *) * (size_t)(end - begin), __func__),
+      .axis = axis,
+      .chunk_minmax = MEM_mallocN(sizeof(float[2]) * (size_t)max_chunks_num, __func__),
+      .chunk_bins = MEM_mallocN(sizeof(int) * KDOPBVH_PARTITION_BINS * (size_t)max_chunks_num,
+                                __func__),
+      .chunk_offsets = MEM_mallocN(sizeof(int[3]) * (size_t)max_chunks_num, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  /* Every iteration only keeps the leafs of the bin that contains the nth element, which
+   * usually is a small fraction of the range. */
+  while (end - begin > KDOPBVH_PARALLEL_LEAF_THRESHOLD) {
+    const int chunks_num = (end - begin + KDOPBVH_PARALLEL_CHUNK_SIZE - 1) /
+                           KDOPBVH_PARALLEL_CHUNK_SIZE;
+    data.begin = begin;
+    data.end = end;
+
+    BLI_task_parallel_range(0, chunks_num, &data, partition_minmax_chunk_cb, &settings);
+    float key_min = FLT_MAX;
+    float key_max = -FLT_MAX;
+    for (int chunk = 0; chunk < chunks_num; chunk++) {
+      key_min = min_ff(key_min, data.chunk_minmax[chunk * 2]);
+      key_max = max_ff(key_max, data.chunk_minmax[chunk * 2 + 1]);
+    }
+    if (!(key_min < key_max)) {
+      /* All keys are equal, so any order is a valid partition. */
+      begin = end;
+      break;
+    }
+    const double key_range = (double)key_max - (double)key_min;
+    data.key_min = key_min;
+    data.bins_per_key = KDOPBVH_PARTITION_BINS / key_range;
+
+    BLI_task_parallel_range(0, chunks_num, &data, partition_count_chunk_cb, &settings);
+
+    /* Find the bin that contains the nth element. */
+    int below_num = 0;
+    int split_num = 0;
+    for (data.split_bin = 0; data.split_bin < KDOPBVH_PARTITION_BINS; data.split_bin++) {
+      split_num = 0;
+      for (int chunk = 0; chunk < chunks_num; chunk++) {
+        split_num += data.chunk_bins[chunk * KDOPBVH_PARTITION_BINS + data.split_bin];
+      }
+      if (begin + below_num + split_num > n) {
+        break;
+      }
+      below_num += split_num;
+    }
+    BLI_assert(data.split_bin < KDOPBVH_PARTITION_BINS);
+
+    /* The leafs of every chunk are placed after the leafs of the previous chunks in each of the
+     * three groups. */
+    int offsets[3] = {0, below_num, below_num + split_num};
+    for (int chunk = 0; chunk < chunks_num; chunk++) {
+      const int *bins = &data.chunk_bins[chunk * KDOPBVH_PARTITION_BINS];
+      int chunk_below_num = 0;
+      for (int bin = 0; bin < data.split_bin; bin++) {
+        chunk_below_num += bins[bin];
+      }
+      int chunk_begin, chunk_end;
+      partition_chunk_range(&data, chunk, &chunk_begin, &chunk_end);
+      const int chunk_split_num = bins[data.split_bin];
+      const int chunk_above_num = chunk_end - chunk_begin - chunk_below_num - chunk_split_num;
+
+      copy_v3_v3_int(&data.chunk_offsets[chunk * 3], offsets);
+      offsets[0] += chunk_below_num;
+      offsets[1] += chunk_split_num;
+      offsets[2] += chunk_above_num;
+    }
+
+    BLI_task_parallel_range(0, chunks_num, &data, partition_scatter_chunk_cb, &settings);
+    BLI_task_parallel_range(0, chunks_num, &data, partition_copy_chunk_cb, &settings);
+
+    /* The smallest key is in the first bin and the largest key in the last one, so the range
+     * always gets smaller. */
+    end = begin + below_num + split_num;
+    begin += below_num;
+  }
+
+  MEM_freeN(data.buffer);
+  MEM_freeN(data.chunk_minmax);
+  MEM_freeN(data.chunk_bins);
+  MEM_freeN(data.chunk_offsets);
+
+  partition_nth_element(a, begin, end, n, axis);
+}
+
 /**
  * bottom-up update of bvh node BV
  * join the children on the parent BV */
@@ -668,7 +950,8 @@ static void split_leafs(BVHNode **leafs_array,
       break;
     }
 
-    partition_nth_element(leafs_array, nth[i], nth[partitions], nth[i + 1], split_axis);
+    partition_nth_element_parallel(
+        leafs_array, nth[i], nth[partitions], nth[i + 1], split_axis);
   }
 }
 
@@ -704,7 +987,7 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
 
   /* This calculates the bounding box of this branch
    * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  refit_kdop_hull_parallel(data->tree, parent, parent_leafs_begin, parent_leafs_end);
   split_axis = get_largest_axis(parent->bv);
 
   /* Save split axis (this can be used on ray-tracing to speedup the query time) */
@@ -61,6 +61,16 @@ static off64_t memory_seek(FileReader *reader, off64_t offset, int whence)
   return mem->reader.offset;
 }
 
+static const void *memory_peek(FileReader *reader, off64_t offset, size_t size)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0 || (size_t)offset + size > mem->length) {
+    return NULL;
+  }
+  return mem->data + offset;
+}
+
 static void memory_close_raw(FileReader *reader)
 {
   MEM_freeN(reader);
@@ -76,6 +86,7 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len)
   mem->reader.read = memory_read_raw;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_raw;
+  mem->reader.peek = memory_peek;
 
   return (FileReader *)mem;
 }
@@ -102,6 +113,17 @@ static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
   return readsize;
 }
 
+static const void *memory_peek_mmap(FileReader *reader, off64_t offset, size_t size)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  /* Once an IO error happened the mapping is replaced by zeroes, don't hand out that memory. */
+  if (BLI_mmap_any_io_error(mem->mmap)) {
+    return NULL;
+  }
+  return memory_peek(reader, offset, size);
+}
+
 static void memory_close_mmap(FileReader *reader)
 {
   MemoryReader *mem = (MemoryReader *)reader;
@@ -119,11 +141,22 @@ FileReader *BLI_filereader_new_mmap(int filedes)
   MemoryReader *mem = MEM_callocN(sizeof(MemoryReader), __func__);
 
   mem->mmap = mmap;
+  mem->data = BLI_mmap_get_pointer(mmap);
   mem->length = BLI_lseek(filedes, 0, SEEK_END);
 
   mem->reader.read = memory_read_mmap;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_mmap;
+  mem->reader.peek = memory_peek_mmap;
 
   return (FileReader *)mem;
 }
+
+bool BLI_filereader_peek_io_error(FileReader *reader)
+{
+  if (reader->peek != memory_peek_mmap) {
+    return false;
+  }
+  MemoryReader *mem = (MemoryReader *)reader;
+  return BLI_mmap_any_io_error(mem->mmap);
+}
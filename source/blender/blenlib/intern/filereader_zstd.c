@@ -12,9 +12,17 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Maximum number of frames that are decompressed ahead of the current read position.
+ * Frames written by Blender are 1mb each, so this bounds the cache to a few megabytes.
+ */
+#define ZSTD_READAHEAD_FRAMES_MAX 16
+
 typedef struct {
   FileReader reader;
 
@@ -29,8 +37,16 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
+    /**
+     * Decompressed content of the frames in the range
+     * `[cached_frame, cached_frame + cached_frames_num)`.
+     * Entries may be NULL when decompressing that frame failed.
+     */
+    char *cached_content[ZSTD_READAHEAD_FRAMES_MAX];
     int cached_frame;
+    int cached_frames_num;
+    /** Number of frames to decompress in parallel when the cache misses. */
+    int readahead_frames_num;
   } seek;
 } ZstdReader;
 
@@ -127,6 +143,8 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.readahead_frames_num = clamp_i(
+      BLI_system_thread_count(), 1, ZSTD_READAHEAD_FRAMES_MAX);
 
   return true;
 }
@@ -154,41 +172,88 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+static void zstd_free_cache(ZstdReader *zstd)
+{
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
+  }
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
+
+typedef struct ZstdDecompressData {
+  ZstdReader *zstd;
+  const char *compressed_data;
+  int first_frame;
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_task(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = (ZstdDecompressData *)userdata;
+  ZstdReader *zstd = data->zstd;
+  const int frame = data->first_frame + index;
+
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                                 zstd->seek.compressed_ofs[frame];
+  const size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                                   zstd->seek.uncompressed_ofs[frame];
+  const size_t offset_in_batch = zstd->seek.compressed_ofs[frame] -
+                                 zstd->seek.compressed_ofs[data->first_frame];
+  const char *compressed_data = data->compressed_data + offset_in_batch;
+
+  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* Each frame is independent, so use a decompression context per task
+   * instead of sharing the reader's one between threads. */
+  size_t res = ZSTD_decompress(
+      uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    uncompressed_data = NULL;
+  }
+  zstd->seek.cached_content[index] = uncompressed_data;
+}
+
+/**
+ * Ensure that the given frame is loaded. On a cache miss the following frames are
+ * decompressed in parallel too, since the file is mostly read sequentially.
+ */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
+  if (frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_frames_num) {
     /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+    return zstd->seek.cached_content[frame - zstd->seek.cached_frame];
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
+  zstd_free_cache(zstd);
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  const int frames_num = min_ii(zstd->seek.readahead_frames_num,
+                                zstd->seek.frames_num - frame);
 
-  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* Frames are stored contiguously, so read all of their compressed data at once. */
+  size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                           zstd->seek.compressed_ofs[frame];
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  ZstdDecompressData data = {zstd, compressed_data, frame};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = frames_num > 1;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_task, &settings);
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
-    return NULL;
-  }
 
   zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  zstd->seek.cached_frames_num = frames_num;
+  return zstd->seek.cached_content[0];
 }
 
 static ssize_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -281,10 +346,7 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: T99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
+    zstd_free_cache(zstd);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
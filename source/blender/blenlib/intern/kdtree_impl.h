@@ -8,6 +8,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -42,6 +43,9 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/* Min number of queries handled by one task in batch queries. */
+#define KD_BATCH_GRAIN_SIZE 256
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -792,6 +796,142 @@ finally:
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Queries
+ *
+ * Run the same query for many points in parallel, writing all results into flat arrays.
+ * \{ */
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeNearest *nearest;
+  uint nearest_len_capacity;
+  int *nearest_len;
+  float range;
+  int *offsets;
+  int *indices;
+} KDTreeBatchData;
+
+static void batch_settings_init(TaskParallelSettings *settings)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->min_iter_per_thread = KD_BATCH_GRAIN_SIZE;
+}
+
+static void find_nearest_n_batch_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  KDTreeNearest *nearest = &data->nearest[(size_t)i * data->nearest_len_capacity];
+  data->nearest_len[i] = BLI_kdtree_nd_(find_nearest_n)(
+      data->tree, data->co[i], nearest, data->nearest_len_capacity);
+}
+
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len)
+{
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .nearest = r_nearest,
+      .nearest_len_capacity = nearest_len_capacity,
+      .nearest_len = r_nearest_len,
+  };
+  TaskParallelSettings settings;
+  batch_settings_init(&settings);
+  BLI_task_parallel_range(0, (int)co_len, &data, find_nearest_n_batch_cb, &settings);
+}
+
+static bool range_search_batch_count_found_cb(void *user_data,
+                                              int UNUSED(index),
+                                              const float UNUSED(co[KD_DIMS]),
+                                              float UNUSED(dist_sq))
+{
+  int *found_len = user_data;
+  (*found_len)++;
+  return true;
+}
+
+static bool range_search_batch_add_found_cb(void *user_data,
+                                            int index,
+                                            const float UNUSED(co[KD_DIMS]),
+                                            float UNUSED(dist_sq))
+{
+  int **found = user_data;
+  **found = index;
+  (*found)++;
+  return true;
+}
+
+static void range_search_batch_count_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  int found_len = 0;
+  BLI_kdtree_nd_(range_search_cb)(
+      data->tree, data->co[i], data->range, range_search_batch_count_found_cb, &found_len);
+  data->offsets[i] = found_len;
+}
+
+static void range_search_batch_fill_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  int *found = &data->indices[data->offsets[i]];
+  BLI_kdtree_nd_(range_search_cb)(
+      data->tree, data->co[i], data->range, range_search_batch_add_found_cb, &found);
+  BLI_assert(found == &data->indices[data->offsets[i + 1]]);
+}
+
+int BLI_kdtree_nd_(range_search_batch)(const KDTree *tree,
+                                       const float (*co)[KD_DIMS],
+                                       const uint co_len,
+                                       const float range,
+                                       int *r_offsets,
+                                       int **r_indices)
+{
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .range = range,
+      .offsets = r_offsets,
+  };
+  TaskParallelSettings settings;
+  batch_settings_init(&settings);
+
+  /* Count the points in range first, so that the results can be written into one array. */
+  BLI_task_parallel_range(0, (int)co_len, &data, range_search_batch_count_cb, &settings);
+
+  int offset = 0;
+  for (uint i = 0; i < co_len; i++) {
+    const int found_len = r_offsets[i];
+    r_offsets[i] = offset;
+    offset += found_len;
+  }
+  r_offsets[co_len] = offset;
+
+  if (offset == 0) {
+    *r_indices = NULL;
+    return 0;
+  }
+
+  data.indices = MEM_mallocN(sizeof(int) * (size_t)offset, __func__);
+  BLI_task_parallel_range(0, (int)co_len, &data, range_search_batch_fill_cb, &settings);
+
+  *r_indices = data.indices;
+  return offset;
+}
+
+/** \} */
+
 /**
  * Use when we want to loop over nodes ordered by index.
  * Requires indices to be aligned with nodes.
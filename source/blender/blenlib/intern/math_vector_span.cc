@@ -0,0 +1,168 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * The kernels are written as plain loops which are vectorized by the compiler. On x86 they are
+ * additionally compiled for AVX2, which is used when supported by the CPU. FMA is not enabled for
+ * those variants, so that results don't depend on the CPU which runs the code.
+ */
+
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_span.hh"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && !defined(__AVX2__)
+#  define WITH_AVX2_KERNELS
+#endif
+
+namespace blender::math {
+
+namespace kernels {
+
+BLI_INLINE void transform_points(const float4x4 &transform,
+                                 const float3 *src,
+                                 float3 *dst,
+                                 const int64_t size)
+{
+  const float(*m)[4] = transform.values;
+  for (int64_t i = 0; i < size; i++) {
+    const float3 p = src[i];
+    /* Same order of operations as #mul_v3_m4v3. */
+    dst[i] = float3(p.x * m[0][0] + p.y * m[1][0] + m[2][0] * p.z + m[3][0],
+                    p.x * m[0][1] + p.y * m[1][1] + m[2][1] * p.z + m[3][1],
+                    p.x * m[0][2] + p.y * m[1][2] + m[2][2] * p.z + m[3][2]);
+  }
+}
+
+BLI_INLINE void normalize_all(float3 *vectors, const int64_t size)
+{
+  for (int64_t i = 0; i < size; i++) {
+    vectors[i] = math::normalize(vectors[i]);
+  }
+}
+
+BLI_INLINE void dot(const float3 *a, const float3 *b, float *r_dot, const int64_t size)
+{
+  for (int64_t i = 0; i < size; i++) {
+    r_dot[i] = math::dot(a[i], b[i]);
+  }
+}
+
+BLI_INLINE void cross(const float3 *a, const float3 *b, float3 *r_cross, const int64_t size)
+{
+  for (int64_t i = 0; i < size; i++) {
+    r_cross[i] = math::cross(a[i], b[i]);
+  }
+}
+
+BLI_INLINE void min_max(const float3 *values, const int64_t size, float3 &min, float3 &max)
+{
+  float3 min_result = min;
+  float3 max_result = max;
+  for (int64_t i = 0; i < size; i++) {
+    min_result = math::min(min_result, values[i]);
+    max_result = math::max(max_result, values[i]);
+  }
+  min = min_result;
+  max = max_result;
+}
+
+}  // namespace kernels
+
+#ifdef WITH_AVX2_KERNELS
+
+/* The same kernels compiled with AVX2 enabled. */
+namespace kernels_avx2 {
+
+#  define AVX2_KERNEL __attribute__((target("avx2")))
+
+AVX2_KERNEL static void transform_points(const float4x4 &transform,
+                                         const float3 *src,
+                                         float3 *dst,
+                                         const int64_t size)
+{
+  kernels::transform_points(transform, src, dst, size);
+}
+
+AVX2_KERNEL static void normalize_all(float3 *vectors, const int64_t size)
+{
+  kernels::normalize_all(vectors, size);
+}
+
+AVX2_KERNEL static void dot(const float3 *a, const float3 *b, float *r_dot, const int64_t size)
+{
+  kernels::dot(a, b, r_dot, size);
+}
+
+AVX2_KERNEL static void cross(const float3 *a,
+                              const float3 *b,
+                              float3 *r_cross,
+                              const int64_t size)
+{
+  kernels::cross(a, b, r_cross, size);
+}
+
+AVX2_KERNEL static void min_max(const float3 *values,
+                                const int64_t size,
+                                float3 &min,
+                                float3 &max)
+{
+  kernels::min_max(values, size, min, max);
+}
+
+#  undef AVX2_KERNEL
+
+}  // namespace kernels_avx2
+
+static bool cpu_supports_avx2()
+{
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+
+#  define DISPATCH_KERNEL(name, ...) \
+    if (cpu_supports_avx2()) { \
+      kernels_avx2::name(__VA_ARGS__); \
+    } \
+    else { \
+      kernels::name(__VA_ARGS__); \
+    } \
+    ((void)0)
+#else
+#  define DISPATCH_KERNEL(name, ...) kernels::name(__VA_ARGS__)
+#endif
+
+void transform_points(const float4x4 &transform, MutableSpan<float3> points)
+{
+  DISPATCH_KERNEL(transform_points, transform, points.data(), points.data(), points.size());
+}
+
+void transform_points(const float4x4 &transform, Span<float3> src, MutableSpan<float3> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  DISPATCH_KERNEL(transform_points, transform, src.data(), dst.data(), src.size());
+}
+
+void normalize_all(MutableSpan<float3> vectors)
+{
+  DISPATCH_KERNEL(normalize_all, vectors.data(), vectors.size());
+}
+
+void dot(Span<float3> a, Span<float3> b, MutableSpan<float> r_dot)
+{
+  BLI_assert(a.size() == b.size() && a.size() == r_dot.size());
+  DISPATCH_KERNEL(dot, a.data(), b.data(), r_dot.data(), a.size());
+}
+
+void cross(Span<float3> a, Span<float3> b, MutableSpan<float3> r_cross)
+{
+  BLI_assert(a.size() == b.size() && a.size() == r_cross.size());
+  DISPATCH_KERNEL(cross, a.data(), b.data(), r_cross.data(), a.size());
+}
+
+void min_max(Span<float3> values, float3 &min, float3 &max)
+{
+  DISPATCH_KERNEL(min_max, values.data(), values.size(), min, max);
+}
+
+}  // namespace blender::math
@@ -6,7 +6,10 @@
  * Task parallel range functions.
  */
 
+#include <algorithm>
 #include <cstdlib>
+#include <iomanip>
+#include <iostream>
 
 #include "MEM_guardedalloc.h"
 
@@ -14,6 +17,7 @@
 
 #include "BLI_lazy_threading.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #include "atomic_ops.h"
@@ -154,3 +158,103 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS *UNUSED(tls))
   return 0;
 #endif
 }
+
+namespace blender::threading {
+
+/* Head of the list of all adaptive grain size call sites. */
+static std::atomic<AdaptiveGrainSize *> adaptive_grain_sizes = nullptr;
+
+AdaptiveGrainSize::AdaptiveGrainSize(const char *name) : name_(name)
+{
+  next_ = adaptive_grain_sizes.load();
+  while (!adaptive_grain_sizes.compare_exchange_weak(next_, this)) {
+    /* Pass. */
+  }
+}
+
+int64_t AdaptiveGrainSize::grain_size() const
+{
+  const double element_time_ns = element_time_ns_.load(std::memory_order_relaxed);
+  if (element_time_ns == 0.0) {
+    return 0;
+  }
+  return std::max<int64_t>(1, int64_t(double(target_task_time_ns) / element_time_ns));
+}
+
+void AdaptiveGrainSize::add_sample(const int64_t elements_num, const int64_t time_ns)
+{
+  const int64_t measured_elements_num = measured_elements_num_.fetch_add(elements_num) +
+                                        elements_num;
+  int64_t measured_time_ns = measured_time_ns_.fetch_add(time_ns) + time_ns;
+  if (measured_time_ns < min_estimate_time_ns) {
+    return;
+  }
+  /* Only one thread folds the measured window into the estimate. Samples which are added by
+   * other threads in the meantime are kept for the next window. */
+  if (!measured_time_ns_.compare_exchange_strong(measured_time_ns, 0)) {
+    return;
+  }
+  measured_elements_num_.fetch_sub(measured_elements_num);
+  const double window_time_ns = double(measured_time_ns) / double(measured_elements_num);
+  const double element_time_ns = element_time_ns_.load(std::memory_order_relaxed);
+  /* Smooth the estimate, so that a few slow tasks (e.g. because of page faults or an
+   * oversubscribed machine) don't change the granularity of the next call too much. */
+  element_time_ns_.store((element_time_ns == 0.0) ?
+                             window_time_ns :
+                             element_time_ns * 0.75 + window_time_ns * 0.25,
+                         std::memory_order_relaxed);
+}
+
+void AdaptiveGrainSize::add_call(const bool is_parallel,
+                                 const int64_t tasks_num,
+                                 const int64_t busy_time_ns,
+                                 const int64_t wall_time_ns)
+{
+  calls_num_.fetch_add(1, std::memory_order_relaxed);
+  if (!is_parallel) {
+    return;
+  }
+  parallel_calls_num_.fetch_add(1, std::memory_order_relaxed);
+  tasks_num_.fetch_add(tasks_num, std::memory_order_relaxed);
+  busy_time_ns_.fetch_add(busy_time_ns, std::memory_order_relaxed);
+  available_time_ns_.fetch_add(wall_time_ns * BLI_task_scheduler_num_threads(),
+                               std::memory_order_relaxed);
+}
+
+float AdaptiveGrainSize::utilization() const
+{
+  const int64_t available_time_ns = available_time_ns_.load(std::memory_order_relaxed);
+  if (available_time_ns == 0) {
+    return 0.0f;
+  }
+  return std::min(1.0f, float(busy_time_ns_.load(std::memory_order_relaxed)) / available_time_ns);
+}
+
+void AdaptiveGrainSize::print_statistics(std::ostream &stream)
+{
+  stream << "Adaptive parallel for statistics:\n";
+  for (const AdaptiveGrainSize *grain_size = adaptive_grain_sizes.load(); grain_size != nullptr;
+       grain_size = grain_size->next_) {
+    const int64_t parallel_calls_num = grain_size->parallel_calls_num_.load();
+    if (parallel_calls_num == 0) {
+      continue;
+    }
+    const float utilization = grain_size->utilization();
+    stream << "  " << grain_size->name_ << ": " << grain_size->calls_num_.load() << " calls, "
+           << parallel_calls_num << " parallel, "
+           << grain_size->tasks_num_.load() / parallel_calls_num << " tasks per call, grain size "
+           << grain_size->grain_size() << ", utilization " << std::fixed << std::setprecision(1)
+           << utilization * 100.0f << "%";
+    if (utilization < 0.5f) {
+      stream << " (poor utilization)";
+    }
+    stream << "\n";
+  }
+}
+
+}  // namespace blender::threading
+
+void BLI_task_parallel_statistics_print()
+{
+  blender::threading::AdaptiveGrainSize::print_statistics(std::cout);
+}
@@ -6,10 +6,15 @@
  * Task scheduler initialization.
  */
 
+#include <algorithm>
+#include <cstring>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #ifdef WITH_TBB
 /* Need to include at least one header to get the version define. */
@@ -19,6 +24,10 @@
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
 #  endif
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+#    include <tbb/info.h>
+#    define WITH_TBB_NUMA
+#  endif
 #endif
 
 /* Task Scheduler */
@@ -27,6 +36,10 @@ static int task_scheduler_num_threads = 1;
 #ifdef WITH_TBB_GLOBAL_CONTROL
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
+#ifdef WITH_TBB_NUMA
+/* Arena per NUMA node, only created when the system has more than one node. */
+static blender::Vector<tbb::task_arena *> task_scheduler_numa_arenas;
+#endif
 
 void BLI_task_scheduler_init()
 {
@@ -50,10 +63,28 @@ void BLI_task_scheduler_init()
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
+
+#ifdef WITH_TBB_NUMA
+  /* The list of nodes contains a single automatic node when the system has no NUMA support, or
+   * when TBB is unable to query the topology. */
+  const std::vector<tbb::numa_node_id> numa_nodes = tbb::info::numa_nodes();
+  if (numa_nodes.size() > 1) {
+    for (const tbb::numa_node_id numa_node : numa_nodes) {
+      task_scheduler_numa_arenas.append(
+          MEM_new<tbb::task_arena>(__func__, tbb::task_arena::constraints(numa_node)));
+    }
+  }
+#endif
 }
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB_NUMA
+  for (tbb::task_arena *arena : task_scheduler_numa_arenas) {
+    MEM_delete(arena);
+  }
+  task_scheduler_numa_arenas.clear_and_make_inline();
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   MEM_delete(task_scheduler_global_control);
 #endif
@@ -72,3 +103,52 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
   func(userdata);
 #endif
 }
+
+namespace blender::threading {
+
+int numa_nodes_num()
+{
+#ifdef WITH_TBB_NUMA
+  return std::max<int>(1, task_scheduler_numa_arenas.size());
+#else
+  return 1;
+#endif
+}
+
+void execute_on_numa_node(const int numa_node_index, const FunctionRef<void()> function)
+{
+  BLI_assert(numa_node_index >= 0 && numa_node_index < numa_nodes_num());
+#ifdef WITH_TBB_NUMA
+  if (!task_scheduler_numa_arenas.is_empty()) {
+    task_scheduler_numa_arenas[numa_node_index]->execute([&]() { function(); });
+    return;
+  }
+#else
+  UNUSED_VARS_NDEBUG(numa_node_index);
+#endif
+  function();
+}
+
+void *numa_calloc(const size_t size, const int numa_node_index, const char *name)
+{
+  if (numa_nodes_num() == 1) {
+    return MEM_callocN(size, name);
+  }
+  /* Memory pages are placed on the NUMA node of the thread which first writes to them, so clear
+   * the memory from threads of the requested node instead of using #MEM_callocN. */
+  void *data = MEM_mallocN(size, name);
+  execute_on_numa_node(numa_node_index, [&]() {
+    const int64_t chunk_size = 64 * 1024;
+    const int64_t chunks_num = (int64_t(size) + chunk_size - 1) / chunk_size;
+    parallel_for(IndexRange(chunks_num), 16, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        const int64_t offset = chunk * chunk_size;
+        const int64_t length = std::min<int64_t>(chunk_size, int64_t(size) - offset);
+        memset(static_cast<char *>(data) + offset, 0, size_t(length));
+      }
+    });
+  });
+  return data;
+}
+
+}  // namespace blender::threading
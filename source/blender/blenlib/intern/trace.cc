@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "BLI_fileops.h"
+#include "BLI_trace.h"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+namespace blender::trace {
+
+struct Event {
+  const char *name;
+  uint64_t start_time;
+  uint64_t end_time;
+};
+
+struct ThreadEvents {
+  /* Only contended while the events are written. */
+  std::mutex mutex;
+  Vector<Event> events;
+  int tid;
+};
+
+static std::atomic<bool> is_recording = false;
+/* Protects everything below, only locked when starting or ending, and the first time a thread
+ * records an event. */
+static std::mutex recording_mutex;
+static std::string output_filepath;
+static uint64_t recording_begin_time;
+/* Owned here instead of by the threads, to keep the events of threads that ended. */
+static Vector<std::unique_ptr<ThreadEvents>> all_thread_events;
+
+static thread_local ThreadEvents *local_thread_events = nullptr;
+
+static uint64_t current_time()
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static ThreadEvents &ensure_local_thread_events()
+{
+  if (local_thread_events == nullptr) {
+    std::lock_guard lock{recording_mutex};
+    std::unique_ptr<ThreadEvents> thread_events = std::make_unique<ThreadEvents>();
+    thread_events->tid = int(all_thread_events.size());
+    local_thread_events = thread_events.get();
+    all_thread_events.append(std::move(thread_events));
+  }
+  return *local_thread_events;
+}
+
+static void write_json_string(FILE *fp, const char *str)
+{
+  fputc('"', fp);
+  for (const char *ch = str; *ch; ch++) {
+    if (ELEM(*ch, '"', '\\')) {
+      fputc('\\', fp);
+      fputc(*ch, fp);
+    }
+    else if (uchar(*ch) < 0x20) {
+      fprintf(fp, "\\u%04x", int(*ch));
+    }
+    else {
+      fputc(*ch, fp);
+    }
+  }
+  fputc('"', fp);
+}
+
+static bool write_chrome_trace(const char *filepath)
+{
+  FILE *fp = BLI_fopen(filepath, "w");
+  if (fp == nullptr) {
+    return false;
+  }
+
+  fprintf(fp, "{\"traceEvents\":[\n");
+  fprintf(fp,
+          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"Blender\"}}");
+  for (std::unique_ptr<ThreadEvents> &thread_events : all_thread_events) {
+    std::lock_guard lock{thread_events->mutex};
+    for (const Event &event : thread_events->events) {
+      if (event.start_time < recording_begin_time) {
+        continue;
+      }
+      fprintf(fp, ",\n{\"name\":");
+      write_json_string(fp, event.name);
+      /* Times are in microseconds, relative to the beginning of the recording. */
+      fprintf(fp,
+              ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+              double(event.start_time - recording_begin_time) / 1000.0,
+              double(event.end_time - event.start_time) / 1000.0,
+              thread_events->tid);
+    }
+    thread_events->events.clear();
+  }
+  fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+  return fclose(fp) == 0;
+}
+
+}  // namespace blender::trace
+
+using namespace blender::trace;
+
+void BLI_trace_begin_recording(const char *filepath)
+{
+  std::lock_guard lock{recording_mutex};
+  if (is_recording) {
+    return;
+  }
+  output_filepath = filepath;
+  recording_begin_time = current_time();
+  is_recording = true;
+}
+
+bool BLI_trace_end_recording(void)
+{
+  std::lock_guard lock{recording_mutex};
+  if (!is_recording) {
+    return false;
+  }
+  is_recording = false;
+  return write_chrome_trace(output_filepath.c_str());
+}
+
+bool BLI_trace_is_recording(void)
+{
+  return is_recording.load(std::memory_order_relaxed);
+}
+
+uint64_t BLI_trace_event_begin(void)
+{
+  if (!is_recording.load(std::memory_order_relaxed)) {
+    return 0;
+  }
+  return current_time();
+}
+
+void BLI_trace_event_end(const char *name, const uint64_t start_time)
+{
+  if (start_time == 0 || !is_recording.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const uint64_t end_time = current_time();
+  ThreadEvents &thread_events = ensure_local_thread_events();
+  std::lock_guard lock{thread_events.mutex};
+  thread_events.events.append({name, start_time, end_time});
+}
@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <atomic>
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_concurrent_set.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+
+namespace blender::threading::tests {
+
+TEST(concurrent_map, AddAndLookup)
+{
+  ConcurrentMap<int, int> map(4);
+  EXPECT_EQ(map.shards_num(), 4);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_TRUE(map.add(1, 10));
+  EXPECT_FALSE(map.add(1, 20));
+  EXPECT_TRUE(map.contains(1));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.lookup_default(1, 0), 10);
+  EXPECT_EQ(map.lookup_default(2, 0), 0);
+  EXPECT_EQ(map.lookup_or_add(2, 30), 30);
+  EXPECT_EQ(map.lookup_or_add(2, 40), 30);
+  EXPECT_FALSE(map.add_overwrite(2, 50));
+  EXPECT_EQ(map.lookup_default(2, 0), 50);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_TRUE(map.remove(1));
+  EXPECT_FALSE(map.remove(1));
+  EXPECT_EQ(map.size(), 1);
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(concurrent_map, ParallelAdd)
+{
+  const int keys_num = 100000;
+  ConcurrentMap<int, int> map;
+  map.reserve(keys_num);
+  /* Every key is added by multiple threads, but only one of them succeeds. */
+  std::atomic<int> added_num = 0;
+  threading::parallel_for(IndexRange(keys_num * 4), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int key = int(i % keys_num);
+      if (map.add(key, key * 2)) {
+        added_num++;
+      }
+    }
+  });
+  EXPECT_EQ(added_num, keys_num);
+  EXPECT_EQ(map.size(), keys_num);
+
+  int64_t size = 0;
+  for (const int64_t shard : IndexRange(map.shards_num())) {
+    for (const auto item : map.shard(shard).items()) {
+      EXPECT_EQ(item.value, item.key * 2);
+    }
+    size += map.shard(shard).size();
+  }
+  EXPECT_EQ(size, keys_num);
+}
+
+TEST(concurrent_map, ParallelLookupOrAddIndex)
+{
+  /* Assign a unique index to every key, even though the keys are added from many threads. */
+  const int keys_num = 10000;
+  ConcurrentMap<int, int> map;
+  std::atomic<int> next_index = 0;
+  Array<int> indices(keys_num * 3);
+  threading::parallel_for(indices.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      indices[i] = map.lookup_or_add_cb(int(i % keys_num), [&]() { return next_index++; });
+    }
+  });
+  EXPECT_EQ(next_index, keys_num);
+  for (const int64_t i : indices.index_range()) {
+    EXPECT_EQ(indices[i], indices[i % keys_num]);
+  }
+}
+
+TEST(concurrent_map, ParallelAddOrModify)
+{
+  ConcurrentMap<int, int> map;
+  threading::parallel_for(IndexRange(10000), 128, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      map.add_or_modify(
+          int(i % 100), [](int *value) { *value = 1; }, [](int *value) { (*value)++; });
+    }
+  });
+  EXPECT_EQ(map.size(), 100);
+  for (const int key : IndexRange(100)) {
+    EXPECT_EQ(map.lookup_default(key, 0), 100);
+  }
+}
+
+TEST(concurrent_set, ParallelAdd)
+{
+  const int keys_num = 50000;
+  ConcurrentSet<int> set;
+  std::atomic<int> added_num = 0;
+  threading::parallel_for(IndexRange(keys_num * 2), 1024, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (set.add(int(i / 2))) {
+        added_num++;
+      }
+    }
+  });
+  EXPECT_EQ(added_num, keys_num);
+  EXPECT_EQ(set.size(), keys_num);
+  EXPECT_TRUE(set.contains(0));
+  EXPECT_FALSE(set.contains(keys_num));
+  EXPECT_TRUE(set.remove(0));
+  EXPECT_FALSE(set.contains(0));
+  set.clear();
+  EXPECT_TRUE(set.is_empty());
+}
+
+}  // namespace blender::threading::tests
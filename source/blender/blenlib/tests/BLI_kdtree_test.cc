@@ -2,9 +2,13 @@
 
 #include "testing/testing.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_kdtree.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 /* -------------------------------------------------------------------- */
 /* Tests */
@@ -52,6 +56,106 @@ static void deduplicate_test()
   }
 }
 
+static KDTree_3d *grid_tree_new(const int size, std::vector<float> &r_co)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(size * size * size);
+  for (int x = 0; x < size; x++) {
+    for (int y = 0; y < size; y++) {
+      for (int z = 0; z < size; z++) {
+        const float co[3] = {float(x), float(y), float(z)};
+        BLI_kdtree_3d_insert(tree, int(r_co.size() / 3), co);
+        r_co.insert(r_co.end(), co, co + 3);
+      }
+    }
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static std::vector<float> query_points_get(const int num, const float scale)
+{
+  std::vector<float> points;
+  for (int i = 0; i < num * 3; i++) {
+    points.push_back(fmodf(i * 7.121f, 1.0f) * scale);
+  }
+  return points;
+}
+
+static void find_nearest_n_batch_test()
+{
+  std::vector<float> tree_co;
+  KDTree_3d *tree = grid_tree_new(10, tree_co);
+  const std::vector<float> query = query_points_get(1000, 10.0f);
+  const int query_num = int(query.size() / 3);
+  const int nearest_capacity = 4;
+
+  std::vector<KDTreeNearest_3d> nearest(query_num * nearest_capacity);
+  std::vector<int> nearest_len(query_num);
+  BLI_kdtree_3d_find_nearest_n_batch(tree,
+                                     reinterpret_cast<const float(*)[3]>(query.data()),
+                                     query_num,
+                                     nearest.data(),
+                                     nearest_capacity,
+                                     nearest_len.data());
+
+  for (int i = 0; i < query_num; i++) {
+    KDTreeNearest_3d expected[nearest_capacity];
+    const int expected_len = BLI_kdtree_3d_find_nearest_n(
+        tree, &query[i * 3], expected, nearest_capacity);
+    EXPECT_EQ(nearest_len[i], expected_len);
+    for (int j = 0; j < expected_len; j++) {
+      EXPECT_EQ(nearest[i * nearest_capacity + j].index, expected[j].index);
+      EXPECT_EQ(nearest[i * nearest_capacity + j].dist, expected[j].dist);
+    }
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
+static void range_search_batch_test()
+{
+  std::vector<float> tree_co;
+  KDTree_3d *tree = grid_tree_new(10, tree_co);
+  /* Some of the query points are outside of the grid, so that nothing is found for them. */
+  const std::vector<float> query = query_points_get(1000, 14.0f);
+  const int query_num = int(query.size() / 3);
+  const float range = 1.5f;
+
+  std::vector<int> offsets(query_num + 1);
+  int *indices;
+  const int found_num = BLI_kdtree_3d_range_search_batch(
+      tree,
+      reinterpret_cast<const float(*)[3]>(query.data()),
+      query_num,
+      range,
+      offsets.data(),
+      &indices);
+  EXPECT_EQ(offsets[0], 0);
+  EXPECT_EQ(offsets[query_num], found_num);
+
+  for (int i = 0; i < query_num; i++) {
+    KDTreeNearest_3d *expected;
+    const int expected_len = BLI_kdtree_3d_range_search(tree, &query[i * 3], &expected, range);
+    EXPECT_EQ(offsets[i + 1] - offsets[i], expected_len);
+
+    std::vector<int> found(indices + offsets[i], indices + offsets[i + 1]);
+    std::vector<int> expected_indices;
+    for (int j = 0; j < expected_len; j++) {
+      expected_indices.push_back(expected[j].index);
+    }
+    std::sort(found.begin(), found.end());
+    std::sort(expected_indices.begin(), expected_indices.end());
+    EXPECT_EQ(found, expected_indices);
+
+    if (expected) {
+      MEM_freeN(expected);
+    }
+  }
+  if (indices) {
+    MEM_freeN(indices);
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
 TEST(kdtree, Standard)
 {
   standard_test();
@@ -61,3 +165,13 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, FindNearestNBatch)
+{
+  find_nearest_n_batch_test();
+}
+
+TEST(kdtree, RangeSearchBatch)
+{
+  range_search_batch_test();
+}
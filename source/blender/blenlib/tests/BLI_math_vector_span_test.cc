@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_span.hh"
+
+namespace blender::tests {
+
+/* Different sizes to test the remainder loops of vectorized kernels. */
+static Array<float3> test_vectors(const int size)
+{
+  Array<float3> vectors(size);
+  for (const int i : vectors.index_range()) {
+    vectors[i] = float3(float(i) - 3.5f, float(i % 5) * 0.25f, 1.0f / float(i + 1));
+  }
+  return vectors;
+}
+
+TEST(math_vector_span, TransformPoints)
+{
+  const float4x4 transform = float4x4::from_loc_eul_scale(
+      float3(1.0f, -2.0f, 3.0f), float3(0.3f, 0.2f, 0.1f), float3(2.0f, 1.0f, 0.5f));
+  for (const int size : {0, 1, 7, 33}) {
+    const Array<float3> src = test_vectors(size);
+    Array<float3> points = src;
+    math::transform_points(transform, points);
+    Array<float3> dst(size);
+    math::transform_points(transform, src, dst);
+    for (const int i : src.index_range()) {
+      const float3 expected = transform * src[i];
+      EXPECT_EQ(points[i], expected);
+      EXPECT_EQ(dst[i], expected);
+    }
+  }
+}
+
+TEST(math_vector_span, NormalizeAll)
+{
+  Array<float3> vectors = test_vectors(19);
+  vectors[3] = float3(0.0f);
+  const Array<float3> src = vectors;
+  math::normalize_all(vectors);
+  for (const int i : src.index_range()) {
+    EXPECT_EQ(vectors[i], math::normalize(src[i]));
+  }
+  EXPECT_EQ(vectors[3], float3(0.0f));
+}
+
+TEST(math_vector_span, DotCross)
+{
+  const Array<float3> a = test_vectors(21);
+  Array<float3> b = test_vectors(21);
+  std::reverse(b.begin(), b.end());
+  Array<float> dots(a.size());
+  Array<float3> crosses(a.size());
+  math::dot(a, b, dots);
+  math::cross(a, b, crosses);
+  for (const int i : a.index_range()) {
+    EXPECT_EQ(dots[i], math::dot(a[i], b[i]));
+    EXPECT_EQ(crosses[i], math::cross(a[i], b[i]));
+  }
+}
+
+TEST(math_vector_span, MinMax)
+{
+  const Array<float3> values = test_vectors(11);
+  float3 min(std::numeric_limits<float>::max());
+  float3 max(std::numeric_limits<float>::lowest());
+  math::min_max(values, min, max);
+  EXPECT_EQ(min, float3(-3.5f, 0.0f, 1.0f / 11.0f));
+  EXPECT_EQ(max, float3(6.5f, 1.0f, 1.0f));
+
+  /* Existing bounds are expanded, not replaced. */
+  min = float3(-10.0f);
+  max = float3(0.0f);
+  math::min_max(values, min, max);
+  EXPECT_EQ(min, float3(-10.0f));
+  EXPECT_EQ(max, float3(6.5f, 1.0f, 1.0f));
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+
+namespace blender::noise::tests {
+
+/* Different sizes to test the remainder loops of vectorized kernels and multiple batches. */
+static Array<float3> test_positions(const int size)
+{
+  Array<float3> positions(size);
+  for (const int i : positions.index_range()) {
+    positions[i] = float3(float(i) * 0.37f - 5.0f, float(i % 7) * -1.3f, float(i) / 11.0f);
+  }
+  return positions;
+}
+
+TEST(noise, PerlinFractalDistortedBatch)
+{
+  for (const float octaves : {0.0f, 2.0f, 3.5f}) {
+    for (const int size : {0, 1, 13, 150}) {
+      const Array<float3> positions = test_positions(size);
+      Array<float> values(size);
+      perlin_fractal_distorted(positions, octaves, 0.6f, 0.4f, values);
+      for (const int i : positions.index_range()) {
+        EXPECT_EQ(values[i], perlin_fractal_distorted(positions[i], octaves, 0.6f, 0.4f));
+      }
+    }
+  }
+}
+
+TEST(noise, PerlinFloat3FractalDistortedBatch)
+{
+  for (const float octaves : {0.0f, 2.0f, 3.5f}) {
+    for (const int size : {0, 1, 13, 150}) {
+      const Array<float3> positions = test_positions(size);
+      Array<float3> values(size);
+      perlin_float3_fractal_distorted(positions, octaves, 0.6f, 0.4f, values);
+      for (const int i : positions.index_range()) {
+        EXPECT_EQ(values[i], perlin_float3_fractal_distorted(positions[i], octaves, 0.6f, 0.4f));
+      }
+    }
+  }
+}
+
+}  // namespace blender::noise::tests
@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <algorithm>
+#include <random>
+
+#include "BLI_array.hh"
+#include "BLI_sort.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+template<typename T> static void test_radix_sort_matches_std_sort(const Span<T> data)
+{
+  Array<T> expected(data);
+  std::stable_sort(expected.begin(), expected.end());
+  Array<T> sorted(data);
+  parallel_radix_sort(sorted.as_mutable_span());
+  EXPECT_EQ(sorted.as_span(), expected.as_span());
+}
+
+TEST(sort, RadixSortEmpty)
+{
+  Array<int> data;
+  parallel_radix_sort(data.as_mutable_span());
+  EXPECT_TRUE(data.is_empty());
+}
+
+TEST(sort, RadixSortIntegers)
+{
+  std::mt19937 rng(0);
+  /* Large enough to be split into multiple chunks. */
+  Array<uint32_t> data_u32(300000);
+  Array<int32_t> data_i32(300000);
+  Array<int64_t> data_i64(300000);
+  Array<uint8_t> data_u8(1000);
+  for (const int64_t i : data_u32.index_range()) {
+    data_u32[i] = rng();
+    data_i32[i] = int32_t(rng());
+    data_i64[i] = int64_t((uint64_t(rng()) << 32) | uint64_t(rng()));
+  }
+  for (const int64_t i : data_u8.index_range()) {
+    data_u8[i] = uint8_t(rng());
+  }
+  test_radix_sort_matches_std_sort<uint32_t>(data_u32);
+  test_radix_sort_matches_std_sort<int32_t>(data_i32);
+  test_radix_sort_matches_std_sort<int64_t>(data_i64);
+  test_radix_sort_matches_std_sort<uint8_t>(data_u8);
+}
+
+TEST(sort, RadixSortSmallRange)
+{
+  /* Most passes are skipped because all keys have the same higher digits. */
+  Array<int> data(200000);
+  for (const int64_t i : data.index_range()) {
+    data[i] = int((i * 7919) % 1000) - 500;
+  }
+  test_radix_sort_matches_std_sort<int>(data);
+}
+
+TEST(sort, RadixSortFloats)
+{
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist_f(-1000.0f, 1000.0f);
+  std::uniform_real_distribution<double> dist_d(-1e10, 1e10);
+  Array<float> data_f(100000);
+  Array<double> data_d(100000);
+  for (const int64_t i : data_f.index_range()) {
+    data_f[i] = dist_f(rng);
+    data_d[i] = dist_d(rng);
+  }
+  data_f[0] = 0.0f;
+  data_f[1] = -1e30f;
+  data_f[2] = 1e30f;
+  test_radix_sort_matches_std_sort<float>(data_f);
+  test_radix_sort_matches_std_sort<double>(data_d);
+}
+
+TEST(sort, RadixSortKeyValueIsStable)
+{
+  Array<uint64_t> keys(200000);
+  Array<int> values(keys.size());
+  for (const int64_t i : keys.index_range()) {
+    keys[i] = uint64_t((i * 31337) % 1024) << 40;
+    values[i] = int(i);
+  }
+  Array<uint64_t> keys_copy(keys.as_span());
+  parallel_radix_sort(keys.as_mutable_span(), values.as_mutable_span());
+  for (const int64_t i : keys.index_range()) {
+    EXPECT_EQ(keys[i], keys_copy[values[i]]);
+    if (i > 0) {
+      EXPECT_LE(keys[i - 1], keys[i]);
+      if (keys[i - 1] == keys[i]) {
+        EXPECT_LT(values[i - 1], values[i]);
+      }
+    }
+  }
+}
+
+}  // namespace blender::tests
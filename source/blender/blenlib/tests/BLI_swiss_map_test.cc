@@ -0,0 +1,292 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_exception_safety_test_utils.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.h"
+#include "BLI_strict_flags.h"
+#include "BLI_swiss_map.hh"
+#include "BLI_swiss_set.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+#include <memory>
+
+namespace blender::tests {
+
+TEST(swiss_map, DefaultConstructor)
+{
+  SwissMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(3));
+  EXPECT_EQ(map.lookup_ptr(3), nullptr);
+  EXPECT_EQ(map.capacity(), 0);
+}
+
+TEST(swiss_map, AddLookup)
+{
+  SwissMap<int, float> map;
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_FALSE(map.add(2, 6.0f));
+  map.add_new(4, 1.0f);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.lookup(2), 5.0f);
+  EXPECT_EQ(map.lookup(4), 1.0f);
+  EXPECT_EQ(map.lookup_default(5, 3.0f), 3.0f);
+  EXPECT_TRUE(map.add_overwrite(5, 7.0f));
+  EXPECT_FALSE(map.add_overwrite(5, 8.0f));
+  EXPECT_EQ(map.lookup(5), 8.0f);
+}
+
+TEST(swiss_map, AddMany)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 10000; i++) {
+    map.add_new(i * 3, i);
+  }
+  EXPECT_EQ(map.size(), 10000);
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(map.lookup(i * 3), i);
+    EXPECT_FALSE(map.contains(i * 3 + 1));
+  }
+}
+
+TEST(swiss_map, RemoveMany)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 1000; i++) {
+    map.add_new(i, i);
+  }
+  /* Removing and adding many times must reuse removed slots instead of growing indefinitely. */
+  for (int round = 0; round < 20; round++) {
+    for (int i = 0; i < 1000; i += 2) {
+      EXPECT_TRUE(map.remove(i));
+    }
+    EXPECT_EQ(map.size(), 500);
+    for (int i = 1; i < 1000; i += 2) {
+      EXPECT_EQ(map.lookup(i), i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+      EXPECT_FALSE(map.contains(i));
+      map.add_new(i, i);
+    }
+    EXPECT_EQ(map.size(), 1000);
+  }
+  EXPECT_LE(map.capacity(), 2048);
+  EXPECT_EQ(map.pop(10), 10);
+  EXPECT_FALSE(map.pop_try(10).has_value());
+  EXPECT_EQ(map.pop_default(10, -1), -1);
+  EXPECT_EQ(map.pop_default(11, -1), 11);
+}
+
+TEST(swiss_map, ItemIterator)
+{
+  SwissMap<int, float> map;
+  map.add(5, 3.0f);
+  map.add(2, 9.0f);
+  map.add(1, 0.0f);
+
+  SwissSet<int> keys;
+  float value_sum = 0.0f;
+  for (auto item : map.items()) {
+    keys.add(item.key);
+    value_sum += item.value;
+  }
+  EXPECT_EQ(keys.size(), 3);
+  EXPECT_TRUE(keys.contains(5));
+  EXPECT_TRUE(keys.contains(2));
+  EXPECT_TRUE(keys.contains(1));
+  EXPECT_EQ(value_sum, 12.0f);
+
+  for (float &value : map.values()) {
+    value *= 2.0f;
+  }
+  EXPECT_EQ(map.lookup(2), 18.0f);
+  int key_sum = 0;
+  for (const int key : map.keys()) {
+    key_sum += key;
+  }
+  EXPECT_EQ(key_sum, 8);
+}
+
+TEST(swiss_map, LookupOrAdd)
+{
+  SwissMap<int, int> map;
+  map.lookup_or_add_default(3)++;
+  map.lookup_or_add_default(3)++;
+  EXPECT_EQ(map.lookup(3), 2);
+  EXPECT_EQ(map.lookup_or_add(4, 10), 10);
+  EXPECT_EQ(map.lookup_or_add(4, 20), 10);
+  EXPECT_EQ(map.lookup_or_add_cb(5, []() { return 30; }), 30);
+
+  auto create_func = [](int *value) {
+    *value = 10;
+    return true;
+  };
+  auto modify_func = [](int *value) {
+    *value += 5;
+    return false;
+  };
+  EXPECT_TRUE(map.add_or_modify(1, create_func, modify_func));
+  EXPECT_EQ(map.lookup(1), 10);
+  EXPECT_FALSE(map.add_or_modify(1, create_func, modify_func));
+  EXPECT_EQ(map.lookup(1), 15);
+}
+
+TEST(swiss_map, CopyAndMove)
+{
+  SwissMap<int, int> map1;
+  for (int i = 0; i < 100; i++) {
+    map1.add(i, i * 2);
+  }
+  for (int i = 0; i < 100; i += 3) {
+    map1.remove(i);
+  }
+  SwissMap<int, int> map2 = map1;
+  EXPECT_EQ(map2.size(), map1.size());
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(map2.lookup_ptr(i) == nullptr, i % 3 == 0);
+  }
+  SwissMap<int, int> map3 = std::move(map1);
+  EXPECT_EQ(map1.size(), 0); /* NOLINT: bugprone-use-after-move */
+  EXPECT_EQ(map3.size(), map2.size());
+  EXPECT_EQ(map3.lookup(50), 100);
+  map3.clear();
+  EXPECT_TRUE(map3.is_empty());
+  EXPECT_FALSE(map3.contains(50));
+}
+
+TEST(swiss_map, UniquePtrValue)
+{
+  SwissMap<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; i++) {
+    map.add_new(i, std::make_unique<int>(i));
+  }
+  map.remove(10);
+  EXPECT_EQ(*map.lookup(20), 20);
+  std::unique_ptr<int> value = map.pop(30);
+  EXPECT_EQ(*value, 30);
+  EXPECT_EQ(map.size(), 98);
+}
+
+TEST(swiss_map, RemoveIf)
+{
+  SwissMap<int64_t, int64_t> map;
+  for (const int64_t i : IndexRange(100)) {
+    map.add(i * i, i);
+  }
+  map.remove_if([](auto item) { return item.key > 100; });
+  EXPECT_EQ(map.size(), 11);
+  for (const int64_t i : IndexRange(100)) {
+    if (i <= 10) {
+      EXPECT_EQ(map.lookup(i * i), i);
+    }
+    else {
+      EXPECT_FALSE(map.contains(i * i));
+    }
+  }
+}
+
+TEST(swiss_map, StringKeys)
+{
+  SwissMap<std::string, int> map;
+  map.add("a", 1);
+  map.add("b", 2);
+  EXPECT_EQ(map.lookup_as(StringRef("a")), 1);
+  EXPECT_EQ(map.lookup("b"), 2);
+  EXPECT_EQ(map.lookup_ptr_as(StringRef("c")), nullptr);
+}
+
+TEST(swiss_map, CopyConstructorExceptions)
+{
+  using MapType = SwissMap<ExceptionThrower, ExceptionThrower>;
+  MapType map;
+  map.add(2, 2);
+  map.add(4, 4);
+  map.lookup(2).throw_during_copy = true;
+  EXPECT_ANY_THROW({ MapType map_copy(map); });
+}
+
+TEST(swiss_map, AddNewExceptions)
+{
+  SwissMap<ExceptionThrower, ExceptionThrower> map;
+  ExceptionThrower key1 = 1;
+  key1.throw_during_copy = true;
+  ExceptionThrower value1;
+  EXPECT_ANY_THROW({ map.add_new(key1, value1); });
+  EXPECT_EQ(map.size(), 0);
+  ExceptionThrower key2 = 2;
+  ExceptionThrower value2;
+  value2.throw_during_copy = true;
+  EXPECT_ANY_THROW({ map.add_new(key2, value2); });
+  EXPECT_EQ(map.size(), 0);
+}
+
+TEST(swiss_map, ReserveExceptions)
+{
+  SwissMap<ExceptionThrower, ExceptionThrower> map;
+  map.add(3, 3);
+  map.add(5, 5);
+  map.add(2, 2);
+  map.lookup(2).throw_during_move = true;
+  EXPECT_ANY_THROW({ map.reserve(100); });
+  map.add(1, 1);
+  map.add(5, 5);
+}
+
+/**
+ * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
+ */
+#if 0
+template<typename MapT>
+BLI_NOINLINE void benchmark_random_ints(StringRef name, int amount, int factor)
+{
+  RNG *rng = BLI_rng_new(0);
+  Vector<int> values;
+  for (int i = 0; i < amount; i++) {
+    values.append(BLI_rng_get_int(rng) * factor);
+  }
+  BLI_rng_free(rng);
+
+  MapT map;
+  {
+    SCOPED_TIMER(name + " Add");
+    for (int value : values) {
+      map.add(value, value);
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER(name + " Contains");
+    for (int value : values) {
+      count += map.contains(value);
+    }
+  }
+  {
+    SCOPED_TIMER(name + " Remove");
+    for (int value : values) {
+      count += map.remove(value);
+    }
+  }
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Count: " << count << "\n";
+}
+
+TEST(swiss_map, Benchmark)
+{
+  for (int i = 0; i < 3; i++) {
+    benchmark_random_ints<blender::Map<int, int>>("blender::Map          ", 1000000, 1);
+    benchmark_random_ints<blender::SwissMap<int, int>>("blender::SwissMap     ", 1000000, 1);
+  }
+  std::cout << "\n";
+  for (int i = 0; i < 3; i++) {
+    uint32_t factor = (3 << 10);
+    benchmark_random_ints<blender::Map<int, int>>("blender::Map          ", 1000000, factor);
+    benchmark_random_ints<blender::SwissMap<int, int>>("blender::SwissMap     ", 1000000, factor);
+  }
+}
+
+#endif /* Benchmark */
+
+}  // namespace blender::tests
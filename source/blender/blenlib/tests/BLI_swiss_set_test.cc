@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_exception_safety_test_utils.hh"
+#include "BLI_strict_flags.h"
+#include "BLI_swiss_set.hh"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(swiss_set, DefaultConstructor)
+{
+  SwissSet<int> set;
+  EXPECT_EQ(set.size(), 0);
+  EXPECT_TRUE(set.is_empty());
+  EXPECT_FALSE(set.contains(0));
+  EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(swiss_set, AddContainsRemove)
+{
+  SwissSet<int> set;
+  EXPECT_TRUE(set.add(5));
+  EXPECT_FALSE(set.add(5));
+  set.add_new(6);
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_TRUE(set.contains(5));
+  EXPECT_TRUE(set.contains(6));
+  EXPECT_FALSE(set.contains(7));
+  EXPECT_TRUE(set.remove(5));
+  EXPECT_FALSE(set.remove(5));
+  EXPECT_FALSE(set.contains(5));
+  EXPECT_EQ(set.size(), 1);
+}
+
+TEST(swiss_set, Many)
+{
+  SwissSet<int> set;
+  for (int i = 0; i < 10000; i++) {
+    set.add(i * 7);
+  }
+  EXPECT_EQ(set.size(), 10000);
+  for (int i = 0; i < 10000; i += 2) {
+    set.remove_contained(i * 7);
+  }
+  EXPECT_EQ(set.size(), 5000);
+  int count = 0;
+  for (const int value : set) {
+    EXPECT_EQ(value % 14, 7);
+    count++;
+  }
+  EXPECT_EQ(count, 5000);
+}
+
+TEST(swiss_set, InitializerListAndCopy)
+{
+  SwissSet<int> set = {4, 5, 6, 5};
+  EXPECT_EQ(set.size(), 3);
+  SwissSet<int> copy = set;
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_TRUE(copy.contains(4));
+  SwissSet<int> moved = std::move(set);
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(set.size(), 0); /* NOLINT: bugprone-use-after-move */
+  EXPECT_TRUE(SwissSet<int>::Intersects(copy, moved));
+  EXPECT_TRUE(SwissSet<int>::Disjoint(copy, SwissSet<int>{1, 2, 3}));
+}
+
+TEST(swiss_set, LookupKey)
+{
+  SwissSet<std::string> set;
+  set.add("a");
+  set.add("b");
+  EXPECT_EQ(set.lookup_key("a"), "a");
+  EXPECT_EQ(set.lookup_key_as(StringRef("b")), "b");
+  EXPECT_EQ(set.lookup_key_ptr("c"), nullptr);
+  EXPECT_EQ(set.lookup_key_default("c", "d"), "d");
+  EXPECT_EQ(set.lookup_key_or_add("c"), "c");
+  EXPECT_EQ(set.size(), 3);
+}
+
+TEST(swiss_set, RemoveIf)
+{
+  SwissSet<int64_t> set;
+  for (const int64_t i : IndexRange(100)) {
+    set.add(i * i);
+  }
+  set.remove_if([](const int64_t key) { return key > 100; });
+  EXPECT_EQ(set.size(), 11);
+  for (const int64_t i : IndexRange(100)) {
+    EXPECT_EQ(set.contains(i * i), i <= 10);
+  }
+}
+
+TEST(swiss_set, ReserveExceptions)
+{
+  SwissSet<ExceptionThrower> set;
+  set.add(1);
+  set.add(2);
+  set.add(3);
+  const_cast<ExceptionThrower &>(set.lookup_key(2)).throw_during_move = true;
+  EXPECT_ANY_THROW({ set.reserve(100); });
+  EXPECT_EQ(set.size(), 0);
+  set.add(4);
+  EXPECT_TRUE(set.contains(4));
+}
+
+}  // namespace blender::tests
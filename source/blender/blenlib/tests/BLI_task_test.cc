@@ -3,6 +3,7 @@
 #include "testing/testing.h"
 #include <atomic>
 #include <cstring>
+#include <vector>
 
 #include "atomic_ops.h"
 
@@ -294,3 +295,51 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, ParallelForAdaptiveGrainSize)
+{
+  static blender::threading::AdaptiveGrainSize grain_size("ParallelForAdaptiveGrainSize");
+  std::vector<std::atomic<int>> visited(ITEMS_NUM);
+  for (int iteration = 0; iteration < 3; iteration++) {
+    blender::threading::parallel_for(
+        blender::IndexRange(ITEMS_NUM), grain_size, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            visited[i]++;
+          }
+        });
+    /* Every element is processed exactly once, including the ones used for estimating. */
+    for (const int i : blender::IndexRange(ITEMS_NUM)) {
+      EXPECT_EQ(visited[i], iteration + 1);
+    }
+  }
+  blender::threading::parallel_for(
+      blender::IndexRange(0), grain_size, [&](const blender::IndexRange /*range*/) {
+        ADD_FAILURE();
+      });
+}
+
+TEST(task, NumaNodes)
+{
+  const int numa_nodes_num = blender::threading::numa_nodes_num();
+  EXPECT_GE(numa_nodes_num, 1);
+  for (const int numa_node : blender::IndexRange(numa_nodes_num)) {
+    std::atomic<int> counter = 0;
+    blender::threading::execute_on_numa_node(numa_node, [&]() {
+      blender::threading::parallel_for(
+          blender::IndexRange(ITEMS_NUM), 100, [&](const blender::IndexRange range) {
+            counter += range.size();
+          });
+    });
+    EXPECT_EQ(counter, ITEMS_NUM);
+
+    const size_t size = 1000000;
+    char *data = static_cast<char *>(blender::threading::numa_calloc(size, numa_node, __func__));
+    for (const size_t i : blender::IndexRange(size)) {
+      if (data[i] != 0) {
+        ADD_FAILURE();
+        break;
+      }
+    }
+    MEM_freeN(data);
+  }
+}
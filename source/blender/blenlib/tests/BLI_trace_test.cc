@@ -0,0 +1,50 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "BLI_fileops.h"
+#include "BLI_task.hh"
+#include "BLI_trace.h"
+
+namespace blender::tests {
+
+static std::string read_file(const std::string &filepath)
+{
+  std::ifstream file(filepath);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+TEST(trace, NotRecording)
+{
+  EXPECT_FALSE(BLI_trace_is_recording());
+  EXPECT_EQ(BLI_trace_event_begin(), 0);
+  EXPECT_FALSE(BLI_trace_end_recording());
+}
+
+TEST(trace, RecordThreads)
+{
+  const std::string filepath = ::testing::TempDir() + "BLI_trace_test.json";
+  BLI_trace_begin_recording(filepath.c_str());
+  EXPECT_TRUE(BLI_trace_is_recording());
+  {
+    BLI_TRACE_SCOPE("Main \"Thread\"");
+    threading::parallel_for(IndexRange(1000), 1, [&](const IndexRange /*range*/) {
+      BLI_TRACE_SCOPE("Worker");
+    });
+  }
+  EXPECT_TRUE(BLI_trace_end_recording());
+  EXPECT_FALSE(BLI_trace_is_recording());
+
+  const std::string trace = read_file(filepath);
+  EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0);
+  EXPECT_NE(trace.find("\"name\":\"Main \\\"Thread\\\"\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"Worker\""), std::string::npos);
+  BLI_delete(filepath.c_str(), false, false);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_index_mask_ops.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+/* Number of times each timed scope runs, the average and minimum times are printed. */
+#define NUM_RUN_AVERAGED 10
+
+namespace blender::tests {
+
+static Vector<int> random_ints(const int amount, const int factor)
+{
+  RandomNumberGenerator rng;
+  Vector<int> values(amount);
+  for (int &value : values) {
+    /* Masked so that multiplying by the factor doesn't overflow. */
+    value = (rng.get_int32() & 0xfffff) * factor;
+  }
+  return values;
+}
+
+/* *** Core containers. *** */
+
+TEST(map_performance, AddLookupRemove)
+{
+  const Vector<int> values = random_ints(1000000, 1);
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    Map<int, int> map;
+    {
+      SCOPED_TIMER_AVERAGED("Map: add");
+      for (const int value : values) {
+        map.add(value, value);
+      }
+    }
+    int count = 0;
+    {
+      SCOPED_TIMER_AVERAGED("Map: lookup");
+      for (const int value : values) {
+        count += map.contains(value);
+      }
+    }
+    {
+      SCOPED_TIMER_AVERAGED("Map: remove");
+      for (const int value : values) {
+        map.remove(value);
+      }
+    }
+    EXPECT_EQ(count, values.size());
+    EXPECT_TRUE(map.is_empty());
+  }
+}
+
+TEST(map_performance, AddBadHashDistribution)
+{
+  /* Multiples of a power of two are a worst case for hash tables masking the lower bits. */
+  const Vector<int> values = random_ints(1000000, 1 << 10);
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    SCOPED_TIMER_AVERAGED("Map: add multiples of 1024");
+    Map<int, int> map;
+    for (const int value : values) {
+      map.add(value, value);
+    }
+  }
+}
+
+TEST(vector_set_performance, AddIndexOf)
+{
+  const Vector<int> values = random_ints(1000000, 1);
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    VectorSet<int> set;
+    {
+      SCOPED_TIMER_AVERAGED("VectorSet: add");
+      for (const int value : values) {
+        set.add(value);
+      }
+    }
+    int64_t sum = 0;
+    {
+      SCOPED_TIMER_AVERAGED("VectorSet: index_of");
+      for (const int value : values) {
+        sum += set.index_of(value);
+      }
+    }
+    EXPECT_GE(sum, 0);
+  }
+}
+
+/* *** Index masks and task scheduling. *** */
+
+TEST(index_mask_performance, FindIndicesBasedOnPredicate)
+{
+  const Vector<int> values = random_ints(10000000, 1);
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    SCOPED_TIMER_AVERAGED("IndexMask: find even values");
+    Vector<int64_t> indices;
+    const IndexMask mask = index_mask_ops::find_indices_based_on_predicate(
+        values.index_range(), 4096, indices, [&](const int64_t i) { return values[i] % 2 == 0; });
+    EXPECT_LE(mask.size(), values.size());
+  }
+}
+
+TEST(task_performance, ParallelForGrainSizes)
+{
+  Vector<float> values(10000000, 1.0f);
+
+  for (const int64_t grain_size : {64, 512, 4096, 65536}) {
+    SCOPED_TIMER("parallel_for: grain size " + std::to_string(grain_size));
+    for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+      threading::parallel_for(values.index_range(), grain_size, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          values[i] = values[i] * 0.5f + 0.5f;
+        }
+      });
+    }
+  }
+  EXPECT_FLOAT_EQ(values.first(), 1.0f);
+}
+
+}  // namespace blender::tests
@@ -18,8 +18,13 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   size_t size;
-  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
+  /**
+   * When true, this chunk is identical to the chunk at the same position in the previous step
+   * (used by undo code to detect unchanged IDs). Such chunks never own their memory.
+   */
   bool is_identical;
+  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
+  bool is_shared;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
@@ -27,6 +32,8 @@ typedef struct {
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
+  /** Hash of the chunk content, only computed for chunks large enough to be de-duplicated. */
+  uint hash;
 } MemFileChunk;
 
 typedef struct MemFile {
@@ -43,6 +50,11 @@ typedef struct MemFileWriteData {
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   struct GHash *id_session_uuid_mapping;
+  /**
+   * Maps the content hash of reference chunks to the chunk, used to share memory with chunks
+   * that moved to another position (e.g. because data written before them changed size).
+   */
+  struct GHash *chunk_hash_mapping;
 } MemFileWriteData;
 
 typedef struct MemFileUndoData {
@@ -73,6 +85,12 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add all chunks of the ID starting at \a reference_chunk to the written memfile, sharing
+ * their memory and marking them as identical, without comparing any data.
+ * Used for IDs that are known to be unchanged since the reference memfile was written.
+ */
+void BLO_memfile_chunks_reuse_id(MemFileWriteData *mem_data, MemFileChunk *reference_chunk);
 
 /* exports */
 
@@ -91,6 +109,11 @@ extern void BLO_memfile_merge(MemFile *first, MemFile *second);
  * Clear is_identical_future before adding next memfile.
  */
 extern void BLO_memfile_clear_future(MemFile *memfile);
+/**
+ * Copy all chunks of \a memfile into \a r_memfile, which owns all of its memory.
+ * The copy is independent from the undo stack, so it remains valid when undo steps are freed.
+ */
+extern void BLO_memfile_copy(const MemFile *memfile, MemFile *r_memfile);
 
 /* Utilities. */
 
@@ -65,6 +65,17 @@ extern bool BLO_write_file_mem(struct Main *mainvar,
                                struct MemFile *current,
                                int write_flags);
 
+/**
+ * Write the content of an undo #MemFile to disk, optionally compressed.
+ * Does not access #Main, so it can be used from a worker thread as long as
+ * \a memfile is not modified meanwhile (see #BLO_memfile_copy).
+ *
+ * \return Success.
+ */
+extern bool BLO_write_file_from_memfile(struct MemFile *memfile,
+                                        const char *filepath,
+                                        bool use_compress);
+
 /** \} */
 
 #ifdef __cplusplus
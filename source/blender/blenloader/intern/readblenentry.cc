@@ -19,6 +19,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_genfile.h"
@@ -358,6 +359,8 @@ BlendFileData *BLO_read_from_file(const char *filepath,
                                   eBLOReadSkip skip_flags,
                                   BlendFileReadReport *reports)
 {
+  BLI_TRACE_SCOPE("Read Blend File");
+
   BlendFileData *bfd = NULL;
   FileData *fd;
 
@@ -53,6 +53,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 
 #include "PIL_time.h"
@@ -994,6 +995,21 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   }
   return &new_bhead_data->bhead;
 }
+
+/**
+ * Access the data of a block that has not been read yet without copying it,
+ * only supported for memory-backed readers (memory-mapped files for example).
+ * The returned data is read-only and must not be kept after the file is closed.
+ */
+static const void *blo_bhead_peek_data(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->file->peek == nullptr) {
+    return nullptr;
+  }
+  return fd->file->peek(fd->file, new_bhead->file_offset, size_t(new_bhead->bhead.len));
+}
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
@@ -1876,6 +1892,39 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
+/**
+ * Convert the block data to the current DNA, large arrays of structs
+ * (mesh data in files from older versions for example) are converted in parallel.
+ */
+static void *blo_struct_reconstruct(FileData *fd, const BHead *bh, const void *old_blocks)
+{
+  /* Below this number of bytes threading overhead outweighs the conversion. */
+  const int64_t parallel_min_len = 256 * 1024;
+  if (bh->len < parallel_min_len || bh->nr < 2) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, old_blocks);
+  }
+
+  const int new_block_size = DNA_struct_reconstruct_block_size(fd->reconstruct_info, bh->SDNAnr);
+  if (new_block_size == 0) {
+    return nullptr;
+  }
+  const int old_block_size = fd->filesdna->types_size[fd->filesdna->structs[bh->SDNAnr]->type];
+
+  char *new_blocks = static_cast<char *>(
+      MEM_callocN(size_t(bh->nr) * size_t(new_block_size), "reconstruct"));
+  const int64_t grain_size = std::max<int64_t>(1, parallel_min_len / old_block_size);
+  blender::threading::parallel_for(
+      blender::IndexRange(bh->nr), grain_size, [&](const blender::IndexRange range) {
+        DNA_struct_reconstruct_into(
+            fd->reconstruct_info,
+            bh->SDNAnr,
+            int(range.size()),
+            POINTER_OFFSET(old_blocks, range.start() * old_block_size),
+            new_blocks + range.start() * new_block_size);
+      });
+  return new_blocks;
+}
+
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = nullptr;
@@ -1903,6 +1952,17 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+          /* Reconstruct directly from the mapped file when possible,
+           * this avoids a temporary copy of the whole block. */
+          if (const void *data = blo_bhead_peek_data(fd, bh)) {
+            temp = blo_struct_reconstruct(fd, bh, data);
+            if (UNLIKELY(BLI_filereader_peek_io_error(fd->file))) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              MEM_freeN(temp);
+              return nullptr;
+            }
+            return temp;
+          }
           bh = blo_bhead_read_full(fd, bh);
           if (UNLIKELY(bh == nullptr)) {
             fd->flags &= ~FD_FLAGS_FILE_OK;
@@ -1910,7 +1970,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = blo_struct_reconstruct(fd, bh, (bh + 1));
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -25,6 +25,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -38,12 +39,18 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/**
+ * Chunks smaller than this are not looked up by content, the cost of hashing and the mapping
+ * is not worth it compared to simply copying them.
+ */
+#define MEMFILE_CHUNK_DEDUPLICATE_MIN_SIZE 1024
+
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks)))) {
-    if (chunk->is_identical == false) {
+    if (chunk->is_shared == false) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -61,8 +68,12 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   /* First, detect all memchunks in second memfile that are not owned by it. */
   for (MemFileChunk *sc = static_cast<MemFileChunk *>(second->chunks.first); sc != nullptr;
        sc = static_cast<MemFileChunk *>(sc->next)) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+    if (sc->is_shared) {
+      /* Several chunks may share the same buffer, only one of them can take over ownership. */
+      void **entry;
+      if (!BLI_ghash_ensure_p(buffer_to_second_memchunk, (void *)sc->buf, &entry)) {
+        *entry = sc;
+      }
     }
   }
 
@@ -70,13 +81,13 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
    * it is also used by the second memfile, transfer the ownership. */
   for (MemFileChunk *fc = static_cast<MemFileChunk *>(first->chunks.first); fc != nullptr;
        fc = static_cast<MemFileChunk *>(fc->next)) {
-    if (!fc->is_identical) {
+    if (!fc->is_shared) {
       MemFileChunk *sc = static_cast<MemFileChunk *>(
           BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf));
       if (sc != nullptr) {
-        BLI_assert(sc->is_identical);
-        sc->is_identical = false;
-        fc->is_identical = true;
+        BLI_assert(sc->is_shared);
+        sc->is_shared = false;
+        fc->is_shared = true;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
        * fully owns it without sharing it with any other memfile, and hence it should be freed with
@@ -96,6 +107,29 @@ void BLO_memfile_clear_future(MemFile *memfile)
   }
 }
 
+void BLO_memfile_copy(const MemFile *memfile, MemFile *r_memfile)
+{
+  BLI_listbase_clear(&r_memfile->chunks);
+  r_memfile->size = 0;
+
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileChunk *chunk_copy = static_cast<MemFileChunk *>(
+        MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
+    *chunk_copy = *chunk;
+    chunk_copy->next = chunk_copy->prev = nullptr;
+    chunk_copy->is_identical = false;
+    chunk_copy->is_shared = false;
+    chunk_copy->is_identical_future = false;
+
+    char *buf_new = static_cast<char *>(MEM_mallocN(chunk->size, "Chunk buffer"));
+    memcpy(buf_new, chunk->buf, chunk->size);
+    chunk_copy->buf = buf_new;
+
+    BLI_addtail(&r_memfile->chunks, chunk_copy);
+    r_memfile->size += chunk->size;
+  }
+}
+
 void BLO_memfile_write_init(MemFileWriteData *mem_data,
                             MemFile *written_memfile,
                             MemFile *reference_memfile)
@@ -129,6 +163,19 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
         }
       }
     }
+
+    mem_data->chunk_hash_mapping = BLI_ghash_new(
+        BLI_ghashutil_inthash_p_simple, BLI_ghashutil_intcmp, __func__);
+    LISTBASE_FOREACH (MemFileChunk *, mem_chunk, &reference_memfile->chunks) {
+      if (mem_chunk->size >= MEMFILE_CHUNK_DEDUPLICATE_MIN_SIZE) {
+        /* Keep the first chunk in case of collisions, the content is compared on lookup. */
+        void **entry;
+        if (!BLI_ghash_ensure_p(
+                mem_data->chunk_hash_mapping, POINTER_FROM_UINT(mem_chunk->hash), &entry)) {
+          *entry = mem_chunk;
+        }
+      }
+    }
   }
 }
 
@@ -137,6 +184,9 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   if (mem_data->id_session_uuid_mapping != nullptr) {
     BLI_ghash_free(mem_data->id_session_uuid_mapping, nullptr, nullptr);
   }
+  if (mem_data->chunk_hash_mapping != nullptr) {
+    BLI_ghash_free(mem_data->chunk_hash_mapping, nullptr, nullptr);
+  }
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -149,6 +199,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = nullptr;
   curchunk->is_identical = false;
+  curchunk->is_shared = false;
+  curchunk->hash = 0;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -163,12 +215,30 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
         curchunk->is_identical = true;
+        curchunk->is_shared = true;
+        curchunk->hash = compchunk->hash;
         compchunk->is_identical_future = true;
       }
     }
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
+  if (curchunk->buf == nullptr && size >= MEMFILE_CHUNK_DEDUPLICATE_MIN_SIZE) {
+    curchunk->hash = BLI_hash_mm2((const uchar *)buf, size, 0);
+
+    /* Same content may exist at another position of the previous step, share its memory.
+     * This is not considered identical, since the ID itself may still have changed. */
+    if (mem_data->chunk_hash_mapping != nullptr) {
+      MemFileChunk *hashchunk = static_cast<MemFileChunk *>(
+          BLI_ghash_lookup(mem_data->chunk_hash_mapping, POINTER_FROM_UINT(curchunk->hash)));
+      if (hashchunk != nullptr && hashchunk->size == size &&
+          memcmp(hashchunk->buf, buf, size) == 0) {
+        curchunk->buf = hashchunk->buf;
+        curchunk->is_shared = true;
+      }
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == nullptr) {
     char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
@@ -178,6 +248,31 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+void BLO_memfile_chunks_reuse_id(MemFileWriteData *mem_data, MemFileChunk *reference_chunk)
+{
+  MemFile *memfile = mem_data->written_memfile;
+  const uint id_session_uuid = reference_chunk->id_session_uuid;
+  BLI_assert(id_session_uuid != MAIN_ID_SESSION_UUID_UNSET);
+
+  MemFileChunk *compchunk = reference_chunk;
+  for (; compchunk != nullptr && compchunk->id_session_uuid == id_session_uuid;
+       compchunk = static_cast<MemFileChunk *>(compchunk->next)) {
+    MemFileChunk *curchunk = static_cast<MemFileChunk *>(
+        MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
+    *curchunk = *compchunk;
+    curchunk->next = curchunk->prev = nullptr;
+    curchunk->is_identical = true;
+    curchunk->is_shared = true;
+    curchunk->is_identical_future = true;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+
+  /* Continue comparing with the chunks after this ID. */
+  mem_data->reference_current_chunk = compchunk;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
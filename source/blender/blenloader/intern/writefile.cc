@@ -82,6 +82,7 @@
 #include "DNA_genfile.h"
 #include "DNA_sdna_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -90,7 +91,10 @@
 #include "BLI_linklist.h"
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
+#include "BLI_vector.hh"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -423,6 +427,12 @@ typedef struct {
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
 
+  /**
+   * When set, every write is recorded as a chunk of this memfile instead of being written out,
+   * so it can be replayed later in the same order (see #write_ids_parallel).
+   */
+  MemFile *record_memfile;
+
   /**
    * Wrap writing, so we can use zstd or
    * other compression types later, see: G_FILE_COMPRESS
@@ -464,6 +474,19 @@ static void writedata_do_write(WriteData *wd, const void *mem, size_t memlen)
     return;
   }
 
+  if (wd->record_memfile) {
+    /* Recorded chunks are split when replayed, so they are not limited in size. */
+    MemFileChunk *chunk = static_cast<MemFileChunk *>(
+        MEM_callocN(sizeof(MemFileChunk), "MemFileChunk"));
+    char *buf = static_cast<char *>(MEM_mallocN(memlen, "Chunk buffer"));
+    memcpy(buf, mem, memlen);
+    chunk->buf = buf;
+    chunk->size = memlen;
+    BLI_addtail(&wd->record_memfile->chunks, chunk);
+    wd->record_memfile->size += memlen;
+    return;
+  }
+
   if (memlen > INT_MAX) {
     BLI_assert_msg(0, "Cannot write chunks bigger than INT_MAX.");
     return;
@@ -638,6 +661,61 @@ static void mywrite_id_begin(WriteData *wd, ID *id)
   }
 }
 
+static bool id_is_unchanged_since_undo_push(const ID *id)
+{
+  /* When changes happened before the previous undo push, `recalc_up_to_undo_push` stored in the
+   * reference memfile is different from the value that would be written now. */
+  return id->recalc_after_undo_push == 0 && id->recalc_up_to_undo_push == 0;
+}
+
+/**
+ * Reuse the memory of the reference memfile for IDs that were not tagged as changed since it
+ * was written, skipping the serialization entirely.
+ *
+ * Only does something when storing an undo step.
+ *
+ * \return True when the ID does not need to be written.
+ */
+static bool mywrite_id_reuse_unchanged(WriteData *wd, ID *id)
+{
+  if (!wd->use_memfile || wd->mem.id_session_uuid_mapping == nullptr ||
+      !USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged_ids)) {
+    return false;
+  }
+
+  if (!id_is_unchanged_since_undo_push(id)) {
+    return false;
+  }
+  bNodeTree *nodetree = ntreeFromID(id);
+  if (nodetree != nullptr && !id_is_unchanged_since_undo_push(&nodetree->id)) {
+    return false;
+  }
+  if (GS(id->name) == ID_SCE) {
+    Scene *scene = (Scene *)id;
+    if (scene->master_collection != nullptr &&
+        !id_is_unchanged_since_undo_push(&scene->master_collection->id)) {
+      return false;
+    }
+  }
+
+  MemFileChunk *reference_chunk = static_cast<MemFileChunk *>(
+      BLI_ghash_lookup(wd->mem.id_session_uuid_mapping, POINTER_FROM_UINT(id->session_uuid)));
+  if (reference_chunk == nullptr || reference_chunk->size < sizeof(BHead)) {
+    return false;
+  }
+
+  /* The first chunk of an ID starts with the block of the ID itself, it must still be stored at
+   * the same address, otherwise pointers to it from other data would not be restored. */
+  BHead bhead;
+  memcpy(&bhead, reference_chunk->buf, sizeof(BHead));
+  if (bhead.old != id || bhead.code != GS(id->name)) {
+    return false;
+  }
+
+  BLO_memfile_chunks_reuse_id(&wd->mem, reference_chunk);
+  return true;
+}
+
 /**
  * Start writing of data related to a single ID.
  *
@@ -1086,6 +1164,118 @@ static void write_thumb(WriteData *wd, const BlendThumbnail *thumb)
  * \{ */
 
 /* if MemFile * there's filesave to memory */
+/**
+ * Write a single ID and all of its data.
+ *
+ * \param id_buffer: Memory of at least the ID type struct size, used to write a modified copy
+ * of the ID struct.
+ */
+static void write_id(BlendWriter *writer, const IDTypeInfo *id_type, ID *id, void *id_buffer)
+{
+  memcpy(id_buffer, id, id_type->struct_size);
+
+  /* Clear runtime data to reduce false detection of changed data in undo/redo context. */
+  ((ID *)id_buffer)->tag = 0;
+  ((ID *)id_buffer)->us = 0;
+  ((ID *)id_buffer)->icon_id = 0;
+  /* Those listbase data change every time we add/remove an ID, and also often when
+   * renaming one (due to re-sorting). This avoids generating a lot of false 'is changed'
+   * detections between undo steps. */
+  ((ID *)id_buffer)->prev = nullptr;
+  ((ID *)id_buffer)->next = nullptr;
+  /* Those runtime pointers should never be set during writing stage, but just in case clear
+   * them too. */
+  ((ID *)id_buffer)->orig_id = nullptr;
+  ((ID *)id_buffer)->newid = nullptr;
+  /* Even though in theory we could be able to preserve this python instance across undo even
+   * when we need to re-read the ID into its original address, this is currently cleared in
+   * #direct_link_id_common in `readfile.c` anyway, */
+  ((ID *)id_buffer)->py_instance = nullptr;
+
+  if (id_type->blend_write != nullptr) {
+    id_type->blend_write(writer, (ID *)id_buffer, id);
+  }
+}
+
+/**
+ * ID types that hold large amounts of data and whose writing code only accesses the ID itself,
+ * so that multiple IDs of that type can be written from different threads.
+ */
+static bool write_id_type_supports_parallel(const short id_code)
+{
+  return ELEM(id_code, ID_ME, ID_CV, ID_PT, ID_IM);
+}
+
+/**
+ * Serialize the IDs of \a lb into separate recordings from multiple threads, and replay them into
+ * \a wd in the original order, so that the output is identical to writing them one by one.
+ *
+ * Only used when writing files, undo steps would not benefit as unchanged data is not copied.
+ *
+ * \return False when the IDs could not be written in parallel, nothing has been written then.
+ */
+static bool write_ids_parallel(WriteData *wd,
+                               ListBase *lb,
+                               const IDTypeInfo *id_type,
+                               const bool use_override_storage)
+{
+  using namespace blender;
+
+  if (wd->use_memfile || !write_id_type_supports_parallel(id_type->id_code) ||
+      BLI_system_thread_count() < 2) {
+    return false;
+  }
+
+  Vector<ID *> ids;
+  LISTBASE_FOREACH (ID *, id, lb) {
+    /* Library override operations are stored in #Main, they can't be done from threads. */
+    if (use_override_storage && ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
+      return false;
+    }
+    if (id->us == 0) {
+      continue;
+    }
+    ids.append(id);
+  }
+  if (ids.size() < 2) {
+    return false;
+  }
+
+  /* Process the IDs in batches, to limit the amount of memory used by the recordings. */
+  const int64_t batch_size = int64_t(BLI_system_thread_count()) * 2;
+  Array<MemFile> recordings(batch_size);
+  for (int64_t batch_start = 0; batch_start < ids.size(); batch_start += batch_size) {
+    const IndexRange batch(batch_start, std::min(batch_size, ids.size() - batch_start));
+
+    threading::parallel_for(IndexRange(batch.size()), 1, [&](const IndexRange range) {
+      void *id_buffer = MEM_mallocN(id_type->struct_size, __func__);
+      for (const int64_t i : range) {
+        MemFile &recording = recordings[i];
+        BLI_listbase_clear(&recording.chunks);
+        recording.size = 0;
+
+        /* No buffering, so the recorded chunks match the original write calls exactly. */
+        WriteData *wd_record = static_cast<WriteData *>(MEM_callocN(sizeof(*wd), __func__));
+        wd_record->sdna = wd->sdna;
+        wd_record->record_memfile = &recording;
+        BlendWriter writer = {wd_record};
+        write_id(&writer, id_type, ids[batch[i]], id_buffer);
+        MEM_freeN(wd_record);
+      }
+      MEM_freeN(id_buffer);
+    });
+
+    for (const int64_t i : IndexRange(batch.size())) {
+      LISTBASE_FOREACH (MemFileChunk *, chunk, &recordings[i].chunks) {
+        mywrite(wd, chunk->buf, chunk->size);
+      }
+      BLO_memfile_free(&recordings[i]);
+    }
+  }
+
+  return true;
+}
+
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
                               MemFile *compare,
@@ -1153,6 +1343,10 @@ static bool write_file_handle(Main *mainvar,
         id_buffer = MEM_mallocN(idtype_struct_size, __func__);
       }
 
+      if (write_ids_parallel(wd, lbarray[a], id_type, !ELEM(override_storage, nullptr, bmain))) {
+        id = nullptr;
+      }
+
       for (; id; id = static_cast<ID *>(id->next)) {
         /* We should never attempt to write non-regular IDs
          * (i.e. all kind of temp/runtime ones). */
@@ -1167,6 +1361,10 @@ static bool write_file_handle(Main *mainvar,
           continue;
         }
 
+        if (mywrite_id_reuse_unchanged(wd, id)) {
+          continue;
+        }
+
         const bool do_override = !ELEM(override_storage, nullptr, bmain) &&
                                  ID_IS_OVERRIDE_LIBRARY_REAL(id);
 
@@ -1198,29 +1396,7 @@ static bool write_file_handle(Main *mainvar,
 
         mywrite_id_begin(wd, id);
 
-        memcpy(id_buffer, id, idtype_struct_size);
-
-        /* Clear runtime data to reduce false detection of changed data in undo/redo context. */
-        ((ID *)id_buffer)->tag = 0;
-        ((ID *)id_buffer)->us = 0;
-        ((ID *)id_buffer)->icon_id = 0;
-        /* Those listbase data change every time we add/remove an ID, and also often when
-         * renaming one (due to re-sorting). This avoids generating a lot of false 'is changed'
-         * detections between undo steps. */
-        ((ID *)id_buffer)->prev = nullptr;
-        ((ID *)id_buffer)->next = nullptr;
-        /* Those runtime pointers should never be set during writing stage, but just in case clear
-         * them too. */
-        ((ID *)id_buffer)->orig_id = nullptr;
-        ((ID *)id_buffer)->newid = nullptr;
-        /* Even though in theory we could be able to preserve this python instance across undo even
-         * when we need to re-read the ID into its original address, this is currently cleared in
-         * #direct_link_id_common in `readfile.c` anyway, */
-        ((ID *)id_buffer)->py_instance = nullptr;
-
-        if (id_type->blend_write != nullptr) {
-          id_type->blend_write(&writer, (ID *)id_buffer, id);
-        }
+        write_id(&writer, id_type, id, id_buffer);
 
         if (do_override) {
           BKE_lib_override_library_operations_store_end(override_storage, id);
@@ -1325,6 +1501,8 @@ bool BLO_write_file(Main *mainvar,
   BLI_assert(!BLI_path_is_rel(filepath));
   BLI_assert(BLI_path_is_abs_from_cwd(filepath));
 
+  BLI_TRACE_SCOPE("Write Blend File");
+
   char tempname[FILE_MAX + 1];
   WriteWrap ww;
 
@@ -1491,6 +1669,40 @@ bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int w
   return (err == 0);
 }
 
+bool BLO_write_file_from_memfile(MemFile *memfile, const char *filepath, const bool use_compress)
+{
+  char tempname[FILE_MAX + 1];
+  WriteWrap ww;
+
+  /* Write to a temporary file first, so a previous file is kept if writing is interrupted. */
+  BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
+
+  ww_handle_init(use_compress ? WW_WRAP_ZSTD : WW_WRAP_NONE, &ww);
+  if (ww.open(&ww, tempname) == false) {
+    CLOG_ERROR(&LOG, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  /* Go through the regular buffering, memfile chunks are too small to be compressed one by one. */
+  WriteData *wd = mywrite_begin(&ww, nullptr, nullptr);
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    mywrite(wd, chunk->buf, chunk->size);
+  }
+  const bool err = mywrite_end(wd);
+
+  if (ww.close(&ww) == false || err) {
+    CLOG_ERROR(&LOG, "Unable to write %s: %s", tempname, strerror(errno));
+    remove(tempname);
+    return false;
+  }
+
+  if (BLI_rename(tempname, filepath) != 0) {
+    CLOG_ERROR(&LOG, "Cannot change old file %s (file saved with @)", filepath);
+    return false;
+  }
+  return true;
+}
+
 void BLO_write_raw(BlendWriter *writer, size_t size_in_bytes, const void *data_ptr)
 {
   writedata(writer->wd, DATA, size_in_bytes, data_ptr);
@@ -85,6 +85,7 @@
 #include "BLI_span.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.h"
@@ -109,6 +110,7 @@ using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
 using blender::StringRef;
+using blender::Vector;
 
 /* Static function for alloc (duplicate in modifiers_bmesh.c) */
 static BMFace *bm_face_create_from_mpoly(BMesh &bm,
@@ -919,11 +921,60 @@ static void convert_bmesh_selection_flags_to_mesh_attributes(BMesh &bm,
   }
 }
 
+/**
+ * A layer copied from BMesh blocks to the mesh attribute array of the same type, matched once for
+ * all elements instead of by #CustomData_from_bmesh_block for every element.
+ */
+struct BMeshToMeshLayerInfo {
+  eCustomDataType type;
+  int bmesh_offset;
+  int elem_size;
+  void *mesh_data;
+};
+
+static Vector<BMeshToMeshLayerInfo> bm_to_mesh_copy_info_calc(const CustomData &bm_data,
+                                                              CustomData &me_data)
+{
+  Vector<BMeshToMeshLayerInfo> info;
+  /* Match layers the same way as #CustomData_from_bmesh_block, they are ordered by type. */
+  int dst_i = 0;
+  for (int src_i = 0; src_i < bm_data.totlayer; src_i++) {
+    const CustomDataLayer &src_layer = bm_data.layers[src_i];
+    while (dst_i < me_data.totlayer && me_data.layers[dst_i].type < src_layer.type) {
+      dst_i++;
+    }
+    if (dst_i >= me_data.totlayer) {
+      break;
+    }
+    if (me_data.layers[dst_i].type == src_layer.type) {
+      BMeshToMeshLayerInfo layer_info;
+      layer_info.type = eCustomDataType(src_layer.type);
+      layer_info.bmesh_offset = src_layer.offset;
+      layer_info.elem_size = CustomData_sizeof(src_layer.type);
+      layer_info.mesh_data = me_data.layers[dst_i].data;
+      info.append(layer_info);
+      dst_i++;
+    }
+  }
+  return info;
+}
+
+static void bmesh_block_copy_to_mesh_attributes(const Span<BMeshToMeshLayerInfo> copy_info,
+                                                const int mesh_index,
+                                                void *block)
+{
+  for (const BMeshToMeshLayerInfo &info : copy_info) {
+    CustomData_copy_elements(info.type,
+                             POINTER_OFFSET(block, info.bmesh_offset),
+                             POINTER_OFFSET(info.mesh_data, size_t(mesh_index) * info.elem_size),
+                             1);
+  }
+}
+
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
+  using namespace blender;
+  BMVert *eve;
   BMIter iter;
   int i, j;
 
@@ -978,101 +1029,118 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
    * different than the BMesh's. */
   BKE_mesh_clear_derived_normals(me);
 
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(mvert[i].co, v->co);
-
-    if (BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
-      need_hide_vert = true;
-    }
-    if (BM_elem_flag_test(v, BM_ELEM_SELECT)) {
-      need_select_vert = true;
-    }
-
-    BM_elem_index_set(v, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
-    i++;
-
-    BM_CHECK_ELEMENT(v);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    medge[i].v1 = BM_elem_index_get(e->v1);
-    medge[i].v2 = BM_elem_index_get(e->v2);
-
-    medge[i].flag = BM_edge_flag_to_mflag(e);
-    if (BM_elem_flag_test(e, BM_ELEM_HIDDEN)) {
-      need_hide_edge = true;
-    }
-    if (BM_elem_flag_test(e, BM_ELEM_SELECT)) {
-      need_select_edge = true;
-    }
-
-    BM_elem_index_set(e, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
-    bmesh_quick_edgedraw_flag(&medge[i], e);
-
-    i++;
-    BM_CHECK_ELEMENT(e);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  i = 0;
-  j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly[i].loopstart = j;
-    mpoly[i].totloop = f->len;
-    if (f->mat_nr != 0) {
-      need_material_index = true;
-    }
-    mpoly[i].flag = BM_face_flag_to_mflag(f);
-    if (BM_elem_flag_test(f, BM_ELEM_HIDDEN)) {
-      need_hide_poly = true;
-    }
-    if (BM_elem_flag_test(f, BM_ELEM_SELECT)) {
-      need_select_poly = true;
-    }
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop[j].e = BM_elem_index_get(l_iter->e);
-      mloop[j].v = BM_elem_index_get(l_iter->v);
-
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
-
-      j++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    if (f == bm->act_face) {
-      me->act_face = i;
-    }
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-    i++;
-    BM_CHECK_ELEMENT(f);
-  }
+  Array<BMVert *> vert_table(bm->totvert);
+  Array<BMEdge *> edge_table(bm->totedge);
+  Array<BMFace *> face_table(bm->totface);
+
+  /* Build the element tables and set the indices of every element type at the same time, each
+   * task only writes to the elements of its own type. */
+  threading::parallel_invoke(
+      (bm->totface > 1024),
+      [&]() {
+        BMIter iter_vert;
+        BMVert *v;
+        int vert_i;
+        BM_ITER_MESH_INDEX (v, &iter_vert, bm, BM_VERTS_OF_MESH, vert_i) {
+          vert_table[vert_i] = v;
+          BM_elem_index_set(v, vert_i); /* set_inline */
+          need_hide_vert |= BM_elem_flag_test_bool(v, BM_ELEM_HIDDEN);
+          need_select_vert |= BM_elem_flag_test_bool(v, BM_ELEM_SELECT);
+        }
+      },
+      [&]() {
+        BMIter iter_edge;
+        BMEdge *e;
+        int edge_i;
+        BM_ITER_MESH_INDEX (e, &iter_edge, bm, BM_EDGES_OF_MESH, edge_i) {
+          edge_table[edge_i] = e;
+          BM_elem_index_set(e, edge_i); /* set_inline */
+          need_hide_edge |= BM_elem_flag_test_bool(e, BM_ELEM_HIDDEN);
+          need_select_edge |= BM_elem_flag_test_bool(e, BM_ELEM_SELECT);
+        }
+      },
+      [&]() {
+        BMIter iter_face;
+        BMFace *f;
+        int face_i;
+        int loop_i = 0;
+        BM_ITER_MESH_INDEX (f, &iter_face, bm, BM_FACES_OF_MESH, face_i) {
+          face_table[face_i] = f;
+          BM_elem_index_set(f, face_i); /* set_inline */
+          mpoly[face_i].loopstart = loop_i;
+          mpoly[face_i].totloop = f->len;
+          loop_i += f->len;
+          need_material_index |= f->mat_nr != 0;
+          need_hide_poly |= BM_elem_flag_test_bool(f, BM_ELEM_HIDDEN);
+          need_select_poly |= BM_elem_flag_test_bool(f, BM_ELEM_SELECT);
+          if (f == bm->act_face) {
+            me->act_face = face_i;
+          }
+        }
+      });
+  bm->elem_index_dirty &= ~(BM_VERT | BM_EDGE | BM_FACE);
+
+  const Vector<BMeshToMeshLayerInfo> vert_info = bm_to_mesh_copy_info_calc(bm->vdata, me->vdata);
+  const Vector<BMeshToMeshLayerInfo> edge_info = bm_to_mesh_copy_info_calc(bm->edata, me->edata);
+  const Vector<BMeshToMeshLayerInfo> loop_info = bm_to_mesh_copy_info_calc(bm->ldata, me->ldata);
+  const Vector<BMeshToMeshLayerInfo> poly_info = bm_to_mesh_copy_info_calc(bm->pdata, me->pdata);
+
+  /* All indices are known now, so elements can be converted in any order. */
+  threading::parallel_invoke(
+      (bm->totface > 1024),
+      [&]() {
+        threading::parallel_for(vert_table.index_range(), 1024, [&](const IndexRange range) {
+          for (const int vert_i : range) {
+            BMVert *v = vert_table[vert_i];
+            copy_v3_v3(mvert[vert_i].co, v->co);
+            bmesh_block_copy_to_mesh_attributes(vert_info, vert_i, v->head.data);
+            BM_CHECK_ELEMENT(v);
+          }
+        });
+      },
+      [&]() {
+        threading::parallel_for(edge_table.index_range(), 1024, [&](const IndexRange range) {
+          for (const int edge_i : range) {
+            BMEdge *e = edge_table[edge_i];
+            medge[edge_i].v1 = BM_elem_index_get(e->v1);
+            medge[edge_i].v2 = BM_elem_index_get(e->v2);
+            medge[edge_i].flag = BM_edge_flag_to_mflag(e);
+            bmesh_block_copy_to_mesh_attributes(edge_info, edge_i, e->head.data);
+            bmesh_quick_edgedraw_flag(&medge[edge_i], e);
+            BM_CHECK_ELEMENT(e);
+          }
+        });
+      },
+      [&]() {
+        threading::parallel_for(face_table.index_range(), 1024, [&](const IndexRange range) {
+          for (const int face_i : range) {
+            BMFace *f = face_table[face_i];
+            mpoly[face_i].flag = BM_face_flag_to_mflag(f);
+
+            int loop_i = mpoly[face_i].loopstart;
+            BMLoop *l_iter, *l_first;
+            l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+            do {
+              mloop[loop_i].e = BM_elem_index_get(l_iter->e);
+              mloop[loop_i].v = BM_elem_index_get(l_iter->v);
+              bmesh_block_copy_to_mesh_attributes(loop_info, loop_i, l_iter->head.data);
+              loop_i++;
+              BM_CHECK_ELEMENT(l_iter);
+              BM_CHECK_ELEMENT(l_iter->e);
+              BM_CHECK_ELEMENT(l_iter->v);
+            } while ((l_iter = l_iter->next) != l_first);
+
+            bmesh_block_copy_to_mesh_attributes(poly_info, face_i, f->head.data);
+            BM_CHECK_ELEMENT(f);
+          }
+        });
+      });
 
   if (need_material_index) {
-    BM_mesh_elem_table_ensure(bm, BM_FACE);
     write_fn_to_attribute<int>(me->attributes_for_write(),
                                "material_index",
                                ATTR_DOMAIN_FACE,
-                               [&](const int i) { return int(BM_face_at_index(bm, i)->mat_nr); });
+                               [&](const int i) { return int(face_table[i]->mat_nr); });
   }
 
   /* Patch hook indices and vertex parents. */
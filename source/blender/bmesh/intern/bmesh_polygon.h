@@ -218,6 +218,35 @@ void BM_face_triangulate(BMesh *bm,
                          struct MemArena *pf_arena,
                          struct Heap *pf_heap) ATTR_NONNULL(1, 2);
 
+/**
+ * Calculate the triangles #BM_face_triangulate creates for \a f, without modifying the mesh,
+ * so it can run for many faces in parallel (with an arena and heap per thread).
+ *
+ * \param r_loops: Array of length `f->len`, filled with the face loops indexed by \a r_tris.
+ * \param r_tris: Array of length `f->len - 2`.
+ */
+void BM_face_triangulate_calc(BMFace *f,
+                              BMLoop **r_loops,
+                              uint (*r_tris)[3],
+                              int quad_method,
+                              int ngon_method,
+                              struct MemArena *pf_arena,
+                              struct Heap *pf_heap) ATTR_NONNULL(1, 2, 3);
+/**
+ * Split \a f into the triangles calculated by #BM_face_triangulate_calc,
+ * see #BM_face_triangulate for the other arguments.
+ */
+void BM_face_triangulate_from_tris(BMesh *bm,
+                                   BMFace *f,
+                                   BMLoop **loops,
+                                   const uint (*tris)[3],
+                                   BMFace **r_faces_new,
+                                   int *r_faces_new_tot,
+                                   BMEdge **r_edges_new,
+                                   int *r_edges_new_tot,
+                                   struct LinkNode **r_faces_double,
+                                   bool use_tag) ATTR_NONNULL(1, 2, 3, 4);
+
 /**
  * each pair of loops defines a new edge, a split.  this function goes
  * through and sets pairs that are geometrically invalid to null.  a
@@ -14,6 +14,7 @@
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 /* only for defines */
@@ -25,38 +26,152 @@
 #include "bmesh_triangulate.h" /* own include */
 
 /**
- * a version of #BM_face_triangulate that maps to #BMOpSlot
+ * Triangles of all the faces to triangulate, calculated in parallel before modifying the mesh
+ * (creating faces isn't thread-safe), see #BM_face_triangulate_calc.
+ */
+typedef struct TriangulateData {
+  BMFace **faces;
+  int faces_len;
+  /** Offset of each face in `loops`, the triangles offset is `loop_offsets[i] - (2 * i)`. */
+  int *loop_offsets;
+  BMLoop **loops;
+  uint (*tris)[3];
+
+  int quad_method;
+  int ngon_method;
+} TriangulateData;
+
+typedef struct TriangulateTLS {
+  MemArena *pf_arena;
+  /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
+  Heap *pf_heap;
+} TriangulateTLS;
+
+static void bm_face_triangulate_calc_fn(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict tls)
+{
+  const TriangulateData *data = userdata;
+  TriangulateTLS *tls_data = tls->userdata_chunk;
+  BMFace *f = data->faces[i];
+
+  if (f->len > 4) {
+    if (UNLIKELY(tls_data->pf_arena == NULL)) {
+      tls_data->pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
+      if (data->ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
+        tls_data->pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+      }
+    }
+  }
+
+  BM_face_triangulate_calc(f,
+                           &data->loops[data->loop_offsets[i]],
+                           &data->tris[data->loop_offsets[i] - (2 * i)],
+                           data->quad_method,
+                           data->ngon_method,
+                           tls_data->pf_arena,
+                           tls_data->pf_heap);
+}
+
+static void bm_face_triangulate_calc_free_fn(const void *__restrict UNUSED(userdata),
+                                             void *__restrict tls_v)
+{
+  TriangulateTLS *tls_data = tls_v;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+  }
+  if (tls_data->pf_heap) {
+    BLI_heap_free(tls_data->pf_heap, NULL);
+  }
+}
+
+static void bm_mesh_triangulate_calc(BMesh *bm,
+                                     const int quad_method,
+                                     const int ngon_method,
+                                     const int min_vertices,
+                                     const bool tag_only,
+                                     TriangulateData *data)
+{
+  BMIter iter;
+  BMFace *face;
+  int faces_len = 0;
+  int loops_len = 0;
+
+  BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
+    if (face->len >= min_vertices && face->len > 3) {
+      if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
+        faces_len++;
+        loops_len += face->len;
+      }
+    }
+  }
+
+  data->faces = MEM_mallocN(sizeof(*data->faces) * faces_len, __func__);
+  data->faces_len = faces_len;
+  data->loop_offsets = MEM_mallocN(sizeof(*data->loop_offsets) * faces_len, __func__);
+  data->loops = MEM_mallocN(sizeof(*data->loops) * loops_len, __func__);
+  data->tris = MEM_mallocN(sizeof(*data->tris) * (loops_len - (2 * faces_len)), __func__);
+  data->quad_method = quad_method;
+  data->ngon_method = ngon_method;
+
+  faces_len = 0;
+  loops_len = 0;
+  BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
+    if (face->len >= min_vertices && face->len > 3) {
+      if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
+        data->faces[faces_len] = face;
+        data->loop_offsets[faces_len] = loops_len;
+        faces_len++;
+        loops_len += face->len;
+      }
+    }
+  }
+
+  TriangulateTLS tls_dummy = {NULL};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &tls_dummy;
+  settings.userdata_chunk_size = sizeof(tls_dummy);
+  settings.func_free = bm_face_triangulate_calc_free_fn;
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, faces_len, data, bm_face_triangulate_calc_fn, &settings);
+}
+
+static void bm_mesh_triangulate_data_free(TriangulateData *data)
+{
+  MEM_freeN(data->faces);
+  MEM_freeN(data->loop_offsets);
+  MEM_freeN(data->loops);
+  MEM_freeN(data->tris);
+}
+
+/**
+ * a version of #BM_face_triangulate_from_tris that maps to #BMOpSlot
  */
 static void bm_face_triangulate_mapping(BMesh *bm,
                                         BMFace *face,
-                                        const int quad_method,
-                                        const int ngon_method,
+                                        BMLoop **loops,
+                                        const uint (*tris)[3],
                                         const bool use_tag,
                                         BMOperator *op,
                                         BMOpSlot *slot_facemap_out,
-                                        BMOpSlot *slot_facemap_double_out,
-
-                                        MemArena *pf_arena,
-                                        /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                                        struct Heap *pf_heap)
+                                        BMOpSlot *slot_facemap_double_out)
 {
   int faces_array_tot = face->len - 3;
   BMFace **faces_array = BLI_array_alloca(faces_array, faces_array_tot);
   LinkNode *faces_double = NULL;
   BLI_assert(face->len > 3);
 
-  BM_face_triangulate(bm,
-                      face,
-                      faces_array,
-                      &faces_array_tot,
-                      NULL,
-                      NULL,
-                      &faces_double,
-                      quad_method,
-                      ngon_method,
-                      use_tag,
-                      pf_arena,
-                      pf_heap);
+  BM_face_triangulate_from_tris(bm,
+                                face,
+                                loops,
+                                tris,
+                                faces_array,
+                                &faces_array_tot,
+                                NULL,
+                                NULL,
+                                &faces_double,
+                                use_tag);
 
   if (faces_array_tot) {
     int i;
@@ -83,59 +198,40 @@ void BM_mesh_triangulate(BMesh *bm,
                          BMOpSlot *slot_facemap_out,
                          BMOpSlot *slot_facemap_double_out)
 {
-  BMIter iter;
-  BMFace *face;
-  MemArena *pf_arena;
-  Heap *pf_heap;
+  TriangulateData data;
+  int i;
 
-  pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
-  }
-  else {
-    pf_heap = NULL;
-  }
+  /* Splitting a face only changes its own loops, the loops of other faces and the vertex
+   * positions stay valid, so all the triangles can be calculated in advance. */
+  bm_mesh_triangulate_calc(bm, quad_method, ngon_method, min_vertices, tag_only, &data);
 
   if (slot_facemap_out) {
     /* same as below but call: bm_face_triangulate_mapping() */
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          bm_face_triangulate_mapping(bm,
-                                      face,
-                                      quad_method,
-                                      ngon_method,
-                                      tag_only,
-                                      op,
-                                      slot_facemap_out,
-                                      slot_facemap_double_out,
-                                      pf_arena,
-                                      pf_heap);
-        }
-      }
+    for (i = 0; i < data.faces_len; i++) {
+      bm_face_triangulate_mapping(bm,
+                                  data.faces[i],
+                                  &data.loops[data.loop_offsets[i]],
+                                  (const uint(*)[3])&data.tris[data.loop_offsets[i] - (2 * i)],
+                                  tag_only,
+                                  op,
+                                  slot_facemap_out,
+                                  slot_facemap_double_out);
     }
   }
   else {
     LinkNode *faces_double = NULL;
 
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          BM_face_triangulate(bm,
-                              face,
-                              NULL,
-                              NULL,
-                              NULL,
-                              NULL,
-                              &faces_double,
-                              quad_method,
-                              ngon_method,
-                              tag_only,
-                              pf_arena,
-                              pf_heap);
-        }
-      }
+    for (i = 0; i < data.faces_len; i++) {
+      BM_face_triangulate_from_tris(bm,
+                                    data.faces[i],
+                                    &data.loops[data.loop_offsets[i]],
+                                    (const uint(*)[3])&data.tris[data.loop_offsets[i] - (2 * i)],
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    &faces_double,
+                                    tag_only);
     }
 
     while (faces_double) {
@@ -146,9 +242,5 @@ void BM_mesh_triangulate(BMesh *bm,
     }
   }
 
-  BLI_memarena_free(pf_arena);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    BLI_heap_free(pf_heap, NULL);
-  }
+  bm_mesh_triangulate_data_free(&data);
 }
@@ -13,6 +13,8 @@ struct bNodeInstanceHash;
 
 namespace blender::compositor {
 
+class OperationResultCache;
+
 /**
  * \brief Overall context of the compositor
  */
@@ -69,6 +71,11 @@ class CompositorContext {
    */
   const char *view_name_;
 
+  /**
+   * \brief cache of operation results kept across executions, may be null
+   */
+  OperationResultCache *result_cache_;
+
  public:
   /**
    * \brief constructor initializes the context with default values.
@@ -207,6 +214,22 @@ class CompositorContext {
     view_name_ = view_name;
   }
 
+  /**
+   * \brief set the cache of operation results kept across executions
+   */
+  void set_result_cache(OperationResultCache *result_cache)
+  {
+    result_cache_ = result_cache;
+  }
+
+  /**
+   * \brief get the cache of operation results kept across executions, may be null
+   */
+  OperationResultCache *get_result_cache() const
+  {
+    return result_cache_;
+  }
+
   int get_chunksize() const
   {
     return this->get_bnodetree()->chunksize;
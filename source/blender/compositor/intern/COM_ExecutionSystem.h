@@ -160,7 +160,8 @@ class ExecutionSystem {
                   bNodeTree *editingtree,
                   bool rendering,
                   bool fastcalculation,
-                  const char *view_name);
+                  const char *view_name,
+                  OperationResultCache *result_cache = nullptr);
 
   /**
    * Destructor
@@ -6,6 +6,7 @@
 #include "BLT_translation.h"
 
 #include "COM_Debug.h"
+#include "COM_OperationResultCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -45,6 +46,7 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
   const bool is_rendering = context_.is_rendering();
   const bNodeTree *node_tree = context_.get_bnodetree();
 
+  Vector<NodeOperation *> output_ops;
   rcti area;
   for (eCompositorPriority priority : priorities_) {
     for (NodeOperation *op : operations_) {
@@ -52,10 +54,68 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
       if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
         get_output_render_area(op, area);
         determine_areas_to_render(op, area);
-        determine_reads(op);
+        output_ops.append(op);
       }
     }
   }
+
+  /* Cached results need all areas to render and inputs of cached operations are not read. */
+  if (context_.get_result_cache()) {
+    determine_cached_results();
+  }
+
+  for (NodeOperation *op : output_ops) {
+    determine_reads(op);
+  }
+}
+
+void FullFrameExecutionModel::determine_cached_results()
+{
+  OperationResultCache &result_cache = *context_.get_result_cache();
+
+  Map<NodeOperation *, std::optional<size_t>> result_hashes;
+  for (NodeOperation *op : operations_) {
+    op->generate_result_hash(result_hashes);
+  }
+
+  Vector<NodeOperation *> cacheable_ops;
+  for (NodeOperation *op : operations_) {
+    if (result_hashes.lookup(op)) {
+      continue;
+    }
+    const int num_inputs = op->get_number_of_input_sockets();
+    for (int i = 0; i < num_inputs; i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (result_hashes.lookup(input_op) && !input_op->get_flags().is_constant_operation &&
+          !cacheable_ops.contains(input_op)) {
+        cacheable_ops.append(input_op);
+      }
+    }
+  }
+
+  for (NodeOperation *op : cacheable_ops) {
+    Vector<rcti> areas = active_buffers_.get_areas_to_render(
+        op, -op->get_canvas().xmin, -op->get_canvas().ymin);
+    if (areas.is_empty() || op->get_width() == 0 || op->get_height() == 0) {
+      continue;
+    }
+
+    const size_t result_hash = *result_hashes.lookup(op);
+    MemoryBuffer *cached_buf = result_cache.lookup(result_hash, areas);
+    if (cached_buf) {
+      /* The cache keeps owning the buffer. */
+      active_buffers_.set_rendered_buffer(
+          op,
+          std::make_unique<MemoryBuffer>(cached_buf->get_buffer(),
+                                         cached_buf->get_num_channels(),
+                                         cached_buf->get_rect(),
+                                         cached_buf->is_a_single_elem()));
+      num_operations_finished_++;
+    }
+    else {
+      results_to_cache_.add_new(op, result_hash);
+    }
+  }
 }
 
 Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation *op,
@@ -80,7 +140,8 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
 
 MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op,
                                                                const int output_x,
-                                                               const int output_y)
+                                                               const int output_y,
+                                                               const Span<rcti> areas_to_render)
 {
   rcti rect;
   BLI_rcti_init(
@@ -88,6 +149,19 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
 
   const DataType data_type = op->get_output_socket(0)->get_data_type();
   const bool is_a_single_elem = op->get_flags().is_constant_operation;
+
+  /* Only allocate the part of the canvas that is rendered, reads are limited to it by the areas
+   * of interest of the reading operations. Single element buffers keep the whole canvas as they
+   * are read everywhere. */
+  if (!is_a_single_elem && !areas_to_render.is_empty()) {
+    rcti bounds;
+    BLI_rcti_init_minmax(&bounds);
+    for (const rcti &area : areas_to_render) {
+      BLI_rcti_do_minmax_rcti(&bounds, &area);
+    }
+    BLI_rcti_isect(&rect, &bounds, &rect);
+  }
+
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
@@ -97,13 +171,15 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
+  const int op_offset_x = output_x - op->get_canvas().xmin;
+  const int op_offset_y = output_y - op->get_canvas().ymin;
+  Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
+  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y, areas) :
+                                       nullptr;
   if (op->get_width() > 0 && op->get_height() > 0) {
     Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
-    const int op_offset_x = output_x - op->get_canvas().xmin;
-    const int op_offset_y = output_y - op->get_canvas().ymin;
-    Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
     op->render(op_buf, areas, input_bufs);
     DebugInfo::operation_rendered(op, op_buf);
 
@@ -113,7 +189,22 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   }
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
-  active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
+  std::unique_ptr<MemoryBuffer> buffer(op_buf);
+
+  /* Results of cancelled executions may be incomplete. */
+  const size_t *result_hash = results_to_cache_.lookup_ptr(op);
+  const bNodeTree *node_tree = context_.get_bnodetree();
+  if (result_hash && !node_tree->test_break(node_tree->tbh) &&
+      context_.get_result_cache()->try_add(
+          *result_hash, buffer, op->get_flags().use_half_precision) &&
+      buffer == nullptr) {
+    /* The cache owns the buffer now, reading operations get a buffer using its memory. */
+    buffer = std::make_unique<MemoryBuffer>(op_buf->get_buffer(),
+                                            op_buf->get_num_channels(),
+                                            op_buf->get_rect(),
+                                            op_buf->is_a_single_elem());
+  }
+  active_buffers_.set_rendered_buffer(op, std::move(buffer));
 
   operation_finished(op);
 }
@@ -142,9 +233,10 @@ void FullFrameExecutionModel::render_operations()
 
 /**
  * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * several operations depend on it. Dependencies of already rendered operations are skipped.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation,
+                                                          SharedOperationBuffers &active_buffers)
 {
   /* Get dependencies from outputs to inputs. */
   Vector<NodeOperation *> dependencies;
@@ -154,6 +246,9 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
     Vector<NodeOperation *> outputs(next_outputs);
     next_outputs.clear();
     for (NodeOperation *output : outputs) {
+      if (output != operation && active_buffers.is_operation_rendered(output)) {
+        continue;
+      }
       for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
         next_outputs.append(output->get_input_operation(i));
       }
@@ -170,7 +265,7 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op, active_buffers_);
   for (NodeOperation *op : dependencies) {
     if (!active_buffers_.is_operation_rendered(op)) {
       render_operation(op);
@@ -218,6 +313,10 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
   stack.append(output_op);
   while (stack.size() > 0) {
     NodeOperation *operation = stack.pop_last();
+    /* Operations with a cached result don't read their inputs. */
+    if (active_buffers_.is_operation_rendered(operation)) {
+      continue;
+    }
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -42,6 +43,11 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Result hashes of the operations whose rendered buffer is to be stored in the result cache.
+   */
+  Map<NodeOperation *, size_t> results_to_cache_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -61,7 +67,14 @@ class FullFrameExecutionModel : public ExecutionModel {
    * Returned memory buffers must be deleted.
    */
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
-  MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
+  /**
+   * Returns a buffer for the operation output, only covering the given areas to render, as
+   * determined from the areas of interest of the operations reading it.
+   */
+  MemoryBuffer *create_operation_buffer(NodeOperation *op,
+                                        int output_x,
+                                        int output_y,
+                                        Span<rcti> areas_to_render);
   void render_operation(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
@@ -80,6 +93,12 @@ class FullFrameExecutionModel : public ExecutionModel {
    * operations each operation has).
    */
   void determine_reads(NodeOperation *output_op);
+  /**
+   * Sets the buffers of the operations that have their result in the result cache as rendered
+   * and determines the results to store in it. Only results read by operations that can't be
+   * cached are looked up and stored, as the rest are only needed to render them.
+   */
+  void determine_cached_results();
 
   void update_progress_bar();
 
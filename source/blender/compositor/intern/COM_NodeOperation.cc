@@ -84,6 +84,51 @@ std::optional<NodeOperationHash> NodeOperation::generate_hash()
   return hash;
 }
 
+std::optional<size_t> NodeOperation::generate_result_hash(
+    Map<NodeOperation *, std::optional<size_t>> &r_hashes)
+{
+  if (const std::optional<size_t> *hash = r_hashes.lookup_ptr(this)) {
+    return *hash;
+  }
+
+  std::optional<size_t> result_hash = std::nullopt;
+  const std::optional<NodeOperationHash> op_hash = generate_hash();
+  if (op_hash) {
+    size_t hash = get_default_hash_2(op_hash->type_hash_, op_hash->params_hash_);
+    bool is_inputs_hashed = true;
+    for (NodeOperationInput &socket : inputs_) {
+      if (!socket.is_connected()) {
+        continue;
+      }
+
+      /* Unlike #generate_hash, use the result hash of the inputs instead of their id, which is
+       * only valid in the current execution. */
+      NodeOperation &input = socket.get_link()->get_operation();
+      if (input.get_flags().is_constant_operation) {
+        const float *elem = ((ConstantOperation *)&input)->get_constant_elem();
+        const int num_channels = COM_data_type_num_channels(socket.get_data_type());
+        for (const int i : IndexRange(num_channels)) {
+          combine_hashes(hash, get_default_hash(elem[i]));
+        }
+        continue;
+      }
+
+      const std::optional<size_t> input_hash = input.generate_result_hash(r_hashes);
+      if (!input_hash) {
+        is_inputs_hashed = false;
+        break;
+      }
+      combine_hashes(hash, *input_hash);
+    }
+    if (is_inputs_hashed) {
+      result_hash = hash;
+    }
+  }
+
+  r_hashes.add(this, result_hash);
+  return result_hash;
+}
+
 NodeOperationOutput *NodeOperation::get_output_socket(uint index)
 {
   return &outputs_[index];
@@ -490,6 +535,9 @@ std::ostream &operator<<(std::ostream &os, const NodeOperationFlags &node_operat
   if (node_operation_flags.can_be_constant) {
     os << "can_be_constant,";
   }
+  if (node_operation_flags.use_half_precision) {
+    os << "use_half_precision,";
+  }
 
   return os;
 }
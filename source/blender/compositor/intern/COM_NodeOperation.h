@@ -8,6 +8,7 @@
 
 #include "BLI_ghash.h"
 #include "BLI_hash.hh"
+#include "BLI_map.hh"
 #include "BLI_rect.h"
 #include "BLI_span.hh"
 #include "BLI_threads.h"
@@ -237,6 +238,12 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether operation output can be stored with half float precision without visible loss, for
+   * example when read from 8 bit images. Used to halve the memory of cached results.
+   */
+  bool use_half_precision : 1;
+
   NodeOperationFlags()
   {
     complex = false;
@@ -255,6 +262,7 @@ struct NodeOperationFlags {
     is_fullframe_operation = false;
     is_constant_operation = false;
     can_be_constant = false;
+    use_half_precision = false;
   }
 };
 
@@ -390,6 +398,16 @@ class NodeOperation {
    */
   std::optional<NodeOperationHash> generate_hash();
 
+  /**
+   * Generate a hash that identifies the operation result across executions, combining the
+   * operation parameters with the result hashes of the operations it reads. Requires
+   * `hash_output_params` to be implemented by all the operations it depends on, otherwise
+   * `std::nullopt` is returned. Hashes of the visited operations are stored in \a r_hashes to
+   * avoid computing them again.
+   */
+  std::optional<size_t> generate_result_hash(
+      Map<NodeOperation *, std::optional<size_t>> &r_hashes);
+
   unsigned int get_number_of_input_sockets() const
   {
     return inputs_.size();
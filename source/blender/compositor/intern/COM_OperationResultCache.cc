@@ -0,0 +1,239 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include <cmath>
+#include <cstring>
+
+#include "COM_OperationResultCache.h"
+
+#include "BLI_task.hh"
+
+#include "BKE_image.h"
+#include "BKE_image_partial_update.hh"
+
+#include "DNA_image_types.h"
+
+namespace blender::compositor {
+
+static size_t get_buffer_num_elements(const MemoryBuffer &buffer)
+{
+  return size_t(buffer.get_memory_width()) * buffer.get_memory_height() *
+         buffer.get_num_channels();
+}
+
+/* Round to nearest even, values out of half range become infinite. */
+static uint16_t float_to_half(const float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  const uint32_t abs_bits = bits & 0x7fffffff;
+
+  if (abs_bits >= 0x7f800000) {
+    /* Infinity or NaN. */
+    return sign | 0x7c00 | (abs_bits > 0x7f800000 ? 0x200 : 0);
+  }
+  if (abs_bits >= 0x477ff000) {
+    /* Rounds to 65520 or more. */
+    return sign | 0x7c00;
+  }
+  if (abs_bits < 0x38800000) {
+    /* Half denormals, 2^-25 or lower rounds to zero. */
+    if (abs_bits <= 0x33000000) {
+      return sign;
+    }
+    const uint32_t exponent = abs_bits >> 23;
+    const uint32_t mantissa = (abs_bits & 0x7fffff) | 0x800000;
+    const uint32_t shift = 126 - exponent;
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) {
+      half++;
+    }
+    return sign | uint16_t(half);
+  }
+
+  /* Re-bias exponent from 127 to 15. */
+  uint32_t half = (abs_bits - 0x38000000) >> 13;
+  const uint32_t remainder = abs_bits & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+    half++;
+  }
+  return sign | uint16_t(half);
+}
+
+static float half_to_float(const uint16_t half)
+{
+  const uint32_t sign = uint32_t(half & 0x8000) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1f;
+  const uint32_t mantissa = half & 0x3ff;
+
+  uint32_t bits;
+  if (exponent == 0) {
+    /* Zero or denormal. */
+    const float value = ldexpf(float(mantissa), -24);
+    return sign ? -value : value;
+  }
+  if (exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  }
+  else {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+OperationResultCache::~OperationResultCache()
+{
+  clear();
+  for (ImageUpdates &updates : image_updates_.values()) {
+    BKE_image_partial_update_free(updates.partial_update_user);
+  }
+}
+
+void OperationResultCache::begin_execution(const size_t memory_budget)
+{
+  execution_++;
+  memory_budget_ = memory_budget;
+  free_memory_for(0);
+
+  for (CachedBuffer &cached : buffers_.values()) {
+    if (!cached.half_buffer.is_empty()) {
+      cached.buffer.reset();
+    }
+  }
+}
+
+MemoryBuffer *OperationResultCache::lookup(const size_t result_hash, Span<rcti> areas)
+{
+  CachedBuffer *cached = buffers_.lookup_ptr(result_hash);
+  if (cached == nullptr) {
+    return nullptr;
+  }
+
+  for (const rcti &area : areas) {
+    if (!BLI_rcti_inside_rcti(&cached->rect, &area)) {
+      return nullptr;
+    }
+  }
+
+  if (cached->buffer == nullptr) {
+    /* Convert back the half precision pixels, kept until the next execution. */
+    cached->buffer = std::make_unique<MemoryBuffer>(
+        cached->num_channels == 1 ?
+            DataType::Value :
+            (cached->num_channels == 3 ? DataType::Vector : DataType::Color),
+        cached->rect);
+    float *dst = cached->buffer->get_buffer();
+    const Span<uint16_t> src = cached->half_buffer;
+    threading::parallel_for(src.index_range(), 1 << 16, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        dst[i] = half_to_float(src[i]);
+      }
+    });
+  }
+
+  cached->last_used_execution = execution_;
+  return cached->buffer.get();
+}
+
+bool OperationResultCache::try_add(const size_t result_hash,
+                                   std::unique_ptr<MemoryBuffer> &buffer,
+                                   const bool use_half_precision)
+{
+  /* Replace any buffer with the same result that didn't contain the rendered areas. */
+  if (CachedBuffer *cached = buffers_.lookup_ptr(result_hash)) {
+    if (cached->last_used_execution == execution_) {
+      /* Still read in the current execution. */
+      return false;
+    }
+    memory_usage_ -= cached->memory_size;
+    buffers_.remove(result_hash);
+  }
+
+  /* Half precision needs a full buffer, single elements aren't worth it. */
+  const bool store_half = use_half_precision && !buffer->is_a_single_elem();
+  const size_t num_elements = get_buffer_num_elements(*buffer);
+  const size_t memory_size = num_elements * (store_half ? sizeof(uint16_t) : sizeof(float));
+  if (memory_size > memory_budget_ || !free_memory_for(memory_size)) {
+    return false;
+  }
+
+  CachedBuffer cached;
+  cached.rect = buffer->get_rect();
+  cached.num_channels = buffer->get_num_channels();
+  if (store_half) {
+    cached.half_buffer.reinitialize(num_elements);
+    const float *src = buffer->get_buffer();
+    MutableSpan<uint16_t> dst = cached.half_buffer;
+    threading::parallel_for(dst.index_range(), 1 << 16, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        dst[i] = float_to_half(src[i]);
+      }
+    });
+  }
+  else {
+    cached.buffer = std::move(buffer);
+  }
+  cached.memory_size = memory_size;
+  cached.last_used_execution = execution_;
+  buffers_.add_new(result_hash, std::move(cached));
+  memory_usage_ += memory_size;
+  return true;
+}
+
+int OperationResultCache::get_image_update_count(Image *image)
+{
+  using namespace blender::bke::image::partial_update;
+
+  ImageUpdates *updates = image_updates_.lookup_ptr(image->id.session_uuid);
+  if (updates == nullptr) {
+    ImageUpdates new_updates;
+    new_updates.partial_update_user = BKE_image_partial_update_create(image);
+    new_updates.update_count = 0;
+    /* First collection always requests a full update. */
+    BKE_image_partial_update_collect_changes(image, new_updates.partial_update_user);
+    image_updates_.add_new(image->id.session_uuid, new_updates);
+    return new_updates.update_count;
+  }
+
+  if (BKE_image_partial_update_collect_changes(image, updates->partial_update_user) !=
+      ePartialUpdateCollectResult::NoChangesDetected) {
+    updates->update_count++;
+  }
+  return updates->update_count;
+}
+
+void OperationResultCache::clear()
+{
+  buffers_.clear();
+  memory_usage_ = 0;
+}
+
+bool OperationResultCache::free_memory_for(const size_t memory_size)
+{
+  while (memory_usage_ + memory_size > memory_budget_) {
+    const size_t *lru_hash = nullptr;
+    int lru_execution = execution_;
+    for (const auto item : buffers_.items()) {
+      if (item.value.last_used_execution < lru_execution) {
+        lru_hash = &item.key;
+        lru_execution = item.value.last_used_execution;
+      }
+    }
+    if (lru_hash == nullptr) {
+      /* Only buffers used in the current execution are left. */
+      return false;
+    }
+
+    const size_t hash = *lru_hash;
+    memory_usage_ -= buffers_.lookup(hash).memory_size;
+    buffers_.remove(hash);
+  }
+  return true;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+
+#include "COM_MemoryBuffer.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+struct Image;
+struct PartialUpdateUser;
+
+namespace blender::compositor {
+
+/**
+ * Keeps operations rendered buffers across executions, identified by their result hash (see
+ * #NodeOperation::generate_result_hash), so that the parts of a node tree that didn't change
+ * since the previous executions or frames are not rendered again. Least recently used buffers
+ * are freed when over the memory budget.
+ */
+class OperationResultCache {
+ private:
+  typedef struct CachedBuffer {
+    /* When stored with half precision, only exists in the executions it's used. */
+    std::unique_ptr<MemoryBuffer> buffer;
+    /* Half float pixels of buffers stored with half precision, empty otherwise. */
+    Array<uint16_t> half_buffer;
+    rcti rect;
+    int num_channels;
+    size_t memory_size;
+    int last_used_execution;
+  } CachedBuffer;
+
+  typedef struct ImageUpdates {
+    PartialUpdateUser *partial_update_user;
+    int update_count;
+  } ImageUpdates;
+
+  blender::Map<size_t, CachedBuffer> buffers_;
+  /* Changes tracking of the images read by the cached results, by image session UUID. */
+  blender::Map<uint32_t, ImageUpdates> image_updates_;
+  size_t memory_usage_ = 0;
+  size_t memory_budget_ = 0;
+  int execution_ = 0;
+
+ public:
+  ~OperationResultCache();
+
+  /**
+   * Starts a new execution using the given memory budget in bytes. Buffers used in the current
+   * execution are never freed, even when over budget. Full precision buffers converted from half
+   * precision in the previous execution are freed.
+   */
+  void begin_execution(size_t memory_budget);
+
+  /**
+   * Get the cached buffer with the given result hash if it contains all the given areas,
+   * otherwise returns null. Returned buffer is owned by the cache.
+   */
+  MemoryBuffer *lookup(size_t result_hash, Span<rcti> areas);
+
+  /**
+   * Stores given rendered buffer with its result hash if it fits in the memory budget, freeing
+   * least recently used buffers when needed. Returns whether it was stored. When stored with full
+   * precision the buffer ownership is moved to the cache, with half precision a converted copy is
+   * stored instead.
+   */
+  bool try_add(size_t result_hash,
+               std::unique_ptr<MemoryBuffer> &buffer,
+               bool use_half_precision = false);
+
+  /**
+   * Get a number identifying the current content of the given image buffers across executions.
+   * It changes every time the image buffers are modified, reloaded or freed, so it can be used
+   * in result hashes of operations reading images.
+   */
+  int get_image_update_count(Image *image);
+
+  /**
+   * Free all cached buffers.
+   */
+  void clear();
+
+ private:
+  /**
+   * Free least recently used buffers, not used in the current execution, until the given amount
+   * of memory fits in the budget. Returns whether it fits.
+   */
+  bool free_memory_for(size_t memory_size);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:OperationResultCache")
+#endif
+};
+
+}  // namespace blender::compositor
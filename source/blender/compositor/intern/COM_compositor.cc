@@ -5,16 +5,21 @@
 
 #include "BLT_translation.h"
 
+#include "DNA_userdef_types.h"
+
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
 #include "COM_ExecutionSystem.h"
+#include "COM_OperationResultCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
+  /* Operation results kept across executions, only used by the full frame execution model. */
+  blender::compositor::OperationResultCache *result_cache = nullptr;
 } g_compositor;
 
 /* Make sure node tree has previews.
@@ -75,11 +80,17 @@ void COM_execute(RenderData *render_data,
   const bool use_opencl = (node_tree->flag & NTREE_COM_OPENCL) != 0;
   blender::compositor::WorkScheduler::initialize(use_opencl, BKE_render_num_threads(render_data));
 
+  if (g_compositor.result_cache == nullptr) {
+    g_compositor.result_cache = new blender::compositor::OperationResultCache();
+  }
+  /* Use the memory cache limit of the preferences as budget, in megabytes. */
+  g_compositor.result_cache->begin_execution(size_t(U.memcachelimit) * 1024 * 1024);
+
   /* Execute. */
   const bool twopass = (node_tree->flag & NTREE_TWO_PASS) && !rendering;
   if (twopass) {
     blender::compositor::ExecutionSystem fast_pass(
-        render_data, scene, node_tree, rendering, true, view_name);
+        render_data, scene, node_tree, rendering, true, view_name, g_compositor.result_cache);
     fast_pass.execute();
 
     if (node_tree->test_break(node_tree->tbh)) {
@@ -89,7 +100,7 @@ void COM_execute(RenderData *render_data,
   }
 
   blender::compositor::ExecutionSystem system(
-      render_data, scene, node_tree, rendering, false, view_name);
+      render_data, scene, node_tree, rendering, false, view_name, g_compositor.result_cache);
   system.execute();
 
   BLI_mutex_unlock(&g_compositor.mutex);
@@ -100,6 +111,8 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    delete g_compositor.result_cache;
+    g_compositor.result_cache = nullptr;
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
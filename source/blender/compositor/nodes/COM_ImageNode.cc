@@ -4,6 +4,7 @@
 #include "COM_ImageNode.h"
 #include "COM_ConvertOperation.h"
 #include "COM_MultilayerImageOperation.h"
+#include "COM_OperationResultCache.h"
 
 #include "COM_SetColorOperation.h"
 #include "COM_SetValueOperation.h"
@@ -187,12 +188,19 @@ void ImageNode::convert_to_operations(NodeConverter &converter,
     }
   }
   else {
+    /* Allows caching the results of the operations reading the image across executions. */
+    OperationResultCache *result_cache = context.get_result_cache();
+    const int image_update_count = (image && result_cache) ?
+                                       result_cache->get_image_update_count(image) :
+                                       -1;
+
     const int64_t number_of_outputs = get_output_sockets().size();
     if (number_of_outputs > 0) {
       ImageOperation *operation = new ImageOperation();
       operation->set_image(image);
       operation->set_image_user(imageuser);
       operation->set_framenumber(framenumber);
+      operation->set_image_update_count(image_update_count);
       operation->set_render_data(context.get_render_data());
       operation->set_view_name(context.get_view_name());
       converter.add_operation(operation);
@@ -218,6 +226,7 @@ void ImageNode::convert_to_operations(NodeConverter &converter,
       alpha_operation->set_image(image);
       alpha_operation->set_image_user(imageuser);
       alpha_operation->set_framenumber(framenumber);
+      alpha_operation->set_image_update_count(image_update_count);
       alpha_operation->set_render_data(context.get_render_data());
       alpha_operation->set_view_name(context.get_view_name());
       converter.add_operation(alpha_operation);
@@ -230,6 +239,7 @@ void ImageNode::convert_to_operations(NodeConverter &converter,
       depth_operation->set_image(image);
       depth_operation->set_image_user(imageuser);
       depth_operation->set_framenumber(framenumber);
+      depth_operation->set_image_update_count(image_update_count);
       depth_operation->set_render_data(context.get_render_data());
       depth_operation->set_view_name(context.get_view_name());
       converter.add_operation(depth_operation);
@@ -59,6 +59,15 @@ void BlurBaseOperation::init_execution()
   QualityStepHelper::init_execution(COM_QH_MULTIPLY);
 }
 
+void BlurBaseOperation::hash_output_params()
+{
+  hash_params(data_.sizex, data_.sizey, data_.filtertype);
+  hash_params(data_.relative, data_.aspect, data_.fac);
+  hash_params(data_.percentx, data_.percenty, int(data_.gamma));
+  hash_params(size_, sizeavailable_, use_variable_size_);
+  hash_params(extend_bounds_, get_quality());
+}
+
 float *BlurBaseOperation::make_gausstab(float rad, int size)
 {
   float *gausstab, sum, val;
@@ -33,6 +33,7 @@ class BlurBaseOperation : public MultiThreadedOperation, public QualityStepHelpe
   float *make_dist_fac_inverse(float rad, int size, int falloff);
 
   void update_size();
+  void hash_output_params() override;
 
   /**
    * Cached reference to the input_program
@@ -0,0 +1,21 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2011 Blender Foundation. */
+
+#pragma once
+
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+/**
+ * Convolves the first \a num_channels channels of a color image with a color kernel centered on
+ * each pixel, using the 2D Fast Hartley Transform with block overlap-add. Much faster than direct
+ * convolution for large kernels. Pixels outside the image are zero. The result is added to
+ * \a r_dst, a color buffer of the image size.
+ */
+void convolve_fast_hartley(MemoryBuffer &r_dst,
+                           MemoryBuffer &image,
+                           MemoryBuffer &kernel,
+                           int num_channels);
+
+}  // namespace blender::compositor
@@ -12,6 +12,10 @@ GammaCorrectOperation::GammaCorrectOperation()
   input_program_ = nullptr;
   flags_.can_be_constant = true;
 }
+void GammaCorrectOperation::hash_output_params()
+{
+}
+
 void GammaCorrectOperation::init_execution()
 {
   input_program_ = this->get_input_socket_reader(0);
@@ -83,6 +87,10 @@ GammaUncorrectOperation::GammaUncorrectOperation()
   input_program_ = nullptr;
   flags_.can_be_constant = true;
 }
+void GammaUncorrectOperation::hash_output_params()
+{
+}
+
 void GammaUncorrectOperation::init_execution()
 {
   input_program_ = this->get_input_socket_reader(0);
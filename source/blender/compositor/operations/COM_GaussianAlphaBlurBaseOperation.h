@@ -45,6 +45,9 @@ class GaussianAlphaBlurBaseOperation : public BlurBaseOperation {
   {
     return (LIKELY(test == false)) ? f : 1.0f - f;
   }
+
+ protected:
+  void hash_output_params() override;
 };
 
 }  // namespace blender::compositor
@@ -2,14 +2,20 @@
  * Copyright 2011 Blender Foundation. */
 
 #include "COM_GaussianBokehBlurOperation.h"
+#include "COM_FastHartleyConvolution.h"
 
 #include "RE_pipeline.h"
 
 namespace blender::compositor {
 
+/* Kernels of this area or bigger are convolved with the FFT in full frame execution. */
+static constexpr int FFT_MIN_KERNEL_AREA = 65 * 65;
+
 GaussianBokehBlurOperation::GaussianBokehBlurOperation() : BlurBaseOperation(DataType::Color)
 {
   gausstab_ = nullptr;
+  convolved_ = nullptr;
+  use_fft_ = false;
 }
 
 void *GaussianBokehBlurOperation::initialize_tile_data(rcti * /*rect*/)
@@ -96,6 +102,37 @@ void GaussianBokehBlurOperation::update_gauss()
   }
 }
 
+void GaussianBokehBlurOperation::update_gauss_sums()
+{
+  if (!gauss_sums_.is_empty()) {
+    return;
+  }
+
+  const int ddwidth = 2 * radx_ + 1;
+  const int ddheight = 2 * rady_ + 1;
+  const int sums_width = ddwidth + 1;
+  gauss_sums_.reinitialize(sums_width * (ddheight + 1));
+  gauss_sums_.as_mutable_span().take_front(sums_width).fill(0.0);
+  for (int j = 0; j < ddheight; j++) {
+    double row_sum = 0.0;
+    gauss_sums_[(j + 1) * sums_width] = 0.0;
+    for (int i = 0; i < ddwidth; i++) {
+      row_sum += gausstab_[j * ddwidth + i];
+      gauss_sums_[(j + 1) * sums_width + i + 1] = gauss_sums_[j * sums_width + i + 1] + row_sum;
+    }
+  }
+}
+
+float GaussianBokehBlurOperation::get_gauss_sum(const int xmin,
+                                                const int ymin,
+                                                const int xmax,
+                                                const int ymax)
+{
+  const int sums_width = 2 * radx_ + 2;
+  return float(gauss_sums_[ymax * sums_width + xmax] - gauss_sums_[ymin * sums_width + xmax] -
+               gauss_sums_[ymax * sums_width + xmin] + gauss_sums_[ymin * sums_width + xmin]);
+}
+
 void GaussianBokehBlurOperation::execute_pixel(float output[4], int x, int y, void *data)
 {
   float result[4];
@@ -160,6 +197,7 @@ void GaussianBokehBlurOperation::deinit_execution()
     MEM_freeN(gausstab_);
     gausstab_ = nullptr;
   }
+  gauss_sums_.reinitialize(0);
 
   deinit_mutex();
 }
@@ -212,6 +250,40 @@ void GaussianBokehBlurOperation::get_area_of_interest(const int input_idx,
   r_input_area.ymin = output_area.ymin - rady_;
 }
 
+void GaussianBokehBlurOperation::update_memory_buffer_started(MemoryBuffer *UNUSED(output),
+                                                              const rcti &area,
+                                                              Span<MemoryBuffer *> inputs)
+{
+  MemoryBuffer *input = inputs[IMAGE_INPUT_INDEX];
+  use_fft_ = !input->is_a_single_elem() &&
+             (2 * radx_ + 1) * (2 * rady_ + 1) >= FFT_MIN_KERNEL_AREA;
+  if (!use_fft_) {
+    return;
+  }
+
+  /* Only the input pixels affecting the rendered area are convolved. */
+  rcti input_area;
+  get_area_of_interest(IMAGE_INPUT_INDEX, area, input_area);
+  if (!BLI_rcti_isect(&input_area, &input->get_rect(), &input_area)) {
+    use_fft_ = false;
+    return;
+  }
+  MemoryBuffer image(DataType::Color, input_area);
+  image.copy_from(input, input_area);
+
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, 2 * radx_ + 1, 0, 2 * rady_ + 1);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  for (BuffersIterator<float> it = kernel.iterate_with({}); !it.is_end(); ++it) {
+    copy_v4_fl(it.out, gausstab_[it.y * kernel.get_width() + it.x]);
+  }
+
+  convolved_ = new MemoryBuffer(DataType::Color, input_area);
+  convolved_->clear();
+  convolve_fast_hartley(*convolved_, image, kernel, COM_DATA_TYPE_COLOR_CHANNELS);
+  update_gauss_sums();
+}
+
 void GaussianBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                               const rcti &area,
                                                               Span<MemoryBuffer *> inputs)
@@ -228,6 +300,18 @@ void GaussianBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *outp
     const int xmin = max_ii(x - radx_, input_rect.xmin);
     const int xmax = min_ii(x + radx_ + 1, input_rect.xmax);
 
+    if (use_fft_) {
+      const rcti &convolved_rect = convolved_->get_rect();
+      if (x >= convolved_rect.xmin && x < convolved_rect.xmax && y >= convolved_rect.ymin &&
+          y < convolved_rect.ymax) {
+        /* Normalize by the weights of the kernel part inside the input. */
+        const float multiplier_accum = get_gauss_sum(
+            xmin - x + radx_, ymin - y + rady_, xmax - x + radx_, ymax - y + rady_);
+        mul_v4_v4fl(it.out, convolved_->get_elem(x, y), 1.0f / multiplier_accum);
+        continue;
+      }
+    }
+
     float temp_color[4] = {0};
     float multiplier_accum = 0;
     const int step = QualityStepHelper::get_step();
@@ -249,6 +333,16 @@ void GaussianBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *outp
   }
 }
 
+void GaussianBokehBlurOperation::update_memory_buffer_finished(MemoryBuffer *UNUSED(output),
+                                                               const rcti &UNUSED(area),
+                                                               Span<MemoryBuffer *> UNUSED(inputs))
+{
+  if (convolved_) {
+    delete convolved_;
+    convolved_ = nullptr;
+  }
+}
+
 // reference image
 GaussianBlurReferenceOperation::GaussianBlurReferenceOperation()
     : BlurBaseOperation(DataType::Color)
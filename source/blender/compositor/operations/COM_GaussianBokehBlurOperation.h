@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "BLI_array.hh"
+
 #include "COM_BlurBaseOperation.h"
 #include "COM_NodeOperation.h"
 #include "COM_QualityStepHelper.h"
@@ -15,7 +17,14 @@ class GaussianBokehBlurOperation : public BlurBaseOperation {
   int radx_, rady_;
   float radxf_;
   float radyf_;
+  /* Input convolved with the whole kernel when blurring with the FFT, see #use_fft_. */
+  MemoryBuffer *convolved_;
+  /* Summed-area table of the kernel weights, to normalize the convolved input near its edges. */
+  Array<double> gauss_sums_;
+  bool use_fft_;
   void update_gauss();
+  void update_gauss_sums();
+  float get_gauss_sum(int xmin, int ymin, int xmax, int ymax);
 
  public:
   GaussianBokehBlurOperation();
@@ -37,9 +46,19 @@ class GaussianBokehBlurOperation : public BlurBaseOperation {
                                             rcti *output) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  /**
+   * Big kernels are convolved with the whole input at once using the FFT, much faster than
+   * gathering each output pixel from its neighborhood.
+   */
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
+  void update_memory_buffer_finished(MemoryBuffer *output,
+                                     const rcti &area,
+                                     Span<MemoryBuffer *> inputs) override;
 };
 
 class GaussianBlurReferenceOperation : public BlurBaseOperation {
@@ -26,6 +26,7 @@ BaseImageOperation::BaseImageOperation()
   number_of_channels_ = 0;
   rd_ = nullptr;
   view_name_ = nullptr;
+  image_update_count_ = -1;
 }
 ImageOperation::ImageOperation() : BaseImageOperation()
 {
@@ -62,6 +63,21 @@ ImBuf *BaseImageOperation::get_im_buf()
   return ibuf;
 }
 
+void BaseImageOperation::hash_output_params()
+{
+  /* Without an update count buffers content may change between executions. */
+  if (image_ == nullptr || image_user_ == nullptr || image_update_count_ < 0) {
+    NodeOperation::hash_output_params();
+    return;
+  }
+
+  hash_params(image_->id.session_uuid, image_update_count_);
+  hash_params(image_user_->framenr, image_user_->layer, image_user_->pass);
+  hash_params(image_user_->view,
+              image_user_->multi_index,
+              BKE_scene_multiview_view_id_get(rd_, view_name_));
+}
+
 void BaseImageOperation::init_execution()
 {
   ImBuf *stackbuf = get_im_buf();
@@ -76,6 +92,9 @@ void BaseImageOperation::init_execution()
     imagewidth_ = stackbuf->x;
     imageheight_ = stackbuf->y;
     number_of_channels_ = stackbuf->channels;
+    /* Pixels converted from 8 bit don't need more precision. */
+    flags_.use_half_precision = stackbuf->rect_float == nullptr &&
+                                stackbuf->zbuf_float == nullptr;
   }
 }
 
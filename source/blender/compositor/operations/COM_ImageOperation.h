@@ -34,6 +34,9 @@ class BaseImageOperation : public MultiThreadedOperation {
   int number_of_channels_;
   const RenderData *rd_;
   const char *view_name_;
+  /* Identifies the image buffers content across executions, negative when unknown. See
+   * #OperationResultCache::get_image_update_count. */
+  int image_update_count_;
 
   BaseImageOperation();
   /**
@@ -43,6 +46,8 @@ class BaseImageOperation : public MultiThreadedOperation {
 
   virtual ImBuf *get_im_buf();
 
+  void hash_output_params() override;
+
  public:
   void init_execution() override;
   void deinit_execution() override;
@@ -66,6 +71,10 @@ class BaseImageOperation : public MultiThreadedOperation {
   {
     framenumber_ = framenumber;
   }
+  void set_image_update_count(int image_update_count)
+  {
+    image_update_count_ = image_update_count;
+  }
 };
 class ImageOperation : public BaseImageOperation {
  public:
@@ -20,6 +20,11 @@ MathBaseOperation::MathBaseOperation()
   flags_.can_be_constant = true;
 }
 
+void MathBaseOperation::hash_output_params()
+{
+  hash_param(use_clamp_);
+}
+
 void MathBaseOperation::init_execution()
 {
   input_value1_operation_ = this->get_input_socket_reader(0);
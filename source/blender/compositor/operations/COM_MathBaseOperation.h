@@ -31,6 +31,8 @@ class MathBaseOperation : public MultiThreadedOperation {
   /* TODO(manzanilla): to be removed with tiled implementation. */
   void clamp_if_needed(float color[4]);
 
+  void hash_output_params() override;
+
   float clamp_when_enabled(float value)
   {
     if (use_clamp_) {
@@ -150,6 +150,15 @@ void MixAddOperation::execute_pixel_sampled(float output[4],
 
 void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  while (p.out < p.row_end) {
+    const __m128 value = load_value_sse(p);
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    store_rgb_sse(p, _mm_add_ps(color1, _mm_mul_ps(value, color2)), color1);
+    p.next();
+  }
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -163,6 +172,7 @@ void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Blend Operation ******** */
@@ -196,6 +206,18 @@ void MixBlendOperation::execute_pixel_sampled(float output[4],
 
 void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  const __m128 one = _mm_set1_ps(1.0f);
+  while (p.out < p.row_end) {
+    const __m128 value = load_value_sse(p);
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 value_m = _mm_sub_ps(one, value);
+    const __m128 rgb = _mm_add_ps(_mm_mul_ps(value_m, color1), _mm_mul_ps(value, color2));
+    store_rgb_sse(p, rgb, color1);
+    p.next();
+  }
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -210,6 +232,7 @@ void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Burn Operation ******** */
@@ -1023,6 +1046,18 @@ void MixMultiplyOperation::execute_pixel_sampled(float output[4],
 
 void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  const __m128 one = _mm_set1_ps(1.0f);
+  while (p.out < p.row_end) {
+    const __m128 value = load_value_sse(p);
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 value_m = _mm_sub_ps(one, value);
+    const __m128 rgb = _mm_mul_ps(color1, _mm_add_ps(value_m, _mm_mul_ps(value, color2)));
+    store_rgb_sse(p, rgb, color1);
+    p.next();
+  }
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1038,6 +1073,7 @@ void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Overlay Operation ******** */
@@ -1217,6 +1253,19 @@ void MixScreenOperation::execute_pixel_sampled(float output[4],
 
 void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  const __m128 one = _mm_set1_ps(1.0f);
+  while (p.out < p.row_end) {
+    const __m128 value = load_value_sse(p);
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 value_m = _mm_sub_ps(one, value);
+    const __m128 screen = _mm_add_ps(value_m, _mm_mul_ps(value, _mm_sub_ps(one, color2)));
+    const __m128 rgb = _mm_sub_ps(one, _mm_mul_ps(screen, _mm_sub_ps(one, color1)));
+    store_rgb_sse(p, rgb, color1);
+    p.next();
+  }
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1232,6 +1281,7 @@ void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Soft Light Operation ******** */
@@ -1332,6 +1382,15 @@ void MixSubtractOperation::execute_pixel_sampled(float output[4],
 
 void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  while (p.out < p.row_end) {
+    const __m128 value = load_value_sse(p);
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    store_rgb_sse(p, _mm_sub_ps(color1, _mm_mul_ps(value, color2)), color1);
+    p.next();
+  }
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1345,6 +1404,7 @@ void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Value Operation ******** */
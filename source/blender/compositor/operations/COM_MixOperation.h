@@ -5,6 +5,8 @@
 
 #include "COM_MultiThreadedOperation.h"
 
+#include "BLI_simd.h"
+
 namespace blender::compositor {
 
 /**
@@ -51,6 +53,36 @@ class MixBaseOperation : public MultiThreadedOperation {
     }
   }
 
+#ifdef BLI_HAVE_SSE2
+  /* Row kernels process a RGBA pixel per vector, colors inputs are always 4 channels. */
+
+  /**
+   * Get the mix factor of the cursor pixel in all the vector lanes.
+   */
+  inline __m128 load_value_sse(const PixelCursor &p)
+  {
+    float value = p.value[0];
+    if (value_alpha_multiply_) {
+      value *= p.color2[3];
+    }
+    return _mm_set1_ps(value);
+  }
+
+  /**
+   * Writes the RGB channels of given color to the cursor output with the alpha of the first
+   * color, clamped when needed.
+   */
+  inline void store_rgb_sse(PixelCursor &p, const __m128 rgb, const __m128 color1)
+  {
+    const __m128 rgb_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 color = _mm_or_ps(_mm_and_ps(rgb_mask, rgb), _mm_andnot_ps(rgb_mask, color1));
+    if (use_clamp_) {
+      color = _mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    }
+    _mm_storeu_ps(p.out, color);
+  }
+#endif
+
  public:
   /**
    * Default constructor
@@ -25,6 +25,13 @@ TranslateOperation::TranslateOperation(DataType data_type, ResizeMode resize_mod
   this->y_extend_mode_ = MemoryBufferExtend::Clip;
 }
 
+void TranslateOperation::hash_output_params()
+{
+  /* Deltas are read from the inputs. */
+  hash_params(factor_x_, factor_y_);
+  hash_params(x_extend_mode_, y_extend_mode_);
+}
+
 void TranslateOperation::init_execution()
 {
   input_operation_ = this->get_input_socket_reader(0);
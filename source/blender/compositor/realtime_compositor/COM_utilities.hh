@@ -48,8 +48,8 @@ int number_of_inputs_linked_to_output_conditioned(DOutputSocket output,
 bool is_shader_node(DNode node);
 
 /**
- * Returns true if the given node is supported, that is, have an implementation.
- * Returns false otherwise.
+ * Returns true if the given node is supported, that is, have an implementation that is not just a
+ * placeholder, see #bNodeType.realtime_compositor_unsupported_message. Returns false otherwise.
  */
 bool is_node_supported(DNode node);
 
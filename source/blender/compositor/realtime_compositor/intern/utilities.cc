@@ -100,6 +100,9 @@ bool is_shader_node(DNode node)
 
 bool is_node_supported(DNode node)
 {
+  if (node->typeinfo->realtime_compositor_unsupported_message) {
+    return false;
+  }
   return node->typeinfo->get_compositor_operation || node->typeinfo->get_compositor_shader_node;
 }
 
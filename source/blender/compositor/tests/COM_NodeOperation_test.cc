@@ -42,6 +42,31 @@ class NonHashedConstantOperation : public ConstantOperation {
   }
 };
 
+class HashedInputOperation : public NodeOperation {
+ private:
+  int param_;
+
+ public:
+  HashedInputOperation(int id, int param)
+  {
+    set_id(id);
+    add_output_socket(DataType::Value);
+    set_width(2);
+    set_height(3);
+    param_ = param;
+  }
+
+  void set_param(int value)
+  {
+    param_ = value;
+  }
+
+  void hash_output_params() override
+  {
+    hash_param(param_);
+  }
+};
+
 class HashedOperation : public NodeOperation {
  private:
   int param1;
@@ -151,4 +176,33 @@ TEST(NodeOperation, generate_hash)
   }
 }
 
+TEST(NodeOperation, generate_result_hash)
+{
+  /* Non hashed input. */
+  {
+    NonHashedOperation input_op(1);
+    HashedOperation op(input_op, 6, 4);
+    Map<NodeOperation *, std::optional<size_t>> hashes;
+    EXPECT_EQ(op.generate_result_hash(hashes), std::nullopt);
+    EXPECT_EQ(hashes.lookup(&input_op), std::nullopt);
+  }
+
+  /* Hashed inputs with different ids. */
+  {
+    HashedInputOperation input_op1(1, 5);
+    HashedOperation op1(input_op1, 6, 4);
+    HashedInputOperation input_op2(2, 5);
+    HashedOperation op2(input_op2, 6, 4);
+
+    Map<NodeOperation *, std::optional<size_t>> hashes;
+    std::optional<size_t> hash1 = op1.generate_result_hash(hashes);
+    EXPECT_NE(hash1, std::nullopt);
+    EXPECT_EQ(hash1, op2.generate_result_hash(hashes));
+
+    input_op2.set_param(3);
+    hashes.clear();
+    EXPECT_NE(hash1, op2.generate_result_hash(hashes));
+  }
+}
+
 }  // namespace blender::compositor::tests
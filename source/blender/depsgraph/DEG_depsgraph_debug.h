@@ -52,6 +52,13 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/**
+ * Write timeline of the last evaluation in the Chrome trace event format (JSON), which can be
+ * opened in `chrome://tracing` or Perfetto. The timeline is only gathered when the timing
+ * statistics are enabled (`--debug-depsgraph-time`).
+ */
+void DEG_debug_eval_trace_json(const struct Depsgraph *graph, FILE *fp);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
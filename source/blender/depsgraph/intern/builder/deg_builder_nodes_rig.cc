@@ -15,6 +15,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
@@ -205,32 +206,64 @@ void DepsgraphNodeBuilder::build_rig(Object *object)
       OperationCode::POSE_DONE,
       [object_cow](::Depsgraph *depsgraph) { BKE_pose_eval_done(depsgraph, object_cow); });
   op_node->set_as_exit();
+  /* Bones which can be part of an IK or Spline IK chain: the solvers modify their pose between
+   * the ready and done steps. Chain lengths can be animated, so all parents of the constraint
+   * owners are included. */
+  Set<const bPoseChannel *> ik_chain_pchans;
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
+    LISTBASE_FOREACH (bConstraint *, con, &pchan->constraints) {
+      if (ELEM(con->type, CONSTRAINT_TYPE_KINEMATIC, CONSTRAINT_TYPE_SPLINEIK)) {
+        for (const bPoseChannel *parchan = pchan; parchan; parchan = parchan->parent) {
+          if (!ik_chain_pchans.add(parchan)) {
+            break;
+          }
+        }
+        break;
+      }
+    }
+  }
   /* Bones. */
   int pchan_index = 0;
   LISTBASE_FOREACH (bPoseChannel *, pchan, &object->pose->chanbase) {
+    /* Nothing happens between the pose and done steps of bones without constraints which are not
+     * in an IK chain, so both are evaluated in the same operation to save scheduling overhead.
+     * The done step is kept as a noop for the relations. */
+    const bool is_done_with_pose = pchan->constraints.first == nullptr &&
+                                   !ik_chain_pchans.contains(pchan);
+
     /* Node for bone evaluation. */
     op_node = add_operation_node(
         &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_LOCAL);
     op_node->set_as_entry();
 
-    add_operation_node(&object->id,
-                       NodeType::BONE,
-                       pchan->name,
-                       OperationCode::BONE_POSE_PARENT,
-                       [scene_cow, object_cow, pchan_index](::Depsgraph *depsgraph) {
-                         BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
-                       });
+    add_operation_node(
+        &object->id,
+        NodeType::BONE,
+        pchan->name,
+        OperationCode::BONE_POSE_PARENT,
+        [scene_cow, object_cow, pchan_index, is_done_with_pose](::Depsgraph *depsgraph) {
+          BKE_pose_eval_bone(depsgraph, scene_cow, object_cow, pchan_index);
+          if (is_done_with_pose) {
+            BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+          }
+        });
 
     /* NOTE: Dedicated noop for easier relationship construction. */
     add_operation_node(&object->id, NodeType::BONE, pchan->name, OperationCode::BONE_READY);
 
-    op_node = add_operation_node(&object->id,
-                                 NodeType::BONE,
-                                 pchan->name,
-                                 OperationCode::BONE_DONE,
-                                 [object_cow, pchan_index](::Depsgraph *depsgraph) {
-                                   BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
-                                 });
+    if (is_done_with_pose) {
+      op_node = add_operation_node(
+          &object->id, NodeType::BONE, pchan->name, OperationCode::BONE_DONE);
+    }
+    else {
+      op_node = add_operation_node(&object->id,
+                                   NodeType::BONE,
+                                   pchan->name,
+                                   OperationCode::BONE_DONE,
+                                   [object_cow, pchan_index](::Depsgraph *depsgraph) {
+                                     BKE_pose_bone_done(depsgraph, object_cow, pchan_index);
+                                   });
+    }
 
     /* B-Bone shape computation - the real last step if present. */
     if (check_pchan_has_bbone(object, pchan)) {
@@ -15,7 +15,9 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -3100,8 +3102,25 @@ void DepsgraphRelationBuilder::build_vfont(VFont *vfont)
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+  /* Relations are collected for every ID node in parallel, without modifying the graph. They are
+   * then added in the order of ID nodes, so the result is the same as when building them on a
+   * single thread. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<Vector<PendingRelation>> id_relations(id_nodes.size());
+  threading::parallel_for(id_nodes.index_range(), 32, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      collect_copy_on_write_relations(id_nodes[i], id_relations[i]);
+    }
+  });
+  for (const Vector<PendingRelation> &relations : id_relations) {
+    add_pending_relations(relations);
+  }
+}
+
+void DepsgraphRelationBuilder::add_pending_relations(Span<PendingRelation> relations)
+{
+  for (const PendingRelation &relation : relations) {
+    graph_->add_new_relation(relation.from, relation.to, relation.description, relation.flags);
   }
 }
 
@@ -3143,6 +3162,14 @@ void DepsgraphRelationBuilder::build_nested_shapekey(ID *owner, Key *key)
 }
 
 void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
+{
+  Vector<PendingRelation> relations;
+  collect_copy_on_write_relations(id_node, relations);
+  add_pending_relations(relations);
+}
+
+void DepsgraphRelationBuilder::collect_copy_on_write_relations(
+    IDNode *id_node, Vector<PendingRelation> &r_relations)
 {
   ID *id_orig = id_node->id_orig;
 
@@ -3198,8 +3225,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "CoW Dependency");
-      rel->flag |= rel_flag;
+      r_relations.append({op_cow, op_entry, "CoW Dependency", rel_flag});
     }
     /* All dangling operations should also be executed after copy-on-write. */
     for (OperationNode *op_node : comp_node->operations_map->values()) {
@@ -3207,8 +3233,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "CoW Dependency");
-        rel->flag |= rel_flag;
+        r_relations.append({op_cow, op_node, "CoW Dependency", rel_flag});
       }
       else {
         bool has_same_comp_dependency = false;
@@ -3223,8 +3248,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "CoW Dependency");
-          rel->flag |= rel_flag;
+          r_relations.append({op_cow, op_node, "CoW Dependency", rel_flag});
         }
       }
     }
@@ -3245,8 +3269,10 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
       if (deg_copy_on_write_is_needed(object_data_id)) {
         OperationKey data_copy_on_write_key(
             object_data_id, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
-        add_relation(
-            data_copy_on_write_key, copy_on_write_key, "Eval Order", RELATION_FLAG_GODMODE);
+        OperationNode *op_data_cow = get_node(data_copy_on_write_key);
+        if (op_data_cow != nullptr) {
+          r_relations.append({op_data_cow, op_cow, "Eval Order", RELATION_FLAG_GODMODE});
+        }
       }
     }
     else {
@@ -245,6 +245,20 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   Depsgraph *getGraph();
 
  protected:
+  /* Relation which is collected by a pass running in parallel over ID nodes, and which is added
+   * to the graph once all threads are done. */
+  struct PendingRelation {
+    OperationNode *from;
+    OperationNode *to;
+    const char *description;
+    int flags;
+  };
+
+  /* Collect copy-on-write relations of the given ID node without modifying the graph, so that
+   * it is safe to call for different ID nodes from multiple threads. */
+  void collect_copy_on_write_relations(IDNode *id_node, Vector<PendingRelation> &r_relations);
+  void add_pending_relations(Span<PendingRelation> relations);
+
   TimeSourceNode *get_node(const TimeSourceKey &key) const;
   ComponentNode *get_node(const ComponentKey &key) const;
   OperationNode *get_node(const OperationKey &key) const;
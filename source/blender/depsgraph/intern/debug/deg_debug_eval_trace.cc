@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Export of the evaluation timeline in the Chrome trace event format, which can be loaded into
+ * `chrome://tracing` or Perfetto.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include <cstdarg>
+
+#include "BLI_compiler_attrs.h"
+
+#include "intern/depsgraph.h"
+#include "intern/eval/deg_eval_stats.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+namespace {
+
+/* Process identifier used for all events. */
+const int TRACE_PID = 1;
+
+void trace_fprintf(FILE *fp, const char *fmt, ...) ATTR_PRINTF_FORMAT(2, 3);
+void trace_fprintf(FILE *fp, const char *fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(fp, fmt, args);
+  va_end(args);
+}
+
+string json_escape(const string &str)
+{
+  string result;
+  result.reserve(str.length());
+  for (const char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      result += '\\';
+      result += ch;
+    }
+    else if (uchar(ch) < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", int(ch));
+      result += buffer;
+    }
+    else {
+      result += ch;
+    }
+  }
+  return result;
+}
+
+/* Convert timer seconds to the trace microseconds, relative to the evaluation begin. */
+double trace_time(const EvalTrace &trace, const double time)
+{
+  return (time - trace.begin_time) * 1e6;
+}
+
+void write_thread_name(FILE *fp, const int tid, const char *name)
+{
+  trace_fprintf(fp,
+                ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                "\"args\":{\"name\":\"%s\"}}",
+                TRACE_PID,
+                tid,
+                name);
+}
+
+void write_event(FILE *fp, const EvalTrace &trace, const EvalTraceEvent &event, const int tid)
+{
+  const OperationNode *operation = event.operation;
+  const ComponentNode *component = operation->owner;
+  const IDNode *id_node = component->owner;
+  trace_fprintf(fp,
+                ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                "\"pid\":%d,\"tid\":%d,\"args\":{\"id\":\"%s\",\"component\":\"%s\","
+                "\"wait\":%.3f,\"critical_path\":%s}}",
+                json_escape(operation->full_identifier()).c_str(),
+                nodeTypeAsString(component->type),
+                trace_time(trace, event.start_time),
+                (event.end_time - event.start_time) * 1e6,
+                TRACE_PID,
+                tid,
+                json_escape(id_node->name).c_str(),
+                json_escape(component->name).c_str(),
+                (event.start_time - event.ready_time) * 1e6,
+                event.on_critical_path ? "true" : "false");
+}
+
+void deg_debug_eval_trace_json(const EvalTrace &trace, FILE *fp)
+{
+  trace_fprintf(fp, "{\"traceEvents\":[");
+  trace_fprintf(fp,
+                "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                "\"args\":{\"name\":\"Depsgraph Evaluation\"}}",
+                TRACE_PID);
+
+  for (int thread_index = 0; thread_index < trace.threads_num; thread_index++) {
+    char name[64];
+    snprintf(name, sizeof(name), "Thread %d", thread_index);
+    write_thread_name(fp, thread_index, name);
+  }
+  /* The critical path is shown as its own track after all the threads, making it easy to see
+   * which operations are serializing the evaluation. */
+  const int critical_path_tid = trace.threads_num;
+  write_thread_name(fp, critical_path_tid, "Critical Path");
+
+  for (const EvalTraceEvent &event : trace.events) {
+    if (event.operation->is_noop()) {
+      continue;
+    }
+    write_event(fp, trace, event, event.thread_index);
+    if (event.on_critical_path) {
+      write_event(fp, trace, event, critical_path_tid);
+    }
+  }
+
+  trace_fprintf(fp,
+                "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"wall_time\":%f,"
+                "\"operations_time\":%f,\"critical_path_time\":%f,"
+                "\"critical_path_operations\":%d,\"threads\":%d}}\n",
+                trace.end_time - trace.begin_time,
+                trace.operations_time,
+                trace.critical_path_time,
+                trace.critical_path_operations_num,
+                trace.threads_num);
+}
+
+}  // namespace
+}  // namespace blender::deg
+
+void DEG_debug_eval_trace_json(const Depsgraph *depsgraph, FILE *fp)
+{
+  if (depsgraph == nullptr) {
+    return;
+  }
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  deg::deg_debug_eval_trace_json(deg_graph->eval_trace, fp);
+}
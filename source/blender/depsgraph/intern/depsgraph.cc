@@ -59,6 +59,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       is_evaluating(false),
+      priority_update_countdown(0),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false)
 {
@@ -166,6 +167,10 @@ void Depsgraph::clear_id_nodes()
   id_nodes.clear();
   /* Clear physics relation caches. */
   clear_physics_relations(this);
+  /* Trace events are referencing operation nodes. */
+  eval_trace.clear();
+  /* Time the new operations as soon as possible. */
+  priority_update_countdown = 0;
 }
 
 Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
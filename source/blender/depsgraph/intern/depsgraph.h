@@ -26,6 +26,7 @@
 
 #include "intern/debug/deg_debug.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_stats.h"
 
 struct ID;
 struct Scene;
@@ -149,8 +150,15 @@ struct Depsgraph {
 
   DepsgraphDebug debug;
 
+  /* Timeline of the last evaluation, only gathered when timing statistics are enabled. */
+  EvalTrace eval_trace;
+
   bool is_evaluating;
 
+  /* Number of evaluations left until operations are timed to update their scheduling priority.
+   * Zero means that the next evaluation is timed. */
+  int priority_update_countdown;
+
   /* Is set to truth for dependency graph which are used for post-processing (compositor and
    * sequencer).
    * Such dependency graph needs all view layers (so render pipeline can access names), but it
@@ -9,11 +9,16 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_gsqueue.h"
+#include "BLI_math_base.h"
 #include "BLI_task.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -50,6 +55,12 @@ namespace {
 
 struct DepsgraphEvalState;
 
+/* Operations are timed once in this many evaluations to update their scheduling priority. */
+const int PRIORITY_UPDATE_INTERVAL = 16;
+
+/* Operations which became ready for evaluation, gathered so they can be ordered by priority. */
+using ReadyNodes = Vector<OperationNode *, 16>;
+
 void deg_task_run_func(TaskPool *pool, void *taskdata);
 
 template<typename ScheduleFunction, typename... ScheduleFunctionArgs>
@@ -58,9 +69,34 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args);
 
-void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), TaskPool *pool)
+void schedule_node_to_ready_nodes(OperationNode *node,
+                                  const int /*thread_id*/,
+                                  ReadyNodes *ready_nodes)
 {
-  BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  ready_nodes->append(node);
+}
+
+/* Push ready nodes to the pool, the ones with the longest chain of operations ahead first.
+ *
+ * When `r_continue_node` is given the most important node is not pushed but returned for the
+ * caller to evaluate right away, without going through the pool. */
+void push_ready_nodes_by_priority(ReadyNodes &ready_nodes,
+                                  TaskPool *pool,
+                                  OperationNode **r_continue_node)
+{
+  std::stable_sort(ready_nodes.begin(),
+                   ready_nodes.end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->priority > b->priority;
+                   });
+  int64_t start = 0;
+  if (r_continue_node != nullptr) {
+    *r_continue_node = ready_nodes.is_empty() ? nullptr : ready_nodes[0];
+    start = 1;
+  }
+  for (int64_t i = start; i < ready_nodes.size(); i++) {
+    BLI_task_pool_push(pool, deg_task_run_func, ready_nodes[i], false, nullptr);
+  }
 }
 
 /* Denotes which part of dependency graph is being evaluated. */
@@ -86,22 +122,49 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Time every evaluated operation, either for the statistics or for the priority update. */
+  bool do_timing;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+
+  /* Timeline of the evaluated operations, gathered together with the timing statistics.
+   * Every thread records its own events to avoid synchronization. */
+  double trace_begin_time = 0.0;
+  threading::EnumerableThreadSpecific<Vector<EvalTraceEvent>> trace_events;
 };
 
-void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
+void record_trace_event(DepsgraphEvalState *state,
+                        const OperationNode *operation_node,
+                        const double start_time,
+                        const double end_time)
+{
+  EvalTraceEvent event;
+  event.operation = operation_node;
+  event.start_time = start_time;
+  event.end_time = end_time;
+  event.thread_index = 0;
+  event.ready_time = start_time;
+  event.on_critical_path = false;
+  state->trace_events.local().append(event);
+}
+
+void evaluate_node(DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_timing) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    const double end_time = PIL_check_seconds_timer();
+    operation_node->eval_time = float(end_time - start_time);
+    if (state->do_stats) {
+      operation_node->stats.current_time += end_time - start_time;
+      record_trace_event(state, operation_node, start_time, end_time);
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -120,12 +183,16 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
+  /* Evaluate node, and continue with the most important of its children which became ready in
+   * the same task. The rest of the children are pushed to the pool for other threads. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    ReadyNodes ready_nodes;
+    schedule_children(state, operation_node, schedule_node_to_ready_nodes, &ready_nodes);
+    push_ready_nodes_by_priority(ready_nodes, pool, &operation_node);
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -198,7 +265,33 @@ void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
     for (OperationNode *node : graph->operations) {
       node->stats.reset_current();
     }
+    state->trace_begin_time = PIL_check_seconds_timer();
+  }
+}
+
+/* Move events recorded by all threads to the graph, and analyze them. */
+void finalize_trace(DepsgraphEvalState *state, Depsgraph *graph)
+{
+  EvalTrace &trace = graph->eval_trace;
+  trace.clear();
+  trace.begin_time = state->trace_begin_time;
+  trace.end_time = PIL_check_seconds_timer();
+  for (Vector<EvalTraceEvent> &thread_events : state->trace_events) {
+    for (EvalTraceEvent &event : thread_events) {
+      event.thread_index = trace.threads_num;
+    }
+    trace.events.extend(thread_events);
+    trace.threads_num++;
   }
+
+  deg_eval_trace_finalize(trace);
+
+  printf("Depsgraph critical path: %f seconds over %d operations, %f seconds of work in %d "
+         "threads.\n",
+         trace.critical_path_time,
+         trace.critical_path_operations_num,
+         trace.operations_time,
+         trace.threads_num);
 }
 
 bool is_metaball_object_operation(const OperationNode *operation_node)
@@ -276,6 +369,11 @@ void schedule_node(DepsgraphEvalState *state,
   bool is_scheduled = atomic_fetch_and_or_uint8((uint8_t *)&node->scheduled, uint8_t(true));
   if (!is_scheduled) {
     if (node->is_noop()) {
+      if (state->do_stats) {
+        /* Keep track of the no-op nodes, so that the critical path can be followed through. */
+        const double time = PIL_check_seconds_timer();
+        record_trace_event(state, node, time, time);
+      }
       /* skip NOOP node, schedule children right away */
       schedule_children(state, node, schedule_function, schedule_function_args...);
     }
@@ -335,7 +433,9 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, schedule_node_to_pool, task_pool);
+  ReadyNodes ready_nodes;
+  schedule_graph(state, schedule_node_to_ready_nodes, &ready_nodes);
+  push_ready_nodes_by_priority(ready_nodes, task_pool, nullptr);
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -380,6 +480,50 @@ void depsgraph_ensure_view_layer(Depsgraph *graph)
   deg_update_copy_on_write_datablock(graph, scene_id_node);
 }
 
+/* Update priorities of all operations from their last sampled evaluation time.
+ *
+ * The operations are visited in reverse topological order, so that the priority of all children
+ * is known when the priority of the operation is calculated. */
+void update_operation_priorities(Depsgraph *graph)
+{
+  const auto foreach_child = [](OperationNode *node, auto func) {
+    for (Relation *rel : node->outlinks) {
+      if (rel->to->type == NodeType::OPERATION && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+        func(static_cast<OperationNode *>(rel->to));
+      }
+    }
+  };
+
+  /* Use custom flags to count the children whose priority is not yet known. */
+  Vector<OperationNode *> queue;
+  queue.reserve(graph->operations.size());
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = 0;
+    foreach_child(node, [&](OperationNode * /*child*/) { node->custom_flags++; });
+    if (node->custom_flags == 0) {
+      queue.append(node);
+    }
+  }
+
+  for (int64_t queue_index = 0; queue_index < queue.size(); queue_index++) {
+    OperationNode *node = queue[queue_index];
+    float children_priority = 0.0f;
+    foreach_child(node, [&](OperationNode *child) {
+      children_priority = max_ff(children_priority, child->priority);
+    });
+    node->priority = node->eval_time + children_priority;
+
+    for (Relation *rel : node->inlinks) {
+      if (rel->from->type == NodeType::OPERATION && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+        OperationNode *parent = static_cast<OperationNode *>(rel->from);
+        if (--parent->custom_flags == 0) {
+          queue.append(parent);
+        }
+      }
+    }
+  }
+}
+
 TaskPool *deg_evaluate_task_pool_create(DepsgraphEvalState *state)
 {
   if (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) {
@@ -398,6 +542,8 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
     return;
   }
 
+  BLI_TRACE_SCOPE("Depsgraph Evaluation");
+
   graph->debug.begin_graph_evaluation();
 
 #ifdef WITH_PYTHON
@@ -412,6 +558,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.do_timing = state.do_stats || graph->priority_update_countdown == 0;
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -465,6 +612,15 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * synchronization. */
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
+    finalize_trace(&state, graph);
+  }
+
+  if (state.do_timing) {
+    update_operation_priorities(graph);
+    graph->priority_update_countdown = PRIORITY_UPDATE_INTERVAL;
+  }
+  else {
+    graph->priority_update_countdown--;
   }
 
   /* Clear any uncleared tags. */
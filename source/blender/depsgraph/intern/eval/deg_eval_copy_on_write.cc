@@ -819,8 +819,8 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* NOTE: Geometry arrays of trivial types are not copied but shared with the original mesh
+       * (see #CD_SHARE), and only duplicated when they are to be modified. */
       break;
     }
     default:
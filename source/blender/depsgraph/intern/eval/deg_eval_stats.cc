@@ -7,9 +7,12 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -38,4 +41,124 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void EvalTrace::clear()
+{
+  begin_time = 0.0;
+  end_time = 0.0;
+  events.clear();
+  threads_num = 0;
+  operations_time = 0.0;
+  critical_path_time = 0.0;
+  critical_path_operations_num = 0;
+}
+
+/* Invoke the callback for all evaluated dependencies of the given operation. Cyclic relations are
+ * ignored, as they are not respected by the scheduler either. */
+template<typename Func>
+static void foreach_traced_relation(const Map<const OperationNode *, int64_t> &event_index,
+                                    const Node::Relations &relations,
+                                    const bool use_from,
+                                    const Func &func)
+{
+  for (const Relation *rel : relations) {
+    if (rel->flag & RELATION_FLAG_CYCLIC) {
+      continue;
+    }
+    const Node *node = use_from ? rel->from : rel->to;
+    if (node->type != NodeType::OPERATION) {
+      continue;
+    }
+    const int64_t *index = event_index.lookup_ptr(static_cast<const OperationNode *>(node));
+    if (index != nullptr) {
+      func(*index);
+    }
+  }
+}
+
+void deg_eval_trace_finalize(EvalTrace &trace)
+{
+  Vector<EvalTraceEvent> &events = trace.events;
+  const int64_t events_num = events.size();
+
+  trace.operations_time = 0.0;
+  trace.critical_path_time = 0.0;
+  trace.critical_path_operations_num = 0;
+
+  /* No-op nodes might be passed through in several evaluation stages, the last event is the one
+   * which the following operations depend on. */
+  Map<const OperationNode *, int64_t> event_index;
+  event_index.reserve(events_num);
+  for (const int64_t i : events.index_range()) {
+    event_index.add_overwrite(events[i].operation, i);
+    events[i].ready_time = events[i].start_time;
+    events[i].on_critical_path = false;
+  }
+
+  /* Visit events in topological order, so that all dependencies are handled before the operation
+   * itself. */
+  Array<int> pending_num(events_num, 0);
+  Vector<int64_t> queue;
+  queue.reserve(events_num);
+  for (const int64_t i : events.index_range()) {
+    const OperationNode *operation = events[i].operation;
+    if (event_index.lookup(operation) == i) {
+      foreach_traced_relation(event_index, operation->inlinks, true, [&](const int64_t /*from*/) {
+        pending_num[i]++;
+      });
+    }
+    if (pending_num[i] == 0) {
+      queue.append(i);
+    }
+  }
+
+  /* Longest accumulated time of a chain of operations ending at the event. */
+  Array<double> path_time(events_num, 0.0);
+  Array<int64_t> path_prev(events_num, -1);
+
+  for (int64_t queue_index = 0; queue_index < queue.size(); queue_index++) {
+    const int64_t i = queue[queue_index];
+    EvalTraceEvent &event = events[i];
+    const OperationNode *operation = event.operation;
+    const double duration = event.end_time - event.start_time;
+
+    event.ready_time = trace.begin_time;
+    foreach_traced_relation(event_index, operation->inlinks, true, [&](const int64_t from) {
+      event.ready_time = max_dd(event.ready_time, events[from].end_time);
+      if (path_prev[i] == -1 || path_time[from] > path_time[path_prev[i]]) {
+        path_prev[i] = from;
+      }
+    });
+    event.ready_time = min_dd(event.ready_time, event.start_time);
+    path_time[i] = duration + (path_prev[i] != -1 ? path_time[path_prev[i]] : 0.0);
+    trace.operations_time += duration;
+
+    if (event_index.lookup(operation) != i) {
+      continue;
+    }
+    foreach_traced_relation(event_index, operation->outlinks, false, [&](const int64_t to) {
+      if (--pending_num[to] == 0) {
+        queue.append(to);
+      }
+    });
+  }
+
+  if (events_num == 0) {
+    return;
+  }
+
+  int64_t tail = 0;
+  for (const int64_t i : events.index_range()) {
+    if (path_time[i] > path_time[tail]) {
+      tail = i;
+    }
+  }
+  trace.critical_path_time = path_time[tail];
+  for (int64_t i = tail; i != -1; i = path_prev[i]) {
+    events[i].on_critical_path = true;
+    if (!events[i].operation->is_noop()) {
+      trace.critical_path_operations_num++;
+    }
+  }
+}
+
 }  // namespace blender::deg
@@ -7,11 +7,62 @@
 
 #pragma once
 
+#include "intern/depsgraph_type.h"
+
 namespace blender::deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Single operation which was executed during the dependency graph evaluation.
+ * No-op nodes are recorded as well (with zero duration) so that the dependencies passing through
+ * them can be followed. */
+struct EvalTraceEvent {
+  const OperationNode *operation;
+
+  /* Timestamps from #PIL_check_seconds_timer(). */
+  double start_time;
+  double end_time;
+
+  /* Index of the thread which evaluated the operation. */
+  int thread_index;
+
+  /* Point in time when all dependencies of this operation became evaluated, and when the
+   * operation could have started if there were enough free threads.
+   * Calculated by #deg_eval_trace_finalize(). */
+  double ready_time;
+
+  /* Operation belongs to the longest chain of dependent operations of this evaluation.
+   * Calculated by #deg_eval_trace_finalize(). */
+  bool on_critical_path;
+};
+
+/* Timeline of the last dependency graph evaluation.
+ * Gathered when timing statistics are enabled (`--debug-depsgraph-time`). */
+struct EvalTrace {
+  double begin_time = 0.0;
+  double end_time = 0.0;
+
+  Vector<EvalTraceEvent> events;
+
+  /* Number of threads which took part in the evaluation. */
+  int threads_num = 0;
+
+  /* Accumulated time of all operations. */
+  double operations_time = 0.0;
+
+  /* Accumulated time of the operations on the critical path: the shortest possible time of the
+   * evaluation regardless of the number of threads. */
+  double critical_path_time = 0.0;
+  int critical_path_operations_num = 0;
+
+  void clear();
+};
+
+/* Calculate ready times and the critical path of the recorded trace events. */
+void deg_eval_trace_finalize(EvalTrace &trace);
+
 }  // namespace blender::deg
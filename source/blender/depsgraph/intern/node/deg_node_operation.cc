@@ -202,7 +202,7 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0)
+OperationNode::OperationNode() : name_tag(-1), flag(0), eval_time(0.0f), priority(0.0f)
 {
 }
 
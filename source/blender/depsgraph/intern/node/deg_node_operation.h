@@ -275,6 +275,12 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Time spent on the last sampled evaluation of this operation, in seconds. */
+  float eval_time;
+  /* Accumulated evaluation time of the longest chain of operations which starts at this one.
+   * Operations with a longer chain ahead of them are scheduled first. */
+  float priority;
+
   DEG_DEPSNODE_DECLARE;
 };
 
@@ -164,6 +164,10 @@ void DRW_uniform_attrs_pool_free(struct GHash *table);
 
 void DRW_render_context_enable(struct Render *render);
 void DRW_render_context_disable(struct Render *render);
+/**
+ * Free the draw data kept across the frames of a render, see #RE_draw_data_get.
+ */
+void DRW_render_data_free(struct Render *render);
 
 void DRW_opengl_context_create(void);
 void DRW_opengl_context_destroy(void);
@@ -185,6 +189,9 @@ void DRW_cache_free_old_subdiv(void);
 /* For the OpenGL evaluators and garbage collected subdivision data. */
 void DRW_subdiv_free(void);
 
+/* For the compute shaders used to extract mesh positions and normals. */
+void DRW_mesh_extract_gpu_free(void);
+
 /* Never use this. Only for closing blender. */
 void DRW_opengl_context_enable_ex(bool restore);
 void DRW_opengl_context_disable_ex(bool restore);
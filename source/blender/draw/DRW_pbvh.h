@@ -82,6 +82,15 @@ void DRW_pbvh_update_pre(PBVHBatches *batches, PBVH_GPU_Args *args);
 void DRW_pbvh_node_gpu_flush(PBVHBatches *batches);
 struct PBVHBatches *DRW_pbvh_node_create(PBVH_GPU_Args *args);
 void DRW_pbvh_node_free(PBVHBatches *batches);
+/**
+ * Approximate size of the GPU buffers of a node, in bytes.
+ */
+uint64_t DRW_pbvh_node_gpu_memory_usage(const PBVHBatches *batches);
+/**
+ * Amount of GPU memory PBVH draw buffers can use before the ones of nodes outside of the view
+ * are freed, in bytes. Zero when the GPU memory size is unknown, in which case nothing is freed.
+ */
+uint64_t DRW_pbvh_gpu_memory_budget(void);
 struct GPUBatch *DRW_pbvh_tris_get(PBVHBatches *batches,
                                    struct PBVHAttrReq *attrs,
                                    int attrs_num,
@@ -162,6 +162,43 @@ static void workbench_cache_texpaint_populate(WORKBENCH_PrivateData *wpd, Object
   }
 }
 
+/**
+ * Use the simplified surface when the grid cells used to merge its vertices are smaller than a
+ * pixel, which makes the level of detail change invisible.
+ */
+static bool workbench_object_use_mesh_lod(Object *ob)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_viewport_mesh_lod)) {
+    return false;
+  }
+  if (ob->type != OB_MESH || ob->mode != OB_MODE_OBJECT) {
+    return false;
+  }
+  const Mesh *me = ob->data;
+  /* The simplified surface can't have much less triangles than that. */
+  if (me->totpoly < DRW_MESH_LOD_GRID_RESOLUTION * DRW_MESH_LOD_GRID_RESOLUTION) {
+    return false;
+  }
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return false;
+  }
+
+  float min[3], max[3], center[3];
+  mul_v3_m4v3(min, ob->obmat, bb->vec[0]);
+  mul_v3_m4v3(max, ob->obmat, bb->vec[6]);
+  mid_v3_v3v3(center, min, max);
+
+  float persmat[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  const float pixel_size = mul_project_m4_v3_zfac(persmat, center) * *DRW_viewport_pixelsize_get();
+  if (pixel_size <= 0.0f) {
+    return false;
+  }
+  /* The diagonal is an upper bound of the largest dimension, in any rotation. */
+  return len_v3v3(min, max) <= pixel_size * DRW_MESH_LOD_GRID_RESOLUTION;
+}
+
 static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
                                             Object *ob,
                                             eV3DShadingColorType color_type,
@@ -182,6 +219,9 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
         geom = DRW_cache_mesh_surface_sculptcolors_get(ob);
       }
     }
+    else if (workbench_object_use_mesh_lod(ob)) {
+      geom = DRW_cache_mesh_surface_lod_get(ob);
+    }
     else {
       geom = DRW_cache_object_surface_get(ob);
     }
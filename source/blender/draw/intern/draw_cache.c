@@ -2833,6 +2833,12 @@ GPUBatch *DRW_cache_mesh_surface_get(Object *ob)
   return DRW_mesh_batch_cache_get_surface(ob->data);
 }
 
+GPUBatch *DRW_cache_mesh_surface_lod_get(Object *ob)
+{
+  BLI_assert(ob->type == OB_MESH);
+  return DRW_mesh_batch_cache_get_surface_lod(ob->data);
+}
+
 GPUBatch *DRW_cache_mesh_surface_edges_get(Object *ob)
 {
   BLI_assert(ob->type == OB_MESH);
@@ -148,11 +148,18 @@ struct GPUBatch *DRW_cache_bone_dof_lines_get(void);
 
 /* Meshes */
 
+#define DRW_MESH_LOD_GRID_RESOLUTION 256
+
 struct GPUBatch *DRW_cache_mesh_all_verts_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_all_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_loose_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_edge_detection_get(struct Object *ob, bool *r_is_manifold);
 struct GPUBatch *DRW_cache_mesh_surface_get(struct Object *ob);
+/**
+ * Simplified surface for meshes drawn with less than one pixel per triangle. Vertices are merged
+ * in a grid of #DRW_MESH_LOD_GRID_RESOLUTION cells along the largest dimension of the mesh.
+ */
+struct GPUBatch *DRW_cache_mesh_surface_lod_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_surface_edges_get(struct Object *ob);
 /**
  * Return list of batches with length equal to `max(1, totcol)`.
@@ -121,6 +121,8 @@ struct MeshBufferList {
   struct {
     /* Indices to vloops. Ordered per material. */
     GPUIndexBuf *tris;
+    /* Simplified `tris` for distant dense meshes, see `extract_mesh_ibo_tris.cc`. */
+    GPUIndexBuf *tris_lod;
     /* Loose edges last. */
     GPUIndexBuf *lines;
     /* Sub buffer of `lines` only containing the loose edges. */
@@ -142,6 +144,7 @@ struct MeshBufferList {
 struct MeshBatchList {
   /* Surfaces / Render */
   GPUBatch *surface;
+  GPUBatch *surface_lod;
   GPUBatch *surface_weights;
   /* Edit mode */
   GPUBatch *edit_triangles;
@@ -187,6 +190,7 @@ struct MeshBatchList {
 
 enum DRWBatchFlag {
   MBC_SURFACE = (1u << MBC_BATCH_INDEX(surface)),
+  MBC_SURFACE_LOD = (1u << MBC_BATCH_INDEX(surface_lod)),
   MBC_SURFACE_WEIGHTS = (1u << MBC_BATCH_INDEX(surface_weights)),
   MBC_EDIT_TRIANGLES = (1u << MBC_BATCH_INDEX(edit_triangles)),
   MBC_EDIT_VERTICES = (1u << MBC_BATCH_INDEX(edit_vertices)),
@@ -232,12 +236,19 @@ struct MeshExtractLooseGeom {
  * Data that are kept around between extractions to reduce rebuilding time.
  *
  * - Loose geometry.
+ * - Corner topology for the extraction with compute shaders.
  */
 struct MeshBufferCache {
   MeshBufferList buff;
 
   MeshExtractLooseGeom loose_geom;
 
+  /** The vertex and face of every corner, see `draw_cache_extract_mesh_gpu.cc`. */
+  struct {
+    GPUVertBuf *loop_vert;
+    GPUVertBuf *loop_poly;
+  } gpu_topology;
+
   struct {
     int *tri_first_index;
     int *mat_tri_len;
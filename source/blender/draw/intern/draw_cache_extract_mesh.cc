@@ -615,8 +615,9 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
     } \
   } while (0)
 
-  EXTRACT_ADD_REQUESTED(vbo, pos_nor);
-  EXTRACT_ADD_REQUESTED(vbo, lnor);
+  /* Positions and normals may be extracted with compute shaders, see below. */
+  const bool request_pos_nor = DRW_vbo_requested(mbuflist->vbo.pos_nor);
+  const bool request_lnor = DRW_vbo_requested(mbuflist->vbo.lnor);
   EXTRACT_ADD_REQUESTED(vbo, uv);
   EXTRACT_ADD_REQUESTED(vbo, tan);
   EXTRACT_ADD_REQUESTED(vbo, sculpt_data);
@@ -643,6 +644,7 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   EXTRACT_ADD_REQUESTED(vbo, attr_viewer);
 
   EXTRACT_ADD_REQUESTED(ibo, tris);
+  EXTRACT_ADD_REQUESTED(ibo, tris_lod);
   if (DRW_ibo_requested(mbuflist->ibo.lines_loose)) {
     /* `ibo.lines_loose` require the `ibo.lines` buffer. */
     if (mbuflist->ibo.lines == nullptr) {
@@ -673,9 +675,7 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   EXTRACT_ADD_REQUESTED(ibo, edituv_points);
   EXTRACT_ADD_REQUESTED(ibo, edituv_fdots);
 
-#undef EXTRACT_ADD_REQUESTED
-
-  if (extractors.is_empty()) {
+  if (extractors.is_empty() && !request_pos_nor && !request_lnor) {
     return;
   }
 
@@ -689,10 +689,46 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   mr->use_subsurf_fdots = mr->me && mr->me->runtime.subsurf_face_dot_tags != nullptr;
   mr->use_final_mesh = do_final;
 
+  if (request_pos_nor || request_lnor) {
+    /* High quality normals need a different format, and custom or auto-smooth normals are only
+     * computed on the CPU. */
+    const bool use_gpu = !do_hq_normals && mesh_extract_gpu_supported(mr);
+    const bool use_gpu_lnor = use_gpu && (mr->me->flag & ME_AUTOSMOOTH) == 0;
+    GPUVertBuf *gpu_pos_nor = nullptr;
+    GPUVertBuf *gpu_lnor = nullptr;
+
+    if (request_pos_nor) {
+      if (use_gpu) {
+        gpu_pos_nor = mbuflist->vbo.pos_nor;
+      }
+      else {
+        EXTRACT_ADD_REQUESTED(vbo, pos_nor);
+      }
+    }
+    if (request_lnor) {
+      if (use_gpu_lnor) {
+        gpu_lnor = mbuflist->vbo.lnor;
+      }
+      else {
+        EXTRACT_ADD_REQUESTED(vbo, lnor);
+      }
+    }
+    if (gpu_pos_nor || gpu_lnor) {
+      mesh_extract_gpu_pos_nor_lnor(mr, mbc, gpu_pos_nor, gpu_lnor);
+    }
+  }
+
+#undef EXTRACT_ADD_REQUESTED
+
 #ifdef DEBUG_TIME
   double rdata_end = PIL_check_seconds_timer();
 #endif
 
+  if (extractors.is_empty()) {
+    mesh_render_data_free(mr);
+    return;
+  }
+
   eMRIterType iter_type = extractors.iter_types();
   eMRDataType data_flag = extractors.data_types();
 
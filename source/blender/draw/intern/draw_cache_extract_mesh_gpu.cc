@@ -0,0 +1,347 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup draw
+ *
+ * \brief Extraction of the position and normal buffers of a mesh with compute shaders.
+ *
+ * The CPU extractors write data for every face corner, which is then uploaded to the GPU. Here
+ * only the data per vertex and per face is written and uploaded, and the compute shader gathers
+ * it for every corner. The corner topology is uploaded once and kept in the #MeshBufferCache.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_math_base.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "BKE_mesh.h"
+
+#include "DRW_engine.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_vertex_buffer.h"
+
+#include "draw_cache_extract.hh"
+
+#include "mesh_extractors/extract_mesh.hh"
+
+extern "C" char datatoc_draw_mesh_extract_comp_glsl[];
+
+namespace blender::draw {
+
+/* ---------------------------------------------------------------------- */
+/** \name Shaders
+ * \{ */
+
+enum {
+  SHADER_EXTRACT_POS_NOR,
+  SHADER_EXTRACT_LNOR,
+  SHADER_EXTRACT_LEN,
+};
+
+static GPUShader *g_extract_shaders[SHADER_EXTRACT_LEN] = {nullptr};
+
+static GPUShader *mesh_extract_gpu_shader_get(const int shader_type)
+{
+  if (g_extract_shaders[shader_type] == nullptr) {
+    const bool is_pos_nor = shader_type == SHADER_EXTRACT_POS_NOR;
+    g_extract_shaders[shader_type] = GPU_shader_create_compute(
+        datatoc_draw_mesh_extract_comp_glsl,
+        nullptr,
+        is_pos_nor ? "#define EXTRACT_POS_NOR\n" : nullptr,
+        is_pos_nor ? "mesh_extract_pos_nor" : "mesh_extract_lnor");
+  }
+  return g_extract_shaders[shader_type];
+}
+
+#define EXTRACT_LOCAL_WORK_GROUP_SIZE 64
+
+static void mesh_extract_gpu_dispatch(GPUShader *shader, const int loop_len, const int total_len)
+{
+  GPU_shader_uniform_1i(shader, "loop_len", loop_len);
+  GPU_shader_uniform_1i(shader, "total_len", total_len);
+
+  /* Split the work groups in rows when there are more than supported in one dimension, the
+   * shader computes the index from both dimensions. */
+  const uint max_res_x = uint(GPU_max_work_group_count(0));
+  const uint dispatch_size = divide_ceil_u(uint(total_len), EXTRACT_LOCAL_WORK_GROUP_SIZE);
+  const uint dispatch_rx = min_uu(dispatch_size, max_res_x);
+  const uint dispatch_ry = divide_ceil_u(dispatch_size, dispatch_rx);
+  BLI_assert(dispatch_ry <= uint(GPU_max_work_group_count(1)));
+
+  GPU_compute_dispatch(shader, dispatch_rx, dispatch_ry, 1);
+}
+
+/** \} */
+
+/* ---------------------------------------------------------------------- */
+/** \name Buffers
+ * \{ */
+
+/* Same layout as #PosNorLoop. */
+struct ExtractVertData {
+  float pos[3];
+  GPUPackedNormal nor;
+};
+
+struct ExtractPolyData {
+  GPUPackedNormal nor;
+  uint flag;
+};
+
+/* Keep in sync with `draw_mesh_extract_comp.glsl`. */
+enum {
+  EXTRACT_POLY_SMOOTH = (1 << 0),
+  EXTRACT_POLY_HIDDEN = (1 << 1),
+};
+
+static GPUVertFormat *get_index_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "index", GPU_COMP_U32, 1, GPU_FETCH_INT);
+  }
+  return &format;
+}
+
+static GPUVertFormat *get_vert_data_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "data", GPU_COMP_U32, 4, GPU_FETCH_INT);
+  }
+  return &format;
+}
+
+static GPUVertFormat *get_poly_data_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "data", GPU_COMP_U32, 2, GPU_FETCH_INT);
+  }
+  return &format;
+}
+
+/* Same formats as in #extract_pos_nor_init and #extract_lnor_init. */
+static GPUVertFormat *get_pos_nor_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    GPU_vertformat_alias_add(&format, "vnor");
+  }
+  return &format;
+}
+
+static GPUVertFormat *get_lnor_format()
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    GPU_vertformat_alias_add(&format, "lnor");
+  }
+  return &format;
+}
+
+/**
+ * Upload the vertex and the face of every corner, followed by the vertices of the loose edges and
+ * the loose vertices. These only depend on the topology, so they are kept for the next
+ * extractions.
+ */
+static void mesh_extract_gpu_topology_ensure(const MeshRenderData *mr, MeshBufferCache *mbc)
+{
+  if (mbc->gpu_topology.loop_vert != nullptr) {
+    return;
+  }
+
+  GPUVertBuf *loop_vert = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format(loop_vert, get_index_format());
+  GPU_vertbuf_data_alloc(loop_vert, mr->loop_len + mr->loop_loose_len);
+  uint *loop_vert_data = static_cast<uint *>(GPU_vertbuf_get_data(loop_vert));
+
+  GPUVertBuf *loop_poly = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format(loop_poly, get_index_format());
+  GPU_vertbuf_data_alloc(loop_poly, mr->loop_len);
+  uint *loop_poly_data = static_cast<uint *>(GPU_vertbuf_get_data(loop_poly));
+
+  threading::parallel_for(IndexRange(mr->poly_len), 4096, [&](const IndexRange range) {
+    for (const int poly_index : range) {
+      const MPoly *mp = &mr->mpoly[poly_index];
+      for (const int ml_index : IndexRange(mp->loopstart, mp->totloop)) {
+        loop_vert_data[ml_index] = mr->mloop[ml_index].v;
+        loop_poly_data[ml_index] = uint(poly_index);
+      }
+    }
+  });
+
+  uint *loose_data = loop_vert_data + mr->loop_len;
+  for (int i = 0; i < mr->edge_loose_len; i++) {
+    const MEdge *med = &mr->medge[mr->ledges[i]];
+    *loose_data++ = med->v1;
+    *loose_data++ = med->v2;
+  }
+  for (int i = 0; i < mr->vert_loose_len; i++) {
+    *loose_data++ = uint(mr->lverts[i]);
+  }
+
+  mbc->gpu_topology.loop_vert = loop_vert;
+  mbc->gpu_topology.loop_poly = loop_poly;
+}
+
+static GPUVertBuf *mesh_extract_gpu_vert_data_create(const MeshRenderData *mr)
+{
+  const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mr->me);
+
+  GPUVertBuf *vbo = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format_ex(vbo, get_vert_data_format(), GPU_USAGE_STREAM);
+  GPU_vertbuf_data_alloc(vbo, mr->vert_len);
+  ExtractVertData *vert_data = static_cast<ExtractVertData *>(GPU_vertbuf_get_data(vbo));
+
+  threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+    for (const int v : range) {
+      ExtractVertData &data = vert_data[v];
+      copy_v3_v3(data.pos, mr->mvert[v].co);
+      data.nor = GPU_normal_convert_i10_v3(vert_normals[v]);
+      /* Flag for paint mode overlay, the shader adds the hidden state of the faces. */
+      if ((mr->hide_vert && mr->hide_vert[v]) ||
+          ((mr->v_origindex) && (mr->v_origindex[v] == ORIGINDEX_NONE))) {
+        data.nor.w = -1;
+      }
+      else if (mr->select_vert && mr->select_vert[v]) {
+        data.nor.w = 1;
+      }
+      else {
+        data.nor.w = 0;
+      }
+    }
+  });
+  return vbo;
+}
+
+static GPUVertBuf *mesh_extract_gpu_poly_data_create(const MeshRenderData *mr)
+{
+  const float(*poly_normals)[3] = BKE_mesh_poly_normals_ensure(mr->me);
+
+  GPUVertBuf *vbo = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format_ex(vbo, get_poly_data_format(), GPU_USAGE_STREAM);
+  GPU_vertbuf_data_alloc(vbo, mr->poly_len);
+  ExtractPolyData *poly_data = static_cast<ExtractPolyData *>(GPU_vertbuf_get_data(vbo));
+
+  threading::parallel_for(IndexRange(mr->poly_len), 4096, [&](const IndexRange range) {
+    for (const int poly_index : range) {
+      ExtractPolyData &data = poly_data[poly_index];
+      const bool hidden = mr->hide_poly && mr->hide_poly[poly_index];
+      data.nor = GPU_normal_convert_i10_v3(poly_normals[poly_index]);
+      /* Flag for paint mode overlay, as in #extract_lnor_iter_poly_mesh. */
+      if (hidden) {
+        data.nor.w = -1;
+      }
+      else if (mr->select_poly && mr->select_poly[poly_index]) {
+        data.nor.w = 1;
+      }
+      else {
+        data.nor.w = 0;
+      }
+      data.flag = 0;
+      if (mr->mpoly[poly_index].flag & ME_SMOOTH) {
+        data.flag |= EXTRACT_POLY_SMOOTH;
+      }
+      if (hidden) {
+        data.flag |= EXTRACT_POLY_HIDDEN;
+      }
+    }
+  });
+  return vbo;
+}
+
+/** \} */
+
+}  // namespace blender::draw
+
+/* ---------------------------------------------------------------------- */
+/** \name Extraction
+ * \{ */
+
+bool mesh_extract_gpu_supported(const MeshRenderData *mr)
+{
+  if (!GPU_compute_shader_support() || !GPU_shader_storage_buffer_objects_support()) {
+    return false;
+  }
+  /* Edit-mode data is extracted from the #BMesh, and its flags depend on the edit-mesh. */
+  if (mr->extract_type != MR_EXTRACT_MESH || mr->edit_bmesh != nullptr) {
+    return false;
+  }
+  return mr->loop_len > 0;
+}
+
+void mesh_extract_gpu_pos_nor_lnor(MeshRenderData *mr,
+                                   MeshBufferCache *mbc,
+                                   GPUVertBuf *pos_nor,
+                                   GPUVertBuf *lnor)
+{
+  using namespace blender::draw;
+  BLI_assert(mesh_extract_gpu_supported(mr));
+
+  /* The loose geometry is cached, so this doesn't conflict with the extraction task. */
+  mesh_render_data_update_loose_geom(mr, mbc, MR_ITER_LEDGE | MR_ITER_LVERT, MR_DATA_NONE);
+  mesh_extract_gpu_topology_ensure(mr, mbc);
+
+  GPUVertBuf *vert_data = mesh_extract_gpu_vert_data_create(mr);
+  GPUVertBuf *poly_data = mesh_extract_gpu_poly_data_create(mr);
+
+  if (pos_nor) {
+    const int len = mr->loop_len + mr->loop_loose_len;
+    GPU_vertbuf_init_build_on_device(pos_nor, get_pos_nor_format(), len);
+
+    GPUShader *shader = mesh_extract_gpu_shader_get(SHADER_EXTRACT_POS_NOR);
+    GPU_shader_bind(shader);
+    GPU_vertbuf_bind_as_ssbo(vert_data, 0);
+    GPU_vertbuf_bind_as_ssbo(poly_data, 1);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.loop_vert, 2);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.loop_poly, 3);
+    GPU_vertbuf_bind_as_ssbo(pos_nor, 4);
+    mesh_extract_gpu_dispatch(shader, mr->loop_len, len);
+  }
+
+  if (lnor) {
+    GPU_vertbuf_init_build_on_device(lnor, get_lnor_format(), mr->loop_len);
+
+    GPUShader *shader = mesh_extract_gpu_shader_get(SHADER_EXTRACT_LNOR);
+    GPU_shader_bind(shader);
+    GPU_vertbuf_bind_as_ssbo(vert_data, 0);
+    GPU_vertbuf_bind_as_ssbo(poly_data, 1);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.loop_vert, 2);
+    GPU_vertbuf_bind_as_ssbo(mbc->gpu_topology.loop_poly, 3);
+    GPU_vertbuf_bind_as_ssbo(lnor, 4);
+    mesh_extract_gpu_dispatch(shader, mr->loop_len, mr->loop_len);
+  }
+
+  /* The buffers are used as vertex attributes. */
+  GPU_memory_barrier(GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+  GPU_shader_unbind();
+
+  GPU_vertbuf_discard(vert_data);
+  GPU_vertbuf_discard(poly_data);
+}
+
+void DRW_mesh_extract_gpu_free()
+{
+  using namespace blender::draw;
+  for (int i = 0; i < SHADER_EXTRACT_LEN; i++) {
+    if (g_extract_shaders[i]) {
+      GPU_shader_free(g_extract_shaders[i]);
+      g_extract_shaders[i] = nullptr;
+    }
+  }
+}
@@ -24,6 +24,9 @@
 
 #include "BLI_hash.h"
 #include "BLI_polyfill_2d.h"
+#include "BLI_task.h"
+
+#include "MEM_guardedalloc.h"
 
 #include "draw_cache.h"
 #include "draw_cache_impl.h"
@@ -256,6 +259,9 @@ typedef struct gpIterData {
   gpStrokeVert *verts;
   gpColorVert *cols;
   GPUIndexBufBuilder ibo;
+  /* Visible strokes, in the order of their vertices in the buffers. */
+  bGPDstroke **strokes;
+  int stroke_len;
   int vert_len;
   int tri_len;
   int curve_len;
@@ -379,12 +385,21 @@ static void gpencil_stroke_iter_cb(bGPDlayer *UNUSED(gpl),
                                    void *thunk)
 {
   gpIterData *iter = (gpIterData *)thunk;
-  gpencil_buffer_add_stroke(iter->verts, iter->cols, gps);
+  /* Vertices are written afterwards in parallel, see #gpencil_buffer_add_stroke_fn. */
+  iter->strokes[iter->stroke_len++] = gps;
   if (gps->tot_triangles > 0) {
     gpencil_buffer_add_fill(&iter->ibo, gps);
   }
 }
 
+static void gpencil_buffer_add_stroke_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  gpIterData *iter = (gpIterData *)userdata;
+  gpencil_buffer_add_stroke(iter->verts, iter->cols, iter->strokes[i]);
+}
+
 static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
                                           bGPDframe *UNUSED(gpf),
                                           bGPDstroke *gps,
@@ -395,6 +410,7 @@ static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
   /* Store first index offset */
   gps->runtime.stroke_start = iter->vert_len;
   gps->runtime.fill_start = iter->tri_len;
+  iter->stroke_len++;
   iter->vert_len += gps->totpoints + 2 + gpencil_stroke_is_cyclic(gps);
   iter->tri_len += gps->tot_triangles;
 }
@@ -419,12 +435,16 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
         .gpd = gpd,
         .verts = NULL,
         .ibo = {0},
+        .strokes = NULL,
+        .stroke_len = 0,
         .vert_len = 1, /* Start at 1 for the gl_InstanceID trick to work (see vert shader). */
         .tri_len = 0,
         .curve_len = 0,
     };
     BKE_gpencil_visible_stroke_advanced_iter(
         NULL, ob, NULL, gpencil_object_verts_count_cb, &iter, do_onion, cfra);
+    iter.strokes = MEM_malloc_arrayN(max_ii(iter.stroke_len, 1), sizeof(*iter.strokes), __func__);
+    iter.stroke_len = 0;
 
     /* Create VBOs. */
     GPUVertFormat *format = gpencil_stroke_format();
@@ -443,6 +463,12 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     BKE_gpencil_visible_stroke_advanced_iter(
         NULL, ob, NULL, gpencil_stroke_iter_cb, &iter, do_onion, cfra);
 
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0, iter.stroke_len, &iter, gpencil_buffer_add_stroke_fn, &settings);
+    MEM_freeN(iter.strokes);
+
     /* Mark last 2 verts as invalid. */
     for (int i = 0; i < 2; i++) {
       iter.verts[iter.vert_len + i].mat = -1;
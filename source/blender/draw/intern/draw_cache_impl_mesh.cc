@@ -101,14 +101,14 @@ static constexpr DRWBatchFlag batches_that_use_buffer(const int buffer_index)
 {
   switch (buffer_index) {
     case BUFFER_INDEX(vbo.pos_nor):
-      return MBC_SURFACE | MBC_SURFACE_WEIGHTS | MBC_EDIT_TRIANGLES | MBC_EDIT_VERTICES |
-             MBC_EDIT_EDGES | MBC_EDIT_VNOR | MBC_EDIT_LNOR | MBC_EDIT_MESH_ANALYSIS |
-             MBC_EDIT_SELECTION_VERTS | MBC_EDIT_SELECTION_EDGES | MBC_EDIT_SELECTION_FACES |
-             MBC_ALL_VERTS | MBC_ALL_EDGES | MBC_LOOSE_EDGES | MBC_EDGE_DETECTION |
-             MBC_WIRE_EDGES | MBC_WIRE_LOOPS | MBC_SCULPT_OVERLAYS | MBC_VIEWER_ATTRIBUTE_OVERLAY |
-             MBC_SURFACE_PER_MAT;
+      return MBC_SURFACE | MBC_SURFACE_LOD | MBC_SURFACE_WEIGHTS | MBC_EDIT_TRIANGLES |
+             MBC_EDIT_VERTICES | MBC_EDIT_EDGES | MBC_EDIT_VNOR | MBC_EDIT_LNOR |
+             MBC_EDIT_MESH_ANALYSIS | MBC_EDIT_SELECTION_VERTS | MBC_EDIT_SELECTION_EDGES |
+             MBC_EDIT_SELECTION_FACES | MBC_ALL_VERTS | MBC_ALL_EDGES | MBC_LOOSE_EDGES |
+             MBC_EDGE_DETECTION | MBC_WIRE_EDGES | MBC_WIRE_LOOPS | MBC_SCULPT_OVERLAYS |
+             MBC_VIEWER_ATTRIBUTE_OVERLAY | MBC_SURFACE_PER_MAT;
     case BUFFER_INDEX(vbo.lnor):
-      return MBC_SURFACE | MBC_EDIT_LNOR | MBC_WIRE_LOOPS | MBC_SURFACE_PER_MAT;
+      return MBC_SURFACE | MBC_SURFACE_LOD | MBC_EDIT_LNOR | MBC_WIRE_LOOPS | MBC_SURFACE_PER_MAT;
     case BUFFER_INDEX(vbo.edge_fac):
       return MBC_WIRE_EDGES;
     case BUFFER_INDEX(vbo.weights):
@@ -174,6 +174,8 @@ static constexpr DRWBatchFlag batches_that_use_buffer(const int buffer_index)
       return MBC_SURFACE | MBC_SURFACE_WEIGHTS | MBC_EDIT_TRIANGLES | MBC_EDIT_LNOR |
              MBC_EDIT_MESH_ANALYSIS | MBC_EDIT_SELECTION_FACES | MBC_SCULPT_OVERLAYS |
              MBC_VIEWER_ATTRIBUTE_OVERLAY;
+    case BUFFER_INDEX(ibo.tris_lod):
+      return MBC_SURFACE_LOD;
     case BUFFER_INDEX(ibo.lines):
       return MBC_EDIT_EDGES | MBC_EDIT_SELECTION_EDGES | MBC_ALL_EDGES | MBC_WIRE_EDGES;
     case BUFFER_INDEX(ibo.lines_loose):
@@ -740,6 +742,45 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
   mesh_batch_cache_discard_batch(cache, batch_map);
 }
 
+/**
+ * Discard the buffers that depend on the vertex positions, keeping the index buffers and the
+ * attributes that are still valid when the mesh was only deformed.
+ */
+static void mesh_batch_cache_discard_deformed(MeshBatchCache *cache)
+{
+  if (cache->subdiv_cache) {
+    /* The GPU subdivision is evaluated from the positions of the base mesh. */
+    cache->is_dirty = true;
+    return;
+  }
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.skin_roots);
+  }
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos_nor,
+                                     vbo.lnor,
+                                     vbo.edge_fac,
+                                     vbo.tan,
+                                     vbo.edituv_stretch_area,
+                                     vbo.edituv_stretch_angle,
+                                     vbo.mesh_analysis,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     vbo.skin_roots);
+  mesh_batch_cache_discard_batch(cache, batch_map);
+
+  cache->tot_area = 0.0f;
+  cache->tot_uv_area = 0.0f;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
 {
   MeshBatchCache *cache = static_cast<MeshBatchCache *>(me->runtime.batch_cache);
@@ -788,6 +829,9 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
       batch_map = BATCH_MAP(vbo.edituv_data, vbo.fdots_edituv_data);
       mesh_batch_cache_discard_batch(cache, batch_map);
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_batch_cache_discard_deformed(cache);
+      break;
     default:
       BLI_assert(0);
   }
@@ -814,6 +858,9 @@ static void mesh_buffer_cache_clear(MeshBufferCache *mbc)
   mbc->loose_geom.edge_len = 0;
   mbc->loose_geom.vert_len = 0;
 
+  GPU_VERTBUF_DISCARD_SAFE(mbc->gpu_topology.loop_vert);
+  GPU_VERTBUF_DISCARD_SAFE(mbc->gpu_topology.loop_poly);
+
   MEM_SAFE_FREE(mbc->poly_sorted.tri_first_index);
   MEM_SAFE_FREE(mbc->poly_sorted.mat_tri_len);
   mbc->poly_sorted.visible_tri_len = 0;
@@ -938,6 +985,17 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return cache->batch.surface;
 }
 
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me)
+{
+  /* The simplified triangles are not extracted from the GPU subdivision. */
+  if (BKE_subsurf_modifier_has_gpu_subdiv(me)) {
+    return DRW_mesh_batch_cache_get_surface(me);
+  }
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD);
+  return DRW_batch_request(&cache->batch.surface_lod);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1588,6 +1646,15 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
     }
     drw_add_attributes_vbo(cache->batch.surface, mbuflist, &cache->attr_used);
   }
+  assert_deps_valid(
+      MBC_SURFACE_LOD,
+      {BUFFER_INDEX(ibo.tris_lod), BUFFER_INDEX(vbo.lnor), BUFFER_INDEX(vbo.pos_nor)});
+  if (DRW_batch_requested(cache->batch.surface_lod, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod, &mbuflist->ibo.tris_lod);
+    /* Order matters. First ones override latest VBO's attributes. */
+    DRW_vbo_request(cache->batch.surface_lod, &mbuflist->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod, &mbuflist->vbo.pos_nor);
+  }
   assert_deps_valid(MBC_ALL_VERTS, {BUFFER_INDEX(vbo.pos_nor)});
   if (DRW_batch_requested(cache->batch.all_verts, GPU_PRIM_POINTS)) {
     DRW_vbo_request(cache->batch.all_verts, &mbuflist->vbo.pos_nor);
@@ -1880,6 +1947,7 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
   assert_final_deps_valid(BUFFER_INDEX(vbo.attr_viewer));
 
   assert_final_deps_valid(BUFFER_INDEX(ibo.tris));
+  assert_final_deps_valid(BUFFER_INDEX(ibo.tris_lod));
   assert_final_deps_valid(BUFFER_INDEX(ibo.lines));
   assert_final_deps_valid(BUFFER_INDEX(ibo.lines_loose));
   assert_final_deps_valid(BUFFER_INDEX(ibo.lines_adjacency));
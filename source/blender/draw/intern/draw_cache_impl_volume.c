@@ -302,7 +302,7 @@ static DRWVolumeGrid *volume_grid_cache_get(const Volume *volume,
   const bool was_loaded = BKE_volume_grid_is_loaded(grid);
 
   DenseFloatVolumeGrid dense_grid;
-  if (BKE_volume_grid_dense_floats(volume, grid, &dense_grid)) {
+  if (BKE_volume_grid_dense_floats(volume, grid, GPU_max_texture_3d_size(), &dense_grid)) {
     copy_m4_m4(cache_grid->texture_to_object, dense_grid.texture_to_object);
     invert_m4_m4(cache_grid->object_to_texture, dense_grid.texture_to_object);
 
@@ -314,8 +314,7 @@ static DRWVolumeGrid *volume_grid_cache_get(const Volume *volume,
                                                 format,
                                                 GPU_DATA_FLOAT,
                                                 dense_grid.voxels);
-    /* The texture can be null if the resolution along one axis is larger than
-     * GL_MAX_3D_TEXTURE_SIZE. */
+    /* The texture can still be null when running out of GPU memory. */
     if (cache_grid->texture != NULL) {
       GPU_texture_swizzle_set(cache_grid->texture, (channels == 3) ? "rgb1" : "rrr1");
       GPU_texture_wrap_mode(cache_grid->texture, false, false);
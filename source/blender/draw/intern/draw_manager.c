@@ -14,6 +14,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -406,6 +407,14 @@ DRWData *DRW_viewport_data_create(void)
   return drw_data;
 }
 
+static void drw_render_data_engines_free(DRWData *drw_data)
+{
+  for (int i = 0; i < 2; i++) {
+    DRW_view_data_free(drw_data->view_data[i]);
+    drw_data->view_data[i] = DRW_view_data_create(&g_registered_engines.engines);
+  }
+}
+
 /* Reduce ref count of the textures used by a viewport. */
 static void draw_texture_release(DRWData *drw_data)
 {
@@ -1599,6 +1608,7 @@ struct DRWTextStore *DRW_text_cache_ensure(void)
 
 void DRW_draw_view(const bContext *C)
 {
+  const uint64_t trace_start_time = BLI_trace_event_begin();
   View3D *v3d = CTX_wm_view3d(C);
   if (v3d) {
     Depsgraph *depsgraph = CTX_data_expect_evaluated_depsgraph(C);
@@ -1622,6 +1632,7 @@ void DRW_draw_view(const bContext *C)
     drw_state_prepare_clean_for_draw(&DST);
     DRW_draw_render_loop_2d_ex(depsgraph, region, viewport, C);
   }
+  BLI_trace_event_end("Draw View", trace_start_time);
 }
 
 void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
@@ -1987,6 +1998,14 @@ void DRW_render_to_image(RenderEngine *engine, struct Depsgraph *depsgraph)
 
   const int size[2] = {engine->resolution_x, engine->resolution_y};
 
+  /* Keep the draw data across the frames of an animation render, so that pooled textures,
+   * uniform buffers and pass memory are not allocated again for every frame. */
+  DRWData **render_drw_data = RE_draw_data_get(render);
+  if (*render_drw_data == NULL) {
+    *render_drw_data = DRW_viewport_data_create();
+  }
+  DST.vmempool = *render_drw_data;
+
   drw_manager_init(&DST, NULL, size);
 
   ViewportEngineData *data = DRW_view_data_engine_data_get_ensure(DST.view_data_active,
@@ -2038,6 +2057,11 @@ void DRW_render_to_image(RenderEngine *engine, struct Depsgraph *depsgraph)
 
   DRW_smoke_exit(DST.vmempool);
 
+  /* Engines don't expect data of the previous frame in final renders, only the draw manager data
+   * is kept. */
+  drw_render_data_engines_free(DST.vmempool);
+  DST.vmempool = NULL;
+
   drw_manager_exit(&DST);
 
   /* Reset state after drawing */
@@ -2047,6 +2071,18 @@ void DRW_render_to_image(RenderEngine *engine, struct Depsgraph *depsgraph)
   GPU_render_end();
 }
 
+void DRW_render_data_free(Render *render)
+{
+  DRWData **render_drw_data = RE_draw_data_get(render);
+  if (*render_drw_data == NULL) {
+    return;
+  }
+  DRW_render_context_enable(render);
+  DRW_viewport_data_free(*render_drw_data);
+  *render_drw_data = NULL;
+  DRW_render_context_disable(render);
+}
+
 void DRW_render_object_iter(
     void *vedata,
     RenderEngine *engine,
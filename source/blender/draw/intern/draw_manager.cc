@@ -56,6 +56,10 @@ void Manager::end_sync()
 {
   GPU_debug_group_begin("Manager.end_sync");
 
+  /* Shared between all managers, as views can be submitted with any of them. */
+  static uint64_t sync_counter = 0;
+  sync_id_ = ++sync_counter;
+
   matrix_buf.push_update();
   bounds_buf.push_update();
   infos_buf.push_update();
@@ -132,7 +136,7 @@ void Manager::submit(PassMain &pass, View &view)
   bool freeze_culling = (U.experimental.use_viewport_debug && DST.draw_ctx.v3d &&
                          (DST.draw_ctx.v3d->debug_flag & V3D_DEBUG_FREEZE_CULLING) != 0);
 
-  view.compute_visibility(bounds_buf, resource_len_, freeze_culling);
+  view.compute_visibility(bounds_buf, resource_len_, sync_id_, freeze_culling);
 
   command::RecordingState state;
   state.inverted_view = view.is_inverted();
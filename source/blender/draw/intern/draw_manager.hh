@@ -97,6 +97,8 @@ class Manager {
   uint resource_len_ = 0;
   /** Number of object attribute recorded. */
   uint attribute_len_ = 0;
+  /** Unique identifier of the last sync. Lets views know if the bounds changed. */
+  uint64_t sync_id_ = 0;
 
   Object *object_active = nullptr;
 
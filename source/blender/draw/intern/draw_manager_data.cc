@@ -37,6 +37,8 @@
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #ifdef DRW_DEBUG_CULLING
 #  include "BLI_math_bits.h"
@@ -138,9 +140,9 @@ void drw_resource_buffer_finish(DRWData *vmempool)
 
   DRW_uniform_attrs_pool_flush_all(vmempool->obattrs_ubo_pool);
 
-  /* Aligned alloc to avoid unaligned memcpy. */
-  DRWCommandChunk *chunk_tmp = static_cast<DRWCommandChunk *>(
-      MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, __func__));
+  /* Gather the chunks to sort first, they are independent from each other so they can be sorted
+   * on multiple threads. */
+  blender::Vector<DRWCommandChunk *> sortable_chunks;
   DRWCommandChunk *chunk;
   BLI_memblock_iter iter;
   BLI_memblock_iternew(vmempool->commands, &iter);
@@ -153,10 +155,21 @@ void drw_resource_buffer_finish(DRWData *vmempool)
       }
     }
     if (sortable) {
-      draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
+      sortable_chunks.append(chunk);
     }
   }
-  MEM_freeN(chunk_tmp);
+
+  blender::threading::parallel_for(
+      sortable_chunks.index_range(), 64, [&](const blender::IndexRange range) {
+        /* Aligned alloc to avoid unaligned memcpy. */
+        DRWCommandChunk *chunk_tmp = static_cast<DRWCommandChunk *>(
+            MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, __func__));
+        for (const int i : range) {
+          DRWCommandChunk *chunk = sortable_chunks[i];
+          draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
+        }
+        MEM_freeN(chunk_tmp);
+      });
 }
 
 /** \} */
@@ -13,6 +13,7 @@
 
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_string_utils.h"
 #include "BLI_threads.h"
 
@@ -23,6 +24,7 @@
 #include "DEG_depsgraph_query.h"
 
 #include "GPU_capabilities.h"
+#include "GPU_context.h"
 #include "GPU_material.h"
 #include "GPU_shader.h"
 
@@ -42,6 +44,9 @@ extern char datatoc_common_fullscreen_vert_glsl[];
 
 #define USE_DEFERRED_COMPILATION 1
 
+/** Maximum number of additional contexts compiling the queued materials in parallel. */
+#define DRW_SHADER_COMPILER_MAX_WORKERS 3
+
 /* -------------------------------------------------------------------- */
 /** \name Deferred Compilation (DRW_deferred)
  *
@@ -58,32 +63,28 @@ typedef struct DRWShaderCompiler {
   void *gl_context;
   GPUContext *gpu_context;
   bool own_context;
-} DRWShaderCompiler;
 
-static void drw_deferred_shader_compilation_exec(
-    void *custom_data,
-    /* Cannot be const, this function implements wm_jobs_start_callback.
-     * NOLINTNEXTLINE: readability-non-const-parameter. */
-    short *stop,
-    short *UNUSED(do_update),
-    float *UNUSED(progress))
-{
-  GPU_render_begin();
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
-  GPUContext *gpu_context = comp->gpu_context;
+  /**
+   * Additional contexts, each compiling from the same queue in its own thread.
+   * They are owned together with the main compilation context.
+   */
+  void *worker_gl_contexts[DRW_SHADER_COMPILER_MAX_WORKERS];
+  GPUContext *worker_gpu_contexts[DRW_SHADER_COMPILER_MAX_WORKERS];
+  int workers_len;
 
-  BLI_assert(gl_context != NULL);
-  BLI_assert(gpu_context != NULL);
+  short *stop;
+} DRWShaderCompiler;
 
-  const bool use_main_context_workaround = GPU_use_main_context_workaround();
-  if (use_main_context_workaround) {
-    BLI_assert(gl_context == DST.gl_context);
-    GPU_context_main_lock();
-  }
+typedef struct DRWShaderCompilerWorker {
+  DRWShaderCompiler *comp;
+  void *gl_context;
+  GPUContext *gpu_context;
+} DRWShaderCompilerWorker;
 
-  WM_opengl_context_activate(gl_context);
-  GPU_context_active_set(gpu_context);
+/* Compile materials from the queue until it is empty. */
+static void drw_deferred_shader_compile_queue(DRWShaderCompiler *comp)
+{
+  short *stop = comp->stop;
 
   while (true) {
     if (*stop != 0) {
@@ -118,9 +119,74 @@ static void drw_deferred_shader_compilation_exec(
       GPU_flush();
     }
   }
+}
+
+static void *drw_deferred_shader_compilation_worker_exec(void *custom_data)
+{
+  DRWShaderCompilerWorker *worker = (DRWShaderCompilerWorker *)custom_data;
+
+  GPU_render_begin();
+  WM_opengl_context_activate(worker->gl_context);
+  GPU_context_active_set(worker->gpu_context);
+
+  drw_deferred_shader_compile_queue(worker->comp);
+
+  GPU_context_active_set(NULL);
+  WM_opengl_context_release(worker->gl_context);
+  GPU_render_end();
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(
+    void *custom_data,
+    /* Cannot be const, this function implements wm_jobs_start_callback.
+     * NOLINTNEXTLINE: readability-non-const-parameter. */
+    short *stop,
+    short *UNUSED(do_update),
+    float *UNUSED(progress))
+{
+  GPU_render_begin();
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+  void *gl_context = comp->gl_context;
+  GPUContext *gpu_context = comp->gpu_context;
+
+  BLI_assert(gl_context != NULL);
+  BLI_assert(gpu_context != NULL);
+
+  const bool use_main_context_workaround = GPU_use_main_context_workaround();
+  if (use_main_context_workaround) {
+    BLI_assert(gl_context == DST.gl_context);
+    GPU_context_main_lock();
+  }
+
+  comp->stop = stop;
+
+  /* Compile in the worker contexts alongside this one. */
+  ListBase worker_threads = {NULL, NULL};
+  DRWShaderCompilerWorker workers[DRW_SHADER_COMPILER_MAX_WORKERS];
+  if (comp->workers_len > 0) {
+    BLI_threadpool_init(
+        &worker_threads, drw_deferred_shader_compilation_worker_exec, comp->workers_len);
+    for (int i = 0; i < comp->workers_len; i++) {
+      workers[i].comp = comp;
+      workers[i].gl_context = comp->worker_gl_contexts[i];
+      workers[i].gpu_context = comp->worker_gpu_contexts[i];
+      BLI_threadpool_insert(&worker_threads, &workers[i]);
+    }
+  }
+
+  WM_opengl_context_activate(gl_context);
+  GPU_context_active_set(gpu_context);
+
+  drw_deferred_shader_compile_queue(comp);
 
   GPU_context_active_set(NULL);
   WM_opengl_context_release(gl_context);
+
+  if (comp->workers_len > 0) {
+    BLI_threadpool_end(&worker_threads);
+  }
+
   if (use_main_context_workaround) {
     GPU_context_main_unlock();
   }
@@ -137,6 +203,13 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
 
   if (comp->own_context) {
     /* Only destroy if the job owns the context. */
+    for (int i = 0; i < comp->workers_len; i++) {
+      WM_opengl_context_activate(comp->worker_gl_contexts[i]);
+      GPU_context_active_set(comp->worker_gpu_contexts[i]);
+      GPU_context_discard(comp->worker_gpu_contexts[i]);
+      WM_opengl_context_dispose(comp->worker_gl_contexts[i]);
+    }
+
     WM_opengl_context_activate(comp->gl_context);
     GPU_context_active_set(comp->gpu_context);
     GPU_context_discard(comp->gpu_context);
@@ -201,6 +274,13 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
     if (old_comp->gl_context) {
       comp->gl_context = old_comp->gl_context;
       comp->gpu_context = old_comp->gpu_context;
+      comp->workers_len = old_comp->workers_len;
+      memcpy(comp->worker_gl_contexts,
+             old_comp->worker_gl_contexts,
+             sizeof(comp->worker_gl_contexts));
+      memcpy(comp->worker_gpu_contexts,
+             old_comp->worker_gpu_contexts,
+             sizeof(comp->worker_gpu_contexts));
       old_comp->own_context = false;
       comp->own_context = job_own_context;
     }
@@ -221,6 +301,18 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
       comp->gpu_context = GPU_context_create(NULL, comp->gl_context);
       GPU_context_active_set(NULL);
 
+      /* Compiling is mostly done by the driver on the calling thread, so more contexts let it
+       * use more cores. Keep some cores for drawing, and limit the memory used by contexts. */
+      if (GPU_backend_get_type() == GPU_BACKEND_OPENGL) {
+        comp->workers_len = min_ii(BLI_system_thread_count() / 2 - 1,
+                                   DRW_SHADER_COMPILER_MAX_WORKERS);
+        for (int i = 0; i < comp->workers_len; i++) {
+          comp->worker_gl_contexts[i] = WM_opengl_context_create();
+          comp->worker_gpu_contexts[i] = GPU_context_create(NULL, comp->worker_gl_contexts[i]);
+          GPU_context_active_set(NULL);
+        }
+      }
+
       WM_opengl_context_activate(DST.gl_context);
       GPU_context_active_set(DST.gpu_context);
     }
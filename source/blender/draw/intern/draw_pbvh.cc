@@ -33,6 +33,7 @@
 #include "BKE_subdiv_ccg.h"
 
 #include "GPU_batch.h"
+#include "GPU_capabilities.h"
 
 #include "DRW_engine.h"
 #include "DRW_pbvh.h"
@@ -51,6 +52,7 @@
 #include <vector>
 
 #include <algorithm>
+#include <optional>
 #include <string>
 
 using blender::char3;
@@ -220,6 +222,25 @@ struct PBVHBatches {
     GPU_INDEXBUF_DISCARD_SAFE(lines_index);
   }
 
+  uint64_t memory_usage() const
+  {
+    uint64_t size = 0;
+    for (const PBVHVbo &vbo : vbos) {
+      if (vbo.vert_buf) {
+        size += uint64_t(GPU_vertbuf_get_vertex_alloc(vbo.vert_buf)) *
+                GPU_vertbuf_get_format(vbo.vert_buf)->stride;
+      }
+    }
+    /* Assume 32 bit indices. */
+    if (tri_index) {
+      size += uint64_t(tris_count) * 3 * sizeof(uint);
+    }
+    if (lines_index) {
+      size += uint64_t(lines_count) * 2 * sizeof(uint);
+    }
+    return size;
+  }
+
   string build_key(PBVHAttrReq *attrs, int attrs_num)
   {
     string key;
@@ -1208,6 +1229,26 @@ void DRW_pbvh_node_free(PBVHBatches *batches)
   delete batches;
 }
 
+uint64_t DRW_pbvh_node_gpu_memory_usage(const PBVHBatches *batches)
+{
+  return batches->memory_usage();
+}
+
+uint64_t DRW_pbvh_gpu_memory_budget()
+{
+  static std::optional<uint64_t> budget;
+  if (!budget) {
+    budget = 0;
+    if (GPU_mem_stats_supported()) {
+      int total_kb, free_kb;
+      GPU_mem_stats_get(&total_kb, &free_kb);
+      /* Leave the other half to textures, frame-buffers and other meshes. */
+      budget = uint64_t(total_kb) * 1024 / 2;
+    }
+  }
+  return *budget;
+}
+
 GPUBatch *DRW_pbvh_tris_get(PBVHBatches *batches,
                             PBVHAttrReq *attrs,
                             int attrs_num,
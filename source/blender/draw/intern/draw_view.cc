@@ -37,6 +37,7 @@ void View::sync(const float4x4 &view_mat, const float4x4 &win_mat)
   frustum_culling_sphere_calc(bound_box, bound_sphere);
 
   dirty_ = true;
+  visibility_dirty_ = true;
 }
 
 void View::frustum_boundbox_calc(BoundBox &bbox)
@@ -290,8 +291,18 @@ void View::bind()
   GPU_uniformbuf_bind(data_, DRW_VIEW_UBO_SLOT);
 }
 
-void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool debug_freeze)
+void View::compute_visibility(ObjectBoundsBuf &bounds,
+                              uint resource_len,
+                              uint64_t sync_id,
+                              bool debug_freeze)
 {
+  if (!visibility_dirty_ && visibility_sync_id_ == sync_id && debug_freeze == frozen_) {
+    /* The result of the last computation is still valid. */
+    return;
+  }
+  visibility_dirty_ = false;
+  visibility_sync_id_ = sync_id;
+
   if (debug_freeze && frozen_ == false) {
     data_freeze_ = static_cast<ViewInfos>(data_);
     data_freeze_.push_update();
@@ -305,9 +316,11 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
 
   GPU_debug_group_begin("View.compute_visibility");
 
-  /* TODO(fclem): Early out if visibility hasn't changed. */
-  /* TODO(fclem): Resize to nearest pow2 to reduce fragmentation. */
-  visibility_buf_.resize(divide_ceil_u(resource_len, 128));
+  /* Only grow the buffer, in power of 2 steps to avoid reallocating for every new object. */
+  const uint visibility_len = divide_ceil_u(resource_len, 128);
+  if (visibility_len > visibility_buf_.size()) {
+    visibility_buf_.resize(power_of_2_max_u(visibility_len));
+  }
 
   uint32_t data = 0xFFFFFFFFu;
   GPU_storagebuf_clear(visibility_buf_, GPU_R32UI, GPU_DATA_UINT, &data);
@@ -36,6 +36,10 @@ class View {
   bool do_visibility_ = true;
   bool dirty_ = true;
   bool frozen_ = false;
+  /** True if the culling data changed since the last visibility computation. */
+  bool visibility_dirty_ = true;
+  /** Manager sync the visibility buffer was computed for. */
+  uint64_t visibility_sync_id_ = 0;
 
  public:
   View(const char *name) : visibility_buf_(name), debug_name_(name){};
@@ -81,7 +85,14 @@ class View {
  private:
   /** Called from draw manager. */
   void bind();
-  void compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool debug_freeze);
+  /**
+   * Compute the visibility of every resource. Skipped if neither the view nor the manager data
+   * changed since the last call, as a view is often submitted with multiple passes.
+   */
+  void compute_visibility(ObjectBoundsBuf &bounds,
+                          uint resource_len,
+                          uint64_t sync_id,
+                          bool debug_freeze);
 
   void update_view_vectors();
   void update_viewport_size();
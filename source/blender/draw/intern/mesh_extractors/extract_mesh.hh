@@ -370,6 +370,21 @@ void mesh_render_data_update_looptris(MeshRenderData *mr,
                                       eMRIterType iter_type,
                                       eMRDataType data_flag);
 
+/* draw_cache_extract_mesh_gpu.cc */
+
+/**
+ * Whether the position and normal buffers of this mesh can be extracted with compute shaders.
+ */
+bool mesh_extract_gpu_supported(const MeshRenderData *mr);
+/**
+ * Fill the requested buffers (either can be null) on the GPU from data uploaded per vertex and
+ * per face. Has to run on the main thread as it dispatches compute shaders.
+ */
+void mesh_extract_gpu_pos_nor_lnor(MeshRenderData *mr,
+                                   MeshBufferCache *mbc,
+                                   GPUVertBuf *pos_nor,
+                                   GPUVertBuf *lnor);
+
 /* draw_cache_extract_mesh_extractors.c */
 
 struct EditLoopData {
@@ -401,6 +416,7 @@ void mesh_render_data_loop_edge_flag(const MeshRenderData *mr,
 
 extern const MeshExtract extract_tris;
 extern const MeshExtract extract_tris_single_mat;
+extern const MeshExtract extract_tris_lod;
 extern const MeshExtract extract_lines;
 extern const MeshExtract extract_lines_with_lines_loose;
 extern const MeshExtract extract_lines_loose_only;
@@ -7,8 +7,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_map.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_math_vector.h"
+
 #include "extract_mesh.hh"
 
+#include "draw_cache.h"
 #include "draw_subdivision.h"
 
 namespace blender::draw {
@@ -241,7 +246,139 @@ constexpr MeshExtract create_extractor_tris_single_mat()
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Extract Simplified Triangles Indices
+ *
+ * Level of detail for dense meshes drawn from far away, built with vertex clustering: the
+ * corners are merged per cell of a regular grid, and only the triangles with corners in three
+ * different cells are kept. The remaining triangles use the first corner found in each cell, so
+ * the position and normal buffers of the full mesh can be used.
+ * \{ */
+
+struct MeshExtract_TrisLOD_Data {
+  GPUIndexBufBuilder elb;
+  float3 min;
+  /** Number of cells per unit of distance. */
+  float cell_scale;
+  /** First corner found in each cell. */
+  Map<uint64_t, int> *cell_corners;
+};
+
+static void extract_tris_lod_init(const MeshRenderData *mr,
+                                  MeshBatchCache *UNUSED(cache),
+                                  void *UNUSED(ibo),
+                                  void *tls_data)
+{
+  MeshExtract_TrisLOD_Data *data = static_cast<MeshExtract_TrisLOD_Data *>(tls_data);
+  GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+
+  float3 min(FLT_MAX), max(-FLT_MAX);
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    BM_ITER_MESH (eve, &iter, mr->bm, BM_VERTS_OF_MESH) {
+      minmax_v3v3_v3(min, max, bm_vert_co_get(mr, eve));
+    }
+  }
+  else {
+    for (int v = 0; v < mr->vert_len; v++) {
+      minmax_v3v3_v3(min, max, mr->mvert[v].co);
+    }
+  }
+
+  const float size = max_fff(max.x - min.x, max.y - min.y, max.z - min.z);
+  data->min = min;
+  data->cell_scale = (size > 0.0f) ? DRW_MESH_LOD_GRID_RESOLUTION / size : 0.0f;
+  data->cell_corners = new Map<uint64_t, int>();
+  data->cell_corners->reserve(min_ii(mr->vert_len, DRW_MESH_LOD_GRID_RESOLUTION * 1024));
+}
+
+static int extract_tris_lod_cell_corner(MeshExtract_TrisLOD_Data *data,
+                                        const float co[3],
+                                        const int corner)
+{
+  uint64_t key = 0;
+  for (int i = 0; i < 3; i++) {
+    const int cell = int((co[i] - data->min[i]) * data->cell_scale);
+    key |= uint64_t(clamp_i(cell, 0, DRW_MESH_LOD_GRID_RESOLUTION - 1)) << (i * 20);
+  }
+  return data->cell_corners->lookup_or_add(key, corner);
+}
+
+static void extract_tris_lod_add(MeshExtract_TrisLOD_Data *data, const int corners[3])
+{
+  if (ELEM(corners[0], corners[1], corners[2]) || corners[1] == corners[2]) {
+    /* Collapsed triangle. */
+    return;
+  }
+  GPU_indexbuf_add_tri_verts(&data->elb, corners[0], corners[1], corners[2]);
+}
+
+static void extract_tris_lod_iter_looptri_bm(const MeshRenderData *mr,
+                                             BMLoop **elt,
+                                             const int UNUSED(elt_index),
+                                             void *_data)
+{
+  if (BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
+    return;
+  }
+  MeshExtract_TrisLOD_Data *data = static_cast<MeshExtract_TrisLOD_Data *>(_data);
+  int corners[3];
+  for (int i = 0; i < 3; i++) {
+    corners[i] = extract_tris_lod_cell_corner(
+        data, bm_vert_co_get(mr, elt[i]->v), BM_elem_index_get(elt[i]));
+  }
+  extract_tris_lod_add(data, corners);
+}
+
+static void extract_tris_lod_iter_looptri_mesh(const MeshRenderData *mr,
+                                               const MLoopTri *mlt,
+                                               const int UNUSED(mlt_index),
+                                               void *_data)
+{
+  if (mr->use_hide && mr->hide_poly && mr->hide_poly[mlt->poly]) {
+    return;
+  }
+  MeshExtract_TrisLOD_Data *data = static_cast<MeshExtract_TrisLOD_Data *>(_data);
+  int corners[3];
+  for (int i = 0; i < 3; i++) {
+    const int ml_index = int(mlt->tri[i]);
+    corners[i] = extract_tris_lod_cell_corner(
+        data, mr->mvert[mr->mloop[ml_index].v].co, ml_index);
+  }
+  extract_tris_lod_add(data, corners);
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *UNUSED(mr),
+                                    MeshBatchCache *UNUSED(cache),
+                                    void *buf,
+                                    void *_data)
+{
+  GPUIndexBuf *ibo = static_cast<GPUIndexBuf *>(buf);
+  MeshExtract_TrisLOD_Data *data = static_cast<MeshExtract_TrisLOD_Data *>(_data);
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  delete data->cell_corners;
+}
+
+constexpr MeshExtract create_extractor_tris_lod()
+{
+  MeshExtract extractor = {nullptr};
+  extractor.init = extract_tris_lod_init;
+  extractor.iter_looptri_bm = extract_tris_lod_iter_looptri_bm;
+  extractor.iter_looptri_mesh = extract_tris_lod_iter_looptri_mesh;
+  extractor.finish = extract_tris_lod_finish;
+  extractor.data_type = MR_DATA_NONE;
+  extractor.data_size = sizeof(MeshExtract_TrisLOD_Data);
+  /* The cells are shared by all triangles. */
+  extractor.use_threading = false;
+  extractor.mesh_buffer_offset = offsetof(MeshBufferList, ibo.tris_lod);
+  return extractor;
+}
+
+/** \} */
+
 }  // namespace blender::draw
 
 const MeshExtract extract_tris = blender::draw::create_extractor_tris();
 const MeshExtract extract_tris_single_mat = blender::draw::create_extractor_tris_single_mat();
+const MeshExtract extract_tris_lod = blender::draw::create_extractor_tris_lod();
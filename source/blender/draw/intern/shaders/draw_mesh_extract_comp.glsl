@@ -0,0 +1,100 @@
+
+/**
+ * Extraction of the position and normal buffers of a mesh from data uploaded per vertex and per
+ * face, see `draw_cache_extract_mesh_gpu.cc`. Normals are packed as #GPUPackedNormal, with the
+ * flag used by the overlays stored in the two highest bits.
+ */
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+/* Number of face corners, the loose edges and vertices follow them in the output. */
+uniform int loop_len;
+/* Total number of elements to process. */
+uniform int total_len;
+
+/* Same layout as #PosNorLoop. */
+struct VertData {
+  float x;
+  float y;
+  float z;
+  uint nor;
+};
+
+struct PolyData {
+  uint nor;
+  uint flag;
+};
+
+#define POLY_SMOOTH 1u
+#define POLY_HIDDEN 2u
+
+#define NOR_FLAG_MASK 0xC0000000u
+#define NOR_FLAG_HIDDEN 0xC0000000u
+
+layout(std430, binding = 0) readonly buffer inputVertData
+{
+  VertData vert_data[];
+};
+
+layout(std430, binding = 1) readonly buffer inputPolyData
+{
+  PolyData poly_data[];
+};
+
+layout(std430, binding = 2) readonly buffer inputLoopVert
+{
+  uint loop_vert[];
+};
+
+layout(std430, binding = 3) readonly buffer inputLoopPoly
+{
+  uint loop_poly[];
+};
+
+#ifdef EXTRACT_POS_NOR
+layout(std430, binding = 4) writeonly buffer outputPosNor
+{
+  VertData output_pos_nor[];
+};
+#else
+layout(std430, binding = 4) writeonly buffer outputLoopNormals
+{
+  uint output_lnor[];
+};
+#endif
+
+uint get_global_invocation_index()
+{
+  uint invocations_per_row = gl_WorkGroupSize.x * gl_NumWorkGroups.x;
+  return gl_GlobalInvocationID.x + gl_GlobalInvocationID.y * invocations_per_row;
+}
+
+void main()
+{
+  uint index = get_global_invocation_index();
+  if (index >= uint(total_len)) {
+    return;
+  }
+
+#ifdef EXTRACT_POS_NOR
+  VertData data = vert_data[loop_vert[index]];
+  if (index >= uint(loop_len)) {
+    /* Loose geometry doesn't use the flag. */
+    data.nor &= ~NOR_FLAG_MASK;
+  }
+  else if ((poly_data[loop_poly[index]].flag & POLY_HIDDEN) != 0u) {
+    data.nor = (data.nor & ~NOR_FLAG_MASK) | NOR_FLAG_HIDDEN;
+  }
+  output_pos_nor[index] = data;
+#else
+  PolyData poly = poly_data[loop_poly[index]];
+  if ((poly.flag & POLY_SMOOTH) != 0u) {
+    /* Use the vertex normal with the flag of the face. */
+    uint vert_nor = vert_data[loop_vert[index]].nor;
+    output_lnor[index] = (vert_nor & ~NOR_FLAG_MASK) | (poly.nor & NOR_FLAG_MASK);
+  }
+  else {
+    output_lnor[index] = poly.nor;
+  }
+#endif
+}
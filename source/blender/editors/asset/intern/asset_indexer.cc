@@ -85,14 +85,17 @@ class AbstractFile {
 
   virtual const char *get_file_path() const = 0;
 
-  bool exists() const
-  {
-    return BLI_exists(get_file_path());
-  }
-
-  size_t get_file_size() const
+  /**
+   * Get existence, size and modification time of the file at once. Every file system query
+   * counts when browsing libraries with many files stored on network drives.
+   */
+  std::optional<BLI_stat_t> stat() const
   {
-    return BLI_file_size(get_file_path());
+    BLI_stat_t st;
+    if (BLI_stat(get_file_path(), &st) == -1) {
+      return std::nullopt;
+    }
+    return st;
   }
 };
 
@@ -637,19 +640,19 @@ class AssetIndexFile : public AbstractFile {
   }
 
   /**
-   * Returns whether the index file is older than the given asset file.
+   * Returns whether the index file is older than the asset file, given the stats of both files.
    */
-  bool is_older_than(BlendFile &asset_file) const
+  static bool is_older_than(const BLI_stat_t &index_stat, const BLI_stat_t &asset_file_stat)
   {
-    return BLI_file_older(get_file_path(), asset_file.get_file_path());
+    return index_stat.st_mtime < asset_file_stat.st_mtime;
   }
 
   /**
    * Check whether the index file contains entries without opening the file.
    */
-  bool constains_entries() const
+  bool constains_entries(const BLI_stat_t &index_stat) const
   {
-    const size_t file_size = get_file_size();
+    const size_t file_size = size_t(index_stat.st_size);
     return file_size >= MIN_FILE_SIZE_WITH_ENTRIES;
   }
 
@@ -695,7 +698,8 @@ static eFileIndexerResult read_index(const char *filename,
   BlendFile asset_file(filename);
   AssetIndexFile asset_index_file(library_index, asset_file);
 
-  if (!asset_index_file.exists()) {
+  const std::optional<BLI_stat_t> index_stat = asset_index_file.stat();
+  if (!index_stat) {
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
@@ -705,7 +709,8 @@ static eFileIndexerResult read_index(const char *filename,
    */
   asset_index_file.mark_as_used();
 
-  if (asset_index_file.is_older_than(asset_file)) {
+  const std::optional<BLI_stat_t> asset_file_stat = asset_file.stat();
+  if (asset_file_stat && AssetIndexFile::is_older_than(*index_stat, *asset_file_stat)) {
     CLOG_INFO(
         &LOG,
         3,
@@ -715,7 +720,7 @@ static eFileIndexerResult read_index(const char *filename,
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
-  if (!asset_index_file.constains_entries()) {
+  if (!asset_index_file.constains_entries(*index_stat)) {
     CLOG_INFO(&LOG,
               3,
               "Asset file index is to small to contain any entries. [%s]",
@@ -224,14 +224,16 @@ static bool eyedropper_cryptomatte_sample_image_fl(const bNode *node,
 
   if (image && image->type == IMA_TYPE_MULTILAYER) {
     ImBuf *ibuf = BKE_image_acquire_ibuf(image, iuser, NULL);
-    if (image->rr) {
-      LISTBASE_FOREACH (RenderLayer *, render_layer, &image->rr->layers) {
+    RenderResult *rr = BKE_image_acquire_renderresult(NULL, image);
+    if (rr) {
+      LISTBASE_FOREACH (RenderLayer *, render_layer, &rr->layers) {
         success = eyedropper_cryptomatte_sample_renderlayer_fl(render_layer, prefix, fpos, r_col);
         if (success) {
           break;
         }
       }
     }
+    BKE_image_release_renderresult(NULL, image);
     BKE_image_release_ibuf(image, ibuf, NULL);
   }
   return success;
@@ -6671,23 +6671,20 @@ void uiTemplateCacheFileProcedural(uiLayout *layout, const bContext *C, PointerR
   const struct RenderEngineType *engine_type = CTX_data_engine_type(C);
 
   Scene *scene = CTX_data_scene(C);
-  const bool engine_supports_procedural = RE_engine_supports_alembic_procedural(engine_type,
-                                                                                scene);
+  const bool engine_supports_procedural = RE_engine_supports_alembic_procedural(
+      engine_type, scene, true);
 
   if (!engine_supports_procedural) {
     row = uiLayoutRow(layout, false);
-    /* For Cycles, verify that experimental features are enabled. */
-    if (BKE_scene_uses_cycles(scene) && !BKE_scene_uses_cycles_experimental_features(scene)) {
-      uiItemL(
-          row,
-          TIP_(
-              "The Cycles Alembic Procedural is only available with the experimental feature set"),
-          ICON_INFO);
-    }
-    else {
-      uiItemL(
-          row, TIP_("The active render engine does not have an Alembic Procedural"), ICON_INFO);
-    }
+    uiItemL(row, TIP_("The active render engine does not have an Alembic Procedural"), ICON_INFO);
+  }
+  else if (!RE_engine_supports_alembic_procedural(engine_type, scene, false)) {
+    /* For Cycles, viewport rendering needs experimental features to be enabled. */
+    row = uiLayoutRow(layout, false);
+    uiItemL(row,
+            TIP_("The Cycles Alembic Procedural is only used for final renders, viewport "
+                 "rendering needs the experimental feature set"),
+            ICON_INFO);
   }
 
   row = uiLayoutRow(layout, false);
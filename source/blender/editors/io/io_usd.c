@@ -370,6 +370,8 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
 
   const bool import_instance_proxies = RNA_boolean_get(op->ptr, "import_instance_proxies");
 
+  const bool use_instancing = RNA_boolean_get(op->ptr, "use_instancing");
+
   const bool import_visible_only = RNA_boolean_get(op->ptr, "import_visible_only");
 
   const bool create_collection = RNA_boolean_get(op->ptr, "create_collection");
@@ -401,7 +403,6 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   }
 
   const bool validate_meshes = false;
-  const bool use_instancing = false;
 
   struct USDImportParams params = {.scale = scale,
                                    .is_sequence = is_sequence,
@@ -466,7 +467,10 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   uiItemR(col, ptr, "read_mesh_colors", 0, NULL, ICON_NONE);
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Include"));
   uiItemR(col, ptr, "import_subdiv", 0, IFACE_("Subdivision"), ICON_NONE);
-  uiItemR(col, ptr, "import_instance_proxies", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "use_instancing", 0, NULL, ICON_NONE);
+  uiLayout *row = uiLayoutRow(col, false);
+  uiLayoutSetActive(row, !RNA_boolean_get(ptr, "use_instancing"));
+  uiItemR(row, ptr, "import_instance_proxies", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_visible_only", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_guide", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_proxy", 0, NULL, ICON_NONE);
@@ -483,7 +487,7 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Experimental"));
   uiItemR(col, ptr, "import_usd_preview", 0, NULL, ICON_NONE);
   uiLayoutSetEnabled(col, RNA_boolean_get(ptr, "import_materials"));
-  uiLayout *row = uiLayoutRow(col, true);
+  row = uiLayoutRow(col, true);
   uiItemR(row, ptr, "set_material_blend", 0, NULL, ICON_NONE);
   uiLayoutSetEnabled(row, RNA_boolean_get(ptr, "import_usd_preview"));
 }
@@ -547,6 +551,13 @@ void WM_OT_usd_import(struct wmOperatorType *ot)
                   "Import Instance Proxies",
                   "Create unique Blender objects for USD instances");
 
+  RNA_def_boolean(ot->srna,
+                  "use_instancing",
+                  false,
+                  "Instancing",
+                  "Import every prototype of the USD instances once into a collection, and the "
+                  "instances as collection instances of it");
+
   RNA_def_boolean(ot->srna,
                   "import_visible_only",
                   true,
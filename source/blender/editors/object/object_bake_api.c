@@ -1331,20 +1331,33 @@ static void bake_targets_free(BakeTargets *targets)
 
 /* Main Bake Logic */
 
+/**
+ * We build a depsgraph for the baking,
+ * so we don't need to change the original data to adjust visibility and modifiers.
+ */
+static Depsgraph *bake_depsgraph_new(const BakeAPIRender *bkr)
+{
+  Depsgraph *depsgraph = DEG_graph_new(bkr->main, bkr->scene, bkr->view_layer, DAG_EVAL_RENDER);
+  DEG_graph_build_from_view_layer(depsgraph);
+  return depsgraph;
+}
+
+/**
+ * \param shared_depsgraph: When baking multiple objects one after the other, the depsgraph built
+ * for the first one is reused instead of building and evaluating the whole scene for each object.
+ * Null to use a new depsgraph, which is needed when visibility of evaluated objects is changed.
+ */
 static int bake(const BakeAPIRender *bkr,
                 Object *ob_low,
                 const ListBase *selected_objects,
+                Depsgraph *shared_depsgraph,
                 ReportList *reports)
 {
   Render *re = bkr->render;
   Main *bmain = bkr->main;
   Scene *scene = bkr->scene;
-  ViewLayer *view_layer = bkr->view_layer;
 
-  /* We build a depsgraph for the baking,
-   * so we don't need to change the original data to adjust visibility and modifiers. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_graph_build_from_view_layer(depsgraph);
+  Depsgraph *depsgraph = shared_depsgraph ? shared_depsgraph : bake_depsgraph_new(bkr);
 
   int op_result = OPERATOR_CANCELLED;
   bool ok = false;
@@ -1425,6 +1438,7 @@ static int bake(const BakeAPIRender *bkr,
     if (mmd_low) {
       mmd_flags_low = mmd_low->flags;
       mmd_low->uv_smooth = SUBSURF_UV_SMOOTH_NONE;
+      DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
     }
   }
 
@@ -1699,6 +1713,7 @@ cleanup:
 
   if (mmd_low) {
     mmd_low->flags = mmd_flags_low;
+    DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
   }
 
   if (pixel_array_low) {
@@ -1719,7 +1734,9 @@ cleanup:
     BKE_id_free(NULL, &me_cage_eval->id);
   }
 
-  DEG_graph_free(depsgraph);
+  if (depsgraph != shared_depsgraph) {
+    DEG_graph_free(depsgraph);
+  }
 
   return op_result;
 }
@@ -1834,15 +1851,17 @@ static int bake_exec(bContext *C, wmOperator *op)
   RE_SetReports(re, bkr.reports);
 
   if (bkr.is_selected_to_active) {
-    result = bake(&bkr, bkr.ob, &bkr.selected_objects, bkr.reports);
+    result = bake(&bkr, bkr.ob, &bkr.selected_objects, NULL, bkr.reports);
   }
   else {
     CollectionPointerLink *link;
     bkr.is_clear = bkr.is_clear && BLI_listbase_is_single(&bkr.selected_objects);
+    Depsgraph *depsgraph = bake_depsgraph_new(&bkr);
     for (link = bkr.selected_objects.first; link; link = link->next) {
       Object *ob_iter = link->ptr.data;
-      result = bake(&bkr, ob_iter, NULL, bkr.reports);
+      result = bake(&bkr, ob_iter, NULL, depsgraph, bkr.reports);
     }
+    DEG_graph_free(depsgraph);
   }
 
   RE_SetReports(re, NULL);
@@ -1887,19 +1906,25 @@ static void bake_startjob(void *bkv, short *UNUSED(stop), short *do_update, floa
   }
 
   if (bkr->is_selected_to_active) {
-    bkr->result = bake(bkr, bkr->ob, &bkr->selected_objects, bkr->reports);
+    bkr->result = bake(bkr, bkr->ob, &bkr->selected_objects, NULL, bkr->reports);
   }
   else {
     CollectionPointerLink *link;
     bkr->is_clear = bkr->is_clear && BLI_listbase_is_single(&bkr->selected_objects);
+    Depsgraph *depsgraph = bake_depsgraph_new(bkr);
     for (link = bkr->selected_objects.first; link; link = link->next) {
       Object *ob_iter = link->ptr.data;
-      bkr->result = bake(bkr, ob_iter, NULL, bkr->reports);
+      bkr->result = bake(bkr, ob_iter, NULL, depsgraph, bkr->reports);
 
       if (bkr->result == OPERATOR_CANCELLED) {
-        return;
+        break;
       }
     }
+    DEG_graph_free(depsgraph);
+
+    if (bkr->result == OPERATOR_CANCELLED) {
+      return;
+    }
   }
 
   RE_SetReports(bkr->render, NULL);
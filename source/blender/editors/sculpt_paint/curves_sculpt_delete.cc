@@ -175,28 +175,30 @@ struct DeleteOperationExecutor {
 
     threading::parallel_for(curve_selection_.index_range(), 512, [&](const IndexRange range) {
       for (const int curve_i : curve_selection_.slice(range)) {
+        if (curves_to_delete[curve_i]) {
+          /* Already deleted by another symmetry transform. */
+          continue;
+        }
         const IndexRange points = curves_->points_for_curve(curve_i);
+        const float3 first_pos_cu = brush_transform_inv *
+                                    self_->deformed_positions_[points.first()];
+        float2 prev_pos_re;
+        ED_view3d_project_float_v2_m4(ctx_.region, first_pos_cu, prev_pos_re, projection.values);
         if (points.size() == 1) {
-          const float3 pos_cu = brush_transform_inv * self_->deformed_positions_[points.first()];
-          float2 pos_re;
-          ED_view3d_project_float_v2_m4(ctx_.region, pos_cu, pos_re, projection.values);
-
-          if (math::distance_squared(brush_pos_re_, pos_re) <= brush_radius_sq_re) {
+          if (math::distance_squared(brush_pos_re_, prev_pos_re) <= brush_radius_sq_re) {
             curves_to_delete[curve_i] = true;
           }
           continue;
         }
 
-        for (const int segment_i : points.drop_back(1)) {
-          const float3 pos1_cu = brush_transform_inv * self_->deformed_positions_[segment_i];
-          const float3 pos2_cu = brush_transform_inv * self_->deformed_positions_[segment_i + 1];
-
-          float2 pos1_re, pos2_re;
-          ED_view3d_project_float_v2_m4(ctx_.region, pos1_cu, pos1_re, projection.values);
-          ED_view3d_project_float_v2_m4(ctx_.region, pos2_cu, pos2_re, projection.values);
+        for (const int point_i : points.drop_front(1)) {
+          const float3 pos_cu = brush_transform_inv * self_->deformed_positions_[point_i];
+          float2 pos_re;
+          ED_view3d_project_float_v2_m4(ctx_.region, pos_cu, pos_re, projection.values);
+          BLI_SCOPED_DEFER([&]() { prev_pos_re = pos_re; });
 
           const float dist_sq_re = dist_squared_to_line_segment_v2(
-              brush_pos_re_, pos1_re, pos2_re);
+              brush_pos_re_, prev_pos_re, pos_re);
           if (dist_sq_re <= brush_radius_sq_re) {
             curves_to_delete[curve_i] = true;
             break;
@@ -234,6 +236,10 @@ struct DeleteOperationExecutor {
 
     threading::parallel_for(curve_selection_.index_range(), 512, [&](const IndexRange range) {
       for (const int curve_i : curve_selection_.slice(range)) {
+        if (curves_to_delete[curve_i]) {
+          /* Already deleted by another symmetry transform. */
+          continue;
+        }
         const IndexRange points = curves_->points_for_curve(curve_i);
 
         if (points.size() == 1) {
@@ -367,13 +367,17 @@ struct CurvesEffectOperationExecutor {
 
         float max_move_distance_cu = 0.0f;
         for (const float4x4 &brush_transform_inv : symmetry_brush_transforms_inv) {
-          for (const int segment_i : points.drop_back(1)) {
-            const float3 p1_cu = brush_transform_inv * deformation.positions[segment_i];
-            const float3 p2_cu = brush_transform_inv * deformation.positions[segment_i + 1];
-
-            float2 p1_re, p2_re;
-            ED_view3d_project_float_v2_m4(ctx_.region, p1_cu, p1_re, projection.values);
+          float3 p1_cu = brush_transform_inv * deformation.positions[points.first()];
+          float2 p1_re;
+          ED_view3d_project_float_v2_m4(ctx_.region, p1_cu, p1_re, projection.values);
+          for (const int point_i : points.drop_front(1)) {
+            const float3 p2_cu = brush_transform_inv * deformation.positions[point_i];
+            float2 p2_re;
             ED_view3d_project_float_v2_m4(ctx_.region, p2_cu, p2_re, projection.values);
+            BLI_SCOPED_DEFER([&]() {
+              p1_cu = p2_cu;
+              p1_re = p2_re;
+            });
 
             float2 closest_on_brush_re;
             float2 closest_on_segment_re;
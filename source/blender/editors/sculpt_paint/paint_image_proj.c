@@ -104,7 +104,7 @@
 
 #include "paint_intern.h"
 
-static void partial_redraw_array_init(ImagePaintPartialRedraw *pr);
+static void partial_redraw_array_init(ImagePaintPartialRedraw *pr, int tot);
 
 /* Defines and Structs */
 /* unit_float_to_uchar_clamp as inline function */
@@ -126,8 +126,12 @@ BLI_INLINE uchar f_to_char(const float val)
 #define PROJ_BUCKET_RECT_MIN 4
 #define PROJ_BUCKET_RECT_MAX 256
 
-#define PROJ_BOUNDBOX_DIV 8
-#define PROJ_BOUNDBOX_SQUARED (PROJ_BOUNDBOX_DIV * PROJ_BOUNDBOX_DIV)
+/* Images are split in cells to redraw only the regions that were painted, see
+ * #ProjPaintImage.partRedrawRect. Big images use more cells, so that drawing the updates of a
+ * stroke uploads smaller regions to the GPU. */
+#define PROJ_BOUNDBOX_DIV_MIN 8
+#define PROJ_BOUNDBOX_DIV_MAX 32
+#define PROJ_BOUNDBOX_CELL_SIZE 512
 
 //#define PROJ_DEBUG_PAINT 1
 //#define PROJ_DEBUG_NOSEAMBLEED 1
@@ -198,6 +202,8 @@ typedef struct ProjPaintImage {
   ImageUser iuser;
   ImBuf *ibuf;
   ImagePaintPartialRedraw *partRedrawRect;
+  /** Number of #partRedrawRect cells on each axis of the image. */
+  int partRedrawRect_div;
   /** Only used to build undo tiles during painting. */
   volatile void **undoRect;
   /** The mask accumulation must happen on canvas, not on space screen bucket.
@@ -208,6 +214,11 @@ typedef struct ProjPaintImage {
   bool touch;
 } ProjPaintImage;
 
+BLI_INLINE int proj_paint_image_cells_num(const ProjPaintImage *projIma)
+{
+  return projIma->partRedrawRect_div * projIma->partRedrawRect_div;
+}
+
 /**
  * Handle for stroke (operator customdata)
  */
@@ -460,7 +471,7 @@ typedef struct ProjPixel {
 
   /** if anyone wants to paint onto more than 65535 images they can bite me. */
   ushort image_index;
-  uchar bb_cell_index;
+  ushort bb_cell_index;
 
   /* for various reasons we may want to mask out painting onto this pixel */
   ushort mask;
@@ -1942,9 +1953,9 @@ static ProjPixel *project_paint_uvpixel_init(const ProjPaintState *ps,
   }
 
   /* which bounding box cell are we in?, needed for undo */
-  projPixel->bb_cell_index = ((int)(((float)x_px / (float)ibuf->x) * PROJ_BOUNDBOX_DIV)) +
-                             ((int)(((float)y_px / (float)ibuf->y) * PROJ_BOUNDBOX_DIV)) *
-                                 PROJ_BOUNDBOX_DIV;
+  const int bb_div = projima->partRedrawRect_div;
+  projPixel->bb_cell_index = ((int)(((float)x_px / (float)ibuf->x) * bb_div)) +
+                             ((int)(((float)y_px / (float)ibuf->y) * bb_div)) * bb_div;
 
   /* done with view3d_project_float inline */
   if (ps->tool == PAINT_TOOL_CLONE) {
@@ -4258,9 +4269,13 @@ static void project_paint_build_proj_ima(ProjPaintState *ps,
     }
     size = sizeof(void **) * ED_IMAGE_UNDO_TILE_NUMBER(projIma->ibuf->x) *
            ED_IMAGE_UNDO_TILE_NUMBER(projIma->ibuf->y);
+    projIma->partRedrawRect_div = clamp_i(
+        max_ii(projIma->ibuf->x, projIma->ibuf->y) / PROJ_BOUNDBOX_CELL_SIZE,
+        PROJ_BOUNDBOX_DIV_MIN,
+        PROJ_BOUNDBOX_DIV_MAX);
     projIma->partRedrawRect = BLI_memarena_alloc(
-        arena, sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED);
-    partial_redraw_array_init(projIma->partRedrawRect);
+        arena, sizeof(ImagePaintPartialRedraw) * proj_paint_image_cells_num(projIma));
+    partial_redraw_array_init(projIma->partRedrawRect, proj_paint_image_cells_num(projIma));
     projIma->undoRect = (volatile void **)BLI_memarena_alloc(arena, size);
     memset((void *)projIma->undoRect, 0, size);
     projIma->maskRect = BLI_memarena_alloc(arena, size);
@@ -4648,9 +4663,8 @@ static void partial_redraw_single_init(ImagePaintPartialRedraw *pr)
   BLI_rcti_init_minmax(&pr->dirty_region);
 }
 
-static void partial_redraw_array_init(ImagePaintPartialRedraw *pr)
+static void partial_redraw_array_init(ImagePaintPartialRedraw *pr, int tot)
 {
-  int tot = PROJ_BOUNDBOX_SQUARED;
   while (tot--) {
     partial_redraw_single_init(pr);
     pr++;
@@ -4686,7 +4700,7 @@ static bool project_image_refresh_tagged(ProjPaintState *ps)
   for (a = 0, projIma = ps->projImages; a < ps->image_tot; a++, projIma++) {
     if (projIma->touch) {
       /* look over each bound cell */
-      for (i = 0; i < PROJ_BOUNDBOX_SQUARED; i++) {
+      for (i = 0; i < proj_paint_image_cells_num(projIma); i++) {
         pr = &(projIma->partRedrawRect[i]);
         if (BLI_rcti_is_valid(&pr->dirty_region)) {
           set_imapaintpartial(pr);
@@ -5615,11 +5629,12 @@ static bool project_paint_op(void *state, const float lastpos[2], const float po
 
     /* image bounds */
     for (i = 0; i < ps->image_tot; i++) {
-      handles[a].projImages[i].partRedrawRect = BLI_memarena_alloc(
-          ps->arena_mt[a], sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED);
+      const size_t cells_size = sizeof(ImagePaintPartialRedraw) *
+                                proj_paint_image_cells_num(&ps->projImages[i]);
+      handles[a].projImages[i].partRedrawRect = BLI_memarena_alloc(ps->arena_mt[a], cells_size);
       memcpy(handles[a].projImages[i].partRedrawRect,
              ps->projImages[i].partRedrawRect,
-             sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED);
+             cells_size);
     }
 
     handles[a].pool = image_pool;
@@ -5645,7 +5660,7 @@ static bool project_paint_op(void *state, const float lastpos[2], const float po
     for (a = 0; a < ps->thread_tot; a++) {
       touch |= partial_redraw_array_merge(ps->projImages[i].partRedrawRect,
                                           handles[a].projImages[i].partRedrawRect,
-                                          PROJ_BOUNDBOX_SQUARED);
+                                          proj_paint_image_cells_num(&ps->projImages[i]));
     }
 
     if (touch) {
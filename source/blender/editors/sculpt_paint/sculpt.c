@@ -2405,16 +2405,10 @@ static float brush_strength(const Sculpt *sd,
   }
 }
 
-float SCULPT_brush_strength_factor(SculptSession *ss,
-                                   const Brush *br,
-                                   const float brush_point[3],
-                                   float len,
-                                   const float vno[3],
-                                   const float fno[3],
-                                   float mask,
-                                   const PBVHVertRef vertex,
-                                   const int thread_id,
-                                   AutomaskingNodeData *automask_data)
+static float sculpt_brush_texture_factor(SculptSession *ss,
+                                         const Brush *br,
+                                         const float brush_point[3],
+                                         const int thread_id)
 {
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
@@ -2475,20 +2469,41 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
+  return avg;
+}
+
+/* Remap the distance to the brush center with the brush hardness, before evaluating the falloff
+ * curve. */
+BLI_INLINE float sculpt_brush_hardness_len(const StrokeCache *cache, const float len)
+{
   const float hardness = cache->paint_brush.hardness;
   float p = len / cache->radius;
   if (p < hardness) {
-    final_len = 0.0f;
-  }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
+    return 0.0f;
   }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
+  if (hardness == 1.0f) {
+    return cache->radius;
   }
+  p = (p - hardness) / (1.0f - hardness);
+  return p * cache->radius;
+}
+
+float SCULPT_brush_strength_factor(SculptSession *ss,
+                                   const Brush *br,
+                                   const float brush_point[3],
+                                   float len,
+                                   const float vno[3],
+                                   const float fno[3],
+                                   float mask,
+                                   const PBVHVertRef vertex,
+                                   const int thread_id,
+                                   AutomaskingNodeData *automask_data)
+{
+  StrokeCache *cache = ss->cache;
+  float avg = sculpt_brush_texture_factor(ss, br, brush_point, thread_id);
+
+  /* Hardness. */
+  const float final_len = sculpt_brush_hardness_len(cache, len);
 
   /* Falloff curve. */
   avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
@@ -2503,6 +2518,136 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   return avg;
 }
 
+void SCULPT_brush_node_verts_gather(Object *ob,
+                                    PBVHNode *node,
+                                    SculptBrushTest *test,
+                                    SculptBrushTestFn test_fn,
+                                    const bool use_original,
+                                    SculptBrushNodeVerts *r_verts)
+{
+  SculptSession *ss = ob->sculpt;
+  AutomaskingCache *automasking = ss->cache->automasking;
+
+  int totvert;
+  BKE_pbvh_node_num_verts(ss->pbvh, node, &totvert, NULL);
+
+  memset(r_verts, 0, sizeof(*r_verts));
+  if (totvert == 0) {
+    return;
+  }
+
+  r_verts->node_indices = MEM_malloc_arrayN(totvert, sizeof(int), __func__);
+  r_verts->vertices = MEM_malloc_arrayN(totvert, sizeof(PBVHVertRef), __func__);
+  r_verts->co = MEM_malloc_arrayN(totvert, sizeof(float[3]), __func__);
+  r_verts->no = MEM_malloc_arrayN(totvert, sizeof(float[3]), __func__);
+  r_verts->dist = MEM_malloc_arrayN(totvert, sizeof(float), __func__);
+  r_verts->mask = MEM_malloc_arrayN(totvert, sizeof(float), __func__);
+  r_verts->factors = MEM_malloc_arrayN(totvert, sizeof(float), __func__);
+
+  SculptOrigVertData orig_data;
+  if (use_original) {
+    SCULPT_orig_vert_data_init(&orig_data, ob, node, SCULPT_UNDO_COORDS);
+  }
+
+  AutomaskingNodeData automask_data;
+  SCULPT_automasking_node_begin(ob, ss, automasking, &automask_data, node);
+
+  int i = 0;
+  PBVHVertexIter vd;
+  BKE_pbvh_vertex_iter_begin (ss->pbvh, node, vd, PBVH_ITER_UNIQUE) {
+    const float *co = vd.co;
+    const float *no = vd.no ? vd.no : vd.fno;
+    if (use_original) {
+      SCULPT_orig_vert_data_update(&orig_data, &vd);
+      co = orig_data.co;
+      no = orig_data.no;
+    }
+    if (!test_fn(test, co)) {
+      continue;
+    }
+
+    r_verts->node_indices[i] = vd.i;
+    r_verts->vertices[i] = vd.vertex;
+    copy_v3_v3(r_verts->co[i], co);
+    copy_v3_v3(r_verts->no[i], no);
+    r_verts->dist[i] = sqrtf(test->dist);
+    r_verts->mask[i] = vd.mask ? *vd.mask : 0.0f;
+
+    /* Auto-masking depends on the iterator state, so it can't be deferred. */
+    if (automasking) {
+      SCULPT_automasking_node_update(ss, &automask_data, &vd);
+      r_verts->factors[i] = SCULPT_automasking_factor_get(
+          automasking, ss, vd.vertex, &automask_data);
+    }
+    else {
+      r_verts->factors[i] = 1.0f;
+    }
+    r_verts->tag_normals |= vd.mvert != NULL;
+    i++;
+  }
+  BKE_pbvh_vertex_iter_end;
+
+  r_verts->totvert = i;
+}
+
+void SCULPT_brush_node_verts_strength_factors(SculptSession *ss,
+                                              const Brush *br,
+                                              const int thread_id,
+                                              SculptBrushNodeVerts *verts)
+{
+  StrokeCache *cache = ss->cache;
+  const int totvert = verts->totvert;
+  float *factors = verts->factors;
+  float *dist = verts->dist;
+
+  /* Texture sampling goes through the generic texture code, one vertex at a time. */
+  if (br->mtex.tex) {
+    for (int i = 0; i < totvert; i++) {
+      factors[i] *= sculpt_brush_texture_factor(ss, br, verts->co[i], thread_id);
+    }
+  }
+
+  /* Paint mask. */
+  const float *mask = verts->mask;
+  for (int i = 0; i < totvert; i++) {
+    factors[i] *= 1.0f - mask[i];
+  }
+
+  /* Hardness, the distances are not used afterwards so they are remapped in place. */
+  if (cache->paint_brush.hardness > 0.0f) {
+    for (int i = 0; i < totvert; i++) {
+      dist[i] = sculpt_brush_hardness_len(cache, dist[i]);
+    }
+  }
+
+  /* Falloff curve. */
+  const float radius = cache->radius;
+  for (int i = 0; i < totvert; i++) {
+    factors[i] *= BKE_brush_curve_strength(br, dist[i], radius);
+  }
+
+  if (br->flag & BRUSH_FRONTFACE) {
+    const float *view_normal = cache->view_normal;
+    const float(*no)[3] = (const float(*)[3])verts->no;
+    for (int i = 0; i < totvert; i++) {
+      const float dot = dot_v3v3(no[i], view_normal);
+      factors[i] *= dot > 0.0f ? dot : 0.0f;
+    }
+  }
+}
+
+void SCULPT_brush_node_verts_free(SculptBrushNodeVerts *verts)
+{
+  MEM_SAFE_FREE(verts->node_indices);
+  MEM_SAFE_FREE(verts->vertices);
+  MEM_SAFE_FREE(verts->co);
+  MEM_SAFE_FREE(verts->no);
+  MEM_SAFE_FREE(verts->dist);
+  MEM_SAFE_FREE(verts->mask);
+  MEM_SAFE_FREE(verts->factors);
+  verts->totvert = 0;
+}
+
 bool SCULPT_search_sphere_cb(PBVHNode *node, void *data_v)
 {
   SculptSearchSphereData *data = data_v;
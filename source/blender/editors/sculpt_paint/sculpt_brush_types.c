@@ -292,46 +292,30 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
   const Brush *brush = data->brush;
   const float *offset = data->offset;
 
-  PBVHVertexIter vd;
-  float(*proxy)[3];
-
-  proxy = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
+  float(*proxy)[3] = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
 
   SculptBrushTest test;
   SculptBrushTestFn sculpt_brush_test_sq_fn = SCULPT_brush_test_init_with_falloff_shape(
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
-  AutomaskingNodeData automask_data;
-  SCULPT_automasking_node_begin(
-      data->ob, ss, ss->cache->automasking, &automask_data, data->nodes[n]);
-
-  BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
-    if (!sculpt_brush_test_sq_fn(&test, vd.co)) {
-      continue;
-    }
-
-    SCULPT_automasking_node_update(ss, &automask_data, &vd);
-
-    /* Offset vertex. */
-    const float fade = SCULPT_brush_strength_factor(ss,
-                                                    brush,
-                                                    vd.co,
-                                                    sqrtf(test.dist),
-                                                    vd.no,
-                                                    vd.fno,
-                                                    vd.mask ? *vd.mask : 0.0f,
-                                                    vd.vertex,
-                                                    thread_id,
-                                                    &automask_data);
+  SculptBrushNodeVerts verts;
+  SCULPT_brush_node_verts_gather(
+      data->ob, data->nodes[n], &test, sculpt_brush_test_sq_fn, false, &verts);
+  SCULPT_brush_node_verts_strength_factors(ss, brush, thread_id, &verts);
 
-    mul_v3_v3fl(proxy[vd.i], offset, fade);
+  /* Offset vertices. */
+  for (int i = 0; i < verts.totvert; i++) {
+    mul_v3_v3fl(proxy[verts.node_indices[i]], offset, verts.factors[i]);
+  }
 
-    if (vd.mvert) {
-      BKE_pbvh_vert_tag_update_normal(ss->pbvh, vd.vertex);
+  if (verts.tag_normals) {
+    for (int i = 0; i < verts.totvert; i++) {
+      BKE_pbvh_vert_tag_update_normal(ss->pbvh, verts.vertices[i]);
     }
   }
-  BKE_pbvh_vertex_iter_end;
+
+  SCULPT_brush_node_verts_free(&verts);
 }
 
 void SCULPT_do_draw_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
@@ -2280,49 +2264,30 @@ static void do_draw_sharp_brush_task_cb_ex(void *__restrict userdata,
   const Brush *brush = data->brush;
   const float *offset = data->offset;
 
-  PBVHVertexIter vd;
-  SculptOrigVertData orig_data;
-  float(*proxy)[3];
-
-  SCULPT_orig_vert_data_init(&orig_data, data->ob, data->nodes[n], SCULPT_UNDO_COORDS);
-
-  proxy = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
+  float(*proxy)[3] = BKE_pbvh_node_add_proxy(ss->pbvh, data->nodes[n])->co;
 
   SculptBrushTest test;
   SculptBrushTestFn sculpt_brush_test_sq_fn = SCULPT_brush_test_init_with_falloff_shape(
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
-  AutomaskingNodeData automask_data;
-  SCULPT_automasking_node_begin(
-      data->ob, ss, ss->cache->automasking, &automask_data, data->nodes[n]);
-
-  BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
-    SCULPT_orig_vert_data_update(&orig_data, &vd);
-    if (!sculpt_brush_test_sq_fn(&test, orig_data.co)) {
-      continue;
-    }
-    /* Offset vertex. */
-    SCULPT_automasking_node_update(ss, &automask_data, &vd);
+  SculptBrushNodeVerts verts;
+  SCULPT_brush_node_verts_gather(
+      data->ob, data->nodes[n], &test, sculpt_brush_test_sq_fn, true, &verts);
+  SCULPT_brush_node_verts_strength_factors(ss, brush, thread_id, &verts);
 
-    const float fade = SCULPT_brush_strength_factor(ss,
-                                                    brush,
-                                                    orig_data.co,
-                                                    sqrtf(test.dist),
-                                                    orig_data.no,
-                                                    NULL,
-                                                    vd.mask ? *vd.mask : 0.0f,
-                                                    vd.vertex,
-                                                    thread_id,
-                                                    &automask_data);
-
-    mul_v3_v3fl(proxy[vd.i], offset, fade);
+  /* Offset vertices. */
+  for (int i = 0; i < verts.totvert; i++) {
+    mul_v3_v3fl(proxy[verts.node_indices[i]], offset, verts.factors[i]);
+  }
 
-    if (vd.mvert) {
-      BKE_pbvh_vert_tag_update_normal(ss->pbvh, vd.vertex);
+  if (verts.tag_normals) {
+    for (int i = 0; i < verts.totvert; i++) {
+      BKE_pbvh_vert_tag_update_normal(ss->pbvh, verts.vertices[i]);
     }
   }
-  BKE_pbvh_vertex_iter_end;
+
+  SCULPT_brush_node_verts_free(&verts);
 }
 
 void SCULPT_do_draw_sharp_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
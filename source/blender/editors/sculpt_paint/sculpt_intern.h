@@ -198,6 +198,12 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* Compressed coordinates, colors and masks of pushed undo steps, the arrays are null while
+   * they are packed. */
+  void *packed;
+  size_t packed_size;
+  size_t packed_lens[5];
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -1206,6 +1212,47 @@ float SCULPT_brush_strength_factor(struct SculptSession *ss,
                                    int thread_id,
                                    struct AutomaskingNodeData *automask_data);
 
+/**
+ * Vertices of a PBVH node inside the brush, kept in separate arrays so that their strength
+ * factors can be computed in bulk by #SCULPT_brush_node_verts_strength_factors instead of calling
+ * #SCULPT_brush_strength_factor for each vertex.
+ */
+typedef struct SculptBrushNodeVerts {
+  int totvert;
+  /* Index of the vertices in the node, as #PBVHVertexIter.i, used to write to the proxies. */
+  int *node_indices;
+  PBVHVertRef *vertices;
+  float (*co)[3];
+  /* Vertex normal, or face normal when the PBVH has no vertex normals. */
+  float (*no)[3];
+  float *dist;
+  float *mask;
+  /* Auto-masking factors after gathering, the final strength factors after computing them. */
+  float *factors;
+  /* Normals of the gathered vertices need to be tagged for update. */
+  bool tag_normals;
+} SculptBrushNodeVerts;
+
+/**
+ * Gather the vertices of the node passing the brush test, along with their auto-masking factors.
+ * \param use_original: Test and store the original coordinates and normals of the stroke.
+ */
+void SCULPT_brush_node_verts_gather(struct Object *ob,
+                                    PBVHNode *node,
+                                    SculptBrushTest *test,
+                                    SculptBrushTestFn test_fn,
+                                    bool use_original,
+                                    SculptBrushNodeVerts *r_verts);
+/**
+ * Multiply the gathered factors by the brush texture, mask, falloff curve and front-face
+ * factors, giving the same result as #SCULPT_brush_strength_factor for each vertex.
+ */
+void SCULPT_brush_node_verts_strength_factors(struct SculptSession *ss,
+                                              const struct Brush *br,
+                                              int thread_id,
+                                              SculptBrushNodeVerts *verts);
+void SCULPT_brush_node_verts_free(SculptBrushNodeVerts *verts);
+
 /**
  * Tilts a normal by the x and y tilt values using the view axis.
  */
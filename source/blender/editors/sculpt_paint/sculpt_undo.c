@@ -31,6 +31,8 @@
 
 #include <stddef.h>
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_ghash.h"
@@ -127,6 +129,11 @@ typedef struct UndoSculpt {
   ListBase nodes;
 
   size_t undo_size;
+
+  /* Compresses the node arrays in the background once the step is pushed. */
+  TaskPool *pack_pool;
+  /* The node arrays are compressed, or being compressed by #pack_pool. */
+  bool is_packed;
 } UndoSculpt;
 
 typedef struct SculptAttrRef {
@@ -978,6 +985,214 @@ static void sculpt_undo_restore_list(bContext *C, Depsgraph *depsgraph, ListBase
   MEM_SAFE_FREE(undo_modified_grids);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * The coordinates, colors and masks of the nodes are only read again when undoing or redoing, so
+ * they are compressed in the background once the undo step is pushed, and uncompressed when the
+ * step is decoded or its nodes are accessed again. The compressed size is reported to the undo
+ * system, so the undo memory limit keeps more steps.
+ * \{ */
+
+/* Smaller nodes are not worth compressing. */
+#define SCULPT_UNDO_PACK_MIN_SIZE 4096
+#define SCULPT_UNDO_PACK_LEVEL 1
+
+static int sculpt_undo_node_pack_arrays(SculptUndoNode *unode, void **r_arrays[], int r_strides[])
+{
+  r_arrays[0] = (void **)&unode->co;
+  r_strides[0] = 3;
+  r_arrays[1] = (void **)&unode->orig_co;
+  r_strides[1] = 3;
+  r_arrays[2] = (void **)&unode->col;
+  r_strides[2] = 4;
+  r_arrays[3] = (void **)&unode->loop_col;
+  r_strides[3] = 4;
+  r_arrays[4] = (void **)&unode->mask;
+  r_strides[4] = 1;
+  return ARRAY_SIZE(unode->packed_lens);
+}
+
+/**
+ * XOR each value with the same component of the previous element and split the result in byte
+ * planes. Nearby vertices have similar values, so most of the high bytes become zero and compress
+ * well.
+ */
+static void sculpt_undo_delta_shuffle(const uint32_t *src,
+                                      const size_t len,
+                                      const int stride,
+                                      uint8_t *dst)
+{
+  for (size_t i = 0; i < len; i++) {
+    const uint32_t value = i >= (size_t)stride ? src[i] ^ src[i - stride] : src[i];
+    dst[i] = value & 0xff;
+    dst[len + i] = (value >> 8) & 0xff;
+    dst[len * 2 + i] = (value >> 16) & 0xff;
+    dst[len * 3 + i] = value >> 24;
+  }
+}
+
+static void sculpt_undo_delta_unshuffle(const uint8_t *src,
+                                        const size_t len,
+                                        const int stride,
+                                        uint32_t *dst)
+{
+  for (size_t i = 0; i < len; i++) {
+    const uint32_t value = (uint32_t)src[i] | ((uint32_t)src[len + i] << 8) |
+                           ((uint32_t)src[len * 2 + i] << 16) |
+                           ((uint32_t)src[len * 3 + i] << 24);
+    dst[i] = i >= (size_t)stride ? value ^ dst[i - stride] : value;
+  }
+}
+
+static size_t sculpt_undo_node_packed_saved_size(const SculptUndoNode *unode)
+{
+  size_t raw_size = 0;
+  for (int i = 0; i < ARRAY_SIZE(unode->packed_lens); i++) {
+    raw_size += unode->packed_lens[i];
+  }
+  return raw_size - unode->packed_size;
+}
+
+static void sculpt_undo_node_pack_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  SculptUndoNode *unode = taskdata;
+  void **arrays[ARRAY_SIZE(unode->packed_lens)];
+  int strides[ARRAY_SIZE(unode->packed_lens)];
+  const int arrays_num = sculpt_undo_node_pack_arrays(unode, arrays, strides);
+
+  BLI_assert(unode->packed == NULL);
+  size_t raw_size = 0;
+  for (int i = 0; i < arrays_num; i++) {
+    unode->packed_lens[i] = *arrays[i] ? MEM_allocN_len(*arrays[i]) : 0;
+    raw_size += unode->packed_lens[i];
+  }
+  if (raw_size < SCULPT_UNDO_PACK_MIN_SIZE) {
+    return;
+  }
+
+  uint8_t *filtered = MEM_mallocN(raw_size, __func__);
+  size_t offset = 0;
+  for (int i = 0; i < arrays_num; i++) {
+    if (unode->packed_lens[i]) {
+      sculpt_undo_delta_shuffle(*arrays[i],
+                                unode->packed_lens[i] / sizeof(uint32_t),
+                                strides[i],
+                                filtered + offset);
+      offset += unode->packed_lens[i];
+    }
+  }
+
+  const size_t bound = ZSTD_compressBound(raw_size);
+  void *packed = MEM_mallocN(bound, __func__);
+  const size_t packed_size = ZSTD_compress(
+      packed, bound, filtered, raw_size, SCULPT_UNDO_PACK_LEVEL);
+  MEM_freeN(filtered);
+
+  /* Keep the arrays as they are when compression barely helps. */
+  if (ZSTD_isError(packed_size) || packed_size > raw_size - raw_size / 8) {
+    MEM_freeN(packed);
+    return;
+  }
+
+  unode->packed = MEM_reallocN(packed, packed_size);
+  unode->packed_size = packed_size;
+  for (int i = 0; i < arrays_num; i++) {
+    MEM_SAFE_FREE(*arrays[i]);
+  }
+}
+
+static void sculpt_undo_node_unpack_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  SculptUndoNode *unode = taskdata;
+  void **arrays[ARRAY_SIZE(unode->packed_lens)];
+  int strides[ARRAY_SIZE(unode->packed_lens)];
+  const int arrays_num = sculpt_undo_node_pack_arrays(unode, arrays, strides);
+
+  size_t raw_size = 0;
+  for (int i = 0; i < arrays_num; i++) {
+    raw_size += unode->packed_lens[i];
+  }
+
+  uint8_t *filtered = MEM_mallocN(raw_size, __func__);
+  const size_t size = ZSTD_decompress(filtered, raw_size, unode->packed, unode->packed_size);
+  BLI_assert(!ZSTD_isError(size) && size == raw_size);
+  UNUSED_VARS_NDEBUG(size);
+
+  size_t offset = 0;
+  for (int i = 0; i < arrays_num; i++) {
+    if (unode->packed_lens[i]) {
+      *arrays[i] = MEM_mallocN(unode->packed_lens[i], __func__);
+      sculpt_undo_delta_unshuffle(filtered + offset,
+                                  unode->packed_lens[i] / sizeof(uint32_t),
+                                  strides[i],
+                                  *arrays[i]);
+      offset += unode->packed_lens[i];
+    }
+  }
+  MEM_freeN(filtered);
+
+  MEM_freeN(unode->packed);
+  unode->packed = NULL;
+  unode->packed_size = 0;
+}
+
+/* Start compressing the node arrays of a pushed or decoded undo step in the background. */
+static void sculpt_undo_pack_begin(UndoSculpt *usculpt)
+{
+  BLI_assert(!usculpt->is_packed);
+  if (BLI_listbase_is_empty(&usculpt->nodes)) {
+    return;
+  }
+
+  usculpt->pack_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    BLI_task_pool_push(usculpt->pack_pool, sculpt_undo_node_pack_task, unode, false, NULL);
+  }
+  usculpt->is_packed = true;
+}
+
+/* Wait for the compression to finish and account for the memory it saved. */
+static void sculpt_undo_pack_wait(UndoSculpt *usculpt)
+{
+  if (usculpt->pack_pool == NULL) {
+    return;
+  }
+
+  BLI_task_pool_work_and_wait(usculpt->pack_pool);
+  BLI_task_pool_free(usculpt->pack_pool);
+  usculpt->pack_pool = NULL;
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (unode->packed) {
+      usculpt->undo_size -= sculpt_undo_node_packed_saved_size(unode);
+    }
+  }
+}
+
+/* Ensure the node arrays of the undo step can be accessed. */
+static void sculpt_undo_unpack(UndoSculpt *usculpt)
+{
+  if (!usculpt->is_packed) {
+    return;
+  }
+  sculpt_undo_pack_wait(usculpt);
+
+  TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (unode->packed) {
+      usculpt->undo_size += sculpt_undo_node_packed_saved_size(unode);
+      BLI_task_pool_push(pool, sculpt_undo_node_unpack_task, unode, false, NULL);
+    }
+  }
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  usculpt->is_packed = false;
+}
+
+/** \} */
+
 static void sculpt_undo_free_list(ListBase *lb)
 {
   SculptUndoNode *unode = lb->first;
@@ -1034,6 +1249,10 @@ static void sculpt_undo_free_list(ListBase *lb)
       MEM_freeN(unode->face_sets);
     }
 
+    if (unode->packed) {
+      MEM_freeN(unode->packed);
+    }
+
     MEM_freeN(unode);
 
     unode = unode_next;
@@ -1615,6 +1834,14 @@ void SCULPT_undo_push_begin_ex(Object *ob, const char *name)
     ED_undosys_stack_memfile_id_changed_tag(ustack, ob->data);
   }
 
+  /* Report the compressed size of the previous step before the undo memory limit is applied. */
+  SculptUndoStep *us_prev = (SculptUndoStep *)BKE_undosys_stack_active_with_type(
+      ustack, BKE_UNDOSYS_TYPE_SCULPT);
+  if (us_prev) {
+    sculpt_undo_pack_wait(&us_prev->data);
+    us_prev->step.data_size = us_prev->data.undo_size;
+  }
+
   /* Special case, we never read from this. */
   bContext *C = NULL;
 
@@ -1746,6 +1973,7 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   us->step.data_size = us->data.undo_size;
+  sculpt_undo_pack_begin(&us->data);
 
   SculptUndoNode *unode = us->data.nodes.last;
   if (unode && unode->type == SCULPT_UNDO_DYNTOPO_END) {
@@ -1766,7 +1994,9 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
 {
   BLI_assert(us->step.is_applied == true);
 
+  sculpt_undo_unpack(&us->data);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_pack_begin(&us->data);
   us->step.is_applied = false;
 }
 
@@ -1776,7 +2006,9 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
 {
   BLI_assert(us->step.is_applied == false);
 
+  sculpt_undo_unpack(&us->data);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_pack_begin(&us->data);
   us->step.is_applied = true;
 }
 
@@ -1891,6 +2123,7 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_pack_wait(&us->data);
   sculpt_undo_free_list(&us->data.nodes);
 }
 
@@ -1942,7 +2175,9 @@ static UndoSculpt *sculpt_undo_get_nodes(void)
 {
   UndoStack *ustack = ED_undo_stack_get();
   UndoStep *us = BKE_undosys_stack_init_or_active_with_type(ustack, BKE_UNDOSYS_TYPE_SCULPT);
-  return sculpt_undosys_step_get_nodes(us);
+  UndoSculpt *usculpt = sculpt_undosys_step_get_nodes(us);
+  sculpt_undo_unpack(usculpt);
+  return usculpt;
 }
 
 /** \} */
@@ -1881,6 +1881,46 @@ static std::optional<NodeExtraInfoRow> node_get_accessed_attributes_row(
   return row_from_used_named_attribute(node_log->used_named_attributes);
 }
 
+static const char *execution_time_tooltip = N_(
+    "The execution time from the node tree's latest evaluation. For frame and group nodes, the "
+    "time for all sub-nodes");
+
+/** Profiles are only logged when Blender is started with `--debug-geometry-nodes-profile`. */
+static std::optional<geo_log::NodeProfile> node_get_profile(TreeDrawContext &tree_draw_ctx,
+                                                            const bNode &node)
+{
+  const geo_log::GeoTreeLog *tree_log = tree_draw_ctx.geo_tree_log;
+  if (tree_log == nullptr) {
+    return std::nullopt;
+  }
+  if (node.type == NODE_GROUP_OUTPUT) {
+    return tree_log->profile_sum;
+  }
+  if (const geo_log::GeoNodeLog *node_log = tree_log->nodes.lookup_ptr(node.name)) {
+    return node_log->profile;
+  }
+  return std::nullopt;
+}
+
+struct NodeProfileTooltipArg {
+  geo_log::NodeProfile profile;
+};
+
+static char *node_profile_tooltip(bContext *UNUSED(C), void *argN, const char *UNUSED(tip))
+{
+  const geo_log::NodeProfile &profile = static_cast<NodeProfileTooltipArg *>(argN)->profile;
+  char memory_str[15];
+  BLI_str_format_byte_unit(memory_str, profile.allocated_bytes, false);
+
+  std::stringstream ss;
+  ss << TIP_(execution_time_tooltip) << ".\n\n";
+  ss << TIP_("CPU time: ") << std::fixed << std::setprecision(2)
+     << std::chrono::duration<double, std::milli>(profile.cpu_time).count() << " ms\n";
+  ss << TIP_("Allocated memory: ") << memory_str << "\n";
+  ss << TIP_("Geometry copies: ") << profile.geometry_copies;
+  return BLI_strdup(ss.str().c_str());
+}
+
 static Vector<NodeExtraInfoRow> node_get_extra_info(TreeDrawContext &tree_draw_ctx,
                                                     const SpaceNode &snode,
                                                     const bNode &node)
@@ -1904,9 +1944,15 @@ static Vector<NodeExtraInfoRow> node_get_extra_info(TreeDrawContext &tree_draw_c
     NodeExtraInfoRow row;
     row.text = node_get_execution_time_label(tree_draw_ctx, snode, node);
     if (!row.text.empty()) {
-      row.tooltip = TIP_(
-          "The execution time from the node tree's latest evaluation. For frame and group nodes, "
-          "the time for all sub-nodes");
+      row.tooltip = TIP_(execution_time_tooltip);
+      if (const std::optional<geo_log::NodeProfile> profile = node_get_profile(tree_draw_ctx,
+                                                                                node)) {
+        row.tooltip_fn = node_profile_tooltip;
+        row.tooltip_fn_arg = new NodeProfileTooltipArg{*profile};
+        row.tooltip_fn_free_arg = [](void *arg) {
+          delete static_cast<NodeProfileTooltipArg *>(arg);
+        };
+      }
       row.icon = ICON_PREVIEW_RANGE;
       rows.append(std::move(row));
     }
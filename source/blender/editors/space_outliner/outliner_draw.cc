@@ -2210,11 +2210,16 @@ static void outliner_draw_mode_column_toggle(uiBlock *block,
 
 static void outliner_draw_mode_column(uiBlock *block,
                                       TreeViewContext *tvc,
+                                      const ARegion *region,
                                       SpaceOutliner *space_outliner)
 {
   const bool lock_object_modes = tvc->scene->toolsettings->object_flag & SCE_OBJECT_MODE_LOCK;
 
   tree_iterator::all_open(*space_outliner, [&](TreeElement *te) {
+    /* Only create buttons for visible rows, there may be a lot of objects. */
+    if (!outliner_is_element_in_view(te, &region->v2d)) {
+      return;
+    }
     if (tvc->obact && tvc->obact->mode != OB_MODE_OBJECT) {
       outliner_draw_mode_column_toggle(block, tvc, te, lock_object_modes);
     }
@@ -2290,10 +2295,15 @@ static void outliner_draw_warning_tree_element(uiBlock *block,
 }
 
 static void outliner_draw_warning_column(uiBlock *block,
+                                         const ARegion *region,
                                          const SpaceOutliner *space_outliner,
                                          const bool use_mode_column)
 {
   tree_iterator::all_open(*space_outliner, [&](const TreeElement *te) {
+    if (!outliner_is_element_in_view(te, &region->v2d)) {
+      return;
+    }
+
     /* Get warning for this element, or if there is none and the element is collapsed, the first
      * warning in the collapsed sub-tree. */
     StringRefNull warning_msg = outliner_draw_get_warning_tree_element(*space_outliner, te);
@@ -3632,6 +3642,11 @@ static void outliner_draw_highlights(uint pos,
   tree_iterator::all_open(*space_outliner, [&](const TreeElement *te) {
     const TreeStoreElem *tselem = TREESTORE(te);
     const int start_y = *io_start_y;
+    *io_start_y -= UI_UNIT_Y;
+
+    if (start_y + UI_UNIT_Y < region->v2d.cur.ymin || start_y > region->v2d.cur.ymax) {
+      return;
+    }
 
     /* Selection status. */
     if ((tselem->flag & TSE_ACTIVE) && (tselem->flag & TSE_SELECTED)) {
@@ -3683,8 +3698,6 @@ static void outliner_draw_highlights(uint pos,
         }
       }
     }
-
-    *io_start_y -= UI_UNIT_Y;
   });
 }
 
@@ -3975,12 +3988,12 @@ void draw_outliner(const bContext *C)
 
   /* Draw mode icons */
   if (use_mode_column) {
-    outliner_draw_mode_column(block, &tvc, space_outliner);
+    outliner_draw_mode_column(block, &tvc, region, space_outliner);
   }
 
   /* Draw warning icons */
   if (use_warning_column) {
-    outliner_draw_warning_column(block, space_outliner, use_mode_column);
+    outliner_draw_warning_column(block, region, space_outliner, use_mode_column);
   }
 
   UI_block_emboss_set(block, UI_EMBOSS);
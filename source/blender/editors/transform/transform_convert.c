@@ -15,6 +15,7 @@
 #include "BLI_linklist_stack.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BKE_action.h"
 #include "BKE_anim_data.h"
@@ -168,6 +169,80 @@ static void sort_trans_data_selected_first(TransInfo *t)
   }
 }
 
+/* Location used to compute the proportional editing distance of \a td. */
+static void prop_dist_loc_get(const TransDataContainer *tc,
+                              const TransData *td,
+                              const bool use_island,
+                              const float proj_vec[3],
+                              float r_vec[3])
+{
+  if (use_island) {
+    if (tc->use_local_mat) {
+      mul_v3_m4v3(r_vec, tc->mat, td->iloc);
+    }
+    else {
+      mul_v3_m3v3(r_vec, td->mtx, td->iloc);
+    }
+  }
+  else {
+    if (tc->use_local_mat) {
+      mul_v3_m4v3(r_vec, tc->mat, td->center);
+    }
+    else {
+      mul_v3_m3v3(r_vec, td->mtx, td->center);
+    }
+  }
+
+  if (proj_vec) {
+    float vec_p[3];
+    project_v3_v3v3(vec_p, r_vec, proj_vec);
+    sub_v3_v3(r_vec, vec_p);
+  }
+}
+
+struct PropDistData {
+  const TransDataContainer *tc;
+  const KDTree_3d *td_tree;
+  TransData **td_table;
+  const float *proj_vec;
+  bool use_island;
+  bool with_dist;
+};
+
+static void prop_dist_elem_calc(const struct PropDistData *data, TransData *td)
+{
+  if (td->flag & TD_SELECTED) {
+    return;
+  }
+
+  float vec[3];
+  prop_dist_loc_get(data->tc, td, data->use_island, data->proj_vec, vec);
+
+  KDTreeNearest_3d nearest;
+  const int td_index = BLI_kdtree_3d_find_nearest(data->td_tree, vec, &nearest);
+
+  td->rdist = -1.0f;
+  if (td_index != -1) {
+    td->rdist = nearest.dist;
+    if (data->use_island) {
+      copy_v3_v3(td->center, data->td_table[td_index]->center);
+      copy_m3_m3(td->axismtx, data->td_table[td_index]->axismtx);
+    }
+  }
+
+  if (data->with_dist) {
+    td->dist = td->rdist;
+  }
+}
+
+static void prop_dist_elem_calc_fn(void *__restrict iter_data_v,
+                                   const int iter,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct PropDistData *data = iter_data_v;
+  prop_dist_elem_calc(data, &data->tc->data[iter]);
+}
+
 /**
  * Distance calculated from not-selected vertex to nearest selected vertex.
  */
@@ -220,28 +295,7 @@ static void set_prop_dist(TransInfo *t, const bool with_dist)
         float vec[3];
         td->rdist = 0.0f;
 
-        if (use_island) {
-          if (tc->use_local_mat) {
-            mul_v3_m4v3(vec, tc->mat, td->iloc);
-          }
-          else {
-            mul_v3_m3v3(vec, td->mtx, td->iloc);
-          }
-        }
-        else {
-          if (tc->use_local_mat) {
-            mul_v3_m4v3(vec, tc->mat, td->center);
-          }
-          else {
-            mul_v3_m3v3(vec, td->mtx, td->center);
-          }
-        }
-
-        if (proj_vec) {
-          float vec_p[3];
-          project_v3_v3v3(vec_p, vec, proj_vec);
-          sub_v3_v3(vec, vec_p);
-        }
+        prop_dist_loc_get(tc, td, use_island, proj_vec, vec);
 
         BLI_kdtree_3d_insert(td_tree, td_table_index, vec);
         td_table[td_table_index++] = td;
@@ -256,53 +310,28 @@ static void set_prop_dist(TransInfo *t, const bool with_dist)
 
   BLI_kdtree_3d_balance(td_tree);
 
-  /* For each non-selected vertex, find distance to the nearest selected vertex. */
+  /* For each non-selected vertex, find distance to the nearest selected vertex.
+   * The KD-tree is only read from here, so the look-ups can be threaded. */
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransData *td = tc->data;
-    for (a = 0; a < tc->data_len; a++, td++) {
-      if ((td->flag & TD_SELECTED) == 0) {
-        float vec[3];
-
-        if (use_island) {
-          if (tc->use_local_mat) {
-            mul_v3_m4v3(vec, tc->mat, td->iloc);
-          }
-          else {
-            mul_v3_m3v3(vec, td->mtx, td->iloc);
-          }
-        }
-        else {
-          if (tc->use_local_mat) {
-            mul_v3_m4v3(vec, tc->mat, td->center);
-          }
-          else {
-            mul_v3_m3v3(vec, td->mtx, td->center);
-          }
-        }
-
-        if (proj_vec) {
-          float vec_p[3];
-          project_v3_v3v3(vec_p, vec, proj_vec);
-          sub_v3_v3(vec, vec_p);
-        }
-
-        KDTreeNearest_3d nearest;
-        const int td_index = BLI_kdtree_3d_find_nearest(td_tree, vec, &nearest);
-
-        td->rdist = -1.0f;
-        if (td_index != -1) {
-          td->rdist = nearest.dist;
-          if (use_island) {
-            copy_v3_v3(td->center, td_table[td_index]->center);
-            copy_m3_m3(td->axismtx, td_table[td_index]->axismtx);
-          }
-        }
-
-        if (with_dist) {
-          td->dist = td->rdist;
-        }
+    struct PropDistData data = {
+        .tc = tc,
+        .td_tree = td_tree,
+        .td_table = td_table,
+        .proj_vec = proj_vec,
+        .use_island = use_island,
+        .with_dist = with_dist,
+    };
+    if (tc->data_len < TRANSDATA_THREAD_LIMIT) {
+      TransData *td = tc->data;
+      for (a = 0; a < tc->data_len; a++, td++) {
+        prop_dist_elem_calc(&data, td);
       }
     }
+    else {
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, prop_dist_elem_calc_fn, &settings);
+    }
   }
 
   BLI_kdtree_3d_free(td_tree);
@@ -2030,6 +2030,41 @@ static void tc_mesh_transdata_mirror_apply(TransDataContainer *tc)
   }
 }
 
+/**
+ * The transformed vertices don't change during the transform,
+ * tag them for partial updates of the modifiers.
+ */
+static void tc_mesh_modifier_partial_update(TransDataContainer *tc)
+{
+  BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+
+  if (em->partial_update_verts != NULL) {
+    BKE_editmesh_partial_update_tag(em);
+    return;
+  }
+
+  const int verts_len = tc->data_len + tc->data_mirror_len;
+  if (verts_len >= em->bm->totvert) {
+    /* All vertices change (proportional editing for example). */
+    return;
+  }
+
+  BM_mesh_elem_index_ensure(em->bm, BM_VERT);
+
+  int *verts = MEM_malloc_arrayN(verts_len, sizeof(*verts), __func__);
+  int i;
+  TransData *td;
+  for (i = 0, td = tc->data; i < tc->data_len; i++, td++) {
+    verts[i] = BM_elem_index_get((BMVert *)td->extra);
+  }
+  TransDataMirror *td_mirror = tc->data_mirror;
+  for (i = 0; i < tc->data_mirror_len; i++, td_mirror++) {
+    verts[tc->data_len + i] = BM_elem_index_get((BMVert *)td_mirror->extra);
+  }
+
+  BKE_editmesh_partial_update_set(em, verts, verts_len);
+}
+
 static void recalcData_mesh(TransInfo *t)
 {
   bool is_canceling = t->state == TRANS_CANCEL;
@@ -2060,6 +2095,7 @@ static void recalcData_mesh(TransInfo *t)
     DEG_id_tag_update(tc->obedit->data, ID_RECALC_GEOMETRY);
 
     tc_mesh_partial_update(t, tc, &partial_state);
+    tc_mesh_modifier_partial_update(tc);
   }
 }
 
@@ -2074,6 +2110,10 @@ void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
   const bool is_canceling = (t->state == TRANS_CANCEL);
   const bool use_automerge = !is_canceling && (t->flag & (T_AUTOMERGE | T_AUTOSPLIT)) != 0;
 
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    BKE_editmesh_partial_update_clear(BKE_editmesh_from_object(tc->obedit));
+  }
+
   if (!is_canceling && ELEM(t->mode, TFM_EDGE_SLIDE, TFM_VERT_SLIDE)) {
     /* NOTE(joeedh): Handle multi-res re-projection,
      * done on transform completion since it's really slow. */
@@ -15,6 +15,7 @@
 #include "BLI_math.h"
 #include "BLI_math_vector.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_armature_types.h"
 #include "DNA_curve_types.h"
@@ -48,6 +49,7 @@ using blender::float3;
 using blender::float4x4;
 using blender::Map;
 using blender::Span;
+using blender::Vector;
 
 /* -------------------------------------------------------------------- */
 /** \name Internal Data Types
@@ -129,6 +131,14 @@ struct SnapData_EditMesh {
 #endif
 };
 
+/* An object to snap to, as gathered by #iter_snap_objects. */
+struct SnapObjectTarget {
+  Object *ob_eval;
+  /* Owned by the object or by the dupli-list of its instancer. */
+  const float (*obmat)[4];
+  bool is_object_active;
+};
+
 struct SnapObjectContext {
   Scene *scene;
 
@@ -161,6 +171,16 @@ struct SnapObjectContext {
     eSnapMode snap_to_flag;
     bool has_occlusion_plane; /* Ignore plane of occlusion in curves. */
   } runtime;
+
+  /* Objects to snap to, gathered once for all the snapping passes of a single query, so that the
+   * view layer bases and dupli-lists are not iterated again by each pass. */
+  struct {
+    bool use_cache;
+    bool is_valid;
+    eSnapTargetSelect snap_target_select;
+    Vector<SnapObjectTarget> targets;
+    Vector<ListBase *> duplilists;
+  } targets_cache;
 };
 
 /** \} */
@@ -535,17 +555,44 @@ static bool snap_object_is_snappable(const SnapObjectContext *sctx,
   return true;
 }
 
+static void snap_targets_cache_clear(SnapObjectContext *sctx)
+{
+  for (ListBase *lb : sctx->targets_cache.duplilists) {
+    free_object_duplilist(lb);
+  }
+  sctx->targets_cache.duplilists.clear();
+  sctx->targets_cache.targets.clear();
+  sctx->targets_cache.is_valid = false;
+}
+
 /**
- * Walks through all objects in the scene to create the list of objects to snap.
+ * Gather the objects to snap to once for all following #iter_snap_objects calls, until
+ * #snap_targets_cache_end. Objects must not be evaluated again in-between.
  */
-static void iter_snap_objects(SnapObjectContext *sctx,
-                              const SnapObjectParams *params,
-                              IterSnapObjsCallback sob_callback,
-                              void *data)
+static void snap_targets_cache_begin(SnapObjectContext *sctx)
+{
+  BLI_assert(!sctx->targets_cache.use_cache);
+  sctx->targets_cache.use_cache = true;
+}
+
+static void snap_targets_cache_end(SnapObjectContext *sctx)
 {
+  snap_targets_cache_clear(sctx);
+  sctx->targets_cache.use_cache = false;
+}
+
+/* Walks through all objects in the scene to create the list of objects to snap. */
+static void snap_targets_cache_ensure(SnapObjectContext *sctx,
+                                      const eSnapTargetSelect snap_target_select)
+{
+  if (sctx->targets_cache.is_valid &&
+      sctx->targets_cache.snap_target_select == snap_target_select) {
+    return;
+  }
+  snap_targets_cache_clear(sctx);
+
   Scene *scene = DEG_get_input_scene(sctx->runtime.depsgraph);
   ViewLayer *view_layer = DEG_get_input_view_layer(sctx->runtime.depsgraph);
-  const eSnapTargetSelect snap_target_select = params->snap_target_select;
   BKE_view_layer_synced_ensure(scene, view_layer);
   Base *base_act = BKE_view_layer_active_base_get(view_layer);
 
@@ -560,12 +607,32 @@ static void iter_snap_objects(SnapObjectContext *sctx,
       ListBase *lb = object_duplilist(sctx->runtime.depsgraph, sctx->scene, obj_eval);
       LISTBASE_FOREACH (DupliObject *, dupli_ob, lb) {
         BLI_assert(DEG_is_evaluated_object(dupli_ob->ob));
-        sob_callback(sctx, params, dupli_ob->ob, dupli_ob->mat, is_object_active, data);
+        sctx->targets_cache.targets.append({dupli_ob->ob, dupli_ob->mat, is_object_active});
       }
-      free_object_duplilist(lb);
+      sctx->targets_cache.duplilists.append(lb);
     }
 
-    sob_callback(sctx, params, obj_eval, obj_eval->obmat, is_object_active, data);
+    sctx->targets_cache.targets.append({obj_eval, obj_eval->obmat, is_object_active});
+  }
+
+  sctx->targets_cache.snap_target_select = snap_target_select;
+  sctx->targets_cache.is_valid = true;
+}
+
+/**
+ * Calls \a sob_callback for each object to snap to.
+ */
+static void iter_snap_objects(SnapObjectContext *sctx,
+                              const SnapObjectParams *params,
+                              IterSnapObjsCallback sob_callback,
+                              void *data)
+{
+  snap_targets_cache_ensure(sctx, params->snap_target_select);
+  for (const SnapObjectTarget &target : sctx->targets_cache.targets) {
+    sob_callback(sctx, params, target.ob_eval, target.obmat, target.is_object_active, data);
+  }
+  if (!sctx->targets_cache.use_cache) {
+    snap_targets_cache_clear(sctx);
   }
 }
 
@@ -3594,22 +3661,25 @@ eSnapMode ED_transform_snap_object_project_view3d_ex(SnapObjectContext *sctx,
                                                      float r_obmat[4][4],
                                                      float r_face_nor[3])
 {
-  return transform_snap_context_project_view3d_mixed_impl(sctx,
-                                                          depsgraph,
-                                                          region,
-                                                          v3d,
-                                                          snap_to,
-                                                          params,
-                                                          init_co,
-                                                          mval,
-                                                          prev_co,
-                                                          dist_px,
-                                                          r_loc,
-                                                          r_no,
-                                                          r_index,
-                                                          r_ob,
-                                                          r_obmat,
-                                                          r_face_nor);
+  snap_targets_cache_begin(sctx);
+  const eSnapMode snap_elem = transform_snap_context_project_view3d_mixed_impl(sctx,
+                                                                              depsgraph,
+                                                                              region,
+                                                                              v3d,
+                                                                              snap_to,
+                                                                              params,
+                                                                              init_co,
+                                                                              mval,
+                                                                              prev_co,
+                                                                              dist_px,
+                                                                              r_loc,
+                                                                              r_no,
+                                                                              r_index,
+                                                                              r_ob,
+                                                                              r_obmat,
+                                                                              r_face_nor);
+  snap_targets_cache_end(sctx);
+  return snap_elem;
 }
 
 eSnapMode ED_transform_snap_object_project_view3d(SnapObjectContext *sctx,
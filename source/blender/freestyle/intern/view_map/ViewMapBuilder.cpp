@@ -26,6 +26,8 @@
 
 #include "BKE_global.h"
 
+#include "BLI_task.hh"
+
 namespace Freestyle {
 
 // XXX Grmll... G is used as template's typename parameter :/
@@ -409,6 +411,53 @@ static int computeVisibility(ViewMap *viewMap,
   return qi;
 }
 
+// computeVisibility only reads the grid and the winged edge structure, so the view edges can be
+// processed from multiple threads, as long as the boundary flags of the vertices (which are
+// computed lazily) were set before, see ensureVertexBoundaryFlags.
+//
+// The render monitor is only used from the calling thread, between batches of view edges.
+template<typename Func>
+static void parallelForViewEdges(vector<ViewEdge *> &vedges,
+                                 RenderMonitor *iRenderMonitor,
+                                 bool reportProgress,
+                                 const Func &func)
+{
+  const int64_t size = int64_t(vedges.size());
+  const int64_t batch_size = std::max<int64_t>(int64_t(ceil(0.01 * size)), 256);
+  int64_t count = 0;
+  while (count < size) {
+    if (iRenderMonitor) {
+      if (iRenderMonitor->testBreak()) {
+        break;
+      }
+      if (reportProgress) {
+        stringstream ss;
+        ss << "Freestyle: Visibility computations " << (100 * count / size) << "%";
+        iRenderMonitor->setInfo(ss.str());
+        iRenderMonitor->progress(float(count) / size);
+      }
+    }
+    const blender::IndexRange batch(count, std::min(batch_size, size - count));
+    blender::threading::parallel_for(batch, 16, func);
+    count += batch.size();
+  }
+  if (iRenderMonitor && reportProgress && size > 0) {
+    stringstream ss;
+    ss << "Freestyle: Visibility computations " << (100 * count / size) << "%";
+    iRenderMonitor->setInfo(ss.str());
+    iRenderMonitor->progress(float(count) / size);
+  }
+}
+
+static void ensureVertexBoundaryFlags(WingedEdge &we)
+{
+  for (WShape *wshape : we.getWShapes()) {
+    for (WVertex *wvertex : wshape->getVertexList()) {
+      wvertex->isBoundary();
+    }
+  }
+}
+
 // computeCumulativeVisibility returns the lowest x such that the majority of FEdges have QI <= x
 //
 // This was probably the original intention of the "normal" algorithm on which
@@ -426,205 +475,190 @@ static void computeCumulativeVisibility(ViewMap *ioViewMap,
 {
   vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
 
-  FEdge *fe, *festart;
-  int nSamples = 0;
-  vector<WFace *> wFaces;
-  WFace *wFace = nullptr;
-  uint count = 0;
-  uint count_step = uint(ceil(0.01f * vedges.size()));
-  uint tmpQI = 0;
-  uint qiClasses[256];
-  uint maxIndex, maxCard;
-  uint qiMajority;
-  for (vector<ViewEdge *>::iterator ve = vedges.begin(), veend = vedges.end(); ve != veend; ve++) {
-    if (iRenderMonitor) {
-      if (iRenderMonitor->testBreak()) {
-        break;
-      }
-      if (count % count_step == 0) {
-        stringstream ss;
-        ss << "Freestyle: Visibility computations " << (100 * count / vedges.size()) << "%";
-        iRenderMonitor->setInfo(ss.str());
-        iRenderMonitor->progress(float(count) / vedges.size());
-      }
-      count++;
-    }
-#if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "Processing ViewEdge " << (*ve)->getId() << endl;
-    }
-#endif
-    // Find an edge to test
-    if (!(*ve)->isInImage()) {
-      // This view edge has been proscenium culled
-      (*ve)->setQI(255);
-      (*ve)->setaShape(nullptr);
+  parallelForViewEdges(vedges, iRenderMonitor, true, [&](const blender::IndexRange range) {
+    FEdge *fe, *festart;
+    int nSamples = 0;
+    vector<WFace *> wFaces;
+    WFace *wFace = nullptr;
+    uint tmpQI = 0;
+    uint qiClasses[256];
+    uint maxIndex, maxCard;
+    uint qiMajority;
+    for (vector<ViewEdge *>::iterator ve = vedges.begin() + range.first(),
+                                      veend = vedges.begin() + range.one_after_last();
+         ve != veend;
+         ve++) {
 #if LOGGING
       if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "\tCulled." << endl;
+        cout << "Processing ViewEdge " << (*ve)->getId() << endl;
       }
 #endif
-      continue;
-    }
-
-    // Test edge
-    festart = (*ve)->fedgeA();
-    fe = (*ve)->fedgeA();
-    qiMajority = 0;
-    do {
-      if (fe != nullptr && fe->isInImage()) {
-        qiMajority++;
+      // Find an edge to test
+      if (!(*ve)->isInImage()) {
+        // This view edge has been proscenium culled
+        (*ve)->setQI(255);
+        (*ve)->setaShape(nullptr);
+#if LOGGING
+        if (_global.debug & G_DEBUG_FREESTYLE) {
+          cout << "\tCulled." << endl;
+        }
+#endif
+        continue;
       }
-      fe = fe->nextEdge();
-    } while (fe && fe != festart);
 
-    if (qiMajority == 0) {
-      // There are no occludable FEdges on this ViewEdge
-      // This should be impossible.
-      if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
+      // Test edge
+      festart = (*ve)->fedgeA();
+      fe = (*ve)->fedgeA();
+      qiMajority = 0;
+      do {
+        if (fe != nullptr && fe->isInImage()) {
+          qiMajority++;
+        }
+        fe = fe->nextEdge();
+      } while (fe && fe != festart);
+
+      if (qiMajority == 0) {
+        // There are no occludable FEdges on this ViewEdge
+        // This should be impossible.
+        if (_global.debug & G_DEBUG_FREESTYLE) {
+          cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
+        }
+        // We can recover from this error:
+        // Treat this edge as fully visible with no occludee
+        (*ve)->setQI(0);
+        (*ve)->setaShape(nullptr);
+        continue;
       }
-      // We can recover from this error:
-      // Treat this edge as fully visible with no occludee
-      (*ve)->setQI(0);
-      (*ve)->setaShape(nullptr);
-      continue;
-    }
 
-    ++qiMajority;
-    qiMajority >>= 1;
+      ++qiMajority;
+      qiMajority >>= 1;
 
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tqiMajority: " << qiMajority << endl;
-    }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tqiMajority: " << qiMajority << endl;
+      }
 #endif
 
-    tmpQI = 0;
-    maxIndex = 0;
-    maxCard = 0;
-    nSamples = 0;
-    memset(qiClasses, 0, 256 * sizeof(*qiClasses));
-    set<ViewShape *> foundOccluders;
+      tmpQI = 0;
+      maxIndex = 0;
+      maxCard = 0;
+      nSamples = 0;
+      memset(qiClasses, 0, 256 * sizeof(*qiClasses));
+      set<ViewShape *> foundOccluders;
 
-    fe = (*ve)->fedgeA();
-    do {
-      if (!fe || !fe->isInImage()) {
-        fe = fe->nextEdge();
-        continue;
-      }
-      if (maxCard < qiMajority) {
-        // ARB: change &wFace to wFace and use reference in called function
-        tmpQI = computeVisibility<G, I>(
-            ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
-#if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: visibility " << tmpQI << endl;
+      fe = (*ve)->fedgeA();
+      do {
+        if (!fe || !fe->isInImage()) {
+          fe = fe->nextEdge();
+          continue;
         }
+        if (maxCard < qiMajority) {
+          // ARB: change &wFace to wFace and use reference in called function
+          tmpQI = computeVisibility<G, I>(
+              ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
+#if LOGGING
+          if (_global.debug & G_DEBUG_FREESTYLE) {
+            cout << "\tFEdge: visibility " << tmpQI << endl;
+          }
 #endif
 
-        // ARB: This is an error condition, not an alert condition.
-        // Some sort of recovery or abort is necessary.
-        if (tmpQI >= 256) {
-          cerr << "Warning: too many occluding levels" << endl;
-          // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
-          tmpQI = 255;
-        }
+          // ARB: This is an error condition, not an alert condition.
+          // Some sort of recovery or abort is necessary.
+          if (tmpQI >= 256) {
+            cerr << "Warning: too many occluding levels" << endl;
+            // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
+            tmpQI = 255;
+          }
 
-        if (++qiClasses[tmpQI] > maxCard) {
-          maxCard = qiClasses[tmpQI];
-          maxIndex = tmpQI;
+          if (++qiClasses[tmpQI] > maxCard) {
+            maxCard = qiClasses[tmpQI];
+            maxIndex = tmpQI;
+          }
         }
-      }
-      else {
-        // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
-        // ARB: change &wFace to wFace and use reference in called function
-        findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
+        else {
+          // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
+          // ARB: change &wFace to wFace and use reference in called function
+          findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
-               << endl;
-        }
+          if (_global.debug & G_DEBUG_FREESTYLE) {
+            cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
+                 << endl;
+          }
 #endif
-      }
-
-      // Store test results
-      if (wFace) {
-        vector<Vec3r> vertices;
-        for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
-          vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
         }
-        Polygon3r poly(vertices, wFace->GetNormal());
-        poly.userdata = (void *)wFace;
-        fe->setaFace(poly);
-        wFaces.push_back(wFace);
-        fe->setOccludeeEmpty(false);
+
+        // Store test results
+        if (wFace) {
+          vector<Vec3r> vertices;
+          for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
+            vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
+          }
+          Polygon3r poly(vertices, wFace->GetNormal());
+          poly.userdata = (void *)wFace;
+          fe->setaFace(poly);
+          wFaces.push_back(wFace);
+          fe->setOccludeeEmpty(false);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFound occludee" << endl;
-        }
+          if (_global.debug & G_DEBUG_FREESTYLE) {
+            cout << "\tFound occludee" << endl;
+          }
 #endif
-      }
-      else {
-        fe->setOccludeeEmpty(true);
-      }
+        }
+        else {
+          fe->setOccludeeEmpty(true);
+        }
 
-      ++nSamples;
-      fe = fe->nextEdge();
-    } while ((maxCard < qiMajority) && (fe) && (fe != festart));
+        ++nSamples;
+        fe = fe->nextEdge();
+      } while ((maxCard < qiMajority) && (fe) && (fe != festart));
 
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
-    }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
+      }
 #endif
 
-    // ViewEdge
-    // qi --
-    // Find the minimum value that is >= the majority of the QI
-    for (uint count = 0, i = 0; i < 256; ++i) {
-      count += qiClasses[i];
-      if (count >= qiMajority) {
-        (*ve)->setQI(i);
-        break;
+      // ViewEdge
+      // qi --
+      // Find the minimum value that is >= the majority of the QI
+      for (uint count = 0, i = 0; i < 256; ++i) {
+        count += qiClasses[i];
+        if (count >= qiMajority) {
+          (*ve)->setQI(i);
+          break;
+        }
+      }
+      // occluders --
+      // I would rather not have to go through the effort of creating this set and then copying out
+      // its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
+      for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
+           o != oend;
+           ++o) {
+        (*ve)->AddOccluder(*o);
       }
-    }
-    // occluders --
-    // I would rather not have to go through the effort of creating this set and then copying out
-    // its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
-    for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
-         o != oend;
-         ++o) {
-      (*ve)->AddOccluder(*o);
-    }
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size() << " occluders."
-           << endl;
-    }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size()
+             << " occluders." << endl;
+      }
 #else
-    (void)maxIndex;
+      (void)maxIndex;
 #endif
-    // occludee --
-    if (!wFaces.empty()) {
-      if (wFaces.size() <= float(nSamples) / 2.0f) {
-        (*ve)->setaShape(nullptr);
-      }
-      else {
-        ViewShape *vshape = ioViewMap->viewShape(
-            (*wFaces.begin())->GetVertex(0)->shape()->GetId());
-        (*ve)->setaShape(vshape);
+      // occludee --
+      if (!wFaces.empty()) {
+        if (wFaces.size() <= float(nSamples) / 2.0f) {
+          (*ve)->setaShape(nullptr);
+        }
+        else {
+          ViewShape *vshape = ioViewMap->viewShape(
+              (*wFaces.begin())->GetVertex(0)->shape()->GetId());
+          (*ve)->setaShape(vshape);
+        }
       }
-    }
 
-    wFaces.clear();
-  }
-  if (iRenderMonitor && !vedges.empty()) {
-    stringstream ss;
-    ss << "Freestyle: Visibility computations " << (100 * count / vedges.size()) << "%";
-    iRenderMonitor->setInfo(ss.str());
-    iRenderMonitor->progress(float(count) / vedges.size());
-  }
+      wFaces.clear();
+    }
+  });
 }
 
 template<typename G, typename I>
@@ -635,179 +669,182 @@ static void computeDetailedVisibility(ViewMap *ioViewMap,
 {
   vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
 
-  FEdge *fe, *festart;
-  int nSamples = 0;
-  vector<WFace *> wFaces;
-  WFace *wFace = nullptr;
-  uint tmpQI = 0;
-  uint qiClasses[256];
-  uint maxIndex, maxCard;
-  uint qiMajority;
-  for (vector<ViewEdge *>::iterator ve = vedges.begin(), veend = vedges.end(); ve != veend; ve++) {
-    if (iRenderMonitor && iRenderMonitor->testBreak()) {
-      break;
-    }
-#if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "Processing ViewEdge " << (*ve)->getId() << endl;
-    }
-#endif
-    // Find an edge to test
-    if (!(*ve)->isInImage()) {
-      // This view edge has been proscenium culled
-      (*ve)->setQI(255);
-      (*ve)->setaShape(nullptr);
+  parallelForViewEdges(vedges, iRenderMonitor, false, [&](const blender::IndexRange range) {
+    FEdge *fe, *festart;
+    int nSamples = 0;
+    vector<WFace *> wFaces;
+    WFace *wFace = nullptr;
+    uint tmpQI = 0;
+    uint qiClasses[256];
+    uint maxIndex, maxCard;
+    uint qiMajority;
+    for (vector<ViewEdge *>::iterator ve = vedges.begin() + range.first(),
+                                      veend = vedges.begin() + range.one_after_last();
+         ve != veend;
+         ve++) {
 #if LOGGING
       if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "\tCulled." << endl;
+        cout << "Processing ViewEdge " << (*ve)->getId() << endl;
       }
 #endif
-      continue;
-    }
-
-    // Test edge
-    festart = (*ve)->fedgeA();
-    fe = (*ve)->fedgeA();
-    qiMajority = 0;
-    do {
-      if (fe != nullptr && fe->isInImage()) {
-        qiMajority++;
+      // Find an edge to test
+      if (!(*ve)->isInImage()) {
+        // This view edge has been proscenium culled
+        (*ve)->setQI(255);
+        (*ve)->setaShape(nullptr);
+#if LOGGING
+        if (_global.debug & G_DEBUG_FREESTYLE) {
+          cout << "\tCulled." << endl;
+        }
+#endif
+        continue;
       }
-      fe = fe->nextEdge();
-    } while (fe && fe != festart);
 
-    if (qiMajority == 0) {
-      // There are no occludable FEdges on this ViewEdge
-      // This should be impossible.
-      if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
+      // Test edge
+      festart = (*ve)->fedgeA();
+      fe = (*ve)->fedgeA();
+      qiMajority = 0;
+      do {
+        if (fe != nullptr && fe->isInImage()) {
+          qiMajority++;
+        }
+        fe = fe->nextEdge();
+      } while (fe && fe != festart);
+
+      if (qiMajority == 0) {
+        // There are no occludable FEdges on this ViewEdge
+        // This should be impossible.
+        if (_global.debug & G_DEBUG_FREESTYLE) {
+          cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
+        }
+        // We can recover from this error:
+        // Treat this edge as fully visible with no occludee
+        (*ve)->setQI(0);
+        (*ve)->setaShape(nullptr);
+        continue;
       }
-      // We can recover from this error:
-      // Treat this edge as fully visible with no occludee
-      (*ve)->setQI(0);
-      (*ve)->setaShape(nullptr);
-      continue;
-    }
 
-    ++qiMajority;
-    qiMajority >>= 1;
+      ++qiMajority;
+      qiMajority >>= 1;
 
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tqiMajority: " << qiMajority << endl;
-    }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tqiMajority: " << qiMajority << endl;
+      }
 #endif
 
-    tmpQI = 0;
-    maxIndex = 0;
-    maxCard = 0;
-    nSamples = 0;
-    memset(qiClasses, 0, 256 * sizeof(*qiClasses));
-    set<ViewShape *> foundOccluders;
+      tmpQI = 0;
+      maxIndex = 0;
+      maxCard = 0;
+      nSamples = 0;
+      memset(qiClasses, 0, 256 * sizeof(*qiClasses));
+      set<ViewShape *> foundOccluders;
 
-    fe = (*ve)->fedgeA();
-    do {
-      if (fe == nullptr || !fe->isInImage()) {
-        fe = fe->nextEdge();
-        continue;
-      }
-      if (maxCard < qiMajority) {
-        // ARB: change &wFace to wFace and use reference in called function
-        tmpQI = computeVisibility<G, I>(
-            ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
-#if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: visibility " << tmpQI << endl;
+      fe = (*ve)->fedgeA();
+      do {
+        if (fe == nullptr || !fe->isInImage()) {
+          fe = fe->nextEdge();
+          continue;
         }
+        if (maxCard < qiMajority) {
+          // ARB: change &wFace to wFace and use reference in called function
+          tmpQI = computeVisibility<G, I>(
+              ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
+#if LOGGING
+          if (_global.debug & G_DEBUG_FREESTYLE) {
+            cout << "\tFEdge: visibility " << tmpQI << endl;
+          }
 #endif
 
-        // ARB: This is an error condition, not an alert condition.
-        // Some sort of recovery or abort is necessary.
-        if (tmpQI >= 256) {
-          cerr << "Warning: too many occluding levels" << endl;
-          // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
-          tmpQI = 255;
-        }
+          // ARB: This is an error condition, not an alert condition.
+          // Some sort of recovery or abort is necessary.
+          if (tmpQI >= 256) {
+            cerr << "Warning: too many occluding levels" << endl;
+            // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
+            tmpQI = 255;
+          }
 
-        if (++qiClasses[tmpQI] > maxCard) {
-          maxCard = qiClasses[tmpQI];
-          maxIndex = tmpQI;
+          if (++qiClasses[tmpQI] > maxCard) {
+            maxCard = qiClasses[tmpQI];
+            maxIndex = tmpQI;
+          }
         }
-      }
-      else {
-        // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
-        // ARB: change &wFace to wFace and use reference in called function
-        findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
+        else {
+          // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
+          // ARB: change &wFace to wFace and use reference in called function
+          findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
-               << endl;
-        }
+          if (_global.debug & G_DEBUG_FREESTYLE) {
+            cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
+                 << endl;
+          }
 #endif
-      }
-
-      // Store test results
-      if (wFace) {
-        vector<Vec3r> vertices;
-        for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
-          vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
         }
-        Polygon3r poly(vertices, wFace->GetNormal());
-        poly.userdata = (void *)wFace;
-        fe->setaFace(poly);
-        wFaces.push_back(wFace);
-        fe->setOccludeeEmpty(false);
+
+        // Store test results
+        if (wFace) {
+          vector<Vec3r> vertices;
+          for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
+            vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
+          }
+          Polygon3r poly(vertices, wFace->GetNormal());
+          poly.userdata = (void *)wFace;
+          fe->setaFace(poly);
+          wFaces.push_back(wFace);
+          fe->setOccludeeEmpty(false);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFound occludee" << endl;
-        }
+          if (_global.debug & G_DEBUG_FREESTYLE) {
+            cout << "\tFound occludee" << endl;
+          }
 #endif
-      }
-      else {
-        fe->setOccludeeEmpty(true);
-      }
+        }
+        else {
+          fe->setOccludeeEmpty(true);
+        }
 
-      ++nSamples;
-      fe = fe->nextEdge();
-    } while ((maxCard < qiMajority) && (fe) && (fe != festart));
+        ++nSamples;
+        fe = fe->nextEdge();
+      } while ((maxCard < qiMajority) && (fe) && (fe != festart));
 
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
-    }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
+      }
 #endif
 
-    // ViewEdge
-    // qi --
-    (*ve)->setQI(maxIndex);
-    // occluders --
-    // I would rather not have to go through the effort of creating this this set and then copying
-    // out its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
-    for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
-         o != oend;
-         ++o) {
-      (*ve)->AddOccluder(*o);
-    }
+      // ViewEdge
+      // qi --
+      (*ve)->setQI(maxIndex);
+      // occluders --
+      // I would rather not have to go through the effort of creating this this set and then
+      // copying out its contents. Is there a reason why ViewEdge::_Occluders cannot be converted
+      // to a set<>?
+      for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
+           o != oend;
+           ++o) {
+        (*ve)->AddOccluder(*o);
+      }
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size() << " occluders."
-           << endl;
-    }
-#endif
-    // occludee --
-    if (!wFaces.empty()) {
-      if (wFaces.size() <= float(nSamples) / 2.0f) {
-        (*ve)->setaShape(nullptr);
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size()
+             << " occluders." << endl;
       }
-      else {
-        ViewShape *vshape = ioViewMap->viewShape(
-            (*wFaces.begin())->GetVertex(0)->shape()->GetId());
-        (*ve)->setaShape(vshape);
+#endif
+      // occludee --
+      if (!wFaces.empty()) {
+        if (wFaces.size() <= float(nSamples) / 2.0f) {
+          (*ve)->setaShape(nullptr);
+        }
+        else {
+          ViewShape *vshape = ioViewMap->viewShape(
+              (*wFaces.begin())->GetVertex(0)->shape()->GetId());
+          (*ve)->setaShape(vshape);
+        }
       }
-    }
 
-    wFaces.clear();
-  }
+      wFaces.clear();
+    }
+  });
 }
 
 template<typename G, typename I>
@@ -1382,6 +1419,8 @@ void ViewMapBuilder::ComputeCumulativeVisibility(ViewMap *ioViewMap,
 
   AutoPtr<GridDensityProvider> density(factory.newGridDensityProvider(*source, bbox, *transform));
 
+  ensureVertexBoundaryFlags(we);
+
   if (_orthographicProjection) {
     BoxGrid grid(*source, *density, ioViewMap, _viewpoint, _EnableQI);
     computeCumulativeVisibility<BoxGrid, BoxGrid::Iterator>(
@@ -1420,6 +1459,8 @@ void ViewMapBuilder::ComputeDetailedVisibility(ViewMap *ioViewMap,
 
   AutoPtr<GridDensityProvider> density(factory.newGridDensityProvider(*source, bbox, *transform));
 
+  ensureVertexBoundaryFlags(we);
+
   if (_orthographicProjection) {
     BoxGrid grid(*source, *density, ioViewMap, _viewpoint, _EnableQI);
     computeDetailedVisibility<BoxGrid, BoxGrid::Iterator>(
@@ -15,6 +15,8 @@
  *   arbitrary number of sockets.
  */
 
+#include <atomic>
+
 #include "BLI_linear_allocator.hh"
 
 #include "FN_lazy_function.hh"
@@ -163,8 +165,25 @@ class Node : NonCopyable, NonMovable {
  * A #Node that corresponds to a specific #LazyFunction.
  */
 class FunctionNode : public Node {
+ private:
+  /**
+   * Estimated time in nanoseconds that an execution of the function takes, based on earlier
+   * executions. Graphs are usually evaluated many times, so this allows the executor to
+   * distribute expensive nodes over multiple threads before they start. It's -1 when the node
+   * has not been executed yet.
+   */
+  mutable std::atomic<int64_t> execution_time_estimate_ns_ = -1;
+
  public:
   const LazyFunction &function() const;
+
+  int64_t execution_time_estimate_ns() const;
+  /**
+   * Update the estimate after an execution. The estimate decays slowly, so that a node that is
+   * executed multiple times per evaluation (e.g. to request its inputs first) is still considered
+   * expensive when one of those executions is.
+   */
+  void add_execution_time_ns(int64_t time_ns) const;
 };
 
 /**
@@ -405,6 +424,18 @@ inline const LazyFunction &FunctionNode::function() const
   return *fn_;
 }
 
+inline int64_t FunctionNode::execution_time_estimate_ns() const
+{
+  return execution_time_estimate_ns_.load(std::memory_order_relaxed);
+}
+
+inline void FunctionNode::add_execution_time_ns(const int64_t time_ns) const
+{
+  const int64_t old_estimate = execution_time_estimate_ns_.load(std::memory_order_relaxed);
+  execution_time_estimate_ns_.store(std::max(time_ns, old_estimate / 2),
+                                    std::memory_order_relaxed);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
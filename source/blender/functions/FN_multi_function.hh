@@ -119,6 +119,11 @@ class MultiFunction {
      * memory usage.
      */
     bool allocates_array = false;
+    /**
+     * Upper bound for the number of indices that are passed in at once when #allocates_array is
+     * true. Smaller values keep the allocated arrays small enough to stay in the cache.
+     */
+    int64_t max_grain_size = 10000;
     /**
      * Tells the caller that every execution takes about the same time. This helps making a more
      * educated guess about a good grain size.
@@ -15,6 +15,8 @@ class MFProcedureExecutor : public MultiFunction {
  private:
   MFSignature signature_;
   const MFProcedure &procedure_;
+  /** Maximum number of indices that are processed at once, see #compute_max_grain_size. */
+  int64_t max_grain_size_;
 
  public:
   MFProcedureExecutor(const MFProcedure &procedure);
@@ -7,9 +7,12 @@
  * - Allow spreading the work over an arbitrary number of threads efficiently.
  *
  * This executor makes use of `FN_lazy_threading.hh` to enable multi-threading only when it seems
- * beneficial. It operates in two modes: single- and multi-threaded. The use of a task pool and
- * locks is avoided in single-threaded mode. Once multi-threading is enabled the executor starts
- * using both. It is not possible to switch back from multi-threaded to single-threaded mode.
+ * beneficial. Since graphs are usually evaluated many times, it also remembers how long every node
+ * took before, so that nodes known to be expensive can be distributed over threads right away.
+ *
+ * The executor operates in two modes: single- and multi-threaded. The use of a task pool and locks
+ * is avoided in single-threaded mode. Once multi-threading is enabled the executor starts using
+ * both. It is not possible to switch back from multi-threaded to single-threaded mode.
  *
  * The multi-threading design implemented in this executor requires *no* main thread that
  * coordinates everything. Instead, one thread will trigger some initial work and then many threads
@@ -39,6 +42,7 @@
  * starts again.
  */
 
+#include <chrono>
 #include <mutex>
 
 #include "BLI_compute_context.hh"
@@ -52,6 +56,14 @@
 
 namespace blender::fn::lazy_function {
 
+/**
+ * Nodes whose execution took at least this long in earlier evaluations are considered expensive.
+ * Before such a node runs, the other scheduled nodes are moved to other threads, just like when
+ * the node sends a #lazy_threading hint itself. This is similar to the amount of work that
+ * justifies a separate task in #threading::parallel_for.
+ */
+constexpr int64_t expensive_node_time_ns = 100'000;
+
 enum class NodeScheduleState {
   /**
    * Default state of every node.
@@ -986,24 +998,43 @@ class Executor {
     return true;
   }
 
+  using FunctionNodeVector = Vector<const FunctionNode *>;
+
   /**
    * Allow other threads to steal all the nodes that are currently scheduled on this thread.
    */
   void move_scheduled_nodes_to_task_pool(CurrentTask &current_task)
   {
     BLI_assert(this->use_multi_threading());
-    using FunctionNodeVector = Vector<const FunctionNode *>;
-    FunctionNodeVector *nodes = MEM_new<FunctionNodeVector>(__func__);
+    FunctionNodeVector nodes;
     {
       std::lock_guard lock{current_task.mutex};
       if (current_task.scheduled_nodes.is_empty()) {
         return;
       }
-      *nodes = std::move(current_task.scheduled_nodes);
+      nodes = std::move(current_task.scheduled_nodes);
       current_task.has_scheduled_nodes.store(false, std::memory_order_relaxed);
     }
-    /* All nodes are pushed as a single task in the pool. This avoids unnecessary threading
-     * overhead when the nodes are fast to compute. */
+    /* Nodes that were expensive in earlier evaluations get a task each, so that independent
+     * expensive branches of the graph can run on different threads. All other nodes are pushed
+     * as a single task. This avoids unnecessary threading overhead when the nodes are fast to
+     * compute. */
+    FunctionNodeVector cheap_nodes;
+    for (const FunctionNode *node : nodes) {
+      if (node->execution_time_estimate_ns() >= expensive_node_time_ns) {
+        this->push_nodes_to_task_pool({node});
+      }
+      else {
+        cheap_nodes.append(node);
+      }
+    }
+    if (!cheap_nodes.is_empty()) {
+      this->push_nodes_to_task_pool(std::move(cheap_nodes));
+    }
+  }
+
+  void push_nodes_to_task_pool(FunctionNodeVector nodes)
+  {
     BLI_task_pool_push(
         task_pool_.load(),
         [](TaskPool *pool, void *data) {
@@ -1014,7 +1045,7 @@ class Executor {
           new_current_task.has_scheduled_nodes.store(true, std::memory_order_relaxed);
           executor.run_task(new_current_task);
         },
-        nodes,
+        MEM_new<FunctionNodeVector>(__func__, std::move(nodes)),
         true,
         [](TaskPool * /*pool*/, void *data) {
           MEM_delete(static_cast<FunctionNodeVector *>(data));
@@ -1150,7 +1181,15 @@ inline void Executor::execute_node(const FunctionNode &node,
   };
 
   lazy_threading::HintReceiver blocking_hint_receiver{blocking_hint_fn};
+  if (node.execution_time_estimate_ns() >= expensive_node_time_ns) {
+    /* Don't wait for the node to send a hint when it's known to take a while already. */
+    blocking_hint_fn();
+  }
+  const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
   fn.execute(node_params, fn_context);
+  const std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+  node.add_execution_time_ns(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
 
   if (self_.logger_ != nullptr) {
     self_.logger_->log_after_node_execute(node, node_params, fn_context);
@@ -44,10 +44,9 @@ static int64_t compute_grain_size(const ExecutionHints &hints, const IndexMask m
     grain_size = std::max(grain_size, thread_based_grain_size);
   }
   if (hints.allocates_array) {
-    const int64_t max_grain_size = 10000;
     /* Avoid allocating many large intermediate arrays. Better process data in smaller chunks to
      * keep peak memory usage lower. */
-    grain_size = std::min(grain_size, max_grain_size);
+    grain_size = std::min(grain_size, hints.max_grain_size);
   }
   return grain_size;
 }
@@ -71,7 +70,7 @@ void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context
     return;
   }
 
-  threading::parallel_for(mask.index_range(), grain_size, [&](const IndexRange sub_range) {
+  const auto call_for_sub_range = [&](const IndexRange sub_range) {
     const IndexMask sliced_mask = mask.slice(sub_range);
     if (!hints.allocates_array) {
       /* There is no benefit to changing indices in this case. */
@@ -128,6 +127,19 @@ void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context
     }
 
     this->call(offset_mask, offset_params, context);
+  };
+
+  threading::parallel_for(mask.index_range(), grain_size, [&](const IndexRange sub_range) {
+    if (!hints.allocates_array) {
+      call_for_sub_range(sub_range);
+      return;
+    }
+    /* The scheduler may pass in much larger ranges than the grain size. Split them up, so that
+     * the arrays allocated by the function don't get larger than the grain size. */
+    for (int64_t start = sub_range.start(); start < sub_range.one_after_last();
+         start += grain_size) {
+      call_for_sub_range(IndexRange(start, grain_size).intersect(sub_range));
+    }
   });
 }
 
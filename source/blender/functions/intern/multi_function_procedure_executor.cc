@@ -2,10 +2,103 @@
 
 #include "FN_multi_function_procedure_executor.hh"
 
+#include "BLI_set.hh"
 #include "BLI_stack.hh"
 
 namespace blender::fn {
 
+/**
+ * The temporary buffers of all variables that are alive at the same time should fit into the
+ * cache, so that the values of one instruction are still cached when the next instruction uses
+ * them. Otherwise every instruction has to read and write main memory.
+ */
+static constexpr int64_t temporary_buffers_cache_size = 256 * 1024;
+static constexpr int64_t min_chunk_size = 1024;
+static constexpr int64_t max_chunk_size = 10000;
+
+/**
+ * Estimate the memory per index that is used by the buffers of the variables that are alive at
+ * the same time. Variables passed in by the caller are not taken into account, because they don't
+ * need temporary buffers.
+ */
+static int64_t compute_temporary_bytes_per_index(const MFProcedure &procedure)
+{
+  Set<const MFVariable *> param_variables;
+  for (const ConstMFParameter &param : procedure.params()) {
+    param_variables.add(param.variable);
+  }
+  const auto get_variable_size = [&](const MFVariable *variable) -> int64_t {
+    if (variable == nullptr || param_variables.contains(variable)) {
+      return 0;
+    }
+    const MFDataType data_type = variable->data_type();
+    if (data_type.is_single()) {
+      return data_type.single_type().size();
+    }
+    return sizeof(GVectorArray);
+  };
+
+  /* Follow the linear chain of instructions from the entry and find the peak memory. */
+  int64_t peak_size = 0;
+  int64_t alive_size = 0;
+  const MFInstruction *instruction = procedure.entry();
+  while (instruction != nullptr) {
+    switch (instruction->type()) {
+      case MFInstructionType::Call: {
+        const MFCallInstruction &call_instr = *static_cast<const MFCallInstruction *>(
+            instruction);
+        const MultiFunction &fn = call_instr.fn();
+        for (const int param_index : fn.param_indices()) {
+          if (fn.param_type(param_index).interface_type() == MFParamType::Output) {
+            alive_size += get_variable_size(call_instr.params()[param_index]);
+          }
+        }
+        peak_size = std::max(peak_size, alive_size);
+        instruction = call_instr.next();
+        break;
+      }
+      case MFInstructionType::Destruct: {
+        const MFDestructInstruction &destruct_instr =
+            *static_cast<const MFDestructInstruction *>(instruction);
+        alive_size -= get_variable_size(destruct_instr.variable());
+        instruction = destruct_instr.next();
+        break;
+      }
+      case MFInstructionType::Dummy: {
+        instruction = static_cast<const MFDummyInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Return: {
+        return peak_size;
+      }
+      case MFInstructionType::Branch: {
+        /* Be conservative when there are multiple code paths and assume that all variables are
+         * alive at the same time. */
+        int64_t total_size = 0;
+        for (const MFVariable *variable : procedure.variables()) {
+          total_size += get_variable_size(variable);
+        }
+        return total_size;
+      }
+    }
+  }
+  return peak_size;
+}
+
+/**
+ * Process fewer indices at once when the procedure has many large intermediate values, so that
+ * they stay in the cache.
+ */
+static int64_t compute_max_grain_size(const MFProcedure &procedure)
+{
+  const int64_t bytes_per_index = compute_temporary_bytes_per_index(procedure);
+  if (bytes_per_index == 0) {
+    return max_chunk_size;
+  }
+  return std::clamp(
+      temporary_buffers_cache_size / bytes_per_index, min_chunk_size, max_chunk_size);
+}
+
 MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedure_(procedure)
 {
   MFSignatureBuilder signature("Procedure Executor");
@@ -16,6 +109,8 @@ MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedu
 
   signature_ = signature.build();
   this->set_signature(&signature_);
+
+  max_grain_size_ = compute_max_grain_size(procedure);
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -1263,6 +1358,7 @@ MultiFunction::ExecutionHints MFProcedureExecutor::get_execution_hints() const
   ExecutionHints hints;
   hints.allocates_array = true;
   hints.min_grain_size = 10000;
+  hints.max_grain_size = max_grain_size_;
   return hints;
 }
 
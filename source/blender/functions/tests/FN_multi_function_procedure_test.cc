@@ -2,6 +2,8 @@
 
 #include "testing/testing.h"
 
+#include "BLI_float4x4.hh"
+
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_procedure_builder.hh"
 #include "FN_multi_function_procedure_executor.hh"
@@ -408,4 +410,62 @@ TEST(multi_function_procedure, OutputBufferReplaced)
   EXPECT_EQ(output[2], output_value);
 }
 
+TEST(multi_function_procedure, LargeIntermediateValues)
+{
+  /**
+   * procedure(int a, int *out) {
+   *   float4x4 b = make_matrix(a);
+   *   float4x4 c = b * b;
+   *   out = get_element(c);
+   * }
+   */
+
+  CustomMF_SI_SO<int, float4x4> make_matrix_fn{"make matrix", [](int a) {
+                                                  float4x4 matrix = float4x4::identity();
+                                                  matrix.values[0][0] = float(a);
+                                                  return matrix;
+                                                }};
+  CustomMF_SI_SO<float4x4, float4x4> square_fn{"square",
+                                               [](const float4x4 &a) { return a * a; }};
+  CustomMF_SI_SO<float4x4, int> get_element_fn{"get element",
+                                               [](const float4x4 &a) { return int(a[0][0]); }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var_a = &builder.add_single_input_parameter<int>();
+  auto [var_b] = builder.add_call<1>(make_matrix_fn, {var_a});
+  builder.add_destruct(*var_a);
+  auto [var_c] = builder.add_call<1>(square_fn, {var_b});
+  builder.add_destruct(*var_b);
+  auto [var_out] = builder.add_call<1>(get_element_fn, {var_c});
+  builder.add_destruct(*var_c);
+  builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor procedure_fn{procedure};
+  /* The intermediate matrices are large, so the indices are processed in smaller chunks. */
+  EXPECT_LT(procedure_fn.execution_hints().max_grain_size, 10000);
+
+  const int size = 100000;
+  Array<int> inputs(size);
+  for (const int i : inputs.index_range()) {
+    inputs[i] = i % 100;
+  }
+  Array<int> results(size, -1);
+
+  MFParamsBuilder params{procedure_fn, size};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  procedure_fn.call_auto(IndexRange(size), params, context);
+
+  for (const int i : results.index_range()) {
+    EXPECT_EQ(results[i], inputs[i] * inputs[i]);
+  }
+}
+
 }  // namespace blender::fn::tests
@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
+
+/** \file
+ * \ingroup geo
+ */
+
+namespace blender::geometry {
+
+/**
+ * Find the selected points that are within \a merge_distance of another selected point, with the
+ * same greedy behavior as #BLI_kdtree_3d_calc_duplicates_fast: a point that isn't merged yet
+ * becomes the target of all unmerged points in its range.
+ *
+ * When the merge distance is small compared to the size of the bounds, the points are sorted
+ * into a uniform grid with cells as large as the merge distance instead of building a KD-tree.
+ * Cells whose neighborhoods don't overlap are then processed in parallel. The result is
+ * deterministic, but the targets can differ from the ones the KD-tree would find.
+ *
+ * \param r_duplicates: Has the size of \a positions. Values of selected points that are -1 are
+ * candidates to be merged, afterwards they contain the index of the target point. Targets are
+ * set to their own index.
+ * \return The number of points that are merged into another point.
+ */
+int find_duplicate_points(Span<float3> positions,
+                          IndexMask selection,
+                          float merge_distance,
+                          MutableSpan<int> r_duplicates);
+
+}  // namespace blender::geometry
@@ -0,0 +1,271 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "BLI_array.hh"
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "GEO_find_duplicate_points.hh"
+
+namespace blender::geometry {
+
+/**
+ * The grid is only used when the bounds are at least this many cells wide along their largest
+ * axis. Otherwise there are too many points in every cell and the KD-tree is faster.
+ */
+constexpr int64_t grid_min_cells_along_axis = 16;
+/** Larger grids can't be indexed with 64 bit integers safely. */
+constexpr double grid_max_cells_num = double(int64_t(1) << 60);
+/** Below this number of points, building a grid isn't worth it. */
+constexpr int64_t grid_min_points_num = 4096;
+
+static int find_duplicate_points_kdtree(const Span<float3> positions,
+                                        const IndexMask selection,
+                                        const float merge_distance,
+                                        MutableSpan<int> r_duplicates)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(uint(selection.size()));
+  for (const int i : selection) {
+    BLI_kdtree_3d_insert(tree, i, positions[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  const int duplicates_num = BLI_kdtree_3d_calc_duplicates_fast(
+      tree, merge_distance, false, r_duplicates.data());
+  BLI_kdtree_3d_free(tree);
+  return duplicates_num;
+}
+
+struct DuplicatesGrid {
+  float3 min;
+  float cell_size_inv;
+  int64_t size_x;
+  int64_t size_y;
+  int64_t size_z;
+
+  int3 cell_of(const float3 &position) const
+  {
+    const float3 cell = (position - min) * cell_size_inv;
+    return {std::clamp(int(cell.x), 0, int(size_x - 1)),
+            std::clamp(int(cell.y), 0, int(size_y - 1)),
+            std::clamp(int(cell.z), 0, int(size_z - 1))};
+  }
+
+  uint64_t key_of(const int3 &cell) const
+  {
+    return uint64_t((cell.z * size_y + cell.y) * size_x + cell.x);
+  }
+
+  int3 cell_of_key(const uint64_t key) const
+  {
+    const int64_t index = int64_t(key);
+    return {int(index % size_x), int((index / size_x) % size_y), int(index / (size_x * size_y))};
+  }
+};
+
+/**
+ * \return False when the grid would not be faster than the KD-tree.
+ */
+static bool create_duplicates_grid(const Span<float3> positions,
+                                   const IndexMask selection,
+                                   const float merge_distance,
+                                   DuplicatesGrid &r_grid)
+{
+  if (selection.size() < grid_min_points_num || merge_distance <= 0.0f) {
+    return false;
+  }
+  struct MinMax {
+    float3 min;
+    float3 max;
+  };
+  const float3 first = positions[selection[0]];
+  const MinMax bounds = threading::parallel_reduce(
+      selection.index_range(),
+      1024,
+      MinMax{first, first},
+      [&](const IndexRange range, const MinMax &init) {
+        MinMax result = init;
+        for (const int i : selection.slice(range)) {
+          math::min_max(positions[i], result.min, result.max);
+        }
+        return result;
+      },
+      [](const MinMax &a, const MinMax &b) {
+        return MinMax{math::min(a.min, b.min), math::max(a.max, b.max)};
+      });
+
+  /* Make the cells slightly larger than the merge distance, so that points within the merge
+   * distance are always in neighboring cells, even with rounding errors. */
+  const float cell_size = merge_distance * 1.001f;
+  const float3 size = (bounds.max - bounds.min) / cell_size;
+  if (!(std::isfinite(size.x) && std::isfinite(size.y) && std::isfinite(size.z))) {
+    return false;
+  }
+  const double size_x = std::floor(double(size.x)) + 1.0;
+  const double size_y = std::floor(double(size.y)) + 1.0;
+  const double size_z = std::floor(double(size.z)) + 1.0;
+  if (std::max({size_x, size_y, size_z}) < double(grid_min_cells_along_axis)) {
+    return false;
+  }
+  if (size_x * size_y * size_z > grid_max_cells_num ||
+      std::max({size_x, size_y, size_z}) > double(std::numeric_limits<int>::max())) {
+    return false;
+  }
+
+  r_grid.min = bounds.min;
+  r_grid.cell_size_inv = 1.0f / cell_size;
+  r_grid.size_x = int64_t(size_x);
+  r_grid.size_y = int64_t(size_y);
+  r_grid.size_z = int64_t(size_z);
+  return true;
+}
+
+/**
+ * Cells are colored so that the neighborhoods of two cells with the same color never overlap.
+ * All cells of one color can then be processed in parallel, because a point can only be merged
+ * into points of its own or of a neighboring cell.
+ */
+static int cell_color(const int3 &cell)
+{
+  return (cell.x % 3) + (cell.y % 3) * 3 + (cell.z % 3) * 9;
+}
+constexpr int cell_colors_num = 27;
+
+static int find_duplicate_points_grid(const Span<float3> positions,
+                                      const IndexMask selection,
+                                      const float merge_distance,
+                                      const DuplicatesGrid &grid,
+                                      MutableSpan<int> r_duplicates)
+{
+  /* Sort the selected points by their cell. Because the sort is stable, the points in every cell
+   * are still ordered by index. */
+  Array<uint64_t> point_keys(selection.size(), NoInitialization());
+  Array<int> sorted_points(selection.size(), NoInitialization());
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int point_i = int(selection[i]);
+      point_keys[i] = grid.key_of(grid.cell_of(positions[point_i]));
+      sorted_points[i] = point_i;
+    }
+  });
+  parallel_radix_sort<uint64_t, int>(point_keys, sorted_points);
+
+  /* Find the range of points in every non-empty cell. */
+  Vector<uint64_t> cell_keys;
+  Vector<int> cell_offsets;
+  for (const int64_t i : point_keys.index_range()) {
+    if (i == 0 || point_keys[i] != point_keys[i - 1]) {
+      cell_keys.append(point_keys[i]);
+      cell_offsets.append(int(i));
+    }
+  }
+  cell_offsets.append(int(point_keys.size()));
+  const auto cell_points = [&](const int64_t cell_index) {
+    return sorted_points.as_span().slice(cell_offsets[cell_index],
+                                         cell_offsets[cell_index + 1] - cell_offsets[cell_index]);
+  };
+
+  /* Group the cells by color with a counting sort, which keeps them ordered by key. */
+  Array<int> color_offsets(cell_colors_num + 1, 0);
+  Array<int8_t> colors(cell_keys.size());
+  for (const int64_t cell_index : cell_keys.index_range()) {
+    colors[cell_index] = int8_t(cell_color(grid.cell_of_key(cell_keys[cell_index])));
+    color_offsets[colors[cell_index] + 1]++;
+  }
+  for (const int color : IndexRange(cell_colors_num)) {
+    color_offsets[color + 1] += color_offsets[color];
+  }
+  Array<int> cells_by_color(cell_keys.size());
+  {
+    Array<int> fill_offsets(color_offsets.as_span().drop_back(1));
+    for (const int64_t cell_index : cell_keys.index_range()) {
+      cells_by_color[fill_offsets[colors[cell_index]]++] = int(cell_index);
+    }
+  }
+
+  const float merge_distance_sq = merge_distance * merge_distance;
+  std::atomic<int> duplicates_num = 0;
+  for (const int color : IndexRange(cell_colors_num)) {
+    const Span<int> color_cells = cells_by_color.as_span().slice(
+        color_offsets[color], color_offsets[color + 1] - color_offsets[color]);
+    threading::parallel_for(color_cells.index_range(), 64, [&](const IndexRange range) {
+      int local_duplicates_num = 0;
+      /* Ranges of existing cells in every row of the neighborhood. */
+      Vector<IndexRange, 9> neighbor_cells;
+      for (const int cell_index : color_cells.slice(range)) {
+        const int3 cell = grid.cell_of_key(cell_keys[cell_index]);
+        neighbor_cells.clear();
+        for (int z = std::max(cell.z - 1, 0); z <= std::min(cell.z + 1, int(grid.size_z - 1));
+             z++) {
+          for (int y = std::max(cell.y - 1, 0); y <= std::min(cell.y + 1, int(grid.size_y - 1));
+               y++) {
+            /* The keys of the cells in a row are consecutive. */
+            const uint64_t key_first = grid.key_of({std::max(cell.x - 1, 0), y, z});
+            const uint64_t key_last = grid.key_of(
+                {std::min(cell.x + 1, int(grid.size_x - 1)), y, z});
+            const int64_t begin = std::lower_bound(cell_keys.begin(), cell_keys.end(), key_first) -
+                                  cell_keys.begin();
+            int64_t end = begin;
+            while (end < cell_keys.size() && cell_keys[end] <= key_last) {
+              end++;
+            }
+            if (end > begin) {
+              neighbor_cells.append(IndexRange(begin, end - begin));
+            }
+          }
+        }
+
+        for (const int point_i : cell_points(cell_index)) {
+          if (!ELEM(r_duplicates[point_i], -1, point_i)) {
+            continue;
+          }
+          const float3 &position = positions[point_i];
+          bool found = false;
+          for (const IndexRange cells : neighbor_cells) {
+            for (const int64_t neighbor_cell : cells) {
+              for (const int other_i : cell_points(neighbor_cell)) {
+                if (other_i == point_i || r_duplicates[other_i] != -1) {
+                  continue;
+                }
+                if (math::distance_squared(position, positions[other_i]) <= merge_distance_sq) {
+                  r_duplicates[other_i] = point_i;
+                  local_duplicates_num++;
+                  found = true;
+                }
+              }
+            }
+          }
+          if (found) {
+            /* Prevent chains of doubles. */
+            r_duplicates[point_i] = point_i;
+          }
+        }
+      }
+      duplicates_num += local_duplicates_num;
+    });
+  }
+  return duplicates_num;
+}
+
+int find_duplicate_points(const Span<float3> positions,
+                          const IndexMask selection,
+                          const float merge_distance,
+                          MutableSpan<int> r_duplicates)
+{
+  BLI_assert(positions.size() == r_duplicates.size());
+  if (selection.is_empty()) {
+    return 0;
+  }
+  DuplicatesGrid grid;
+  if (create_duplicates_grid(positions, selection, merge_distance, grid)) {
+    return find_duplicate_points_grid(positions, selection, merge_distance, grid, r_duplicates);
+  }
+  return find_duplicate_points_kdtree(positions, selection, merge_distance, r_duplicates);
+}
+
+}  // namespace blender::geometry
@@ -2,9 +2,9 @@
 
 #include "BLI_array.hh"
 #include "BLI_index_mask.hh"
-#include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
@@ -13,6 +13,7 @@
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
 
+#include "GEO_find_duplicate_points.hh"
 #include "GEO_mesh_merge_by_distance.hh"
 
 //#define USE_WELD_DEBUG
@@ -1550,17 +1551,16 @@ std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
 {
   Array<int> vert_dest_map(mesh.totvert, OUT_OF_CONTEXT);
 
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
   const Span<MVert> verts = mesh.verts();
-  for (const int i : selection) {
-    BLI_kdtree_3d_insert(tree, i, verts[i].co);
-  }
+  Array<float3> positions(verts.size());
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      positions[i] = verts[i].co;
+    }
+  });
 
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, false, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  const int vert_kill_len = find_duplicate_points(
+      positions, selection, merge_distance, vert_dest_map);
 
   if (vert_kill_len == 0) {
     return std::nullopt;
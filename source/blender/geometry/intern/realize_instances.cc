@@ -294,6 +294,42 @@ static void threaded_fill(const GPointer value, GMutableSpan dst)
   });
 }
 
+/**
+ * Execute the realize tasks in parallel. Instances can have very different sizes, so a grain size
+ * based on the number of tasks would either create a lot of overhead for many tiny instances or
+ * keep many medium sized instances on the same thread. Instead, consecutive tasks are grouped
+ * until every group contains enough elements to justify a separate thread. Large tasks are still
+ * multi-threaded internally.
+ */
+template<typename Task, typename GetSizeFn, typename ExecuteFn>
+static void execute_realize_tasks(const Span<Task> tasks,
+                                  const GetSizeFn &get_size,
+                                  const ExecuteFn &execute)
+{
+  const int64_t group_min_size = 4096;
+  Vector<IndexRange> groups;
+  int64_t group_start = 0;
+  int64_t group_size = 0;
+  for (const int64_t task_index : tasks.index_range()) {
+    group_size += get_size(tasks[task_index]);
+    if (group_size >= group_min_size) {
+      groups.append(IndexRange(group_start, task_index + 1 - group_start));
+      group_start = task_index + 1;
+      group_size = 0;
+    }
+  }
+  if (group_start < tasks.size()) {
+    groups.append(IndexRange(group_start, tasks.size() - group_start));
+  }
+  threading::parallel_for(groups.index_range(), 1, [&](const IndexRange group_range) {
+    for (const int64_t group_index : group_range) {
+      for (const int64_t task_index : groups[group_index]) {
+        execute(tasks[task_index]);
+      }
+    }
+  });
+}
+
 static void copy_generic_attributes_to_result(
     const Span<std::optional<GVArraySpan>> src_attributes,
     const AttributeFallbacksArray &attribute_fallbacks,
@@ -449,6 +485,237 @@ static void foreach_geometry_in_reference(
   }
 }
 
+/**
+ * Realize information about an instance reference that is a geometry without nested instances.
+ * The pointers are null when the geometry has no data of the corresponding type.
+ */
+struct LeafReferenceInfo {
+  const PointCloudRealizeInfo *pointcloud_info = nullptr;
+  const MeshRealizeInfo *mesh_info = nullptr;
+  const RealizeCurveInfo *curve_info = nullptr;
+};
+
+/** Offsets of the tasks and of the elements in the result while gathering leaf instances. */
+struct LeafInstancesOffsets {
+  int pointcloud_task = 0;
+  int mesh_task = 0;
+  int curve_task = 0;
+  GatherOffsets elements;
+
+  void add_reference(const LeafReferenceInfo &reference)
+  {
+    if (reference.pointcloud_info != nullptr) {
+      this->pointcloud_task++;
+      this->elements.pointcloud_offset += reference.pointcloud_info->pointcloud->totpoint;
+    }
+    if (reference.mesh_info != nullptr) {
+      const Mesh &mesh = *reference.mesh_info->mesh;
+      this->mesh_task++;
+      this->elements.mesh_offsets.vertex += mesh.totvert;
+      this->elements.mesh_offsets.edge += mesh.totedge;
+      this->elements.mesh_offsets.loop += mesh.totloop;
+      this->elements.mesh_offsets.poly += mesh.totpoly;
+    }
+    if (reference.curve_info != nullptr) {
+      const ::CurvesGeometry &curves = reference.curve_info->curves->geometry;
+      this->curve_task++;
+      this->elements.curves_offsets.point += curves.point_num;
+      this->elements.curves_offsets.curve += curves.curve_num;
+    }
+  }
+
+  void add(const LeafInstancesOffsets &other)
+  {
+    this->pointcloud_task += other.pointcloud_task;
+    this->mesh_task += other.mesh_task;
+    this->curve_task += other.curve_task;
+    this->elements.pointcloud_offset += other.elements.pointcloud_offset;
+    this->elements.mesh_offsets.vertex += other.elements.mesh_offsets.vertex;
+    this->elements.mesh_offsets.edge += other.elements.mesh_offsets.edge;
+    this->elements.mesh_offsets.loop += other.elements.mesh_offsets.loop;
+    this->elements.mesh_offsets.poly += other.elements.mesh_offsets.poly;
+    this->elements.curves_offsets.point += other.elements.curves_offsets.point;
+    this->elements.curves_offsets.curve += other.elements.curves_offsets.curve;
+  }
+};
+
+/**
+ * \return False when the reference contains nested instances or other data that needs the
+ * recursive gather.
+ */
+static bool prepare_leaf_reference(const GatherTasksInfo &gather_info,
+                                   const InstanceReference &reference,
+                                   LeafReferenceInfo &r_info)
+{
+  if (reference.type() == InstanceReference::Type::None) {
+    return true;
+  }
+  if (reference.type() != InstanceReference::Type::GeometrySet) {
+    return false;
+  }
+  const GeometrySet &geometry_set = reference.geometry_set();
+  if (geometry_set.has_instances() || geometry_set.has<VolumeComponent>() ||
+      geometry_set.has<GeometryComponentEditData>()) {
+    return false;
+  }
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
+    if (pointcloud->totpoint > 0) {
+      const int pointcloud_index = gather_info.pointclouds.order.index_of(pointcloud);
+      r_info.pointcloud_info = &gather_info.pointclouds.realize_info[pointcloud_index];
+    }
+  }
+  if (const Mesh *mesh = geometry_set.get_mesh_for_read()) {
+    if (mesh->totvert > 0) {
+      const int mesh_index = gather_info.meshes.order.index_of(mesh);
+      r_info.mesh_info = &gather_info.meshes.realize_info[mesh_index];
+    }
+  }
+  if (const Curves *curves = geometry_set.get_curves_for_read()) {
+    if (curves->geometry.curve_num > 0) {
+      const int curve_index = gather_info.curves.order.index_of(curves);
+      r_info.curve_info = &gather_info.curves.realize_info[curve_index];
+    }
+  }
+  return true;
+}
+
+template<typename Task>
+static MutableSpan<Task> append_uninitialized_tasks(Vector<Task> &tasks, const int64_t num)
+{
+  tasks.reserve(tasks.size() + num);
+  return {tasks.end(), num};
+}
+
+/**
+ * Gathering tasks one instance at a time has a large overhead per instance when there are
+ * millions of small instances. When none of the references contain nested instances, which is
+ * the common case, the start indices of every instance can be computed with a prefix sum over the
+ * sizes of the referenced geometries instead. Then all tasks are created in parallel.
+ *
+ * \return False when the instances have to be gathered recursively.
+ */
+static bool gather_realize_tasks_for_leaf_instances(
+    GatherTasksInfo &gather_info,
+    const InstancesComponent &instances_component,
+    const float4x4 &base_transform,
+    const InstanceContext &base_instance_context,
+    const Span<int> stored_instance_ids,
+    const Span<std::pair<int, GSpan>> pointcloud_attributes_to_override,
+    const Span<std::pair<int, GSpan>> mesh_attributes_to_override,
+    const Span<std::pair<int, GSpan>> curve_attributes_to_override)
+{
+  const Span<InstanceReference> references = instances_component.references();
+  const Span<int> handles = instances_component.instance_reference_handles();
+  const Span<float4x4> transforms = instances_component.instance_transforms();
+
+  Array<LeafReferenceInfo> leaf_references(references.size());
+  for (const int i : references.index_range()) {
+    if (!prepare_leaf_reference(gather_info, references[i], leaf_references[i])) {
+      return false;
+    }
+  }
+
+  /* Sum up the sizes of every chunk of instances in parallel. The start of every chunk is the sum
+   * of the sizes of the chunks before it. */
+  const int64_t chunk_size = 4096;
+  const int64_t chunks_num = (transforms.size() + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    return IndexRange(chunk * chunk_size, chunk_size).intersect(transforms.index_range());
+  };
+  Array<LeafInstancesOffsets> chunk_offsets(chunks_num);
+  threading::parallel_for(chunk_offsets.index_range(), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      LeafInstancesOffsets chunk_sum;
+      for (const int64_t i : chunk_range(chunk)) {
+        chunk_sum.add_reference(leaf_references[handles[i]]);
+      }
+      chunk_offsets[chunk] = chunk_sum;
+    }
+  });
+  LeafInstancesOffsets total;
+  total.elements = gather_info.r_offsets;
+  for (LeafInstancesOffsets &offsets : chunk_offsets) {
+    const LeafInstancesOffsets chunk_sum = offsets;
+    offsets = total;
+    total.add(chunk_sum);
+  }
+
+  GatherTasks &r_tasks = gather_info.r_tasks;
+  MutableSpan<RealizePointCloudTask> pointcloud_tasks = append_uninitialized_tasks(
+      r_tasks.pointcloud_tasks, total.pointcloud_task);
+  MutableSpan<RealizeMeshTask> mesh_tasks = append_uninitialized_tasks(r_tasks.mesh_tasks,
+                                                                       total.mesh_task);
+  MutableSpan<RealizeCurveTask> curve_tasks = append_uninitialized_tasks(r_tasks.curve_tasks,
+                                                                         total.curve_task);
+
+  const auto instance_fallbacks = [](const AttributeFallbacksArray &base_fallbacks,
+                                     const Span<std::pair<int, GSpan>> attributes_to_override,
+                                     const int64_t instance_index) {
+    AttributeFallbacksArray fallbacks = base_fallbacks;
+    for (const std::pair<int, GSpan> &pair : attributes_to_override) {
+      fallbacks.array[pair.first] = pair.second[instance_index];
+    }
+    return fallbacks;
+  };
+
+  threading::parallel_for(chunk_offsets.index_range(), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      LeafInstancesOffsets offsets = chunk_offsets[chunk];
+      for (const int64_t i : chunk_range(chunk)) {
+        const LeafReferenceInfo &reference = leaf_references[handles[i]];
+        const float4x4 transform = base_transform * transforms[i];
+
+        uint32_t local_instance_id = 0;
+        if (gather_info.create_id_attribute_on_any_component) {
+          if (stored_instance_ids.is_empty()) {
+            local_instance_id = uint32_t(i);
+          }
+          else {
+            local_instance_id = uint32_t(stored_instance_ids[i]);
+          }
+        }
+        const uint32_t id = noise::hash(base_instance_context.id, local_instance_id);
+
+        if (reference.pointcloud_info != nullptr) {
+          new (&pointcloud_tasks[offsets.pointcloud_task])
+              RealizePointCloudTask{offsets.elements.pointcloud_offset,
+                                    reference.pointcloud_info,
+                                    transform,
+                                    instance_fallbacks(base_instance_context.pointclouds,
+                                                       pointcloud_attributes_to_override,
+                                                       i),
+                                    id};
+        }
+        if (reference.mesh_info != nullptr) {
+          new (&mesh_tasks[offsets.mesh_task])
+              RealizeMeshTask{offsets.elements.mesh_offsets,
+                              reference.mesh_info,
+                              transform,
+                              instance_fallbacks(
+                                  base_instance_context.meshes, mesh_attributes_to_override, i),
+                              id};
+        }
+        if (reference.curve_info != nullptr) {
+          new (&curve_tasks[offsets.curve_task])
+              RealizeCurveTask{offsets.elements.curves_offsets,
+                               reference.curve_info,
+                               transform,
+                               instance_fallbacks(
+                                   base_instance_context.curves, curve_attributes_to_override, i),
+                               id};
+        }
+        offsets.add_reference(reference);
+      }
+    }
+  });
+
+  r_tasks.pointcloud_tasks.increase_size_by_unchecked(pointcloud_tasks.size());
+  r_tasks.mesh_tasks.increase_size_by_unchecked(mesh_tasks.size());
+  r_tasks.curve_tasks.increase_size_by_unchecked(curve_tasks.size());
+  gather_info.r_offsets = total.elements;
+  return true;
+}
+
 static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
                                                const InstancesComponent &instances_component,
                                                const float4x4 &base_transform,
@@ -475,6 +742,17 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   Vector<std::pair<int, GSpan>> curve_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances_component, gather_info.curves.attributes);
 
+  if (gather_realize_tasks_for_leaf_instances(gather_info,
+                                              instances_component,
+                                              base_transform,
+                                              base_instance_context,
+                                              stored_instance_ids,
+                                              pointcloud_attributes_to_override,
+                                              mesh_attributes_to_override,
+                                              curve_attributes_to_override)) {
+    return;
+  }
+
   for (const int i : transforms.index_range()) {
     const int handle = handles[i];
     const float4x4 &transform = transforms[i];
@@ -765,17 +1043,17 @@ static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &opti
   }
 
   /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizePointCloudTask &task = tasks[task_index];
-      execute_realize_pointcloud_task(options,
-                                      task,
-                                      ordered_attributes,
-                                      dst_attribute_writers,
-                                      point_ids.span,
-                                      positions.span);
-    }
-  });
+  execute_realize_tasks(
+      tasks,
+      [](const RealizePointCloudTask &task) { return task.pointcloud_info->positions.size(); },
+      [&](const RealizePointCloudTask &task) {
+        execute_realize_pointcloud_task(options,
+                                        task,
+                                        ordered_attributes,
+                                        dst_attribute_writers,
+                                        point_ids.span,
+                                        positions.span);
+      });
 
   /* Tag modified attributes. */
   for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
@@ -1084,21 +1362,24 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
   }
 
   /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizeMeshTask &task = tasks[task_index];
-      execute_realize_mesh_task(options,
-                                task,
-                                ordered_attributes,
-                                dst_attribute_writers,
-                                dst_verts,
-                                dst_edges,
-                                dst_polys,
-                                dst_loops,
-                                vertex_ids.span,
-                                material_indices.span);
-    }
-  });
+  execute_realize_tasks(
+      tasks,
+      [](const RealizeMeshTask &task) {
+        const MeshRealizeInfo &info = *task.mesh_info;
+        return info.verts.size() + info.edges.size() + info.polys.size() + info.loops.size();
+      },
+      [&](const RealizeMeshTask &task) {
+        execute_realize_mesh_task(options,
+                                  task,
+                                  ordered_attributes,
+                                  dst_attribute_writers,
+                                  dst_verts,
+                                  dst_edges,
+                                  dst_polys,
+                                  dst_loops,
+                                  vertex_ids.span,
+                                  material_indices.span);
+      });
 
   /* Tag modified attributes. */
   for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
@@ -1369,22 +1650,26 @@ static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
   }
 
   /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizeCurveTask &task = tasks[task_index];
-      execute_realize_curve_task(options,
-                                 all_curves_info,
-                                 task,
-                                 ordered_attributes,
-                                 dst_curves,
-                                 dst_attribute_writers,
-                                 point_ids.span,
-                                 handle_left.span,
-                                 handle_right.span,
-                                 radius.span,
-                                 resolution.span);
-    }
-  });
+  execute_realize_tasks(
+      tasks,
+      [](const RealizeCurveTask &task) {
+        const bke::CurvesGeometry &curves = bke::CurvesGeometry::wrap(
+            task.curve_info->curves->geometry);
+        return int64_t(curves.points_num()) + curves.curves_num();
+      },
+      [&](const RealizeCurveTask &task) {
+        execute_realize_curve_task(options,
+                                   all_curves_info,
+                                   task,
+                                   ordered_attributes,
+                                   dst_curves,
+                                   dst_attribute_writers,
+                                   point_ids.span,
+                                   handle_left.span,
+                                   handle_right.span,
+                                   radius.span,
+                                   resolution.span);
+      });
 
   /* Type counts have to be updated eagerly. */
   dst_curves.runtime->type_counts.fill(0);
@@ -95,6 +95,8 @@ struct GPUPass {
   uint32_t hash;
   /** Did we already tried to compile the attached GPUShader. */
   bool compiled;
+  /** Materials sharing the pass can be compiled from different threads. */
+  ThreadMutex compile_mutex;
 };
 
 /* -------------------------------------------------------------------- */
@@ -702,6 +704,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     pass->create_info = codegen.create_info;
     pass->hash = codegen.hash_get();
     pass->compiled = false;
+    BLI_mutex_init(&pass->compile_mutex);
 
     codegen.create_info = nullptr;
 
@@ -760,6 +763,7 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
+  BLI_mutex_lock(&pass->compile_mutex);
   if (!pass->compiled) {
     GPUShaderCreateInfo *info = reinterpret_cast<GPUShaderCreateInfo *>(
         static_cast<ShaderCreateInfo *>(pass->create_info));
@@ -781,6 +785,7 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
     pass->shader = shader;
     pass->compiled = true;
   }
+  BLI_mutex_unlock(&pass->compile_mutex);
   return success;
 }
 
@@ -804,6 +809,7 @@ static void gpu_pass_free(GPUPass *pass)
     GPU_shader_free(pass->shader);
   }
   delete pass->create_info;
+  BLI_mutex_end(&pass->compile_mutex);
   MEM_freeN(pass);
 }
 
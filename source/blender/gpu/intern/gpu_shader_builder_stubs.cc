@@ -12,6 +12,7 @@
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 
+#include "BKE_appdir.h"
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
 #include "BKE_global.h"
@@ -101,6 +102,18 @@ void UI_GetThemeColorShadeAlpha4ubv(int UNUSED(colorid),
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Stubs of BKE_appdir.h
+ * \{ */
+
+bool BKE_appdir_folder_caches(char *r_path, size_t UNUSED(path_len))
+{
+  r_path[0] = '\0';
+  return false;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Stubs of BKE_attribute.h
  * \{ */
@@ -5,8 +5,12 @@
  * \ingroup gpu
  */
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
@@ -902,7 +906,30 @@ char *GLShader::glsl_patch_get(GLenum gl_stage)
   return glsl_patch_default_get();
 }
 
+static bool program_binary_cache_enabled()
+{
+  /* Compile the shaders when debugging, to always get their logs. */
+  return GLContext::program_binary_support && (G.debug & G_DEBUG_GPU) == 0;
+}
+
 GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get(gl_stage);
+
+  if (program_binary_cache_enabled()) {
+    std::string source;
+    for (const char *source_part : sources) {
+      source += source_part;
+    }
+    deferred_stages_.append({gl_stage, std::move(source)});
+    return 0;
+  }
+
+  return compile_shader_stage(gl_stage, sources);
+}
+
+GLuint GLShader::compile_shader_stage(GLenum gl_stage, Span<const char *> sources)
 {
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
@@ -910,9 +937,6 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get(gl_stage);
-
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
 
@@ -951,6 +975,29 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+bool GLShader::compile_deferred_stages()
+{
+  for (const std::pair<GLenum, std::string> &stage : deferred_stages_) {
+    const char *source = stage.second.c_str();
+    const GLuint shader = this->compile_shader_stage(stage.first, Span<const char *>(&source, 1));
+    switch (stage.first) {
+      case GL_VERTEX_SHADER:
+        vert_shader_ = shader;
+        break;
+      case GL_GEOMETRY_SHADER:
+        geom_shader_ = shader;
+        break;
+      case GL_FRAGMENT_SHADER:
+        frag_shader_ = shader;
+        break;
+      case GL_COMPUTE_SHADER:
+        compute_shader_ = shader;
+        break;
+    }
+  }
+  return !compilation_failed_;
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
   vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
@@ -985,18 +1032,38 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
-  glLinkProgram(shader_program_);
+  std::string binary_filepath;
+  if (!deferred_stages_.is_empty() && transform_feedback_type_ == GPU_SHADER_TFB_NONE) {
+    binary_filepath = program_binary_path_get();
+  }
 
-  GLint status;
-  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
-  if (!status) {
-    char log[5000];
-    glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
-    Span<const char *> sources;
-    GLLogParser parser;
-    this->print_log(sources, log, "Linking", true, &parser);
-    return false;
+  if (binary_filepath.empty() || !program_binary_load(binary_filepath)) {
+    if (!compile_deferred_stages()) {
+      return false;
+    }
+
+    if (!binary_filepath.empty()) {
+      glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    glLinkProgram(shader_program_);
+
+    GLint status;
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    if (!status) {
+      char log[5000];
+      glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
+      Span<const char *> sources;
+      GLLogParser parser;
+      this->print_log(sources, log, "Linking", true, &parser);
+      return false;
+    }
+
+    if (!binary_filepath.empty()) {
+      program_binary_save(binary_filepath);
+    }
   }
+  deferred_stages_.clear_and_make_inline();
 
   if (info != nullptr && info->legacy_resource_location_ == false) {
     interface = new GLShaderInterface(shader_program_, *info);
@@ -1010,6 +1077,126 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Compiling the shaders of materials with many nodes can take seconds per material. The linked
+ * programs are stored in the user cache directory, so that they are only compiled again after
+ * their sources or the driver change.
+ * \{ */
+
+/** Written at the start of every binary file, followed by the binary. */
+struct ProgramBinaryHeader {
+  char magic[4];
+  uint32_t format;
+  uint32_t size;
+};
+
+static const char program_binary_magic[4] = {'B', 'G', 'L', '1'};
+
+static const std::string &program_binary_cache_dir_get()
+{
+  static const std::string cache_dir = []() {
+    char dir[FILE_MAX];
+    if (!BKE_appdir_folder_caches(dir, sizeof(dir))) {
+      return std::string();
+    }
+    BLI_path_append(dir, sizeof(dir), "gpu-shader-binaries");
+    return std::string(dir);
+  }();
+  return cache_dir;
+}
+
+std::string GLShader::program_binary_path_get() const
+{
+  const std::string &cache_dir = program_binary_cache_dir_get();
+  if (cache_dir.empty()) {
+    return "";
+  }
+
+  /* The binary formats are driver specific, and can change between driver versions. */
+  std::string key;
+  key += (const char *)glGetString(GL_VENDOR);
+  key += (const char *)glGetString(GL_RENDERER);
+  key += (const char *)glGetString(GL_VERSION);
+  for (const std::pair<GLenum, std::string> &stage : deferred_stages_) {
+    key += std::to_string(stage.first);
+    key += stage.second;
+  }
+
+  uchar digest[16];
+  char hexdigest[33];
+  BLI_hash_md5_buffer(key.c_str(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, hexdigest);
+
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), cache_dir.c_str(), hexdigest);
+  return filepath;
+}
+
+bool GLShader::program_binary_load(const std::string &filepath)
+{
+  size_t file_size = 0;
+  void *file_data = BLI_file_read_binary_as_mem(filepath.c_str(), 0, &file_size);
+  if (file_data == nullptr) {
+    return false;
+  }
+
+  const ProgramBinaryHeader *header = static_cast<const ProgramBinaryHeader *>(file_data);
+  bool success = false;
+  if (file_size >= sizeof(ProgramBinaryHeader) &&
+      memcmp(header->magic, program_binary_magic, sizeof(header->magic)) == 0 &&
+      file_size - sizeof(ProgramBinaryHeader) == header->size) {
+    glProgramBinary(shader_program_, header->format, header + 1, header->size);
+
+    /* Fails when the driver can no longer use the binary, it is compiled and saved again then. */
+    GLint status;
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    success = status;
+  }
+
+  MEM_freeN(file_data);
+  return success;
+}
+
+void GLShader::program_binary_save(const std::string &filepath)
+{
+  GLint size = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &size);
+  if (size <= 0) {
+    return;
+  }
+
+  Vector<uint8_t> data(sizeof(ProgramBinaryHeader) + size);
+  ProgramBinaryHeader *header = reinterpret_cast<ProgramBinaryHeader *>(data.data());
+  GLenum format;
+  glGetProgramBinary(shader_program_, size, &size, &format, header + 1);
+  memcpy(header->magic, program_binary_magic, sizeof(header->magic));
+  header->format = format;
+  header->size = size;
+
+  const std::string &cache_dir = program_binary_cache_dir_get();
+  if (!BLI_dir_create_recursive(cache_dir.c_str())) {
+    return;
+  }
+
+  /* Write to a temporary file first, so other Blender instances never read partial files. */
+  const std::string temp_filepath = filepath + ".tmp";
+  FILE *file = BLI_fopen(temp_filepath.c_str(), "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const size_t data_size = sizeof(ProgramBinaryHeader) + size;
+  const bool written = fwrite(data.data(), 1, data_size, file) == data_size;
+  fclose(file);
+
+  if (!written || BLI_rename(temp_filepath.c_str(), filepath.c_str()) != 0) {
+    BLI_delete(temp_filepath.c_str(), false, false);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
@@ -11,6 +11,10 @@
 
 #include <epoxy/gl.h>
 
+#include <string>
+
+#include "BLI_vector.hh"
+
 #include "gpu_shader_create_info.hh"
 #include "gpu_shader_private.hh"
 
@@ -37,6 +41,12 @@ class GLShader : public Shader {
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
+  /**
+   * Patched sources of the shader stages, when the program binary cache is used. The stages are
+   * only compiled in #finalize() if the cache does not have a binary of the program.
+   */
+  Vector<std::pair<GLenum, std::string>> deferred_stages_;
+
  public:
   GLShader(const char *name);
   ~GLShader();
@@ -78,8 +88,22 @@ class GLShader : public Shader {
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
-  /** Create, compile and attach the shader stage to the shader program. */
+  /**
+   * Create, compile and attach the shader stage to the shader program.
+   * Returns 0 when the compilation is deferred to #finalize().
+   */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  GLuint compile_shader_stage(GLenum gl_stage, Span<const char *> sources);
+  /** Compile the deferred stages. Returns false if any of them failed to compile. */
+  bool compile_deferred_stages();
+
+  /**
+   * Program binary cache, stored in the user cache directory. Binaries are identified by the
+   * hash of the patched sources and the driver identification strings.
+   */
+  std::string program_binary_path_get() const;
+  bool program_binary_load(const std::string &filepath);
+  void program_binary_save(const std::string &filepath);
 
   /**
    * \brief features available on newer implementation such as native barycentric coordinates
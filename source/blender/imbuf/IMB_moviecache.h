@@ -27,6 +27,19 @@ typedef void *(*MovieCacheGetPriorityDataFP)(void *userkey);
 typedef int (*MovieCacheGetItemPriorityFP)(void *last_userkey, void *priority_data);
 typedef void (*MovieCachePriorityDeleterFP)(void *priority_data);
 
+/**
+ * Statistics of a cache user, all caches created with the same name share one.
+ */
+typedef struct MovieCacheUserStats {
+  char name[64];
+  int priority;
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+  /** Memory used by the currently cached image buffers, in bytes. */
+  size_t memory;
+} MovieCacheUserStats;
+
 void IMB_moviecache_init(void);
 void IMB_moviecache_destruct(void);
 
@@ -54,6 +67,16 @@ void IMB_moviecache_cleanup(struct MovieCache *cache,
                                                    void *userdata),
                             void *userdata);
 
+/**
+ * All the caches share a single memory limit. When over it, the items of the cache users with the
+ * lowest priority are freed first, least recently used first. The default priority is zero.
+ */
+void IMB_moviecache_set_user_priority(const char *name, int priority);
+/**
+ * Get statistics of all cache users, free the returned array with #MEM_freeN.
+ */
+MovieCacheUserStats *IMB_moviecache_get_user_stats(int *r_len);
+
 /**
  * Get segments of cached frames. Useful for debugging cache policies.
  */
@@ -21,6 +21,7 @@
 extern "C" {
 #endif
 
+struct ImBuf;
 struct StampData;
 
 void *IMB_exr_get_handle(void);
@@ -45,6 +46,23 @@ void IMB_exr_add_channel(void *handle,
  */
 bool IMB_exr_begin_read(
     void *handle, const char *filepath, int *width, int *height, bool parse_channels);
+/**
+ * Read the layers, passes and views of a multilayer or multiview file without allocating or
+ * reading their pixels, which are null in #IMB_exr_multilayer_convert. Passes can then be read
+ * one at a time with #IMB_exr_read_pass. Returns false for other files.
+ */
+bool IMB_exr_begin_read_layers(void *handle, const char *filepath, int *width, int *height);
+/**
+ * Read the pixels of a single pass of a handle started with #IMB_exr_begin_read_layers into
+ * \a rect, with the interleaved channels of the pass. Returns false if there is no such pass.
+ * \param passname: Does not include view.
+ */
+bool IMB_exr_read_pass(
+    void *handle, const char *layname, const char *passname, const char *viewname, float *rect);
+/**
+ * Add the string attributes of the file header to the metadata of \a ibuf.
+ */
+void IMB_exr_read_metadata(void *handle, struct ImBuf *ibuf);
 /**
  * Used for output files (from #RenderResult) (single and multi-layer, single and multi-view).
  */
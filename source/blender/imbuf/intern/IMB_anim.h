@@ -112,8 +112,15 @@ struct anim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   struct SwsContext *img_convert_ctx;
+  /* Source format of #img_convert_ctx. */
+  enum AVPixelFormat img_convert_pix_fmt;
   int videoStream;
 
+  /* Pixel format of hardware decoded frames, #AV_PIX_FMT_NONE when decoding in software. */
+  enum AVPixelFormat hw_pix_fmt;
+  /* Hardware decoded frame copied to system memory. */
+  AVFrame *pFrame_sw;
+
   AVFrame *pFrame;
   bool pFrame_complete;
   AVFrame *pFrame_backup;
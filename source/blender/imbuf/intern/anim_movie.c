@@ -43,6 +43,7 @@
 #include "BLI_utildefines.h"
 
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -65,6 +66,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -487,6 +489,109 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 
 #ifdef WITH_FFMPEG
 
+/* Create the context converting decoded frames of the given format to RGBA. */
+static struct SwsContext *ffmpeg_sws_context_create(struct anim *anim,
+                                                    enum AVPixelFormat pix_fmt)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  struct SwsContext *img_convert_ctx = sws_getContext(anim->x,
+                                                      anim->y,
+                                                      pix_fmt,
+                                                      anim->x,
+                                                      anim->y,
+                                                      AV_PIX_FMT_RGBA,
+                                                      SWS_BILINEAR | SWS_PRINT_INFO |
+                                                          SWS_FULL_CHR_H_INT,
+                                                      NULL,
+                                                      NULL,
+                                                      NULL);
+  if (!img_convert_ctx) {
+    return NULL;
+  }
+  anim->img_convert_pix_fmt = pix_fmt;
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return img_convert_ctx;
+}
+
+static enum AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *ctx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  const struct anim *anim = ctx->opaque;
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The hardware can't decode this stream, fall back to software decoding. */
+  return avcodec_default_get_format(ctx, pix_fmts);
+}
+
+/**
+ * Decode with the first hardware device available for the codec, if any. Decoded frames are
+ * copied back to system memory before color conversion, see #ffmpeg_postprocess.
+ */
+static void ffmpeg_hw_decode_setup(struct anim *anim,
+                                   const AVCodec *pCodec,
+                                   AVCodecContext *pCodecCtx)
+{
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, i);
+    if (config == NULL) {
+      return;
+    }
+    if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)) {
+      continue;
+    }
+
+    AVBufferRef *hw_device_ctx = NULL;
+    if (av_hwdevice_ctx_create(&hw_device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    av_log(pCodecCtx,
+           AV_LOG_DEBUG,
+           "Using %s hardware decoding\n",
+           av_hwdevice_get_type_name(config->device_type));
+    anim->hw_pix_fmt = config->pix_fmt;
+    /* The codec context owns the device reference. */
+    pCodecCtx->hw_device_ctx = hw_device_ctx;
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_hw_get_format;
+    return;
+  }
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -500,11 +605,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -568,6 +668,12 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  /* Deinterlacing works on the decoded frames in software formats. */
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  if (U.experimental.use_sequencer_hardware_decode && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decode_setup(anim, pCodec, pCodecCtx);
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -731,16 +837,7 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt);
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
@@ -755,33 +852,6 @@ static int startffmpeg(struct anim *anim)
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -850,6 +920,29 @@ static void ffmpeg_postprocess(struct anim *anim, AVFrame *input)
   ImBuf *ibuf = anim->cur_frame_final;
   int filter_y = 0;
 
+  /* Frames decoded by the hardware are copied from the device memory first. */
+  if (input->hw_frames_ctx != NULL) {
+    if (anim->pFrame_sw == NULL) {
+      anim->pFrame_sw = av_frame_alloc();
+    }
+    if (av_hwframe_transfer_data(anim->pFrame_sw, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not copy hardware decoded frame\n");
+      av_frame_unref(anim->pFrame_sw);
+      return;
+    }
+    input = anim->pFrame_sw;
+
+    /* The software format of the frames is known once they are decoded. */
+    if (input->format != anim->img_convert_pix_fmt) {
+      sws_freeContext(anim->img_convert_ctx);
+      anim->img_convert_ctx = ffmpeg_sws_context_create(anim, input->format);
+      if (anim->img_convert_ctx == NULL) {
+        fprintf(stderr, "Can't transform color space??? Bailing out...\n");
+        return;
+      }
+    }
+  }
+
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -1480,6 +1573,7 @@ static void free_anim_ffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrame_backup);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrame_sw);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->cur_frame_final);
@@ -31,6 +31,7 @@
 #include "BLI_math_color.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_appdir.h"
@@ -91,6 +92,9 @@ typedef struct ColormanageProcessor {
   OCIO_ConstCPUProcessorRcPtr *cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* Display transform from scene linear to the sRGB colorspace without any look, exposure, gamma
+   * or curves, which display buffers can apply with the built-in sRGB conversion instead. */
+  bool is_srgb_display;
 } ColormanageProcessor;
 
 static struct global_gpu_state {
@@ -711,6 +715,9 @@ void colormanagement_init(void)
   }
 
   BLI_init_srgb_conversion();
+
+  /* Display buffers are computed again from their image buffer without reading any file. */
+  IMB_moviecache_set_user_priority("colormanage cache", -1);
 }
 
 void colormanagement_exit(void)
@@ -1456,6 +1463,7 @@ typedef struct DisplayBufferThread {
 
   const char *byte_colorspace;
   const char *float_colorspace;
+  bool byte_colorspace_is_srgb;
 } DisplayBufferThread;
 
 typedef struct DisplayBufferInitData {
@@ -1471,6 +1479,7 @@ typedef struct DisplayBufferInitData {
 
   const char *byte_colorspace;
   const char *float_colorspace;
+  bool byte_colorspace_is_srgb;
 } DisplayBufferInitData;
 
 static void display_buffer_init_handle(void *handle_v,
@@ -1521,6 +1530,7 @@ static void display_buffer_init_handle(void *handle_v,
 
   handle->byte_colorspace = init_data->byte_colorspace;
   handle->float_colorspace = init_data->float_colorspace;
+  handle->byte_colorspace_is_srgb = init_data->byte_colorspace_is_srgb;
 }
 
 static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
@@ -1548,6 +1558,18 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
     const size_t i_last = ((size_t)width) * height;
     size_t i;
 
+    if (!is_data && !is_data_display && handle->byte_colorspace_is_srgb && channels == 4) {
+      /* sRGB is the most common byte color space, use the lookup table of the built-in
+       * conversion which matches OCIO for all byte values. */
+      for (i = 0, fp = linear_buffer, cp = byte_buffer; i != i_last;
+           i++, fp += channels, cp += channels) {
+        srgb_to_linearrgb_uchar4(fp, cp);
+      }
+
+      *is_straight_alpha = true;
+      return;
+    }
+
     /* first convert byte buffer to float, keep in image space */
     for (i = 0, fp = linear_buffer, cp = byte_buffer; i != i_last;
          i++, fp += channels, cp += channels) {
@@ -1639,6 +1661,23 @@ static void *do_display_buffer_apply_thread(void *handle_v)
                                  width);
     }
   }
+  else if (cm_processor->is_srgb_display && handle->buffer && !handle->float_colorspace &&
+           display_buffer_byte && !display_buffer && !is_data) {
+    /* Scene linear float buffer displayed with the standard sRGB view, convert it to display
+     * bytes directly, without an intermediate buffer and OCIO. Values out of the display range
+     * are clamped by the byte conversion either way. */
+    IMB_buffer_byte_from_float(display_buffer_byte,
+                               handle->buffer,
+                               channels,
+                               dither,
+                               IB_PROFILE_SRGB,
+                               IB_PROFILE_LINEAR_RGB,
+                               handle->predivide,
+                               width,
+                               height,
+                               width,
+                               width);
+  }
   else {
     bool is_straight_alpha;
     float *linear_buffer = MEM_mallocN(((size_t)channels) * width * height * sizeof(float),
@@ -1721,6 +1760,11 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
     init_data.byte_colorspace = global_role_default_byte;
   }
 
+  /* Look up once here, the color space info is lazily cached. */
+  ColorSpace *byte_colorspace = colormanage_colorspace_get_named(init_data.byte_colorspace);
+  init_data.byte_colorspace_is_srgb = byte_colorspace &&
+                                      IMB_colormanagement_space_is_srgb(byte_colorspace);
+
   if (ibuf->float_colorspace != NULL) {
     /* sequencer stores float buffers in non-linear space */
     init_data.float_colorspace = ibuf->float_colorspace->name;
@@ -2204,6 +2248,53 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
+typedef struct ImBufToTextureData {
+  void *out_buffer;
+  int offset_x, offset_y;
+  int width;
+  const ImBuf *ibuf;
+  /* Premultiply byte buffers, or unpremultiply float buffers. */
+  bool convert_alpha;
+  OCIO_ConstCPUProcessorRcPtr *processor;
+} ImBufToTextureData;
+
+static void imbuf_to_texture_threading_settings(TaskParallelSettings *settings,
+                                                const int width,
+                                                const int height)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  /* Partial updates while painting are often small. */
+  settings->use_threading = (size_t)width * height > 256 * 256;
+  settings->min_iter_per_thread = 16;
+}
+
+static void imbuf_to_byte_texture_row(void *__restrict userdata,
+                                      const int y,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImBufToTextureData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = (size_t)y * width;
+  const uchar *in = (uchar *)ibuf->rect + in_offset * 4;
+  uchar *out = (uchar *)data->out_buffer + out_offset * 4;
+
+  if (data->convert_alpha) {
+    /* Premultiply only. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      out[0] = (in[0] * in[3]) >> 8;
+      out[1] = (in[1] * in[3]) >> 8;
+      out[2] = (in[2] * in[3]) >> 8;
+      out[3] = in[3];
+    }
+  }
+  else {
+    /* Copy only. */
+    memcpy(out, in, sizeof(uchar[4]) * width);
+  }
+}
+
 void IMB_colormanagement_imbuf_to_byte_texture(uchar *out_buffer,
                                                const int offset_x,
                                                const int offset_y,
@@ -2219,32 +2310,100 @@ void IMB_colormanagement_imbuf_to_byte_texture(uchar *out_buffer,
              IMB_colormanagement_space_is_scene_linear(ibuf->rect_colorspace) ||
              IMB_colormanagement_space_is_data(ibuf->rect_colorspace));
 
-  const uchar *in_buffer = (uchar *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const uchar *in = in_buffer + in_offset * 4;
-    uchar *out = out_buffer + out_offset * 4;
-
-    if (use_premultiply) {
-      /* Premultiply only. */
+  ImBufToTextureData data = {
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .ibuf = ibuf,
+      .convert_alpha = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+      .processor = NULL,
+  };
+
+  TaskParallelSettings settings;
+  imbuf_to_texture_threading_settings(&settings, width, height);
+  BLI_task_parallel_range(0, height, &data, imbuf_to_byte_texture_row, &settings);
+}
+
+static void imbuf_float_to_float_texture_row(void *__restrict userdata,
+                                             const int y,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImBufToTextureData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const int in_channels = ibuf->channels;
+  const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = (size_t)y * width;
+  const float *in = ibuf->rect_float + in_offset * in_channels;
+  float *out = (float *)data->out_buffer + out_offset * 4;
+
+  if (in_channels == 1) {
+    /* Copy single channel. */
+    for (int x = 0; x < width; x++, in += 1, out += 4) {
+      out[0] = in[0];
+      out[1] = in[0];
+      out[2] = in[0];
+      out[3] = in[0];
+    }
+  }
+  else if (in_channels == 3) {
+    /* Copy RGB. */
+    for (int x = 0; x < width; x++, in += 3, out += 4) {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      out[3] = 1.0f;
+    }
+  }
+  else if (in_channels == 4) {
+    /* Copy or convert RGBA. */
+    if (data->convert_alpha) {
       for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = (in[0] * in[3]) >> 8;
-        out[1] = (in[1] * in[3]) >> 8;
-        out[2] = (in[2] * in[3]) >> 8;
-        out[3] = in[3];
+        premul_to_straight_v4_v4(out, in);
       }
     }
     else {
-      /* Copy only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = in[3];
-      }
+      memcpy(out, in, sizeof(float[4]) * width);
+    }
+  }
+}
+
+static void imbuf_byte_to_float_texture_row(void *__restrict userdata,
+                                            const int y,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImBufToTextureData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = (size_t)y * width;
+  const uchar *in = (uchar *)ibuf->rect + in_offset * 4;
+  float *out_row = (float *)data->out_buffer + out_offset * 4;
+  float *out = out_row;
+
+  for (int x = 0; x < width; x++, in += 4, out += 4) {
+    rgba_uchar_to_float(out, in);
+  }
+
+  /* Convert to scene linear, the processor is applied to the whole row at once. */
+  if (data->processor) {
+    OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(
+        out_row, width, 1, 4, sizeof(float), sizeof(float[4]), sizeof(float[4]) * width);
+    OCIO_cpuProcessorApply(data->processor, img);
+    OCIO_PackedImageDescRelease(img);
+  }
+  else {
+    out = out_row;
+    for (int x = 0; x < width; x++, out += 4) {
+      srgb_to_linearrgb_v3_v3(out, out);
+    }
+  }
+
+  if (data->convert_alpha) {
+    out = out_row;
+    for (int x = 0; x < width; x++, out += 4) {
+      mul_v3_fl(out, out[3]);
     }
   }
 }
@@ -2257,84 +2416,33 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
                                                 const struct ImBuf *ibuf,
                                                 const bool store_premultiplied)
 {
+  ImBufToTextureData data = {
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .ibuf = ibuf,
+      .convert_alpha = false,
+      .processor = NULL,
+  };
+
+  TaskParallelSettings settings;
+  imbuf_to_texture_threading_settings(&settings, width, height);
+
   /* Float texture are stored in scene linear color space, with premultiplied
    * alpha depending on the image alpha mode. */
   if (ibuf->rect_float) {
     /* Float source buffer. */
-    const float *in_buffer = ibuf->rect_float;
-    const int in_channels = ibuf->channels;
-    const bool use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
-
-    for (int y = 0; y < height; y++) {
-      const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-      const size_t out_offset = y * width;
-      const float *in = in_buffer + in_offset * in_channels;
-      float *out = out_buffer + out_offset * 4;
-
-      if (in_channels == 1) {
-        /* Copy single channel. */
-        for (int x = 0; x < width; x++, in += 1, out += 4) {
-          out[0] = in[0];
-          out[1] = in[0];
-          out[2] = in[0];
-          out[3] = in[0];
-        }
-      }
-      else if (in_channels == 3) {
-        /* Copy RGB. */
-        for (int x = 0; x < width; x++, in += 3, out += 4) {
-          out[0] = in[0];
-          out[1] = in[1];
-          out[2] = in[2];
-          out[3] = 1.0f;
-        }
-      }
-      else if (in_channels == 4) {
-        /* Copy or convert RGBA. */
-        if (use_unpremultiply) {
-          for (int x = 0; x < width; x++, in += 4, out += 4) {
-            premul_to_straight_v4_v4(out, in);
-          }
-        }
-        else {
-          memcpy(out, in, sizeof(float[4]) * width);
-        }
-      }
-    }
+    data.convert_alpha = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
+    BLI_task_parallel_range(0, height, &data, imbuf_float_to_float_texture_row, &settings);
   }
   else {
     /* Byte source buffer. */
-    const uchar *in_buffer = (uchar *)ibuf->rect;
-    const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
-
-    /* TODO(brecht): make this multi-threaded, or at least process in batches. */
-    OCIO_ConstCPUProcessorRcPtr *processor = (ibuf->rect_colorspace) ?
-                                                 colorspace_to_scene_linear_cpu_processor(
-                                                     ibuf->rect_colorspace) :
-                                                 NULL;
-
-    for (int y = 0; y < height; y++) {
-      const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-      const size_t out_offset = y * width;
-      const uchar *in = in_buffer + in_offset * 4;
-      float *out = out_buffer + out_offset * 4;
-
-      /* Convert to scene linear, to sRGB and premultiply. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        float pixel[4];
-        rgba_uchar_to_float(pixel, in);
-        if (processor) {
-          OCIO_cpuProcessorApplyRGB(processor, pixel);
-        }
-        else {
-          srgb_to_linearrgb_v3_v3(pixel, pixel);
-        }
-        if (use_premultiply) {
-          mul_v3_fl(pixel, pixel[3]);
-        }
-        copy_v4_v4(out, pixel);
-      }
-    }
+    data.convert_alpha = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
+    data.processor = (ibuf->rect_colorspace) ?
+                         colorspace_to_scene_linear_cpu_processor(ibuf->rect_colorspace) :
+                         NULL;
+    BLI_task_parallel_range(0, height, &data, imbuf_byte_to_float_texture_row, &settings);
   }
 }
 
@@ -3784,6 +3892,13 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
   display_space = display_transform_get_colorspace(applied_view_settings, display_settings);
   if (display_space) {
     cm_processor->is_data_result = display_space->is_data;
+    cm_processor->is_srgb_display = !display_space->is_data &&
+                                    IMB_colormanagement_space_is_srgb(display_space) &&
+                                    !colormanage_use_look(applied_view_settings->look,
+                                                          applied_view_settings->view_transform) &&
+                                    applied_view_settings->exposure == 0.0f &&
+                                    applied_view_settings->gamma == 1.0f &&
+                                    !(applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES);
   }
 
   cm_processor->cpu_processor = create_display_buffer_processor(
@@ -7,14 +7,18 @@
 
 #undef DEBUG_MESSAGES
 
+#include <atomic>
 #include <cstdlib> /* for qsort */
 #include <memory.h>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "MEM_CacheLimiterC-Api.h"
 #include "MEM_guardedalloc.h"
 
 #include "BLI_ghash.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
@@ -43,8 +47,41 @@ static MEM_CacheLimiterC *limitor = nullptr;
  * so regular mutex will not work here, hence the recursive lock. */
 static std::recursive_mutex limitor_lock;
 
+/* Priorities of cache users are steps larger than the number of cached items, so that all items
+ * of lower priority users are freed before the items of higher priority ones. */
+#define MOVIECACHE_USER_PRIORITY_STEP (1 << 24)
+#define MOVIECACHE_USER_PRIORITY_MAX 16
+
+/* Statistics and priority shared by all caches with the same name, never freed. */
+struct MovieCacheUser {
+  char name[64];
+  std::atomic<int> priority = 0;
+  std::atomic<uint64_t> hits = 0;
+  std::atomic<uint64_t> misses = 0;
+  std::atomic<uint64_t> evictions = 0;
+  std::atomic<size_t> memory = 0;
+};
+
+static std::vector<std::unique_ptr<MovieCacheUser>> cache_users;
+static std::mutex cache_users_lock;
+
+static MovieCacheUser *moviecache_user_ensure(const char *name)
+{
+  std::lock_guard lock(cache_users_lock);
+  for (std::unique_ptr<MovieCacheUser> &user : cache_users) {
+    if (STREQLEN(user->name, name, sizeof(user->name))) {
+      return user.get();
+    }
+  }
+  MovieCacheUser *user = new MovieCacheUser();
+  BLI_strncpy(user->name, name, sizeof(user->name));
+  cache_users.push_back(std::unique_ptr<MovieCacheUser>(user));
+  return user;
+}
+
 struct MovieCache {
   char name[64];
+  MovieCacheUser *user;
 
   GHash *hash;
   GHashHashFP hashfp;
@@ -77,6 +114,8 @@ struct MovieCacheItem {
   ImBuf *ibuf;
   MEM_CacheLimiterHandleC *c_handle;
   void *priority_data;
+  /* Size accounted in the memory of the cache user, while #ibuf is set. */
+  size_t memory_size;
   /* Indicates that #ibuf is null, because there was an error during load. */
   bool added_empty;
 };
@@ -105,6 +144,12 @@ static void moviecache_keyfree(void *val)
   BLI_mempool_free(key->cache_owner->keys_pool, key);
 }
 
+static void moviecache_item_release_memory(MovieCacheItem *item)
+{
+  item->cache_owner->user->memory -= item->memory_size;
+  item->memory_size = 0;
+}
+
 static void moviecache_valfree(void *val)
 {
   MovieCacheItem *item = (MovieCacheItem *)val;
@@ -121,6 +166,7 @@ static void moviecache_valfree(void *val)
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
+  moviecache_item_release_memory(item);
 
   if (item->priority_data && cache->prioritydeleterfp) {
     cache->prioritydeleterfp(item->priority_data);
@@ -179,6 +225,8 @@ static void moviecache_destructor(void *p)
 
     item->ibuf = nullptr;
     item->c_handle = nullptr;
+    moviecache_item_release_memory(item);
+    cache->user->evictions++;
 
     /* force cached segments to be updated */
     MEM_SAFE_FREE(cache->points);
@@ -210,6 +258,7 @@ static int get_item_priority(void *item_v, int default_priority)
 {
   MovieCacheItem *item = (MovieCacheItem *)item_v;
   MovieCache *cache = item->cache_owner;
+  const int user_priority = cache->user->priority * MOVIECACHE_USER_PRIORITY_STEP;
   int priority;
 
   if (!cache->getitempriorityfp) {
@@ -219,14 +268,14 @@ static int get_item_priority(void *item_v, int default_priority)
           item,
           default_priority);
 
-    return default_priority;
+    return default_priority + user_priority;
   }
 
   priority = cache->getitempriorityfp(cache->last_userkey, item->priority_data);
 
   PRINT("%s: cache '%s' item %p priority %d\n", __func__, cache->name, item, priority);
 
-  return priority;
+  return priority + user_priority;
 }
 
 static bool get_item_destroyable(void *item_v)
@@ -274,6 +323,7 @@ MovieCache *IMB_moviecache_create(const char *name,
   cache = (MovieCache *)MEM_callocN(sizeof(MovieCache), "MovieCache");
 
   BLI_strncpy(cache->name, name, sizeof(cache->name));
+  cache->user = moviecache_user_ensure(name);
 
   cache->keys_pool = BLI_mempool_create(sizeof(MovieCacheKey), 0, 64, BLI_MEMPOOL_NOP);
   cache->items_pool = BLI_mempool_create(sizeof(MovieCacheItem), 0, 64, BLI_MEMPOOL_NOP);
@@ -289,6 +339,32 @@ MovieCache *IMB_moviecache_create(const char *name,
   return cache;
 }
 
+void IMB_moviecache_set_user_priority(const char *name, int priority)
+{
+  MovieCacheUser *user = moviecache_user_ensure(name);
+  user->priority = clamp_i(priority, -MOVIECACHE_USER_PRIORITY_MAX, MOVIECACHE_USER_PRIORITY_MAX);
+}
+
+MovieCacheUserStats *IMB_moviecache_get_user_stats(int *r_len)
+{
+  std::lock_guard lock(cache_users_lock);
+
+  MovieCacheUserStats *stats = (MovieCacheUserStats *)MEM_callocN(
+      sizeof(MovieCacheUserStats) * cache_users.size(), __func__);
+  for (int i = 0; i < cache_users.size(); i++) {
+    const MovieCacheUser &user = *cache_users[i];
+    BLI_strncpy(stats[i].name, user.name, sizeof(stats[i].name));
+    stats[i].priority = user.priority;
+    stats[i].hits = user.hits;
+    stats[i].misses = user.misses;
+    stats[i].evictions = user.evictions;
+    stats[i].memory = user.memory;
+  }
+  *r_len = int(cache_users.size());
+
+  return stats;
+}
+
 void IMB_moviecache_set_getdata_callback(MovieCache *cache, MovieCacheGetKeyDataFP getdatafp)
 {
   cache->getdatafp = getdatafp;
@@ -332,6 +408,7 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
   item->cache_owner = cache;
   item->c_handle = nullptr;
   item->priority_data = nullptr;
+  item->memory_size = 0;
   item->added_empty = ibuf == nullptr;
 
   if (cache->getprioritydatafp) {
@@ -349,6 +426,8 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
   }
 
   item->c_handle = MEM_CacheLimiter_insert(limitor, item);
+  item->memory_size = ibuf ? get_size_in_memory(ibuf) : 0;
+  cache->user->memory += item->memory_size;
 
   MEM_CacheLimiter_ref(item->c_handle);
   MEM_CacheLimiter_enforce_limits(limitor);
@@ -418,6 +497,7 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey, bool *r_is_cached_em
       limitor_lock.unlock();
 
       IMB_refImBuf(item->ibuf);
+      cache->user->hits++;
 
       return item->ibuf;
     }
@@ -426,6 +506,7 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey, bool *r_is_cached_em
     }
   }
 
+  cache->user->misses++;
   return nullptr;
 }
 
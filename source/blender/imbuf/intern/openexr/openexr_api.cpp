@@ -78,6 +78,7 @@
 #include "BLI_math_color.h"
 #include "BLI_mmap.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -99,6 +100,7 @@ extern "C" {
 static struct ExrPass *imb_exr_get_pass(ListBase *lb, char *passname);
 static bool exr_has_multiview(MultiPartInputFile &file);
 static bool exr_has_multipart_file(MultiPartInputFile &file);
+static bool imb_exr_is_multi(MultiPartInputFile &file);
 static bool exr_has_alpha(MultiPartInputFile &file);
 static bool exr_has_zbuffer(MultiPartInputFile &file);
 static void exr_printf(const char *__restrict fmt, ...);
@@ -453,6 +455,20 @@ static void openexr_header_metadata(Header *header, struct ImBuf *ibuf)
   }
 }
 
+static void imb_exr_header_metadata_to_imbuf(const Header &header, struct ImBuf *ibuf)
+{
+  IMB_metadata_ensure(&ibuf->metadata);
+  for (Header::ConstIterator iter = header.begin(); iter != header.end(); iter++) {
+    const StringAttribute *attr = header.findTypedAttribute<StringAttribute>(iter.name());
+
+    /* not all attributes are string attributes so we might get some NULLs here */
+    if (attr) {
+      IMB_metadata_set_field(ibuf->metadata, iter.name(), attr->value().c_str());
+      ibuf->flags |= IB_metadata;
+    }
+  }
+}
+
 static void openexr_header_metadata_callback(void *data,
                                              const char *propname,
                                              char *prop,
@@ -736,7 +752,8 @@ struct ExrLayer {
   ListBase passes;
 };
 
-static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data);
+static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data, bool alloc_passes);
+static void imb_exr_pass_assign_rect(ExrHandle *data, ExrPass *pass, float *rect);
 
 /* ********************** */
 
@@ -1012,12 +1029,11 @@ void IMB_exrtile_begin_write(
   }
 }
 
-bool IMB_exr_begin_read(
-    void *handle, const char *filepath, int *width, int *height, const bool parse_channels)
+static bool imb_exr_begin_read_file(ExrHandle *data,
+                                    const char *filepath,
+                                    int *width,
+                                    int *height)
 {
-  ExrHandle *data = (ExrHandle *)handle;
-  ExrChannel *echan;
-
   /* 32 is arbitrary, but zero length files crashes exr. */
   if (!(BLI_exists(filepath) && BLI_file_size(filepath) > 32)) {
     return false;
@@ -1044,9 +1060,22 @@ bool IMB_exr_begin_read(
   data->width = *width = dw.max.x - dw.min.x + 1;
   data->height = *height = dw.max.y - dw.min.y + 1;
 
+  return true;
+}
+
+bool IMB_exr_begin_read(
+    void *handle, const char *filepath, int *width, int *height, const bool parse_channels)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  ExrChannel *echan;
+
+  if (!imb_exr_begin_read_file(data, filepath, width, height)) {
+    return false;
+  }
+
   if (parse_channels) {
     /* Parse channels into view/layer/pass. */
-    if (!imb_exr_multilayer_parse_channels_from_file(data)) {
+    if (!imb_exr_multilayer_parse_channels_from_file(data, true)) {
       return false;
     }
   }
@@ -1072,6 +1101,51 @@ bool IMB_exr_begin_read(
   return true;
 }
 
+bool IMB_exr_begin_read_layers(void *handle, const char *filepath, int *width, int *height)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  if (!imb_exr_begin_read_file(data, filepath, width, height)) {
+    return false;
+  }
+  if (!imb_exr_is_multi(*data->ifile)) {
+    return false;
+  }
+
+  return imb_exr_multilayer_parse_channels_from_file(data, false);
+}
+
+bool IMB_exr_read_pass(void *handle,
+                       const char *layname,
+                       const char *passname,
+                       const char *viewname,
+                       float *rect)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  ExrLayer *lay = (ExrLayer *)BLI_findstring(&data->layers, layname, offsetof(ExrLayer, name));
+  if (lay == nullptr) {
+    return false;
+  }
+
+  LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
+    if (pass->totchan && STREQ(pass->internal_name, passname) && STREQ(pass->view, viewname)) {
+      imb_exr_pass_assign_rect(data, pass, rect);
+      IMB_exr_read_channels(handle);
+      imb_exr_pass_assign_rect(data, pass, nullptr);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void IMB_exr_read_metadata(void *handle, struct ImBuf *ibuf)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  imb_exr_header_metadata_to_imbuf(data->ifile->header(0), ibuf);
+}
+
 void IMB_exr_set_channel(
     void *handle, const char *layname, const char *passname, int xstride, int ystride, float *rect)
 {
@@ -1155,6 +1229,26 @@ void IMB_exr_clear_channels(void *handle)
   BLI_freelistN(&data->channels);
 }
 
+struct ExrHalfConvertData {
+  const float *rect;
+  half *rect_half;
+  int xstride;
+  int width;
+};
+
+static void exr_half_convert_row(void *__restrict userdata,
+                                 const int y,
+                                 const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ExrHalfConvertData *data = static_cast<const ExrHalfConvertData *>(userdata);
+  const size_t offset = size_t(y) * data->width;
+  const float *rect = data->rect + offset * data->xstride;
+  half *cur = data->rect_half + offset;
+  for (int x = 0; x < data->width; x++, cur++) {
+    *cur = float_to_half_safe(rect[size_t(x) * data->xstride]);
+  }
+}
+
 void IMB_exr_write_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1175,11 +1269,14 @@ void IMB_exr_write_channels(void *handle)
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scan-line, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
+        /* Convert rows in parallel, compression is already multi-threaded by OpenEXR. */
+        ExrHalfConvertData convert_data = {
+            echan->rect, current_rect_half, echan->xstride, data->width};
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.min_iter_per_thread = 16;
+        BLI_task_parallel_range(0, data->height, &convert_data, exr_half_convert_row, &settings);
+
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -1293,6 +1390,7 @@ void IMB_exr_read_channels(void *handle)
     /* Insert all matching channel into frame-buffer. */
     FrameBuffer frameBuffer;
     ExrChannel *echan;
+    bool has_channels_to_read = false;
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       if (echan->m->part_number != i) {
@@ -1324,12 +1422,19 @@ void IMB_exr_read_channels(void *handle)
 
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+        has_channels_to_read = true;
       }
       else {
-        printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
+        /* Only some of the channels are read, for example a single pass or render layer. */
+        exr_printf("channel with no rect set %s\n", echan->m->internal_name.c_str());
       }
     }
 
+    /* Don't decompress parts, like other views, that none of the requested channels are in. */
+    if (!has_channels_to_read) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -1584,7 +1689,64 @@ static ExrPass *imb_exr_get_pass(ListBase *lb, char *passname)
   return pass;
 }
 
-static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
+/* Point the channels of the pass to their interleaved pixels in the given pass buffer, which can
+ * be null to only set the channel ids of the pass. */
+static void imb_exr_pass_assign_rect(ExrHandle *data, ExrPass *pass, float *rect)
+{
+  if (pass->totchan == 1) {
+    ExrChannel *echan = pass->chan[0];
+    echan->rect = rect;
+    echan->xstride = 1;
+    echan->ystride = data->width;
+    pass->chan_id[0] = echan->chan_id;
+  }
+  else {
+    char lookup[256];
+
+    memset(lookup, 0, sizeof(lookup));
+
+    /* we can have RGB(A), XYZ(W), UVA */
+    if (ELEM(pass->totchan, 3, 4)) {
+      if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
+          pass->chan[2]->chan_id == 'B') {
+        lookup[uint('R')] = 0;
+        lookup[uint('G')] = 1;
+        lookup[uint('B')] = 2;
+        lookup[uint('A')] = 3;
+      }
+      else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
+               pass->chan[2]->chan_id == 'Y') {
+        lookup[uint('X')] = 0;
+        lookup[uint('Y')] = 1;
+        lookup[uint('Z')] = 2;
+        lookup[uint('W')] = 3;
+      }
+      else {
+        lookup[uint('U')] = 0;
+        lookup[uint('V')] = 1;
+        lookup[uint('A')] = 2;
+      }
+      for (int a = 0; a < pass->totchan; a++) {
+        ExrChannel *echan = pass->chan[a];
+        echan->rect = rect ? rect + lookup[uint(echan->chan_id)] : nullptr;
+        echan->xstride = pass->totchan;
+        echan->ystride = data->width * pass->totchan;
+        pass->chan_id[uint(lookup[uint(echan->chan_id)])] = echan->chan_id;
+      }
+    }
+    else { /* unknown */
+      for (int a = 0; a < pass->totchan; a++) {
+        ExrChannel *echan = pass->chan[a];
+        echan->rect = rect ? rect + a : nullptr;
+        echan->xstride = pass->totchan;
+        echan->ystride = data->width * pass->totchan;
+        pass->chan_id[a] = echan->chan_id;
+      }
+    }
+  }
+}
+
+static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data, const bool alloc_passes)
 {
   std::vector<MultiViewChannelName> channels;
   GetChannelsInMultiPartFile(*data->ifile, channels);
@@ -1643,59 +1805,11 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
   for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
     for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
       if (pass->totchan) {
-        pass->rect = (float *)MEM_callocN(
-            data->width * data->height * pass->totchan * sizeof(float), "pass rect");
-        if (pass->totchan == 1) {
-          ExrChannel *echan = pass->chan[0];
-          echan->rect = pass->rect;
-          echan->xstride = 1;
-          echan->ystride = data->width;
-          pass->chan_id[0] = echan->chan_id;
-        }
-        else {
-          char lookup[256];
-
-          memset(lookup, 0, sizeof(lookup));
-
-          /* we can have RGB(A), XYZ(W), UVA */
-          if (ELEM(pass->totchan, 3, 4)) {
-            if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
-                pass->chan[2]->chan_id == 'B') {
-              lookup[uint('R')] = 0;
-              lookup[uint('G')] = 1;
-              lookup[uint('B')] = 2;
-              lookup[uint('A')] = 3;
-            }
-            else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
-                     pass->chan[2]->chan_id == 'Y') {
-              lookup[uint('X')] = 0;
-              lookup[uint('Y')] = 1;
-              lookup[uint('Z')] = 2;
-              lookup[uint('W')] = 3;
-            }
-            else {
-              lookup[uint('U')] = 0;
-              lookup[uint('V')] = 1;
-              lookup[uint('A')] = 2;
-            }
-            for (int a = 0; a < pass->totchan; a++) {
-              echan = pass->chan[a];
-              echan->rect = pass->rect + lookup[uint(echan->chan_id)];
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
-              pass->chan_id[uint(lookup[uint(echan->chan_id)])] = echan->chan_id;
-            }
-          }
-          else { /* unknown */
-            for (int a = 0; a < pass->totchan; a++) {
-              ExrChannel *echan = pass->chan[a];
-              echan->rect = pass->rect + a;
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
-              pass->chan_id[a] = echan->chan_id;
-            }
-          }
+        if (alloc_passes) {
+          pass->rect = (float *)MEM_callocN(
+              data->width * data->height * pass->totchan * sizeof(float), "pass rect");
         }
+        imb_exr_pass_assign_rect(data, pass, pass->rect);
       }
     }
   }
@@ -1717,7 +1831,7 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
   data->width = width;
   data->height = height;
 
-  if (!imb_exr_multilayer_parse_channels_from_file(data)) {
+  if (!imb_exr_multilayer_parse_channels_from_file(data, true)) {
     IMB_exr_close(data);
     return nullptr;
   }
@@ -2015,20 +2129,7 @@ struct ImBuf *imb_load_openexr(const uchar *mem,
       if (!(flags & IB_test)) {
 
         if (flags & IB_metadata) {
-          const Header &header = file->header(0);
-          Header::ConstIterator iter;
-
-          IMB_metadata_ensure(&ibuf->metadata);
-          for (iter = header.begin(); iter != header.end(); iter++) {
-            const StringAttribute *attr = file->header(0).findTypedAttribute<StringAttribute>(
-                iter.name());
-
-            /* not all attributes are string attributes so we might get some NULLs here */
-            if (attr) {
-              IMB_metadata_set_field(ibuf->metadata, iter.name(), attr->value().c_str());
-              ibuf->flags |= IB_metadata;
-            }
-          }
+          imb_exr_header_metadata_to_imbuf(file->header(0), ibuf);
         }
 
         /* Only enters with IB_multilayer flag set. */
@@ -36,6 +36,24 @@ bool IMB_exr_begin_read(void * /*handle*/,
 {
   return false;
 }
+bool IMB_exr_begin_read_layers(void * /*handle*/,
+                               const char * /*filepath*/,
+                               int * /*width*/,
+                               int * /*height*/)
+{
+  return false;
+}
+bool IMB_exr_read_pass(void * /*handle*/,
+                       const char * /*layname*/,
+                       const char * /*passname*/,
+                       const char * /*viewname*/,
+                       float * /*rect*/)
+{
+  return false;
+}
+void IMB_exr_read_metadata(void * /*handle*/, struct ImBuf * /*ibuf*/)
+{
+}
 bool IMB_exr_begin_write(void * /*handle*/,
                          const char * /*filepath*/,
                          int /*width*/,
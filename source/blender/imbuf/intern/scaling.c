@@ -9,6 +9,7 @@
 
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -875,497 +876,362 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+/* Lines of pixels scaled along their length by the separable scaling passes below, either the
+ * rows or the columns of the image. */
+typedef struct ScaleLinesData {
+  const uchar *rect;
+  const float *rectf;
+  uchar *newrect;
+  float *newrectf;
+
+  /* Offsets in channels between the first pixels of two consecutive lines of the source and
+   * destination buffers, and between two consecutive pixels of a line of both buffers. */
+  size_t src_line_step;
+  size_t dst_line_step;
+  size_t pixel_step;
+
+  int src_len;
+  int dst_len;
+  float add;
+} ScaleLinesData;
+
+static void scale_lines_parallel(ScaleLinesData *data, int num_lines, TaskParallelRangeFunc func)
 {
-  const bool do_rect = (ibuf->rect != NULL);
-  const bool do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)num_lines * data->dst_len) > 256 * 256;
+  BLI_task_parallel_range(0, num_lines, data, func, &settings);
+}
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+static void scaledown_line_byte(
+    const uchar *src, uchar *dst, const size_t step, const int src_len, const ScaleLinesData *data)
+{
+  const uchar *src_start = src;
+  const float add = data->add;
+  float sample = 0.0f;
+  float val[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  float nval[4];
+
+  for (int i = 0; i < data->dst_len; i++) {
+    for (int c = 0; c < 4; c++) {
+      nval[c] = -val[c] * sample;
+    }
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
+    sample += add;
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+      for (int c = 0; c < 4; c++) {
+        nval[c] += src[c];
       }
-      return ibuf;
+      src += step;
     }
-  }
 
-  add = (ibuf->x - 0.01) / newx;
+    for (int c = 0; c < 4; c++) {
+      val[c] = src[c];
+      dst[c] = roundf((nval[c] + sample * val[c]) / add);
+    }
+    src += step;
+    dst += step;
 
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
+    sample -= 1.0f;
   }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
-  }
-
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
-
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += 4;
-      }
-      if (do_float) {
+  BLI_assert(src == src_start + step * src_len); /* see bug T26502. */
+  UNUSED_VARS_NDEBUG(src_start, src_len);
+}
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+static void scaledown_line_float(
+    const float *src, float *dst, const size_t step, const int src_len, const ScaleLinesData *data)
+{
+  const float *src_start = src;
+  const float add = data->add;
+  float sample = 0.0f;
+  float val[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  float nval[4];
+
+  for (int i = 0; i < data->dst_len; i++) {
+    for (int c = 0; c < 4; c++) {
+      nval[c] = -val[c] * sample;
+    }
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+    sample += add;
 
-        newrectf += 4;
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+      for (int c = 0; c < 4; c++) {
+        nval[c] += src[c];
       }
+      src += step;
+    }
 
-      sample -= 1.0f;
+    for (int c = 0; c < 4; c++) {
+      val[c] = src[c];
+      dst[c] = (nval[c] + sample * val[c]) / add;
     }
-  }
+    src += step;
+    dst += step;
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    sample -= 1.0f;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
-  ibuf->x = newx;
-  return ibuf;
+  BLI_assert(src == src_start + step * src_len); /* see bug T26502. */
+  UNUSED_VARS_NDEBUG(src_start, src_len);
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+static void scaledown_lines_fn(void *__restrict userdata,
+                               const int line,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  const bool do_rect = (ibuf->rect != NULL);
-  const bool do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
+  const ScaleLinesData *data = userdata;
+  if (data->newrect) {
+    scaledown_line_byte(data->rect + line * data->src_line_step,
+                        data->newrect + line * data->dst_line_step,
+                        data->pixel_step,
+                        data->src_len,
+                        data);
+  }
+  if (data->newrectf) {
+    scaledown_line_float(data->rectf + line * data->src_line_step,
+                         data->newrectf + line * data->dst_line_step,
+                         data->pixel_step,
+                         data->src_len,
+                         data);
+  }
+}
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
+static void scaleup_line_byte(const uchar *src,
+                              uchar *dst,
+                              const size_t step,
+                              const int src_len,
+                              const ScaleLinesData *data)
+{
+  /* Special case, copy the single pixel, needed since the scaling logic assumes there is at
+   * least two pixels to interpolate between causing out of bounds read for 1px images,
+   * see T70356. */
+  if (UNLIKELY(src_len == 1)) {
+    for (int i = 0; i < data->dst_len; i++) {
+      memcpy(dst, src, sizeof(char[4]));
+      dst += step;
+    }
+    return;
+  }
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  const float add = data->add;
+  float sample = 0.0f;
+  float val[4], nval[4], diff[4];
 
-  if (!do_rect && !do_float) {
-    return ibuf;
+  for (int c = 0; c < 4; c++) {
+    val[c] = src[c];
+    nval[c] = src[step + c];
+    diff[c] = nval[c] - val[c];
+    val[c] += 0.5f;
   }
+  src += 2 * step;
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+  for (int i = 0; i < data->dst_len; i++) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
+      for (int c = 0; c < 4; c++) {
+        val[c] = nval[c];
+        nval[c] = src[c];
+        diff[c] = nval[c] - val[c];
+        val[c] += 0.5f;
       }
-      return ibuf;
+      src += step;
     }
+    for (int c = 0; c < 4; c++) {
+      dst[c] = val[c] + sample * diff[c];
+    }
+    dst += step;
+    sample += add;
   }
+}
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
+static void scaleup_line_float(const float *src,
+                               float *dst,
+                               const size_t step,
+                               const int src_len,
+                               const ScaleLinesData *data)
+{
+  /* Special case, see #scaleup_line_byte. */
+  if (UNLIKELY(src_len == 1)) {
+    for (int i = 0; i < data->dst_len; i++) {
+      memcpy(dst, src, sizeof(float[4]));
+      dst += step;
     }
+    return;
+  }
 
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+  const float add = data->add;
+  float sample = 0.0f;
+  float val[4], nval[4], diff[4];
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+  for (int c = 0; c < 4; c++) {
+    val[c] = src[c];
+    nval[c] = src[step + c];
+    diff[c] = nval[c] - val[c];
+  }
+  src += 2 * step;
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += skipx;
+  for (int i = 0; i < data->dst_len; i++) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
+      for (int c = 0; c < 4; c++) {
+        val[c] = nval[c];
+        nval[c] = src[c];
+        diff[c] = nval[c] - val[c];
       }
-      if (do_float) {
-
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+      src += step;
+    }
+    for (int c = 0; c < 4; c++) {
+      dst[c] = val[c] + sample * diff[c];
+    }
+    dst += step;
+    sample += add;
+  }
+}
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+static void scaleup_lines_fn(void *__restrict userdata,
+                             const int line,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleLinesData *data = userdata;
+  if (data->newrect) {
+    scaleup_line_byte(data->rect + line * data->src_line_step,
+                      data->newrect + line * data->dst_line_step,
+                      data->pixel_step,
+                      data->src_len,
+                      data);
+  }
+  if (data->newrectf) {
+    scaleup_line_float(data->rectf + line * data->src_line_step,
+                       data->newrectf + line * data->dst_line_step,
+                       data->pixel_step,
+                       data->src_len,
+                       data);
+  }
+}
 
-        newrectf += skipx;
-      }
+/* Allocate the scaled buffers of the image, returns false when out of memory. */
+static bool scale_alloc_buffers(const ImBuf *ibuf,
+                                ScaleLinesData *data,
+                                const size_t newlen,
+                                const char *name)
+{
+  data->rect = (const uchar *)ibuf->rect;
+  data->rectf = ibuf->rect_float;
+  data->newrect = NULL;
+  data->newrectf = NULL;
 
-      sample -= 1.0f;
+  if (ibuf->rect) {
+    data->newrect = MEM_mallocN(sizeof(uchar[4]) * newlen, name);
+    if (data->newrect == NULL) {
+      return false;
+    }
+  }
+  if (ibuf->rect_float) {
+    data->newrectf = MEM_mallocN(sizeof(float[4]) * newlen, name);
+    if (data->newrectf == NULL) {
+      MEM_SAFE_FREE(data->newrect);
+      return false;
     }
   }
+  return true;
+}
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
+static void scale_swap_buffers(ImBuf *ibuf, ScaleLinesData *data)
+{
+  if (data->newrect) {
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
+    ibuf->rect = (uint *)data->newrect;
   }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
+  if (data->newrectf) {
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = data->newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->y = newy;
-  return ibuf;
 }
 
-static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  int x, y;
-  bool do_rect = false, do_float = false;
+  ScaleLinesData data;
 
-  if (ibuf == NULL) {
-    return NULL;
-  }
   if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
     return ibuf;
   }
-
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaleupxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
-
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  /* Special case, copy all columns, needed since the scaling logic assumes there is at least
-   * two rows to interpolate between causing out of bounds read for 1px images, see T70356. */
-  if (UNLIKELY(ibuf->x == 1)) {
-    if (do_rect) {
-      for (y = ibuf->y; y > 0; y--) {
-        for (x = newx; x > 0; x--) {
-          memcpy(newrect, rect, sizeof(char[4]));
-          newrect += 4;
-        }
-        rect += 4;
-      }
-    }
-    if (do_float) {
-      for (y = ibuf->y; y > 0; y--) {
-        for (x = newx; x > 0; x--) {
-          memcpy(newrectf, rectf, sizeof(float[4]));
-          newrectf += 4;
-        }
-        rectf += 4;
-      }
-    }
+  if (!scale_alloc_buffers(ibuf, &data, (size_t)newx * ibuf->y, "scaledownx")) {
+    return ibuf;
   }
-  else {
-    const float add = (ibuf->x - 1.001) / (newx - 1.0);
-    float sample;
 
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
+  data.src_line_step = 4 * (size_t)ibuf->x;
+  data.dst_line_step = 4 * (size_t)newx;
+  data.pixel_step = 4;
+  data.src_len = ibuf->x;
+  data.dst_len = newx;
+  data.add = (ibuf->x - 0.01) / newx;
+  scale_lines_parallel(&data, ibuf->y, scaledown_lines_fn);
 
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (y = ibuf->y; y > 0; y--) {
+  scale_swap_buffers(ibuf, &data);
+  ibuf->x = newx;
+  return ibuf;
+}
 
-      sample = 0;
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  ScaleLinesData data;
 
-      if (do_rect) {
-        val_a = rect[0];
-        nval_a = rect[4];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[5];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[6];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[7];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 8;
-      }
-      if (do_float) {
-        val_af = rectf[0];
-        nval_af = rectf[4];
-        diff_af = nval_af - val_af;
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return ibuf;
+  }
+  if (!scale_alloc_buffers(ibuf, &data, (size_t)newy * ibuf->x, "scaledowny")) {
+    return ibuf;
+  }
 
-        val_bf = rectf[1];
-        nval_bf = rectf[5];
-        diff_bf = nval_bf - val_bf;
+  data.src_line_step = 4;
+  data.dst_line_step = 4;
+  data.pixel_step = 4 * (size_t)ibuf->x;
+  data.src_len = ibuf->y;
+  data.dst_len = newy;
+  data.add = (ibuf->y - 0.01) / newy;
+  scale_lines_parallel(&data, ibuf->x, scaledown_lines_fn);
 
-        val_gf = rectf[2];
-        nval_gf = rectf[6];
-        diff_gf = nval_gf - val_gf;
+  scale_swap_buffers(ibuf, &data);
+  ibuf->y = newy;
+  return ibuf;
+}
 
-        val_rf = rectf[3];
-        nval_rf = rectf[7];
-        diff_rf = nval_rf - val_rf;
+static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
+{
+  ScaleLinesData data;
 
-        rectf += 8;
-      }
-      for (x = newx; x > 0; x--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += 4;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += 4;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += 4;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += 4;
-        }
-        sample += add;
-      }
-    }
+  if (ibuf == NULL) {
+    return NULL;
   }
-
-  if (do_rect) {
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return ibuf;
   }
-  if (do_float) {
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+  if (!scale_alloc_buffers(ibuf, &data, (size_t)newx * ibuf->y, "scaleupx")) {
+    return ibuf;
   }
 
+  data.src_line_step = 4 * (size_t)ibuf->x;
+  data.dst_line_step = 4 * (size_t)newx;
+  data.pixel_step = 4;
+  data.src_len = ibuf->x;
+  data.dst_len = newx;
+  data.add = (ibuf->x - 1.001) / (newx - 1.0);
+  scale_lines_parallel(&data, ibuf->y, scaleup_lines_fn);
+
+  scale_swap_buffers(ibuf, &data);
   ibuf->x = newx;
   return ibuf;
 }
 
 static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  int x, y, skipx;
-  bool do_rect = false, do_float = false;
+  ScaleLinesData data;
 
   if (ibuf == NULL) {
     return NULL;
@@ -1373,192 +1239,19 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
   if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
     return ibuf;
   }
-
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(sizeof(float[4]) * ibuf->x * newy, "scaleupyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
-
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  skipx = 4 * ibuf->x;
-
-  /* Special case, copy all rows, needed since the scaling logic assumes there is at least
-   * two rows to interpolate between causing out of bounds read for 1px images, see T70356. */
-  if (UNLIKELY(ibuf->y == 1)) {
-    if (do_rect) {
-      for (y = newy; y > 0; y--) {
-        memcpy(newrect, rect, sizeof(char) * skipx);
-        newrect += skipx;
-      }
-    }
-    if (do_float) {
-      for (y = newy; y > 0; y--) {
-        memcpy(newrectf, rectf, sizeof(float) * skipx);
-        newrectf += skipx;
-      }
-    }
+  if (!scale_alloc_buffers(ibuf, &data, (size_t)newy * ibuf->x, "scaleupy")) {
+    return ibuf;
   }
-  else {
-    const float add = (ibuf->y - 1.001) / (newy - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (x = ibuf->x; x > 0; x--) {
-      sample = 0;
-      if (do_rect) {
-        rect = ((uchar *)ibuf->rect) + 4 * (x - 1);
-        newrect = _newrect + 4 * (x - 1);
-
-        val_a = rect[0];
-        nval_a = rect[skipx];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[skipx + 1];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[skipx + 2];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[skipx + 3];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 2 * skipx;
-      }
-      if (do_float) {
-        rectf = ibuf->rect_float + 4 * (x - 1);
-        newrectf = _newrectf + 4 * (x - 1);
-
-        val_af = rectf[0];
-        nval_af = rectf[skipx];
-        diff_af = nval_af - val_af;
 
-        val_bf = rectf[1];
-        nval_bf = rectf[skipx + 1];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[skipx + 2];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[skipx + 3];
-        diff_rf = nval_rf - val_rf;
-
-        rectf += 2 * skipx;
-      }
-
-      for (y = newy; y > 0; y--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += skipx;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += skipx;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += skipx;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += skipx;
-        }
-        sample += add;
-      }
-    }
-  }
-
-  if (do_rect) {
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
-  }
-  if (do_float) {
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
-  }
+  data.src_line_step = 4;
+  data.dst_line_step = 4;
+  data.pixel_step = 4 * (size_t)ibuf->x;
+  data.src_len = ibuf->y;
+  data.dst_len = newy;
+  data.add = (ibuf->y - 1.001) / (newy - 1.0);
+  scale_lines_parallel(&data, ibuf->x, scaleup_lines_fn);
 
+  scale_swap_buffers(ibuf, &data);
   ibuf->y = newy;
   return ibuf;
 }
@@ -1673,22 +1366,54 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastData {
+  const ImBuf *ibuf;
+  uint *newrect;
+  struct imbufRGBA *newrectf;
+  int newx;
+  size_t stepx, stepy;
+} ScaleFastData;
+
+static void scalefast_row_fn(void *__restrict userdata,
+                             const int y,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleFastData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const size_t ofsy = 32768 + y * data->stepy;
+  const size_t src_offset = (ofsy >> 16) * ibuf->x;
+  const size_t dst_offset = (size_t)y * data->newx;
+  size_t ofsx;
+  int x;
+
+  if (data->newrect) {
+    const uint *rect = ibuf->rect + src_offset;
+    uint *newrect = data->newrect + dst_offset;
+    ofsx = 32768;
+
+    for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+      *newrect++ = rect[ofsx >> 16];
+    }
+  }
+
+  if (data->newrectf) {
+    const struct imbufRGBA *rectf = (const struct imbufRGBA *)ibuf->rect_float + src_offset;
+    struct imbufRGBA *newrectf = data->newrectf + dst_offset;
+    ofsx = 32768;
+
+    for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+      *newrectf++ = rectf[ofsx >> 16];
+    }
+  }
+}
+
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, uint newx, uint newy)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
 
-  uint *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
+  uint *_newrect = NULL;
+  struct imbufRGBA *_newrectf = NULL;
   bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
-
-  rect = NULL;
-  _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
-  _newrectf = NULL;
-  newrectf = NULL;
 
   if (ibuf == NULL) {
     return false;
@@ -1712,7 +1437,6 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, uint newx, uint newy)
     if (_newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
   if (do_float) {
@@ -1723,34 +1447,20 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, uint newx, uint newy)
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
-  stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
-  stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
-  ofsy = 32768;
+  ScaleFastData data;
+  data.ibuf = ibuf;
+  data.newrect = _newrect;
+  data.newrectf = _newrectf;
+  data.newx = newx;
+  data.stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
+  data.stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
 
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
-
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)newx * newy) > 256 * 256;
+  BLI_task_parallel_range(0, newy, &data, scalefast_row_fn, &settings);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
@@ -8,8 +8,12 @@
 #include "abc_hierarchy_iterator.h"
 #include "intern/abc_axis_conversion.h"
 
+#include <atomic>
+
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_attribute.hh"
@@ -380,9 +384,11 @@ bool ABCGenericMeshWriter::get_velocities(struct Mesh *mesh, std::vector<Imath::
   vels.clear();
   vels.resize(totverts);
 
-  for (int i = 0; i < totverts; i++) {
-    copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
-  }
+  threading::parallel_for(IndexRange(totverts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
+    }
+  });
 
   return true;
 }
@@ -431,15 +437,33 @@ void ABCGenericMeshWriter::get_geo_groups(Object *object,
 
 /* NOTE: Alembic's polygon winding order is clockwise, to match with Renderman. */
 
+/**
+ * Get the offset of the first corner of each polygon in the exported face corner arrays, with the
+ * total number of corners as last element.
+ */
+static Array<int> get_poly_corner_offsets(const Span<MPoly> polys)
+{
+  Array<int> offsets(polys.size() + 1);
+  int offset = 0;
+  for (const int i : polys.index_range()) {
+    offsets[i] = offset;
+    offset += polys[i].totloop;
+  }
+  offsets.last() = offset;
+  return offsets;
+}
+
 static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
 {
   points.clear();
   points.resize(mesh->totvert);
 
   const Span<MVert> verts = mesh->verts();
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
-  }
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -449,26 +473,35 @@ static void get_topology(struct Mesh *mesh,
 {
   const Span<MPoly> polys = mesh->polys();
   const Span<MLoop> loops = mesh->loops();
-  r_has_flat_shaded_poly = false;
+  const Array<int> offsets = get_poly_corner_offsets(polys);
 
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(loops.size());
-  loop_counts.reserve(polys.size());
+  poly_verts.resize(offsets.last());
+  loop_counts.resize(polys.size());
 
   /* NOTE: data needs to be written in the reverse order. */
-  for (const int i : polys.index_range()) {
-    const MPoly &poly = polys[i];
-    loop_counts.push_back(poly.totloop);
+  std::atomic<bool> has_flat_shaded_poly = false;
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    bool has_flat_shaded_poly_in_range = false;
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      loop_counts[i] = poly.totloop;
 
-    r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+      has_flat_shaded_poly_in_range |= (poly.flag & ME_SMOOTH) == 0;
 
-    const MLoop *loop = &loops[poly.loopstart + (poly.totloop - 1)];
+      const MLoop *loop = &loops[poly.loopstart + (poly.totloop - 1)];
+      int32_t *dst = &poly_verts[offsets[i]];
 
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
+      for (int j = 0; j < poly.totloop; j++, loop--) {
+        dst[j] = loop->v;
+      }
     }
-  }
+    if (has_flat_shaded_poly_in_range) {
+      has_flat_shaded_poly = true;
+    }
+  });
+  r_has_flat_shaded_poly = has_flat_shaded_poly;
 }
 
 static void get_edge_creases(struct Mesh *mesh,
@@ -541,16 +574,19 @@ static void get_loop_normals(struct Mesh *mesh,
   normals.resize(mesh->totloop);
 
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
   const Span<MPoly> polys = mesh->polys();
-
-  for (const int i : polys.index_range()) {
-    const MPoly *mp = &polys[i];
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  const Array<int> offsets = get_poly_corner_offsets(polys);
+
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &polys[i];
+      int abc_index = offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
@@ -16,7 +16,9 @@
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_base.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
@@ -61,23 +63,32 @@ static void get_uvs(const CDStreamConfig &config,
   MLoop *mloop = config.mloop;
 
   if (!config.pack_uvs) {
-    int count = 0;
     uvidx.resize(config.totloop);
     uvs.resize(config.totloop);
 
-    /* Iterate in reverse order to match exported polygons. */
+    Array<int> offsets(num_poly);
+    int offset = 0;
     for (int i = 0; i < num_poly; i++) {
-      MPoly &current_poly = mpoly[i];
-      const MLoopUV *loopuv = mloopuv_array + current_poly.loopstart + current_poly.totloop;
-
-      for (int j = 0; j < current_poly.totloop; j++, count++) {
-        loopuv--;
+      offsets[i] = offset;
+      offset += mpoly[i].totloop;
+    }
 
-        uvidx[count] = count;
-        uvs[count][0] = loopuv->uv[0];
-        uvs[count][1] = loopuv->uv[1];
+    /* Iterate in reverse order to match exported polygons. */
+    threading::parallel_for(IndexRange(num_poly), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        const MPoly &current_poly = mpoly[i];
+        const MLoopUV *loopuv = mloopuv_array + current_poly.loopstart + current_poly.totloop;
+        int count = offsets[i];
+
+        for (int j = 0; j < current_poly.totloop; j++, count++) {
+          loopuv--;
+
+          uvidx[count] = count;
+          uvs[count][0] = loopuv->uv[0];
+          uvs[count][1] = loopuv->uv[1];
+        }
       }
-    }
+    });
   }
   else {
     /* Mapping for indexed UVs, deduplicating UV coordinates at vertices. */
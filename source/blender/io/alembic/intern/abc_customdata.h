@@ -52,6 +52,8 @@ struct CDStreamConfig {
   Alembic::Abc::chrono_t time;
   int timesample_index;
   bool use_vertex_interpolation;
+  /* The mesh already has the faces of the sample, so only their corner data is read. */
+  bool use_existing_topology;
   Alembic::AbcGeom::index_t index;
   Alembic::AbcGeom::index_t ceil_index;
 
@@ -81,6 +83,7 @@ struct CDStreamConfig {
         add_customdata_cb(NULL),
         weight(0.0),
         time(0.0),
+        use_existing_topology(false),
         index(0),
         ceil_index(0),
         modifier_error_message(NULL)
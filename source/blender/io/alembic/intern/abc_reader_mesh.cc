@@ -10,6 +10,7 @@
 #include "abc_util.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "MEM_guardedalloc.h"
 
@@ -24,6 +25,7 @@
 #include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.h"
@@ -127,15 +129,17 @@ static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &ceil_positions,
                                const double weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
-
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
-    copy_zup_from_yup(mvert.co, tmp);
-  }
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](const IndexRange range) {
+    float tmp[3];
+    for (const int64_t i : range) {
+      MVert &mvert = mverts[i];
+      const Imath::V3f &floor_pos = (*positions)[i];
+      const Imath::V3f &ceil_pos = (*ceil_positions)[i];
+
+      interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
+      copy_zup_from_yup(mvert.co, tmp);
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -156,18 +160,22 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 void read_mverts(Mesh &mesh, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
   MutableSpan<MVert> verts = mesh.verts_for_write();
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = verts[i];
-    Imath::V3f pos_in = (*positions)[i];
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      MVert &mvert = verts[i];
+      Imath::V3f pos_in = (*positions)[i];
 
-    copy_zup_from_yup(mvert.co, pos_in.getValue());
-  }
+      copy_zup_from_yup(mvert.co, pos_in.getValue());
+    }
+  });
   if (normals) {
     float(*vert_normals)[3] = BKE_mesh_vertex_normals_for_write(&mesh);
-    for (const int64_t i : IndexRange(normals->size())) {
-      Imath::V3f nor_in = (*normals)[i];
-      copy_zup_from_yup(vert_normals[i], nor_in.getValue());
-    }
+    threading::parallel_for(IndexRange(normals->size()), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        Imath::V3f nor_in = (*normals)[i];
+        copy_zup_from_yup(vert_normals[i], nor_in.getValue());
+      }
+    });
     BKE_mesh_vertex_normals_clear_dirty(&mesh);
   }
 }
@@ -188,6 +196,11 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   const bool do_uvs = (mloopuvs && uvs && uvs_indices);
   const bool do_uvs_per_loop = do_uvs && mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
   BLI_assert(!do_uvs || mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
+  const bool do_topology = !config.use_existing_topology;
+  if (!do_topology && !do_uvs) {
+    return;
+  }
+
   uint loop_index = 0;
   uint rev_loop_index = 0;
   uint uv_index = 0;
@@ -196,32 +209,38 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   for (int i = 0; i < face_counts->size(); i++) {
     const int face_size = (*face_counts)[i];
 
-    MPoly &poly = mpolys[i];
-    poly.loopstart = loop_index;
-    poly.totloop = face_size;
+    if (do_topology) {
+      MPoly &poly = mpolys[i];
+      poly.loopstart = loop_index;
+      poly.totloop = face_size;
 
-    /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be flat-shaded,
-     * this is encoded in custom loop normals. See T71246. */
-    poly.flag |= ME_SMOOTH;
+      /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be
+       * flat-shaded, this is encoded in custom loop normals. See T71246. */
+      poly.flag |= ME_SMOOTH;
+    }
 
     /* NOTE: Alembic data is stored in the reverse order. */
     rev_loop_index = loop_index + (face_size - 1);
 
     uint last_vertex_index = 0;
     for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
-      MLoop &loop = mloops[rev_loop_index];
-      loop.v = (*face_indices)[loop_index];
+      const uint vertex_index = (*face_indices)[loop_index];
+
+      if (do_topology) {
+        MLoop &loop = mloops[rev_loop_index];
+        loop.v = vertex_index;
 
-      if (f > 0 && loop.v == last_vertex_index) {
-        /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
-         * by invalid geometry in the Alembic file, such as in T76514. */
-        seen_invalid_geometry = true;
+        if (f > 0 && loop.v == last_vertex_index) {
+          /* This face is invalid, as it has consecutive loops from the same vertex. This is
+           * caused by invalid geometry in the Alembic file, such as in T76514. */
+          seen_invalid_geometry = true;
+        }
+        last_vertex_index = loop.v;
       }
-      last_vertex_index = loop.v;
 
       if (do_uvs) {
         MLoopUV &loopuv = mloopuvs[rev_loop_index];
-        uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : loop.v];
+        uv_index = (*uvs_indices)[do_uvs_per_loop ? loop_index : vertex_index];
 
         /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
         if (uv_index >= uvs_size) {
@@ -234,6 +253,10 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     }
   }
 
+  if (!do_topology) {
+    return;
+  }
+
   BKE_mesh_calc_edges(config.mesh, false, false);
   if (seen_invalid_geometry) {
     if (config.modifier_error_message) {
@@ -466,14 +489,52 @@ static void read_velocity(const V3fArraySamplePtr &velocities,
   }
 }
 
+/**
+ * Check if the mesh has the faces #read_mpolys creates from the given sample arrays, so that only
+ * the rest of the data has to be read again for meshes with constant topology.
+ */
+static bool mesh_topology_matches(const Mesh &mesh,
+                                  const Int32ArraySample &face_counts,
+                                  const Int32ArraySample &face_indices)
+{
+  const Span<MPoly> polys = mesh.polys();
+  const Span<MLoop> loops = mesh.loops();
+  if (size_t(polys.size()) != face_counts.size() || size_t(loops.size()) != face_indices.size()) {
+    return false;
+  }
+
+  int loop_index = 0;
+  for (const int i : polys.index_range()) {
+    if (polys[i].loopstart != loop_index || polys[i].totloop != face_counts[i]) {
+      return false;
+    }
+    loop_index += face_counts[i];
+  }
+
+  std::atomic<bool> matches = true;
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      /* NOTE: Alembic data is stored in the reverse order. */
+      const int rev_loop_start = poly.loopstart + poly.totloop - 1;
+      for (int f = 0; f < poly.totloop; f++) {
+        if (loops[rev_loop_start - f].v != uint(face_indices[poly.loopstart + f])) {
+          matches.store(false, std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+  });
+  return matches;
+}
+
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -724,7 +785,11 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  bool use_existing_topology = false;
+
+  if (positions->size() != existing_mesh->totvert ||
+      face_counts->size() != existing_mesh->totpoly ||
+      face_indices->size() != existing_mesh->totloop) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -744,6 +809,10 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
             " mesh. Only vertices will be read!";
       }
     }
+    else if ((settings.read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
+      /* Caches usually don't change their topology, avoid rebuilding the faces and edges then. */
+      use_existing_topology = mesh_topology_matches(*existing_mesh, *face_counts, *face_indices);
+    }
   }
 
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
@@ -751,8 +820,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   CDStreamConfig config = get_config(mesh_to_export, use_vertex_interpolation);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
+  config.use_existing_topology = use_existing_topology;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
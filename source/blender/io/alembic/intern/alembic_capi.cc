@@ -508,6 +508,9 @@ static void import_startjob(void *user_data, short *stop, short *do_update, floa
   chrono_t min_time = std::numeric_limits<chrono_t>::max();
   chrono_t max_time = std::numeric_limits<chrono_t>::min();
 
+  /* The new IDs are sorted by name once they are all created. */
+  BKE_main_id_sort_defer_begin(data->bmain);
+
   ISampleSelector sample_sel(0.0);
   std::vector<AbcObjectReader *>::iterator iter;
   for (iter = data->readers.begin(); iter != data->readers.end(); ++iter) {
@@ -528,11 +531,14 @@ static void import_startjob(void *user_data, short *stop, short *do_update, floa
     *data->do_update = true;
 
     if (G.is_break) {
+      BKE_main_id_sort_defer_end(data->bmain);
       data->was_cancelled = true;
       return;
     }
   }
 
+  BKE_main_id_sort_defer_end(data->bmain);
+
   if (data->settings.set_frame_range) {
     Scene *scene = data->scene;
 
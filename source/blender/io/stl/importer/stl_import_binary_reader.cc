@@ -6,12 +6,17 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <numeric>
 
 #include "BKE_main.h"
 #include "BKE_mesh.h"
 
 #include "BLI_array.hh"
 #include "BLI_memory_utils.hh"
+#include "BLI_mmap.h"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -29,6 +34,49 @@ struct STLBinaryTriangle {
 };
 #pragma pack(pop)
 
+/* Arbitrary but consistent order of positions, equal positions compare equal bit-wise like in
+ * the hashing of #STLMeshHelper. */
+static int compare_positions(const float3 &a, const float3 &b)
+{
+  return memcmp(&a, &b, sizeof(float3));
+}
+
+/**
+ * Merge the corners with equal positions, vertices are numbered in the order of their first
+ * corner, like adding the corners one by one to a set would.
+ */
+static void weld_corners(Span<float3> corner_positions,
+                         MutableSpan<int> r_corner_verts,
+                         Vector<float3> &r_verts)
+{
+  Array<int> sorted_corners(corner_positions.size());
+  std::iota(sorted_corners.begin(), sorted_corners.end(), 0);
+  parallel_sort(sorted_corners.begin(), sorted_corners.end(), [&](const int a, const int b) {
+    const int cmp = compare_positions(corner_positions[a], corner_positions[b]);
+    return cmp < 0 || (cmp == 0 && a < b);
+  });
+
+  /* The first corner of every group of equal positions, which has the lowest index. */
+  Array<int> first_corners(corner_positions.size());
+  int group_first = sorted_corners[0];
+  for (const int corner : sorted_corners) {
+    if (compare_positions(corner_positions[corner], corner_positions[group_first]) != 0) {
+      group_first = corner;
+    }
+    first_corners[corner] = group_first;
+  }
+
+  for (const int corner : corner_positions.index_range()) {
+    const int first_corner = first_corners[corner];
+    if (first_corner == corner) {
+      r_corner_verts[corner] = r_verts.append_and_get_index(corner_positions[corner]);
+    }
+    else {
+      r_corner_verts[corner] = r_corner_verts[first_corner];
+    }
+  }
+}
+
 Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_normals)
 {
   const int chunk_size = 1024;
@@ -43,21 +91,135 @@ Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_
     return BKE_mesh_add(bmain, mesh_name);
   }
 
-  Array<STLBinaryTriangle> tris_buf(chunk_size);
-  STLMeshHelper stl_mesh(num_tris, use_custom_normals);
-  size_t num_read_tris;
-  while ((num_read_tris = fread(tris_buf.data(), sizeof(STLBinaryTriangle), chunk_size, file))) {
-    for (size_t i = 0; i < num_read_tris; i++) {
-      if (use_custom_normals) {
-        stl_mesh.add_triangle(tris_buf[i].v1, tris_buf[i].v2, tris_buf[i].v3, tris_buf[i].normal);
+  /* Read the triangles directly from the mapped file when possible, the caller already checked
+   * that the file size matches the triangles count. */
+  Array<STLBinaryTriangle> tris_buf;
+  const STLBinaryTriangle *file_tris = nullptr;
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  if (mmap_file) {
+    file_tris = reinterpret_cast<const STLBinaryTriangle *>(
+        static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)) + BINARY_HEADER_SIZE +
+        sizeof(uint32_t));
+  }
+  else {
+    tris_buf.reinitialize(num_tris);
+    size_t num_read_tris = 0;
+    while (num_read_tris < num_tris) {
+      const size_t read_num = fread(tris_buf.data() + num_read_tris,
+                                    sizeof(STLBinaryTriangle),
+                                    std::min<size_t>(chunk_size, num_tris - num_read_tris),
+                                    file);
+      if (read_num == 0) {
+        break;
       }
-      else {
-        stl_mesh.add_triangle(tris_buf[i].v1, tris_buf[i].v2, tris_buf[i].v3);
+      num_read_tris += read_num;
+    }
+    num_tris = num_read_tris;
+    file_tris = tris_buf.data();
+  }
+  const Span<STLBinaryTriangle> stl_tris(file_tris, num_tris);
+
+  Array<float3> corner_positions(stl_tris.size() * 3);
+  threading::parallel_for(stl_tris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      corner_positions[3 * i] = stl_tris[i].v1;
+      corner_positions[3 * i + 1] = stl_tris[i].v2;
+      corner_positions[3 * i + 2] = stl_tris[i].v3;
+    }
+  });
+
+  Array<float3> tri_normals;
+  if (use_custom_normals) {
+    tri_normals.reinitialize(stl_tris.size());
+    threading::parallel_for(stl_tris.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        tri_normals[i] = stl_tris[i].normal;
       }
+    });
+  }
+
+  const bool io_error = mmap_file && BLI_mmap_any_io_error(mmap_file);
+  if (mmap_file) {
+    BLI_mmap_free(mmap_file);
+  }
+  if (io_error) {
+    stl_import_report_error(file);
+    return nullptr;
+  }
+
+  Vector<float3> verts;
+  Array<int> corner_verts(corner_positions.size());
+  weld_corners(corner_positions, corner_verts, verts);
+  corner_positions = {};
+
+  /* Vertices of every triangle in increasing order, to find the duplicates regardless of their
+   * winding. Degenerate triangles are removed first, like in #STLMeshHelper::add_triangle. */
+  Array<int3> sorted_tri_verts(stl_tris.size());
+  threading::parallel_for(stl_tris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      int3 tri_verts(corner_verts[3 * i], corner_verts[3 * i + 1], corner_verts[3 * i + 2]);
+      if (tri_verts.x > tri_verts.y) {
+        std::swap(tri_verts.x, tri_verts.y);
+      }
+      if (tri_verts.y > tri_verts.z) {
+        std::swap(tri_verts.y, tri_verts.z);
+      }
+      if (tri_verts.x > tri_verts.y) {
+        std::swap(tri_verts.x, tri_verts.y);
+      }
+      sorted_tri_verts[i] = tri_verts;
+    }
+  });
+
+  Vector<int> valid_tris;
+  valid_tris.reserve(stl_tris.size());
+  for (const int i : stl_tris.index_range()) {
+    const int3 &tri_verts = sorted_tri_verts[i];
+    if (tri_verts.x != tri_verts.y && tri_verts.y != tri_verts.z) {
+      valid_tris.append(i);
+    }
+  }
+  const int degenerate_tris_num = stl_tris.size() - valid_tris.size();
+
+  /* Keep the first of every group of triangles using the same vertices. */
+  Array<int> sorted_tris(valid_tris.as_span());
+  parallel_sort(sorted_tris.begin(), sorted_tris.end(), [&](const int a, const int b) {
+    const int3 &tri_a = sorted_tri_verts[a];
+    const int3 &tri_b = sorted_tri_verts[b];
+    if (tri_a.x != tri_b.x) {
+      return tri_a.x < tri_b.x;
+    }
+    if (tri_a.y != tri_b.y) {
+      return tri_a.y < tri_b.y;
+    }
+    if (tri_a.z != tri_b.z) {
+      return tri_a.z < tri_b.z;
+    }
+    return a < b;
+  });
+  Array<bool> is_duplicate(stl_tris.size(), false);
+  for (const int i : sorted_tris.index_range().drop_front(1)) {
+    if (sorted_tri_verts[sorted_tris[i]] == sorted_tri_verts[sorted_tris[i - 1]]) {
+      is_duplicate[sorted_tris[i]] = true;
+    }
+  }
+
+  Vector<Triangle> tris;
+  tris.reserve(valid_tris.size());
+  Vector<float3> loop_normals;
+  for (const int i : valid_tris) {
+    if (is_duplicate[i]) {
+      continue;
+    }
+    tris.append({corner_verts[3 * i], corner_verts[3 * i + 1], corner_verts[3 * i + 2]});
+    if (use_custom_normals) {
+      loop_normals.append_n_times(tri_normals[i], 3);
     }
   }
+  const int duplicate_tris_num = valid_tris.size() - tris.size();
 
-  return stl_mesh.to_mesh(bmain, mesh_name);
+  return create_mesh_from_triangles(
+      bmain, mesh_name, verts, tris, loop_normals, degenerate_tris_num, duplicate_tris_num);
 }
 
 }  // namespace blender::io::stl
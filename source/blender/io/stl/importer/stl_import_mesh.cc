@@ -62,12 +62,29 @@ void STLMeshHelper::add_triangle(const float3 &a,
 
 Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
 {
-  if (degenerate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << degenerate_tris_num_ << " degenerate triangles were removed"
+  return create_mesh_from_triangles(bmain,
+                                    mesh_name,
+                                    verts_.as_span(),
+                                    tris_.as_span(),
+                                    use_custom_normals_ ? loop_normals_.as_span() : Span<float3>(),
+                                    degenerate_tris_num_,
+                                    duplicate_tris_num_);
+}
+
+Mesh *create_mesh_from_triangles(Main *bmain,
+                                 char *mesh_name,
+                                 Span<float3> verts,
+                                 Span<Triangle> tris,
+                                 Span<float3> loop_normals,
+                                 const int degenerate_tris_num,
+                                 const int duplicate_tris_num)
+{
+  if (degenerate_tris_num > 0) {
+    std::cout << "STL Importer: " << degenerate_tris_num << " degenerate triangles were removed"
               << std::endl;
   }
-  if (duplicate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << duplicate_tris_num_ << " duplicate triangles were removed"
+  if (duplicate_tris_num > 0) {
+    std::cout << "STL Importer: " << duplicate_tris_num << " duplicate triangles were removed"
               << std::endl;
   }
 
@@ -75,35 +92,39 @@ Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
   /* User count is already 1 here, but will be set later in #BKE_mesh_assign_object. */
   id_us_min(&mesh->id);
 
-  mesh->totvert = verts_.size();
+  mesh->totvert = verts.size();
   CustomData_add_layer(&mesh->vdata, CD_MVERT, CD_SET_DEFAULT, nullptr, mesh->totvert);
-  MutableSpan<MVert> verts = mesh->verts_for_write();
-  for (int i = 0; i < mesh->totvert; i++) {
-    copy_v3_v3(verts[i].co, verts_[i]);
-  }
+  MutableSpan<MVert> mverts = mesh->verts_for_write();
+  threading::parallel_for(verts.index_range(), 4096, [&](IndexRange verts_range) {
+    for (const int i : verts_range) {
+      copy_v3_v3(mverts[i].co, verts[i]);
+    }
+  });
 
-  mesh->totpoly = tris_.size();
-  mesh->totloop = tris_.size() * 3;
+  mesh->totpoly = tris.size();
+  mesh->totloop = tris.size() * 3;
   CustomData_add_layer(&mesh->pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, mesh->totpoly);
   CustomData_add_layer(&mesh->ldata, CD_MLOOP, CD_SET_DEFAULT, nullptr, mesh->totloop);
   MutableSpan<MPoly> polys = mesh->polys_for_write();
   MutableSpan<MLoop> loops = mesh->loops_for_write();
-  threading::parallel_for(tris_.index_range(), 2048, [&](IndexRange tris_range) {
+  threading::parallel_for(tris.index_range(), 2048, [&](IndexRange tris_range) {
     for (const int i : tris_range) {
       polys[i].loopstart = 3 * i;
       polys[i].totloop = 3;
 
-      loops[3 * i].v = tris_[i].v1;
-      loops[3 * i + 1].v = tris_[i].v2;
-      loops[3 * i + 2].v = tris_[i].v3;
+      loops[3 * i].v = tris[i].v1;
+      loops[3 * i + 1].v = tris[i].v2;
+      loops[3 * i + 2].v = tris[i].v3;
     }
   });
 
   /* NOTE: edges must be calculated first before setting custom normals. */
   BKE_mesh_calc_edges(mesh, false, false);
 
-  if (use_custom_normals_ && loop_normals_.size() == mesh->totloop) {
-    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(loop_normals_.data()));
+  if (!loop_normals.is_empty() && loop_normals.size() == mesh->totloop) {
+    BKE_mesh_set_custom_normals(mesh,
+                                reinterpret_cast<float(*)[3]>(
+                                    const_cast<float3 *>(loop_normals.data())));
     mesh->flag |= ME_AUTOSMOOTH;
   }
 
@@ -10,6 +10,7 @@
 
 #include "BLI_math_vec_types.hh"
 #include "BLI_set.hh"
+#include "BLI_span.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
@@ -68,4 +69,16 @@ class STLMeshHelper {
   Mesh *to_mesh(Main *bmain, char *mesh_name);
 };
 
+/**
+ * Create a mesh from unique vertices and triangles using them, with optional custom normals for
+ * every triangle corner. The numbers of removed triangles are only reported.
+ */
+Mesh *create_mesh_from_triangles(Main *bmain,
+                                 char *mesh_name,
+                                 Span<float3> verts,
+                                 Span<Triangle> tris,
+                                 Span<float3> loop_normals,
+                                 int degenerate_tris_num,
+                                 int duplicate_tris_num);
+
 }  // namespace blender::io::stl
@@ -30,6 +30,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DEG_depsgraph.h"
@@ -239,7 +240,8 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
   *data->do_update = true;
   *data->progress = 0.25f;
 
-  /* Create blender objects. */
+  /* Create blender objects, the new IDs are sorted by name once they are all created. */
+  BKE_main_id_sort_defer_begin(data->bmain);
   for (USDPrimReader *reader : archive->readers()) {
     if (!reader) {
       continue;
@@ -250,8 +252,28 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
       *data->progress = 0.25f + 0.25f * (i / size);
     }
   }
+  BKE_main_id_sort_defer_end(data->bmain);
+
+  /* Read the object data that doesn't depend on #Main in parallel, USD supports reading a stage
+   * from multiple threads. */
+  const std::vector<USDPrimReader *> &readers = archive->readers();
+  threading::parallel_for(IndexRange(readers.size()), 16, [&](const IndexRange range) {
+    for (const int64_t reader_index : range) {
+      if (readers[reader_index] && !G.is_break) {
+        readers[reader_index]->prefetch_object_data(0.0);
+      }
+    }
+  });
+
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
 
-  /* Setup parenthood and read actual object data. */
+  *data->do_update = true;
+  *data->progress = 0.75f;
+
+  /* Setup parenthood and read the rest of the object data. */
   i = 0;
   for (USDPrimReader *reader : archive->readers()) {
 
@@ -272,7 +294,7 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.5f + 0.5f * (++i / size);
+    *data->progress = 0.75f + 0.25f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
@@ -281,6 +303,30 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
     }
   }
 
+  /* Read the objects of the prototypes of the instances, once for all instances. */
+  for (const auto &item : archive->proto_readers()) {
+    BKE_main_id_sort_defer_begin(data->bmain);
+    for (USDPrimReader *reader : item.second) {
+      if (reader) {
+        reader->create_object(data->bmain, 0.0);
+      }
+    }
+    BKE_main_id_sort_defer_end(data->bmain);
+    for (USDPrimReader *reader : item.second) {
+      if (!reader) {
+        continue;
+      }
+      reader->read_object_data(data->bmain, 0.0);
+      USDPrimReader *parent = reader->parent();
+      reader->object()->parent = parent ? parent->object() : nullptr;
+    }
+
+    if (G.is_break) {
+      data->was_canceled = true;
+      return;
+    }
+  }
+
   data->import_ok = !data->was_canceled;
 
   *progress = 1.0f;
@@ -306,6 +352,14 @@ static void import_endjob(void *customdata)
         BKE_id_free_us(data->bmain, ob);
       }
     }
+
+    for (const auto &item : data->archive->proto_readers()) {
+      for (USDPrimReader *reader : item.second) {
+        if (reader && reader->object()) {
+          BKE_id_free_us(data->bmain, reader->object());
+        }
+      }
+    }
   }
   else if (data->archive) {
     Base *base;
@@ -319,6 +373,7 @@ static void import_endjob(void *customdata)
 
     /* Add all objects to the collection (don't do sync for each object). */
     BKE_layer_collection_resync_forbid();
+    data->archive->create_proto_collections(data->bmain, lc->collection);
     for (USDPrimReader *reader : data->archive->readers()) {
       if (!reader) {
         continue;
@@ -36,10 +36,20 @@ void USDCurvesReader::create_object(Main *bmain, const double /* motionSampleTim
   object_->data = curve_;
 }
 
-void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
+void USDCurvesReader::prefetch_object_data(const double motionSampleTime)
 {
   Curve *cu = (Curve *)object_->data;
   read_curve_sample(cu, motionSampleTime);
+  is_sample_prefetched_ = true;
+}
+
+void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
+{
+  Curve *cu = (Curve *)object_->data;
+  if (!is_sample_prefetched_) {
+    read_curve_sample(cu, motionSampleTime);
+  }
+  is_sample_prefetched_ = false;
 
   if (curve_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
     add_cache_modifier();
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "usd_reader_instance.h"
+
+#include "BKE_lib_id.h"
+#include "BKE_object.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+
+#include <pxr/pxr.h>
+
+namespace blender::io::usd {
+
+USDInstanceReader::USDInstanceReader(const pxr::UsdPrim &prim,
+                                     const USDImportParams &import_params,
+                                     const ImportSettings &settings)
+    : USDXformReader(prim, import_params, settings)
+{
+}
+
+bool USDInstanceReader::valid() const
+{
+  return prim_.IsValid() && prim_.IsInstance();
+}
+
+void USDInstanceReader::create_object(Main *bmain, const double /* motionSampleTime */)
+{
+  object_ = BKE_object_add_only_object(bmain, OB_EMPTY, name_.c_str());
+  object_->data = nullptr;
+  object_->instance_collection = nullptr;
+  object_->transflag |= OB_DUPLICOLLECTION;
+}
+
+void USDInstanceReader::set_instance_collection(Collection *coll)
+{
+  if (!object_ || object_->instance_collection == coll) {
+    return;
+  }
+  if (object_->instance_collection) {
+    id_us_min(&object_->instance_collection->id);
+  }
+  object_->instance_collection = coll;
+  if (coll) {
+    id_us_plus(&coll->id);
+  }
+}
+
+pxr::SdfPath USDInstanceReader::proto_path() const
+{
+#if PXR_VERSION >= 2011
+  if (pxr::UsdPrim proto = prim_.GetPrototype()) {
+#else
+  if (pxr::UsdPrim proto = prim_.GetMaster()) {
+#endif
+    return proto.GetPath();
+  }
+  return pxr::SdfPath();
+}
+
+}  // namespace blender::io::usd
@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+#include "usd.h"
+#include "usd_reader_xform.h"
+
+#include <pxr/usd/usdGeom/xform.h>
+
+struct Collection;
+
+namespace blender::io::usd {
+
+/* Wraps an instanceable USD prim, imported as an empty instancing the collection of the objects
+ * read from its prototype. */
+class USDInstanceReader : public USDXformReader {
+
+ public:
+  USDInstanceReader(const pxr::UsdPrim &prim,
+                    const USDImportParams &import_params,
+                    const ImportSettings &settings);
+
+  bool valid() const override;
+
+  void create_object(Main *bmain, double motionSampleTime) override;
+
+  void set_instance_collection(Collection *coll);
+
+  /* Path of the prototype of the instance, empty if it has none. */
+  pxr::SdfPath proto_path() const;
+};
+
+}  // namespace blender::io::usd
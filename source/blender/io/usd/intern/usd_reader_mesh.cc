@@ -8,6 +8,7 @@
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -226,10 +227,20 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
       is_left_handed_(false),
       has_uvs_(false),
       is_time_varying_(false),
-      is_initial_load_(false)
+      is_initial_load_(false),
+      prefetched_mesh_(nullptr),
+      has_prefetched_mesh_(false)
 {
 }
 
+USDMeshReader::~USDMeshReader()
+{
+  /* Only left when the import was canceled before the object data was read. */
+  if (prefetched_mesh_) {
+    BKE_id_free(nullptr, prefetched_mesh_);
+  }
+}
+
 void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
 {
   Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
@@ -238,15 +249,38 @@ void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDMeshReader::prefetch_object_data(const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
+  /* The new mesh is created outside of #Main, so it's safe to read from multiple threads. */
   is_initial_load_ = true;
   Mesh *read_mesh = this->read_mesh(
       mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
-
   is_initial_load_ = false;
+
+  prefetched_mesh_ = read_mesh != mesh ? read_mesh : nullptr;
+  has_prefetched_mesh_ = true;
+}
+
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  Mesh *read_mesh = mesh;
+  if (has_prefetched_mesh_) {
+    if (prefetched_mesh_) {
+      read_mesh = prefetched_mesh_;
+    }
+    prefetched_mesh_ = nullptr;
+    has_prefetched_mesh_ = false;
+  }
+  else {
+    is_initial_load_ = true;
+    read_mesh = this->read_mesh(mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+    is_initial_load_ = false;
+  }
+
   if (read_mesh != mesh) {
     BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
   }
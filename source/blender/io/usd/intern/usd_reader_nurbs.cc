@@ -53,10 +53,20 @@ void USDNurbsReader::create_object(Main *bmain, const double /* motionSampleTime
   object_->data = curve_;
 }
 
-void USDNurbsReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDNurbsReader::prefetch_object_data(const double motionSampleTime)
 {
   Curve *cu = (Curve *)object_->data;
   read_curve_sample(cu, motionSampleTime);
+  is_sample_prefetched_ = true;
+}
+
+void USDNurbsReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Curve *cu = (Curve *)object_->data;
+  if (!is_sample_prefetched_) {
+    read_curve_sample(cu, motionSampleTime);
+  }
+  is_sample_prefetched_ = false;
 
   if (curve_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
     add_cache_modifier();
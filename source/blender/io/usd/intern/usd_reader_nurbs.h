@@ -16,12 +16,17 @@ class USDNurbsReader : public USDGeomReader {
  protected:
   pxr::UsdGeomNurbsCurves curve_prim_;
   Curve *curve_;
+  /* Set when #prefetch_object_data already read the curve sample. */
+  bool is_sample_prefetched_;
 
  public:
   USDNurbsReader(const pxr::UsdPrim &prim,
                  const USDImportParams &import_params,
                  const ImportSettings &settings)
-      : USDGeomReader(prim, import_params, settings), curve_prim_(prim), curve_(nullptr)
+      : USDGeomReader(prim, import_params, settings),
+        curve_prim_(prim),
+        curve_(nullptr),
+        is_sample_prefetched_(false)
   {
   }
 
@@ -31,6 +36,7 @@ class USDNurbsReader : public USDGeomReader {
   }
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void prefetch_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_curve_sample(Curve *cu, double motionSampleTime);
@@ -89,6 +89,12 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /**
+   * Read the parts of the object data that don't need #Main ahead of #read_object_data. This is
+   * called from multiple threads at once for different readers, so it may only modify the data
+   * owned by this reader.
+   */
+  virtual void prefetch_object_data(double /* motionSampleTime */){};
   virtual void read_object_data(Main * /* bmain */, double /* motionSampleTime */){};
 
   Object *object() const;
@@ -4,6 +4,7 @@
 #include "usd_reader_stage.h"
 #include "usd_reader_camera.h"
 #include "usd_reader_curve.h"
+#include "usd_reader_instance.h"
 #include "usd_reader_light.h"
 #include "usd_reader_mesh.h"
 #include "usd_reader_nurbs.h"
@@ -28,9 +29,14 @@
 
 #include <iostream>
 
+#include "BKE_collection.h"
+
 #include "BLI_sort.hh"
 #include "BLI_string.h"
 
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+
 namespace blender::io::usd {
 
 USDStageReader::USDStageReader(pxr::UsdStageRefPtr stage,
@@ -205,7 +211,9 @@ static bool merge_with_parent(USDPrimReader *reader)
   return true;
 }
 
-USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &prim)
+USDPrimReader *USDStageReader::collect_readers(Main *bmain,
+                                               const pxr::UsdPrim &prim,
+                                               std::vector<USDPrimReader *> &r_readers)
 {
   if (prim.IsA<pxr::UsdGeomImageable>()) {
     pxr::UsdGeomImageable imageable(prim);
@@ -219,9 +227,17 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
     }
   }
 
+  if (params_.use_instancing && prim.IsInstance()) {
+    /* The prototype is read once for all its instances, see #collect_readers. */
+    USDPrimReader *reader = new USDInstanceReader(prim, params_, settings_);
+    r_readers.push_back(reader);
+    reader->incref();
+    return reader;
+  }
+
   pxr::Usd_PrimFlagsPredicate filter_predicate = pxr::UsdPrimDefaultPredicate;
 
-  if (params_.import_instance_proxies) {
+  if (params_.import_instance_proxies && !params_.use_instancing) {
     filter_predicate = pxr::UsdTraverseInstanceProxies(filter_predicate);
   }
 
@@ -230,7 +246,7 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
   std::vector<USDPrimReader *> child_readers;
 
   for (const auto &childPrim : children) {
-    if (USDPrimReader *child_reader = collect_readers(bmain, childPrim)) {
+    if (USDPrimReader *child_reader = collect_readers(bmain, childPrim, r_readers)) {
       child_readers.push_back(child_reader);
     }
   }
@@ -255,7 +271,7 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
     return nullptr;
   }
 
-  readers_.push_back(reader);
+  r_readers.push_back(reader);
   reader->incref();
 
   /* Set each child reader's parent. */
@@ -291,12 +307,31 @@ void USDStageReader::collect_readers(Main *bmain)
   }
 
   stage_->SetInterpolationType(pxr::UsdInterpolationType::UsdInterpolationTypeHeld);
-  collect_readers(bmain, root);
+  collect_readers(bmain, root, readers_);
+
+  if (!params_.use_instancing) {
+    return;
+  }
+
+  /* Read every prototype once. Their root prims only group the prims of the instances, so the
+   * children are read without a parent, relative to the instancing object. */
+#if PXR_VERSION >= 2011
+  const std::vector<pxr::UsdPrim> protos = stage_->GetPrototypes();
+#else
+  const std::vector<pxr::UsdPrim> protos = stage_->GetMasters();
+#endif
+  for (const pxr::UsdPrim &proto_prim : protos) {
+    std::vector<USDPrimReader *> proto_readers;
+    for (const pxr::UsdPrim &child_prim : proto_prim.GetChildren()) {
+      collect_readers(bmain, child_prim, proto_readers);
+    }
+    proto_readers_.insert(std::make_pair(proto_prim.GetPath(), std::move(proto_readers)));
+  }
 }
 
-void USDStageReader::clear_readers()
+static void decref_readers(std::vector<USDPrimReader *> &readers)
 {
-  for (USDPrimReader *reader : readers_) {
+  for (USDPrimReader *reader : readers) {
     if (!reader) {
       continue;
     }
@@ -308,7 +343,17 @@ void USDStageReader::clear_readers()
     }
   }
 
-  readers_.clear();
+  readers.clear();
+}
+
+void USDStageReader::clear_readers()
+{
+  decref_readers(readers_);
+
+  for (auto &item : proto_readers_) {
+    decref_readers(item.second);
+  }
+  proto_readers_.clear();
 }
 
 void USDStageReader::sort_readers()
@@ -321,4 +366,46 @@ void USDStageReader::sort_readers()
       });
 }
 
+void USDStageReader::create_proto_collections(Main *bmain, Collection *parent_collection)
+{
+  if (proto_readers_.empty()) {
+    return;
+  }
+
+  /* The prototypes are only visible through their instances. */
+  Collection *all_protos_collection = BKE_collection_add(bmain, parent_collection, "prototypes");
+  all_protos_collection->flag |= COLLECTION_HIDE_VIEWPORT | COLLECTION_HIDE_RENDER;
+
+  std::map<pxr::SdfPath, Collection *> proto_collections;
+  for (const auto &item : proto_readers_) {
+    Collection *proto_collection = BKE_collection_add(
+        bmain, all_protos_collection, item.first.GetName().c_str());
+    proto_collections.insert(std::make_pair(item.first, proto_collection));
+
+    for (USDPrimReader *reader : item.second) {
+      if (reader && reader->object()) {
+        BKE_collection_object_add(bmain, proto_collection, reader->object());
+      }
+    }
+  }
+
+  /* Prototypes can have instances of other prototypes too. */
+  auto set_instance_collections = [&](const std::vector<USDPrimReader *> &readers) {
+    for (USDPrimReader *reader : readers) {
+      USDInstanceReader *instance_reader = dynamic_cast<USDInstanceReader *>(reader);
+      if (!instance_reader) {
+        continue;
+      }
+      const auto proto_collection = proto_collections.find(instance_reader->proto_path());
+      if (proto_collection != proto_collections.end()) {
+        instance_reader->set_instance_collection(proto_collection->second);
+      }
+    }
+  };
+  set_instance_collections(readers_);
+  for (const auto &item : proto_readers_) {
+    set_instance_collections(item.second);
+  }
+}
+
 }  // Namespace blender::io::usd
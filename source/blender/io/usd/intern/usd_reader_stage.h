@@ -2,6 +2,7 @@
  * Copyright 2021 Tangent Animation and. NVIDIA Corporation. All rights reserved. */
 #pragma once
 
+struct Collection;
 struct Main;
 
 #include "usd.h"
@@ -27,6 +28,9 @@ class USDStageReader {
 
   std::vector<USDPrimReader *> readers_;
 
+  /* Readers of the prims of every prototype, when importing instances as collections. */
+  ProtoReaderMap proto_readers_;
+
  public:
   USDStageReader(pxr::UsdStageRefPtr stage,
                  const USDImportParams &params,
@@ -63,10 +67,24 @@ class USDStageReader {
     return readers_;
   };
 
+  const ProtoReaderMap &proto_readers() const
+  {
+    return proto_readers_;
+  };
+
   void sort_readers();
 
+  /**
+   * Create a collection for every prototype with the objects of its readers, in a hidden
+   * "prototypes" collection added to the given parent collection, and make the instance objects
+   * instance them.
+   */
+  void create_proto_collections(Main *bmain, Collection *parent_collection);
+
  private:
-  USDPrimReader *collect_readers(Main *bmain, const pxr::UsdPrim &prim);
+  USDPrimReader *collect_readers(Main *bmain,
+                                 const pxr::UsdPrim &prim,
+                                 std::vector<USDPrimReader *> &r_readers);
 
   /**
    * Returns true if the given prim should be included in the
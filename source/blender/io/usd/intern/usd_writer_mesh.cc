@@ -7,8 +7,10 @@
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_attribute.hh"
@@ -28,6 +30,7 @@
 #include "DNA_object_fluidsim_types.h"
 #include "DNA_particle_types.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace blender::io::usd {
@@ -103,6 +106,20 @@ struct USDMeshData {
   pxr::VtFloatArray corner_sharpnesses;
 };
 
+/* Start of the face corners of every polygon in the face varying USD arrays, which are written
+ * in polygon order, with the total number of corners at the end. */
+static Array<int> get_poly_corner_offsets(const Span<MPoly> polys)
+{
+  Array<int> offsets(polys.size() + 1);
+  int offset = 0;
+  for (const int i : polys.index_range()) {
+    offsets[i] = offset;
+    offset += polys[i].totloop;
+  }
+  offsets.last() = offset;
+  return offsets;
+}
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -122,11 +139,14 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
     pxr::UsdGeomPrimvar uv_coords_primvar = usd_mesh.CreatePrimvar(
         primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
-    MLoopUV *mloopuv = static_cast<MLoopUV *>(layer->data);
-    pxr::VtArray<pxr::GfVec2f> uv_coords;
-    for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
-      uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].uv));
-    }
+    const MLoopUV *mloopuv = static_cast<const MLoopUV *>(layer->data);
+    pxr::VtArray<pxr::GfVec2f> uv_coords(mesh->totloop);
+    pxr::GfVec2f *uv_coords_data = uv_coords.data();
+    threading::parallel_for(IndexRange(mesh->totloop), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        uv_coords_data[loop_idx] = pxr::GfVec2f(mloopuv[loop_idx].uv);
+      }
+    });
 
     if (!uv_coords_primvar.HasValue()) {
       uv_coords_primvar.Set(uv_coords, pxr::UsdTimeCode::Default());
@@ -244,12 +264,14 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
-
   const Span<MVert> verts = mesh->verts();
-  for (const int i : verts.index_range()) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
-  }
+  usd_mesh_data.points.resize(verts.size());
+  pxr::GfVec3f *points = usd_mesh_data.points.data();
+  threading::parallel_for(verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      points[i] = pxr::GfVec3f(verts[i].co);
+    }
+  });
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -266,19 +288,25 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
     }
   }
 
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
-
   const Span<MPoly> polys = mesh->polys();
   const Span<MLoop> loops = mesh->loops();
+  const Array<int> corner_offsets = get_poly_corner_offsets(polys);
 
-  for (const int i : polys.index_range()) {
-    const MPoly &poly = polys[i];
-    usd_mesh_data.face_vertex_counts.push_back(poly.totloop);
-    for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-      usd_mesh_data.face_indices.push_back(loop.v);
+  usd_mesh_data.face_vertex_counts.resize(polys.size());
+  usd_mesh_data.face_indices.resize(corner_offsets.last());
+  int *face_vertex_counts = usd_mesh_data.face_vertex_counts.data();
+  int *face_indices = usd_mesh_data.face_indices.data();
+
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      face_vertex_counts[i] = poly.totloop;
+      int *poly_indices = face_indices + corner_offsets[i];
+      for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+        *poly_indices++ = loop.v;
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -399,36 +427,39 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
   const Span<MPoly> polys = mesh->polys();
   const Span<MLoop> loops = mesh->loops();
 
-  pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
+  const Array<int> corner_offsets = get_poly_corner_offsets(polys);
+  pxr::VtVec3fArray loop_normals(corner_offsets.last());
+  pxr::GfVec3f *loop_normals_data = loop_normals.data();
 
   if (lnors != nullptr) {
     /* Export custom loop normals. */
-    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
-    }
+    threading::parallel_for(IndexRange(mesh->totloop), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        loop_normals_data[loop_idx] = pxr::GfVec3f(lnors[loop_idx]);
+      }
+    });
   }
   else {
     /* Compute the loop normals based on the 'smooth' flag. */
     const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
     const float(*face_normals)[3] = BKE_mesh_poly_normals_ensure(mesh);
-    for (const int i : polys.index_range()) {
-      const MPoly &poly = polys[i];
-
-      if ((poly.flag & ME_SMOOTH) == 0) {
-        /* Flat shaded, use common normal for all verts. */
-        pxr::GfVec3f pxr_normal(face_normals[i]);
-        for (int loop_idx = 0; loop_idx < poly.totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
+    threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        const MPoly &poly = polys[i];
+        pxr::GfVec3f *poly_normals = loop_normals_data + corner_offsets[i];
+
+        if ((poly.flag & ME_SMOOTH) == 0) {
+          /* Flat shaded, use common normal for all verts. */
+          std::fill_n(poly_normals, poly.totloop, pxr::GfVec3f(face_normals[i]));
         }
-      }
-      else {
-        /* Smooth shaded, use individual vert normals. */
-        for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-          loop_normals.push_back(pxr::GfVec3f(vert_normals[loop.v]));
+        else {
+          /* Smooth shaded, use individual vert normals. */
+          for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
+            *poly_normals++ = pxr::GfVec3f(vert_normals[loop.v]);
+          }
         }
       }
-    }
+    });
   }
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
@@ -453,15 +484,21 @@ void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeom
   const float(*velocities)[3] = reinterpret_cast<float(*)[3]>(velocity_layer->data);
 
   /* Export per-vertex velocity vectors. */
-  pxr::VtVec3fArray usd_velocities;
-  usd_velocities.reserve(mesh->totvert);
-
-  for (int vertex_idx = 0, totvert = mesh->totvert; vertex_idx < totvert; ++vertex_idx) {
-    usd_velocities.push_back(pxr::GfVec3f(velocities[vertex_idx]));
-  }
+  pxr::VtVec3fArray usd_velocities(mesh->totvert);
+  pxr::GfVec3f *usd_velocities_data = usd_velocities.data();
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](const IndexRange range) {
+    for (const int vertex_idx : range) {
+      usd_velocities_data[vertex_idx] = pxr::GfVec3f(velocities[vertex_idx]);
+    }
+  });
 
+  /* Like the other attributes, only write time samples when the velocities change. */
   pxr::UsdTimeCode timecode = get_export_time_code();
-  usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
+  pxr::UsdAttribute attr_velocities = usd_mesh.CreateVelocitiesAttr(pxr::VtValue(), true);
+  if (!attr_velocities.HasValue()) {
+    attr_velocities.Set(usd_velocities, pxr::UsdTimeCode::Default());
+  }
+  usd_value_writer_.SetAttribute(attr_velocities, pxr::VtValue(usd_velocities), timecode);
 }
 
 USDMeshWriter::USDMeshWriter(const USDExporterContext &ctx) : USDGenericMeshWriter(ctx)
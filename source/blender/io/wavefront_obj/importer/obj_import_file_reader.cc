@@ -8,6 +8,7 @@
 #include "BLI_math_color.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "obj_export_mtl.hh"
@@ -152,27 +153,72 @@ static void geom_add_uv_vertex(const char *p, const char *end, GlobalVertices &r
   r_global_vertices.uv_vertices.append(uv);
 }
 
-static void geom_add_edge(Geometry *geom,
-                          const char *p,
-                          const char *end,
-                          GlobalVertices &r_global_vertices)
+static void geom_add_edge(Geometry *geom, const char *p, const char *end, const int vertices_num)
 {
   int edge_v1, edge_v2;
   p = parse_int(p, end, -1, edge_v1);
   p = parse_int(p, end, -1, edge_v2);
   /* Always keep stored indices non-negative and zero-based. */
-  edge_v1 += edge_v1 < 0 ? r_global_vertices.vertices.size() : -1;
-  edge_v2 += edge_v2 < 0 ? r_global_vertices.vertices.size() : -1;
+  edge_v1 += edge_v1 < 0 ? vertices_num : -1;
+  edge_v2 += edge_v2 < 0 ? vertices_num : -1;
   BLI_assert(edge_v1 >= 0 && edge_v2 >= 0);
   geom->edges_.append({uint(edge_v1), uint(edge_v2)});
   geom->track_vertex_index(edge_v1);
   geom->track_vertex_index(edge_v2);
 }
 
+/**
+ * Face corner as written in the file, its indices are only made zero-based and validated once the
+ * number of vertices before the face in the file is known, see #geom_add_polygon.
+ */
+struct FileCorner {
+  PolyCorner corner;
+  bool got_uv = false;
+  bool got_normal = false;
+};
+
+static void parse_polygon_corners(const char *p, const char *end, Vector<FileCorner> &r_corners)
+{
+  p = drop_whitespace(p, end);
+  while (p < end) {
+    FileCorner file_corner;
+    PolyCorner &corner = file_corner.corner;
+    /* Parse vertex index. */
+    p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
+    if (p < end && *p == '/') {
+      /* Parse UV index. */
+      ++p;
+      if (p < end && *p != '/') {
+        p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
+        file_corner.got_uv = corner.uv_vert_index != INT32_MAX;
+      }
+      /* Parse normal index. */
+      if (p < end && *p == '/') {
+        ++p;
+        p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
+        file_corner.got_normal = corner.vertex_normal_index != INT32_MAX;
+      }
+    }
+    r_corners.append(file_corner);
+    if (corner.vert_index == INT32_MAX) {
+      /* The face is invalid, no need to parse the other corners. */
+      break;
+    }
+
+    /* Skip whitespace to get to the next face corner. */
+    p = drop_whitespace(p, end);
+  }
+}
+
+/**
+ * Add a face from its corners parsed with #parse_polygon_corners, the vertex, UV and normal
+ * counts are the numbers of elements before the face in the file.
+ */
 static void geom_add_polygon(Geometry *geom,
-                             const char *p,
-                             const char *end,
-                             const GlobalVertices &global_vertices,
+                             Span<FileCorner> file_corners,
+                             const int vertices_num,
+                             const int uv_vertices_num,
+                             const int vertex_normals_num,
                              const int material_index,
                              const int group_index,
                              const bool shaded_smooth)
@@ -189,70 +235,49 @@ static void geom_add_polygon(Geometry *geom,
   curr_face.start_index_ = orig_corners_size;
 
   bool face_valid = true;
-  p = drop_whitespace(p, end);
-  while (p < end && face_valid) {
-    PolyCorner corner;
-    bool got_uv = false, got_normal = false;
-    /* Parse vertex index. */
-    p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
-    face_valid &= corner.vert_index != INT32_MAX;
-    if (p < end && *p == '/') {
-      /* Parse UV index. */
-      ++p;
-      if (p < end && *p != '/') {
-        p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
-        got_uv = corner.uv_vert_index != INT32_MAX;
-      }
-      /* Parse normal index. */
-      if (p < end && *p == '/') {
-        ++p;
-        p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
-        got_normal = corner.vertex_normal_index != INT32_MAX;
-      }
-    }
+  for (const FileCorner &file_corner : file_corners) {
+    PolyCorner corner = file_corner.corner;
     /* Always keep stored indices non-negative and zero-based. */
-    corner.vert_index += corner.vert_index < 0 ? global_vertices.vertices.size() : -1;
-    if (corner.vert_index < 0 || corner.vert_index >= global_vertices.vertices.size()) {
+    corner.vert_index += corner.vert_index < 0 ? vertices_num : -1;
+    if (corner.vert_index < 0 || corner.vert_index >= vertices_num) {
       fprintf(stderr,
               "Invalid vertex index %i (valid range [0, %zu)), ignoring face\n",
               corner.vert_index,
-              size_t(global_vertices.vertices.size()));
+              size_t(vertices_num));
       face_valid = false;
     }
     else {
       geom->track_vertex_index(corner.vert_index);
     }
-    if (got_uv) {
-      corner.uv_vert_index += corner.uv_vert_index < 0 ? global_vertices.uv_vertices.size() : -1;
-      if (corner.uv_vert_index < 0 || corner.uv_vert_index >= global_vertices.uv_vertices.size()) {
+    if (file_corner.got_uv) {
+      corner.uv_vert_index += corner.uv_vert_index < 0 ? uv_vertices_num : -1;
+      if (corner.uv_vert_index < 0 || corner.uv_vert_index >= uv_vertices_num) {
         fprintf(stderr,
                 "Invalid UV index %i (valid range [0, %zu)), ignoring face\n",
                 corner.uv_vert_index,
-                size_t(global_vertices.uv_vertices.size()));
+                size_t(uv_vertices_num));
         face_valid = false;
       }
     }
     /* Ignore corner normal index, if the geometry does not have any normals.
      * Some obj files out there do have face definitions that refer to normal indices,
      * without any normals being present (T98782). */
-    if (got_normal && !global_vertices.vertex_normals.is_empty()) {
-      corner.vertex_normal_index += corner.vertex_normal_index < 0 ?
-                                        global_vertices.vertex_normals.size() :
-                                        -1;
-      if (corner.vertex_normal_index < 0 ||
-          corner.vertex_normal_index >= global_vertices.vertex_normals.size()) {
+    if (file_corner.got_normal && vertex_normals_num > 0) {
+      corner.vertex_normal_index += corner.vertex_normal_index < 0 ? vertex_normals_num : -1;
+      if (corner.vertex_normal_index < 0 || corner.vertex_normal_index >= vertex_normals_num) {
         fprintf(stderr,
                 "Invalid normal index %i (valid range [0, %zu)), ignoring face\n",
                 corner.vertex_normal_index,
-                size_t(global_vertices.vertex_normals.size()));
+                size_t(vertex_normals_num));
         face_valid = false;
       }
     }
     geom->face_corners_.append(corner);
     curr_face.corner_count_++;
 
-    /* Skip whitespace to get to the next face corner. */
-    p = drop_whitespace(p, end);
+    if (!face_valid) {
+      break;
+    }
   }
 
   if (face_valid) {
@@ -290,7 +315,7 @@ static void geom_set_curve_degree(Geometry *geom, const char *p, const char *end
 static void geom_add_curve_vertex_indices(Geometry *geom,
                                           const char *p,
                                           const char *end,
-                                          const GlobalVertices &global_vertices)
+                                          const int vertices_num)
 {
   /* Curve lines always have "0.0" and "1.0", skip over them. */
   float dummy[2];
@@ -303,7 +328,7 @@ static void geom_add_curve_vertex_indices(Geometry *geom,
       return;
     }
     /* Always keep stored indices non-negative and zero-based. */
-    index += index < 0 ? global_vertices.vertices.size() : -1;
+    index += index < 0 ? vertices_num : -1;
     geom->nurbs_element_.curv_indices.append(index);
   }
 }
@@ -412,6 +437,143 @@ static void use_all_vertices_if_no_faces(Geometry *geom,
   }
 }
 
+/**
+ * Lines of a part of the file, parsed independently of the other parts. Vertex positions,
+ * normals and UVs don't depend on the previous lines so they are stored directly. The other
+ * elements depend on the current object, group and material, or on the number of vertices
+ * before them, so they are kept to be added in file order once all the chunks are parsed.
+ */
+struct ParsedChunk {
+  StringRef text;
+  /* Vertex data of the chunk, vertex color blocks start at chunk-local vertex indices. */
+  GlobalVertices vertices;
+  /* Start of the first vertex colors block when it was created, before MRGB colors moved it. */
+  int first_colors_block_start = 0;
+  /* Corners of all the faces of the chunk, with the indices written in the file. */
+  Vector<FileCorner> face_corners;
+
+  struct ElementLine {
+    /* Line with the leading whitespace dropped. For faces only what follows the keyword. */
+    StringRef line;
+    /* Numbers of vertices, UVs and normals in the chunk before the line. */
+    int vertices_num;
+    int uv_vertices_num;
+    int vertex_normals_num;
+    /* Range in #face_corners for faces, empty otherwise. */
+    IndexRange face_corners;
+    bool is_face;
+  };
+  Vector<ElementLine> element_lines;
+  size_t lines_num = 0;
+};
+
+static void parse_chunk(ParsedChunk &chunk)
+{
+  StringRef buffer_str = chunk.text;
+  while (!buffer_str.is_empty()) {
+    StringRef line = read_next_line(buffer_str);
+    const char *p = line.begin(), *end = line.end();
+    p = drop_whitespace(p, end);
+    ++chunk.lines_num;
+    if (p == end) {
+      continue;
+    }
+    /* Most common things that start with 'v': vertices, normals, UVs. */
+    const bool had_vertex_colors = !chunk.vertices.vertex_colors.is_empty();
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        geom_add_vertex(p, end, chunk.vertices);
+        if (!had_vertex_colors && !chunk.vertices.vertex_colors.is_empty()) {
+          chunk.first_colors_block_start = chunk.vertices.vertices.size() - 1;
+        }
+      }
+      else if (parse_keyword(p, end, "vn")) {
+        geom_add_vertex_normal(p, end, chunk.vertices);
+      }
+      else if (parse_keyword(p, end, "vt")) {
+        geom_add_uv_vertex(p, end, chunk.vertices);
+      }
+      continue;
+    }
+    if (parse_keyword(p, end, "#MRGB")) {
+      geom_add_mrgb_colors(p, end, chunk.vertices);
+      if (!had_vertex_colors && !chunk.vertices.vertex_colors.is_empty()) {
+        chunk.first_colors_block_start = chunk.vertices.vertices.size();
+      }
+      continue;
+    }
+    /* Comments. */
+    if (*p == '#') {
+      continue;
+    }
+
+    ParsedChunk::ElementLine element;
+    element.vertices_num = chunk.vertices.vertices.size();
+    element.uv_vertices_num = chunk.vertices.uv_vertices.size();
+    element.vertex_normals_num = chunk.vertices.vertex_normals.size();
+    element.is_face = parse_keyword(p, end, "f");
+    if (element.is_face) {
+      const int64_t corners_start = chunk.face_corners.size();
+      parse_polygon_corners(p, end, chunk.face_corners);
+      element.face_corners = IndexRange(corners_start,
+                                        chunk.face_corners.size() - corners_start);
+    }
+    element.line = StringRef(p, end);
+    chunk.element_lines.append(element);
+  }
+}
+
+/**
+ * Split the text on line boundaries, in chunks of about the given size.
+ */
+static Vector<ParsedChunk> split_into_chunks(StringRef text, const size_t chunk_size)
+{
+  Vector<ParsedChunk> chunks;
+  while (!text.is_empty()) {
+    int64_t chunk_end = std::min(int64_t(chunk_size), text.size());
+    const int64_t newline = text.find('\n', chunk_end - 1);
+    chunk_end = newline == StringRef::not_found ? text.size() : newline + 1;
+
+    ParsedChunk chunk;
+    chunk.text = text.substr(0, chunk_end);
+    chunks.append(std::move(chunk));
+    text = text.drop_prefix(chunk_end);
+  }
+  return chunks;
+}
+
+/**
+ * Append the vertex data of the chunk, the offsets of its vertex color blocks are
+ * fixed up to global vertex indices.
+ */
+static void append_chunk_vertices(const ParsedChunk &chunk, GlobalVertices &r_global_vertices)
+{
+  const GlobalVertices &chunk_vertices = chunk.vertices;
+  const int vertex_offset = r_global_vertices.vertices.size();
+  r_global_vertices.vertices.extend(chunk_vertices.vertices);
+  r_global_vertices.uv_vertices.extend(chunk_vertices.uv_vertices);
+  r_global_vertices.vertex_normals.extend(chunk_vertices.vertex_normals);
+
+  auto &blocks = r_global_vertices.vertex_colors;
+  for (const int i : chunk_vertices.vertex_colors.index_range()) {
+    const GlobalVertices::VertexColorsBlock &chunk_block = chunk_vertices.vertex_colors[i];
+    /* The first block continues the previous one when it was created right after it, like when
+     * the colors are in the same chunk. MRGB colors move the start of the block back. */
+    if (i == 0 && !blocks.is_empty() &&
+        blocks.last().start_vertex_index + blocks.last().colors.size() ==
+            chunk.first_colors_block_start + vertex_offset) {
+      blocks.last().start_vertex_index -= chunk.first_colors_block_start -
+                                          chunk_block.start_vertex_index;
+      blocks.last().colors.extend(chunk_block.colors);
+      continue;
+    }
+    GlobalVertices::VertexColorsBlock block;
+    block.start_vertex_index = chunk_block.start_vertex_index + vertex_offset;
+    block.colors = chunk_block.colors;
+    blocks.append(std::move(block));
+  }
+}
+
 void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
                       GlobalVertices &r_global_vertices)
 {
@@ -434,15 +596,18 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
   string state_material_name;
   int state_material_index = -1;
 
-  /* Read the input file in chunks. We need up to twice the possible chunk size,
-   * to possibly store remainder of the previous input line that got broken mid-chunk. */
-  Array<char> buffer(read_buffer_size_ * 2);
+  /* Read the input file in blocks of several chunks of the read buffer size, which are parsed
+   * in parallel. We need up to twice the possible block size, to possibly store remainder of
+   * the previous input line that got broken mid-block. */
+  const size_t chunks_per_read = 64;
+  const size_t read_size = read_buffer_size_ * chunks_per_read;
+  Array<char> buffer(read_size * 2);
 
   size_t buffer_offset = 0;
   size_t line_number = 0;
   while (true) {
-    /* Read a chunk of input from the file. */
-    size_t bytes_read = fread(buffer.data() + buffer_offset, 1, read_buffer_size_, obj_file_);
+    /* Read a block of input from the file. */
+    size_t bytes_read = fread(buffer.data() + buffer_offset, 1, read_size, obj_file_);
     if (bytes_read == 0 && buffer_offset == 0) {
       break; /* No more data to read. */
     }
@@ -453,7 +618,7 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
                              buffer.data() + buffer_offset + bytes_read);
 
     /* Ensure buffer ends in a newline. */
-    if (bytes_read < read_buffer_size_) {
+    if (bytes_read < read_size) {
       if (bytes_read == 0 || buffer[buffer_offset + bytes_read - 1] != '\n') {
         buffer[buffer_offset + bytes_read] = '\n';
         bytes_read++;
@@ -478,107 +643,102 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
       fprintf(stderr,
               "OBJ file contains a line #%zu that is too long (max. length %zu)\n",
               line_number,
-              read_buffer_size_);
+              read_size);
       break;
     }
     ++last_nl;
 
-    /* Parse the buffer (until last newline) that we have so far,
-     * line by line. */
-    StringRef buffer_str{buffer.data(), int64_t(last_nl)};
-    while (!buffer_str.is_empty()) {
-      StringRef line = read_next_line(buffer_str);
-      const char *p = line.begin(), *end = line.end();
-      p = drop_whitespace(p, end);
-      ++line_number;
-      if (p == end) {
-        continue;
-      }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
-      if (*p == 'v') {
-        if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
+    /* Parse the buffer (until last newline) that we have so far, in chunks split on line
+     * boundaries. */
+    Vector<ParsedChunk> chunks = split_into_chunks(StringRef(buffer.data(), int64_t(last_nl)),
+                                                   read_buffer_size_);
+    threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        parse_chunk(chunks[i]);
+      }
+    });
+
+    /* Add the elements depending on the previous lines, in file order. */
+    for (ParsedChunk &chunk : chunks) {
+      const int vertex_offset = r_global_vertices.vertices.size();
+      const int uv_vertex_offset = r_global_vertices.uv_vertices.size();
+      const int vertex_normal_offset = r_global_vertices.vertex_normals.size();
+      append_chunk_vertices(chunk, r_global_vertices);
+      line_number += chunk.lines_num;
+
+      for (const ParsedChunk::ElementLine &element : chunk.element_lines) {
+        const char *p = element.line.begin(), *end = element.line.end();
+        const int vertices_num = vertex_offset + element.vertices_num;
+        /* Faces. */
+        if (element.is_face) {
+          geom_add_polygon(curr_geom,
+                           chunk.face_corners.as_span().slice(element.face_corners),
+                           vertices_num,
+                           uv_vertex_offset + element.uv_vertices_num,
+                           vertex_normal_offset + element.vertex_normals_num,
+                           state_material_index,
+                           state_group_index,
+                           state_shaded_smooth);
         }
-        else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
+        /* Edges. */
+        else if (parse_keyword(p, end, "l")) {
+          geom_add_edge(curr_geom, p, end, vertices_num);
         }
-        else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
+        /* Objects. */
+        else if (parse_keyword(p, end, "o")) {
+          state_shaded_smooth = false;
+          state_group_name = "";
+          state_material_name = "";
+          curr_geom = create_geometry(
+              curr_geom, GEOM_MESH, StringRef(p, end).trim(), r_all_geometries);
         }
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "f")) {
-        geom_add_polygon(curr_geom,
-                         p,
-                         end,
-                         r_global_vertices,
-                         state_material_index,
-                         state_group_index,
-                         state_shaded_smooth);
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "l")) {
-        geom_add_edge(curr_geom, p, end, r_global_vertices);
-      }
-      /* Objects. */
-      else if (parse_keyword(p, end, "o")) {
-        state_shaded_smooth = false;
-        state_group_name = "";
-        state_material_name = "";
-        curr_geom = create_geometry(
-            curr_geom, GEOM_MESH, StringRef(p, end).trim(), r_all_geometries);
-      }
-      /* Groups. */
-      else if (parse_keyword(p, end, "g")) {
-        geom_update_group(StringRef(p, end).trim(), state_group_name);
-        int new_index = curr_geom->group_indices_.size();
-        state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
-        if (new_index == state_group_index) {
-          curr_geom->group_order_.append(state_group_name);
+        /* Groups. */
+        else if (parse_keyword(p, end, "g")) {
+          geom_update_group(StringRef(p, end).trim(), state_group_name);
+          int new_index = curr_geom->group_indices_.size();
+          state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name,
+                                                                      new_index);
+          if (new_index == state_group_index) {
+            curr_geom->group_order_.append(state_group_name);
+          }
         }
-      }
-      /* Smoothing groups. */
-      else if (parse_keyword(p, end, "s")) {
-        geom_update_smooth_group(p, end, state_shaded_smooth);
-      }
-      /* Materials and their libraries. */
-      else if (parse_keyword(p, end, "usemtl")) {
-        state_material_name = StringRef(p, end).trim();
-        int new_mat_index = curr_geom->material_indices_.size();
-        state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
-                                                                          new_mat_index);
-        if (new_mat_index == state_material_index) {
-          curr_geom->material_order_.append(state_material_name);
+        /* Smoothing groups. */
+        else if (parse_keyword(p, end, "s")) {
+          geom_update_smooth_group(p, end, state_shaded_smooth);
+        }
+        /* Materials and their libraries. */
+        else if (parse_keyword(p, end, "usemtl")) {
+          state_material_name = StringRef(p, end).trim();
+          int new_mat_index = curr_geom->material_indices_.size();
+          state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
+                                                                            new_mat_index);
+          if (new_mat_index == state_material_index) {
+            curr_geom->material_order_.append(state_material_name);
+          }
+        }
+        else if (parse_keyword(p, end, "mtllib")) {
+          add_mtl_library(StringRef(p, end).trim());
+        }
+        /* Curve related things. */
+        else if (parse_keyword(p, end, "cstype")) {
+          curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
+        }
+        else if (parse_keyword(p, end, "deg")) {
+          geom_set_curve_degree(curr_geom, p, end);
+        }
+        else if (parse_keyword(p, end, "curv")) {
+          geom_add_curve_vertex_indices(curr_geom, p, end, vertices_num);
+        }
+        else if (parse_keyword(p, end, "parm")) {
+          geom_add_curve_parameters(curr_geom, p, end);
+        }
+        else if (StringRef(p, end).startswith("end")) {
+          /* End of curve definition, nothing else to do. */
+        }
+        else {
+          std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'"
+                    << std::endl;
         }
-      }
-      else if (parse_keyword(p, end, "mtllib")) {
-        add_mtl_library(StringRef(p, end).trim());
-      }
-      else if (parse_keyword(p, end, "#MRGB")) {
-        geom_add_mrgb_colors(p, end, r_global_vertices);
-      }
-      /* Comments. */
-      else if (*p == '#') {
-        /* Nothing to do. */
-      }
-      /* Curve related things. */
-      else if (parse_keyword(p, end, "cstype")) {
-        curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
-      }
-      else if (parse_keyword(p, end, "deg")) {
-        geom_set_curve_degree(curr_geom, p, end);
-      }
-      else if (parse_keyword(p, end, "curv")) {
-        geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
-      }
-      else if (parse_keyword(p, end, "parm")) {
-        geom_add_curve_parameters(curr_geom, p, end);
-      }
-      else if (StringRef(p, end).startswith("end")) {
-        /* End of curve definition, nothing else to do. */
-      }
-      else {
-        std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
       }
     }
 
@@ -31,10 +31,21 @@ class MeshFromGeometry : NonMovable, NonCopyable {
   {
   }
 
-  Object *create_mesh(Main *bmain,
-                      Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
-                      Map<std::string, Material *> &created_materials,
-                      const OBJImportParams &import_params);
+  /**
+   * Build the mesh data of the geometry, outside of #Main. Returns null for empty geometries.
+   * Doesn't touch any Blender data shared with other meshes, so meshes of different
+   * geometries can be built in parallel.
+   */
+  Mesh *create_mesh(const OBJImportParams &import_params);
+  /**
+   * Add an object with the mesh built by #create_mesh to #Main, along with its materials.
+   * Takes ownership of the mesh.
+   */
+  Object *create_mesh_object(Main *bmain,
+                             Mesh *mesh,
+                             Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
+                             Map<std::string, Material *> &created_materials,
+                             const OBJImportParams &import_params);
 
  private:
   /**
@@ -122,6 +122,24 @@ void *DNA_struct_reconstruct(const struct DNA_ReconstructInfo *reconstruct_info,
                              int old_struct_nr,
                              int blocks,
                              const void *old_blocks);
+/**
+ * \return The size in bytes of a single reconstructed struct,
+ * zero when the struct does not exist in newsdna anymore.
+ */
+int DNA_struct_reconstruct_block_size(const struct DNA_ReconstructInfo *reconstruct_info,
+                                      int old_struct_nr);
+/**
+ * Same as #DNA_struct_reconstruct, but writes into memory provided by the caller.
+ * This allows reconstructing parts of a large array from multiple threads.
+ *
+ * \param new_blocks: Zero initialized memory of `blocks` times
+ * #DNA_struct_reconstruct_block_size bytes.
+ */
+void DNA_struct_reconstruct_into(const struct DNA_ReconstructInfo *reconstruct_info,
+                                 int old_struct_nr,
+                                 int blocks,
+                                 const void *old_blocks,
+                                 void *new_blocks);
 
 /**
  * Returns the offset of the field with the specified name and type within the specified
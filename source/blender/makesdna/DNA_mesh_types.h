@@ -107,6 +107,12 @@ typedef struct Mesh_Runtime {
   /** Cache of non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /**
+   * Lazily computed adjacency maps that only depend on the topology, e.g. the corners around
+   * every vertex. Defined in `mesh_mapping.cc`.
+   */
+  struct MeshTopologyCache *topology_cache;
+
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra;
 
@@ -140,14 +146,27 @@ typedef struct Mesh_Runtime {
   struct SubsurfRuntimeData *subsurf_runtime_data;
   void *_pad1;
 
+  /**
+   * The vertex positions changed since #looptris were calculated, so the triangles of quads and
+   * n-gons have to be updated. The topology is still the same.
+   */
+  char looptris_positions_dirty;
+  char _pad2[1];
+
   /**
    * Caches for lazily computed vertex and polygon normals. These are stored here rather than in
    * #CustomData because they can be calculated on a const mesh, and adding custom data layers on a
    * const mesh is not thread-safe.
    */
-  char _pad2[6];
   char vert_normals_dirty;
   char poly_normals_dirty;
+
+  /**
+   * Changes whenever the topology or attributes of the mesh may have changed. Evaluated copies
+   * that reference the layers of their source keep its version, so deformed copies of the same
+   * data can be recognized. See #BKE_mesh_runtime_data_version_new.
+   */
+  uint32_t data_version;
   float (*vert_normals)[3];
   float (*poly_normals)[3];
 
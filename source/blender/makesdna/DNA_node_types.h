@@ -692,6 +692,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_GPU_RENDER (1 << 6) /* use the realtime compositor for final renders */
 
 /* tree->execution_mode */
 typedef enum eNodeTreeExecutionMode {
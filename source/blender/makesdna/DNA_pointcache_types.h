@@ -149,6 +149,7 @@ enum {
 #define PTCACHE_COMPRESS_NO 0
 #define PTCACHE_COMPRESS_LZO 1
 #define PTCACHE_COMPRESS_LZMA 2
+#define PTCACHE_COMPRESS_ZSTD 3
 
 #ifdef __cplusplus
 }
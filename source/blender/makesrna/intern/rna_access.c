@@ -4416,6 +4416,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* Items only made of the property, like in attribute arrays, are copied at once. */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4431,8 +4442,32 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Non-matching types are converted item by item, still avoiding the property lookups
+       * of the generic loop below. */
+      if (in.type != PROP_RAW_UNSET && out.type != PROP_RAW_UNSET) {
+        RawArray item;
+        item.array = out.array;
+        item.type = out.type;
+        item.stride = 0;
+        item.len = arraylen;
+
+        for (int a = 0, in_index = 0; a < out.len; a++) {
+          for (int j = 0; j < arraylen; j++, in_index++) {
+            double value;
+            if (set) {
+              RAW_GET(double, value, in, in_index);
+              RAW_SET(double, item, j, value);
+            }
+            else {
+              RAW_GET(double, value, item, j);
+              RAW_SET(double, in, in_index, value);
+            }
+          }
+          item.array = (char *)item.array + out.stride;
+        }
+
+        return 1;
+      }
     }
   }
 
@@ -256,9 +256,9 @@ static void rna_def_cachefile(BlenderRNA *brna)
       prop,
       "Use Render Engine Procedural",
       "Display boxes in the viewport as placeholders for the objects, Cycles will use a "
-      "procedural to load the objects during viewport rendering in experimental mode, "
-      "other render engines will also receive a placeholder and should take care of loading the "
-      "Alembic data themselves if possible");
+      "procedural to load the objects during final renders, and during viewport rendering in "
+      "experimental mode, other render engines will also receive a placeholder and should take "
+      "care of loading the Alembic data themselves if possible");
   RNA_def_property_update(prop, 0, "rna_CacheFile_dependency_update");
 
   /* ----------------- For Scene time ------------------- */
@@ -39,11 +39,26 @@
 
 #  include "MEM_guardedalloc.h"
 
+#  ifdef WITH_PYTHON
+#    include "BPY_extern.h"
+#  endif
+
 static void rna_ImagePackedFile_save(ImagePackedFile *imapf, Main *bmain, ReportList *reports)
 {
-  if (BKE_packedfile_write_to_file(
-          reports, BKE_main_blendfile_path(bmain), imapf->filepath, imapf->packedfile, 0) !=
-      RET_OK) {
+  int ret;
+
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
+  ret = BKE_packedfile_write_to_file(
+      reports, BKE_main_blendfile_path(bmain), imapf->filepath, imapf->packedfile, 0);
+
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
+
+  if (ret != RET_OK) {
     BKE_reportf(reports, RPT_ERROR, "Could not save packed file to disk as '%s'", imapf->filepath);
   }
 }
@@ -63,7 +78,19 @@ static void rna_Image_save_render(
     opts.save_copy = true;
     STRNCPY(opts.filepath, path);
 
-    if (!BKE_image_save(reports, bmain, image, NULL, &opts)) {
+    bool ok;
+
+#  ifdef WITH_PYTHON
+    BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
+    ok = BKE_image_save(reports, bmain, image, NULL, &opts);
+
+#  ifdef WITH_PYTHON
+    BPy_END_ALLOW_THREADS;
+#  endif
+
+    if (!ok) {
       BKE_reportf(
           reports, RPT_ERROR, "Image '%s' could not be saved to '%s'", image->id.name + 2, path);
     }
@@ -83,7 +110,19 @@ static void rna_Image_save(Image *image, Main *bmain, bContext *C, ReportList *r
   ImageSaveOptions opts;
 
   if (BKE_image_save_options_init(&opts, bmain, scene, image, NULL, false, false)) {
-    if (!BKE_image_save(reports, bmain, image, NULL, &opts)) {
+    bool ok;
+
+#  ifdef WITH_PYTHON
+    BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
+    ok = BKE_image_save(reports, bmain, image, NULL, &opts);
+
+#  ifdef WITH_PYTHON
+    BPy_END_ALLOW_THREADS;
+#  endif
+
+    if (!ok) {
       BKE_reportf(reports,
                   RPT_ERROR,
                   "Image '%s' could not be saved to '%s'",
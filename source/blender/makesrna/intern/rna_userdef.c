@@ -5360,6 +5360,11 @@ static void rna_def_userdef_system(BlenderRNA *brna)
        0,
        "None",
        "Requires fast storage, but uses minimum CPU resources"},
+      {USER_SEQ_DISK_CACHE_COMPRESSION_FASTEST,
+       "FASTEST",
+       0,
+       "Fastest",
+       "Requires fast storage and uses little CPU resources"},
       {USER_SEQ_DISK_CACHE_COMPRESSION_LOW,
        "LOW",
        0,
@@ -6302,6 +6307,27 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       "Undo Legacy",
       "Use legacy undo (slower than the new default one, but may be more stable in some cases)");
 
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged_ids", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_skip_unchanged_ids", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged Data-Blocks",
+                           "Reuse the undo memory of data-blocks that were not tagged as changed "
+                           "since the last undo push, instead of writing them again");
+
+  prop = RNA_def_property(srna, "use_viewport_mesh_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_viewport_mesh_lod", 1);
+  RNA_def_property_ui_text(prop,
+                           "Viewport Mesh Level of Detail",
+                           "Draw dense meshes with a simplified surface in Solid mode when their "
+                           "detail is smaller than a pixel");
+
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decode", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_sequencer_hardware_decode", 1);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies with the GPU video decoder when FFmpeg supports it for "
+                           "their codec, used for movies opened after enabling it");
+
   prop = RNA_def_property(srna, "override_auto_resync", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, NULL, "no_override_auto_resync", 1);
   RNA_def_property_ui_text(
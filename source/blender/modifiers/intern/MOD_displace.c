@@ -160,13 +160,80 @@ typedef struct DisplaceUserdata {
   MVert *mvert;
   const float (*vert_normals)[3];
   float (*vert_clnors)[3];
+  /** Only displace these vertices on partial updates. */
+  const int *partial_verts;
 } DisplaceUserdata;
 
+/** Previous result, kept for partial updates (see #eModifierTypeFlag_SupportsPartialUpdate). */
+typedef struct DisplaceRuntime {
+  float (*vert_coords)[3];
+  int verts_num;
+  int update_id;
+} DisplaceRuntime;
+
+static void freeRuntimeData(void *runtime_data_v)
+{
+  DisplaceRuntime *runtime = (DisplaceRuntime *)runtime_data_v;
+  if (runtime == NULL) {
+    return;
+  }
+  MEM_SAFE_FREE(runtime->vert_coords);
+  MEM_freeN(runtime);
+}
+
+/**
+ * Get the vertices to displace when the previous result can be reused for the others,
+ * otherwise null.
+ */
+static const int *displace_partial_update_verts_get(DisplaceModifierData *dmd,
+                                                    const ModifierEvalContext *ctx,
+                                                    const int verts_num,
+                                                    int *r_verts_len)
+{
+  const DisplaceRuntime *runtime = (const DisplaceRuntime *)dmd->modifier.runtime;
+  const ModifierPartialUpdate *partial_update = ctx->partial_update;
+  if (runtime == NULL || partial_update == NULL || partial_update->verts == NULL) {
+    return NULL;
+  }
+  if (runtime->verts_num != verts_num || runtime->update_id != partial_update->update_id - 1) {
+    return NULL;
+  }
+  *r_verts_len = partial_update->verts_len;
+  return partial_update->verts;
+}
+
+static void displace_partial_update_store(DisplaceModifierData *dmd,
+                                          const ModifierEvalContext *ctx,
+                                          const float (*vertexCos)[3],
+                                          const int verts_num)
+{
+  ModifierData *md = &dmd->modifier;
+  if (ctx->partial_update == NULL) {
+    /* Not worth keeping the result outside of edit-mode. */
+    freeRuntimeData(md->runtime);
+    md->runtime = NULL;
+    return;
+  }
+
+  DisplaceRuntime *runtime = (DisplaceRuntime *)md->runtime;
+  if (runtime == NULL) {
+    runtime = md->runtime = MEM_callocN(sizeof(*runtime), __func__);
+  }
+  if (runtime->verts_num != verts_num) {
+    MEM_SAFE_FREE(runtime->vert_coords);
+    runtime->vert_coords = MEM_malloc_arrayN(verts_num, sizeof(*runtime->vert_coords), __func__);
+    runtime->verts_num = verts_num;
+  }
+  memcpy(runtime->vert_coords, vertexCos, sizeof(*runtime->vert_coords) * verts_num);
+  runtime->update_id = ctx->partial_update->update_id;
+}
+
 static void displaceModifier_do_task(void *__restrict userdata,
-                                     const int iter,
+                                     const int index,
                                      const TaskParallelTLS *__restrict UNUSED(tls))
 {
   DisplaceUserdata *data = (DisplaceUserdata *)userdata;
+  const int iter = data->partial_verts ? data->partial_verts[index] : index;
   DisplaceModifierData *dmd = data->dmd;
   const MDeformVert *dvert = data->dvert;
   const bool invert_vgroup = (dmd->flag & MOD_DISP_INVERT_VGROUP) != 0;
@@ -346,10 +413,27 @@ static void displaceModifier_do(DisplaceModifierData *dmd,
     data.pool = BKE_image_pool_new();
     BKE_texture_fetch_images_for_pool(tex_target, data.pool);
   }
+
+  int displace_len = verts_num;
+  data.partial_verts = displace_partial_update_verts_get(dmd, ctx, verts_num, &displace_len);
+  if (data.partial_verts) {
+    /* Only the changed vertices are displaced again, the others keep the previous result. */
+    const DisplaceRuntime *runtime = (const DisplaceRuntime *)dmd->modifier.runtime;
+    float(*partial_cos)[3] = MEM_malloc_arrayN(displace_len, sizeof(*partial_cos), __func__);
+    for (int i = 0; i < displace_len; i++) {
+      copy_v3_v3(partial_cos[i], vertexCos[data.partial_verts[i]]);
+    }
+    memcpy(vertexCos, runtime->vert_coords, sizeof(*vertexCos) * verts_num);
+    for (int i = 0; i < displace_len; i++) {
+      copy_v3_v3(vertexCos[data.partial_verts[i]], partial_cos[i]);
+    }
+    MEM_freeN(partial_cos);
+  }
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (verts_num > 512);
-  BLI_task_parallel_range(0, verts_num, &data, displaceModifier_do_task, &settings);
+  settings.use_threading = (displace_len > 512);
+  BLI_task_parallel_range(0, displace_len, &data, displaceModifier_do_task, &settings);
 
   if (data.pool != NULL) {
     BKE_image_pool_free(data.pool);
@@ -373,6 +457,8 @@ static void deformVerts(ModifierData *md,
   Mesh *mesh_src = MOD_deform_mesh_eval_get(ctx->object, NULL, mesh, NULL, verts_num, false);
 
   displaceModifier_do((DisplaceModifierData *)md, ctx, mesh_src, vertexCos, verts_num);
+  displace_partial_update_store(
+      (DisplaceModifierData *)md, ctx, (const float(*)[3])vertexCos, verts_num);
 
   if (!ELEM(mesh_src, NULL, mesh)) {
     BKE_id_free(NULL, mesh_src);
@@ -394,6 +480,8 @@ static void deformVertsEM(ModifierData *md,
   }
 
   displaceModifier_do((DisplaceModifierData *)md, ctx, mesh_src, vertexCos, verts_num);
+  displace_partial_update_store(
+      (DisplaceModifierData *)md, ctx, (const float(*)[3])vertexCos, verts_num);
 
   if (!ELEM(mesh_src, NULL, mesh)) {
     BKE_id_free(NULL, mesh_src);
@@ -474,7 +562,8 @@ ModifierTypeInfo modifierType_Displace = {
     /* structSize */ sizeof(DisplaceModifierData),
     /* srna */ &RNA_DisplaceModifier,
     /* type */ eModifierTypeType_OnlyDeform,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+        eModifierTypeFlag_SupportsPartialUpdate,
     /* icon */ ICON_MOD_DISPLACE,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -495,7 +584,7 @@ ModifierTypeInfo modifierType_Displace = {
     /* dependsOnNormals */ dependsOnNormals,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ foreachTexLink,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ NULL,
@@ -150,7 +150,8 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
 
   /* Do not process data if using a render procedural, return a box instead for displaying in the
    * viewport. */
-  if (BKE_cache_file_uses_render_procedural(cache_file, scene)) {
+  if (BKE_cache_file_uses_render_procedural(
+          cache_file, scene, DEG_get_mode(ctx->depsgraph) == DAG_EVAL_RENDER)) {
     return generate_bounding_box_mesh(org_mesh);
   }
 
@@ -252,9 +253,10 @@ static bool dependsOnTime(Scene *scene, ModifierData *md)
 {
 #if defined(WITH_USD) || defined(WITH_ALEMBIC)
   MeshSeqCacheModifierData *mcmd = reinterpret_cast<MeshSeqCacheModifierData *>(md);
-  /* Do not evaluate animations if using the render engine procedural. */
+  /* Do not evaluate animations if using the render engine procedural. Procedurals only used for
+   * final renders still need the animated data in the viewport. */
   return (mcmd->cache_file != nullptr) &&
-         !BKE_cache_file_uses_render_procedural(mcmd->cache_file, scene);
+         !BKE_cache_file_uses_render_procedural(mcmd->cache_file, scene, false);
 #else
   UNUSED_VARS(scene, md);
   return false;
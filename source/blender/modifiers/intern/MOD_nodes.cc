@@ -7,6 +7,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 #include "MEM_guardedalloc.h"
@@ -18,6 +19,7 @@
 #include "BLI_set.hh"
 #include "BLI_string.h"
 #include "BLI_string_search.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -87,6 +89,8 @@
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_node_declaration.hh"
 
+#include "GEO_realize_instances.hh"
+
 #include "FN_field.hh"
 #include "FN_field_cpp_type.hh"
 #include "FN_lazy_function_execute.hh"
@@ -1110,7 +1114,8 @@ static GeometrySet compute_geometry(
     const bNode &output_node,
     GeometrySet input_geometry_set,
     NodesModifierData *nmd,
-    const ModifierEvalContext *ctx)
+    const ModifierEvalContext *ctx,
+    const bool use_logging)
 {
   const blender::nodes::GeometryNodeLazyFunctionGraphMapping &mapping = lf_graph_info.mapping;
 
@@ -1137,7 +1142,8 @@ static GeometrySet compute_geometry(
   geo_nodes_modifier_data.depsgraph = ctx->depsgraph;
   geo_nodes_modifier_data.self_object = ctx->object;
   auto eval_log = std::make_unique<GeoModifierLog>();
-  if (logging_enabled(ctx)) {
+  eval_log->use_profiling = G.debug & G_DEBUG_GEOMETRY_NODES_PROFILE;
+  if (use_logging) {
     geo_nodes_modifier_data.eval_log = eval_log.get();
   }
   MultiValueMap<blender::ComputeContextHash, const lf::FunctionNode *> r_side_effect_nodes;
@@ -1196,7 +1202,15 @@ static GeometrySet compute_geometry(
     ptr.destruct();
   }
 
-  if (logging_enabled(ctx)) {
+  if (use_logging) {
+    if (eval_log->use_profiling) {
+      const std::string name = std::string(ctx->object->id.name + 2) + "/" + nmd->modifier.name;
+      /* Write everything at once, because other modifiers can be evaluated at the same time. */
+      std::stringstream stream;
+      eval_log->get_tree_log(modifier_compute_context.hash()).write_profile_json(stream, name);
+      stream << "\n";
+      std::cout << stream.str() << std::flush;
+    }
     NodesModifierData *nmd_orig = reinterpret_cast<NodesModifierData *>(
         BKE_modifier_get_original(ctx->object, &nmd->modifier));
     delete static_cast<GeoModifierLog *>(nmd_orig->runtime_eval_log);
@@ -1206,6 +1220,143 @@ static GeometrySet compute_geometry(
   return output_geometry_set;
 }
 
+/**
+ * Point clouds that are larger than this are evaluated in batches when the node tree only
+ * contains nodes that process every point independently.
+ */
+static constexpr int streaming_batch_size = 1 << 20;
+
+/**
+ * Check whether every node in the tree (including nested groups) computes the result for every
+ * point independently of all other points. Then evaluating the tree on parts of a point cloud and
+ * joining the results gives the same result as evaluating it on the entire point cloud.
+ */
+static bool node_tree_is_pointwise(const bNodeTree &tree)
+{
+  tree.ensure_topology_cache();
+  for (const bNode *node : tree.all_nodes()) {
+    if (node->is_muted()) {
+      continue;
+    }
+    switch (node->type) {
+      case NODE_FRAME:
+      case NODE_REROUTE:
+      case NODE_GROUP_INPUT:
+      case NODE_GROUP_OUTPUT:
+      case GEO_NODE_INPUT_POSITION:
+      case GEO_NODE_INPUT_NAMED_ATTRIBUTE:
+      case GEO_NODE_SET_POSITION:
+      case GEO_NODE_DELETE_GEOMETRY:
+      case GEO_NODE_STORE_NAMED_ATTRIBUTE:
+        continue;
+      case NODE_GROUP:
+        if (node->id == nullptr ||
+            !node_tree_is_pointwise(*reinterpret_cast<const bNodeTree *>(node->id))) {
+          return false;
+        }
+        continue;
+      default:
+        break;
+    }
+    /* Other nodes have to be multi-functions, which are evaluated for every element separately.
+     * Implicit inputs like the index depend on the batch though. */
+    if (node->typeinfo->build_multi_function == nullptr) {
+      return false;
+    }
+    const blender::nodes::NodeDeclaration *declaration = node->declaration();
+    if (declaration == nullptr) {
+      return false;
+    }
+    for (const int i : declaration->inputs().index_range()) {
+      const blender::nodes::ImplicitInputValueFn *implicit_input_fn =
+          declaration->inputs()[i]->implicit_input_fn();
+      if (implicit_input_fn == nullptr || node->input_socket(i).is_directly_linked()) {
+        continue;
+      }
+      using ImplicitInputFnPtr = void (*)(const bNode &node, void *r_value);
+      const ImplicitInputFnPtr *fn_ptr = implicit_input_fn->target<ImplicitInputFnPtr>();
+      if (fn_ptr == nullptr || *fn_ptr != blender::nodes::implicit_field_inputs::position) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool use_streaming_evaluation(const bNodeTree &tree, const GeometrySet &geometry_set)
+{
+  const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read();
+  if (pointcloud == nullptr || pointcloud->totpoint <= streaming_batch_size) {
+    return false;
+  }
+  if (geometry_set.get_components_for_read().size() != 1) {
+    return false;
+  }
+  return node_tree_is_pointwise(tree);
+}
+
+static PointCloud *copy_pointcloud_range(const PointCloud &src_pointcloud, const IndexRange range)
+{
+  PointCloud *dst_pointcloud = BKE_pointcloud_new_nomain(int(range.size()));
+  const blender::bke::AttributeAccessor src_attributes = src_pointcloud.attributes();
+  blender::bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
+  src_attributes.for_all(
+      [&](const blender::bke::AttributeIDRef &id, const AttributeMetaData &meta_data) {
+        const GVArray src = src_attributes.lookup(id, ATTR_DOMAIN_POINT);
+        blender::bke::GSpanAttributeWriter dst = dst_attributes.lookup_or_add_for_write_span(
+            id, ATTR_DOMAIN_POINT, meta_data.data_type);
+        if (src && dst) {
+          src.materialize_compressed(range, dst.span.data());
+        }
+        dst.finish();
+        return true;
+      });
+  return dst_pointcloud;
+}
+
+/**
+ * Evaluate the node tree on batches of the input point cloud and join the results, so that the
+ * memory used by intermediate values in the tree doesn't scale with the number of points.
+ * Only the first batch is logged, so the node editor shows the values of that batch.
+ */
+static GeometrySet compute_geometry_in_batches(
+    const bNodeTree &btree,
+    const blender::nodes::GeometryNodesLazyFunctionGraphInfo &lf_graph_info,
+    const bNode &output_node,
+    GeometrySet input_geometry_set,
+    NodesModifierData *nmd,
+    const ModifierEvalContext *ctx)
+{
+  const PointCloud &pointcloud = *input_geometry_set.get_pointcloud_for_read();
+  const IndexRange points(pointcloud.totpoint);
+  const int batches_num = (pointcloud.totpoint + streaming_batch_size - 1) /
+                          streaming_batch_size;
+
+  GeometrySet result;
+  InstancesComponent &instances = result.get_component_for_write<InstancesComponent>();
+  for (const int batch : IndexRange(batches_num)) {
+    const IndexRange batch_range = IndexRange(batch * streaming_batch_size, streaming_batch_size)
+                                       .intersect(points);
+    GeometrySet batch_geometry = GeometrySet::create_with_pointcloud(
+        copy_pointcloud_range(pointcloud, batch_range));
+    batch_geometry = compute_geometry(btree,
+                                      lf_graph_info,
+                                      output_node,
+                                      std::move(batch_geometry),
+                                      nmd,
+                                      ctx,
+                                      batch == 0 && logging_enabled(ctx));
+    const int handle = instances.add_reference(std::move(batch_geometry));
+    instances.add_instance(handle, blender::float4x4::identity());
+  }
+  input_geometry_set.clear();
+
+  blender::geometry::RealizeInstancesOptions options;
+  options.keep_original_ids = true;
+  options.realize_instance_attributes = false;
+  return blender::geometry::realize_instances(std::move(result), options);
+}
+
 /**
  * \note This could be done in #initialize_group_input, though that would require adding the
  * the object as a parameter, so it's likely better to this check as a separate step.
@@ -1261,6 +1412,8 @@ static void modifyGeometry(ModifierData *md,
     return;
   }
 
+  BLI_TRACE_SCOPE("Geometry Nodes Modifier");
+
   const bNodeTree &tree = *nmd->node_group;
   tree.ensure_topology_cache();
   check_property_socket_sync(ctx->object, md);
@@ -1304,8 +1457,19 @@ static void modifyGeometry(ModifierData *md,
     use_orig_index_polys = CustomData_has_layer(&mesh.pdata, CD_ORIGINDEX);
   }
 
-  geometry_set = compute_geometry(
-      tree, *lf_graph_info, *output_node, std::move(geometry_set), nmd, ctx);
+  if (use_streaming_evaluation(tree, geometry_set)) {
+    geometry_set = compute_geometry_in_batches(
+        tree, *lf_graph_info, *output_node, std::move(geometry_set), nmd, ctx);
+  }
+  else {
+    geometry_set = compute_geometry(tree,
+                                    *lf_graph_info,
+                                    *output_node,
+                                    std::move(geometry_set),
+                                    nmd,
+                                    ctx,
+                                    logging_enabled(ctx));
+  }
 
   if (geometry_set.has_mesh()) {
     /* Add #CD_ORIGINDEX layers if they don't exist already. This is required because the
@@ -43,6 +43,10 @@ struct SpaceNode;
 struct SpaceSpreadsheet;
 struct NodesModifierData;
 
+namespace blender::io::serialize {
+class DictionaryValue;
+}
+
 namespace blender::nodes::geo_eval_log {
 
 using fn::GField;
@@ -162,6 +166,32 @@ class ViewerNodeLog {
 using Clock = std::chrono::steady_clock;
 using TimePoint = Clock::time_point;
 
+/**
+ * Additional measurements of a node execution that are only logged when profiling is enabled with
+ * `--debug-geometry-nodes-profile`. Together with the wall time they show whether a node is slow
+ * because of its own work, because it waits for other threads or because it copies geometry.
+ */
+struct NodeProfile {
+  /**
+   * Time that the thread executing the node spent on the CPU. Work done by other threads is not
+   * included, so the difference to the wall time is mostly spent waiting for them.
+   */
+  std::chrono::nanoseconds cpu_time{0};
+  /**
+   * Change of the memory allocated with guarded-alloc. Other nodes that are executed at the same
+   * time influence this as well, the value is only exact in single threaded evaluation.
+   */
+  int64_t allocated_bytes = 0;
+  /** Number of geometry components that had to be copied because they were shared. */
+  int64_t geometry_copies = 0;
+
+  /** Get the counters of the current thread, the difference of two calls is the profile. */
+  static NodeProfile measure_current_thread();
+
+  NodeProfile &operator+=(const NodeProfile &other);
+  friend NodeProfile operator-(const NodeProfile &a, const NodeProfile &b);
+};
+
 /**
  * Logs all data for a specific geometry node tree in a specific context. When the same node group
  * is used in multiple times each instantiation will have a separate logger.
@@ -188,6 +218,10 @@ class GeoTreeLogger {
     TimePoint start;
     TimePoint end;
   };
+  struct NodeProfileWithNode {
+    StringRefNull node_name;
+    NodeProfile profile;
+  };
   struct ViewerNodeLogWithNode {
     StringRefNull node_name;
     destruct_ptr<ViewerNodeLog> viewer_log;
@@ -206,6 +240,7 @@ class GeoTreeLogger {
   Vector<SocketValueLog> input_socket_values;
   Vector<SocketValueLog> output_socket_values;
   Vector<NodeExecutionTime> node_execution_times;
+  Vector<NodeProfileWithNode, 0> node_profiles;
   Vector<ViewerNodeLogWithNode, 0> viewer_node_logs;
   Vector<AttributeUsageWithNode, 0> used_named_attributes;
   Vector<DebugMessage, 0> debug_messages;
@@ -234,6 +269,8 @@ class GeoNodeLog {
    * inside.
    */
   std::chrono::nanoseconds run_time{0};
+  /** Only available when profiling is enabled. For node groups this is the sum as well. */
+  std::optional<NodeProfile> profile;
   /** Maps from socket identifiers to their values. */
   Map<StringRefNull, ValueLog *> input_values_;
   Map<StringRefNull, ValueLog *> output_values_;
@@ -273,6 +310,7 @@ class GeoTreeLog {
   Map<StringRefNull, ViewerNodeLog *, 0> viewer_node_logs;
   Vector<NodeWarning> all_warnings;
   std::chrono::nanoseconds run_time_sum{0};
+  std::optional<NodeProfile> profile_sum;
   Vector<const GeometryAttributeInfo *> existing_attributes;
   Map<StringRefNull, NamedAttributeUsage> used_named_attributes;
 
@@ -288,6 +326,15 @@ class GeoTreeLog {
   void ensure_debug_messages();
 
   ValueLog *find_socket_value_log(const bNodeSocket &query_socket);
+
+  /**
+   * Write the run times and profiles of all nodes as JSON. Nodes in nested node groups are
+   * written as children of their group node. The \a name is used for the tree itself.
+   */
+  void write_profile_json(std::ostream &stream, StringRefNull name);
+
+ private:
+  std::shared_ptr<io::serialize::DictionaryValue> profile_json_value(StringRefNull name);
 };
 
 /**
@@ -316,6 +363,9 @@ class GeoModifierLog {
   Map<ComputeContextHash, std::unique_ptr<GeoTreeLog>> tree_logs_;
 
  public:
+  /** Log a #NodeProfile for every executed node, which has some overhead. */
+  bool use_profiling = false;
+
   GeoModifierLog();
   ~GeoModifierLog();
 
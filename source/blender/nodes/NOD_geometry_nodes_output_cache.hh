@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/**
+ * Some geometry nodes are so slow that it's worth remembering their outputs across evaluations
+ * of the node tree. When such a node is evaluated again with the same settings and inputs, e.g.
+ * while scrubbing the timeline when only unrelated parts of the tree are animated, the cached
+ * outputs are used instead of executing the node.
+ *
+ * Inputs are compared by their content, because geometries don't have stable identifiers across
+ * evaluations. Hashing the input geometry has to be much faster than the node itself, so only
+ * nodes that set #bNodeType.geometry_node_cache_outputs use the cache. Nodes with field inputs or
+ * geometry that isn't a mesh are never cached.
+ *
+ * The cache has a fixed memory budget. When it's full, the least recently used outputs are
+ * removed.
+ */
+
+#include "BLI_function_ref.hh"
+
+#include "FN_lazy_function.hh"
+
+struct bNode;
+
+namespace blender::nodes::node_output_cache {
+
+namespace lf = fn::lazy_function;
+
+/**
+ * Set the outputs of a node that doesn't support laziness from the cache, or call the execute
+ * function and add its outputs to the cache. Inputs that can't be compared, like fields, always
+ * execute the node.
+ */
+void execute_cached(const bNode &node,
+                    const lf::LazyFunction &fn,
+                    lf::Params &params,
+                    FunctionRef<void(lf::Params &params)> execute);
+
+/** Free all cached outputs. */
+void clear();
+
+}  // namespace blender::nodes::node_output_cache
@@ -474,6 +474,8 @@ void register_node_type_cmp_output_file()
       &ntype, "NodeImageMultiFile", file_ns::free_output_file, file_ns::copy_output_file);
   node_type_update(&ntype, file_ns::update_output_file);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.realtime_compositor_unsupported_message = N_(
+      "Node not supported in the Viewport compositor");
 
   nodeRegisterType(&ntype);
 }
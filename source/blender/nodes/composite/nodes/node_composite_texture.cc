@@ -55,6 +55,8 @@ void register_node_type_cmp_texture()
   ntype.declare = file_ns::cmp_node_texture_declare;
   ntype.flag |= NODE_PREVIEW;
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.realtime_compositor_unsupported_message = N_(
+      "Node not supported in the Viewport compositor");
 
   nodeRegisterType(&ntype);
 }
@@ -91,6 +91,8 @@ void register_node_type_cmp_tonemap()
   node_type_init(&ntype, file_ns::node_composit_init_tonemap);
   node_type_storage(&ntype, "NodeTonemap", node_free_standard_storage, node_copy_standard_storage);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.realtime_compositor_unsupported_message = N_(
+      "Node not supported in the Viewport compositor");
 
   nodeRegisterType(&ntype);
 }
@@ -62,6 +62,9 @@ static void mesh_flip_faces(Mesh &mesh, const Field<bool> &selection_field)
         }
         return true;
       });
+
+  /* The winding order changed, which invalidates the normals and the cached topology maps. */
+  BKE_mesh_runtime_clear_geometry(&mesh);
 }
 
 static void node_geo_exec(GeoNodeExecParams params)
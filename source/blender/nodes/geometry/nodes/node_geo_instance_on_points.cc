@@ -2,6 +2,8 @@
 
 #include "DNA_collection_types.h"
 
+#include "BLI_array_utils.hh"
+#include "BLI_devirtualize_parameters.hh"
 #include "BLI_hash.h"
 #include "BLI_task.hh"
 
@@ -42,6 +44,41 @@ static void node_declare(NodeDeclarationBuilder &b)
   b.add_output<decl::Geometry>(N_("Instances"));
 }
 
+/**
+ * Rotation and scale are often the same for all instances. Then the matrix only has to be built
+ * once and only the location differs for every instance. Otherwise the virtual arrays are
+ * devirtualized to avoid the virtual function call overhead for every element.
+ */
+static void compute_base_transforms(const IndexMask selection,
+                                    const VArray<float3> &positions,
+                                    const VArray<float3> &rotations,
+                                    const VArray<float3> &scales,
+                                    MutableSpan<float4x4> r_transforms)
+{
+  const VArraySpan<float3> positions_span{positions};
+  if (rotations.is_single() && scales.is_single()) {
+    const float4x4 rotation_scale = float4x4::from_loc_eul_scale(
+        float3(0), rotations.get_internal_single(), scales.get_internal_single());
+    threading::parallel_for(selection.index_range(), 4096, [&](IndexRange selection_range) {
+      for (const int range_i : selection_range) {
+        float4x4 &transform = r_transforms[range_i];
+        transform = rotation_scale;
+        copy_v3_v3(transform.values[3], positions_span[selection[range_i]]);
+      }
+    });
+    return;
+  }
+  devirtualize_varray2(rotations, scales, [&](const auto rotations, const auto scales) {
+    threading::parallel_for(selection.index_range(), 1024, [&](IndexRange selection_range) {
+      for (const int range_i : selection_range) {
+        const int64_t i = selection[range_i];
+        r_transforms[range_i] = float4x4::from_loc_eul_scale(
+            positions_span[i], rotations[i], scales[i]);
+      }
+    });
+  });
+}
+
 static void add_instances_from_component(
     InstancesComponent &dst_component,
     const GeometryComponent &src_component,
@@ -108,44 +145,48 @@ static void add_instances_from_component(
   /* Add this reference last, because it is the most likely one to be removed later on. */
   const int empty_reference_handle = dst_component.add_reference(InstanceReference());
 
-  threading::parallel_for(selection.index_range(), 1024, [&](IndexRange selection_range) {
-    for (const int range_i : selection_range) {
-      const int64_t i = selection[range_i];
-
-      /* Compute base transform for every instances. */
-      float4x4 &dst_transform = dst_transforms[range_i];
-      dst_transform = float4x4::from_loc_eul_scale(positions[i], rotations[i], scales[i]);
-
-      /* Reference that will be used by this new instance. */
-      int dst_handle = empty_reference_handle;
-
-      const bool use_individual_instance = pick_instance[i];
-      if (use_individual_instance) {
-        if (src_instances != nullptr) {
-          const int src_instances_num = src_instances->instances_num();
-          const int original_index = indices[i];
-          /* Use #mod_i instead of `%` to get the desirable wrap around behavior where -1
-           * refers to the last element. */
-          const int index = mod_i(original_index, std::max(src_instances_num, 1));
-          if (index < src_instances_num) {
-            /* Get the reference to the source instance. */
-            const int src_handle = src_instances->instance_reference_handles()[index];
-            dst_handle = handle_mapping[src_handle];
-
-            /* Take transforms of the source instance into account. */
-            mul_m4_m4_post(dst_transform.values,
-                           src_instances->instance_transforms()[index].values);
+  compute_base_transforms(selection, positions, rotations, scales, dst_transforms);
+
+  if (pick_instance.is_single() && !pick_instance.get_internal_single()) {
+    /* Use entire source geometry as instance everywhere. */
+    dst_handles.fill(full_instance_handle);
+  }
+  else {
+    threading::parallel_for(selection.index_range(), 1024, [&](IndexRange selection_range) {
+      for (const int range_i : selection_range) {
+        const int64_t i = selection[range_i];
+
+        /* Reference that will be used by this new instance. */
+        int dst_handle = empty_reference_handle;
+
+        const bool use_individual_instance = pick_instance[i];
+        if (use_individual_instance) {
+          if (src_instances != nullptr) {
+            const int src_instances_num = src_instances->instances_num();
+            const int original_index = indices[i];
+            /* Use #mod_i instead of `%` to get the desirable wrap around behavior where -1
+             * refers to the last element. */
+            const int index = mod_i(original_index, std::max(src_instances_num, 1));
+            if (index < src_instances_num) {
+              /* Get the reference to the source instance. */
+              const int src_handle = src_instances->instance_reference_handles()[index];
+              dst_handle = handle_mapping[src_handle];
+
+              /* Take transforms of the source instance into account. */
+              mul_m4_m4_post(dst_transforms[range_i].values,
+                             src_instances->instance_transforms()[index].values);
+            }
           }
         }
+        else {
+          /* Use entire source geometry as instance. */
+          dst_handle = full_instance_handle;
+        }
+        /* Set properties of new instance. */
+        dst_handles[range_i] = dst_handle;
       }
-      else {
-        /* Use entire source geometry as instance. */
-        dst_handle = full_instance_handle;
-      }
-      /* Set properties of new instance. */
-      dst_handles[range_i] = dst_handle;
-    }
-  });
+    });
+  }
 
   if (pick_instance.is_single()) {
     if (pick_instance.get_internal_single()) {
@@ -175,17 +216,7 @@ static void add_instances_from_component(
     }
     BLI_assert(dst_attribute_opt);
     const GMutableSpan dst_attribute = dst_attribute_opt->slice(start_len, select_len);
-    threading::parallel_for(selection.index_range(), 1024, [&](IndexRange selection_range) {
-      attribute_math::convert_to_static_type(attribute_kind.data_type, [&](auto dummy) {
-        using T = decltype(dummy);
-        VArray<T> src = src_attribute.typed<T>();
-        MutableSpan<T> dst = dst_attribute.typed<T>();
-        for (const int range_i : selection_range) {
-          const int i = selection[range_i];
-          dst[range_i] = src[i];
-        }
-      });
-    });
+    array_utils::gather(src_attribute, selection, dst_attribute, 1024);
   }
 }
 
@@ -60,8 +60,8 @@ class CornersOfVertInput final : public bke::MeshFieldInput {
   {
     const IndexRange vert_range(mesh.totvert);
     const Span<MLoop> loops = mesh.loops();
-    Array<Vector<int>> vert_to_corner_map = mesh_topology::build_vert_to_corner_map(loops,
-                                                                                    mesh.totvert);
+    const mesh_topology::GroupedIndices vert_to_corner_map = mesh_topology::vert_to_corner_map(
+        mesh);
 
     const bke::MeshFieldContext context{mesh, domain};
     fn::FieldEvaluator evaluator{context, &mask};
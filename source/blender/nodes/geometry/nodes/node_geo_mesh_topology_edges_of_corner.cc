@@ -77,10 +77,9 @@ class CornerPreviousEdgeFieldInput final : public bke::MeshFieldInput {
     }
     const Span<MPoly> polys = mesh.polys();
     const Span<MLoop> loops = mesh.loops();
-    Array<int> corner_to_poly_map = mesh_topology::build_corner_to_poly_map(polys, mesh.totloop);
+    const Span<int> corner_to_poly_map = mesh_topology::corner_to_poly_map(mesh);
     return VArray<int>::ForFunc(
-        mesh.totloop,
-        [polys, loops, corner_to_poly_map = std::move(corner_to_poly_map)](const int corner_i) {
+        mesh.totloop, [polys, loops, corner_to_poly_map](const int corner_i) {
           const int poly_i = corner_to_poly_map[corner_i];
           const MPoly &poly = polys[poly_i];
           const int corner_i_prev = mesh_topology::previous_poly_corner(poly, corner_i);
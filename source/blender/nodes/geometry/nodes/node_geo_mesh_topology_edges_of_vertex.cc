@@ -59,9 +59,7 @@ class EdgesOfVertInput final : public bke::MeshFieldInput {
                                  const IndexMask mask) const final
   {
     const IndexRange vert_range(mesh.totvert);
-    const Span<MEdge> edges = mesh.edges();
-    Array<Vector<int>> vert_to_edge_map = mesh_topology::build_vert_to_edge_map(edges,
-                                                                                mesh.totvert);
+    const mesh_topology::GroupedIndices vert_to_edge_map = mesh_topology::vert_to_edge_map(mesh);
 
     const bke::MeshFieldContext context{mesh, domain};
     fn::FieldEvaluator evaluator{context, &mask};
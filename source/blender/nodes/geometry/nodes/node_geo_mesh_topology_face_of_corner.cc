@@ -35,8 +35,7 @@ class CornerFaceIndexInput final : public bke::MeshFieldInput {
     if (domain != ATTR_DOMAIN_CORNER) {
       return {};
     }
-    return VArray<int>::ForContainer(
-        mesh_topology::build_corner_to_poly_map(mesh.polys(), mesh.totloop));
+    return VArray<int>::ForSpan(mesh_topology::corner_to_poly_map(mesh));
   }
 
   uint64_t hash() const final
@@ -65,10 +64,9 @@ class CornerIndexInFaceInput final : public bke::MeshFieldInput {
       return {};
     }
     const Span<MPoly> polys = mesh.polys();
-    Array<int> corner_to_poly_map = mesh_topology::build_corner_to_poly_map(polys, mesh.totloop);
+    const Span<int> corner_to_poly_map = mesh_topology::corner_to_poly_map(mesh);
     return VArray<int>::ForFunc(
-        mesh.totloop,
-        [polys, corner_to_poly_map = std::move(corner_to_poly_map)](const int corner_i) {
+        mesh.totloop, [polys, corner_to_poly_map](const int corner_i) {
           const int poly_i = corner_to_poly_map[corner_i];
           return corner_i - polys[poly_i].loopstart;
         });
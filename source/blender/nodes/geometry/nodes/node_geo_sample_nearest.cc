@@ -26,22 +26,29 @@ void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
   BLI_assert(positions.size() >= r_distances_sq.size());
   BLI_assert(positions.size() >= r_positions.size());
 
-  for (const int i : mask) {
+  threading::parallel_for(mask.index_range(), 512, [&](const IndexRange range) {
     BVHTreeNearest nearest;
-    nearest.dist_sq = FLT_MAX;
-    const float3 position = positions[i];
-    BLI_bvhtree_find_nearest(
-        tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
-    if (!r_indices.is_empty()) {
-      r_indices[i] = nearest.index;
-    }
-    if (!r_distances_sq.is_empty()) {
-      r_distances_sq[i] = nearest.dist_sq;
-    }
-    if (!r_positions.is_empty()) {
-      r_positions[i] = nearest.co;
+    copy_v3_fl(nearest.co, FLT_MAX);
+    nearest.index = -1;
+
+    for (const int i : mask.slice(range)) {
+      const float3 position = positions[i];
+      /* Use the distance to the last found point as upper bound to speedup the bvh lookup. */
+      nearest.dist_sq = math::distance_squared(float3(nearest.co), position);
+
+      BLI_bvhtree_find_nearest(
+          tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
+      if (!r_indices.is_empty()) {
+        r_indices[i] = nearest.index;
+      }
+      if (!r_distances_sq.is_empty()) {
+        r_distances_sq[i] = nearest.dist_sq;
+      }
+      if (!r_positions.is_empty()) {
+        r_positions[i] = nearest.co;
+      }
     }
-  }
+  });
 }
 
 }  // namespace blender::nodes
@@ -79,17 +86,24 @@ static void get_closest_pointcloud_points(const PointCloud &pointcloud,
   BVHTreeFromPointCloud tree_data;
   BKE_bvhtree_from_pointcloud_get(&tree_data, &pointcloud, 2);
 
-  for (const int i : mask) {
+  threading::parallel_for(mask.index_range(), 512, [&](const IndexRange range) {
     BVHTreeNearest nearest;
-    nearest.dist_sq = FLT_MAX;
-    const float3 position = positions[i];
-    BLI_bvhtree_find_nearest(
-        tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
-    r_indices[i] = nearest.index;
-    if (!r_distances_sq.is_empty()) {
-      r_distances_sq[i] = nearest.dist_sq;
+    copy_v3_fl(nearest.co, FLT_MAX);
+    nearest.index = -1;
+
+    for (const int i : mask.slice(range)) {
+      const float3 position = positions[i];
+      /* Use the distance to the last found point as upper bound to speedup the bvh lookup. */
+      nearest.dist_sq = math::distance_squared(float3(nearest.co), position);
+
+      BLI_bvhtree_find_nearest(
+          tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
+      r_indices[i] = nearest.index;
+      if (!r_distances_sq.is_empty()) {
+        r_distances_sq[i] = nearest.dist_sq;
+      }
     }
-  }
+  });
 
   free_bvhtree_from_pointcloud(&tree_data);
 }
@@ -13,6 +13,7 @@
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_output_cache.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 
@@ -126,17 +127,40 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
     BLI_assert(user_data != nullptr);
 
-    GeoNodeExecParams geo_params{node_, params, context};
+    const auto execute = [&](lf::Params &params) {
+      GeoNodeExecParams geo_params{node_, params, context};
+      node_.typeinfo->geometry_node_execute(geo_params);
+    };
+
+    geo_eval_log::GeoModifierLog *modifier_log = user_data->modifier_data->eval_log;
+    const bool use_profiling = modifier_log != nullptr && modifier_log->use_profiling;
+    geo_eval_log::NodeProfile profile_start;
+    if (use_profiling) {
+      profile_start = geo_eval_log::NodeProfile::measure_current_thread();
+    }
 
     geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
-    node_.typeinfo->geometry_node_execute(geo_params);
+    if (node_.typeinfo->geometry_node_cache_outputs &&
+        !node_.typeinfo->geometry_node_execute_supports_laziness) {
+      node_output_cache::execute_cached(node_, *this, params, execute);
+    }
+    else {
+      execute(params);
+    }
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
+    geo_eval_log::NodeProfile profile;
+    if (use_profiling) {
+      profile = geo_eval_log::NodeProfile::measure_current_thread() - profile_start;
+    }
 
-    if (geo_eval_log::GeoModifierLog *modifier_log = user_data->modifier_data->eval_log) {
+    if (modifier_log != nullptr) {
       geo_eval_log::GeoTreeLogger &tree_logger = modifier_log->get_local_tree_logger(
           *user_data->compute_context);
-      tree_logger.node_execution_times.append(
-          {tree_logger.allocator->copy_string(node_.name), start_time, end_time});
+      const StringRefNull node_name = tree_logger.allocator->copy_string(node_.name);
+      tree_logger.node_execution_times.append({node_name, start_time, end_time});
+      if (use_profiling) {
+        tree_logger.node_profiles.append({node_name, profile});
+      }
     }
   }
 };
@@ -1,8 +1,16 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <ctime>
+
+#ifdef WIN32
+#  include <windows.h>
+#endif
+
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_geometry_nodes_log.hh"
 
+#include "BLI_serialize.hh"
+
 #include "BKE_compute_contexts.hh"
 #include "BKE_curves.hh"
 #include "BKE_node_runtime.hh"
@@ -15,11 +23,60 @@
 
 #include "ED_viewer_path.hh"
 
+#include "MEM_guardedalloc.h"
+
 namespace blender::nodes::geo_eval_log {
 
 using fn::FieldInput;
 using fn::FieldInputs;
 
+static std::chrono::nanoseconds get_thread_cpu_time()
+{
+#ifdef WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(
+          GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+    return std::chrono::nanoseconds(0);
+  }
+  /* The times are in units of 100 nanoseconds. */
+  const uint64_t kernel = (uint64_t(kernel_time.dwHighDateTime) << 32) | kernel_time.dwLowDateTime;
+  const uint64_t user = (uint64_t(user_time.dwHighDateTime) << 32) | user_time.dwLowDateTime;
+  return std::chrono::nanoseconds((kernel + user) * 100);
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
+
+NodeProfile NodeProfile::measure_current_thread()
+{
+  NodeProfile profile;
+  profile.cpu_time = get_thread_cpu_time();
+  profile.allocated_bytes = int64_t(MEM_get_memory_in_use());
+  profile.geometry_copies = GeometrySet::copied_components_num_on_thread();
+  return profile;
+}
+
+NodeProfile &NodeProfile::operator+=(const NodeProfile &other)
+{
+  this->cpu_time += other.cpu_time;
+  this->allocated_bytes += other.allocated_bytes;
+  this->geometry_copies += other.geometry_copies;
+  return *this;
+}
+
+NodeProfile operator-(const NodeProfile &a, const NodeProfile &b)
+{
+  NodeProfile profile;
+  profile.cpu_time = a.cpu_time - b.cpu_time;
+  profile.allocated_bytes = a.allocated_bytes - b.allocated_bytes;
+  profile.geometry_copies = a.geometry_copies - b.geometry_copies;
+  return profile;
+}
+
 GenericValueLog::~GenericValueLog()
 {
   this->value.destruct();
@@ -223,6 +280,14 @@ void GeoTreeLog::ensure_node_warnings()
   reduced_node_warnings_ = true;
 }
 
+static void add_profile(std::optional<NodeProfile> &sum, const NodeProfile &profile)
+{
+  if (!sum) {
+    sum.emplace();
+  }
+  *sum += profile;
+}
+
 void GeoTreeLog::ensure_node_run_time()
 {
   if (reduced_node_run_times_) {
@@ -234,6 +299,11 @@ void GeoTreeLog::ensure_node_run_time()
       this->nodes.lookup_or_add_default_as(timings.node_name).run_time += duration;
       this->run_time_sum += duration;
     }
+    for (const GeoTreeLogger::NodeProfileWithNode &item : tree_logger->node_profiles) {
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default_as(item.node_name);
+      add_profile(node_log.profile, item.profile);
+      add_profile(this->profile_sum, item.profile);
+    }
   }
   for (const ComputeContextHash &child_hash : children_hashes_) {
     GeoTreeLog &child_log = modifier_log_->get_tree_log(child_hash);
@@ -241,9 +311,16 @@ void GeoTreeLog::ensure_node_run_time()
     const std::optional<std::string> &group_node_name =
         child_log.tree_loggers_[0]->group_node_name;
     if (group_node_name.has_value()) {
-      this->nodes.lookup_or_add_default(*group_node_name).run_time += child_log.run_time_sum;
+      GeoNodeLog &group_node_log = this->nodes.lookup_or_add_default(*group_node_name);
+      group_node_log.run_time += child_log.run_time_sum;
+      if (child_log.profile_sum) {
+        add_profile(group_node_log.profile, *child_log.profile_sum);
+      }
     }
     this->run_time_sum += child_log.run_time_sum;
+    if (child_log.profile_sum) {
+      add_profile(this->profile_sum, *child_log.profile_sum);
+    }
   }
   reduced_node_run_times_ = true;
 }
@@ -433,6 +510,75 @@ ValueLog *GeoTreeLog::find_socket_value_log(const bNodeSocket &query_socket)
   return nullptr;
 }
 
+static void add_profile_json_values(io::serialize::DictionaryValue::Items &items,
+                                    const std::chrono::nanoseconds run_time,
+                                    const std::optional<NodeProfile> &profile)
+{
+  using namespace io::serialize;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  items.append_as("wall_time_ms", std::make_shared<DoubleValue>(Milliseconds(run_time).count()));
+  if (profile) {
+    items.append_as("cpu_time_ms",
+                    std::make_shared<DoubleValue>(Milliseconds(profile->cpu_time).count()));
+    items.append_as("allocated_bytes", std::make_shared<IntValue>(profile->allocated_bytes));
+    items.append_as("geometry_copies", std::make_shared<IntValue>(profile->geometry_copies));
+  }
+}
+
+std::shared_ptr<io::serialize::DictionaryValue> GeoTreeLog::profile_json_value(
+    const StringRefNull name)
+{
+  using namespace io::serialize;
+  this->ensure_node_run_time();
+
+  Map<StringRefNull, GeoTreeLog *> child_log_by_group_node;
+  for (const ComputeContextHash &child_hash : children_hashes_) {
+    GeoTreeLog &child_log = modifier_log_->get_tree_log(child_hash);
+    const std::optional<StringRefNull> &group_node_name =
+        child_log.tree_loggers_[0]->group_node_name;
+    if (group_node_name.has_value()) {
+      child_log_by_group_node.add(*group_node_name, &child_log);
+    }
+  }
+
+  /* Put the slowest nodes first. */
+  Vector<std::pair<StringRefNull, const GeoNodeLog *>> executed_nodes;
+  for (const auto item : this->nodes.items()) {
+    if (item.value.run_time.count() > 0 || item.value.profile.has_value()) {
+      executed_nodes.append({item.key, &item.value});
+    }
+  }
+  std::sort(executed_nodes.begin(), executed_nodes.end(), [](const auto &a, const auto &b) {
+    return a.second->run_time > b.second->run_time;
+  });
+
+  std::shared_ptr<ArrayValue> nodes_value = std::make_shared<ArrayValue>();
+  for (const auto &[node_name, node_log] : executed_nodes) {
+    std::shared_ptr<DictionaryValue> node_value;
+    if (GeoTreeLog *child_log = child_log_by_group_node.lookup_default(node_name, nullptr)) {
+      node_value = child_log->profile_json_value(node_name);
+    }
+    else {
+      node_value = std::make_shared<DictionaryValue>();
+      node_value->elements().append_as("name", std::make_shared<StringValue>(node_name));
+      add_profile_json_values(node_value->elements(), node_log->run_time, node_log->profile);
+    }
+    nodes_value->elements().append(std::move(node_value));
+  }
+
+  std::shared_ptr<DictionaryValue> tree_value = std::make_shared<DictionaryValue>();
+  tree_value->elements().append_as("name", std::make_shared<StringValue>(name));
+  add_profile_json_values(tree_value->elements(), this->run_time_sum, this->profile_sum);
+  tree_value->elements().append_as("nodes", std::move(nodes_value));
+  return tree_value;
+}
+
+void GeoTreeLog::write_profile_json(std::ostream &stream, const StringRefNull name)
+{
+  io::serialize::JsonFormatter json;
+  json.serialize(stream, *this->profile_json_value(name));
+}
+
 GeoTreeLogger &GeoModifierLog::get_local_tree_logger(const ComputeContext &compute_context)
 {
   LocalData &local_data = data_per_thread_.local();
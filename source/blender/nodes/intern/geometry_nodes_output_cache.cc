@@ -0,0 +1,453 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <mutex>
+#include <optional>
+
+#include "BLI_generic_pointer.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_map.hh"
+#include "BLI_task.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_geometry_set.hh"
+#include "BKE_node.h"
+
+#include "FN_field_cpp_type.hh"
+
+#include "NOD_geometry_nodes_output_cache.hh"
+
+namespace blender::nodes::node_output_cache {
+
+using fn::ValueOrFieldCPPType;
+
+/** Outputs that would make the cache larger than this are not stored. */
+static constexpr int64_t cache_memory_budget = int64_t(1024) * 1024 * 1024;
+
+/* -------------------------------------------------------------------- */
+/** \name Cache Key
+ * \{ */
+
+/**
+ * Identifies a node with its settings and input values. Two independent hashes make accidental
+ * collisions practically impossible, which is important because a collision would silently give
+ * wrong results.
+ */
+struct CacheKey {
+  uint64_t hash_a = 0;
+  uint64_t hash_b = 0;
+
+  void add(const uint64_t value)
+  {
+    hash_a = (hash_a ^ value) * uint64_t(0x9E3779B97F4A7C15);
+    hash_a ^= hash_a >> 32;
+    hash_b = (hash_b + value) * uint64_t(0xC2B2AE3D27D4EB4F);
+    hash_b ^= hash_b >> 29;
+  }
+
+  void add_bytes(const void *data, int64_t size);
+
+  uint64_t hash() const
+  {
+    return hash_a;
+  }
+
+  friend bool operator==(const CacheKey &a, const CacheKey &b)
+  {
+    return a.hash_a == b.hash_a && a.hash_b == b.hash_b;
+  }
+};
+
+static CacheKey hash_bytes_serial(const uint8_t *data, const int64_t size)
+{
+  CacheKey key;
+  int64_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, 8);
+    key.add(word);
+  }
+  if (i < size) {
+    uint64_t word = 0;
+    memcpy(&word, data + i, size_t(size - i));
+    key.add(word);
+  }
+  key.add(uint64_t(size));
+  return key;
+}
+
+void CacheKey::add_bytes(const void *data, const int64_t size)
+{
+  /* Hash chunks in parallel, and combine their hashes in order so that the result is
+   * deterministic. */
+  constexpr int64_t chunk_size = 64 * 1024;
+  const int64_t chunks_num = (size + chunk_size - 1) / chunk_size;
+  if (chunks_num <= 1) {
+    const CacheKey chunk_key = hash_bytes_serial(static_cast<const uint8_t *>(data), size);
+    this->add(chunk_key.hash_a);
+    this->add(chunk_key.hash_b);
+    return;
+  }
+  Array<CacheKey> chunk_keys(chunks_num);
+  threading::parallel_for(chunk_keys.index_range(), 16, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange bytes = IndexRange(chunk * chunk_size, chunk_size)
+                                   .intersect(IndexRange(size));
+      chunk_keys[chunk] = hash_bytes_serial(static_cast<const uint8_t *>(data) + bytes.start(),
+                                            bytes.size());
+    }
+  });
+  for (const CacheKey &chunk_key : chunk_keys) {
+    this->add(chunk_key.hash_a);
+    this->add(chunk_key.hash_b);
+  }
+}
+
+static void add_string(CacheKey &key, const StringRefNull str)
+{
+  key.add_bytes(str.data(), str.size());
+}
+
+static bool add_custom_data(CacheKey &key, const CustomData &data, const int elements_num)
+{
+  key.add(uint64_t(elements_num));
+  key.add(uint64_t(data.totlayer));
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    key.add(uint64_t(layer.type));
+    add_string(key, layer.name);
+    switch (layer.type) {
+      case CD_MDEFORMVERT: {
+        for (const MDeformVert &dvert :
+             Span(static_cast<const MDeformVert *>(layer.data), elements_num)) {
+          key.add(uint64_t(dvert.totweight));
+          key.add_bytes(dvert.dw, int64_t(sizeof(MDeformWeight)) * dvert.totweight);
+        }
+        break;
+      }
+      case CD_MDISPS:
+      case CD_BM_ELEM_PYPTR:
+      case CD_GRID_PAINT_MASK:
+        /* These layers reference other memory that can't be compared. */
+        return false;
+      default:
+        key.add_bytes(layer.data, int64_t(CustomData_sizeof(layer.type)) * elements_num);
+        break;
+    }
+  }
+  return true;
+}
+
+static bool add_mesh(CacheKey &key, const Mesh &mesh)
+{
+  key.add(uint64_t(mesh.flag));
+  key.add(uint64_t(*reinterpret_cast<const uint32_t *>(&mesh.smoothresh)));
+  key.add(uint64_t(mesh.totcol));
+  for (const Material *material : Span(mesh.mat, mesh.totcol)) {
+    /* Materials are data-blocks that are not evaluated by the node tree, so they can be compared
+     * by pointer. */
+    key.add(uint64_t(uintptr_t(material)));
+  }
+  LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+    add_string(key, group->name);
+  }
+  return add_custom_data(key, mesh.vdata, mesh.totvert) &&
+         add_custom_data(key, mesh.edata, mesh.totedge) &&
+         add_custom_data(key, mesh.fdata, mesh.totface) &&
+         add_custom_data(key, mesh.ldata, mesh.totloop) &&
+         add_custom_data(key, mesh.pdata, mesh.totpoly);
+}
+
+static bool add_geometry(CacheKey &key, const GeometrySet &geometry)
+{
+  for (const GeometryComponent *component : geometry.get_components_for_read()) {
+    if (component->type() != GEO_COMPONENT_TYPE_MESH && !component->is_empty()) {
+      return false;
+    }
+  }
+  const Mesh *mesh = geometry.get_mesh_for_read();
+  key.add(mesh != nullptr);
+  if (mesh) {
+    return add_mesh(key, *mesh);
+  }
+  return true;
+}
+
+static bool add_value(CacheKey &key, const CPPType &type, const void *value)
+{
+  if (type.is<GeometrySet>()) {
+    return add_geometry(key, *static_cast<const GeometrySet *>(value));
+  }
+  if (type.is<Vector<GeometrySet>>()) {
+    const Vector<GeometrySet> &geometries = *static_cast<const Vector<GeometrySet> *>(value);
+    key.add(uint64_t(geometries.size()));
+    for (const GeometrySet &geometry : geometries) {
+      if (!add_geometry(key, geometry)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (const ValueOrFieldCPPType *value_or_field_type = dynamic_cast<const ValueOrFieldCPPType *>(
+          &type)) {
+    if (value_or_field_type->is_field(value)) {
+      /* Fields depend on the context they are evaluated in. */
+      return false;
+    }
+    const CPPType &base_type = value_or_field_type->base_type();
+    if (!base_type.is_hashable()) {
+      return false;
+    }
+    key.add(base_type.hash(value_or_field_type->get_value_ptr(value)));
+    return true;
+  }
+  /* Other types like objects are pointers to data that can change without changing the
+   * pointer. */
+  return false;
+}
+
+static std::optional<CacheKey> compute_key(const bNode &node,
+                                           const lf::LazyFunction &fn,
+                                           lf::Params &params)
+{
+  if (node.storage != nullptr) {
+    /* Comparing node storage is not supported yet. */
+    return std::nullopt;
+  }
+  CacheKey key;
+  add_string(key, node.typeinfo->idname);
+  key.add(uint64_t(node.custom1));
+  key.add(uint64_t(node.custom2));
+  key.add(uint64_t(*reinterpret_cast<const uint32_t *>(&node.custom3)));
+  key.add(uint64_t(*reinterpret_cast<const uint32_t *>(&node.custom4)));
+
+  for (const int i : fn.inputs().index_range()) {
+    const void *value = params.try_get_input_data_ptr(i);
+    if (value == nullptr) {
+      return std::nullopt;
+    }
+    if (!add_value(key, *fn.inputs()[i].type, value)) {
+      return std::nullopt;
+    }
+  }
+  for (const int i : fn.outputs().index_range()) {
+    key.add(params.get_output_usage(i) != lf::ValueUsage::Unused);
+  }
+  return key;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Cache Storage
+ * \{ */
+
+struct CachedOutputs {
+  LinearAllocator<> allocator;
+  /** Outputs that were not computed by the node are null. */
+  Vector<GMutablePointer> values;
+  int64_t memory_size = 0;
+  uint64_t last_use = 0;
+
+  ~CachedOutputs()
+  {
+    for (GMutablePointer value : values) {
+      if (value.get() != nullptr) {
+        value.destruct();
+      }
+    }
+  }
+};
+
+struct OutputCache {
+  std::mutex mutex;
+  Map<CacheKey, std::unique_ptr<CachedOutputs>> entries;
+  int64_t memory_size = 0;
+  uint64_t use_counter = 0;
+};
+
+static OutputCache &get_cache()
+{
+  static OutputCache cache;
+  return cache;
+}
+
+static int64_t estimate_custom_data_size(const CustomData &data, const int elements_num)
+{
+  int64_t size = 0;
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    size += int64_t(CustomData_sizeof(layer.type)) * elements_num;
+  }
+  return size;
+}
+
+static int64_t estimate_geometry_size(const GeometrySet &geometry)
+{
+  int64_t size = sizeof(GeometrySet);
+  if (const Mesh *mesh = geometry.get_mesh_for_read()) {
+    size += estimate_custom_data_size(mesh->vdata, mesh->totvert) +
+            estimate_custom_data_size(mesh->edata, mesh->totedge) +
+            estimate_custom_data_size(mesh->ldata, mesh->totloop) +
+            estimate_custom_data_size(mesh->pdata, mesh->totpoly);
+  }
+  return size;
+}
+
+static int64_t estimate_value_size(const CPPType &type, const void *value)
+{
+  if (type.is<GeometrySet>()) {
+    return estimate_geometry_size(*static_cast<const GeometrySet *>(value));
+  }
+  return type.size();
+}
+
+static bool try_load_outputs(const CacheKey &key, const lf::LazyFunction &fn, lf::Params &params)
+{
+  OutputCache &cache = get_cache();
+  std::lock_guard lock{cache.mutex};
+  std::unique_ptr<CachedOutputs> *entry = cache.entries.lookup_ptr(key);
+  if (entry == nullptr) {
+    return false;
+  }
+  CachedOutputs &outputs = **entry;
+  outputs.last_use = ++cache.use_counter;
+  for (const int i : fn.outputs().index_range()) {
+    const GMutablePointer value = outputs.values[i];
+    if (value.get() == nullptr || params.output_was_set(i)) {
+      continue;
+    }
+    value.type()->copy_construct(value.get(), params.get_output_data_ptr(i));
+    params.output_set(i);
+  }
+  return true;
+}
+
+static void remove_least_recently_used(OutputCache &cache)
+{
+  const CacheKey *oldest_key = nullptr;
+  uint64_t oldest_use = UINT64_MAX;
+  for (const auto item : cache.entries.items()) {
+    if (item.value->last_use < oldest_use) {
+      oldest_use = item.value->last_use;
+      oldest_key = &item.key;
+    }
+  }
+  const std::unique_ptr<CachedOutputs> outputs = cache.entries.pop(*oldest_key);
+  cache.memory_size -= outputs->memory_size;
+}
+
+static void store_outputs(const CacheKey &key, std::unique_ptr<CachedOutputs> outputs)
+{
+  if (outputs->memory_size > cache_memory_budget) {
+    return;
+  }
+  OutputCache &cache = get_cache();
+  std::lock_guard lock{cache.mutex};
+  if (cache.entries.contains(key)) {
+    /* Another thread computed the same outputs at the same time. */
+    return;
+  }
+  while (!cache.entries.is_empty() &&
+         cache.memory_size + outputs->memory_size > cache_memory_budget) {
+    remove_least_recently_used(cache);
+  }
+  outputs->last_use = ++cache.use_counter;
+  cache.memory_size += outputs->memory_size;
+  cache.entries.add_new(key, std::move(outputs));
+}
+
+/**
+ * Forwards everything to the params of the caller, but copies every output before it is set,
+ * because the caller may move the value away immediately afterwards.
+ */
+class RecordingParams : public lf::Params {
+ private:
+  lf::Params &params_;
+  CachedOutputs &outputs_;
+
+ public:
+  RecordingParams(const lf::LazyFunction &fn, lf::Params &params, CachedOutputs &outputs)
+      : lf::Params(fn, false), params_(params), outputs_(outputs)
+  {
+    for (const lf::Output &output : fn.outputs()) {
+      outputs_.values.append({*output.type, nullptr});
+    }
+  }
+
+ private:
+  void *try_get_input_data_ptr_impl(const int index) const override
+  {
+    return params_.try_get_input_data_ptr(index);
+  }
+
+  void *try_get_input_data_ptr_or_request_impl(const int index) override
+  {
+    return params_.try_get_input_data_ptr_or_request(index);
+  }
+
+  void *get_output_data_ptr_impl(const int index) override
+  {
+    return params_.get_output_data_ptr(index);
+  }
+
+  void output_set_impl(const int index) override
+  {
+    /* Copying the outputs is cheap, because geometry components share their data. */
+    const CPPType &type = *outputs_.values[index].type();
+    const void *value = params_.get_output_data_ptr(index);
+    void *buffer = outputs_.allocator.allocate(type.size(), type.alignment());
+    type.copy_construct(value, buffer);
+    outputs_.values[index] = {type, buffer};
+    outputs_.memory_size += estimate_value_size(type, value);
+    params_.output_set(index);
+  }
+
+  bool output_was_set_impl(const int index) const override
+  {
+    return params_.output_was_set(index);
+  }
+
+  lf::ValueUsage get_output_usage_impl(const int index) const override
+  {
+    return params_.get_output_usage(index);
+  }
+
+  void set_input_unused_impl(const int index) override
+  {
+    params_.set_input_unused(index);
+  }
+};
+
+void execute_cached(const bNode &node,
+                    const lf::LazyFunction &fn,
+                    lf::Params &params,
+                    const FunctionRef<void(lf::Params &params)> execute)
+{
+  const std::optional<CacheKey> key = compute_key(node, fn, params);
+  if (!key) {
+    execute(params);
+    return;
+  }
+  if (try_load_outputs(*key, fn, params)) {
+    return;
+  }
+  std::unique_ptr<CachedOutputs> outputs = std::make_unique<CachedOutputs>();
+  RecordingParams recording_params{fn, params, *outputs};
+  execute(recording_params);
+  store_outputs(*key, std::move(outputs));
+}
+
+void clear()
+{
+  OutputCache &cache = get_cache();
+  std::lock_guard lock{cache.mutex};
+  cache.entries.clear();
+  cache.memory_size = 0;
+}
+
+/** \} */
+
+}  // namespace blender::nodes::node_output_cache
@@ -120,6 +120,48 @@ class NoiseFunction : public fn::MultiFunction {
     return signature.build();
   }
 
+  /**
+   * Use the vectorized noise functions when all settings except the position are the same for
+   * every element, which is the common case.
+   */
+  static void call_3d_batched(const IndexMask mask,
+                              const VArray<float3> &vector,
+                              const VArray<float> &scale,
+                              const float detail,
+                              const float roughness,
+                              const float distortion,
+                              MutableSpan<float> r_factor,
+                              MutableSpan<ColorGeometry4f> r_color)
+  {
+    const int64_t batch_size = 64;
+    std::array<float3, batch_size> positions;
+    std::array<float, batch_size> factors;
+    std::array<float3, batch_size> colors;
+    for (int64_t start = 0; start < mask.size(); start += batch_size) {
+      const IndexMask batch_mask = mask.slice(start, std::min(batch_size, mask.size() - start));
+      const int64_t size = batch_mask.size();
+      for (const int64_t i : IndexRange(size)) {
+        positions[i] = vector[batch_mask[i]] * scale[batch_mask[i]];
+      }
+      const Span<float3> batch_positions(positions.data(), size);
+      if (!r_factor.is_empty()) {
+        noise::perlin_fractal_distorted(
+            batch_positions, detail, roughness, distortion, {factors.data(), size});
+        for (const int64_t i : IndexRange(size)) {
+          r_factor[batch_mask[i]] = factors[i];
+        }
+      }
+      if (!r_color.is_empty()) {
+        noise::perlin_float3_fractal_distorted(
+            batch_positions, detail, roughness, distortion, {colors.data(), size});
+        for (const int64_t i : IndexRange(size)) {
+          const float3 &c = colors[i];
+          r_color[batch_mask[i]] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+        }
+      }
+    }
+  }
+
   void call(IndexMask mask, fn::MFParams params, fn::MFContext UNUSED(context)) const override
   {
     int param = ELEM(dimensions_, 2, 3, 4) + ELEM(dimensions_, 1, 4);
@@ -177,6 +219,17 @@ class NoiseFunction : public fn::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
+        if (detail.is_single() && roughness.is_single() && distortion.is_single()) {
+          call_3d_batched(mask,
+                          vector,
+                          scale,
+                          detail.get_internal_single(),
+                          roughness.get_internal_single(),
+                          distortion.get_internal_single(),
+                          r_factor,
+                          r_color);
+          break;
+        }
         if (compute_factor) {
           for (int64_t i : mask) {
             const float3 position = vector[i] * scale[i];
@@ -31,8 +31,11 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BKE_appdir.h"
 #include "BKE_blender_version.h"
 #include "BKE_global.h"
@@ -40,6 +43,8 @@
 
 #include "DNA_ID.h"
 
+#include "IMB_moviecache.h"
+
 #include "UI_interface_icons.h"
 
 #include "RNA_enum_types.h" /* For `rna_enum_wm_job_type_items`. */
@@ -433,6 +438,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_doc,
      (void *)G_DEBUG_SIMDATA},
     {"debug_io", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_IO},
+    {"debug_startup_timing",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_STARTUP_TIMING},
 
     {"use_event_simulate",
      bpy_app_global_flag_get,
@@ -515,11 +525,225 @@ static PyObject *bpy_app_is_job_running(PyObject *UNUSED(self), PyObject *args,
   return PyBool_FromLong(WM_jobs_has_running_type(wm, job_type_enum.value));
 }
 
+PyDoc_STRVAR(bpy_app_heap_profile_start_doc,
+             ".. staticmethod:: heap_profile_start(sample_interval=524288)\n"
+             "\n"
+             "   Start sampling memory allocations with their call stacks.\n"
+             "\n"
+             "   :arg sample_interval: Average number of allocated bytes between two samples.\n"
+             "   :type sample_interval: int\n");
+static PyObject *bpy_app_heap_profile_start(PyObject *UNUSED(self),
+                                            PyObject *args,
+                                            PyObject *kwds)
+{
+  Py_ssize_t sample_interval = MEM_HEAP_PROFILE_DEFAULT_SAMPLE_INTERVAL;
+  static const char *_keywords[] = {"sample_interval", NULL};
+  static _PyArg_Parser _parser = {
+      "|$" /* Optional keyword only arguments. */
+      "n"  /* `sample_interval` */
+      ":heap_profile_start",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &sample_interval)) {
+    return NULL;
+  }
+  if (sample_interval <= 0) {
+    PyErr_SetString(PyExc_ValueError, "heap_profile_start: sample_interval must be positive");
+    return NULL;
+  }
+  MEM_heap_profile_start((size_t)sample_interval);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_heap_profile_stop_doc,
+             ".. staticmethod:: heap_profile_stop()\n"
+             "\n"
+             "   Stop sampling memory allocations, samples of memory which is still allocated\n"
+             "   are kept.\n");
+static PyObject *bpy_app_heap_profile_stop(PyObject *UNUSED(self))
+{
+  MEM_heap_profile_stop();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_heap_profile_write_doc,
+             ".. staticmethod:: heap_profile_write(filepath)\n"
+             "\n"
+             "   Write sampled allocations of memory which is still allocated to a file,\n"
+             "   in a heap profile format which can be read by ``pprof``.\n"
+             "\n"
+             "   :arg filepath: File path to write the profile to.\n"
+             "   :type filepath: str\n");
+static PyObject *bpy_app_heap_profile_write(PyObject *UNUSED(self),
+                                            PyObject *args,
+                                            PyObject *kwds)
+{
+  const char *filepath;
+  static const char *_keywords[] = {"filepath", NULL};
+  static _PyArg_Parser _parser = {
+      "s" /* `filepath` */
+      ":heap_profile_write",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &filepath)) {
+    return NULL;
+  }
+  if (!MEM_heap_profile_write(filepath)) {
+    PyErr_Format(PyExc_OSError, "heap_profile_write: unable to write \"%s\"", filepath);
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_trace_start_doc,
+             ".. staticmethod:: trace_start(filepath)\n"
+             "\n"
+             "   Start recording timed events of all threads, written to a file in the Chrome\n"
+             "   trace event format (which can be loaded into Perfetto) by :func:`trace_stop`.\n"
+             "\n"
+             "   :arg filepath: File path to write the trace to.\n"
+             "   :type filepath: str\n");
+static PyObject *bpy_app_trace_start(PyObject *UNUSED(self), PyObject *args, PyObject *kwds)
+{
+  const char *filepath;
+  static const char *_keywords[] = {"filepath", NULL};
+  static _PyArg_Parser _parser = {
+      "s" /* `filepath` */
+      ":trace_start",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &filepath)) {
+    return NULL;
+  }
+  if (BLI_trace_is_recording()) {
+    PyErr_SetString(PyExc_RuntimeError, "trace_start: already recording");
+    return NULL;
+  }
+  BLI_trace_begin_recording(filepath);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_trace_stop_doc,
+             ".. staticmethod:: trace_stop()\n"
+             "\n"
+             "   Stop recording timed events and write them to the file given to\n"
+             "   :func:`trace_start`.\n");
+static PyObject *bpy_app_trace_stop(PyObject *UNUSED(self))
+{
+  if (!BLI_trace_is_recording()) {
+    PyErr_SetString(PyExc_RuntimeError, "trace_stop: not recording");
+    return NULL;
+  }
+  if (!BLI_trace_end_recording()) {
+    PyErr_SetString(PyExc_OSError, "trace_stop: unable to write the trace");
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_image_cache_stats_doc,
+             ".. staticmethod:: image_cache_stats()\n"
+             "\n"
+             "   Get statistics of the users of the image and movie caches, which share the\n"
+             "   memory cache limit from the preferences.\n"
+             "\n"
+             "   :return: Dictionary of cache user names to dictionaries with the ``priority``,\n"
+             "      ``hits``, ``misses``, ``evictions`` and ``memory`` (in bytes) of the user.\n"
+             "   :rtype: dict\n");
+static PyObject *bpy_app_image_cache_stats(PyObject *UNUSED(self))
+{
+  int stats_len;
+  MovieCacheUserStats *stats = IMB_moviecache_get_user_stats(&stats_len);
+
+  PyObject *ret = PyDict_New();
+  for (int i = 0; i < stats_len; i++) {
+    PyObject *item = Py_BuildValue("{s:i,s:K,s:K,s:K,s:n}",
+                                   "priority",
+                                   stats[i].priority,
+                                   "hits",
+                                   (unsigned long long)stats[i].hits,
+                                   "misses",
+                                   (unsigned long long)stats[i].misses,
+                                   "evictions",
+                                   (unsigned long long)stats[i].evictions,
+                                   "memory",
+                                   (Py_ssize_t)stats[i].memory);
+    PyDict_SetItemString(ret, stats[i].name, item);
+    Py_DECREF(item);
+  }
+  MEM_freeN(stats);
+
+  return ret;
+}
+
+PyDoc_STRVAR(bpy_app_image_cache_priority_set_doc,
+             ".. staticmethod:: image_cache_priority_set(name, priority)\n"
+             "\n"
+             "   Set the priority of a user of the image and movie caches. When over the memory\n"
+             "   cache limit, the cached images of the users with the lowest priority are freed\n"
+             "   first.\n"
+             "\n"
+             "   :arg name: Name of the cache user, as in :func:`image_cache_stats`.\n"
+             "   :type name: str\n"
+             "   :arg priority: Priority between -16 and 16, zero by default.\n"
+             "   :type priority: int\n");
+static PyObject *bpy_app_image_cache_priority_set(PyObject *UNUSED(self),
+                                                  PyObject *args,
+                                                  PyObject *kwds)
+{
+  const char *name;
+  int priority;
+  static const char *_keywords[] = {"name", "priority", NULL};
+  static _PyArg_Parser _parser = {
+      "s" /* `name` */
+      "i" /* `priority` */
+      ":image_cache_priority_set",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &name, &priority)) {
+    return NULL;
+  }
+  IMB_moviecache_set_user_priority(name, priority);
+  Py_RETURN_NONE;
+}
+
 static struct PyMethodDef bpy_app_methods[] = {
     {"is_job_running",
      (PyCFunction)bpy_app_is_job_running,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_is_job_running_doc},
+    {"heap_profile_start",
+     (PyCFunction)bpy_app_heap_profile_start,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_heap_profile_start_doc},
+    {"heap_profile_stop",
+     (PyCFunction)bpy_app_heap_profile_stop,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_heap_profile_stop_doc},
+    {"heap_profile_write",
+     (PyCFunction)bpy_app_heap_profile_write,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_heap_profile_write_doc},
+    {"trace_start",
+     (PyCFunction)bpy_app_trace_start,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_trace_start_doc},
+    {"trace_stop",
+     (PyCFunction)bpy_app_trace_stop,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_trace_stop_doc},
+    {"image_cache_stats",
+     (PyCFunction)bpy_app_image_cache_stats,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_image_cache_stats_doc},
+    {"image_cache_priority_set",
+     (PyCFunction)bpy_app_image_cache_priority_set,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_image_cache_priority_set_doc},
     {NULL, NULL, 0, NULL},
 };
 
@@ -262,7 +262,10 @@ static PyObject *bpy_lib_enter(BPy_Library *self)
   memset(bf_reports, 0, sizeof(*bf_reports));
   bf_reports->reports = reports;
 
+  /* Other Python threads can run while the file is read. */
+  Py_BEGIN_ALLOW_THREADS;
   self->blo_handle = BLO_blendhandle_from_file(self->abspath, bf_reports);
+  Py_END_ALLOW_THREADS;
 
   if (self->blo_handle == NULL) {
     if (BPy_reports_to_error(reports, PyExc_IOError, true) != -1) {
@@ -170,8 +170,11 @@ static PyObject *bpy_lib_write(BPy_PropertyRNA *self, PyObject *args, PyObject *
   ReportList reports;
 
   BKE_reports_init(&reports, RPT_STORE);
+  /* Other Python threads can run while the file is written. */
+  Py_BEGIN_ALLOW_THREADS;
   retval = BKE_blendfile_write_partial(
       bmain_src, filepath_abs, write_flags, path_remap.value_found, &reports);
+  Py_END_ALLOW_THREADS;
 
   /* cleanup state */
   BKE_blendfile_write_partial_end(bmain_src);
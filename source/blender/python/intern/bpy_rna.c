@@ -5284,6 +5284,35 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Raw type of buffers which don't match the attribute type but can be converted by RNA,
+ * avoiding the conversion of every item through the Python sequence.
+ */
+static bool foreach_buffer_raw_type(const Py_buffer *buf, int tot, RawPropertyType *r_raw_type)
+{
+  const char f = buf->format ? *buf->format : 'B';
+  switch (f) {
+    case 'h':
+      *r_raw_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+      *r_raw_type = PROP_RAW_INT;
+      break;
+    case '?':
+      *r_raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      *r_raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      *r_raw_type = PROP_RAW_DOUBLE;
+      break;
+    default:
+      return false;
+  }
+  return buf->len == (Py_ssize_t)tot * RNA_raw_type_sizeof(*r_raw_type);
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5296,7 +5325,7 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
   PyObject *seq;
   int tot, size, attr_tot;
   bool attr_signed;
-  RawPropertyType raw_type;
+  RawPropertyType raw_type, buf_raw_type;
 
   if (foreach_parse_args(
           self, args, &attr, &seq, &tot, &size, &raw_type, &attr_tot, &attr_signed) == -1) {
@@ -5321,6 +5350,11 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else if (foreach_buffer_raw_type(&buf, tot, &buf_raw_type)) {
+        buffer_is_compat = true;
+        ok = RNA_property_collection_raw_set(
+            NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5377,6 +5411,11 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else if (foreach_buffer_raw_type(&buf, tot, &buf_raw_type)) {
+        buffer_is_compat = true;
+        ok = RNA_property_collection_raw_get(
+            NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+      }
 
       PyBuffer_Release(&buf);
     }
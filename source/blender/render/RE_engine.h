@@ -269,9 +269,12 @@ bool RE_engine_is_opengl(RenderEngineType *render_type);
 
 /**
  * Return true if the RenderEngineType has native support for direct loading of Alembic data. For
- * Cycles, this also checks that the experimental feature set is enabled.
+ * Cycles, this also checks that the experimental feature set is enabled, unless this is for a
+ * final render.
  */
-bool RE_engine_supports_alembic_procedural(const RenderEngineType *render_type, Scene *scene);
+bool RE_engine_supports_alembic_procedural(const RenderEngineType *render_type,
+                                           Scene *scene,
+                                           bool is_final_render);
 
 RenderEngineType *RE_engines_find(const char *idname);
 
@@ -11,6 +11,7 @@
 #include "DNA_listBase.h"
 #include "DNA_vec_types.h"
 
+struct DRWData;
 struct ImBuf;
 struct Image;
 struct ImageFormatData;
@@ -409,6 +410,10 @@ void RE_gl_context_create(Render *re);
 void RE_gl_context_destroy(Render *re);
 void *RE_gl_context_get(Render *re);
 void *RE_gpu_context_get(Render *re);
+/**
+ * Draw manager data owned by the render, freed with #DRW_render_data_free when the render ends.
+ */
+struct DRWData **RE_draw_data_get(Render *re);
 
 /**
  * \param x: ranges from -1 to 1.
@@ -0,0 +1,319 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup render
+ *
+ * Execution of the compositor node tree of final renders on the GPU, using the realtime
+ * compositor. Node trees that the realtime compositor can't evaluate yet are left to the CPU
+ * compositor, see #render_compositor_execute_gpu.
+ */
+
+#include <cstring>
+#include <string>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_map.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "BLT_translation.h"
+
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BKE_global.h"
+#include "BKE_image.h"
+#include "BKE_node.h"
+
+#include "DRW_engine.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_context.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_context.hh"
+#include "COM_evaluator.hh"
+#include "COM_scheduler.hh"
+#include "COM_texture_pool.hh"
+#include "COM_utilities.hh"
+
+#include "RE_pipeline.h"
+
+#include "pipeline.h"
+#include "render_types.h"
+
+namespace blender::render {
+
+using namespace nodes::derived_node_tree_types;
+
+/* The compositor is evaluated once per view of a final render, so textures are not pooled across
+ * evaluations and are freed when the pool is destructed. */
+class TexturePool : public realtime_compositor::TexturePool {
+ private:
+  Vector<GPUTexture *> textures_;
+
+ public:
+  ~TexturePool()
+  {
+    for (GPUTexture *texture : textures_) {
+      GPU_texture_free(texture);
+    }
+  }
+
+  GPUTexture *allocate_texture(int2 size, eGPUTextureFormat format) override
+  {
+    GPUTexture *texture = GPU_texture_create_2d(
+        "compositor_texture_pool", size.x, size.y, 1, format, nullptr);
+    textures_.append(texture);
+    return texture;
+  }
+};
+
+class Context : public realtime_compositor::Context {
+ private:
+  Render &render_;
+  const Scene &scene_;
+  const char *view_name_;
+  int2 size_;
+  /* The texture the Composite node writes to, read back into the render result after the
+   * evaluation. */
+  GPUTexture *output_texture_ = nullptr;
+  /* The Combined pass of each view layer, uploaded the first time it is requested. */
+  Map<int, GPUTexture *> input_textures_;
+  /* Set if the evaluator failed to evaluate the node tree. */
+  mutable std::string info_message_;
+
+ public:
+  Context(realtime_compositor::TexturePool &texture_pool,
+          Render &render,
+          const Scene &scene,
+          const char *view_name,
+          const int2 size)
+      : realtime_compositor::Context(texture_pool),
+        render_(render),
+        scene_(scene),
+        view_name_(view_name),
+        size_(size)
+  {
+  }
+
+  ~Context()
+  {
+    GPU_TEXTURE_FREE_SAFE(output_texture_);
+    for (GPUTexture *texture : input_textures_.values()) {
+      GPU_texture_free(texture);
+    }
+  }
+
+  const Scene *get_scene() const override
+  {
+    return &scene_;
+  }
+
+  int2 get_output_size() override
+  {
+    return size_;
+  }
+
+  GPUTexture *get_output_texture() override
+  {
+    if (output_texture_ == nullptr) {
+      output_texture_ = GPU_texture_create_2d(
+          "compositor_output_texture", size_.x, size_.y, 1, GPU_RGBA16F, nullptr);
+      const float4 zero_color = float4(0.0f);
+      GPU_texture_clear(output_texture_, GPU_DATA_FLOAT, zero_color);
+    }
+    return output_texture_;
+  }
+
+  GPUTexture *get_input_texture(int view_layer, eScenePassType pass_type) override
+  {
+    /* Only the Combined pass is requested by the realtime compositor for now. */
+    BLI_assert(pass_type == SCE_PASS_COMBINED);
+    UNUSED_VARS_NDEBUG(pass_type);
+
+    return input_textures_.lookup_or_add_cb(view_layer,
+                                            [&]() { return create_input_texture(view_layer); });
+  }
+
+  StringRef get_view_name() override
+  {
+    return view_name_;
+  }
+
+  void set_info_message(StringRef message) const override
+  {
+    info_message_ = message;
+  }
+
+  bool has_error() const
+  {
+    return !info_message_.empty();
+  }
+
+  /* Read the output texture back and store it as the composited result of the view. */
+  void output_to_render_result()
+  {
+    GPU_memory_barrier(GPU_BARRIER_TEXTURE_UPDATE);
+    float *output_buffer = static_cast<float *>(
+        GPU_texture_read(get_output_texture(), GPU_DATA_FLOAT, 0));
+
+    RenderResult *rr = RE_AcquireResultWrite(&render_);
+    RenderView *rv = rr ? RE_RenderViewGetByName(rr, view_name_) : nullptr;
+    if (rv) {
+      MEM_SAFE_FREE(rv->rectf);
+      rv->rectf = output_buffer;
+      rr->have_combined = true;
+    }
+    else {
+      MEM_freeN(output_buffer);
+    }
+    RE_ReleaseResult(&render_);
+
+    Image *image = BKE_image_ensure_viewer(G.main, IMA_TYPE_R_RESULT, "Render Result");
+    BKE_image_partial_update_mark_full_update(image);
+    BLI_thread_lock(LOCK_DRAW_IMAGE);
+    BKE_image_signal(G.main, image, nullptr, IMA_SIGNAL_FREE);
+    BLI_thread_unlock(LOCK_DRAW_IMAGE);
+  }
+
+ private:
+  GPUTexture *create_input_texture(int view_layer_index)
+  {
+    GPUTexture *texture = GPU_texture_create_2d(
+        "compositor_input_texture", size_.x, size_.y, 1, GPU_RGBA16F, nullptr);
+
+    const ViewLayer *view_layer = static_cast<const ViewLayer *>(
+        BLI_findlink(&scene_.view_layers, view_layer_index));
+
+    const float *pass_data = nullptr;
+    RenderResult *rr = RE_AcquireResultRead(&render_);
+    if (rr && view_layer) {
+      RenderLayer *rl = RE_GetRenderLayer(rr, view_layer->name);
+      RenderPass *rpass = rl ? RE_pass_find_by_name(rl, RE_PASSNAME_COMBINED, view_name_) :
+                               nullptr;
+      if (rpass && rpass->channels == 4 && rpass->rectx == size_.x && rpass->recty == size_.y) {
+        pass_data = rpass->rect;
+      }
+    }
+
+    /* Missing passes are transparent black, like in the CPU compositor. */
+    if (pass_data) {
+      GPU_texture_update(texture, GPU_DATA_FLOAT, pass_data);
+    }
+    else {
+      const float4 zero_color = float4(0.0f);
+      GPU_texture_clear(texture, GPU_DATA_FLOAT, zero_color);
+    }
+    RE_ReleaseResult(&render_);
+
+    return texture;
+  }
+};
+
+/* Check if the realtime compositor computes the same result as the CPU compositor for the given
+ * node tree. Nodes that the realtime compositor only has placeholders for, Render Layers nodes of
+ * other scenes or using passes other than Combined, and File Output nodes all need the CPU
+ * compositor. */
+static bool is_node_tree_supported(const Render &render, bNodeTree &node_tree)
+{
+  DerivedNodeTree tree(node_tree);
+  if (tree.has_link_cycles() || tree.has_undefined_nodes_or_sockets()) {
+    return false;
+  }
+
+  bool has_file_output = false;
+  tree.foreach_node([&](DNode node) {
+    if (node->type == CMP_NODE_OUTPUT_FILE) {
+      has_file_output = true;
+    }
+  });
+  if (has_file_output) {
+    return false;
+  }
+
+  /* The output node is scheduled last. */
+  const realtime_compositor::Schedule schedule = realtime_compositor::compute_schedule(tree);
+  if (schedule.is_empty() || schedule.as_span().last()->type != CMP_NODE_COMPOSITE) {
+    return false;
+  }
+
+  for (const DNode &node : schedule) {
+    if (!realtime_compositor::is_node_supported(node)) {
+      return false;
+    }
+    if (node->type != CMP_NODE_R_LAYERS) {
+      continue;
+    }
+    const Scene *scene = reinterpret_cast<const Scene *>(node->id);
+    if (scene == nullptr || RE_GetSceneRender(scene) != &render) {
+      return false;
+    }
+    for (const bNodeSocket *output : node->output_sockets()) {
+      if (!STR_ELEM(output->identifier, "Image", "Alpha") && output->is_logically_linked()) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace blender::render
+
+using namespace blender;
+
+bool render_compositor_execute_gpu(Render *re, bNodeTree *ntree, const char *view_name)
+{
+  if (!U.experimental.use_realtime_compositor || !(ntree->flag & NTREE_COM_GPU_RENDER)) {
+    return false;
+  }
+
+  /* The CPU compositor composites the full resolution when rendering a border without cropping,
+   * keep that case to it. */
+  if ((re->r.mode & R_BORDER) && !(re->r.mode & R_CROP)) {
+    return false;
+  }
+
+  if (!GPU_backend_supported() || !render::is_node_tree_supported(*re, *ntree)) {
+    return false;
+  }
+
+  BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_READ);
+  const int2 size = re->result ? int2(re->result->rectx, re->result->recty) : int2(0);
+  BLI_rw_mutex_unlock(&re->resultmutex);
+  if (size.x <= 0 || size.y <= 0) {
+    return false;
+  }
+
+  DRW_render_context_enable(re);
+
+  bool success = false;
+  if (GPU_compute_shader_support() && GPU_shader_image_load_store_support()) {
+    render::TexturePool texture_pool;
+    render::Context context(texture_pool, *re, *re->pipeline_scene_eval, view_name, size);
+    realtime_compositor::Evaluator evaluator(context, *ntree);
+
+    ntree->stats_draw(ntree->sdh, IFACE_("Compositing"));
+    evaluator.evaluate();
+
+    if (!context.has_error() && !ntree->test_break(ntree->tbh)) {
+      context.output_to_render_result();
+      success = true;
+    }
+    /* The GPU resources of the evaluation are freed here, while the context is still active. */
+  }
+
+  DRW_render_context_disable(re);
+
+  return success;
+}
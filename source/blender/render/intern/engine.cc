@@ -120,13 +120,18 @@ bool RE_engine_is_opengl(RenderEngineType *render_type)
          DRW_engine_render_support(render_type->draw_engine);
 }
 
-bool RE_engine_supports_alembic_procedural(const RenderEngineType *render_type, Scene *scene)
+bool RE_engine_supports_alembic_procedural(const RenderEngineType *render_type,
+                                           Scene *scene,
+                                           const bool is_final_render)
 {
   if ((render_type->flag & RE_USE_ALEMBIC_PROCEDURAL) == 0) {
     return false;
   }
 
-  if (BKE_scene_uses_cycles(scene) && !BKE_scene_uses_cycles_experimental_features(scene)) {
+  /* Final renders in Cycles always support the procedural, the experimental feature set is only
+   * needed for viewport rendering. */
+  if (BKE_scene_uses_cycles(scene) && !is_final_render &&
+      !BKE_scene_uses_cycles_experimental_features(scene)) {
     return false;
   }
 
@@ -714,6 +719,14 @@ static bool engine_keep_depsgraph(RenderEngine *engine)
   return (engine->re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT);
 }
 
+static bool engine_keep_depsgraph_between_frames(RenderEngine *engine)
+{
+  /* The engine is freed after every frame, but the evaluated data of everything which is not
+   * animated can be reused for the next frame of an animation render. */
+  return (G.f & G_FLAG_RENDER_PERSISTENT_DEPSGRAPH) && (engine->re->flag & R_ANIMATION) &&
+         !engine_keep_depsgraph(engine);
+}
+
 /* Depsgraph */
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
@@ -721,6 +734,12 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
   Scene *scene = engine->re->scene;
   bool reuse_depsgraph = false;
 
+  /* Take over the depsgraph kept from the previous frame of an animation render. */
+  if (engine->depsgraph == nullptr && engine->re->animation_depsgraph != nullptr) {
+    engine->depsgraph = engine->re->animation_depsgraph;
+    engine->re->animation_depsgraph = nullptr;
+  }
+
   /* Reuse depsgraph from persistent data if possible. */
   if (engine->depsgraph) {
     if (DEG_get_bmain(engine->depsgraph) != bmain ||
@@ -776,7 +795,7 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 static void engine_depsgraph_exit(RenderEngine *engine)
 {
   if (engine->depsgraph) {
-    if (engine_keep_depsgraph(engine)) {
+    if (engine_keep_depsgraph(engine) || engine_keep_depsgraph_between_frames(engine)) {
       /* Clear recalc flags since the engine should have handled the updates for the currently
        * rendered framed by now. */
       DEG_ids_clear_recalc(engine->depsgraph, false);
@@ -1107,6 +1126,11 @@ bool RE_engine_render(Render *re, bool do_all)
 
   /* re->engine becomes zero if user changed active render engine during render */
   if (!engine_keep_depsgraph(engine) || !re->engine) {
+    if (re->engine && engine_keep_depsgraph_between_frames(engine) && !G.is_break) {
+      BLI_assert(re->animation_depsgraph == nullptr);
+      re->animation_depsgraph = engine->depsgraph;
+      engine->depsgraph = nullptr;
+    }
     engine_depsgraph_free(engine);
 
     RE_engine_free(engine);
@@ -1175,7 +1199,8 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
    *
    * TODO(sergey): Find better solution for this.
    */
-  if (engine->has_grease_pencil || engine_keep_depsgraph(engine)) {
+  if (engine->has_grease_pencil || engine_keep_depsgraph(engine) ||
+      engine_keep_depsgraph_between_frames(engine)) {
     return;
   }
   engine_depsgraph_free(engine);
@@ -67,6 +67,8 @@
 #include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_query.h"
 
+#include "DRW_engine.h"
+
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
@@ -580,6 +582,9 @@ void RE_FreeRender(Render *re)
   if (re->engine) {
     RE_engine_free(re->engine);
   }
+  if (re->animation_depsgraph) {
+    DEG_graph_free(re->animation_depsgraph);
+  }
 
   BLI_rw_mutex_end(&re->resultmutex);
   BLI_mutex_end(&re->engine_draw_mutex);
@@ -920,6 +925,11 @@ void *RE_gl_context_get(Render *re)
   return re->gl_context;
 }
 
+struct DRWData **RE_draw_data_get(Render *re)
+{
+  return &re->drw_data;
+}
+
 void *RE_gpu_context_get(Render *re)
 {
   if (re->gpu_context == nullptr) {
@@ -1205,6 +1215,9 @@ static void do_render_compositor(Render *re)
         }
 
         LISTBASE_FOREACH (RenderView *, rv, &re->result->views) {
+          if (render_compositor_execute_gpu(re, ntree, rv->name)) {
+            continue;
+          }
           ntreeCompositExecTree(
               re->pipeline_scene_eval, ntree, &re->r, true, G.background == 0, rv->name);
         }
@@ -1755,7 +1768,12 @@ static void render_pipeline_free(Render *re)
     re->pipeline_depsgraph = nullptr;
     re->pipeline_scene_eval = nullptr;
   }
-  /* Destroy the opengl context in the correct thread. */
+  if (re->animation_depsgraph != nullptr) {
+    DEG_graph_free(re->animation_depsgraph);
+    re->animation_depsgraph = nullptr;
+  }
+  /* Free draw data and destroy the opengl context in the correct thread. */
+  DRW_render_data_free(re);
   RE_gl_context_destroy(re);
 
   /* In the case the engine did not mark tiles as finished (un-highlight, which could happen in the
@@ -8,6 +8,7 @@
 #pragma once
 
 struct ListBase;
+struct bNodeTree;
 struct Render;
 struct RenderData;
 struct RenderLayer;
@@ -27,6 +28,17 @@ void render_update_anim_renderdata(struct Render *re,
                                    struct ListBase *render_layers);
 void render_copy_renderdata(struct RenderData *to, struct RenderData *from);
 
+/**
+ * Composite the given view of the render result on the GPU with the realtime compositor, if
+ * enabled for the node tree.
+ * \return False if the node tree was not composited, because GPU compositing is disabled or the
+ * node tree uses features the realtime compositor does not support yet. The CPU compositor
+ * should be used instead in that case.
+ */
+bool render_compositor_execute_gpu(struct Render *re,
+                                   struct bNodeTree *ntree,
+                                   const char *view_name);
+
 #ifdef __cplusplus
 }
 #endif
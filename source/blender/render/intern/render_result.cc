@@ -5,6 +5,7 @@
  * \ingroup render
  */
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
@@ -19,8 +20,10 @@
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_appdir.h"
 #include "BKE_camera.h"
@@ -726,7 +729,8 @@ RenderResult *render_result_new_from_exr(
       rpass->rectx = rectx;
       rpass->recty = recty;
 
-      if (rpass->channels >= 3) {
+      /* Passes without pixels are loaded later, see #IMB_exr_begin_read_layers. */
+      if (rpass->rect && rpass->channels >= 3) {
         IMB_colormanagement_transform(rpass->rect,
                                       rpass->rectx,
                                       rpass->recty,
@@ -772,30 +776,37 @@ void render_result_views_new(RenderResult *rr, const RenderData *rd)
 /*********************************** Merge ***********************************/
 
 static void do_merge_tile(
-    RenderResult *rr, RenderResult *rrpart, float *target, float *tile, int pixsize)
+    RenderResult *rr, RenderResult *rrpart, float *target, const float *tile, int pixsize)
 {
-  int y, tilex, tiley;
-  size_t ofs, copylen;
+  const int tilex = rrpart->rectx;
+  const int tiley = rrpart->recty;
 
-  copylen = tilex = rrpart->rectx;
-  tiley = rrpart->recty;
-
-  ofs = (size_t(rrpart->tilerect.ymin) * rr->rectx + rrpart->tilerect.xmin);
+  const size_t ofs = size_t(rrpart->tilerect.ymin) * rr->rectx + rrpart->tilerect.xmin;
   target += pixsize * ofs;
 
-  copylen *= sizeof(float) * pixsize;
-  tilex *= pixsize;
-  ofs = pixsize * rr->rectx;
+  const size_t copylen = sizeof(float) * pixsize * tilex;
+  const size_t target_stride = size_t(pixsize) * rr->rectx;
+  const size_t tile_stride = size_t(pixsize) * tilex;
 
-  for (y = 0; y < tiley; y++) {
-    memcpy(target, tile, copylen);
-    target += ofs;
-    tile += tilex;
-  }
+  /* Each row is a contiguous copy, copy about 256 KB per task. */
+  const int64_t rows_per_task = std::max<int64_t>(1, 256 * 1024 / std::max<size_t>(1, copylen));
+  blender::threading::parallel_for(
+      blender::IndexRange(tiley), rows_per_task, [&](const blender::IndexRange rows) {
+        for (const int64_t y : rows) {
+          memcpy(target + y * target_stride, tile + y * tile_stride, copylen);
+        }
+      });
 }
 
 void render_result_merge(RenderResult *rr, RenderResult *rrpart)
 {
+  struct MergePass {
+    float *target;
+    const float *tile;
+    int channels;
+  };
+  blender::Vector<MergePass> merge_passes;
+
   LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
     RenderLayer *rlp = RE_GetRenderLayer(rrpart, rl->name);
 
@@ -814,13 +825,21 @@ void render_result_merge(RenderResult *rr, RenderResult *rrpart)
           continue;
         }
 
-        do_merge_tile(rr, rrpart, rpass->rect, rpassp->rect, rpass->channels);
+        merge_passes.append({rpass->rect, rpassp->rect, rpass->channels});
 
         /* manually get next render pass */
         rpassp = rpassp->next;
       }
     }
   }
+
+  /* Passes don't overlap, so they are merged in parallel too. */
+  blender::threading::parallel_for(
+      merge_passes.index_range(), 1, [&](const blender::IndexRange range) {
+        for (const MergePass &merge_pass : merge_passes.as_span().slice(range)) {
+          do_merge_tile(rr, rrpart, merge_pass.target, merge_pass.tile, merge_pass.channels);
+        }
+      });
 }
 
 /**************************** Single Layer Rendering *************************/
@@ -91,6 +91,11 @@ struct Render {
   struct Depsgraph *pipeline_depsgraph;
   Scene *pipeline_scene_eval;
 
+  /* Dependency graph of the render engine, kept between frames of an animation render when the
+   * engine itself is not kept (see #G_FLAG_RENDER_PERSISTENT_DEPSGRAPH). Only data which
+   * depends on time is then re-evaluated for the next frame. */
+  struct Depsgraph *animation_depsgraph;
+
   /* callbacks */
   void (*display_init)(void *handle, RenderResult *rr);
   void *dih;
@@ -121,6 +126,8 @@ struct Render {
   /* TODO: replace by a whole draw manager. */
   void *gl_context;
   void *gpu_context;
+  /* Draw manager data kept across the frames of a render, see #DRW_render_to_image. */
+  struct DRWData *drw_data;
 };
 
 /* **************** defines ********************* */
@@ -9,6 +9,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_DerivedMesh.h"
@@ -160,22 +161,37 @@ class TextureMarginMap {
       return a1.distance > a2.distance;
     };
 
-    Vector<DijkstraActivePixel> active_pixels;
-    for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        if (DijkstraPixelIsUnset(get_pixel(x, y))) {
-          for (int i = 0; i < 8; i++) {
-            int xx = x - directions[i][0];
-            int yy = y - directions[i][1];
-
-            if (xx >= 0 && xx < w_ && yy >= 0 && yy < w_ && !IsDijkstraPixel(get_pixel(xx, yy))) {
-              set_pixel(x, y, PackDijkstraPixel(distances[i], i));
-              active_pixels.append(DijkstraActivePixel(distances[i], x, y));
-              break;
+    /* Find the pixels next to polygons in parallel. Setting them doesn't change which pixels are
+     * polygon pixels, so they are set afterwards in the same order as a serial scan. */
+    struct SeedPixel {
+      int x, y, direction;
+    };
+    Array<Vector<SeedPixel>> row_seed_pixels(h_);
+    threading::parallel_for(IndexRange(h_), 16, [&](const IndexRange rows) {
+      for (const int y : rows) {
+        for (int x = 0; x < w_; x++) {
+          if (DijkstraPixelIsUnset(get_pixel(x, y))) {
+            for (int i = 0; i < 8; i++) {
+              int xx = x - directions[i][0];
+              int yy = y - directions[i][1];
+
+              if (xx >= 0 && xx < w_ && yy >= 0 && yy < w_ &&
+                  !IsDijkstraPixel(get_pixel(xx, yy))) {
+                row_seed_pixels[y].append({x, y, i});
+                break;
+              }
             }
           }
         }
       }
+    });
+
+    Vector<DijkstraActivePixel> active_pixels;
+    for (const Vector<SeedPixel> &seed_pixels : row_seed_pixels) {
+      for (const SeedPixel &p : seed_pixels) {
+        set_pixel(p.x, p.y, PackDijkstraPixel(distances[p.direction], p.direction));
+        active_pixels.append(DijkstraActivePixel(distances[p.direction], p.x, p.y));
+      }
     }
 
     /* Not strictly needed because at this point it already is a heap. */
@@ -214,72 +230,118 @@ class TextureMarginMap {
    */
   void lookup_pixels(ImBuf *ibuf, char *mask, int maxPolygonSteps)
   {
-    for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        uint32_t dp = get_pixel(x, y);
-        if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
-          int dist = DijkstraPixelGetDistance(dp);
-          int direction = DijkstraPixelGetDirection(dp);
-
-          int xx = x;
-          int yy = y;
-
-          /* Follow the dijkstra directions to find the polygon this margin pixels belongs to. */
-          while (dist > 0) {
-            xx -= directions[direction][0];
-            yy -= directions[direction][1];
-            dp = get_pixel(xx, yy);
-            dist -= distances[direction];
-            BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
-            direction = DijkstraPixelGetDirection(dp);
+    /* Finding where to sample margin pixels from only reads the map, so it's done in parallel for
+     * blocks of rows. The interpolation can read margin pixels written before, so it's done in
+     * the same order as a serial scan to give the same result. */
+    const int block_rows = 128;
+    Array<float2> dest_positions(size_t(block_rows) * w_);
+    Array<PixelLookup> lookups(size_t(block_rows) * w_);
+
+    for (int block_start = 0; block_start < h_; block_start += block_rows) {
+      const IndexRange block(block_start, std::min(block_rows, h_ - block_start));
+
+      threading::parallel_for(block, 4, [&](const IndexRange rows) {
+        for (const int y : rows) {
+          for (int x = 0; x < w_; x++) {
+            const int64_t i = int64_t(y - block_start) * w_ + x;
+            lookups[i] = lookup_pixel_source(x, y, maxPolygonSteps, dest_positions[i]);
+          }
+        }
+      });
+
+      for (const int y : block) {
+        for (int x = 0; x < w_; x++) {
+          const int64_t i = int64_t(y - block_start) * w_ + x;
+          switch (lookups[i]) {
+            case PixelLookup::Interpolate:
+              bilinear_interpolation(ibuf, ibuf, dest_positions[i].x, dest_positions[i].y, x, y);
+              /* Add our new pixels to the assigned pixel map. */
+              mask[y * w_ + x] = 1;
+              break;
+            case PixelLookup::Keep:
+              /* These are not margin pixels, make sure the extend filter which is run after this
+               * step leaves them alone.
+               */
+              mask[y * w_ + x] = 1;
+              break;
+            case PixelLookup::NotFound:
+              break;
           }
+        }
+      }
+    }
+  }
+
+ private:
+  enum class PixelLookup : char {
+    /** Margin pixel without a pixel to sample in an adjacent polygon. */
+    NotFound,
+    /** Margin pixel sampled from the found position. */
+    Interpolate,
+    /** Polygon or empty pixel, which isn't changed. */
+    Keep,
+  };
 
-          uint32_t poly = get_pixel(xx, yy);
+  /**
+   * Follow the dijkstra directions back to the polygon of a margin pixel, then look up the pixel
+   * from the next polygon.
+   */
+  PixelLookup lookup_pixel_source(const int x,
+                                  const int y,
+                                  const int maxPolygonSteps,
+                                  float2 &r_dest) const
+  {
+    uint32_t dp = get_pixel(x, y);
+    if (!IsDijkstraPixel(dp) || DijkstraPixelIsUnset(dp)) {
+      return PixelLookup::Keep;
+    }
 
-          BLI_assert(!IsDijkstraPixel(poly));
+    int dist = DijkstraPixelGetDistance(dp);
+    int direction = DijkstraPixelGetDirection(dp);
 
-          float destX, destY;
+    int xx = x;
+    int yy = y;
 
-          int other_poly;
-          bool found_pixel_in_polygon = false;
-          if (lookup_pixel_polygon_neighbourhood(x, y, &poly, &destX, &destY, &other_poly)) {
+    /* Follow the dijkstra directions to find the polygon this margin pixels belongs to. */
+    while (dist > 0) {
+      xx -= directions[direction][0];
+      yy -= directions[direction][1];
+      dp = get_pixel(xx, yy);
+      dist -= distances[direction];
+      BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
+      direction = DijkstraPixelGetDirection(dp);
+    }
 
-            for (int i = 0; i < maxPolygonSteps; i++) {
-              /* Force to pixel grid. */
-              int nx = int(round(destX));
-              int ny = int(round(destY));
-              uint32_t polygon_from_map = get_pixel(nx, ny);
-              if (other_poly == polygon_from_map) {
-                found_pixel_in_polygon = true;
-                break;
-              }
+    uint32_t poly = get_pixel(xx, yy);
 
-              float dist_to_edge;
-              /* Look up again, but starting from the polygon we were expected to land in. */
-              if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
-                found_pixel_in_polygon = false;
-                break;
-              }
-            }
+    BLI_assert(!IsDijkstraPixel(poly));
 
-            if (found_pixel_in_polygon) {
-              bilinear_interpolation(ibuf, ibuf, destX, destY, x, y);
-              /* Add our new pixels to the assigned pixel map. */
-              mask[y * w_ + x] = 1;
-            }
-          }
-        }
-        else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
-          /* These are not margin pixels, make sure the extend filter which is run after this step
-           * leaves them alone.
-           */
-          mask[y * w_ + x] = 1;
-        }
+    float destX, destY;
+
+    int other_poly;
+    if (!lookup_pixel_polygon_neighbourhood(x, y, &poly, &destX, &destY, &other_poly)) {
+      return PixelLookup::NotFound;
+    }
+
+    for (int i = 0; i < maxPolygonSteps; i++) {
+      /* Force to pixel grid. */
+      int nx = int(round(destX));
+      int ny = int(round(destY));
+      uint32_t polygon_from_map = get_pixel(nx, ny);
+      if (other_poly == polygon_from_map) {
+        r_dest = float2(destX, destY);
+        return PixelLookup::Interpolate;
+      }
+
+      float dist_to_edge;
+      /* Look up again, but starting from the polygon we were expected to land in. */
+      if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
+        return PixelLookup::NotFound;
       }
     }
+    return PixelLookup::NotFound;
   }
 
- private:
   float2 uv_to_xy(MLoopUV const &mloopuv) const
   {
     float2 ret;
@@ -318,8 +380,12 @@ class TextureMarginMap {
    * polygon we need can be the one next to the one the Dijkstra map provides. To prevent missing
    * pixels also check the neighboring polygons.
    */
-  bool lookup_pixel_polygon_neighbourhood(
-      float x, float y, uint32_t *r_start_poly, float *r_destx, float *r_desty, int *r_other_poly)
+  bool lookup_pixel_polygon_neighbourhood(float x,
+                                          float y,
+                                          uint32_t *r_start_poly,
+                                          float *r_destx,
+                                          float *r_desty,
+                                          int *r_other_poly) const
   {
     float found_dist;
     if (lookup_pixel(x, y, *r_start_poly, r_destx, r_desty, r_other_poly, &found_dist)) {
@@ -372,7 +438,7 @@ class TextureMarginMap {
                     float *r_destx,
                     float *r_desty,
                     int *r_other_poly,
-                    float *r_dist_to_edge)
+                    float *r_dist_to_edge) const
   {
     float2 point(x, y);
 
@@ -26,7 +26,9 @@
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
 #include "BLI_threads.h"
 
@@ -52,7 +54,8 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * Zlib compression with user definable level can be used to compress image data(per image)
+ * Zstd compression with user definable level can be used to compress image data(per image)
+ * Uncompressed image data starts at page aligned offsets and is read with memory-mapped IO.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -66,6 +69,7 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 2
+#define DCACHE_UNCOMPRESSED_ALIGNMENT 4096
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
 
 typedef struct DiskCacheHeaderEntry {
@@ -115,6 +119,9 @@ static int seq_disk_cache_compression_level(void)
   switch (U.sequencer_disk_cache_compression) {
     case USER_SEQ_DISK_CACHE_COMPRESSION_NONE:
       return 0;
+    case USER_SEQ_DISK_CACHE_COMPRESSION_FASTEST:
+      /* Zstd fast mode. */
+      return -5;
     case USER_SEQ_DISK_CACHE_COMPRESSION_LOW:
       return 1;
     case USER_SEQ_DISK_CACHE_COMPRESSION_HIGH:
@@ -428,7 +435,7 @@ static size_t deflate_imbuf_to_file(ImBuf *ibuf,
   void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
 
   /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
+  if (level != 0) {
     return BLI_file_zstd_from_mem_at_pos(
         data, header_entry->size_raw, file, header_entry->offset, level);
   }
@@ -451,6 +458,15 @@ static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntr
     return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
   }
 
+  /* Map the file instead of going through buffered reads, the pages are copied as they fault. */
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  if (mmap_file != NULL) {
+    const bool success = BLI_mmap_read(
+        mmap_file, data, header_entry->offset, header_entry->size_raw);
+    BLI_mmap_free(mmap_file);
+    return success ? header_entry->size_raw : 0;
+  }
+
   fseek(file, header_entry->offset, SEEK_SET);
   return fread(data, 1, header_entry->size_raw, file);
 }
@@ -483,7 +499,10 @@ static size_t seq_disk_cache_write_header(FILE *file, DiskCacheHeader *header)
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(SeqCacheKey *key,
+                                           ImBuf *ibuf,
+                                           DiskCacheHeader *header,
+                                           const bool is_compressed)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -507,6 +526,9 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   if (i > 0) {
     offset = header->entry[i - 1].offset + header->entry[i - 1].size_compressed;
   }
+  if (!is_compressed) {
+    offset = ceil_to_multiple_ul(offset, DCACHE_UNCOMPRESSED_ALIGNMENT);
+  }
 
   if (ENDIAN_ORDER == B_ENDIAN) {
     header->entry[i].encoding = 255;
@@ -575,10 +597,12 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  const int compression_level = seq_disk_cache_compression_level();
+  int entry_index = seq_disk_cache_add_header_entry(
+      key, ibuf, &header, compression_level != 0);
 
   size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
+      ibuf, file, compression_level, &header.entry[entry_index]);
 
   if (bytes_written != 0) {
     /* Last step is writing header, as image data can be overwritten,
@@ -281,12 +281,17 @@ static void seq_cache_relink_keys(SeqCacheKey *link_next, SeqCacheKey *link_prev
   }
 }
 
-/* Choose a key out of 2 candidates(leftmost and rightmost items)
- * to recycle based on currently used strategy */
-static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCacheKey *rkey)
+/* How much keeping the frame of a base key is worth, based on the currently used strategy. Frames
+ * far from the current frame and cheap to render again are recycled first. */
+static float seq_cache_key_keep_score(Scene *scene, SeqCacheKey *key)
 {
-  SeqCacheKey *finalkey = NULL;
+  const float distance = fabsf(key->timeline_frame - scene->r.cfra);
+  return (1.0f + key->cost) / (1.0f + distance);
+}
 
+/* Choose a base key to recycle based on currently used strategy. */
+static bool seq_cache_key_is_recyclable(Scene *scene, SeqCacheKey *key)
+{
   /* Ideally, cache would not need to check the state of prefetching task
    * that is tricky to do however, because prefetch would need to know,
    * if a key, that is about to be created would be removed by itself.
@@ -301,47 +306,10 @@ static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCac
     int pfjob_start, pfjob_end;
     seq_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
 
-    if (lkey) {
-      if (lkey->timeline_frame < pfjob_start || lkey->timeline_frame > pfjob_end) {
-        return lkey;
-      }
-    }
-
-    if (rkey) {
-      if (rkey->timeline_frame < pfjob_start || rkey->timeline_frame > pfjob_end) {
-        return rkey;
-      }
-    }
-
-    return NULL;
+    return key->timeline_frame < pfjob_start || key->timeline_frame > pfjob_end;
   }
 
-  if (rkey && lkey) {
-    if (lkey->timeline_frame > rkey->timeline_frame) {
-      SeqCacheKey *swapkey = lkey;
-      lkey = rkey;
-      rkey = swapkey;
-    }
-
-    int l_diff = scene->r.cfra - lkey->timeline_frame;
-    int r_diff = rkey->timeline_frame - scene->r.cfra;
-
-    if (l_diff > r_diff) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  else {
-    if (lkey) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  return finalkey;
+  return true;
 }
 
 static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
@@ -391,15 +359,11 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *finalkey = NULL;
-  /* Leftmost key. */
-  SeqCacheKey *lkey = NULL;
-  /* Rightmost key. */
-  SeqCacheKey *rkey = NULL;
+  float finalkey_score = FLT_MAX;
   SeqCacheKey *key = NULL;
 
   GHashIterator gh_iter;
   BLI_ghashIterator_init(&gh_iter, cache->hash);
-  int total_count = 0;
 
   while (!BLI_ghashIterator_done(&gh_iter)) {
     key = BLI_ghashIterator_getKey(&gh_iter);
@@ -411,6 +375,8 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       seq_cache_recycle_linked(scene, key);
       /* Can not continue iterating after linked remove. */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
+      finalkey = NULL;
+      finalkey_score = FLT_MAX;
       continue;
     }
 
@@ -418,28 +384,17 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
-    total_count++;
-
-    if (lkey) {
-      if (key->timeline_frame < lkey->timeline_frame) {
-        lkey = key;
-      }
-    }
-    else {
-      lkey = key;
-    }
-    if (rkey) {
-      if (key->timeline_frame > rkey->timeline_frame) {
-        rkey = key;
-      }
+    if (!seq_cache_key_is_recyclable(scene, key)) {
+      continue;
     }
-    else {
-      rkey = key;
+
+    const float score = seq_cache_key_keep_score(scene, key);
+    if (score < finalkey_score) {
+      finalkey = key;
+      finalkey_score = score;
     }
   }
 
-  finalkey = seq_cache_choose_key(scene, lkey, rkey);
-
   return finalkey;
 }
 
@@ -529,6 +484,7 @@ static void seq_cache_populate_key(SeqCacheKey *key,
   key->link_next = NULL;
   key->is_temp_cache = true;
   key->task_id = context->task_id;
+  key->cost = 0.0f;
 }
 
 static SeqCacheKey *seq_cache_allocate_key(SeqCache *cache,
@@ -811,6 +767,35 @@ bool seq_cache_put_if_possible(
   return false;
 }
 
+void seq_cache_set_cost(
+    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, float cost)
+{
+  Scene *scene = context->scene;
+
+  if (context->is_prefetch_render) {
+    context = seq_prefetch_get_original_context(context);
+    scene = context->scene;
+    seq = seq_prefetch_get_original_sequence(seq, scene);
+  }
+
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!seq || !cache) {
+    return;
+  }
+
+  SeqCacheKey key;
+  seq_cache_populate_key(&key, context, seq, timeline_frame, type);
+
+  seq_cache_lock(scene);
+  if (BLI_ghash_haskey(cache->hash, &key)) {
+    void **cached_key, **item;
+    if (BLI_ghash_ensure_p_ex(cache->hash, &key, &cached_key, &item)) {
+      ((SeqCacheKey *)*cached_key)->cost = cost;
+    }
+  }
+  seq_cache_unlock(scene);
+}
+
 void seq_cache_thumbnail_put(
     const SeqRenderData *context, Sequence *seq, float timeline_frame, ImBuf *i, rctf *view_area)
 {
@@ -849,6 +834,11 @@ void seq_cache_put(
     return;
   }
 
+  /* Images rendered after stopping may depend on parts of the frame that were left unfinished. */
+  if (seq_prefetch_is_stop_requested(context)) {
+    return;
+  }
+
   Scene *scene = context->scene;
 
   if (context->is_prefetch_render) {
@@ -54,6 +54,15 @@ bool seq_cache_put_if_possible(const struct SeqRenderData *context,
                                float timeline_frame,
                                int type,
                                struct ImBuf *nval);
+/**
+ * Set the cost of a cached image, its render time in seconds divided by the frame duration.
+ * Frames with the lowest cost for their distance to the current frame are recycled first.
+ */
+void seq_cache_set_cost(const struct SeqRenderData *context,
+                        struct Sequence *seq,
+                        float timeline_frame,
+                        int type,
+                        float cost);
 /**
  * Find only "base" keys.
  * Sources(other types) for a frame must be freed all at once.
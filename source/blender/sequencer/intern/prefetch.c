@@ -59,6 +59,8 @@ typedef struct PrefetchJob {
 
   ThreadMutex prefetch_suspend_mutex;
   ThreadCondition prefetch_suspend_cond;
+  /* Notified when the prefetch thread has finished, protected by `prefetch_suspend_mutex`. */
+  ThreadCondition prefetch_finished_cond;
 
   ListBase threads;
 
@@ -160,6 +162,16 @@ SeqRenderData *seq_prefetch_get_original_context(const SeqRenderData *context)
   return &pfjob->context;
 }
 
+bool seq_prefetch_is_stop_requested(const SeqRenderData *context)
+{
+  if (!context->is_prefetch_render) {
+    return false;
+  }
+
+  PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
+  return pfjob != NULL && pfjob->stop;
+}
+
 static bool seq_prefetch_is_cache_full(Scene *scene)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
@@ -260,11 +272,15 @@ void SEQ_prefetch_stop(Scene *scene)
     return;
   }
 
+  /* Wake up the suspended thread, or make the running one leave the frame being rendered, then
+   * wait for it to finish. */
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
   pfjob->stop = true;
-
+  BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_wait(&pfjob->prefetch_finished_cond, &pfjob->prefetch_suspend_mutex);
   }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 }
 
 static void seq_prefetch_update_context(const SeqRenderData *context)
@@ -349,6 +365,7 @@ void seq_prefetch_free(Scene *scene)
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
+  BLI_condition_end(&pfjob->prefetch_finished_cond);
   seq_prefetch_free_depsgraph(pfjob);
   BKE_main_free(pfjob->bmain_eval);
   MEM_freeN(pfjob);
@@ -469,7 +486,7 @@ static void *seq_prefetch_frames(void *job)
 {
   PrefetchJob *pfjob = (PrefetchJob *)job;
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
+  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra && !pfjob->stop) {
     pfjob->scene_eval->ed->prefetch_job = NULL;
 
     seq_prefetch_update_depsgraph(pfjob);
@@ -515,9 +532,13 @@ static void *seq_prefetch_frames(void *job)
   }
 
   seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-  pfjob->running = false;
   pfjob->scene_eval->ed->prefetch_job = NULL;
 
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  pfjob->running = false;
+  BLI_condition_notify_all(&pfjob->prefetch_finished_cond);
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
   return NULL;
 }
 
@@ -533,6 +554,7 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
       BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
       BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
       BLI_condition_init(&pfjob->prefetch_suspend_cond);
+      BLI_condition_init(&pfjob->prefetch_finished_cond);
 
       pfjob->bmain_eval = BKE_main_new();
       pfjob->scene = context->scene;
@@ -34,6 +34,11 @@ struct SeqRenderData *seq_prefetch_get_original_context(const struct SeqRenderDa
  * For cache context swapping.
  */
 struct Sequence *seq_prefetch_get_original_sequence(struct Sequence *seq, struct Scene *scene);
+/**
+ * Check if the prefetch job rendering with this context was asked to stop, in which case the
+ * frame is left unfinished and nothing it renders is cached anymore.
+ */
+bool seq_prefetch_is_stop_requested(const struct SeqRenderData *context);
 
 #ifdef __cplusplus
 }
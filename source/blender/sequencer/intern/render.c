@@ -11,6 +11,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "PIL_time.h"
+
 #include "DNA_anim_types.h"
 #include "DNA_defaults.h"
 #include "DNA_mask_types.h"
@@ -22,6 +24,7 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1819,6 +1822,157 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Image and movie strips only read their own files, so they can be rendered at the same time as
+ * other strips. Modifiers masks render other strips, which may be rendered concurrently. */
+static bool seq_render_strip_is_thread_safe(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct SeqPrerenderData {
+  const SeqRenderData *context;
+  Sequence **seq_arr;
+  const int *indices;
+  ImBuf **r_ibufs;
+  float timeline_frame;
+} SeqPrerenderData;
+
+static void seq_render_strip_stack_prerender_fn(void *__restrict userdata,
+                                                const int iter,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SeqPrerenderData *data = userdata;
+  const int i = data->indices[iter];
+  SeqRenderState state;
+  seq_render_state_init(&state);
+  data->r_ibufs[i] = seq_render_strip(
+      data->context, &state, data->seq_arr[i], data->timeline_frame);
+}
+
+static void seq_render_strips_parallel(const SeqRenderData *context,
+                                       Sequence **seq_arr,
+                                       const int *indices,
+                                       const int indices_len,
+                                       float timeline_frame,
+                                       ImBuf **r_ibufs)
+{
+  int thread_safe_indices[MAXSEQ + 1];
+  int thread_safe_len = 0;
+  for (int i = 0; i < indices_len; i++) {
+    if (seq_render_strip_is_thread_safe(seq_arr[indices[i]])) {
+      thread_safe_indices[thread_safe_len++] = indices[i];
+    }
+  }
+  /* Single strips are rendered when compositing the stack. */
+  if (thread_safe_len < 2) {
+    return;
+  }
+
+  SeqPrerenderData data = {
+      .context = context,
+      .seq_arr = seq_arr,
+      .indices = thread_safe_indices,
+      .r_ibufs = r_ibufs,
+      .timeline_frame = timeline_frame,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, thread_safe_len, &data, seq_render_strip_stack_prerender_fn, &settings);
+}
+
+/**
+ * Render the strips that compositing the stack needs, from the top channel down to the first
+ * strip hiding the channels below it, the same way #seq_render_strip_stack visits them. Strips
+ * that can run in threads are rendered in parallel instead of one after the other, balancing the
+ * decoding time of the stack. Their images are stored in \a r_ibufs, other strips are left NULL.
+ */
+static void seq_render_strip_stack_prerender(const SeqRenderData *context,
+                                             Sequence **seq_arr,
+                                             const int count,
+                                             float timeline_frame,
+                                             ImBuf **r_ibufs)
+{
+  int i = count - 1;
+  while (i >= 0) {
+    int batch[MAXSEQ + 1];
+    int batch_len = 0;
+    bool is_stack_end = false;
+    /* Alpha over strips hide the channels below only if they are opaque, which is known once they
+     * are rendered, so the strips are rendered in batches ending with such a strip. */
+    bool check_opaque = false;
+
+    for (; i >= 0 && !is_stack_end && !check_opaque; i--) {
+      Sequence *seq = seq_arr[i];
+
+      ImBuf *composite = seq_cache_get(context, seq, timeline_frame, SEQ_CACHE_STORE_COMPOSITE);
+      if (composite) {
+        IMB_freeImBuf(composite);
+        is_stack_end = true;
+        break;
+      }
+      if (seq->blend_mode == SEQ_BLEND_REPLACE) {
+        batch[batch_len++] = i;
+        is_stack_end = true;
+        continue;
+      }
+      if (seq->blend_mode == SEQ_TYPE_ALPHAOVER && seq->blend_opacity == 100.0f) {
+        batch[batch_len++] = i;
+        check_opaque = true;
+        continue;
+      }
+
+      switch (seq_get_early_out_for_blend_mode(seq)) {
+        case EARLY_NO_INPUT:
+        case EARLY_USE_INPUT_2:
+          batch[batch_len++] = i;
+          is_stack_end = true;
+          break;
+        case EARLY_DO_EFFECT:
+          batch[batch_len++] = i;
+          break;
+        case EARLY_USE_INPUT_1:
+          break;
+      }
+    }
+
+    seq_render_strips_parallel(context, seq_arr, batch, batch_len, timeline_frame, r_ibufs);
+
+    if (check_opaque) {
+      ImBuf *test = r_ibufs[batch[batch_len - 1]];
+      if (test == NULL || ELEM(test->planes, R_IMF_PLANES_BW, R_IMF_PLANES_RGB)) {
+        is_stack_end = true;
+      }
+    }
+    if (is_stack_end) {
+      break;
+    }
+  }
+}
+
+/* Get the pre-rendered image of the strip if any, or render it. */
+static ImBuf *seq_render_stack_strip(const SeqRenderData *context,
+                                     SeqRenderState *state,
+                                     Sequence *seq,
+                                     float timeline_frame,
+                                     ImBuf *prerendered)
+{
+  if (prerendered) {
+    IMB_refImBuf(prerendered);
+    return prerendered;
+  }
+  return seq_render_strip(context, state, seq, timeline_frame);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -1838,17 +1992,24 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return NULL;
   }
 
+  ImBuf *prerendered[MAXSEQ + 1] = {NULL};
+  seq_render_strip_stack_prerender(context, seq_arr, count, timeline_frame, prerendered);
+
   for (i = count - 1; i >= 0; i--) {
     int early_out;
     Sequence *seq = seq_arr[i];
 
+    if (seq_prefetch_is_stop_requested(context)) {
+      break;
+    }
+
     out = seq_cache_get(context, seq, timeline_frame, SEQ_CACHE_STORE_COMPOSITE);
 
     if (out) {
       break;
     }
     if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-      out = seq_render_strip(context, state, seq, timeline_frame);
+      out = seq_render_stack_strip(context, state, seq, timeline_frame, prerendered[i]);
       break;
     }
 
@@ -1857,7 +2018,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     /* Early out for alpha over. It requires image to be rendered, so it can't use
      * `seq_get_early_out_for_blend_mode`. */
     if (out == NULL && seq->blend_mode == SEQ_TYPE_ALPHAOVER && seq->blend_opacity == 100.0f) {
-      ImBuf *test = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *test = seq_render_stack_strip(context, state, seq, timeline_frame, prerendered[i]);
       if (ELEM(test->planes, R_IMF_PLANES_BW, R_IMF_PLANES_RGB)) {
         early_out = EARLY_USE_INPUT_2;
       }
@@ -1871,7 +2032,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     switch (early_out) {
       case EARLY_NO_INPUT:
       case EARLY_USE_INPUT_2:
-        out = seq_render_strip(context, state, seq, timeline_frame);
+        out = seq_render_stack_strip(context, state, seq, timeline_frame, prerendered[i]);
         break;
       case EARLY_USE_INPUT_1:
         if (i == 0) {
@@ -1881,7 +2042,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       case EARLY_DO_EFFECT:
         if (i == 0) {
           ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-          ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+          ImBuf *ibuf2 = seq_render_stack_strip(
+              context, state, seq, timeline_frame, prerendered[i]);
 
           out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -1902,9 +2064,16 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   for (; i < count; i++) {
     Sequence *seq = seq_arr[i];
 
+    /* Leave the frame unfinished when prefetching is stopped, it's not cached anyway. */
+    if (seq_prefetch_is_stop_requested(context)) {
+      IMB_freeImBuf(out);
+      out = NULL;
+      break;
+    }
+
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = seq_render_stack_strip(context, state, seq, timeline_frame, prerendered[i]);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -1915,6 +2084,12 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     seq_cache_put(context, seq_arr[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out);
   }
 
+  for (i = 0; i < count; i++) {
+    if (prerendered[i]) {
+      IMB_freeImBuf(prerendered[i]);
+    }
+  }
+
   return out;
 }
 
@@ -1958,6 +2133,7 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
 
   if (count && !out) {
     BLI_mutex_lock(&seq_render_mutex);
+    const double render_start_time = PIL_check_seconds_timer();
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
 
     if (context->is_prefetch_render) {
@@ -1967,6 +2143,13 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
       seq_cache_put_if_possible(
           context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
     }
+    /* Frames that are slow to render are kept longer when the cache is full. */
+    const float render_time = PIL_check_seconds_timer() - render_start_time;
+    seq_cache_set_cost(context,
+                       seq_arr[count - 1],
+                       timeline_frame,
+                       SEQ_CACHE_STORE_FINAL_OUT,
+                       render_time * FPS);
     BLI_mutex_unlock(&seq_render_mutex);
   }
 
@@ -16,6 +16,7 @@
 
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_cloth.h"
@@ -586,26 +587,31 @@ static void cloth_calc_force(
                 0.001f * clmd->sim_parms->effector_weights->global_gravity);
   }
 
-  vert = cloth->verts;
-  for (i = 0; i < cloth->mvert_num; i++, vert++) {
-    SIM_mass_spring_force_gravity(data, i, vert->mass, gravity);
+  /* Both forces only change the diagonal blocks of their vertex. */
+  blender::threading::parallel_for(
+      blender::IndexRange(mvert_num), 1024, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          const ClothVertex *vert = &cloth->verts[i];
+          SIM_mass_spring_force_gravity(data, i, vert->mass, gravity);
 
-    /* Vertex goal springs */
-    if ((!(vert->flags & CLOTH_VERT_FLAG_PINNED)) && (vert->goal > FLT_EPSILON)) {
-      float goal_x[3], goal_v[3];
-      float k;
+          /* Vertex goal springs */
+          if ((!(vert->flags & CLOTH_VERT_FLAG_PINNED)) && (vert->goal > FLT_EPSILON)) {
+            float goal_x[3], goal_v[3];
+            float k;
 
-      /* divide by time_scale to prevent goal vertices' delta locations from being multiplied */
-      interp_v3_v3v3(goal_x, vert->xold, vert->xconst, time / clmd->sim_parms->time_scale);
-      sub_v3_v3v3(goal_v, vert->xconst, vert->xold); /* distance covered over dt==1 */
+            /* divide by time_scale to prevent goal vertices' delta locations from being
+             * multiplied */
+            interp_v3_v3v3(goal_x, vert->xold, vert->xconst, time / clmd->sim_parms->time_scale);
+            sub_v3_v3v3(goal_v, vert->xconst, vert->xold); /* distance covered over dt==1 */
 
-      k = vert->goal * clmd->sim_parms->goalspring /
-          (clmd->sim_parms->avg_spring_len + FLT_EPSILON);
+            k = vert->goal * clmd->sim_parms->goalspring /
+                (clmd->sim_parms->avg_spring_len + FLT_EPSILON);
 
-      SIM_mass_spring_force_spring_goal(
-          data, i, goal_x, goal_v, k, clmd->sim_parms->goalfrict * 0.01f);
-    }
-  }
+            SIM_mass_spring_force_spring_goal(
+                data, i, goal_x, goal_v, k, clmd->sim_parms->goalfrict * 0.01f);
+          }
+        }
+      });
 #endif
 
   // cloth_calc_volume_force(clmd);
@@ -709,20 +715,26 @@ static void cloth_calc_force(
                                                  "effector forces");
     float(*forcevec)[3] = is_not_hair ? winvec + mvert_num : winvec;
 
-    for (i = 0; i < cloth->mvert_num; i++) {
-      float x[3], v[3];
-      EffectedPoint epoint;
-
-      SIM_mass_spring_get_motion_state(data, i, x, v);
-      pd_point_from_loc(scene, x, v, i, &epoint);
-      BKE_effectors_apply(effectors,
-                          nullptr,
-                          clmd->sim_parms->effector_weights,
-                          &epoint,
-                          forcevec[i],
-                          winvec[i],
-                          nullptr);
+    /* Effectors are also evaluated from multiple threads by particle systems. */
+    blender::threading::parallel_for(
+        blender::IndexRange(mvert_num), 256, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            float x[3], v[3];
+            EffectedPoint epoint;
+
+            SIM_mass_spring_get_motion_state(data, i, x, v);
+            pd_point_from_loc(scene, x, v, i, &epoint);
+            BKE_effectors_apply(effectors,
+                                nullptr,
+                                clmd->sim_parms->effector_weights,
+                                &epoint,
+                                forcevec[i],
+                                winvec[i],
+                                nullptr);
+          }
+        });
 
+    for (i = 0; i < cloth->mvert_num; i++) {
       has_wind = has_wind || !is_zero_v3(winvec[i]);
       has_force = has_force || !is_zero_v3(forcevec[i]);
     }
@@ -18,6 +18,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -34,6 +35,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum number of vertices to run big matrix operations on multiple threads. */
+#  define CLOTH_PARALLEL_LIMIT 1024
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -583,35 +587,123 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/* Off-diagonal blocks of a big matrix listed per vertex of their row and of their column, in block
+ * order. This allows computing products per vertex on multiple threads, while still summing the
+ * blocks in the same order as a single loop over them. */
+typedef struct BlockAdjacency {
+  uint *row_offsets; /* vertex count + 1 */
+  uint *row_blocks;  /* spring count */
+  uint *col_offsets; /* vertex count + 1 */
+  uint *col_blocks;  /* spring count */
+} BlockAdjacency;
+
+DO_INLINE void create_block_adjacency(BlockAdjacency *adjacency, uint verts, uint springs)
 {
-  uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  adjacency->row_offsets = (uint *)MEM_mallocN(sizeof(uint) * (verts + 1),
+                                               "cloth_implicit_row_offsets");
+  adjacency->row_blocks = (uint *)MEM_mallocN(sizeof(uint) * springs, "cloth_implicit_row_blocks");
+  adjacency->col_offsets = (uint *)MEM_mallocN(sizeof(uint) * (verts + 1),
+                                               "cloth_implicit_col_offsets");
+  adjacency->col_blocks = (uint *)MEM_mallocN(sizeof(uint) * springs, "cloth_implicit_col_blocks");
+}
 
-  zero_lfvector(to, vcount);
+DO_INLINE void del_block_adjacency(BlockAdjacency *adjacency)
+{
+  MEM_SAFE_FREE(adjacency->row_offsets);
+  MEM_SAFE_FREE(adjacency->row_blocks);
+  MEM_SAFE_FREE(adjacency->col_offsets);
+  MEM_SAFE_FREE(adjacency->col_blocks);
+}
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
-    }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
-    }
+/* Counting sort of the off-diagonal blocks by vertex, which keeps the block order. */
+static void update_block_adjacency(BlockAdjacency *adjacency, const fmatrix3x3 *matrix)
+{
+  const uint vcount = matrix[0].vcount;
+  const uint scount = matrix[0].scount;
+  uint *row_offsets = adjacency->row_offsets;
+  uint *col_offsets = adjacency->col_offsets;
+
+  memset(row_offsets, 0, sizeof(uint) * (vcount + 1));
+  memset(col_offsets, 0, sizeof(uint) * (vcount + 1));
+
+  for (uint i = vcount; i < vcount + scount; i++) {
+    row_offsets[matrix[i].r + 1]++;
+    col_offsets[matrix[i].c + 1]++;
+  }
+  for (uint v = 0; v < vcount; v++) {
+    row_offsets[v + 1] += row_offsets[v];
+    col_offsets[v + 1] += col_offsets[v];
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
 
-  del_lfvector(temp);
+  /* Use the start offsets as insertion cursors, they end up at the start of the next vertex. */
+  for (uint i = vcount; i < vcount + scount; i++) {
+    adjacency->row_blocks[row_offsets[matrix[i].r]++] = i;
+    adjacency->col_blocks[col_offsets[matrix[i].c]++] = i;
+  }
+  for (uint v = vcount; v > 0; v--) {
+    row_offsets[v] = row_offsets[v - 1];
+    col_offsets[v] = col_offsets[v - 1];
+  }
+  row_offsets[0] = 0;
+  col_offsets[0] = 0;
+}
+
+typedef struct MulBFMatrixData {
+  float (*to)[3];
+  const fmatrix3x3 *from;
+  const BlockAdjacency *adjacency;
+  const lfVector *fLongVector;
+} MulBFMatrixData;
+
+static void mul_bfmatrix_lfvector_cb(void *__restrict userdata,
+                                     const int v,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MulBFMatrixData *data = (const MulBFMatrixData *)userdata;
+  const fmatrix3x3 *from = data->from;
+  const BlockAdjacency *adjacency = data->adjacency;
+  const lfVector *fLongVector = data->fLongVector;
+  float lower[3] = {0.0f, 0.0f, 0.0f};
+  float upper[3] = {0.0f, 0.0f, 0.0f};
+
+  for (uint k = adjacency->col_offsets[v]; k < adjacency->col_offsets[v + 1]; k++) {
+    const fmatrix3x3 *block = &from[adjacency->col_blocks[k]];
+    /* This is the lower triangle of the sparse matrix,
+     * therefore multiplication occurs with transposed submatrices. */
+    muladd_fmatrixT_fvector(lower, block->m, fLongVector[block->r]);
+  }
+
+  /* The diagonal block comes first, like in the block order. */
+  muladd_fmatrix_fvector(upper, from[v].m, fLongVector[v]);
+  for (uint k = adjacency->row_offsets[v]; k < adjacency->row_offsets[v + 1]; k++) {
+    const fmatrix3x3 *block = &from[adjacency->row_blocks[k]];
+    muladd_fmatrix_fvector(upper, block->m, fLongVector[block->c]);
+  }
+
+  add_v3_v3v3(data->to[v], lower, upper);
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     fmatrix3x3 *from,
+                                     const BlockAdjacency *adjacency,
+                                     lfVector *fLongVector)
+{
+  const uint vcount = from[0].vcount;
+
+  MulBFMatrixData data = {
+      .to = to,
+      .from = from,
+      .adjacency = adjacency,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (vcount > CLOTH_PARALLEL_LIMIT);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, (int)vcount, &data, mul_bfmatrix_lfvector_cb, &settings);
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -653,6 +745,8 @@ typedef struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+
+  BlockAdjacency adjacency; /* off-diagonal blocks per vertex, shared by all big matrices */
 } Implicit_Data;
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
@@ -678,6 +772,8 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
 
+  create_block_adjacency(&id->adjacency, numverts, numsprings);
+
   initdiag_bfmatrix(id->bigI, I);
 
   return id;
@@ -704,6 +800,8 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->dV);
   del_lfvector(id->z);
 
+  del_block_adjacency(&id->adjacency);
+
   MEM_freeN(id);
 }
 
@@ -741,13 +839,29 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 /* ================================ */
 
+typedef struct FilterData {
+  lfVector *V;
+  const fmatrix3x3 *S;
+} FilterData;
+
+static void filter_cb(void *__restrict userdata,
+                      const int i,
+                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FilterData *data = (const FilterData *)userdata;
+  mul_m3_v3(data->S[i].m, data->V[data->S[i].r]);
+}
+
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
+  FilterData data = {.V = V, .S = S};
 
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  /* S only has diagonal blocks, each vertex is filtered independently. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (S[0].vcount > CLOTH_PARALLEL_LIMIT);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, (int)S[0].vcount, &data, filter_cb, &settings);
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -822,6 +936,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BlockAdjacency *adjacency,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -849,7 +964,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, adjacency, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -872,7 +987,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, adjacency, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1132,7 +1247,10 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All big matrices have the same off-diagonal blocks, one per spring. */
+  update_block_adjacency(&data->adjacency, data->A);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, &data->adjacency, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1141,7 +1259,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &data->adjacency, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
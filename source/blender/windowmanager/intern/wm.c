@@ -17,6 +17,7 @@
 
 #include "BLI_ghash.h"
 #include "BLI_sys_types.h"
+#include "BLI_trace.h"
 
 #include "DNA_windowmanager_types.h"
 
@@ -632,17 +633,29 @@ void WM_main(bContext *C)
   wm_event_do_refresh_wm_and_depsgraph(C);
 
   while (1) {
+    /* Time the steps of every iteration when recording a trace (see `--debug-trace`). */
+    const uint64_t trace_loop_start_time = BLI_trace_event_begin();
+    uint64_t trace_start_time = trace_loop_start_time;
 
     /* Get events from ghost, handle window events, add to window queues. */
     wm_window_process_events(C);
+    BLI_trace_event_end("Process Events", trace_start_time);
 
     /* Per window, all events to the window, screen, area and region handlers. */
+    trace_start_time = BLI_trace_event_begin();
     wm_event_do_handlers(C);
+    BLI_trace_event_end("Event Handlers", trace_start_time);
 
     /* Events have left notes about changes, we handle and cache it. */
+    trace_start_time = BLI_trace_event_begin();
     wm_event_do_notifiers(C);
+    BLI_trace_event_end("Notifiers", trace_start_time);
 
     /* Execute cached changes draw. */
+    trace_start_time = BLI_trace_event_begin();
     wm_draw_update(C);
+    BLI_trace_event_end("Draw Update", trace_start_time);
+
+    BLI_trace_event_end("Main Loop", trace_loop_start_time);
   }
 }
@@ -1933,6 +1933,49 @@ static void wm_autosave_location(char filepath[FILE_MAX])
   BLI_join_dirfile(filepath, FILE_MAX, tempdir_base, path);
 }
 
+typedef struct AutosaveJob {
+  char filepath[FILE_MAX];
+  /** Copy of the undo memfile, owned by the job. */
+  MemFile memfile;
+} AutosaveJob;
+
+static void wm_autosave_job_startjob(void *customdata,
+                                     short *UNUSED(stop),
+                                     short *UNUSED(do_update),
+                                     float *UNUSED(progress))
+{
+  AutosaveJob *job = customdata;
+  /* Compression is cheap to have here since it does not block the interface,
+   * and reduces the amount of data that has to be written. */
+  BLO_write_file_from_memfile(&job->memfile, job->filepath, true);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *job = customdata;
+  BLO_memfile_free(&job->memfile);
+  MEM_freeN(job);
+}
+
+/**
+ * Write the undo memfile from a job, so that the interface does not wait for the file
+ * to be written. The memfile is copied since undo steps may be freed while the job runs.
+ */
+static void wm_autosave_write_memfile_job(wmWindowManager *wm,
+                                          MemFile *memfile,
+                                          const char *filepath)
+{
+  AutosaveJob *job = MEM_callocN(sizeof(AutosaveJob), __func__);
+  STRNCPY(job->filepath, filepath);
+  BLO_memfile_copy(memfile, &job->memfile);
+
+  wmJob *wm_job = WM_jobs_get(wm, wm->winactive, wm, "Auto-Saving...", 0, WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, job, wm_autosave_job_free);
+  WM_jobs_timer(wm_job, 0.5, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, NULL, NULL, NULL);
+  WM_jobs_start(wm, wm_job);
+}
+
 static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -1943,7 +1986,12 @@ static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
   const bool use_memfile = (U.uiflag & USER_GLOBALUNDO) != 0;
   MemFile *memfile = use_memfile ? ED_undosys_stack_memfile_get_active(wm->undo_stack) : NULL;
   if (memfile != NULL) {
-    BLO_memfile_write_file(memfile, filepath);
+    if (G.background || wm->winactive == NULL) {
+      BLO_memfile_write_file(memfile, filepath);
+    }
+    else {
+      wm_autosave_write_memfile_job(wm, memfile, filepath);
+    }
   }
   else {
     if (use_memfile) {
@@ -1992,6 +2040,12 @@ void wm_autosave_timer(Main *bmain, wmWindowManager *wm, wmTimer *UNUSED(wt))
 {
   wm_autosave_timer_end(wm);
 
+  /* The previous auto-save is still being written, skip this one. */
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    wm_autosave_timer_begin(wm);
+    return;
+  }
+
   /* If a modal operator is running, don't autosave because we might not be in
    * a valid state to save. But try again in 10ms. */
   LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
@@ -554,6 +554,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
    * the modifiers were garbage collected. */
   if (opengl_is_init) {
     DRW_subdiv_free();
+    DRW_mesh_extract_gpu_free();
   }
 
   ANIM_fcurves_copybuf_free();
@@ -623,6 +624,10 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   DNA_sdna_current_free();
 
+  if (G.debug & G_DEBUG_JOBS) {
+    BLI_task_parallel_statistics_print();
+  }
+
   BLI_threadapi_exit();
   BLI_task_scheduler_exit();
 
@@ -1445,6 +1445,13 @@ static bool ghost_event_proc(GHOST_EventHandle evt, GHOST_TUserDataPtr C_void_pt
  * Timer handlers should check for delta to decide if they just update, or follow real time.
  * Timer handlers can also set duration to match frames passed
  */
+/**
+ * Time in seconds the timers may take in one iteration of the main loop before job timers are
+ * postponed to the next iteration. This way many jobs finishing at once (preview icons for
+ * example) don't hold up event handling and drawing.
+ */
+#define WM_TIMER_TIME_BUDGET (1.0 / 120.0)
+
 static bool wm_window_timer(const bContext *C)
 {
   Main *bmain = CTX_data_main(C);
@@ -1461,6 +1468,13 @@ static bool wm_window_timer(const bContext *C)
     }
 
     if (time > wt->ntime) {
+      if ((wt->event_type == TIMERJOBS) &&
+          (PIL_check_seconds_timer() - time > WM_TIMER_TIME_BUDGET)) {
+        /* The timer is still due, don't sleep so it runs in the next iteration. */
+        has_event = true;
+        continue;
+      }
+
       wt->delta = time - wt->ltime;
       wt->duration += wt->delta;
       wt->ltime = time;
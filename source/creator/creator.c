@@ -30,6 +30,8 @@
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 /* Mostly initialization functions. */
 #include "BKE_appdir.h"
 #include "BKE_blender.h"
@@ -194,6 +196,46 @@ static void callback_clg_fatal(void *fp)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Startup Timing
+ *
+ * Time of the startup stages, printed with `--debug-startup-timing`. They are always recorded
+ * since the debug flags are only known once the settings arguments have been parsed.
+ * \{ */
+
+static struct {
+  const char *names[16];
+  double times[16];
+  int len;
+  double time_begin;
+} startup_timing = {{NULL}};
+
+static void startup_timing_stage_end(const char *name)
+{
+  if (startup_timing.len < ARRAY_SIZE(startup_timing.names)) {
+    startup_timing.names[startup_timing.len] = name;
+    startup_timing.times[startup_timing.len] = PIL_check_seconds_timer();
+    startup_timing.len++;
+  }
+}
+
+static void startup_timing_print(void)
+{
+  if ((G.debug & G_DEBUG_STARTUP_TIMING) == 0) {
+    return;
+  }
+  double time_prev = startup_timing.time_begin;
+  for (int i = 0; i < startup_timing.len; i++) {
+    printf("Startup: %-32s %9.2f ms\n",
+           startup_timing.names[i],
+           (startup_timing.times[i] - time_prev) * 1000.0);
+    time_prev = startup_timing.times[i];
+  }
+  printf("Startup: %-32s %9.2f ms\n", "Total", (time_prev - startup_timing.time_begin) * 1000.0);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Blender as a Stand-Alone Python Module (bpy)
  *
@@ -289,6 +331,8 @@ int main(int argc,
 
   /* --- end declarations --- */
 
+  startup_timing.time_begin = PIL_check_seconds_timer();
+
   /* Ensure we free data on early-exit. */
   struct CreatorAtExitData app_init_data = {NULL};
   BKE_blender_atexit_register(callback_main_atexit, &app_init_data);
@@ -437,6 +481,7 @@ int main(int argc,
   RE_texture_rng_init();
 
   BKE_callback_global_init();
+  startup_timing_stage_end("Types and globals");
 
   /* First test for background-mode (#Global.background) */
 #ifndef WITH_PYTHON_MODULE
@@ -468,6 +513,7 @@ int main(int argc,
 
   /* Initialize sub-systems that use `BKE_appdir.h`. */
   IMB_init();
+  startup_timing_stage_end("Directories and image formats");
 
 #ifndef WITH_PYTHON_MODULE
   /* First test for background-mode (#Global.background) */
@@ -488,6 +534,7 @@ int main(int argc,
   BKE_node_system_init();
   BKE_particle_init_rng();
   /* End second initialization. */
+  startup_timing_stage_end("RNA, engines and nodes");
 
 #if defined(WITH_PYTHON_MODULE) || defined(WITH_HEADLESS)
   /* Python module mode ALWAYS runs in background-mode (for now). */
@@ -506,6 +553,7 @@ int main(int argc,
   BKE_sound_init_once();
 
   BKE_materials_init();
+  startup_timing_stage_end("Fonts, sounds and materials");
 
 #ifndef WITH_PYTHON_MODULE
   if (G.background == 0) {
@@ -515,6 +563,7 @@ int main(int argc,
 #endif
 
   WM_init(C, argc, (const char **)argv);
+  startup_timing_stage_end("Window manager and Python");
 
   /* Need to be after WM init so that userpref are loaded. */
   RE_engines_init_experimental();
@@ -527,6 +576,7 @@ int main(int argc,
 
   CTX_py_init_set(C, true);
   WM_keyconfig_init(C);
+  startup_timing_stage_end("Key configurations");
 
 #ifdef WITH_FREESTYLE
   /* Initialize Freestyle. */
@@ -534,6 +584,8 @@ int main(int argc,
   FRS_set_context(C);
 #endif
 
+  startup_timing_print();
+
   /* OK we are ready for it */
 #ifndef WITH_PYTHON_MODULE
   /* Handles #ARG_PASS_FINAL. */
@@ -27,6 +27,7 @@
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
@@ -497,12 +498,14 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--render-anim");
   BLI_args_print_arg_doc(ba, "--scene");
   BLI_args_print_arg_doc(ba, "--render-frame");
+  BLI_args_print_arg_doc(ba, "--render-jobs-stdin");
   BLI_args_print_arg_doc(ba, "--frame-start");
   BLI_args_print_arg_doc(ba, "--frame-end");
   BLI_args_print_arg_doc(ba, "--frame-jump");
   BLI_args_print_arg_doc(ba, "--render-output");
   BLI_args_print_arg_doc(ba, "--engine");
   BLI_args_print_arg_doc(ba, "--threads");
+  BLI_args_print_arg_doc(ba, "--render-persistent-depsgraph");
 
   printf("\n");
   printf("Format Options:\n");
@@ -565,6 +568,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-cycles");
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--debug-heap-profile");
+  BLI_args_print_arg_doc(ba, "--debug-trace");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -577,6 +582,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uuid");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
+  BLI_args_print_arg_doc(ba, "--debug-geometry-nodes-profile");
+  BLI_args_print_arg_doc(ba, "--debug-startup-timing");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
   BLI_args_print_arg_doc(ba, "--debug-gpu-disable-ssbo");
@@ -951,6 +958,13 @@ static const char arg_handle_debug_mode_generic_set_doc_ghost[] =
 static const char arg_handle_debug_mode_generic_set_doc_wintab[] =
     "\n\t"
     "Enable debug messages for Wintab.";
+static const char arg_handle_debug_mode_generic_set_doc_geometry_nodes_profile[] =
+    "\n\t"
+    "Record the CPU time, memory and geometry copies of every geometry node and print them as\n"
+    "\tJSON after every evaluation of a geometry nodes modifier.";
+static const char arg_handle_debug_mode_generic_set_doc_startup_timing[] =
+    "\n\t"
+    "Print the time spent in every stage of the startup and in enabling every add-on.";
 #  ifdef WITH_XR_OPENXR
 static const char arg_handle_debug_mode_generic_set_doc_xr[] =
     "\n\t"
@@ -963,7 +977,7 @@ static const char arg_handle_debug_mode_generic_set_doc_xr_time[] =
 #  endif
 static const char arg_handle_debug_mode_generic_set_doc_jobs[] =
     "\n\t"
-    "Enable time profiling for background jobs.";
+    "Enable time profiling for background jobs and parallel loops.";
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph[] =
     "\n\t"
     "Enable all debug messages from dependency graph.";
@@ -1069,6 +1083,66 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static char heap_profile_filepath[FILE_MAX];
+
+static void heap_profile_write_on_exit(void)
+{
+  if (MEM_heap_profile_write(heap_profile_filepath)) {
+    printf("Heap profile written to '%s'\n", heap_profile_filepath);
+  }
+}
+
+static const char arg_handle_debug_heap_profile_set_doc[] =
+    "<filepath>\n"
+    "\tSample allocations with their call stacks, and write a heap profile of the memory which\n"
+    "\tis still allocated on exit (in a format which can be read by 'pprof').\n"
+    "\tThe profile can also be written at any time with 'bpy.app.heap_profile_write'.";
+static int arg_handle_debug_heap_profile_set(int argc, const char **argv, void *UNUSED(data))
+{
+  const char *arg_id = "--debug-heap-profile";
+  if (argc > 1) {
+    if (heap_profile_filepath[0] == '\0') {
+      atexit(heap_profile_write_on_exit);
+    }
+    BLI_strncpy(heap_profile_filepath, argv[1], sizeof(heap_profile_filepath));
+    BLI_path_abs_from_cwd(heap_profile_filepath, sizeof(heap_profile_filepath));
+    MEM_heap_profile_start(MEM_HEAP_PROFILE_DEFAULT_SAMPLE_INTERVAL);
+    return 1;
+  }
+  printf("\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
+static char trace_filepath[FILE_MAX];
+
+static void trace_write_on_exit(void)
+{
+  if (BLI_trace_end_recording()) {
+    printf("Trace written to '%s'\n", trace_filepath);
+  }
+}
+
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord timed events of all threads, and write them on exit in the Chrome trace event\n"
+    "\tformat (which can be loaded into Perfetto).\n"
+    "\tRecording can also be controlled with 'bpy.app.trace_start' and 'bpy.app.trace_stop'.";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void *UNUSED(data))
+{
+  const char *arg_id = "--debug-trace";
+  if (argc > 1) {
+    if (trace_filepath[0] == '\0') {
+      BLI_strncpy(trace_filepath, argv[1], sizeof(trace_filepath));
+      BLI_path_abs_from_cwd(trace_filepath, sizeof(trace_filepath));
+      BLI_trace_begin_recording(trace_filepath);
+      atexit(trace_write_on_exit);
+    }
+    return 1;
+  }
+  printf("\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -1643,6 +1717,19 @@ static int arg_handle_render_animation(int UNUSED(argc), const char **UNUSED(arg
   return 0;
 }
 
+static const char arg_handle_render_persistent_depsgraph_set_doc[] =
+    "\n\t"
+    "Keep the evaluated dependency graph between frames of an animation render,\n"
+    "\tso that only animated data is re-evaluated for every frame.\n"
+    "\tUses more memory while rendering, as evaluated data is not freed after it is synced.";
+static int arg_handle_render_persistent_depsgraph_set(int UNUSED(argc),
+                                                      const char **UNUSED(argv),
+                                                      void *UNUSED(data))
+{
+  G.f |= G_FLAG_RENDER_PERSISTENT_DEPSGRAPH;
+  return 0;
+}
+
 static const char arg_handle_scene_set_doc[] =
     "<name>\n"
     "\tSet the active scene <name> for rendering.";
@@ -2032,6 +2119,58 @@ static int arg_handle_load_last_file(int UNUSED(argc), const char **UNUSED(argv)
   return arg_handle_load_file(ARRAY_SIZE(fake_argv), fake_argv, data);
 }
 
+static const char arg_handle_render_jobs_stdin_doc[] =
+    "\n\t"
+    "Read jobs from the standard input, one per line, until it's closed.\n"
+    "\tEvery line is a list of processing arguments handled like on the command line,\n"
+    "\tfor example '<file> --scene <name> --render-frame <frame>'. Quotes can be used\n"
+    "\tfor arguments with spaces. Add-ons and render engines stay loaded between jobs,\n"
+    "\t'Job done' or 'Job failed' is printed after each one.";
+static int arg_handle_render_jobs_stdin(int UNUSED(argc), const char **UNUSED(argv), void *data)
+{
+  bContext *C = data;
+  char line[4096];
+
+  while (fgets(line, sizeof(line), stdin)) {
+    /* The first argument is skipped when parsing, like the executable path. */
+    const char *job_argv[256] = {"blender"};
+    int job_argc = 1;
+
+    char *p = line;
+    while (job_argc < ARRAY_SIZE(job_argv)) {
+      while (ELEM(*p, ' ', '\t', '\r', '\n')) {
+        p++;
+      }
+      if (*p == '\0') {
+        break;
+      }
+      const char quote = ELEM(*p, '"', '\'') ? *p++ : '\0';
+      job_argv[job_argc++] = p;
+      while (*p != '\0' && (quote ? (*p != quote) : !ELEM(*p, ' ', '\t', '\r', '\n'))) {
+        p++;
+      }
+      if (*p != '\0') {
+        *p++ = '\0';
+      }
+    }
+    if (job_argc == 1) {
+      continue;
+    }
+
+    bArgs *job_ba = BLI_args_create(job_argc, job_argv);
+    main_args_setup(C, job_ba);
+    BLI_args_parse(job_ba, ARG_PASS_FINAL, arg_handle_load_file, C);
+    BLI_args_destroy(job_ba);
+
+    /* A failing job doesn't stop the next ones. */
+    printf("%s\n", G.is_break ? "Job failed" : "Job done");
+    fflush(stdout);
+    G.is_break = false;
+  }
+
+  return 0;
+}
+
 void main_args_setup(bContext *C, bArgs *ba)
 {
 
@@ -2079,6 +2218,11 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, "-v", "--version", CB(arg_handle_print_version), NULL);
 
   BLI_args_add(ba, "-y", "--enable-autoexec", CB_EX(arg_handle_python_set, enable), (void *)true);
+  BLI_args_add(ba,
+               NULL,
+               "--render-persistent-depsgraph",
+               CB(arg_handle_render_persistent_depsgraph_set),
+               NULL);
   BLI_args_add(
       ba, "-Y", "--disable-autoexec", CB_EX(arg_handle_python_set, disable), (void *)false);
 
@@ -2148,6 +2292,16 @@ void main_args_setup(bContext *C, bArgs *ba)
                "--debug-wintab",
                CB_EX(arg_handle_debug_mode_generic_set, wintab),
                (void *)G_DEBUG_WINTAB);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-geometry-nodes-profile",
+               CB_EX(arg_handle_debug_mode_generic_set, geometry_nodes_profile),
+               (void *)G_DEBUG_GEOMETRY_NODES_PROFILE);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-startup-timing",
+               CB_EX(arg_handle_debug_mode_generic_set, startup_timing),
+               (void *)G_DEBUG_STARTUP_TIMING);
   BLI_args_add(ba, NULL, "--debug-all", CB(arg_handle_debug_mode_all), NULL);
 
   BLI_args_add(ba, NULL, "--debug-io", CB(arg_handle_debug_mode_io), NULL);
@@ -2161,6 +2315,8 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_args_add(ba, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_args_add(ba, NULL, "--debug-heap-profile", CB(arg_handle_debug_heap_profile_set), NULL);
+  BLI_args_add(ba, NULL, "--debug-trace", CB(arg_handle_debug_trace_set), NULL);
 
   BLI_args_add(ba, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_args_add(ba,
@@ -2250,6 +2406,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_pass_set(ba, ARG_PASS_FINAL);
   BLI_args_add(ba, "-f", "--render-frame", CB(arg_handle_render_frame), C);
   BLI_args_add(ba, "-a", "--render-anim", CB(arg_handle_render_animation), C);
+  BLI_args_add(ba, NULL, "--render-jobs-stdin", CB(arg_handle_render_jobs_stdin), C);
   BLI_args_add(ba, "-S", "--scene", CB(arg_handle_scene_set), C);
   BLI_args_add(ba, "-s", "--frame-start", CB(arg_handle_frame_start_set), C);
   BLI_args_add(ba, "-e", "--frame-end", CB(arg_handle_frame_end_set), C);
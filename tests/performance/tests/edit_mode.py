@@ -0,0 +1,50 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    ob = bpy.context.view_layer.objects.active
+    if ob is None or ob.type != 'MESH':
+        return {'time': 0.0}
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_toggles = 0
+
+    while elapsed_time < 10.0:
+        bpy.ops.object.mode_set(mode='EDIT')
+        bpy.ops.object.mode_set(mode='OBJECT')
+
+        num_toggles += 1
+        elapsed_time = time.time() - start_time
+
+    time_per_toggle = elapsed_time / num_toggles
+
+    result = {'time': time_per_toggle}
+    return result
+
+
+class EditModeTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "edit_mode"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('edit_mode/*')
+    return [EditModeTest(filepath) for filepath in filepaths]
@@ -0,0 +1,53 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    view_layer = bpy.context.view_layer
+    objects = [ob for ob in bpy.data.objects
+               if any(modifier.type == 'NODES' for modifier in ob.modifiers)]
+    view_layer.update()
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_evaluations = 0
+
+    while elapsed_time < 10.0:
+        # Only re-evaluate objects with geometry nodes, the rest stays evaluated
+        for ob in objects:
+            ob.update_tag(refresh={'DATA'})
+        view_layer.update()
+
+        num_evaluations += 1
+        elapsed_time = time.time() - start_time
+
+    time_per_evaluation = elapsed_time / num_evaluations
+
+    result = {'time': time_per_evaluation}
+    return result
+
+
+class GeometryNodesTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('geometry_nodes/*')
+    return [GeometryNodesTest(filepath) for filepath in filepaths]